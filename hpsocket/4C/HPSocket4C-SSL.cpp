@@ -246,6 +246,16 @@ HPSOCKET_API BOOL __HP_CALL HP_SSLServer_IsSSLAutoHandShake(HP_SSLServer pServer
 	return C_HP_Object::ToSecond<ITcpServer>(pServer)->IsSSLAutoHandShake();
 }
 
+HPSOCKET_API void __HP_CALL HP_SSLServer_SetSSLAlpnProtocols(HP_SSLServer pServer, LPCTSTR lpszProtocols)
+{
+	C_HP_Object::ToSecond<ITcpServer>(pServer)->SetSSLAlpnProtocols(lpszProtocols);
+}
+
+HPSOCKET_API LPCTSTR __HP_CALL HP_SSLServer_GetSSLAlpnProtocols(HP_SSLServer pServer)
+{
+	return C_HP_Object::ToSecond<ITcpServer>(pServer)->GetSSLAlpnProtocols();
+}
+
 HPSOCKET_API BOOL __HP_CALL HP_SSLServer_GetSSLSessionInfo(HP_SSLServer pServer, HP_CONNID dwConnID, En_HP_SSLSessionInfo enInfo, LPVOID* lppInfo)
 {
 	return C_HP_Object::ToSecond<ITcpServer>(pServer)->GetSSLSessionInfo(dwConnID, enInfo, lppInfo);
@@ -266,6 +276,16 @@ HPSOCKET_API BOOL __HP_CALL HP_SSLAgent_IsSSLAutoHandShake(HP_SSLAgent pAgent)
 	return C_HP_Object::ToSecond<ITcpAgent>(pAgent)->IsSSLAutoHandShake();
 }
 
+HPSOCKET_API void __HP_CALL HP_SSLAgent_SetSSLAlpnProtocols(HP_SSLAgent pAgent, LPCTSTR lpszProtocols)
+{
+	C_HP_Object::ToSecond<ITcpAgent>(pAgent)->SetSSLAlpnProtocols(lpszProtocols);
+}
+
+HPSOCKET_API LPCTSTR __HP_CALL HP_SSLAgent_GetSSLAlpnProtocols(HP_SSLAgent pAgent)
+{
+	return C_HP_Object::ToSecond<ITcpAgent>(pAgent)->GetSSLAlpnProtocols();
+}
+
 HPSOCKET_API BOOL __HP_CALL HP_SSLAgent_GetSSLSessionInfo(HP_SSLAgent pAgent, HP_CONNID dwConnID, En_HP_SSLSessionInfo enInfo, LPVOID* lppInfo)
 {
 	return C_HP_Object::ToSecond<ITcpAgent>(pAgent)->GetSSLSessionInfo(dwConnID, enInfo, lppInfo);
@@ -286,6 +306,16 @@ HPSOCKET_API BOOL __HP_CALL HP_SSLClient_IsSSLAutoHandShake(HP_SSLClient pClient
 	return C_HP_Object::ToSecond<ITcpClient>(pClient)->IsSSLAutoHandShake();
 }
 
+HPSOCKET_API void __HP_CALL HP_SSLClient_SetSSLAlpnProtocols(HP_SSLClient pClient, LPCTSTR lpszProtocols)
+{
+	C_HP_Object::ToSecond<ITcpClient>(pClient)->SetSSLAlpnProtocols(lpszProtocols);
+}
+
+HPSOCKET_API LPCTSTR __HP_CALL HP_SSLClient_GetSSLAlpnProtocols(HP_SSLClient pClient)
+{
+	return C_HP_Object::ToSecond<ITcpClient>(pClient)->GetSSLAlpnProtocols();
+}
+
 HPSOCKET_API BOOL __HP_CALL HP_SSLClient_GetSSLSessionInfo(HP_SSLClient pClient, En_HP_SSLSessionInfo enInfo, LPVOID* lppInfo)
 {
 	return C_HP_Object::ToSecond<ITcpClient>(pClient)->GetSSLSessionInfo(enInfo, lppInfo);
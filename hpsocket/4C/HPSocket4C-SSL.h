@@ -309,6 +309,11 @@ HPSOCKET_API void __HP_CALL HP_SSLServer_SetSSLAutoHandShake(HP_SSLServer pServe
 /* ȡַͨʽ */
 HPSOCKET_API BOOL __HP_CALL HP_SSLServer_IsSSLAutoHandShake(HP_SSLServer pServer);
 
+/*  ALPN ЭбŷָȼУ磺"h2,http/1.1"Ĭϣգʹ ALPN SetupSSLContext() ǰã */
+HPSOCKET_API void __HP_CALL HP_SSLServer_SetSSLAlpnProtocols(HP_SSLServer pServer, LPCTSTR lpszProtocols);
+/* ȡ ALPN Эб */
+HPSOCKET_API LPCTSTR __HP_CALL HP_SSLServer_GetSSLAlpnProtocols(HP_SSLServer pServer);
+
 /*
 * ƣȡ SSL Session Ϣ
 * ȡָ͵ SSL Session ϢͲοEn_HP_SSLSessionInfo
@@ -332,6 +337,11 @@ HPSOCKET_API void __HP_CALL HP_SSLAgent_SetSSLAutoHandShake(HP_SSLAgent pAgent,
 /* ȡַͨʽ */
 HPSOCKET_API BOOL __HP_CALL HP_SSLAgent_IsSSLAutoHandShake(HP_SSLAgent pAgent);
 
+/*  ALPN ЭбŷָȼУ磺"h2,http/1.1"Ĭϣգʹ ALPN SetupSSLContext() ǰã */
+HPSOCKET_API void __HP_CALL HP_SSLAgent_SetSSLAlpnProtocols(HP_SSLAgent pAgent, LPCTSTR lpszProtocols);
+/* ȡ ALPN Эб */
+HPSOCKET_API LPCTSTR __HP_CALL HP_SSLAgent_GetSSLAlpnProtocols(HP_SSLAgent pAgent);
+
 /*
 * ƣȡ SSL Session Ϣ
 * ȡָ͵ SSL Session ϢͲοEn_HP_SSLSessionInfo
@@ -355,6 +365,11 @@ HPSOCKET_API void __HP_CALL HP_SSLClient_SetSSLAutoHandShake(HP_SSLClient pClien
 /* ȡַͨʽ */
 HPSOCKET_API BOOL __HP_CALL HP_SSLClient_IsSSLAutoHandShake(HP_SSLClient pClient);
 
+/*  ALPN ЭбŷָȼУ磺"h2,http/1.1"Ĭϣգʹ ALPN SetupSSLContext() ǰã */
+HPSOCKET_API void __HP_CALL HP_SSLClient_SetSSLAlpnProtocols(HP_SSLClient pClient, LPCTSTR lpszProtocols);
+/* ȡ ALPN Эб */
+HPSOCKET_API LPCTSTR __HP_CALL HP_SSLClient_GetSSLAlpnProtocols(HP_SSLClient pClient);
+
 /*
 * ƣȡ SSL Session Ϣ
 * ȡָ͵ SSL Session ϢͲοEn_HP_SSLSessionInfo
@@ -412,6 +412,11 @@ HPSOCKET_API void __HP_CALL HP_Set_FN_Server_OnReceive(HP_ServerListener pListen
 	((C_HP_TcpServerListener*)pListener)->m_fnOnReceive = fn;
 }
 
+HPSOCKET_API void __HP_CALL HP_Set_FN_Server_OnReceiveBatch(HP_ServerListener pListener, HP_FN_Server_OnReceiveBatch fn)
+{
+	((C_HP_TcpServerListener*)pListener)->m_fnOnReceiveBatch = fn;
+}
+
 HPSOCKET_API void __HP_CALL HP_Set_FN_Server_OnPullReceive(HP_ServerListener pListener, HP_FN_Server_OnPullReceive fn)
 {
 	((C_HP_TcpServerListener*)pListener)->m_fnOnPullReceive = fn;
@@ -455,6 +460,11 @@ HPSOCKET_API void __HP_CALL HP_Set_FN_Agent_OnReceive(HP_AgentListener pListener
 	((C_HP_TcpAgentListener*)pListener)->m_fnOnReceive = fn;
 }
 
+HPSOCKET_API void __HP_CALL HP_Set_FN_Agent_OnReceiveBatch(HP_AgentListener pListener, HP_FN_Agent_OnReceiveBatch fn)
+{
+	((C_HP_TcpAgentListener*)pListener)->m_fnOnReceiveBatch = fn;
+}
+
 HPSOCKET_API void __HP_CALL HP_Set_FN_Agent_OnPullReceive(HP_AgentListener pListener, HP_FN_Agent_OnPullReceive fn)
 {
 	((C_HP_TcpAgentListener*)pListener)->m_fnOnPullReceive = fn;
@@ -529,6 +539,11 @@ HPSOCKET_API void __HP_CALL HP_Set_FN_UdpNode_OnReceive(HP_UdpNodeListener pList
 	((C_HP_UdpNodeListener*)pListener)->m_fnOnReceive = fn;
 }
 
+HPSOCKET_API void __HP_CALL HP_Set_FN_UdpNode_OnReceiveBatch(HP_UdpNodeListener pListener, HP_FN_UdpNode_OnReceiveBatch fn)
+{
+	((C_HP_UdpNodeListener*)pListener)->m_fnOnReceiveBatch = fn;
+}
+
 HPSOCKET_API void __HP_CALL HP_Set_FN_UdpNode_OnError(HP_UdpNodeListener pListener , HP_FN_UdpNode_OnError fn)
 {
 	((C_HP_UdpNodeListener*)pListener)->m_fnOnError = fn;
@@ -697,9 +712,9 @@ HPSOCKET_API void __HP_CALL HP_Server_SetOnSendSyncPolicy(HP_Server pServer, En_
 	C_HP_Object::ToSecond<IServer>(pServer)->SetOnSendSyncPolicy(enSyncPolicy);
 }
 
-HPSOCKET_API void __HP_CALL HP_Server_SetFreeSocketObjLockTime(HP_Server pServer, DWORD dwFreeSocketObjLockTime)
+HPSOCKET_API void __HP_CALL HP_Server_SetOnSendNotifyPolicy(HP_Server pServer, En_HP_OnSendNotifyPolicy enNotifyPolicy)
 {
-	C_HP_Object::ToSecond<IServer>(pServer)->SetFreeSocketObjLockTime(dwFreeSocketObjLockTime);
+	C_HP_Object::ToSecond<IServer>(pServer)->SetOnSendNotifyPolicy(enNotifyPolicy);
 }
 
 HPSOCKET_API void __HP_CALL HP_Server_SetFreeSocketObjPool(HP_Server pServer, DWORD dwFreeSocketObjPool)
@@ -752,9 +767,9 @@ HPSOCKET_API En_HP_OnSendSyncPolicy __HP_CALL HP_Server_GetOnSendSyncPolicy(HP_S
 	return C_HP_Object::ToSecond<IServer>(pServer)->GetOnSendSyncPolicy();
 }
 
-HPSOCKET_API DWORD __HP_CALL HP_Server_GetFreeSocketObjLockTime(HP_Server pServer)
+HPSOCKET_API En_HP_OnSendNotifyPolicy __HP_CALL HP_Server_GetOnSendNotifyPolicy(HP_Server pServer)
 {
-	return C_HP_Object::ToSecond<IServer>(pServer)->GetFreeSocketObjLockTime();
+	return C_HP_Object::ToSecond<IServer>(pServer)->GetOnSendNotifyPolicy();
 }
 
 HPSOCKET_API DWORD __HP_CALL HP_Server_GetFreeSocketObjPool(HP_Server pServer)
@@ -792,6 +807,46 @@ HPSOCKET_API BOOL __HP_CALL HP_Server_IsMarkSilence(HP_Server pServer)
 	return C_HP_Object::ToSecond<IServer>(pServer)->IsMarkSilence();
 }
 
+HPSOCKET_API void __HP_CALL HP_Server_SetCollectMetrics(HP_Server pServer, BOOL bCollectMetrics)
+{
+	C_HP_Object::ToSecond<IServer>(pServer)->SetCollectMetrics(bCollectMetrics);
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_Server_IsCollectMetrics(HP_Server pServer)
+{
+	return C_HP_Object::ToSecond<IServer>(pServer)->IsCollectMetrics();
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_Server_GetMetrics(HP_Server pServer, HP_TSocketMetrics* pMetrics)
+{
+	return C_HP_Object::ToSecond<IServer>(pServer)->GetMetrics(*pMetrics);
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_Server_GetMetricsText(HP_Server pServer, LPSTR lpszBuffer, int* piLength, LPCSTR lpszPrefix)
+{
+	return C_HP_Object::ToSecond<IServer>(pServer)->GetMetricsText(lpszBuffer, *piLength, lpszPrefix);
+}
+
+HPSOCKET_API void __HP_CALL HP_Server_SetSlowCallbackThreshold(HP_Server pServer, DWORD dwSlowCallbackThreshold)
+{
+	C_HP_Object::ToSecond<IServer>(pServer)->SetSlowCallbackThreshold(dwSlowCallbackThreshold);
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_Server_GetSlowCallbackThreshold(HP_Server pServer)
+{
+	return C_HP_Object::ToSecond<IServer>(pServer)->GetSlowCallbackThreshold();
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_Server_GetWorkerTraceStats(HP_Server pServer, HP_TWorkerTraceStat stats[], DWORD* pdwCount)
+{
+	return C_HP_Object::ToSecond<IServer>(pServer)->GetWorkerTraceStats(stats, *pdwCount);
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_Server_GetSlowCallbacks(HP_Server pServer, HP_TSlowCallback records[], DWORD* pdwCount)
+{
+	return C_HP_Object::ToSecond<IServer>(pServer)->GetSlowCallbacks(records, *pdwCount);
+}
+
 /**********************************************************************************/
 /******************************* TCP Server  *******************************/
 
@@ -813,6 +868,26 @@ HPSOCKET_API void __HP_CALL HP_TcpServer_SetSocketBufferSize(HP_TcpServer pServe
 	C_HP_Object::ToSecond<ITcpServer>(pServer)->SetSocketBufferSize(dwSocketBufferSize);
 }
 
+HPSOCKET_API void __HP_CALL HP_TcpServer_SetBatchReceive(HP_TcpServer pServer, BOOL bBatchReceive)
+{
+	C_HP_Object::ToSecond<ITcpServer>(pServer)->SetBatchReceive(bBatchReceive);
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpServer_SetIoBytesBudget(HP_TcpServer pServer, DWORD dwIoBytesBudget)
+{
+	C_HP_Object::ToSecond<ITcpServer>(pServer)->SetIoBytesBudget(dwIoBytesBudget);
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpServer_SetIoTimeBudget(HP_TcpServer pServer, DWORD dwIoTimeBudget)
+{
+	C_HP_Object::ToSecond<ITcpServer>(pServer)->SetIoTimeBudget(dwIoTimeBudget);
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpServer_SetEdgeTrigger(HP_TcpServer pServer, BOOL bEdgeTrigger)
+{
+	C_HP_Object::ToSecond<ITcpServer>(pServer)->SetEdgeTrigger(bEdgeTrigger);
+}
+
 HPSOCKET_API void __HP_CALL HP_TcpServer_SetSocketListenQueue(HP_TcpServer pServer, DWORD dwSocketListenQueue)
 {
 	C_HP_Object::ToSecond<ITcpServer>(pServer)->SetSocketListenQueue(dwSocketListenQueue);
@@ -838,6 +913,26 @@ HPSOCKET_API DWORD __HP_CALL HP_TcpServer_GetSocketBufferSize(HP_TcpServer pServ
 	return C_HP_Object::ToSecond<ITcpServer>(pServer)->GetSocketBufferSize();
 }
 
+HPSOCKET_API BOOL __HP_CALL HP_TcpServer_IsBatchReceive(HP_TcpServer pServer)
+{
+	return C_HP_Object::ToSecond<ITcpServer>(pServer)->IsBatchReceive();
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_TcpServer_GetIoBytesBudget(HP_TcpServer pServer)
+{
+	return C_HP_Object::ToSecond<ITcpServer>(pServer)->GetIoBytesBudget();
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_TcpServer_GetIoTimeBudget(HP_TcpServer pServer)
+{
+	return C_HP_Object::ToSecond<ITcpServer>(pServer)->GetIoTimeBudget();
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_TcpServer_IsEdgeTrigger(HP_TcpServer pServer)
+{
+	return C_HP_Object::ToSecond<ITcpServer>(pServer)->IsEdgeTrigger();
+}
+
 HPSOCKET_API DWORD __HP_CALL HP_TcpServer_GetSocketListenQueue(HP_TcpServer pServer)
 {
 	return C_HP_Object::ToSecond<ITcpServer>(pServer)->GetSocketListenQueue();
@@ -956,6 +1051,31 @@ HPSOCKET_API void __HP_CALL HP_UdpArqServer_SetHandShakeTimeout(HP_UdpArqServer
 	C_HP_Object::ToFirst<IArqSocket>(pServer)->SetHandShakeTimeout(dwHandShakeTimeout);
 }
 
+HPSOCKET_API void __HP_CALL HP_UdpArqServer_SetFlushDelay(HP_UdpArqServer pServer, DWORD dwFlushDelay)
+{
+	C_HP_Object::ToFirst<IArqSocket>(pServer)->SetFlushDelay(dwFlushDelay);
+}
+
+HPSOCKET_API void __HP_CALL HP_UdpArqServer_SetFecDataShards(HP_UdpArqServer pServer, DWORD dwDataShards)
+{
+	C_HP_Object::ToFirst<IArqSocket>(pServer)->SetFecDataShards(dwDataShards);
+}
+
+HPSOCKET_API void __HP_CALL HP_UdpArqServer_SetFecParityShards(HP_UdpArqServer pServer, DWORD dwParityShards)
+{
+	C_HP_Object::ToFirst<IArqSocket>(pServer)->SetFecParityShards(dwParityShards);
+}
+
+HPSOCKET_API void __HP_CALL HP_UdpArqServer_SetCongestCtrl(HP_UdpArqServer pServer, En_HP_ArqCongestCtrl enCongestCtrl)
+{
+	C_HP_Object::ToFirst<IArqSocket>(pServer)->SetCongestCtrl(enCongestCtrl);
+}
+
+HPSOCKET_API void __HP_CALL HP_UdpArqServer_SetPacingRate(HP_UdpArqServer pServer, DWORD dwPacingRate)
+{
+	C_HP_Object::ToFirst<IArqSocket>(pServer)->SetPacingRate(dwPacingRate);
+}
+
 HPSOCKET_API BOOL __HP_CALL HP_UdpArqServer_IsNoDelay(HP_UdpArqServer pServer)
 {
 	return C_HP_Object::ToFirst<IArqSocket>(pServer)->IsNoDelay();
@@ -1011,11 +1131,41 @@ HPSOCKET_API DWORD __HP_CALL HP_UdpArqServer_GetHandShakeTimeout(HP_UdpArqServer
 	return C_HP_Object::ToFirst<IArqSocket>(pServer)->GetHandShakeTimeout();
 }
 
+HPSOCKET_API DWORD __HP_CALL HP_UdpArqServer_GetFlushDelay(HP_UdpArqServer pServer)
+{
+	return C_HP_Object::ToFirst<IArqSocket>(pServer)->GetFlushDelay();
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_UdpArqServer_GetFecDataShards(HP_UdpArqServer pServer)
+{
+	return C_HP_Object::ToFirst<IArqSocket>(pServer)->GetFecDataShards();
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_UdpArqServer_GetFecParityShards(HP_UdpArqServer pServer)
+{
+	return C_HP_Object::ToFirst<IArqSocket>(pServer)->GetFecParityShards();
+}
+
+HPSOCKET_API En_HP_ArqCongestCtrl __HP_CALL HP_UdpArqServer_GetCongestCtrl(HP_UdpArqServer pServer)
+{
+	return C_HP_Object::ToFirst<IArqSocket>(pServer)->GetCongestCtrl();
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_UdpArqServer_GetPacingRate(HP_UdpArqServer pServer)
+{
+	return C_HP_Object::ToFirst<IArqSocket>(pServer)->GetPacingRate();
+}
+
 HPSOCKET_API BOOL __HP_CALL HP_UdpArqServer_GetWaitingSendMessageCount(HP_UdpArqServer pServer, HP_CONNID dwConnID, int* piCount)
 {
 	return C_HP_Object::ToFirst<IArqSocket>(pServer)->GetWaitingSendMessageCount(dwConnID, *piCount);
 }
 
+HPSOCKET_API BOOL __HP_CALL HP_UdpArqServer_GetSessionStats(HP_UdpArqServer pServer, HP_CONNID dwConnID, HP_TArqSessionStats* pStats)
+{
+	return C_HP_Object::ToFirst<IArqSocket>(pServer)->GetSessionStats(dwConnID, *pStats);
+}
+
 #endif
 
 /**************************************************************************/
@@ -1204,9 +1354,9 @@ HPSOCKET_API void __HP_CALL HP_Agent_SetOnSendSyncPolicy(HP_Agent pAgent, En_HP_
 	C_HP_Object::ToSecond<IAgent>(pAgent)->SetOnSendSyncPolicy(enSyncPolicy);
 }
 
-HPSOCKET_API void __HP_CALL HP_Agent_SetFreeSocketObjLockTime(HP_Agent pAgent, DWORD dwFreeSocketObjLockTime)
+HPSOCKET_API void __HP_CALL HP_Agent_SetOnSendNotifyPolicy(HP_Agent pAgent, En_HP_OnSendNotifyPolicy enNotifyPolicy)
 {
-	C_HP_Object::ToSecond<IAgent>(pAgent)->SetFreeSocketObjLockTime(dwFreeSocketObjLockTime);
+	C_HP_Object::ToSecond<IAgent>(pAgent)->SetOnSendNotifyPolicy(enNotifyPolicy);
 }
 
 HPSOCKET_API void __HP_CALL HP_Agent_SetFreeSocketObjPool(HP_Agent pAgent, DWORD dwFreeSocketObjPool)
@@ -1259,9 +1409,9 @@ HPSOCKET_API En_HP_OnSendSyncPolicy __HP_CALL HP_Agent_GetOnSendSyncPolicy(HP_Ag
 	return C_HP_Object::ToSecond<IAgent>(pAgent)->GetOnSendSyncPolicy();
 }
 
-HPSOCKET_API DWORD __HP_CALL HP_Agent_GetFreeSocketObjLockTime(HP_Agent pAgent)
+HPSOCKET_API En_HP_OnSendNotifyPolicy __HP_CALL HP_Agent_GetOnSendNotifyPolicy(HP_Agent pAgent)
 {
-	return C_HP_Object::ToSecond<IAgent>(pAgent)->GetFreeSocketObjLockTime();
+	return C_HP_Object::ToSecond<IAgent>(pAgent)->GetOnSendNotifyPolicy();
 }
 
 HPSOCKET_API DWORD __HP_CALL HP_Agent_GetFreeSocketObjPool(HP_Agent pAgent)
@@ -1299,6 +1449,46 @@ HPSOCKET_API BOOL __HP_CALL HP_Agent_IsMarkSilence(HP_Agent pAgent)
 	return C_HP_Object::ToSecond<IAgent>(pAgent)->IsMarkSilence();
 }
 
+HPSOCKET_API void __HP_CALL HP_Agent_SetCollectMetrics(HP_Agent pAgent, BOOL bCollectMetrics)
+{
+	C_HP_Object::ToSecond<IAgent>(pAgent)->SetCollectMetrics(bCollectMetrics);
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_Agent_IsCollectMetrics(HP_Agent pAgent)
+{
+	return C_HP_Object::ToSecond<IAgent>(pAgent)->IsCollectMetrics();
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_Agent_GetMetrics(HP_Agent pAgent, HP_TSocketMetrics* pMetrics)
+{
+	return C_HP_Object::ToSecond<IAgent>(pAgent)->GetMetrics(*pMetrics);
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_Agent_GetMetricsText(HP_Agent pAgent, LPSTR lpszBuffer, int* piLength, LPCSTR lpszPrefix)
+{
+	return C_HP_Object::ToSecond<IAgent>(pAgent)->GetMetricsText(lpszBuffer, *piLength, lpszPrefix);
+}
+
+HPSOCKET_API void __HP_CALL HP_Agent_SetSlowCallbackThreshold(HP_Agent pAgent, DWORD dwSlowCallbackThreshold)
+{
+	C_HP_Object::ToSecond<IAgent>(pAgent)->SetSlowCallbackThreshold(dwSlowCallbackThreshold);
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_Agent_GetSlowCallbackThreshold(HP_Agent pAgent)
+{
+	return C_HP_Object::ToSecond<IAgent>(pAgent)->GetSlowCallbackThreshold();
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_Agent_GetWorkerTraceStats(HP_Agent pAgent, HP_TWorkerTraceStat stats[], DWORD* pdwCount)
+{
+	return C_HP_Object::ToSecond<IAgent>(pAgent)->GetWorkerTraceStats(stats, *pdwCount);
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_Agent_GetSlowCallbacks(HP_Agent pAgent, HP_TSlowCallback records[], DWORD* pdwCount)
+{
+	return C_HP_Object::ToSecond<IAgent>(pAgent)->GetSlowCallbacks(records, *pdwCount);
+}
+
 /**********************************************************************************/
 /******************************* TCP Agent  *******************************/
 
@@ -1315,6 +1505,26 @@ HPSOCKET_API void __HP_CALL HP_TcpAgent_SetSocketBufferSize(HP_TcpAgent pAgent,
 	C_HP_Object::ToSecond<ITcpAgent>(pAgent)->SetSocketBufferSize(dwSocketBufferSize);
 }
 
+HPSOCKET_API void __HP_CALL HP_TcpAgent_SetBatchReceive(HP_TcpAgent pAgent, BOOL bBatchReceive)
+{
+	C_HP_Object::ToSecond<ITcpAgent>(pAgent)->SetBatchReceive(bBatchReceive);
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpAgent_SetIoBytesBudget(HP_TcpAgent pAgent, DWORD dwIoBytesBudget)
+{
+	C_HP_Object::ToSecond<ITcpAgent>(pAgent)->SetIoBytesBudget(dwIoBytesBudget);
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpAgent_SetIoTimeBudget(HP_TcpAgent pAgent, DWORD dwIoTimeBudget)
+{
+	C_HP_Object::ToSecond<ITcpAgent>(pAgent)->SetIoTimeBudget(dwIoTimeBudget);
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpAgent_SetEdgeTrigger(HP_TcpAgent pAgent, BOOL bEdgeTrigger)
+{
+	C_HP_Object::ToSecond<ITcpAgent>(pAgent)->SetEdgeTrigger(bEdgeTrigger);
+}
+
 HPSOCKET_API void __HP_CALL HP_TcpAgent_SetKeepAliveTime(HP_TcpAgent pAgent, DWORD dwKeepAliveTime)
 {
 	C_HP_Object::ToSecond<ITcpAgent>(pAgent)->SetKeepAliveTime(dwKeepAliveTime);
@@ -1330,6 +1540,26 @@ HPSOCKET_API DWORD __HP_CALL HP_TcpAgent_GetSocketBufferSize(HP_TcpAgent pAgent)
 	return C_HP_Object::ToSecond<ITcpAgent>(pAgent)->GetSocketBufferSize();
 }
 
+HPSOCKET_API BOOL __HP_CALL HP_TcpAgent_IsBatchReceive(HP_TcpAgent pAgent)
+{
+	return C_HP_Object::ToSecond<ITcpAgent>(pAgent)->IsBatchReceive();
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_TcpAgent_GetIoBytesBudget(HP_TcpAgent pAgent)
+{
+	return C_HP_Object::ToSecond<ITcpAgent>(pAgent)->GetIoBytesBudget();
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_TcpAgent_GetIoTimeBudget(HP_TcpAgent pAgent)
+{
+	return C_HP_Object::ToSecond<ITcpAgent>(pAgent)->GetIoTimeBudget();
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_TcpAgent_IsEdgeTrigger(HP_TcpAgent pAgent)
+{
+	return C_HP_Object::ToSecond<ITcpAgent>(pAgent)->IsEdgeTrigger();
+}
+
 HPSOCKET_API DWORD __HP_CALL HP_TcpAgent_GetKeepAliveTime(HP_TcpAgent pAgent)
 {
 	return C_HP_Object::ToSecond<ITcpAgent>(pAgent)->GetKeepAliveTime();
@@ -1486,6 +1716,26 @@ HPSOCKET_API DWORD __HP_CALL HP_Client_GetFreeBufferPoolHold(HP_Client pClient)
 	return C_HP_Object::ToSecond<IClient>(pClient)->GetFreeBufferPoolHold();
 }
 
+HPSOCKET_API void __HP_CALL HP_Client_SetCollectMetrics(HP_Client pClient, BOOL bCollectMetrics)
+{
+	C_HP_Object::ToSecond<IClient>(pClient)->SetCollectMetrics(bCollectMetrics);
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_Client_IsCollectMetrics(HP_Client pClient)
+{
+	return C_HP_Object::ToSecond<IClient>(pClient)->IsCollectMetrics();
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_Client_GetMetrics(HP_Client pClient, HP_TSocketMetrics* pMetrics)
+{
+	return C_HP_Object::ToSecond<IClient>(pClient)->GetMetrics(*pMetrics);
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_Client_GetMetricsText(HP_Client pClient, LPSTR lpszBuffer, int* piLength, LPCSTR lpszPrefix)
+{
+	return C_HP_Object::ToSecond<IClient>(pClient)->GetMetricsText(lpszBuffer, *piLength, lpszPrefix);
+}
+
 /**********************************************************************************/
 /******************************* TCP Client  *******************************/
 
@@ -1620,6 +1870,31 @@ HPSOCKET_API void __HP_CALL HP_UdpArqClient_SetHandShakeTimeout(HP_UdpArqClient
 	C_HP_Object::ToFirst<IArqClient>(pClient)->SetHandShakeTimeout(dwHandShakeTimeout);
 }
 
+HPSOCKET_API void __HP_CALL HP_UdpArqClient_SetFlushDelay(HP_UdpArqClient pClient, DWORD dwFlushDelay)
+{
+	C_HP_Object::ToFirst<IArqClient>(pClient)->SetFlushDelay(dwFlushDelay);
+}
+
+HPSOCKET_API void __HP_CALL HP_UdpArqClient_SetFecDataShards(HP_UdpArqClient pClient, DWORD dwDataShards)
+{
+	C_HP_Object::ToFirst<IArqClient>(pClient)->SetFecDataShards(dwDataShards);
+}
+
+HPSOCKET_API void __HP_CALL HP_UdpArqClient_SetFecParityShards(HP_UdpArqClient pClient, DWORD dwParityShards)
+{
+	C_HP_Object::ToFirst<IArqClient>(pClient)->SetFecParityShards(dwParityShards);
+}
+
+HPSOCKET_API void __HP_CALL HP_UdpArqClient_SetCongestCtrl(HP_UdpArqClient pClient, En_HP_ArqCongestCtrl enCongestCtrl)
+{
+	C_HP_Object::ToFirst<IArqClient>(pClient)->SetCongestCtrl(enCongestCtrl);
+}
+
+HPSOCKET_API void __HP_CALL HP_UdpArqClient_SetPacingRate(HP_UdpArqClient pClient, DWORD dwPacingRate)
+{
+	C_HP_Object::ToFirst<IArqClient>(pClient)->SetPacingRate(dwPacingRate);
+}
+
 HPSOCKET_API BOOL __HP_CALL HP_UdpArqClient_IsNoDelay(HP_UdpArqClient pClient)
 {
 	return C_HP_Object::ToFirst<IArqClient>(pClient)->IsNoDelay();
@@ -1675,11 +1950,41 @@ HPSOCKET_API DWORD __HP_CALL HP_UdpArqClient_GetHandShakeTimeout(HP_UdpArqClient
 	return C_HP_Object::ToFirst<IArqClient>(pClient)->GetHandShakeTimeout();
 }
 
+HPSOCKET_API DWORD __HP_CALL HP_UdpArqClient_GetFlushDelay(HP_UdpArqClient pClient)
+{
+	return C_HP_Object::ToFirst<IArqClient>(pClient)->GetFlushDelay();
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_UdpArqClient_GetFecDataShards(HP_UdpArqClient pClient)
+{
+	return C_HP_Object::ToFirst<IArqClient>(pClient)->GetFecDataShards();
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_UdpArqClient_GetFecParityShards(HP_UdpArqClient pClient)
+{
+	return C_HP_Object::ToFirst<IArqClient>(pClient)->GetFecParityShards();
+}
+
+HPSOCKET_API En_HP_ArqCongestCtrl __HP_CALL HP_UdpArqClient_GetCongestCtrl(HP_UdpArqClient pClient)
+{
+	return C_HP_Object::ToFirst<IArqClient>(pClient)->GetCongestCtrl();
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_UdpArqClient_GetPacingRate(HP_UdpArqClient pClient)
+{
+	return C_HP_Object::ToFirst<IArqClient>(pClient)->GetPacingRate();
+}
+
 HPSOCKET_API BOOL __HP_CALL HP_UdpArqClient_GetWaitingSendMessageCount(HP_UdpArqClient pClient, int* piCount)
 {
 	return C_HP_Object::ToFirst<IArqClient>(pClient)->GetWaitingSendMessageCount(*piCount);
 }
 
+HPSOCKET_API BOOL __HP_CALL HP_UdpArqClient_GetSessionStats(HP_UdpArqClient pClient, HP_TArqSessionStats* pStats)
+{
+	return C_HP_Object::ToFirst<IArqClient>(pClient)->GetSessionStats(*pStats);
+}
+
 /**********************************************************************************/
 /****************************** UDP Cast Էʷ ******************************/
 
@@ -1844,6 +2149,16 @@ HPSOCKET_API DWORD __HP_CALL HP_UdpNode_GetMaxDatagramSize(HP_UdpNode pNode)
 	return C_HP_Object::ToSecond<IUdpNode>(pNode)->GetMaxDatagramSize();
 }
 
+HPSOCKET_API void __HP_CALL HP_UdpNode_SetBatchReceive(HP_UdpNode pNode, BOOL bBatchReceive)
+{
+	C_HP_Object::ToSecond<IUdpNode>(pNode)->SetBatchReceive(bBatchReceive);
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_UdpNode_IsBatchReceive(HP_UdpNode pNode)
+{
+	return C_HP_Object::ToSecond<IUdpNode>(pNode)->IsBatchReceive();
+}
+
 HPSOCKET_API void __HP_CALL HP_UdpNode_SetMultiCastTtl(HP_UdpNode pNode, int iMCTtl)
 {
 	C_HP_Object::ToSecond<IUdpNode>(pNode)->SetMultiCastTtl(iMCTtl);
@@ -1914,6 +2229,46 @@ HPSOCKET_API DWORD __HP_CALL HP_UdpNode_GetFreeBufferPoolHold(HP_UdpNode pNode)
 	return C_HP_Object::ToSecond<IUdpNode>(pNode)->GetFreeBufferPoolHold();
 }
 
+HPSOCKET_API void __HP_CALL HP_UdpNode_SetCollectMetrics(HP_UdpNode pNode, BOOL bCollectMetrics)
+{
+	C_HP_Object::ToSecond<IUdpNode>(pNode)->SetCollectMetrics(bCollectMetrics);
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_UdpNode_IsCollectMetrics(HP_UdpNode pNode)
+{
+	return C_HP_Object::ToSecond<IUdpNode>(pNode)->IsCollectMetrics();
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_UdpNode_GetMetrics(HP_UdpNode pNode, HP_TSocketMetrics* pMetrics)
+{
+	return C_HP_Object::ToSecond<IUdpNode>(pNode)->GetMetrics(*pMetrics);
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_UdpNode_GetMetricsText(HP_UdpNode pNode, LPSTR lpszBuffer, int* piLength, LPCSTR lpszPrefix)
+{
+	return C_HP_Object::ToSecond<IUdpNode>(pNode)->GetMetricsText(lpszBuffer, *piLength, lpszPrefix);
+}
+
+HPSOCKET_API void __HP_CALL HP_UdpNode_SetSlowCallbackThreshold(HP_UdpNode pNode, DWORD dwSlowCallbackThreshold)
+{
+	C_HP_Object::ToSecond<IUdpNode>(pNode)->SetSlowCallbackThreshold(dwSlowCallbackThreshold);
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_UdpNode_GetSlowCallbackThreshold(HP_UdpNode pNode)
+{
+	return C_HP_Object::ToSecond<IUdpNode>(pNode)->GetSlowCallbackThreshold();
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_UdpNode_GetWorkerTraceStats(HP_UdpNode pNode, HP_TWorkerTraceStat stats[], DWORD* pdwCount)
+{
+	return C_HP_Object::ToSecond<IUdpNode>(pNode)->GetWorkerTraceStats(stats, *pdwCount);
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_UdpNode_GetSlowCallbacks(HP_UdpNode pNode, HP_TSlowCallback records[], DWORD* pdwCount)
+{
+	return C_HP_Object::ToSecond<IUdpNode>(pNode)->GetSlowCallbacks(records, *pdwCount);
+}
+
 #endif
 
 /***************************************************************************************/
@@ -2056,6 +2411,16 @@ HPSOCKET_API LPCTSTR __HP_CALL HP_GetSocketErrorDesc(En_HP_SocketError enCode)
 	return ::GetSocketErrorDesc(enCode);
 }
 
+HPSOCKET_API void __HP_CALL HP_EnterObjectEpoch()
+{
+	CEpochDomain::Enter();
+}
+
+HPSOCKET_API void __HP_CALL HP_LeaveObjectEpoch()
+{
+	CEpochDomain::Leave();
+}
+
 HPSOCKET_API DWORD __HP_CALL SYS_GetLastError()
 {
 	return ::GetLastError();
@@ -2720,6 +3085,11 @@ HPSOCKET_API BOOL __HP_CALL HP_HttpServer_SendResponse(HP_HttpServer pServer, HP
 	return C_HP_Object::ToFirst<IHttpServer>(pServer)->SendResponse(dwConnID, usStatusCode, lpszDesc, lpHeaders, iHeaderCount, pData, iLength);
 }
 
+HPSOCKET_API BOOL __HP_CALL HP_HttpServer_SendPipelineResponse(HP_HttpServer pServer, HP_CONNID dwConnID, DWORD dwSeq, USHORT usStatusCode, LPCSTR lpszDesc, const HP_THeader lpHeaders[], int iHeaderCount, const BYTE* pData, int iLength)
+{
+	return C_HP_Object::ToFirst<IHttpServer>(pServer)->SendPipelineResponse(dwConnID, dwSeq, usStatusCode, lpszDesc, lpHeaders, iHeaderCount, pData, iLength);
+}
+
 HPSOCKET_API BOOL __HP_CALL HP_HttpServer_SendLocalFile(HP_HttpServer pServer, HP_CONNID dwConnID, LPCSTR lpszFileName, USHORT usStatusCode, LPCSTR lpszDesc, const HP_THeader lpHeaders[], int iHeaderCount)
 {
 	return C_HP_Object::ToFirst<IHttpServer>(pServer)->SendLocalFile(dwConnID, lpszFileName, usStatusCode, lpszDesc, lpHeaders, iHeaderCount);
@@ -2730,6 +3100,16 @@ HPSOCKET_API BOOL __HP_CALL HP_HttpServer_SendChunkData(HP_HttpServer pServer, H
 	return C_HP_Object::ToFirst<IHttpServer>(pServer)->SendChunkData(dwConnID, pData, iLength, lpszExtensions);
 }
 
+HPSOCKET_API BOOL __HP_CALL HP_HttpServer_SendStreamResponse(HP_HttpServer pServer, HP_CONNID dwConnID, DWORD dwStreamID, USHORT usStatusCode, LPCSTR lpszDesc, const HP_THeader lpHeaders[], int iHeaderCount, const BYTE* pData, int iLength)
+{
+	return C_HP_Object::ToFirst<IHttpServer>(pServer)->SendStreamResponse(dwConnID, dwStreamID, usStatusCode, lpszDesc, lpHeaders, iHeaderCount, pData, iLength);
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_HttpServer_SendStreamChunkData(HP_HttpServer pServer, HP_CONNID dwConnID, DWORD dwStreamID, const BYTE* pData, int iLength)
+{
+	return C_HP_Object::ToFirst<IHttpServer>(pServer)->SendStreamChunkData(dwConnID, dwStreamID, pData, iLength);
+}
+
 HPSOCKET_API BOOL __HP_CALL HP_HttpServer_SendWSMessage(HP_HttpServer pServer, HP_CONNID dwConnID, BOOL bFinal, BYTE iReserved, BYTE iOperationCode, const BYTE* pData, int iLength, ULONGLONG ullBodyLen)
 {
 	return C_HP_Object::ToFirst<IHttpServer>(pServer)->SendWSMessage(dwConnID, bFinal, iReserved, iOperationCode, pData, iLength, ullBodyLen);
@@ -2758,6 +3138,31 @@ HPSOCKET_API DWORD __HP_CALL HP_HttpServer_GetReleaseDelay(HP_HttpServer pServer
 	return C_HP_Object::ToFirst<IHttpServer>(pServer)->GetReleaseDelay();
 }
 
+HPSOCKET_API void __HP_CALL HP_HttpServer_SetFastParse(HP_HttpServer pServer, BOOL bFastParse)
+{
+	C_HP_Object::ToFirst<IHttpServer>(pServer)->SetFastParse(bFastParse);
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_HttpServer_IsFastParse(HP_HttpServer pServer)
+{
+	return C_HP_Object::ToFirst<IHttpServer>(pServer)->IsFastParse();
+}
+
+HPSOCKET_API void __HP_CALL HP_HttpServer_SetMaxPipelineRequests(HP_HttpServer pServer, DWORD dwMaxPipelineRequests)
+{
+	C_HP_Object::ToFirst<IHttpServer>(pServer)->SetMaxPipelineRequests(dwMaxPipelineRequests);
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_HttpServer_GetMaxPipelineRequests(HP_HttpServer pServer)
+{
+	return C_HP_Object::ToFirst<IHttpServer>(pServer)->GetMaxPipelineRequests();
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_HttpServer_GetRequestSeq(HP_HttpServer pServer, HP_CONNID dwConnID)
+{
+	return C_HP_Object::ToFirst<IHttpServer>(pServer)->GetRequestSeq(dwConnID);
+}
+
 HPSOCKET_API USHORT __HP_CALL HP_HttpServer_GetUrlFieldSet(HP_HttpServer pServer, HP_CONNID dwConnID)
 {
 	return C_HP_Object::ToFirst<IHttpServer>(pServer)->GetUrlFieldSet(dwConnID);
@@ -2879,6 +3284,36 @@ HPSOCKET_API BOOL __HP_CALL HP_HttpServer_IsHttpAutoStart(HP_HttpServer pServer)
 	return C_HP_Object::ToFirst<IHttpServer>(pServer)->IsHttpAutoStart();
 }
 
+HPSOCKET_API void __HP_CALL HP_HttpServer_SetHttp2Support(HP_HttpServer pServer, BOOL bSupport)
+{
+	C_HP_Object::ToFirst<IHttpServer>(pServer)->SetHttp2Support(bSupport);
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_HttpServer_IsHttp2Support(HP_HttpServer pServer)
+{
+	return C_HP_Object::ToFirst<IHttpServer>(pServer)->IsHttp2Support();
+}
+
+HPSOCKET_API void __HP_CALL HP_HttpServer_SetHttp2MaxConcurrentStreams(HP_HttpServer pServer, DWORD dwMaxConcurrentStreams)
+{
+	C_HP_Object::ToFirst<IHttpServer>(pServer)->SetHttp2MaxConcurrentStreams(dwMaxConcurrentStreams);
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_HttpServer_GetHttp2MaxConcurrentStreams(HP_HttpServer pServer)
+{
+	return C_HP_Object::ToFirst<IHttpServer>(pServer)->GetHttp2MaxConcurrentStreams();
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_HttpServer_IsHttp2(HP_HttpServer pServer, HP_CONNID dwConnID)
+{
+	return C_HP_Object::ToFirst<IHttpServer>(pServer)->IsHttp2(dwConnID);
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_HttpServer_GetStreamID(HP_HttpServer pServer, HP_CONNID dwConnID)
+{
+	return C_HP_Object::ToFirst<IHttpServer>(pServer)->GetStreamID(dwConnID);
+}
+
 /**************************************************************************/
 /*************************** HTTP Agent  ***************************/
 
@@ -2897,6 +3332,16 @@ HPSOCKET_API BOOL __HP_CALL HP_HttpAgent_SendChunkData(HP_HttpAgent pAgent, HP_C
 	return C_HP_Object::ToFirst<IHttpAgent>(pAgent)->SendChunkData(dwConnID, pData, iLength, lpszExtensions);
 }
 
+HPSOCKET_API BOOL __HP_CALL HP_HttpAgent_SendStreamRequest(HP_HttpAgent pAgent, HP_CONNID dwConnID, DWORD* lpdwStreamID, LPCSTR lpszMethod, LPCSTR lpszPath, const HP_THeader lpHeaders[], int iHeaderCount, const BYTE* pBody, int iLength)
+{
+	return C_HP_Object::ToFirst<IHttpAgent>(pAgent)->SendStreamRequest(dwConnID, lpdwStreamID, lpszMethod, lpszPath, lpHeaders, iHeaderCount, pBody, iLength);
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_HttpAgent_SendStreamChunkData(HP_HttpAgent pAgent, HP_CONNID dwConnID, DWORD dwStreamID, const BYTE* pData, int iLength)
+{
+	return C_HP_Object::ToFirst<IHttpAgent>(pAgent)->SendStreamChunkData(dwConnID, dwStreamID, pData, iLength);
+}
+
 HPSOCKET_API BOOL __HP_CALL HP_HttpAgent_SendPost(HP_HttpAgent pAgent, HP_CONNID dwConnID, LPCSTR lpszPath, const HP_THeader lpHeaders[], int iHeaderCount, const BYTE* pBody, int iLength)
 {
 	return C_HP_Object::ToFirst<IHttpAgent>(pAgent)->SendPost(dwConnID, lpszPath, lpHeaders, iHeaderCount, pBody, iLength);
@@ -3070,6 +3515,36 @@ HPSOCKET_API BOOL __HP_CALL HP_HttpAgent_IsHttpAutoStart(HP_HttpAgent pAgent)
 	return C_HP_Object::ToFirst<IHttpAgent>(pAgent)->IsHttpAutoStart();
 }
 
+HPSOCKET_API void __HP_CALL HP_HttpAgent_SetHttp2Support(HP_HttpAgent pAgent, BOOL bSupport)
+{
+	C_HP_Object::ToFirst<IHttpAgent>(pAgent)->SetHttp2Support(bSupport);
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_HttpAgent_IsHttp2Support(HP_HttpAgent pAgent)
+{
+	return C_HP_Object::ToFirst<IHttpAgent>(pAgent)->IsHttp2Support();
+}
+
+HPSOCKET_API void __HP_CALL HP_HttpAgent_SetHttp2MaxConcurrentStreams(HP_HttpAgent pAgent, DWORD dwMaxConcurrentStreams)
+{
+	C_HP_Object::ToFirst<IHttpAgent>(pAgent)->SetHttp2MaxConcurrentStreams(dwMaxConcurrentStreams);
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_HttpAgent_GetHttp2MaxConcurrentStreams(HP_HttpAgent pAgent)
+{
+	return C_HP_Object::ToFirst<IHttpAgent>(pAgent)->GetHttp2MaxConcurrentStreams();
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_HttpAgent_IsHttp2(HP_HttpAgent pAgent, HP_CONNID dwConnID)
+{
+	return C_HP_Object::ToFirst<IHttpAgent>(pAgent)->IsHttp2(dwConnID);
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_HttpAgent_GetStreamID(HP_HttpAgent pAgent, HP_CONNID dwConnID)
+{
+	return C_HP_Object::ToFirst<IHttpAgent>(pAgent)->GetStreamID(dwConnID);
+}
+
 /**************************************************************************/
 /*************************** HTTP Client  **************************/
 
@@ -3088,6 +3563,16 @@ HPSOCKET_API BOOL __HP_CALL HP_HttpClient_SendChunkData(HP_HttpClient pClient, c
 	return C_HP_Object::ToFirst<IHttpClient>(pClient)->SendChunkData(pData, iLength, lpszExtensions);
 }
 
+HPSOCKET_API BOOL __HP_CALL HP_HttpClient_SendStreamRequest(HP_HttpClient pClient, DWORD* lpdwStreamID, LPCSTR lpszMethod, LPCSTR lpszPath, const HP_THeader lpHeaders[], int iHeaderCount, const BYTE* pBody, int iLength)
+{
+	return C_HP_Object::ToFirst<IHttpClient>(pClient)->SendStreamRequest(lpdwStreamID, lpszMethod, lpszPath, lpHeaders, iHeaderCount, pBody, iLength);
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_HttpClient_SendStreamChunkData(HP_HttpClient pClient, DWORD dwStreamID, const BYTE* pData, int iLength)
+{
+	return C_HP_Object::ToFirst<IHttpClient>(pClient)->SendStreamChunkData(dwStreamID, pData, iLength);
+}
+
 HPSOCKET_API BOOL __HP_CALL HP_HttpClient_SendPost(HP_HttpClient pClient, LPCSTR lpszPath, const HP_THeader lpHeaders[], int iHeaderCount, const BYTE* pBody, int iLength)
 {
 	return C_HP_Object::ToFirst<IHttpClient>(pClient)->SendPost(lpszPath, lpHeaders, iHeaderCount, pBody, iLength);
@@ -3261,6 +3746,36 @@ HPSOCKET_API BOOL __HP_CALL HP_HttpClient_IsHttpAutoStart(HP_HttpClient pClient)
 	return C_HP_Object::ToFirst<IHttpClient>(pClient)->IsHttpAutoStart();
 }
 
+HPSOCKET_API void __HP_CALL HP_HttpClient_SetHttp2Support(HP_HttpClient pClient, BOOL bSupport)
+{
+	C_HP_Object::ToFirst<IHttpClient>(pClient)->SetHttp2Support(bSupport);
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_HttpClient_IsHttp2Support(HP_HttpClient pClient)
+{
+	return C_HP_Object::ToFirst<IHttpClient>(pClient)->IsHttp2Support();
+}
+
+HPSOCKET_API void __HP_CALL HP_HttpClient_SetHttp2MaxConcurrentStreams(HP_HttpClient pClient, DWORD dwMaxConcurrentStreams)
+{
+	C_HP_Object::ToFirst<IHttpClient>(pClient)->SetHttp2MaxConcurrentStreams(dwMaxConcurrentStreams);
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_HttpClient_GetHttp2MaxConcurrentStreams(HP_HttpClient pClient)
+{
+	return C_HP_Object::ToFirst<IHttpClient>(pClient)->GetHttp2MaxConcurrentStreams();
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_HttpClient_IsHttp2(HP_HttpClient pClient)
+{
+	return C_HP_Object::ToFirst<IHttpClient>(pClient)->IsHttp2();
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_HttpClient_GetStreamID(HP_HttpClient pClient)
+{
+	return C_HP_Object::ToFirst<IHttpClient>(pClient)->GetStreamID();
+}
+
 /**************************************************************************/
 /************************ HTTP Sync Client  ************************/
 
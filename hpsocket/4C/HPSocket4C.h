@@ -150,6 +150,7 @@ typedef En_HP_HandleResult (__HP_CALL *HP_FN_Server_OnHandShake)		(HP_Server pSe
 typedef En_HP_HandleResult (__HP_CALL *HP_FN_Server_OnSend)				(HP_Server pSender, HP_CONNID dwConnID, const BYTE* pData, int iLength);
 typedef En_HP_HandleResult (__HP_CALL *HP_FN_Server_OnReceive)			(HP_Server pSender, HP_CONNID dwConnID, const BYTE* pData, int iLength);
 typedef En_HP_HandleResult (__HP_CALL *HP_FN_Server_OnPullReceive)		(HP_Server pSender, HP_CONNID dwConnID, int iLength);
+typedef En_HP_HandleResult (__HP_CALL *HP_FN_Server_OnReceiveBatch)		(HP_Server pSender, HP_CONNID dwConnID, const WSABUF pBuffers[], int iCount);
 typedef En_HP_HandleResult (__HP_CALL *HP_FN_Server_OnClose)			(HP_Server pSender, HP_CONNID dwConnID, En_HP_SocketOperation enOperation, int iErrorCode);
 typedef En_HP_HandleResult (__HP_CALL *HP_FN_Server_OnShutdown)			(HP_Server pSender);
 
@@ -160,6 +161,7 @@ typedef En_HP_HandleResult (__HP_CALL *HP_FN_Agent_OnHandShake)			(HP_Agent pSen
 typedef En_HP_HandleResult (__HP_CALL *HP_FN_Agent_OnSend)				(HP_Agent pSender, HP_CONNID dwConnID, const BYTE* pData, int iLength);
 typedef En_HP_HandleResult (__HP_CALL *HP_FN_Agent_OnReceive)			(HP_Agent pSender, HP_CONNID dwConnID, const BYTE* pData, int iLength);
 typedef En_HP_HandleResult (__HP_CALL *HP_FN_Agent_OnPullReceive)		(HP_Agent pSender, HP_CONNID dwConnID, int iLength);
+typedef En_HP_HandleResult (__HP_CALL *HP_FN_Agent_OnReceiveBatch)		(HP_Agent pSender, HP_CONNID dwConnID, const WSABUF pBuffers[], int iCount);
 typedef En_HP_HandleResult (__HP_CALL *HP_FN_Agent_OnClose)				(HP_Agent pSender, HP_CONNID dwConnID, En_HP_SocketOperation enOperation, int iErrorCode);
 typedef En_HP_HandleResult (__HP_CALL *HP_FN_Agent_OnShutdown)			(HP_Agent pSender);
 
@@ -178,6 +180,7 @@ typedef En_HP_HandleResult (__HP_CALL *HP_FN_Client_OnClose)			(HP_Client pSende
 typedef En_HP_HandleResult (__HP_CALL *HP_FN_UdpNode_OnPrepareListen)	(HP_UdpNode pSender, UINT_PTR soListen);
 typedef En_HP_HandleResult (__HP_CALL *HP_FN_UdpNode_OnSend)			(HP_UdpNode pSender, LPCTSTR lpszRemoteAddress, USHORT usRemotePort, const BYTE* pData, int iLength);
 typedef En_HP_HandleResult (__HP_CALL *HP_FN_UdpNode_OnReceive)			(HP_UdpNode pSender, LPCTSTR lpszRemoteAddress, USHORT usRemotePort, const BYTE* pData, int iLength);
+typedef En_HP_HandleResult (__HP_CALL *HP_FN_UdpNode_OnReceiveBatch)	(HP_UdpNode pSender, const HP_TUdpDatagram pDatagrams[], int iCount);
 typedef En_HP_HandleResult (__HP_CALL *HP_FN_UdpNode_OnError)			(HP_UdpNode pSender, En_HP_SocketOperation enOperation, int iErrorCode, LPCTSTR lpszRemoteAddress, USHORT usRemotePort, const BYTE* pData, int iLength);
 typedef En_HP_HandleResult (__HP_CALL *HP_FN_UdpNode_OnShutdown)		(HP_UdpNode pSender);
 
@@ -326,6 +329,7 @@ HPSOCKET_API void __HP_CALL HP_Set_FN_Server_OnHandShake(HP_ServerListener pList
 HPSOCKET_API void __HP_CALL HP_Set_FN_Server_OnSend(HP_ServerListener pListener				, HP_FN_Server_OnSend fn);
 HPSOCKET_API void __HP_CALL HP_Set_FN_Server_OnReceive(HP_ServerListener pListener			, HP_FN_Server_OnReceive fn);
 HPSOCKET_API void __HP_CALL HP_Set_FN_Server_OnPullReceive(HP_ServerListener pListener		, HP_FN_Server_OnPullReceive fn);
+HPSOCKET_API void __HP_CALL HP_Set_FN_Server_OnReceiveBatch(HP_ServerListener pListener		, HP_FN_Server_OnReceiveBatch fn);
 HPSOCKET_API void __HP_CALL HP_Set_FN_Server_OnClose(HP_ServerListener pListener			, HP_FN_Server_OnClose fn);
 HPSOCKET_API void __HP_CALL HP_Set_FN_Server_OnShutdown(HP_ServerListener pListener			, HP_FN_Server_OnShutdown fn);
 
@@ -338,6 +342,7 @@ HPSOCKET_API void __HP_CALL HP_Set_FN_Agent_OnHandShake(HP_AgentListener pListen
 HPSOCKET_API void __HP_CALL HP_Set_FN_Agent_OnSend(HP_AgentListener pListener				, HP_FN_Agent_OnSend fn);
 HPSOCKET_API void __HP_CALL HP_Set_FN_Agent_OnReceive(HP_AgentListener pListener			, HP_FN_Agent_OnReceive fn);
 HPSOCKET_API void __HP_CALL HP_Set_FN_Agent_OnPullReceive(HP_AgentListener pListener		, HP_FN_Agent_OnPullReceive fn);
+HPSOCKET_API void __HP_CALL HP_Set_FN_Agent_OnReceiveBatch(HP_AgentListener pListener		, HP_FN_Agent_OnReceiveBatch fn);
 HPSOCKET_API void __HP_CALL HP_Set_FN_Agent_OnClose(HP_AgentListener pListener				, HP_FN_Agent_OnClose fn);
 HPSOCKET_API void __HP_CALL HP_Set_FN_Agent_OnShutdown(HP_AgentListener pListener			, HP_FN_Agent_OnShutdown fn);
 
@@ -360,6 +365,7 @@ HPSOCKET_API void __HP_CALL HP_Set_FN_Client_OnClose(HP_ClientListener pListener
 HPSOCKET_API void __HP_CALL HP_Set_FN_UdpNode_OnPrepareListen(HP_UdpNodeListener pListener	, HP_FN_UdpNode_OnPrepareListen fn);
 HPSOCKET_API void __HP_CALL HP_Set_FN_UdpNode_OnSend(HP_UdpNodeListener pListener			, HP_FN_UdpNode_OnSend fn);
 HPSOCKET_API void __HP_CALL HP_Set_FN_UdpNode_OnReceive(HP_UdpNodeListener pListener		, HP_FN_UdpNode_OnReceive fn);
+HPSOCKET_API void __HP_CALL HP_Set_FN_UdpNode_OnReceiveBatch(HP_UdpNodeListener pListener	, HP_FN_UdpNode_OnReceiveBatch fn);
 HPSOCKET_API void __HP_CALL HP_Set_FN_UdpNode_OnError(HP_UdpNodeListener pListener			, HP_FN_UdpNode_OnError fn);
 HPSOCKET_API void __HP_CALL HP_Set_FN_UdpNode_OnShutdown(HP_UdpNodeListener pListener		, HP_FN_UdpNode_OnShutdown fn);
 
@@ -544,8 +550,8 @@ HPSOCKET_API void __HP_CALL HP_Server_SetReuseAddressPolicy(HP_Server pServer, E
 HPSOCKET_API void __HP_CALL HP_Server_SetSendPolicy(HP_Server pServer, En_HP_SendPolicy enSendPolicy);
 /*  OnSend ¼ͬԣ Linux ƽ̨Ч */
 HPSOCKET_API void __HP_CALL HP_Server_SetOnSendSyncPolicy(HP_Server pServer, En_HP_OnSendSyncPolicy enSyncPolicy);
-//*  Socket ʱ䣨룬ڼ Socket ܱȡʹã */
-HPSOCKET_API void __HP_CALL HP_Server_SetFreeSocketObjLockTime(HP_Server pServer, DWORD dwFreeSocketObjLockTime);
+/*  OnSend ¼֪ͨԣĬϣOSNP_EACH */
+HPSOCKET_API void __HP_CALL HP_Server_SetOnSendNotifyPolicy(HP_Server pServer, En_HP_OnSendNotifyPolicy enNotifyPolicy);
 /*  Socket شСͨΪƽ 1/3 - 1/2 */
 HPSOCKET_API void __HP_CALL HP_Server_SetFreeSocketObjPool(HP_Server pServer, DWORD dwFreeSocketObjPool);
 /* ڴ黺شСͨΪ Socket شС 2 - 3  */
@@ -567,8 +573,8 @@ HPSOCKET_API En_HP_ReuseAddressPolicy __HP_CALL HP_Server_GetReuseAddressPolicy(
 HPSOCKET_API En_HP_SendPolicy __HP_CALL HP_Server_GetSendPolicy(HP_Server pServer);
 /* ȡ OnSend ¼ͬԣ Linux ƽ̨Ч */
 HPSOCKET_API En_HP_OnSendSyncPolicy __HP_CALL HP_Server_GetOnSendSyncPolicy(HP_Server pServer);
-//* ȡ Socket ʱ */
-HPSOCKET_API DWORD __HP_CALL HP_Server_GetFreeSocketObjLockTime(HP_Server pServer);
+/* ȡ OnSend ¼֪ͨ */
+HPSOCKET_API En_HP_OnSendNotifyPolicy __HP_CALL HP_Server_GetOnSendNotifyPolicy(HP_Server pServer);
 /* ȡ Socket شС */
 HPSOCKET_API DWORD __HP_CALL HP_Server_GetFreeSocketObjPool(HP_Server pServer);
 /* ȡڴ黺شС */
@@ -584,6 +590,24 @@ HPSOCKET_API DWORD __HP_CALL HP_Server_GetWorkerThreadCount(HP_Server pServer);
 /* ǷǾĬʱ */
 HPSOCKET_API BOOL __HP_CALL HP_Server_IsMarkSilence(HP_Server pServer);
 
+/* Ƿɼʱ */
+HPSOCKET_API void __HP_CALL HP_Server_SetCollectMetrics(HP_Server pServer, BOOL bCollectMetrics);
+/* Ƿɼʱ */
+HPSOCKET_API BOOL __HP_CALL HP_Server_IsCollectMetrics(HP_Server pServer);
+/* ȡʱ */
+HPSOCKET_API BOOL __HP_CALL HP_Server_GetMetrics(HP_Server pServer, HP_TSocketMetrics* pMetrics);
+/* ȡ Prometheus ʽʱʱ FALSEpiLength 賤ȣ */
+HPSOCKET_API BOOL __HP_CALL HP_Server_GetMetricsText(HP_Server pServer, LPSTR lpszBuffer, int* piLength, LPCSTR lpszPrefix);
+
+/* صֵ΢룬0 ʾر¼ѭ٣ */
+HPSOCKET_API void __HP_CALL HP_Server_SetSlowCallbackThreshold(HP_Server pServer, DWORD dwSlowCallbackThreshold);
+/* ȡصֵ */
+HPSOCKET_API DWORD __HP_CALL HP_Server_GetSlowCallbackThreshold(HP_Server pServer);
+/* ȡ̸߳ͳƣ鲻ʱ FALSEpdwCount 賤ȣ */
+HPSOCKET_API BOOL __HP_CALL HP_Server_GetWorkerTraceStats(HP_Server pServer, HP_TWorkerTraceStat stats[], DWORD* pdwCount);
+/* ص¼鲻ʱ FALSEpdwCount 賤ȣ */
+HPSOCKET_API BOOL __HP_CALL HP_Server_GetSlowCallbacks(HP_Server pServer, HP_TSlowCallback records[], DWORD* pdwCount);
+
 /**********************************************************************************/
 /******************************* TCP Server  *******************************/
 
@@ -609,6 +633,14 @@ HPSOCKET_API void __HP_CALL HP_TcpServer_SetSocketListenQueue(HP_TcpServer pServ
 HPSOCKET_API void __HP_CALL HP_TcpServer_SetAcceptSocketCount(HP_TcpServer pServer, DWORD dwAcceptSocketCount);
 /* ͨݻСƽͨݰСãͨΪ 1024 ı */
 HPSOCKET_API void __HP_CALL HP_TcpServer_SetSocketBufferSize(HP_TcpServer pServer, DWORD dwSocketBufferSize);
+/* ǷգTRUEͬһ¼жȡͨһ OnReceiveBatch صĬϣFALSE */
+HPSOCKET_API void __HP_CALL HP_TcpServer_SetBatchReceive(HP_TcpServer pServer, BOOL bBatchReceive);
+/* õÿ¼ĶдֽԤ㣨0 ֻƶдĬϣ256 * 1024þԤƳٵ¼֮ */
+HPSOCKET_API void __HP_CALL HP_TcpServer_SetIoBytesBudget(HP_TcpServer pServer, DWORD dwIoBytesBudget);
+/* õÿ¼ʱԤ㣨΢룬0 ƣĬϣ0 */
+HPSOCKET_API void __HP_CALL HP_TcpServer_SetIoTimeBudget(HP_TcpServer pServer, DWORD dwIoTimeBudget);
+/* ǷʹñԵTRUE¼ EV_CLEAR ʽעᲢȡ EAGAINÿδãĬϣFALSE */
+HPSOCKET_API void __HP_CALL HP_TcpServer_SetEdgeTrigger(HP_TcpServer pServer, BOOL bEdgeTrigger);
 /* 룬0 򲻷Ĭϣ60 * 1000 */
 HPSOCKET_API void __HP_CALL HP_TcpServer_SetKeepAliveTime(HP_TcpServer pServer, DWORD dwKeepAliveTime);
 /* 쳣룬0 Ĭϣ20 * 1000ɴ [ĬϣWinXP 5 , Win7 10 ] ⲻȷϰΪѶߣ */
@@ -618,6 +650,14 @@ HPSOCKET_API void __HP_CALL HP_TcpServer_SetKeepAliveInterval(HP_TcpServer pServ
 HPSOCKET_API DWORD __HP_CALL HP_TcpServer_GetAcceptSocketCount(HP_TcpServer pServer);
 /* ȡͨݻС */
 HPSOCKET_API DWORD __HP_CALL HP_TcpServer_GetSocketBufferSize(HP_TcpServer pServer);
+/* Ƿ */
+HPSOCKET_API BOOL __HP_CALL HP_TcpServer_IsBatchReceive(HP_TcpServer pServer);
+/* ȡÿ¼ĶдֽԤ */
+HPSOCKET_API DWORD __HP_CALL HP_TcpServer_GetIoBytesBudget(HP_TcpServer pServer);
+/* ȡÿ¼ʱԤ */
+HPSOCKET_API DWORD __HP_CALL HP_TcpServer_GetIoTimeBudget(HP_TcpServer pServer);
+/* ǷʹñԵ */
+HPSOCKET_API BOOL __HP_CALL HP_TcpServer_IsEdgeTrigger(HP_TcpServer pServer);
 /* ȡ Socket ĵȺдС */
 HPSOCKET_API DWORD __HP_CALL HP_TcpServer_GetSocketListenQueue(HP_TcpServer pServer);
 /* ȡ */
@@ -674,6 +714,16 @@ HPSOCKET_API void __HP_CALL HP_UdpArqServer_SetMaxTransUnit(HP_UdpArqServer pSer
 HPSOCKET_API void __HP_CALL HP_UdpArqServer_SetMaxMessageSize(HP_UdpArqServer pServer, DWORD dwMaxMessageSize);
 /* ֳʱʱ䣨룬Ĭϣ5000 */
 HPSOCKET_API void __HP_CALL HP_UdpArqServer_SetHandShakeTimeout(HP_UdpArqServer pServer, DWORD dwHandShakeTimeout);
+/* ˢӳ٣룬Ĭϣ0ÿηˢ£ 0 ϲηͼ ACKڸӳڻһ MTU ʱˢ£ */
+HPSOCKET_API void __HP_CALL HP_UdpArqServer_SetFlushDelay(HP_UdpArqServer pServer, DWORD dwFlushDelay);
+/*  FEC ݷƬĬϣ0УƬ 0 ʱ FEC˱һ£ */
+HPSOCKET_API void __HP_CALL HP_UdpArqServer_SetFecDataShards(HP_UdpArqServer pServer, DWORD dwDataShards);
+/*  FEC УƬĬϣ0ÿɻָʧķƬݷƬУƬ֮Ͳ 255 */
+HPSOCKET_API void __HP_CALL HP_UdpArqServer_SetFecParityShards(HP_UdpArqServer pServer, DWORD dwParityShards);
+/* ӵ㷨ĬϣACC_KCP */
+HPSOCKET_API void __HP_CALL HP_UdpArqServer_SetCongestCtrl(HP_UdpArqServer pServer, En_HP_ArqCongestCtrl enCongestCtrl);
+/* ÷ʣֽ/룬Ĭϣ0ACC_FIXED_RATE Ĺ̶ʣACC_BBR ķޣ0 ƣ */
+HPSOCKET_API void __HP_CALL HP_UdpArqServer_SetPacingRate(HP_UdpArqServer pServer, DWORD dwPacingRate);
 
 /* Ƿ nodelay ģʽ */
 HPSOCKET_API BOOL __HP_CALL HP_UdpArqServer_IsNoDelay(HP_UdpArqServer pServer);
@@ -697,9 +747,21 @@ HPSOCKET_API DWORD __HP_CALL HP_UdpArqServer_GetMaxTransUnit(HP_UdpArqServer pSe
 HPSOCKET_API DWORD __HP_CALL HP_UdpArqServer_GetMaxMessageSize(HP_UdpArqServer pServer);
 /* ȡֳʱʱ */
 HPSOCKET_API DWORD __HP_CALL HP_UdpArqServer_GetHandShakeTimeout(HP_UdpArqServer pServer);
+/* ȡˢӳ */
+HPSOCKET_API DWORD __HP_CALL HP_UdpArqServer_GetFlushDelay(HP_UdpArqServer pServer);
+/* ȡ FEC ݷƬ */
+HPSOCKET_API DWORD __HP_CALL HP_UdpArqServer_GetFecDataShards(HP_UdpArqServer pServer);
+/* ȡ FEC УƬ */
+HPSOCKET_API DWORD __HP_CALL HP_UdpArqServer_GetFecParityShards(HP_UdpArqServer pServer);
+/* ȡӵ㷨 */
+HPSOCKET_API En_HP_ArqCongestCtrl __HP_CALL HP_UdpArqServer_GetCongestCtrl(HP_UdpArqServer pServer);
+/* ȡ */
+HPSOCKET_API DWORD __HP_CALL HP_UdpArqServer_GetPacingRate(HP_UdpArqServer pServer);
 
 /* ȡȴͰ */
 HPSOCKET_API BOOL __HP_CALL HP_UdpArqServer_GetWaitingSendMessageCount(HP_UdpArqServer pServer, HP_CONNID dwConnID, int* piCount);
+/* ȡӵӵ״̬ӵڡRTTʵȣ */
+HPSOCKET_API BOOL __HP_CALL HP_UdpArqServer_GetSessionStats(HP_UdpArqServer pServer, HP_CONNID dwConnID, HP_TArqSessionStats* pStats);
 
 #endif
 
@@ -962,8 +1024,8 @@ HPSOCKET_API void __HP_CALL HP_Agent_SetReuseAddressPolicy(HP_Agent pAgent, En_H
 HPSOCKET_API void __HP_CALL HP_Agent_SetSendPolicy(HP_Agent pAgent, En_HP_SendPolicy enSendPolicy);
 /*  OnSend ¼ͬԣ Linux ƽ̨Ч */
 HPSOCKET_API void __HP_CALL HP_Agent_SetOnSendSyncPolicy(HP_Agent pAgent, En_HP_OnSendSyncPolicy enSyncPolicy);
-/*  Socket ʱ䣨룬ڼ Socket ܱȡʹã */
-HPSOCKET_API void __HP_CALL HP_Agent_SetFreeSocketObjLockTime(HP_Agent pAgent, DWORD dwFreeSocketObjLockTime);
+/*  OnSend ¼֪ͨԣĬϣOSNP_EACH */
+HPSOCKET_API void __HP_CALL HP_Agent_SetOnSendNotifyPolicy(HP_Agent pAgent, En_HP_OnSendNotifyPolicy enNotifyPolicy);
 /*  Socket شСͨΪƽ 1/3 - 1/2 */
 HPSOCKET_API void __HP_CALL HP_Agent_SetFreeSocketObjPool(HP_Agent pAgent, DWORD dwFreeSocketObjPool);
 /* ڴ黺شСͨΪ Socket شС 2 - 3  */
@@ -985,8 +1047,8 @@ HPSOCKET_API En_HP_ReuseAddressPolicy __HP_CALL HP_Agent_GetReuseAddressPolicy(H
 HPSOCKET_API En_HP_SendPolicy __HP_CALL HP_Agent_GetSendPolicy(HP_Agent pAgent);
 /* ȡ OnSend ¼ͬԣ Linux ƽ̨Ч */
 HPSOCKET_API En_HP_OnSendSyncPolicy __HP_CALL HP_Agent_GetOnSendSyncPolicy(HP_Agent pAgent);
-/* ȡ Socket ʱ */
-HPSOCKET_API DWORD __HP_CALL HP_Agent_GetFreeSocketObjLockTime(HP_Agent pAgent);
+/* ȡ OnSend ¼֪ͨ */
+HPSOCKET_API En_HP_OnSendNotifyPolicy __HP_CALL HP_Agent_GetOnSendNotifyPolicy(HP_Agent pAgent);
 /* ȡ Socket شС */
 HPSOCKET_API DWORD __HP_CALL HP_Agent_GetFreeSocketObjPool(HP_Agent pAgent);
 /* ȡڴ黺شС */
@@ -1002,6 +1064,24 @@ HPSOCKET_API DWORD __HP_CALL HP_Agent_GetWorkerThreadCount(HP_Agent pAgent);
 /* ǷǾĬʱ */
 HPSOCKET_API BOOL __HP_CALL HP_Agent_IsMarkSilence(HP_Agent pAgent);
 
+/* Ƿɼʱ */
+HPSOCKET_API void __HP_CALL HP_Agent_SetCollectMetrics(HP_Agent pAgent, BOOL bCollectMetrics);
+/* Ƿɼʱ */
+HPSOCKET_API BOOL __HP_CALL HP_Agent_IsCollectMetrics(HP_Agent pAgent);
+/* ȡʱ */
+HPSOCKET_API BOOL __HP_CALL HP_Agent_GetMetrics(HP_Agent pAgent, HP_TSocketMetrics* pMetrics);
+/* ȡ Prometheus ʽʱʱ FALSEpiLength 賤ȣ */
+HPSOCKET_API BOOL __HP_CALL HP_Agent_GetMetricsText(HP_Agent pAgent, LPSTR lpszBuffer, int* piLength, LPCSTR lpszPrefix);
+
+/* صֵ΢룬0 ʾر¼ѭ٣ */
+HPSOCKET_API void __HP_CALL HP_Agent_SetSlowCallbackThreshold(HP_Agent pAgent, DWORD dwSlowCallbackThreshold);
+/* ȡصֵ */
+HPSOCKET_API DWORD __HP_CALL HP_Agent_GetSlowCallbackThreshold(HP_Agent pAgent);
+/* ȡ̸߳ͳƣ鲻ʱ FALSEpdwCount 賤ȣ */
+HPSOCKET_API BOOL __HP_CALL HP_Agent_GetWorkerTraceStats(HP_Agent pAgent, HP_TWorkerTraceStat stats[], DWORD* pdwCount);
+/* ص¼鲻ʱ FALSEpdwCount 賤ȣ */
+HPSOCKET_API BOOL __HP_CALL HP_Agent_GetSlowCallbacks(HP_Agent pAgent, HP_TSlowCallback records[], DWORD* pdwCount);
+
 /**********************************************************************************/
 /******************************* TCP Agent  *******************************/
 
@@ -1023,6 +1103,14 @@ HPSOCKET_API BOOL __HP_CALL HP_TcpAgent_SendSmallFile(HP_Agent pAgent, HP_CONNID
 
 /* ͨݻСƽͨݰСãͨΪ 1024 ı */
 HPSOCKET_API void __HP_CALL HP_TcpAgent_SetSocketBufferSize(HP_TcpAgent pAgent, DWORD dwSocketBufferSize);
+/* ǷգTRUEͬһ¼жȡͨһ OnReceiveBatch صĬϣFALSE */
+HPSOCKET_API void __HP_CALL HP_TcpAgent_SetBatchReceive(HP_TcpAgent pAgent, BOOL bBatchReceive);
+/* õÿ¼ĶдֽԤ㣨0 ֻƶдĬϣ256 * 1024þԤƳٵ¼֮ */
+HPSOCKET_API void __HP_CALL HP_TcpAgent_SetIoBytesBudget(HP_TcpAgent pAgent, DWORD dwIoBytesBudget);
+/* õÿ¼ʱԤ㣨΢룬0 ƣĬϣ0 */
+HPSOCKET_API void __HP_CALL HP_TcpAgent_SetIoTimeBudget(HP_TcpAgent pAgent, DWORD dwIoTimeBudget);
+/* ǷʹñԵTRUE¼ EV_CLEAR ʽעᲢȡ EAGAINÿδãĬϣFALSE */
+HPSOCKET_API void __HP_CALL HP_TcpAgent_SetEdgeTrigger(HP_TcpAgent pAgent, BOOL bEdgeTrigger);
 /* 룬0 򲻷Ĭϣ60 * 1000 */
 HPSOCKET_API void __HP_CALL HP_TcpAgent_SetKeepAliveTime(HP_TcpAgent pAgent, DWORD dwKeepAliveTime);
 /* 쳣룬0 Ĭϣ20 * 1000ɴ [ĬϣWinXP 5 , Win7 10 ] ⲻȷϰΪѶߣ */
@@ -1030,6 +1118,14 @@ HPSOCKET_API void __HP_CALL HP_TcpAgent_SetKeepAliveInterval(HP_TcpAgent pAgent,
 
 /* ȡͨݻС */
 HPSOCKET_API DWORD __HP_CALL HP_TcpAgent_GetSocketBufferSize(HP_TcpAgent pAgent);
+/* Ƿ */
+HPSOCKET_API BOOL __HP_CALL HP_TcpAgent_IsBatchReceive(HP_TcpAgent pAgent);
+/* ȡÿ¼ĶдֽԤ */
+HPSOCKET_API DWORD __HP_CALL HP_TcpAgent_GetIoBytesBudget(HP_TcpAgent pAgent);
+/* ȡÿ¼ʱԤ */
+HPSOCKET_API DWORD __HP_CALL HP_TcpAgent_GetIoTimeBudget(HP_TcpAgent pAgent);
+/* ǷʹñԵ */
+HPSOCKET_API BOOL __HP_CALL HP_TcpAgent_IsEdgeTrigger(HP_TcpAgent pAgent);
 /* ȡ */
 HPSOCKET_API DWORD __HP_CALL HP_TcpAgent_GetKeepAliveTime(HP_TcpAgent pAgent);
 /* ȡ쳣 */
@@ -1188,6 +1284,15 @@ HPSOCKET_API DWORD __HP_CALL HP_Client_GetFreeBufferPoolSize(HP_Client pClient);
 /* ȡڴ黺ػշֵ */
 HPSOCKET_API DWORD __HP_CALL HP_Client_GetFreeBufferPoolHold(HP_Client pClient);
 
+/* Ƿɼʱ */
+HPSOCKET_API void __HP_CALL HP_Client_SetCollectMetrics(HP_Client pClient, BOOL bCollectMetrics);
+/* Ƿɼʱ */
+HPSOCKET_API BOOL __HP_CALL HP_Client_IsCollectMetrics(HP_Client pClient);
+/* ȡʱ */
+HPSOCKET_API BOOL __HP_CALL HP_Client_GetMetrics(HP_Client pClient, HP_TSocketMetrics* pMetrics);
+/* ȡ Prometheus ʽʱʱ FALSEpiLength 賤ȣ */
+HPSOCKET_API BOOL __HP_CALL HP_Client_GetMetricsText(HP_Client pClient, LPSTR lpszBuffer, int* piLength, LPCSTR lpszPrefix);
+
 /**********************************************************************************/
 /******************************* TCP Client  *******************************/
 
@@ -1264,6 +1369,16 @@ HPSOCKET_API void __HP_CALL HP_UdpArqClient_SetMaxTransUnit(HP_UdpArqClient pCli
 HPSOCKET_API void __HP_CALL HP_UdpArqClient_SetMaxMessageSize(HP_UdpArqClient pClient, DWORD dwMaxMessageSize);
 /* ֳʱʱ䣨룬Ĭϣ5000 */
 HPSOCKET_API void __HP_CALL HP_UdpArqClient_SetHandShakeTimeout(HP_UdpArqClient pClient, DWORD dwHandShakeTimeout);
+/* ˢӳ٣룬Ĭϣ0ÿηˢ£ 0 ϲηͼ ACKڸӳڻһ MTU ʱˢ£ */
+HPSOCKET_API void __HP_CALL HP_UdpArqClient_SetFlushDelay(HP_UdpArqClient pClient, DWORD dwFlushDelay);
+/*  FEC ݷƬĬϣ0УƬ 0 ʱ FEC˱һ£ */
+HPSOCKET_API void __HP_CALL HP_UdpArqClient_SetFecDataShards(HP_UdpArqClient pClient, DWORD dwDataShards);
+/*  FEC УƬĬϣ0ÿɻָʧķƬݷƬУƬ֮Ͳ 255 */
+HPSOCKET_API void __HP_CALL HP_UdpArqClient_SetFecParityShards(HP_UdpArqClient pClient, DWORD dwParityShards);
+/* ӵ㷨ĬϣACC_KCP */
+HPSOCKET_API void __HP_CALL HP_UdpArqClient_SetCongestCtrl(HP_UdpArqClient pClient, En_HP_ArqCongestCtrl enCongestCtrl);
+/* ÷ʣֽ/룬Ĭϣ0ACC_FIXED_RATE Ĺ̶ʣACC_BBR ķޣ0 ƣ */
+HPSOCKET_API void __HP_CALL HP_UdpArqClient_SetPacingRate(HP_UdpArqClient pClient, DWORD dwPacingRate);
 
 /* Ƿ nodelay ģʽ */
 HPSOCKET_API BOOL __HP_CALL HP_UdpArqClient_IsNoDelay(HP_UdpArqClient pClient);
@@ -1287,9 +1402,21 @@ HPSOCKET_API DWORD __HP_CALL HP_UdpArqClient_GetMaxTransUnit(HP_UdpArqClient pCl
 HPSOCKET_API DWORD __HP_CALL HP_UdpArqClient_GetMaxMessageSize(HP_UdpArqClient pClient);
 /* ȡֳʱʱ */
 HPSOCKET_API DWORD __HP_CALL HP_UdpArqClient_GetHandShakeTimeout(HP_UdpArqClient pClient);
+/* ȡˢӳ */
+HPSOCKET_API DWORD __HP_CALL HP_UdpArqClient_GetFlushDelay(HP_UdpArqClient pClient);
+/* ȡ FEC ݷƬ */
+HPSOCKET_API DWORD __HP_CALL HP_UdpArqClient_GetFecDataShards(HP_UdpArqClient pClient);
+/* ȡ FEC УƬ */
+HPSOCKET_API DWORD __HP_CALL HP_UdpArqClient_GetFecParityShards(HP_UdpArqClient pClient);
+/* ȡӵ㷨 */
+HPSOCKET_API En_HP_ArqCongestCtrl __HP_CALL HP_UdpArqClient_GetCongestCtrl(HP_UdpArqClient pClient);
+/* ȡ */
+HPSOCKET_API DWORD __HP_CALL HP_UdpArqClient_GetPacingRate(HP_UdpArqClient pClient);
 
 /* ȡȴͰ */
 HPSOCKET_API BOOL __HP_CALL HP_UdpArqClient_GetWaitingSendMessageCount(HP_UdpArqClient pClient, int* piCount);
+/* ȡӵӵ״̬ӵڡRTTʵȣ */
+HPSOCKET_API BOOL __HP_CALL HP_UdpArqClient_GetSessionStats(HP_UdpArqClient pClient, HP_TArqSessionStats* pStats);
 
 /**********************************************************************************/
 /****************************** UDP Cast Էʷ ******************************/
@@ -1465,6 +1592,11 @@ HPSOCKET_API void __HP_CALL HP_UdpNode_SetMaxDatagramSize(HP_UdpNode pNode, DWOR
 /* ȡݱ󳤶 */
 HPSOCKET_API DWORD __HP_CALL HP_UdpNode_GetMaxDatagramSize(HP_UdpNode pNode);
 
+/* ǷգTRUEͬһ¼нյݱͨһ OnReceiveBatch صĬϣFALSE */
+HPSOCKET_API void __HP_CALL HP_UdpNode_SetBatchReceive(HP_UdpNode pNode, BOOL bBatchReceive);
+/* Ƿ */
+HPSOCKET_API BOOL __HP_CALL HP_UdpNode_IsBatchReceive(HP_UdpNode pNode);
+
 /* 鲥ĵ TTL0 - 255 */
 HPSOCKET_API void __HP_CALL HP_UdpNode_SetMultiCastTtl(HP_UdpNode pNode, int iMCTtl);
 /* ȡ鲥ĵ TTL */
@@ -1497,6 +1629,24 @@ HPSOCKET_API DWORD __HP_CALL HP_UdpNode_GetFreeBufferPoolSize(HP_UdpNode pNode);
 /* ȡڴ黺ػշֵ */
 HPSOCKET_API DWORD __HP_CALL HP_UdpNode_GetFreeBufferPoolHold(HP_UdpNode pNode);
 
+/* Ƿɼʱ */
+HPSOCKET_API void __HP_CALL HP_UdpNode_SetCollectMetrics(HP_UdpNode pNode, BOOL bCollectMetrics);
+/* Ƿɼʱ */
+HPSOCKET_API BOOL __HP_CALL HP_UdpNode_IsCollectMetrics(HP_UdpNode pNode);
+/* ȡʱ */
+HPSOCKET_API BOOL __HP_CALL HP_UdpNode_GetMetrics(HP_UdpNode pNode, HP_TSocketMetrics* pMetrics);
+/* ȡ Prometheus ʽʱʱ FALSEpiLength 賤ȣ */
+HPSOCKET_API BOOL __HP_CALL HP_UdpNode_GetMetricsText(HP_UdpNode pNode, LPSTR lpszBuffer, int* piLength, LPCSTR lpszPrefix);
+
+/* صֵ΢룬0 ʾر¼ѭ٣ */
+HPSOCKET_API void __HP_CALL HP_UdpNode_SetSlowCallbackThreshold(HP_UdpNode pNode, DWORD dwSlowCallbackThreshold);
+/* ȡصֵ */
+HPSOCKET_API DWORD __HP_CALL HP_UdpNode_GetSlowCallbackThreshold(HP_UdpNode pNode);
+/* ȡ̸߳ͳƣ鲻ʱ FALSEpdwCount 賤ȣ */
+HPSOCKET_API BOOL __HP_CALL HP_UdpNode_GetWorkerTraceStats(HP_UdpNode pNode, HP_TWorkerTraceStat stats[], DWORD* pdwCount);
+/* ص¼鲻ʱ FALSEpdwCount 賤ȣ */
+HPSOCKET_API BOOL __HP_CALL HP_UdpNode_GetSlowCallbacks(HP_UdpNode pNode, HP_TSlowCallback records[], DWORD* pdwCount);
+
 #endif
 
 /***************************************************************************************/
@@ -1640,6 +1790,10 @@ HPSOCKET_API DWORD __HP_CALL HP_GetHPSocketVersion();
 
 /* ȡı */
 HPSOCKET_API LPCTSTR __HP_CALL HP_GetSocketErrorDesc(En_HP_SocketError enCode);
+/* ʱΣǶף¼ص֮ HP_HttpServer_GetHeader() ȷַָķʱڱڵòʹ÷صָ */
+HPSOCKET_API void __HP_CALL HP_EnterObjectEpoch();
+/* 뿪ʱΣ HP_EnterObjectEpoch() ɶԵãұͬһ߳еã */
+HPSOCKET_API void __HP_CALL HP_LeaveObjectEpoch();
 // ϵͳ errno ȡϵͳ
 HPSOCKET_API DWORD __HP_CALL SYS_GetLastError();
 // ϵͳ strerror() ȡϵͳ
@@ -1992,6 +2146,26 @@ HPSOCKET_API void __HP_CALL HP_Set_FN_HttpClient_OnClose(HP_HttpClientListener p
 */
 HPSOCKET_API BOOL __HP_CALL HP_HttpServer_SendResponse(HP_HttpServer pServer, HP_CONNID dwConnID, USHORT usStatusCode, LPCSTR lpszDesc, const HP_THeader lpHeaders[], int iHeaderCount, const BYTE* pData, int iLength);
 
+/*
+* ƣŻظ
+* ˮߣHP_HttpServer_SetMaxPipelineRequests() > 0ʱظָŵ HTTP 
+*		ظ˳ͣŽϴĻظڽĻظύʱ棻
+*		δظﵽʱֹͣͷURL ֻڸ¼صЧ
+*		¼ص֮첽ظʱ OnHeadersComplete ¼и
+*		
+* 		dwConnID		--  ID
+*			dwSeq			-- ţͨ HP_HttpServer_GetRequestSeq() ȡ
+*			usStatusCode	-- HTTP ״̬
+*			lpszDesc		-- HTTP ״̬
+*			lpHeaders		-- ظͷ
+*			iHeaderCount	-- ظͷ
+*			pData			-- ظ
+*			iLength			-- ظ峤
+* ֵ	TRUE			-- ɹ
+*			FALSE			-- ʧ
+*/
+HPSOCKET_API BOOL __HP_CALL HP_HttpServer_SendPipelineResponse(HP_HttpServer pServer, HP_CONNID dwConnID, DWORD dwSeq, USHORT usStatusCode, LPCSTR lpszDesc, const HP_THeader lpHeaders[], int iHeaderCount, const BYTE* pData, int iLength);
+
 /*
 * ƣͱļ
 * ָӷ 4096 KB µСļ
@@ -2020,6 +2194,37 @@ HPSOCKET_API BOOL __HP_CALL HP_HttpServer_SendLocalFile(HP_HttpServer pServer, H
 */
 HPSOCKET_API BOOL __HP_CALL HP_HttpServer_SendChunkData(HP_HttpServer pServer, HP_CONNID dwConnID, const BYTE* pData /*= nullptr*/, int iLength /*= 0*/, LPCSTR lpszExtensions /*= nullptr*/);
 
+/*
+* ƣظ HTTP/2 
+*  HTTP/2 ӵָظ ID ͨ HP_HttpServer_GetStreamID() ȡHTTP/2 ״̬lpszDesc ԣ
+*		HTTP/2  HP_HttpServer_SendResponse() ȷֻ¼صеã첽ظʱӦ OnMessageBegin ¼б ID ñ
+*		
+* 		dwConnID		--  ID
+*			dwStreamID		--  ID
+*			usStatusCode	-- HTTP ״̬
+*			lpszDesc		-- HTTP ״̬
+*			lpHeaders		-- ظͷ
+*			iHeaderCount	-- ظͷ
+*			pData			-- ظ
+*			iLength			-- ظ峤
+* ֵ	TRUE			-- ɹ
+*			FALSE			-- ʧ
+*/
+HPSOCKET_API BOOL __HP_CALL HP_HttpServer_SendStreamResponse(HP_HttpServer pServer, HP_CONNID dwConnID, DWORD dwStreamID, USHORT usStatusCode, LPCSTR lpszDesc, const HP_THeader lpHeaders[], int iHeaderCount, const BYTE* pData, int iLength);
+
+/*
+* ƣ HTTP/2 ݷƬ
+*  HTTP/2 ӵָݷƬϢͷа Transfer-Encoding: chunked ʱʹã
+*
+* 		dwConnID		--  ID
+*			dwStreamID		--  ID
+*			pData			-- ݷƬ
+*			iLength			-- ݷƬȣΪ 0 ʾ
+* ֵ	TRUE			-- ɹ
+*			FALSE			-- ʧ
+*/
+HPSOCKET_API BOOL __HP_CALL HP_HttpServer_SendStreamChunkData(HP_HttpServer pServer, HP_CONNID dwConnID, DWORD dwStreamID, const BYTE* pData /*= nullptr*/, int iLength /*= 0*/);
+
 /*
 * ƣ WebSocket Ϣ
 * Զ˶˷ WebSocket Ϣ
@@ -2066,6 +2271,16 @@ HPSOCKET_API BOOL __HP_CALL HP_HttpServer_StartHttp(HP_HttpServer pServer, HP_CO
 HPSOCKET_API void __HP_CALL HP_HttpServer_SetReleaseDelay(HP_HttpServer pServer, DWORD dwReleaseDelay);
 /* ȡͷʱ */
 HPSOCKET_API DWORD __HP_CALL HP_HttpServer_GetReleaseDelay(HP_HttpServer pServer);
+/* ǷͷٽĬϣFALSE */
+HPSOCKET_API void __HP_CALL HP_HttpServer_SetFastParse(HP_HttpServer pServer, BOOL bFastParse);
+/* Ƿͷٽ */
+HPSOCKET_API BOOL __HP_CALL HP_HttpServer_IsFastParse(HP_HttpServer pServer);
+/* ÿδظˮĬϣ0ˮߣ */
+HPSOCKET_API void __HP_CALL HP_HttpServer_SetMaxPipelineRequests(HP_HttpServer pServer, DWORD dwMaxPipelineRequests);
+/* ȡÿδظˮ */
+HPSOCKET_API DWORD __HP_CALL HP_HttpServer_GetMaxPipelineRequests(HP_HttpServer pServer);
+/* ȡǰˮţʧܻδˮʱ HTTP_INVALID_REQUEST_SEQ */
+HPSOCKET_API DWORD __HP_CALL HP_HttpServer_GetRequestSeq(HP_HttpServer pServer, HP_CONNID dwConnID);
 /* ȡ URL 루URL οEnHttpUrlField */
 HPSOCKET_API USHORT __HP_CALL HP_HttpServer_GetUrlFieldSet(HP_HttpServer pServer, HP_CONNID dwConnID);
 /* ȡĳ URL ֵ */
@@ -2121,6 +2336,19 @@ HPSOCKET_API void __HP_CALL HP_HttpServer_SetHttpAutoStart(HP_HttpServer pServer
 /* ȡ HTTP ʽ */
 HPSOCKET_API BOOL __HP_CALL HP_HttpServer_IsHttpAutoStart(HP_HttpServer pServer);
 
+/* Ƿ֧ HTTP/2ĬϣFALSE */
+HPSOCKET_API void __HP_CALL HP_HttpServer_SetHttp2Support(HP_HttpServer pServer, BOOL bSupport);
+/* Ƿ֧ HTTP/2 */
+HPSOCKET_API BOOL __HP_CALL HP_HttpServer_IsHttp2Support(HP_HttpServer pServer);
+/*  HTTP/2 Զ˴󲢷Ĭϣ256 */
+HPSOCKET_API void __HP_CALL HP_HttpServer_SetHttp2MaxConcurrentStreams(HP_HttpServer pServer, DWORD dwMaxConcurrentStreams);
+/* ȡ HTTP/2 Զ˴󲢷 */
+HPSOCKET_API DWORD __HP_CALL HP_HttpServer_GetHttp2MaxConcurrentStreams(HP_HttpServer pServer);
+/* Ƿʹ HTTP/2 */
+HPSOCKET_API BOOL __HP_CALL HP_HttpServer_IsHttp2(HP_HttpServer pServer, HP_CONNID dwConnID);
+/* ȡǰ¼ HTTP/2  IDHTTP/1.x ӷ 0 */
+HPSOCKET_API DWORD __HP_CALL HP_HttpServer_GetStreamID(HP_HttpServer pServer, HP_CONNID dwConnID);
+
 /**************************************************************************/
 /*************************** HTTP Agent  ***************************/
 
@@ -2168,6 +2396,36 @@ HPSOCKET_API BOOL __HP_CALL HP_HttpAgent_SendLocalFile(HP_HttpAgent pAgent, HP_C
 */
 HPSOCKET_API BOOL __HP_CALL HP_HttpAgent_SendChunkData(HP_HttpAgent pAgent, HP_CONNID dwConnID, const BYTE* pData /*= nullptr*/, int iLength /*= 0*/, LPCSTR lpszExtensions /*= nullptr*/);
 
+/*
+* ƣ HTTP/2 
+*  HTTP/2 ϴµHTTP/2  HP_HttpAgent_SendRequest() ȼڱ
+*		
+* 		dwConnID		--  ID
+*			lpdwStreamID	--  IDΪ nullptr
+*			lpszMethod		-- 󷽷
+*			lpszPath		-- ·
+*			lpHeaders		-- ͷ
+*			iHeaderCount	-- ͷ
+*			pBody			-- 
+*			iLength			-- 峤
+* ֵ	TRUE			-- ɹ
+*			FALSE			-- ʧ
+*/
+HPSOCKET_API BOOL __HP_CALL HP_HttpAgent_SendStreamRequest(HP_HttpAgent pAgent, HP_CONNID dwConnID, DWORD* lpdwStreamID, LPCSTR lpszMethod, LPCSTR lpszPath, const HP_THeader lpHeaders[], int iHeaderCount, const BYTE* pBody, int iLength);
+
+/*
+* ƣ HTTP/2 ݷƬ
+*  HTTP/2 ӵָݷƬͷа Transfer-Encoding: chunked ʱʹã
+*
+* 		dwConnID		--  ID
+*			dwStreamID		--  ID
+*			pData			-- ݷƬ
+*			iLength			-- ݷƬȣΪ 0 ʾ
+* ֵ	TRUE			-- ɹ
+*			FALSE			-- ʧ
+*/
+HPSOCKET_API BOOL __HP_CALL HP_HttpAgent_SendStreamChunkData(HP_HttpAgent pAgent, HP_CONNID dwConnID, DWORD dwStreamID, const BYTE* pData /*= nullptr*/, int iLength /*= 0*/);
+
 /*  POST  */
 HPSOCKET_API BOOL __HP_CALL HP_HttpAgent_SendPost(HP_HttpAgent pAgent, HP_CONNID dwConnID, LPCSTR lpszPath, const HP_THeader lpHeaders[], int iHeaderCount, const BYTE* pBody, int iLength);
 /*  PUT  */
@@ -2273,6 +2531,19 @@ HPSOCKET_API void __HP_CALL HP_HttpAgent_SetHttpAutoStart(HP_HttpAgent pAgent, B
 /* ȡ HTTP ʽ */
 HPSOCKET_API BOOL __HP_CALL HP_HttpAgent_IsHttpAutoStart(HP_HttpAgent pAgent);
 
+/* Ƿ֧ HTTP/2ĬϣFALSE */
+HPSOCKET_API void __HP_CALL HP_HttpAgent_SetHttp2Support(HP_HttpAgent pAgent, BOOL bSupport);
+/* Ƿ֧ HTTP/2 */
+HPSOCKET_API BOOL __HP_CALL HP_HttpAgent_IsHttp2Support(HP_HttpAgent pAgent);
+/*  HTTP/2 Զ˴󲢷Ĭϣ256 */
+HPSOCKET_API void __HP_CALL HP_HttpAgent_SetHttp2MaxConcurrentStreams(HP_HttpAgent pAgent, DWORD dwMaxConcurrentStreams);
+/* ȡ HTTP/2 Զ˴󲢷 */
+HPSOCKET_API DWORD __HP_CALL HP_HttpAgent_GetHttp2MaxConcurrentStreams(HP_HttpAgent pAgent);
+/* Ƿʹ HTTP/2 */
+HPSOCKET_API BOOL __HP_CALL HP_HttpAgent_IsHttp2(HP_HttpAgent pAgent, HP_CONNID dwConnID);
+/* ȡǰ¼ HTTP/2  IDHTTP/1.x ӷ 0 */
+HPSOCKET_API DWORD __HP_CALL HP_HttpAgent_GetStreamID(HP_HttpAgent pAgent, HP_CONNID dwConnID);
+
 /**************************************************************************/
 /*************************** HTTP Client  **************************/
 
@@ -2318,6 +2589,34 @@ HPSOCKET_API BOOL __HP_CALL HP_HttpClient_SendLocalFile(HP_HttpClient pClient, L
 */
 HPSOCKET_API BOOL __HP_CALL HP_HttpClient_SendChunkData(HP_HttpClient pClient, const BYTE* pData /*= nullptr*/, int iLength /*= 0*/, LPCSTR lpszExtensions /*= nullptr*/);
 
+/*
+* ƣ HTTP/2 
+*  HTTP/2 ϴµHTTP/2  HP_HttpClient_SendRequest() ȼڱ
+*		
+* 		lpdwStreamID	--  IDΪ nullptr
+*			lpszMethod		-- 󷽷
+*			lpszPath		-- ·
+*			lpHeaders		-- ͷ
+*			iHeaderCount	-- ͷ
+*			pBody			-- 
+*			iLength			-- 峤
+* ֵ	TRUE			-- ɹ
+*			FALSE			-- ʧ
+*/
+HPSOCKET_API BOOL __HP_CALL HP_HttpClient_SendStreamRequest(HP_HttpClient pClient, DWORD* lpdwStreamID, LPCSTR lpszMethod, LPCSTR lpszPath, const HP_THeader lpHeaders[], int iHeaderCount, const BYTE* pBody, int iLength);
+
+/*
+* ƣ HTTP/2 ݷƬ
+*  HTTP/2 ӵָݷƬͷа Transfer-Encoding: chunked ʱʹã
+*
+* 		dwStreamID		--  ID
+*			pData			-- ݷƬ
+*			iLength			-- ݷƬȣΪ 0 ʾ
+* ֵ	TRUE			-- ɹ
+*			FALSE			-- ʧ
+*/
+HPSOCKET_API BOOL __HP_CALL HP_HttpClient_SendStreamChunkData(HP_HttpClient pClient, DWORD dwStreamID, const BYTE* pData /*= nullptr*/, int iLength /*= 0*/);
+
 /*  POST  */
 HPSOCKET_API BOOL __HP_CALL HP_HttpClient_SendPost(HP_HttpClient pClient, LPCSTR lpszPath, const HP_THeader lpHeaders[], int iHeaderCount, const BYTE* pBody, int iLength);
 /*  PUT  */
@@ -2422,6 +2721,19 @@ HPSOCKET_API void __HP_CALL HP_HttpClient_SetHttpAutoStart(HP_HttpClient pClient
 /* ȡ HTTP ʽ */
 HPSOCKET_API BOOL __HP_CALL HP_HttpClient_IsHttpAutoStart(HP_HttpClient pClient);
 
+/* Ƿ֧ HTTP/2ĬϣFALSE */
+HPSOCKET_API void __HP_CALL HP_HttpClient_SetHttp2Support(HP_HttpClient pClient, BOOL bSupport);
+/* Ƿ֧ HTTP/2 */
+HPSOCKET_API BOOL __HP_CALL HP_HttpClient_IsHttp2Support(HP_HttpClient pClient);
+/*  HTTP/2 Զ˴󲢷Ĭϣ256 */
+HPSOCKET_API void __HP_CALL HP_HttpClient_SetHttp2MaxConcurrentStreams(HP_HttpClient pClient, DWORD dwMaxConcurrentStreams);
+/* ȡ HTTP/2 Զ˴󲢷 */
+HPSOCKET_API DWORD __HP_CALL HP_HttpClient_GetHttp2MaxConcurrentStreams(HP_HttpClient pClient);
+/* Ƿʹ HTTP/2 */
+HPSOCKET_API BOOL __HP_CALL HP_HttpClient_IsHttp2(HP_HttpClient pClient);
+/* ȡǰ¼ HTTP/2  IDHTTP/1.x ӷ 0 */
+HPSOCKET_API DWORD __HP_CALL HP_HttpClient_GetStreamID(HP_HttpClient pClient);
+
 /**************************************************************************/
 /************************ HTTP Sync Client  ************************/
 
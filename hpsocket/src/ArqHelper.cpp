@@ -23,18 +23,265 @@
  
 #include "ArqHelper.h"
 
+#include <random>
+
 #ifdef _UDP_SUPPORT
 
 DWORD GenerateConversationID()
 {
-	static volatile DWORD s_dwConvID = ::TimeGetTime();
+	// 会话 ID 使用随机数，防止被猜测后伪造报文注入会话
+	static thread_local mt19937 s_rand(random_device{}());
 
-	DWORD dwConvID = ::InterlockedIncrement(&s_dwConvID);
+	DWORD dwConvID;
 
-	if(dwConvID == 0)
-		dwConvID = ::InterlockedIncrement(&s_dwConvID);
+	do
+	{
+		dwConvID = (DWORD)s_rand();
+	} while(dwConvID == 0);
 
 	return dwConvID;
 }
 
+/************************************************************************
+名称：固定速率拥塞控制器
+描述：按设定速率匀速发送，不限制拥塞窗口（仍受发送窗口和远端接收窗口限制）
+************************************************************************/
+class CArqFixedRateCongestCtrl : public CArqCongestCtrl
+{
+public:
+	virtual DWORD GetCwnd()			const	{return (DWORD)INT_MAX;}
+	virtual ULLONG GetPacingRate()	const	{return m_ullRate;}
+
+public:
+	CArqFixedRateCongestCtrl(ULLONG ullRate) : m_ullRate(ullRate) {}
+
+private:
+	ULLONG m_ullRate;
+};
+
+/************************************************************************
+名称：BBR 拥塞控制器
+描述：以每个 RTT 为一轮计算交付速率，取最近 10 轮最大值作为瓶颈带宽，取 10 秒内最小平滑 RTT 作为最小 RTT；
+	  STARTUP 阶段以 2.885 倍增益探测带宽，带宽连续 3 轮增长不足 25% 后进入 DRAIN 排空队列，
+	  之后进入 PROBE_BW 按 [1.25, 0.75, 1, 1, 1, 1, 1, 1] 循环增益发送；最小 RTT 超过 10 秒未更新时
+	  进入 PROBE_RTT 以最小拥塞窗口发送 200 毫秒
+************************************************************************/
+class CArqBbrCongestCtrl : public CArqCongestCtrl
+{
+private:
+	enum EnState {BBR_STARTUP, BBR_DRAIN, BBR_PROBE_BW, BBR_PROBE_RTT};
+
+	static constexpr int	BW_WINDOW_ROUNDS	= 10;
+	static constexpr int	FULL_BW_ROUNDS		= 3;
+	static constexpr int	CYCLE_LENGTH		= 8;
+	static constexpr DWORD	MIN_CWND			= 4;
+	static constexpr DWORD	INIT_CWND			= 16;
+	static constexpr DWORD	INIT_RTT			= 100;
+	static constexpr DWORD	MIN_RTT_WINDOW		= 10000;
+	static constexpr DWORD	PROBE_RTT_TIME		= 200;
+	static constexpr double	HIGH_GAIN			= 2.885;
+	static constexpr double	CWND_GAIN			= 2.0;
+	static constexpr double	FULL_BW_THRESH		= 1.25;
+
+	static const double CYCLE_GAINS[CYCLE_LENGTH];
+
+public:
+	virtual void OnAck(DWORD dwCurrent, int iAckedBytes, DWORD dwRtt, int iInflight, BOOL bAppLimited)
+	{
+		if(m_dwRoundStart == 0)
+			m_dwRoundStart = dwCurrent;
+
+		if(dwRtt > 0)
+		{
+			if(m_dwMinRtt == 0 || dwRtt <= m_dwMinRtt)
+			{
+				m_dwMinRtt		= dwRtt;
+				m_dwMinRttStamp	= dwCurrent;
+			}
+
+			if(m_enState == BBR_PROBE_RTT && (m_dwProbeMinRtt == 0 || dwRtt < m_dwProbeMinRtt))
+				m_dwProbeMinRtt = dwRtt;
+		}
+
+		m_ullRoundBytes		+= iAckedBytes;
+		m_bRoundAppLimited	|= bAppLimited;
+
+		DWORD dwElapsed = ::GetTimeGap32(m_dwRoundStart, dwCurrent);
+
+		if(dwElapsed >= MAX(m_dwMinRtt, (DWORD)1))
+			OnRoundEnd(dwCurrent, dwElapsed);
+
+		UpdateState(dwCurrent, iInflight);
+	}
+
+	virtual DWORD GetCwnd() const
+	{
+		if(m_enState == BBR_PROBE_RTT)
+			return MIN_CWND;
+		if(m_ullBandwidth == 0 || m_dwMinRtt == 0)
+			return INIT_CWND;
+
+		return MAX((DWORD)(CWND_GAIN * GetBdp()), MIN_CWND);
+	}
+
+	virtual ULLONG GetPacingRate() const
+	{
+		ULLONG ullRate;
+
+		if(m_ullBandwidth == 0)
+			ullRate = (ULLONG)(HIGH_GAIN * INIT_CWND * m_iMss * 1000 / MAX(m_dwMinRtt, INIT_RTT));
+		else
+			ullRate = (ULLONG)(GetPacingGain() * m_ullBandwidth);
+
+		ullRate = MAX(ullRate, (ULLONG)m_iMss);
+
+		return (m_ullMaxRate > 0) ? MIN(ullRate, m_ullMaxRate) : ullRate;
+	}
+
+	virtual ULLONG GetBandwidth()	const	{return m_ullBandwidth;}
+	virtual DWORD GetMinRtt()		const	{return m_dwMinRtt;}
+
+private:
+	/* 带宽时延积（数据包数量） */
+	double GetBdp() const
+	{
+		return (double)m_ullBandwidth * m_dwMinRtt / 1000 / m_iMss;
+	}
+
+	double GetPacingGain() const
+	{
+		switch(m_enState)
+		{
+		case BBR_STARTUP:	return HIGH_GAIN;
+		case BBR_DRAIN:		return 1 / HIGH_GAIN;
+		case BBR_PROBE_BW:	return CYCLE_GAINS[m_iCycleIndex];
+		default:			return 1.0;
+		}
+	}
+
+	void OnRoundEnd(DWORD dwCurrent, DWORD dwElapsed)
+	{
+		ULLONG ullSample = m_ullRoundBytes * 1000 / dwElapsed;
+
+		//发送受应用限制时交付速率偏低，只接受高于当前估计值的样本
+		if(!m_bRoundAppLimited || ullSample > m_ullBandwidth)
+		{
+			m_ullBwSamples[m_iBwIndex] = ullSample;
+			m_iBwIndex = (m_iBwIndex + 1) % BW_WINDOW_ROUNDS;
+
+			m_ullBandwidth = 0;
+
+			for(int i = 0; i < BW_WINDOW_ROUNDS; i++)
+				m_ullBandwidth = MAX(m_ullBandwidth, m_ullBwSamples[i]);
+		}
+
+		if(m_enState == BBR_STARTUP && !m_bRoundAppLimited)
+		{
+			if(m_ullBandwidth >= (ULLONG)(m_ullFullBw * FULL_BW_THRESH))
+			{
+				m_ullFullBw		= m_ullBandwidth;
+				m_iFullBwCount	= 0;
+			}
+			else if(++m_iFullBwCount >= FULL_BW_ROUNDS)
+				m_enState = BBR_DRAIN;
+		}
+		else if(m_enState == BBR_PROBE_BW)
+			m_iCycleIndex = (m_iCycleIndex + 1) % CYCLE_LENGTH;
+
+		m_dwRoundStart		= dwCurrent;
+		m_ullRoundBytes		= 0;
+		m_bRoundAppLimited	= FALSE;
+	}
+
+	void UpdateState(DWORD dwCurrent, int iInflight)
+	{
+		if(m_enState == BBR_DRAIN && iInflight <= (int)GetBdp())
+			EnterProbeBw();
+
+		if(m_enState == BBR_PROBE_RTT)
+		{
+			if((int)(dwCurrent - m_dwProbeRttDone) >= 0)
+			{
+				//以 PROBE_RTT 期间的最小 RTT 替换过期的最小 RTT
+				if(m_dwProbeMinRtt > 0)
+					m_dwMinRtt = m_dwProbeMinRtt;
+
+				m_dwMinRttStamp = dwCurrent;
+
+				if(m_iFullBwCount >= FULL_BW_ROUNDS)
+					EnterProbeBw();
+				else
+					m_enState = BBR_STARTUP;
+			}
+		}
+		else if(m_dwMinRtt > 0 && ::GetTimeGap32(m_dwMinRttStamp, dwCurrent) > MIN_RTT_WINDOW)
+		{
+			m_enState			= BBR_PROBE_RTT;
+			m_dwProbeRttDone	= dwCurrent + MAX(PROBE_RTT_TIME, m_dwMinRtt);
+			m_dwProbeMinRtt		= 0;
+		}
+	}
+
+	void EnterProbeBw()
+	{
+		m_enState		= BBR_PROBE_BW;
+		m_iCycleIndex	= 0;
+	}
+
+public:
+	CArqBbrCongestCtrl(ULLONG ullMaxRate, int iMss)
+	: m_iMss			(iMss)
+	, m_ullMaxRate		(ullMaxRate)
+	, m_enState			(BBR_STARTUP)
+	, m_ullBandwidth	(0)
+	, m_iBwIndex		(0)
+	, m_dwMinRtt		(0)
+	, m_dwMinRttStamp	(0)
+	, m_dwRoundStart	(0)
+	, m_ullRoundBytes	(0)
+	, m_bRoundAppLimited(FALSE)
+	, m_ullFullBw		(0)
+	, m_iFullBwCount	(0)
+	, m_iCycleIndex		(0)
+	, m_dwProbeRttDone	(0)
+	, m_dwProbeMinRtt	(0)
+	{
+		::ZeroMemory(m_ullBwSamples, sizeof(m_ullBwSamples));
+	}
+
+private:
+	int		m_iMss;
+	ULLONG	m_ullMaxRate;
+	EnState	m_enState;
+
+	ULLONG	m_ullBandwidth;
+	ULLONG	m_ullBwSamples[BW_WINDOW_ROUNDS];
+	int		m_iBwIndex;
+
+	DWORD	m_dwMinRtt;
+	DWORD	m_dwMinRttStamp;
+
+	DWORD	m_dwRoundStart;
+	ULLONG	m_ullRoundBytes;
+	BOOL	m_bRoundAppLimited;
+
+	ULLONG	m_ullFullBw;
+	int		m_iFullBwCount;
+	int		m_iCycleIndex;
+	DWORD	m_dwProbeRttDone;
+	DWORD	m_dwProbeMinRtt;
+};
+
+const double CArqBbrCongestCtrl::CYCLE_GAINS[CYCLE_LENGTH] = {1.25, 0.75, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0};
+
+CArqCongestCtrl* CArqCongestCtrl::Create(EnArqCongestCtrl enType, DWORD dwPacingRate, int iMss)
+{
+	switch(enType)
+	{
+	case ACC_FIXED_RATE:	return new CArqFixedRateCongestCtrl(dwPacingRate);
+	case ACC_BBR:			return new CArqBbrCongestCtrl(dwPacingRate, iMss);
+	default:				return nullptr;
+	}
+}
+
 #endif
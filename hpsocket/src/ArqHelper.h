@@ -32,9 +32,12 @@
 #include "common/FuncHelper.h"
 #include "common/BufferPool.h"
 #include "common/IODispatcher.h"
+#include "common/FecCodec.h"
 #include "common/kcp/ikcp.h"
 
+#include <map>
 #include <memory>
+#include <vector>
 
 using namespace std;
 
@@ -49,6 +52,11 @@ using namespace std;
 #define DEFAULT_ARQ_MAX_TRANS_UNIT		DEFAULT_UDP_MAX_DATAGRAM_SIZE
 #define DEFAULT_ARQ_MAX_MSG_SIZE		DEFAULT_BUFFER_CACHE_CAPACITY
 #define DEFAULT_ARQ_HANND_SHAKE_TIMEOUT	5000
+#define DEFAULT_ARQ_FLUSH_DELAY			0
+#define DEFAULT_ARQ_FEC_DATA_SHARDS		0
+#define DEFAULT_ARQ_FEC_PARITY_SHARDS	0
+#define DEFAULT_ARQ_CONGEST_CTRL		ACC_KCP
+#define DEFAULT_ARQ_PACING_RATE			0
 
 #define KCP_HEADER_SIZE					24
 #define KCP_MIN_RECV_WND				128
@@ -147,6 +155,11 @@ struct TArqAttr
 	DWORD	dwFastLimit;
 	DWORD	dwMaxMessageSize;
 	DWORD	dwHandShakeTimeout;
+	DWORD	dwFlushDelay;
+	DWORD	dwFecDataShards;
+	DWORD	dwFecParityShards;
+	EnArqCongestCtrl enCongestCtrl;
+	DWORD	dwPacingRate;
 
 public:
 	TArqAttr( BOOL no_delay				= DEFAULT_ARQ_NO_DELAY
@@ -160,6 +173,11 @@ public:
 			, DWORD fast_limit			= DEFAULT_ARQ_FAST_LIMIT
 			, DWORD max_msg_size		= DEFAULT_ARQ_MAX_MSG_SIZE
 			, DWORD hand_shake_timeout	= DEFAULT_ARQ_HANND_SHAKE_TIMEOUT
+			, DWORD flush_delay			= DEFAULT_ARQ_FLUSH_DELAY
+			, DWORD fec_data_shards		= DEFAULT_ARQ_FEC_DATA_SHARDS
+			, DWORD fec_parity_shards	= DEFAULT_ARQ_FEC_PARITY_SHARDS
+			, EnArqCongestCtrl congest_ctrl	= DEFAULT_ARQ_CONGEST_CTRL
+			, DWORD pacing_rate			= DEFAULT_ARQ_PACING_RATE
 			)
 	: bNoDelay			(no_delay)
 	, bTurnoffNc		(turnoff_nc)
@@ -172,10 +190,33 @@ public:
 	, dwFastLimit		(fast_limit)
 	, dwMaxMessageSize	(max_msg_size)
 	, dwHandShakeTimeout(hand_shake_timeout)
+	, dwFlushDelay		(flush_delay)
+	, dwFecDataShards	(fec_data_shards)
+	, dwFecParityShards	(fec_parity_shards)
+	, enCongestCtrl		(congest_ctrl)
+	, dwPacingRate		(pacing_rate)
 	{
 		ASSERT(IsValid());
 	}
 
+	/* 会话定时器间隔：批量发送模式下不超过最大刷新延迟 */
+	DWORD GetTimerInterval() const
+	{
+		return (dwFlushDelay > 0) ? MIN(dwFlushInterval, dwFlushDelay) : dwFlushInterval;
+	}
+
+	/* 是否启用 FEC（数据分片数及校验分片数均大于 0） */
+	BOOL IsFecEnabled() const
+	{
+		return (dwFecDataShards > 0 && dwFecParityShards > 0);
+	}
+
+	/* KCP 的 MTU：启用 FEC 时扣除 FEC 分片的最大额外长度 */
+	DWORD GetKcpMtu() const
+	{
+		return IsFecEnabled() ? dwMtu - FEC_MAX_OVERHEAD : dwMtu;
+	}
+
 	BOOL IsValid() const
 	{
 		return 	((int)dwResendByAcks >= 0)																				&&
@@ -184,13 +225,95 @@ public:
 				((int)dwRecvWndSize > 0)																				&&
 				((int)dwMinRto > 0)																						&&
 				((int)dwFastLimit >= 0)																					&&
+				((int)dwFlushDelay >= 0)																				&&
 				((int)dwHandShakeTimeout > 2 * (int)dwMinRto)															&&
-				((int)dwMtu >= 3 * KCP_HEADER_SIZE && dwMtu <= MAXIMUM_UDP_MAX_DATAGRAM_SIZE)							&&
-				((int)dwMaxMessageSize > 0 && dwMaxMessageSize < ((KCP_MIN_RECV_WND - 1) * (dwMtu - KCP_HEADER_SIZE)))	;
+				((dwFecDataShards == 0 && dwFecParityShards == 0)														||
+				 (IsFecEnabled() && dwFecDataShards + dwFecParityShards <= FEC_MAX_SHARDS))								&&
+				(enCongestCtrl >= ACC_KCP && enCongestCtrl <= ACC_BBR)													&&
+				(enCongestCtrl == ACC_KCP || !bTurnoffNc)																&&
+				(enCongestCtrl != ACC_FIXED_RATE || dwPacingRate > 0)													&&
+				((int)GetKcpMtu() >= 3 * KCP_HEADER_SIZE && dwMtu <= MAXIMUM_UDP_MAX_DATAGRAM_SIZE)					&&
+				((int)dwMaxMessageSize > 0 && dwMaxMessageSize < ((KCP_MIN_RECV_WND - 1) * (GetKcpMtu() - KCP_HEADER_SIZE)));
 	}
 
 };
 
+/************************************************************************
+名称：ARQ 拥塞控制器
+描述：会话在处理 ACK 及超时重传后通知拥塞控制器，并在每次刷新前根据拥塞窗口及发送速率
+	  （令牌桶）限制放入 KCP 发送缓冲区的新数据包数量
+************************************************************************/
+class CArqCongestCtrl
+{
+public:
+	/* 收到 ACK：iAckedBytes 新确认的字节数，dwRtt 平滑 RTT，iInflight 在途数据包数，bAppLimited 发送队列为空 */
+	virtual void OnAck(DWORD dwCurrent, int iAckedBytes, DWORD dwRtt, int iInflight, BOOL bAppLimited)	{}
+	/* 发生超时重传：iLost 超时重传的数据包数（不含快速重传） */
+	virtual void OnLoss(DWORD dwCurrent, int iLost)	{}
+	/* 发生快速重传：iCount 因跨越 ACK 次数达到阈值而重传的数据包数，与超时重传分别通知，避免重复退避 */
+	virtual void OnFastRetransmit(DWORD dwCurrent, int iCount)	{}
+
+	/* 拥塞窗口（数据包数量） */
+	virtual DWORD GetCwnd()			const = 0;
+	/* 发送速率（字节/秒，0 表示不限制） */
+	virtual ULLONG GetPacingRate()	const = 0;
+	/* 瓶颈带宽估计值（字节/秒） */
+	virtual ULLONG GetBandwidth()	const	{return 0;}
+	/* 最小 RTT 估计值（毫秒） */
+	virtual DWORD GetMinRtt()		const	{return 0;}
+
+public:
+	/* 创建拥塞控制器：ACC_KCP 返回 nullptr（使用 KCP 内置拥塞控制） */
+	static CArqCongestCtrl* Create(EnArqCongestCtrl enType, DWORD dwPacingRate, int iMss);
+
+	virtual ~CArqCongestCtrl() = default;
+};
+
+/************************************************************************
+名称：ARQ 发送速率令牌桶
+描述：按发送速率累积可发送字节数，最多累积 2 毫秒的发送量（不少于 4 个数据包）
+************************************************************************/
+struct TArqPacer
+{
+	LLONG	tokens;
+	DWORD	lastTime;
+
+	/* 补充令牌并返回可发送的数据包数量 */
+	int Refill(DWORD dwCurrent, ULLONG ullRate, int iPacketSize)
+	{
+		if(ullRate == 0)
+			return INT_MAX;
+
+		LLONG llBurst = MAX((LLONG)(ullRate * 2 / 1000), (LLONG)(4 * iPacketSize));
+
+		tokens		= MIN(tokens + (LLONG)(ullRate * ::GetTimeGap32(lastTime, dwCurrent) / 1000), llBurst);
+		lastTime	= dwCurrent;
+
+		return (tokens > 0) ? (int)(tokens / iPacketSize) : 0;
+	}
+
+	void Consume(int iBytes)
+	{
+		tokens -= iBytes;
+	}
+
+	/* 距离可以发送下一个数据包的时间（毫秒）：令牌足够时返回 0，调用方需确认拥塞窗口未满 */
+	int GetWaitTime(ULLONG ullRate, int iPacketSize) const
+	{
+		if(ullRate == 0 || tokens >= iPacketSize)
+			return 0;
+
+		return (int)(((ULLONG)(iPacketSize - tokens) * 1000 + ullRate - 1) / ullRate);
+	}
+
+	/* 初始为满桶（首次补充令牌时截断为桶容量） */
+	void Reset(DWORD dwCurrent)
+	{
+		tokens		= LLONG_MAX / 2;
+		lastTime	= dwCurrent;
+	}
+};
+
 template<class T, class S> class CArqSessionT
 {
 public:
@@ -198,7 +321,7 @@ public:
 	{
 		m_pContext		= pContext;
 		m_pSocket		= pSocket;
-		m_dwSelfConvID	= ::GenerateConversationID();
+		m_dwSelfConvID	= RenewConvID();
 
 		DoRenew(attr, dwPeerConvID);
 		RenewExtra(attr);
@@ -311,11 +434,33 @@ public:
 					return FALSE;
 				}
 
-				if(bForce)
+				DWORD dwCurrent = ::TimeGetTime();
+
+				PrepareFlush(dwCurrent);
+
+				if(bForce || (m_bDirty && ::GetTimeGap32(m_dwDirtyTime, dwCurrent) >= m_dwFlushDelay))
+				{
 					::ikcp_flush(m_kcp);
+					m_bDirty = FALSE;
+				}
 				else
-					::ikcp_update(m_kcp, ::TimeGetTime());
+				{
+					IUINT32 tsFlush = m_kcp->ts_flush;
+					::ikcp_update(m_kcp, dwCurrent);
+
+					if(tsFlush != m_kcp->ts_flush)
+						m_bDirty = FALSE;
+					//未到刷新时间但有数据包到达重传时间或发送速率允许发送新数据包：立即刷新
+					else if(::ikcp_check(m_kcp, dwCurrent) == dwCurrent || IsPacingReady())
+						::ikcp_flush(m_kcp);
+				}
+
+				FlushFec(dwCurrent);
+				PostFlush(dwCurrent);
 			}
+			//其它线程正在处理会话：标记待刷新，由持有锁的线程或下次调度完成刷新
+			else
+				m_bFlushPending = TRUE;
 		}
 
 		return TRUE;
@@ -326,7 +471,8 @@ public:
 		if(!IsReady())
 			return ERROR_INVALID_STATE;
 
-		int rs = NO_ERROR;
+		int rs		= NO_ERROR;
+		BOOL bFlush	= TRUE;
 
 		{
 			CReentrantCriSecLock locallock(m_cs);
@@ -335,11 +481,22 @@ public:
 				return ERROR_INVALID_STATE;
 
 			rs = ::ikcp_send(m_kcp, (const char*)pBuffer, iLength);
-			if(rs != NO_ERROR) rs = ERROR_INCORRECT_SIZE;
+
+			if(rs != NO_ERROR)
+				rs = ERROR_INCORRECT_SIZE;
+			else if(m_dwFlushDelay > 0)
+				bFlush = MarkDirty(iLength + KCP_HEADER_SIZE);
 		}
 
 		if(rs == NO_ERROR)
-			Flush(TRUE);
+		{
+			if(bFlush)
+				Flush(TRUE);
+			else
+				FlushPending();
+
+			ScheduleExtra();
+		}
 
 		return rs;
 	}
@@ -365,17 +522,73 @@ public:
 
 	EnHandleResult Receive(const BYTE* pData, int iLength, BYTE* pBuffer, int iCapacity)
 	{
+		EnHandleResult result;
+
 		//判断接收的用户数据报大小进行分发
 		if(iLength >= KCP_HEADER_SIZE)
-			return ReceiveArq(pData, iLength, pBuffer, iCapacity);
+			result = ReceiveArq(pData, iLength, pBuffer, iCapacity);
 		else if(iLength == TArqCmd::PACKAGE_LENGTH) // 握手包
-			return ReceiveHandShake(pData);
+			result = ReceiveHandShake(pData);
 		else
 		{
 			//异常包
 			::WSASetLastError(ERROR_INVALID_DATA);
 			return HR_ERROR;
 		}
+
+		if(result != HR_ERROR)
+			ScheduleExtra();
+
+		return result;
+	}
+
+	/* 获取距下次需要调用 Check() 的时间（毫秒，由 ikcp_check() 计算），没有待处理数据的空闲会话返回 -1 */
+	int GetNextCheckDelay()
+	{
+		if(!IsValid())
+			return -1;
+
+		CReentrantCriSecLock locallock(m_cs);
+
+		if(!IsValid())
+			return -1;
+
+		DWORD dwCurrent	= ::TimeGetTime();
+		int iDelay		= -1;
+
+		if(m_bFlushPending && IsReady())
+			return 0;
+
+		if(IsHandShaking() || !m_bHSComplete)
+			iDelay = MAX((int)(m_dwHSNextTime - dwCurrent), 0);
+
+		if(IsReady())
+		{
+			BOOL bBusy = (m_bDirty || m_kcp->nsnd_que > 0 || m_kcp->nsnd_buf > 0 || m_kcp->ackcount > 0 || m_kcp->probe != 0);
+
+			if(bBusy)
+			{
+				int iKcpDelay = MAX((int)(::ikcp_check(m_kcp, dwCurrent) - dwCurrent), 0);
+
+				//发送速率受限时在令牌足够发送下一个数据包时唤醒；拥塞窗口已满时只能等待 ACK，保持 ikcp_check() 的检测时间
+				if(m_pCongestCtrl && m_kcp->nsnd_que > 0 && !IsCwndLimited())
+					iKcpDelay = MIN(iKcpDelay, m_pacer.GetWaitTime(m_pCongestCtrl->GetPacingRate(), (int)m_kcp->mtu));
+
+				if(m_bDirty)
+					iKcpDelay = MIN(iKcpDelay, MAX((int)(m_dwDirtyTime + m_dwFlushDelay - dwCurrent), 0));
+
+				iDelay = (iDelay < 0) ? iKcpDelay : MIN(iDelay, iKcpDelay);
+			}
+
+			//未满的 FEC 分组在一个刷新间隔后发送校验分片
+			if(m_bFec && m_fecEncoder->GetPendingCount() > 0)
+			{
+				int iFecDelay = MAX((int)(m_dwFecTime + m_kcp->interval - dwCurrent), 0);
+				iDelay = (iDelay < 0) ? iFecDelay : MIN(iDelay, iFecDelay);
+			}
+		}
+
+		return iDelay;
 	}
 
 	EnHandleResult ReceiveHandShake(const BYTE* pBuffer)
@@ -426,6 +639,7 @@ public:
 				if(m_dwPeerConvID == 0)
 				{
 					m_dwPeerConvID = cmd.selfID;
+					m_kcp->conv	   = m_dwPeerConvID;
 					m_dwHSNextTime = ::TimeGetTime();
 					m_dwHSSndCount = 0;
 				}
@@ -465,6 +679,8 @@ public:
 	{
 		if(!IsReady()) return HR_IGNORE;
 
+		BOOL bFlush = TRUE;
+
 		{
 			CReentrantCriSecLock locallock(m_cs);
 
@@ -479,8 +695,21 @@ public:
 				::WSASetLastError(ERROR_INVALID_DATA);
 				return HR_ERROR;
 			}
-			//将接收到的数据输入到kcp中
-			int rs = ::ikcp_input(m_kcp, (const char*)pData, iLength);
+			int rs;
+			int iSndBuf = (int)m_kcp->nsnd_buf;
+
+			//将接收到的数据输入到kcp中（启用 FEC 时输入数据分片及恢复的数据报）
+			if(m_bFec)
+			{
+				BOOL isOK = m_fecDecoder->Decode(pData, iLength, [this](const BYTE* pDatagram, int iDatagram)
+				{
+					return (::ikcp_input(m_kcp, (const char*)pDatagram, iDatagram) == NO_ERROR);
+				});
+
+				rs = isOK ? NO_ERROR : ERROR_INVALID_DATA;
+			}
+			else
+				rs = ::ikcp_input(m_kcp, (const char*)pData, iLength);
 
 			if(rs != NO_ERROR)
 			{
@@ -488,6 +717,10 @@ public:
 				return HR_ERROR;
 			}
 
+			//发送缓冲区中被确认移除的数据包数量
+			if(m_pCongestCtrl && iSndBuf > (int)m_kcp->nsnd_buf)
+				m_pCongestCtrl->OnAck(::TimeGetTime(), (iSndBuf - (int)m_kcp->nsnd_buf) * (int)m_kcp->mss, (DWORD)m_kcp->rx_srtt, (int)m_kcp->nsnd_buf, m_kcp->nsnd_que == 0);
+
 			while(TRUE)
 			{
 				//此时取出的数据是有序的
@@ -509,14 +742,137 @@ public:
 				else
 					break;
 			}
+
+			//批量发送模式下 ACK 与待发数据一起合并发送
+			if(m_dwFlushDelay > 0)
+				bFlush = MarkDirty(KCP_HEADER_SIZE);
 		}
 
 		//更新kcp=> 调用flush等
-		Flush(TRUE);
+		if(bFlush)
+			Flush(TRUE);
+		else
+			FlushPending();
 
 		return HR_OK;
 	}
 
+	BOOL GetStats(TArqSessionStats& stats)
+	{
+		if(!IsValid())
+		{
+			::SetLastError(ERROR_INVALID_STATE);
+			return FALSE;
+		}
+
+		CReentrantCriSecLock locallock(m_cs);
+
+		if(!IsValid())
+		{
+			::SetLastError(ERROR_INVALID_STATE);
+			return FALSE;
+		}
+
+		DWORD dwCwnd = MIN(m_kcp->snd_wnd, m_kcp->rmt_wnd);
+
+		if(m_pCongestCtrl)
+			dwCwnd = MIN(dwCwnd, m_pCongestCtrl->GetCwnd());
+		else if(m_kcp->nocwnd == 0)
+			dwCwnd = MIN(dwCwnd, m_kcp->cwnd);
+
+		stats.cwnd			= dwCwnd;
+		stats.inflight		= m_kcp->snd_nxt - m_kcp->snd_una;
+		stats.waitingSend	= (DWORD)::ikcp_waitsnd(m_kcp);
+		stats.srtt			= (DWORD)m_kcp->rx_srtt;
+		stats.rto			= (DWORD)m_kcp->rx_rto;
+		stats.retransmits	= m_kcp->xmit;
+		stats.minRtt		= m_pCongestCtrl ? m_pCongestCtrl->GetMinRtt() : 0;
+		stats.pacingRate	= m_pCongestCtrl ? m_pCongestCtrl->GetPacingRate() : 0;
+		stats.bandwidth		= m_pCongestCtrl ? m_pCongestCtrl->GetBandwidth() : 0;
+
+		return TRUE;
+	}
+
+private:
+	/* 完成被跳过的刷新（Flush() 未能获得会话锁时标记） */
+	void FlushPending()
+	{
+		if(m_bFlushPending.exchange(FALSE))
+			Flush();
+	}
+
+	/* 按拥塞窗口及令牌桶设置 KCP 窗口：本次刷新最多放入发送缓冲区的新数据包数量 = MIN(拥塞窗口 - 在途数据包数, 令牌数) */
+	void PrepareFlush(DWORD dwCurrent)
+	{
+		if(!m_pCongestCtrl)
+			return;
+
+		int iInflight	= (int)(m_kcp->snd_nxt - m_kcp->snd_una);
+		int iCwnd		= (int)MIN(m_pCongestCtrl->GetCwnd(), (DWORD)INT_MAX);
+		int iPaced		= m_pacer.Refill(dwCurrent, m_pCongestCtrl->GetPacingRate(), (int)m_kcp->mtu);
+
+		m_kcp->cwnd		= (IUINT32)MIN(iCwnd, iInflight + MIN(iPaced, INT_MAX - iInflight));
+		m_dwSndNxt		= m_kcp->snd_nxt;
+		m_dwXmit		= m_kcp->xmit;
+		m_dwFastXmit	= m_kcp->fastxmit;
+	}
+
+	void PostFlush(DWORD dwCurrent)
+	{
+		if(!m_pCongestCtrl)
+			return;
+
+		int iSent = (int)(m_kcp->snd_nxt - m_dwSndNxt);
+		int iLost = (int)(m_kcp->xmit - m_dwXmit);
+		int iFast = (int)(m_kcp->fastxmit - m_dwFastXmit);
+
+		if(iSent > 0)
+			m_pacer.Consume(iSent * (int)m_kcp->mtu);
+		if(iLost > 0)
+			m_pCongestCtrl->OnLoss(dwCurrent, iLost);
+		if(iFast > 0)
+			m_pCongestCtrl->OnFastRetransmit(dwCurrent, iFast);
+	}
+
+	/* 当前 FEC 分组超过一个刷新间隔仍未满时结束分组并发送校验分片，避免流量较小时丢失的数据分片无法恢复 */
+	void FlushFec(DWORD dwCurrent)
+	{
+		if(!m_bFec || m_fecEncoder->GetPendingCount() == 0 || ::GetTimeGap32(m_dwFecTime, dwCurrent) < m_kcp->interval)
+			return;
+
+		if(m_fecEncoder->Flush())
+			SendFecParity(m_kcp);
+	}
+
+	/* 在途数据包数已达到拥塞窗口（或 KCP 发送窗口、对端接收窗口） */
+	BOOL IsCwndLimited() const
+	{
+		DWORD dwWnd = MIN(MIN(m_kcp->snd_wnd, m_kcp->rmt_wnd), m_pCongestCtrl->GetCwnd());
+
+		return ((DWORD)(m_kcp->snd_nxt - m_kcp->snd_una) >= dwWnd);
+	}
+
+	/* 发送队列有数据且拥塞窗口及令牌桶允许发送新数据包 */
+	BOOL IsPacingReady() const
+	{
+		return (m_pCongestCtrl && m_kcp->nsnd_que > 0 && (int)(m_kcp->snd_nxt - m_kcp->snd_una) < (int)m_kcp->cwnd);
+	}
+
+	/* 批量发送模式：标记会话待刷新（由定时器在最大刷新延迟内刷新），待发数据满一个 MTU 时返回 TRUE 立即刷新 */
+	BOOL MarkDirty(int iBytes)
+	{
+		if(!m_bDirty)
+		{
+			m_bDirty		= TRUE;
+			m_dwDirtyTime	= ::TimeGetTime();
+			m_iDirtyBytes	= 0;
+		}
+
+		m_iDirtyBytes += iBytes;
+
+		return (m_iDirtyBytes >= (int)m_kcp->mtu);
+	}
+
 private:
 	void DoRenew(const TArqAttr& attr, DWORD dwPeerConvID = 0)
 	{
@@ -525,15 +881,91 @@ private:
 		DoReset();
 
 		m_dwPeerConvID	= dwPeerConvID;
-		m_kcp			= ::ikcp_create(m_dwSelfConvID, m_pSocket);
+		m_bFec			= attr.IsFecEnabled();
+		m_dwFecTime		= 0;
+
+		//启用 FEC 时由会话拦截 kcp 输出，编码后再交给通信组件发送
+		if(m_bFec)
+		{
+			if(!m_fecEncoder)
+			{
+				m_fecEncoder.reset(new CFecEncoder);
+				m_fecDecoder.reset(new CFecDecoder);
+			}
+
+			ENSURE(m_fecEncoder->Init((int)attr.dwFecDataShards, (int)attr.dwFecParityShards, (int)attr.GetKcpMtu()));
+			ENSURE(m_fecDecoder->Init((int)attr.dwFecDataShards, (int)attr.dwFecParityShards, (int)attr.GetKcpMtu()));
+		}
+
+		m_kcp = ::ikcp_create(m_dwSelfConvID, m_bFec ? (LPVOID)this : (LPVOID)m_pSocket);
+
+		//KCP 数据包头的会话 ID 填写对端的会话 ID，接收方据此直接定位会话（对端忽略该字段，兼容旧版本）
+		if(m_dwPeerConvID != 0)
+			m_kcp->conv = m_dwPeerConvID;
 
 		::ikcp_nodelay(m_kcp, attr.bNoDelay ? 1 : 0, (int)attr.dwFlushInterval, (int)attr.dwResendByAcks, attr.bTurnoffNc ? 1 : 0);
 		::ikcp_wndsize(m_kcp, (int)attr.dwSendWndSize, (int)attr.dwRecvWndSize);
-		::ikcp_setmtu(m_kcp, attr.dwMtu);
+		::ikcp_setmtu(m_kcp, attr.GetKcpMtu());
 
 		m_kcp->rx_minrto	= (int)attr.dwMinRto;
 		m_kcp->fastlimit	= (int)attr.dwFastLimit;
-		m_kcp->output		= m_pContext->GetArqOutputProc();
+		m_kcp->output		= m_bFec ? FecOutputProc : m_pContext->GetArqOutputProc();
+
+		//可选拥塞控制器接管 KCP 拥塞窗口（每次刷新前设置，TArqAttr::IsValid() 保证未关闭拥塞控制）
+		m_pCongestCtrl.reset(CArqCongestCtrl::Create(attr.enCongestCtrl, attr.dwPacingRate, (int)m_kcp->mss));
+
+		if(m_pCongestCtrl)
+			m_pacer.Reset(::TimeGetTime());
+
+		m_dwSndNxt			= 0;
+		m_dwXmit			= 0;
+		m_dwFastXmit		= 0;
+
+		m_dwFlushDelay		= attr.dwFlushDelay;
+		m_bDirty			= FALSE;
+		m_dwDirtyTime		= 0;
+		m_iDirtyBytes		= 0;
+		m_bFlushPending		= FALSE;
+	}
+
+	static int FecOutputProc(const char* pBuffer, int iLength, IKCPCB* kcp, LPVOID pv)
+	{
+		CArqSessionT* pSession		= (CArqSessionT*)pv;
+		CFecEncoder* pEncoder		= pSession->m_fecEncoder.get();
+		Fn_ArqOutputProc fnOutput	= pSession->m_pContext->GetArqOutputProc();
+
+		const BYTE* pPacket	= pEncoder->Encode((const BYTE*)pBuffer, iLength);
+		int rs				= fnOutput((const char*)pPacket, iLength + FEC_OVERHEAD, kcp, pSession->m_pSocket);
+
+		//记录分组的第一个数据分片的发送时间
+		if(pEncoder->GetPendingCount() == 1)
+			pSession->m_dwFecTime = ::TimeGetTime();
+
+		int rs2 = pSession->SendFecParity(kcp);
+
+		if(rs == NO_ERROR)
+			rs = rs2;
+
+		return rs;
+	}
+
+	int SendFecParity(IKCPCB* kcp)
+	{
+		Fn_ArqOutputProc fnOutput	= m_pContext->GetArqOutputProc();
+		int rs						= NO_ERROR;
+
+		for(int i = 0; i < m_fecEncoder->GetParityCount(); i++)
+		{
+			int iParity;
+			const BYTE* pParity = m_fecEncoder->GetParity(i, iParity);
+
+			int rs2 = fnOutput((const char*)pParity, iParity, kcp, m_pSocket);
+
+			if(rs == NO_ERROR)
+				rs = rs2;
+		}
+
+		return rs;
 	}
 
 	void DoReset()
@@ -550,16 +982,20 @@ public:
 	BOOL		IsHandShaking()	const	{return GetStatus() == ARQ_HSS_PROC;}
 	BOOL		IsReady()		const	{return GetStatus() == ARQ_HSS_SUCC;}
 	IKCPCB*		GetKcp()				{return m_kcp;}
-	DWORD		GetConvID()		const	{if(!IsValid()) return 0; return m_kcp->conv;}
+	/* 本端会话 ID（m_kcp->conv 在握手后被替换为对端会话 ID，用于填写发出的 KCP 报文） */
+	DWORD		GetConvID()		const	{if(!IsValid()) return 0; return m_dwSelfConvID;}
 	DWORD		GetSelfConvID()	const	{return m_dwSelfConvID;}
 	DWORD		GetPeerConvID()	const	{return m_dwPeerConvID;}
+	S*			GetSocket()		const	{return m_pSocket;}
 	
 	CReentrantCriSec&		GetLock()			{return m_cs;}
 	EnArqHandShakeStatus GetStatus() const {return m_enStatus;}
 
 protected:
+	virtual DWORD RenewConvID() {return ::GenerateConversationID();}
 	virtual void RenewExtra(const TArqAttr& attr) {}
 	virtual void ResetExtra() {}
+	virtual void ScheduleExtra() {}
 
 public:
 	CArqSessionT()
@@ -573,6 +1009,16 @@ public:
 	, m_dwHSNextTime(0)
 	, m_dwHSSndCount(0)
 	, m_bHSComplete	(FALSE)
+	, m_dwFlushDelay(0)
+	, m_bDirty		(FALSE)
+	, m_dwDirtyTime	(0)
+	, m_iDirtyBytes	(0)
+	, m_bFec		(FALSE)
+	, m_dwFecTime	(0)
+	, m_dwSndNxt	(0)
+	, m_dwXmit		(0)
+	, m_dwFastXmit	(0)
+	, m_bFlushPending(FALSE)
 	{
 
 	}
@@ -601,6 +1047,23 @@ private:
 	DWORD	m_dwPeerConvID;
 	EnArqHandShakeStatus m_enStatus;
 
+	DWORD	m_dwFlushDelay;
+	BOOL	m_bDirty;
+	DWORD	m_dwDirtyTime;
+	int		m_iDirtyBytes;
+
+	BOOL	m_bFec;
+	DWORD	m_dwFecTime;
+	unique_ptr<CFecEncoder>	m_fecEncoder;
+	unique_ptr<CFecDecoder>	m_fecDecoder;
+
+	unique_ptr<CArqCongestCtrl>	m_pCongestCtrl;
+	TArqPacer	m_pacer;
+	DWORD		m_dwSndNxt;
+	DWORD		m_dwXmit;
+	DWORD		m_dwFastXmit;
+
+	atomic<BOOL>	 m_bFlushPending;
 	CReentrantCriSec m_cs;
 	IKCPCB*			 m_kcp;
 };
@@ -615,30 +1078,47 @@ template<class T, class S> class CArqSessionExT : public CArqSessionT<T, S>
 
 	friend class CArqSessionPoolT<T, S>;
 
+	using CArqSessionPool	= CArqSessionPoolT<T, S>;
+	using TScheduleMap		= multimap<ULLONG, CArqSessionExT*>;
+
 public:
 	DWORD GetFreeTime	()	const	{return m_dwFreeTime;}
-	FD GetTimer			()	const	{return m_fdTimer;}
+	ULONGLONG GetFreeEpoch()const	{return m_ullFreeEpoch;}
 
 protected:
+	virtual DWORD RenewConvID()
+	{
+		return m_ssPool.RegisterSession(this);
+	}
+
 	virtual void RenewExtra(const TArqAttr& attr)
 	{
-		m_fdTimer = m_ioDispatcher.AddTimer(attr.dwFlushInterval, this);
-		ASSERT(IS_VALID_FD(m_fdTimer));
+		m_ssPool.Schedule(this);
 	}
 
 	virtual void ResetExtra()
 	{
-		m_ioDispatcher.DelTimer(m_fdTimer);
+		m_ssPool.Unschedule(this);
+		m_ssPool.UnregisterSession(this);
+
+		m_dwFreeTime	= ::TimeGetTime();
+		m_ullFreeEpoch	= CEpochDomain::Retire();
+	}
 
-		m_dwFreeTime = ::TimeGetTime();
-		m_fdTimer	 = INVALID_FD;
+	virtual void ScheduleExtra()
+	{
+		m_ssPool.Schedule(this);
 	}
 
 public:
-	CArqSessionExT(CIODispatcher& ioDispatcher)
-	: m_ioDispatcher(ioDispatcher)
-	, m_fdTimer		(INVALID_FD)
+	CArqSessionExT(CArqSessionPool& ssPool)
+	: m_ssPool		(ssPool)
+	, m_bRegistered	(FALSE)
+	, m_dwTableIndex(0)
+	, m_iStripe		(0)
+	, m_bScheduled	(FALSE)
 	, m_dwFreeTime	(0)
+	, m_ullFreeEpoch(0)
 	{
 
 	}
@@ -648,17 +1128,27 @@ public:
 		Reset();
 	}
 
-	static CArqSessionExT* Construct(CIODispatcher& ioDispatcher)
-		{return new CArqSessionExT(ioDispatcher);}
+	static CArqSessionExT* Construct(CArqSessionPool& ssPool)
+		{return new CArqSessionExT(ssPool);}
 
 	static void Destruct(CArqSessionExT* pSession)
 		{if(pSession) delete pSession;}
 
 private:
-	CIODispatcher& m_ioDispatcher;
+	CArqSessionPool& m_ssPool;
+
+	/* 会话是否已加入会话池会话表，及其在会话表中的索引 */
+	BOOL			m_bRegistered;
+	DWORD			m_dwTableIndex;
+	/* 所属调度分片 */
+	int				m_iStripe;
+
+	/* 在会话池调度表中的位置（由所属调度分片的锁保护） */
+	BOOL			m_bScheduled;
+	typename TScheduleMap::iterator m_itSchedule;
 
-	uint32_t		m_fdTimer;
-	DWORD	m_dwFreeTime;
+	DWORD			m_dwFreeTime;
+	ULONGLONG		m_ullFreeEpoch;
 };
 
 template<class T, class S> class CArqSessionPoolT : private CIOHandler
@@ -666,6 +1156,21 @@ template<class T, class S> class CArqSessionPoolT : private CIOHandler
 	using CArqSessionEx		= CArqSessionExT<T, S>;
 	using TArqSessionList	= CRingPool<CArqSessionEx>;
 	using TArqSessionQueue	= CCASQueue<CArqSessionEx>;
+	using TArqSessionTable	= CRingCache2<CArqSessionEx, DWORD, true>;
+	using TScheduleMap		= typename CArqSessionEx::TScheduleMap;
+
+	friend class CArqSessionExT<T, S>;
+
+	/* 调度分片：会话按会话 ID 分散到各分片，每个分片拥有独立的调度表、调度锁及单次定时器 */
+	struct TScheduleStripe
+	{
+		CCriSec			cs;
+		TScheduleMap	schedule;
+		uint32_t		fdTimer;
+		ULLONG			armed;
+
+		TScheduleStripe() : fdTimer(0), armed(0) {}
+	};
 
 public:
 	CArqSessionEx* PickFreeSession(T* pContext, S* pSocket, const TArqAttr& attr)
@@ -675,7 +1180,7 @@ public:
 
 		if(m_lsFreeSession.TryLock(&pSession, dwIndex))
 		{
-			if(::GetTimeGap32(pSession->GetFreeTime()) >= m_dwSessionLockTime)
+			if(CEpochDomain::IsReclaimable(pSession->GetFreeEpoch()))
 				ENSURE(m_lsFreeSession.ReleaseLock(nullptr, dwIndex));
 			else
 			{
@@ -684,7 +1189,7 @@ public:
 			}
 		}
 
-		if(!pSession) pSession = CArqSessionEx::Construct(m_ioDispatcher);
+		if(!pSession) pSession = CArqSessionEx::Construct(*this);
 
 		ASSERT(pSession);
 		return (CArqSessionEx*)pSession->Renew(pContext, pSocket, attr);
@@ -701,9 +1206,46 @@ public:
 		}
 	}
 
-	void Prepare()
+	/*
+	* 根据会话 ID 查找会话：会话 ID 的低位即会话表的槽位，直接定位无需查找映射表，
+	* 高位随机部分须与槽位中会话的 ID 完全一致；
+	* 返回的会话由调用方（持有纪元的工作线程）校验有效性及对端地址
+	*/
+	CArqSessionEx* FindSession(DWORD dwConvID)
+	{
+		DWORD dwSlot = dwConvID & m_dwIndexMask;
+
+		if(dwSlot == 0 || dwSlot > m_dwTableSize)
+			return nullptr;
+
+		DWORD dwIndex = dwSlot - 1;
+		CArqSessionEx* pSession = nullptr;
+
+		m_bfSessions.INDEX_R2V(dwIndex);
+		TArqSessionTable::INDEX_INC(dwIndex);
+
+		if(m_bfSessions.Get(dwIndex, &pSession) != TArqSessionTable::GR_VALID || pSession->GetSelfConvID() != dwConvID)
+			pSession = nullptr;
+
+		return pSession;
+	}
+
+	void Prepare(DWORD dwMaxSessionCount)
 	{
 		m_lsFreeSession.Reset(m_dwSessionPoolSize);
+		//关闭中的会话在释放会话 ID 前可能已有新连接接入，预留同样数量的空间
+		m_dwTableSize = dwMaxSessionCount * 2;
+		m_bfSessions.Reset(m_dwTableSize);
+
+		//会话 ID 低位保存槽位（1 ~ m_dwTableSize），其余高位填充随机数
+		for(m_dwIndexMask = 1; m_dwIndexMask < m_dwTableSize; m_dwIndexMask = (m_dwIndexMask << 1) | 1);
+
+		int iStripes = m_pContext->GetWorkerThreadCount();
+		m_pStripes	 = make_unique<TScheduleStripe[]>(iStripes);
+		m_iStripes	 = iStripes;
+
+		for(int i = 0; i < m_iStripes; i++)
+			m_pStripes[i].fdTimer = ::GenerateNextTimerIdent();
 
 		m_ioDispatcher.Start(this, m_pContext->GetPostReceiveCount(), m_pContext->GetWorkerThreadCount());
 	}
@@ -712,16 +1254,139 @@ public:
 	{
 		m_ioDispatcher.Stop();
 
+		for(int i = 0; i < m_iStripes; i++)
+		{
+			TScheduleStripe& stripe = m_pStripes[i];
+			CCriSecLock locallock(stripe.cs);
+
+			for(auto it = stripe.schedule.begin(), end = stripe.schedule.end(); it != end; ++it)
+				it->second->m_bScheduled = FALSE;
+
+			stripe.schedule.clear();
+			stripe.armed = 0;
+		}
+
 		m_lsFreeSession.Clear();
 
 		ReleaseGCSession(TRUE);
 		ENSURE(m_lsGCSession.IsEmpty());
+
+		m_bfSessions.Reset();
+		m_dwTableSize	= 0;
+		m_dwIndexMask	= 0;
+
+		m_pStripes.reset();
+		m_iStripes = 0;
 	}
 
 private:
 	void ReleaseGCSession(BOOL bForce = FALSE)
 	{
-		::ReleaseGCObj(m_lsGCSession, m_dwSessionLockTime, bForce);
+		::ReleaseGCObj(m_lsGCSession, bForce);
+	}
+
+	/*
+	* 把会话加入会话表并返回会话 ID：会话 ID 由槽位和随机数组成，槽位重用时也不可预测
+	*（会话表已满时生成不在会话表中的会话 ID，此时按地址查找连接）
+	*/
+	DWORD RegisterSession(CArqSessionEx* pSession)
+	{
+		DWORD dwIndex	= 0;
+		DWORD dwConvID	= ::GenerateConversationID();
+
+		pSession->m_bRegistered = m_bfSessions.Put(pSession, dwIndex);
+
+		if(pSession->m_bRegistered)
+		{
+			DWORD dwSlot = (dwIndex - 1) % m_dwTableSize + 1;
+
+			pSession->m_dwTableIndex = dwIndex;
+			dwConvID = (dwConvID & ~m_dwIndexMask) | dwSlot;
+		}
+
+		pSession->m_iStripe = (m_iStripes > 0) ? (int)(dwConvID % m_iStripes) : 0;
+
+		return dwConvID;
+	}
+
+	void UnregisterSession(CArqSessionEx* pSession)
+	{
+		if(pSession->m_bRegistered)
+		{
+			m_bfSessions.Remove(pSession->m_dwTableIndex);
+			pSession->m_bRegistered = FALSE;
+		}
+	}
+
+	/*
+	* 会话调度：所有会话按下次调用 Check() 的时间（ikcp_check()）排序保存在所属分片的调度表中，
+	* 每个分片只使用一个单次定时器，定时器时间总是调度表中最早的时间；
+	* 没有待处理数据的空闲会话不在调度表中，直到再次发送或接收数据
+	*/
+	void Schedule(CArqSessionEx* pSession)
+	{
+		int iDelay = pSession->GetNextCheckDelay();
+
+		if(iDelay < 0)
+			return;
+
+		if(m_iStripes == 0)
+			return;
+
+		ULLONG ullTime			= ::TimeGetTime64() + iDelay;
+		TScheduleStripe& stripe	= m_pStripes[pSession->m_iStripe];
+
+		CCriSecLock locallock(stripe.cs);
+
+		//持有调度锁时检查会话状态：会话重置后（ResetExtra() 中移除）不再加入调度表
+		if(!pSession->IsValid())
+			return;
+
+		if(pSession->m_bScheduled)
+		{
+			if(pSession->m_itSchedule->first <= ullTime)
+				return;
+
+			stripe.schedule.erase(pSession->m_itSchedule);
+		}
+
+		pSession->m_itSchedule	= stripe.schedule.emplace(ullTime, pSession);
+		pSession->m_bScheduled	= TRUE;
+
+		ArmTimer(stripe);
+	}
+
+	void Unschedule(CArqSessionEx* pSession)
+	{
+		if(m_iStripes == 0)
+			return;
+
+		TScheduleStripe& stripe = m_pStripes[pSession->m_iStripe];
+
+		CCriSecLock locallock(stripe.cs);
+
+		if(pSession->m_bScheduled)
+		{
+			stripe.schedule.erase(pSession->m_itSchedule);
+			pSession->m_bScheduled = FALSE;
+		}
+	}
+
+	/* 按分片调度表中最早的时间设置定时器（调用方持有分片的调度锁） */
+	void ArmTimer(TScheduleStripe& stripe)
+	{
+		if(stripe.schedule.empty())
+			return;
+
+		ULLONG ullFirst = stripe.schedule.begin()->first;
+
+		if(stripe.armed != 0 && stripe.armed <= ullFirst)
+			return;
+
+		ULLONG ullCurrent = ::TimeGetTime64();
+
+		if(m_ioDispatcher.SetTimer(stripe.fdTimer, (LLONG)(ullFirst > ullCurrent ? ullFirst - ullCurrent : 0), &stripe))
+			stripe.armed = ullFirst;
 	}
 
 	virtual BOOL OnReadyRead(PVOID pv, UINT events) override
@@ -729,35 +1394,66 @@ private:
 		if(events == EVFILT_EXCEPT)
 			return FALSE;
 
-		CArqSessionEx* pSession = (CArqSessionEx*)pv;
+		TScheduleStripe& stripe = *(TScheduleStripe*)pv;
+
+		ASSERT(&stripe >= m_pStripes.get() && &stripe < m_pStripes.get() + m_iStripes);
 
-		if(!pSession->Check() && pSession->IsValid() && TUdpSocketObj::IsValid(pSession->m_pSocket))
-			pSession->m_pContext->Disconnect(pSession->m_pSocket->connID);
+		vector<CArqSessionEx*> vtDue;
 
-		// kqueue的timer不需要读取数据
-		// ::ReadTimer(pSession->GetTimer());
+		{
+			CCriSecLock locallock(stripe.cs);
+
+			stripe.armed = 0;
+
+			ULLONG ullCurrent	= ::TimeGetTime64();
+			auto it				= stripe.schedule.begin();
+			auto end			= stripe.schedule.end();
+
+			for(; it != end && it->first <= ullCurrent; ++it)
+			{
+				it->second->m_bScheduled = FALSE;
+				vtDue.push_back(it->second);
+			}
+
+			stripe.schedule.erase(stripe.schedule.begin(), it);
+		}
+
+		//工作线程持有纪元，处理期间被重置的会话不会被回收
+		for(auto it = vtDue.begin(), end = vtDue.end(); it != end; ++it)
+		{
+			CArqSessionEx* pSession = *it;
+
+			if(!pSession->Check() && pSession->IsValid() && TUdpSocketObj::IsValid(pSession->m_pSocket))
+				pSession->m_pContext->Disconnect(pSession->m_pSocket->connID);
+			else
+				Schedule(pSession);
+		}
+
+		{
+			CCriSecLock locallock(stripe.cs);
+			ArmTimer(stripe);
+		}
 
 		return TRUE;
 	}
 
 public:
-	void SetSessionLockTime	(DWORD dwSessionLockTime)	{m_dwSessionLockTime = dwSessionLockTime;}
 	void SetSessionPoolSize	(DWORD dwSessionPoolSize)	{m_dwSessionPoolSize = dwSessionPoolSize;}
 	void SetSessionPoolHold	(DWORD dwSessionPoolHold)	{m_dwSessionPoolHold = dwSessionPoolHold;}
 
-	DWORD GetSessionLockTime()	{return m_dwSessionLockTime;}
 	DWORD GetSessionPoolSize()	{return m_dwSessionPoolSize;}
 	DWORD GetSessionPoolHold()	{return m_dwSessionPoolHold;}
 
 public:
 	CArqSessionPoolT(T* pContext,
 					DWORD dwPoolSize = DEFAULT_SESSION_POOL_SIZE,
-					DWORD dwPoolHold = DEFAULT_SESSION_POOL_HOLD,
-					DWORD dwLockTime = DEFAULT_SESSION_LOCK_TIME)
+					DWORD dwPoolHold = DEFAULT_SESSION_POOL_HOLD)
 	: m_pContext(pContext)
 	, m_dwSessionPoolSize(dwPoolSize)
 	, m_dwSessionPoolHold(dwPoolHold)
-	, m_dwSessionLockTime(dwLockTime)
+	, m_dwTableSize		(0)
+	, m_dwIndexMask		(0)
+	, m_iStripes		(0)
 	{
 
 	}
@@ -767,24 +1463,27 @@ public:
 	DECLARE_NO_COPY_CLASS(CArqSessionPoolT)
 
 public:
-	static const DWORD DEFAULT_SESSION_LOCK_TIME;
 	static const DWORD DEFAULT_SESSION_POOL_SIZE;
 	static const DWORD DEFAULT_SESSION_POOL_HOLD;
 
 private:
 	T*					m_pContext;
 
-	DWORD				m_dwSessionLockTime;
 	DWORD				m_dwSessionPoolSize;
 	DWORD				m_dwSessionPoolHold;
 
 	TArqSessionList		m_lsFreeSession;
 	TArqSessionQueue	m_lsGCSession;
+	TArqSessionTable	m_bfSessions;
+	DWORD				m_dwTableSize;
+	DWORD				m_dwIndexMask;
+
+	unique_ptr<TScheduleStripe[]>	m_pStripes;
+	int								m_iStripes;
 
 	CIODispatcher		m_ioDispatcher;
 };
 
-template<class T, class S> const DWORD CArqSessionPoolT<T, S>::DEFAULT_SESSION_LOCK_TIME	= DEFAULT_OBJECT_CACHE_LOCK_TIME;
 template<class T, class S> const DWORD CArqSessionPoolT<T, S>::DEFAULT_SESSION_POOL_SIZE	= DEFAULT_OBJECT_CACHE_POOL_SIZE;
 template<class T, class S> const DWORD CArqSessionPoolT<T, S>::DEFAULT_SESSION_POOL_HOLD	= DEFAULT_OBJECT_CACHE_POOL_HOLD;
 
@@ -220,6 +220,16 @@ HPSOCKET_API LPCTSTR HP_GetSocketErrorDesc(EnSocketError enCode)
 	return ::GetSocketErrorDesc(enCode);
 }
 
+HPSOCKET_API void HP_EnterObjectEpoch()
+{
+	CEpochDomain::Enter();
+}
+
+HPSOCKET_API void HP_LeaveObjectEpoch()
+{
+	CEpochDomain::Leave();
+}
+
 HPSOCKET_API DWORD SYS_GetLastError()
 {
 	return ::GetLastError();
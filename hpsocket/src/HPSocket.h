@@ -473,6 +473,12 @@ HPSOCKET_API DWORD HP_GetHPSocketVersion();
 
 // 获取错误描述文本
 HPSOCKET_API LPCTSTR HP_GetSocketErrorDesc(EnSocketError enCode);
+
+// 进入对象访问保护段（可嵌套）：保护段内通过连接 ID 取得的组件内部对象（如 HTTP 请求头、URL 域等字符串）不会被回收重用；
+// 在组件事件回调之外访问这些数据时使用，保护段应尽量短小，保护段内不能长时间阻塞
+HPSOCKET_API void HP_EnterObjectEpoch();
+// 离开对象访问保护段（与 HP_EnterObjectEpoch() 成对调用，且必须在同一线程中调用）
+HPSOCKET_API void HP_LeaveObjectEpoch();
 // 调用系统的 errno 方法获取系统错误代码
 HPSOCKET_API DWORD SYS_GetLastError();
 // 调用系统的 strerror() 方法获取系统错误代码描述
@@ -778,3 +784,15 @@ struct HPThreadPool_Creator
 
 // IHPThreadPool 对象智能指针
 typedef CHPObjectPtr<IHPThreadPool, HPThreadPool_Creator>	CHPThreadPoolPtr;
+
+// 对象访问保护段守护对象：构造时调用 HP_EnterObjectEpoch()，析构时调用 HP_LeaveObjectEpoch()
+class CHPObjectEpochGuard
+{
+public:
+	CHPObjectEpochGuard()	{HP_EnterObjectEpoch();}
+	~CHPObjectEpochGuard()	{HP_LeaveObjectEpoch();}
+
+private:
+	CHPObjectEpochGuard(const CHPObjectEpochGuard&);
+	CHPObjectEpochGuard& operator = (const CHPObjectEpochGuard&);
+};
@@ -162,6 +162,22 @@ typedef enum EnOnSendSyncPolicy
 	OSSP_RECEIVE		= 2,	// 同步 OnReceive（只用于 TCP 组件）	
 } En_HP_OnSendSyncPolicy;
 
+/************************************************************************
+名称：OnSend 事件通知策略
+描述：Server 组件和 Agent 组件的 OnSend 事件触发方式
+
+* 逐次通知（默认）	：每次成功写出数据后都触发 OnSend 事件
+* 合并通知		：每次处理发送事件时，连接写出的所有数据只触发一次 OnSend 事件，
+				  pData 参数为 nullptr，iLength 参数为本次写出的总字节数
+* 不通知			：不触发 OnSend 事件
+************************************************************************/
+typedef enum EnOnSendNotifyPolicy
+{
+	OSNP_EACH			= 0,	// 逐次通知（默认）
+	OSNP_BATCH			= 1,	// 合并通知
+	OSNP_NONE			= 2,	// 不通知
+} En_HP_OnSendNotifyPolicy;
+
 /************************************************************************
 名称：地址重用选项
 描述：通信组件底层 socket 的地址重用选项
@@ -210,6 +226,22 @@ typedef enum EnCastMode
 	CM_BROADCAST	= 1,	// 广播
 } En_HP_CastMode;
 
+/************************************************************************
+名称：ARQ 拥塞控制算法
+描述：UDP ARQ 组件的拥塞控制及发送速率控制（Pacing）算法
+
+* KCP（默认）	：KCP 内置拥塞窗口（可通过 SetTurnoffCongestCtrl() 关闭），不限制发送速率
+* 固定速率		：按 SetPacingRate() 设置的速率匀速发送，拥塞窗口只受发送窗口和远端接收窗口限制
+* BBR			：估算瓶颈带宽及最小 RTT，按 带宽 x 增益 匀速发送，拥塞窗口为 2 倍带宽时延积
+				  （SetPacingRate() 设置的速率作为发送速率上限，0 则不限制）
+************************************************************************/
+typedef enum EnArqCongestCtrl
+{
+	ACC_KCP			= 0,	// KCP 内置拥塞控制（默认）
+	ACC_FIXED_RATE	= 1,	// 固定速率
+	ACC_BBR			= 2,	// BBR
+} En_HP_ArqCongestCtrl;
+
 /************************************************************************
 名称：IP 地址类型
 描述：IP 地址类型枚举值
@@ -241,6 +273,17 @@ typedef struct _WSABUF
 	LPBYTE	buf;
 } WSABUF, *PWSABUF, *LPWSABUF;
 
+/************************************************************************
+名称：UDP 数据报结构体
+描述：批量数据到达通知中的单个数据报及其来源地址
+************************************************************************/
+typedef struct TUdpDatagram
+{
+	LPCTSTR	address;	// 远程地址
+	USHORT	port;		// 远程端口
+	WSABUF	buffer;		// 数据报内容
+} *LPTUdpDatagram, HP_TUdpDatagram, *HP_LPTUdpDatagram;
+
 /************************************************************************
 名称：拒绝策略
 描述：调用被拒绝后的处理策略
@@ -299,6 +342,100 @@ typedef struct TSocketTask
 	LPARAM				lparam;		// 自定义参数
 } *LPTSocketTask, HP_TSocketTask, *HP_LPTSocketTask;
 
+/************************************************************************
+名称：分布统计结构体
+描述：由 HDR 风格直方图（每个 2 的幂区间 8 个子桶，相对误差不超过 12.5%）计算的分布统计，
+		数值单位由所属字段决定
+************************************************************************/
+typedef struct THistogramStat
+{
+	ULLONG	count;		// 样本数
+	ULLONG	sum;		// 样本总和
+	ULLONG	min;		// 最小值
+	ULLONG	max;		// 最大值
+	ULLONG	p50;		// 50 分位值
+	ULLONG	p90;		// 90 分位值
+	ULLONG	p99;		// 99 分位值
+	ULLONG	p999;		// 99.9 分位值
+} *LPTHistogramStat, HP_THistogramStat, *HP_LPTHistogramStat;
+
+/************************************************************************
+名称：运行时度量结构体
+描述：通信组件运行时度量快照（组件启动后开始计数，需先调用 SetCollectMetrics(TRUE) 启用采集）
+		计数器均为累计值，速率（如每秒接受连接数）由调用方按两次快照的差值计算；
+		“每事件系统调用数” = (recvCalls + sendCalls) / ioEvents
+************************************************************************/
+typedef struct TSocketMetrics
+{
+	ULLONG	uptime;				// 组件运行时长（毫秒）
+	DWORD	connections;		// 当前连接数
+	DWORD	commandQueue;		// 当前分发命令队列深度
+
+	ULLONG	bytesIn;			// 接收字节数
+	ULLONG	bytesOut;			// 发送字节数
+	ULLONG	readsIn;			// 读取到数据的接收系统调用次数（TCP 可能合并或拆分消息，不等于 OnReceive 次数）
+	ULLONG	msgsOut;			// 发送消息数（Send 调用次数）
+	ULLONG	recvCalls;			// 接收系统调用次数
+	ULLONG	sendCalls;			// 发送系统调用次数
+	ULLONG	ioEvents;			// 分发的 IO 事件数
+	ULLONG	connects;			// 建立的连接数（accept 或 connect）
+	ULLONG	closes;				// 关闭的连接数
+	ULLONG	loops;				// 事件循环次数
+	ULLONG	commands;			// 处理的分发命令数
+	ULLONG	heapAllocBytes;		// 组件私有堆（连接对象及收发缓冲区）当前已分配字节数
+	ULLONG	heapReservedBytes;	// 组件私有堆从系统映射的字节数
+
+	THistogramStat	callbackTime;		// 事件回调耗时（纳秒）
+	THistogramStat	loopTime;			// 每次事件循环处理耗时（纳秒）
+	THistogramStat	sendQueueDepth;		// 发送请求入队后的待发数据长度（字节）
+	THistogramStat	commandQueueDepth;	// 处理命令时命令队列深度
+} *LPTSocketMetrics, HP_TSocketMetrics, *HP_LPTSocketMetrics;
+
+/************************************************************************
+名称：ARQ 会话状态结构体
+描述：UDP ARQ 连接的拥塞控制状态快照
+************************************************************************/
+typedef struct TArqSessionStats
+{
+	DWORD	cwnd;				// 当前有效拥塞窗口（数据包数量）
+	DWORD	inflight;			// 在途（已发送未确认）数据包数量
+	DWORD	waitingSend;		// 等待发送数据包数量
+	DWORD	srtt;				// 平滑 RTT（毫秒）
+	DWORD	minRtt;				// 最小 RTT 估计值（毫秒，仅 BBR）
+	DWORD	rto;				// 重传超时时间（毫秒）
+	ULLONG	pacingRate;			// 发送速率（字节/秒，0 表示不限制）
+	ULLONG	bandwidth;			// 瓶颈带宽估计值（字节/秒，仅 BBR）
+	ULLONG	retransmits;		// 超时重传次数
+} *LPTArqSessionStats, HP_TArqSessionStats, *HP_LPTArqSessionStats;
+
+/************************************************************************
+名称：工作线程跟踪统计结构体
+描述：事件循环跟踪开启（慢回调阈值大于 0）期间各工作线程的累计统计
+		繁忙率 = busyTime / (busyTime + idleTime)
+************************************************************************/
+typedef struct TWorkerTraceStat
+{
+	ULLONG	busyTime;	// 处理事件耗时（微秒）
+	ULLONG	idleTime;	// 等待事件耗时（微秒）
+	ULLONG	events;		// 处理的事件数
+	ULLONG	slowEvents;	// 慢回调次数
+	DWORD	busyRatio;	// 繁忙率（万分比）
+} *LPTWorkerTraceStat, HP_TWorkerTraceStat, *HP_LPTWorkerTraceStat;
+
+/************************************************************************
+名称：慢回调记录结构体
+描述：事件处理耗时达到慢回调阈值时记录的跟踪信息
+************************************************************************/
+typedef struct TSlowCallback
+{
+	ULLONG				seq;		// 记录序号（从 1 开始递增，不连续表示记录已被覆盖）
+	ULLONG				timestamp;	// 事件开始时间（毫秒，与 TimeGetTime64() 同一时钟）
+	ULLONG				duration;	// 处理耗时（微秒）
+	CONNID				connID;		// 连接 ID（0：监听 Socket 等不属于某个连接的事件）
+	EnSocketOperation	operation;	// 事件类型
+	int					worker;		// 工作线程序号（-1：非工作线程）
+} *LPTSlowCallback, HP_TSlowCallback, *HP_LPTSlowCallback;
+
 /************************************************************************
 名称：获取 HPSocket 版本号
 描述：版本号（4 个字节分别为：主版本号，子版本号，修正版本号，构建编号）
@@ -359,7 +496,8 @@ typedef enum EnSSLSessionInfo
 	SSL_SSI_PEER_CERT			= 13,	// SSL Peer Cert		（输出类型：X509*）
 	SSL_SSI_PEER_CERT_CHAIN		= 14,	// SSL Peer Cert Chain	（输出类型：STACK_OF(X509)*）
 	SSL_SSI_VERIFIED_CHAIN		= 15,	// SSL Verified Chain	（输出类型：STACK_OF(X509)*）
-	SSL_SSI_MAX					= 15,	// 
+	SSL_SSI_ALPN_PROTOCOL		= 16,	// ALPN Protocol		（输出类型：LPCSTR，未协商时为空串）
+	SSL_SSI_MAX					= 16,	// 
 } En_HP_SSLSessionInfo;
 
 /************************************************************************
@@ -393,7 +531,8 @@ typedef Fn_SNI_ServerNameCallback	HP_Fn_SNI_ServerNameCallback;
 typedef enum EnHttpVersion
 {
 	HV_1_0	= MAKEWORD(1, 0),	// HTTP/1.0
-	HV_1_1	= MAKEWORD(1, 1)	// HTTP/1.1
+	HV_1_1	= MAKEWORD(1, 1),	// HTTP/1.1
+	HV_2_0	= MAKEWORD(2, 0)	// HTTP/2
 } En_HP_HttpVersion;
 
 /************************************************************************
@@ -526,4 +665,10 @@ TParam, HP_TParam, *LPPARAM, *HP_LPPARAM,
 THeader, HP_THeader, *LPHEADER, *HP_LPHEADER,
 TCookie, HP_TCookie, *LPCOOKIE, *HP_LPCOOKIE;
 
+/************************************************************************
+名称：无效的管线化请求序号
+描述：获取管线化请求序号失败时的返回值
+************************************************************************/
+#define HTTP_INVALID_REQUEST_SEQ	((DWORD)-1)
+
 #endif
@@ -0,0 +1,1981 @@
+/*
+ * Copyright: JessMA Open Source (ldcsaa@gmail.com)
+ *
+ * Author	: Bruce Liang
+ * Website	: https://github.com/ldcsaa
+ * Project	: https://github.com/ldcsaa/HP-Socket
+ * Blog		: http://www.cnblogs.com/ldcsaa
+ * Wiki		: http://www.oschina.net/p/hp-socket
+ * QQ Group	: 44636872, 75375912
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Http2Helper.h"
+
+#ifdef _HTTP_SUPPORT
+
+/* 字符串为空时 CBufferPtr::Ptr() 可能为 nullptr */
+#define H2_SAFE_STR(p)		((p) != nullptr ? (LPCSTR)(p) : "")
+
+// ------------------------------------------------------------------------------------------------------------- //
+
+void CHttp2FieldList::Add(LPCSTR lpszName, int iNameLen, LPCSTR lpszValue, int iValueLen)
+{
+	static const char c = 0;
+
+	TField field;
+
+	field.nameOff	= (int)m_buffer.Size();
+	field.nameLen	= iNameLen;
+
+	if(iNameLen > 0) m_buffer.Cat(lpszName, iNameLen);
+	m_buffer.Cat(&c);
+
+	field.valueOff	= (int)m_buffer.Size();
+	field.valueLen	= iValueLen;
+
+	if(iValueLen > 0) m_buffer.Cat(lpszValue, iValueLen);
+	m_buffer.Cat(&c);
+
+	m_fields.push_back(field);
+	m_uiListSize += (UINT)(iNameLen + iValueLen + 32);
+}
+
+void CHttp2FieldList::Clear()
+{
+	m_buffer.SetSize(0);
+	m_fields.clear();
+
+	m_uiListSize = 0;
+}
+
+void CHttp2FieldList::Copy(const CHttp2FieldList& other)
+{
+	Clear();
+
+	for(int i = 0; i < other.Size(); i++)
+		Add(other.GetName(i), other.GetNameLen(i), other.GetValue(i), other.GetValueLen(i));
+}
+
+int CHttp2FieldList::Find(LPCSTR lpszName) const
+{
+	for(int i = 0; i < Size(); i++)
+	{
+		if(strcmp(GetName(i), lpszName) == 0)
+			return i;
+	}
+
+	return -1;
+}
+
+int CHttp2FieldList::FindNoCase(LPCSTR lpszName) const
+{
+	for(int i = 0; i < Size(); i++)
+	{
+		if(strcasecmp(GetName(i), lpszName) == 0)
+			return i;
+	}
+
+	return -1;
+}
+
+// ------------------------------------------------------------------------------------------------------------- //
+
+/* RFC 7541 附录 B：Huffman 码表（最后一项为 EOS） */
+struct THuffmanCode
+{
+	UINT	code;
+	int		bits;
+};
+
+static const THuffmanCode s_huffmanCodes[257] =
+{
+	{0x00001FF8, 13}, {0x007FFFD8, 23}, {0x0FFFFFE2, 28}, {0x0FFFFFE3, 28}, {0x0FFFFFE4, 28}, {0x0FFFFFE5, 28}, {0x0FFFFFE6, 28}, {0x0FFFFFE7, 28},
+	{0x0FFFFFE8, 28}, {0x00FFFFEA, 24}, {0x3FFFFFFC, 30}, {0x0FFFFFE9, 28}, {0x0FFFFFEA, 28}, {0x3FFFFFFD, 30}, {0x0FFFFFEB, 28}, {0x0FFFFFEC, 28},
+	{0x0FFFFFED, 28}, {0x0FFFFFEE, 28}, {0x0FFFFFEF, 28}, {0x0FFFFFF0, 28}, {0x0FFFFFF1, 28}, {0x0FFFFFF2, 28}, {0x3FFFFFFE, 30}, {0x0FFFFFF3, 28},
+	{0x0FFFFFF4, 28}, {0x0FFFFFF5, 28}, {0x0FFFFFF6, 28}, {0x0FFFFFF7, 28}, {0x0FFFFFF8, 28}, {0x0FFFFFF9, 28}, {0x0FFFFFFA, 28}, {0x0FFFFFFB, 28},
+	{0x00000014,  6}, {0x000003F8, 10}, {0x000003F9, 10}, {0x00000FFA, 12}, {0x00001FF9, 13}, {0x00000015,  6}, {0x000000F8,  8}, {0x000007FA, 11},
+	{0x000003FA, 10}, {0x000003FB, 10}, {0x000000F9,  8}, {0x000007FB, 11}, {0x000000FA,  8}, {0x00000016,  6}, {0x00000017,  6}, {0x00000018,  6},
+	{0x00000000,  5}, {0x00000001,  5}, {0x00000002,  5}, {0x00000019,  6}, {0x0000001A,  6}, {0x0000001B,  6}, {0x0000001C,  6}, {0x0000001D,  6},
+	{0x0000001E,  6}, {0x0000001F,  6}, {0x0000005C,  7}, {0x000000FB,  8}, {0x00007FFC, 15}, {0x00000020,  6}, {0x00000FFB, 12}, {0x000003FC, 10},
+	{0x00001FFA, 13}, {0x00000021,  6}, {0x0000005D,  7}, {0x0000005E,  7}, {0x0000005F,  7}, {0x00000060,  7}, {0x00000061,  7}, {0x00000062,  7},
+	{0x00000063,  7}, {0x00000064,  7}, {0x00000065,  7}, {0x00000066,  7}, {0x00000067,  7}, {0x00000068,  7}, {0x00000069,  7}, {0x0000006A,  7},
+	{0x0000006B,  7}, {0x0000006C,  7}, {0x0000006D,  7}, {0x0000006E,  7}, {0x0000006F,  7}, {0x00000070,  7}, {0x00000071,  7}, {0x00000072,  7},
+	{0x000000FC,  8}, {0x00000073,  7}, {0x000000FD,  8}, {0x00001FFB, 13}, {0x0007FFF0, 19}, {0x00001FFC, 13}, {0x00003FFC, 14}, {0x00000022,  6},
+	{0x00007FFD, 15}, {0x00000003,  5}, {0x00000023,  6}, {0x00000004,  5}, {0x00000024,  6}, {0x00000005,  5}, {0x00000025,  6}, {0x00000026,  6},
+	{0x00000027,  6}, {0x00000006,  5}, {0x00000074,  7}, {0x00000075,  7}, {0x00000028,  6}, {0x00000029,  6}, {0x0000002A,  6}, {0x00000007,  5},
+	{0x0000002B,  6}, {0x00000076,  7}, {0x0000002C,  6}, {0x00000008,  5}, {0x00000009,  5}, {0x0000002D,  6}, {0x00000077,  7}, {0x00000078,  7},
+	{0x00000079,  7}, {0x0000007A,  7}, {0x0000007B,  7}, {0x00007FFE, 15}, {0x000007FC, 11}, {0x00003FFD, 14}, {0x00001FFD, 13}, {0x0FFFFFFC, 28},
+	{0x000FFFE6, 20}, {0x003FFFD2, 22}, {0x000FFFE7, 20}, {0x000FFFE8, 20}, {0x003FFFD3, 22}, {0x003FFFD4, 22}, {0x003FFFD5, 22}, {0x007FFFD9, 23},
+	{0x003FFFD6, 22}, {0x007FFFDA, 23}, {0x007FFFDB, 23}, {0x007FFFDC, 23}, {0x007FFFDD, 23}, {0x007FFFDE, 23}, {0x00FFFFEB, 24}, {0x007FFFDF, 23},
+	{0x00FFFFEC, 24}, {0x00FFFFED, 24}, {0x003FFFD7, 22}, {0x007FFFE0, 23}, {0x00FFFFEE, 24}, {0x007FFFE1, 23}, {0x007FFFE2, 23}, {0x007FFFE3, 23},
+	{0x007FFFE4, 23}, {0x001FFFDC, 21}, {0x003FFFD8, 22}, {0x007FFFE5, 23}, {0x003FFFD9, 22}, {0x007FFFE6, 23}, {0x007FFFE7, 23}, {0x00FFFFEF, 24},
+	{0x003FFFDA, 22}, {0x001FFFDD, 21}, {0x000FFFE9, 20}, {0x003FFFDB, 22}, {0x003FFFDC, 22}, {0x007FFFE8, 23}, {0x007FFFE9, 23}, {0x001FFFDE, 21},
+	{0x007FFFEA, 23}, {0x003FFFDD, 22}, {0x003FFFDE, 22}, {0x00FFFFF0, 24}, {0x001FFFDF, 21}, {0x003FFFDF, 22}, {0x007FFFEB, 23}, {0x007FFFEC, 23},
+	{0x001FFFE0, 21}, {0x001FFFE1, 21}, {0x003FFFE0, 22}, {0x001FFFE2, 21}, {0x007FFFED, 23}, {0x003FFFE1, 22}, {0x007FFFEE, 23}, {0x007FFFEF, 23},
+	{0x000FFFEA, 20}, {0x003FFFE2, 22}, {0x003FFFE3, 22}, {0x003FFFE4, 22}, {0x007FFFF0, 23}, {0x003FFFE5, 22}, {0x003FFFE6, 22}, {0x007FFFF1, 23},
+	{0x03FFFFE0, 26}, {0x03FFFFE1, 26}, {0x000FFFEB, 20}, {0x0007FFF1, 19}, {0x003FFFE7, 22}, {0x007FFFF2, 23}, {0x003FFFE8, 22}, {0x01FFFFEC, 25},
+	{0x03FFFFE2, 26}, {0x03FFFFE3, 26}, {0x03FFFFE4, 26}, {0x07FFFFDE, 27}, {0x07FFFFDF, 27}, {0x03FFFFE5, 26}, {0x00FFFFF1, 24}, {0x01FFFFED, 25},
+	{0x0007FFF2, 19}, {0x001FFFE3, 21}, {0x03FFFFE6, 26}, {0x07FFFFE0, 27}, {0x07FFFFE1, 27}, {0x03FFFFE7, 26}, {0x07FFFFE2, 27}, {0x00FFFFF2, 24},
+	{0x001FFFE4, 21}, {0x001FFFE5, 21}, {0x03FFFFE8, 26}, {0x03FFFFE9, 26}, {0x0FFFFFFD, 28}, {0x07FFFFE3, 27}, {0x07FFFFE4, 27}, {0x07FFFFE5, 27},
+	{0x000FFFEC, 20}, {0x00FFFFF3, 24}, {0x000FFFED, 20}, {0x001FFFE6, 21}, {0x003FFFE9, 22}, {0x001FFFE7, 21}, {0x001FFFE8, 21}, {0x007FFFF3, 23},
+	{0x003FFFEA, 22}, {0x003FFFEB, 22}, {0x01FFFFEE, 25}, {0x01FFFFEF, 25}, {0x00FFFFF4, 24}, {0x00FFFFF5, 24}, {0x03FFFFEA, 26}, {0x007FFFF4, 23},
+	{0x03FFFFEB, 26}, {0x07FFFFE6, 27}, {0x03FFFFEC, 26}, {0x03FFFFED, 26}, {0x07FFFFE7, 27}, {0x07FFFFE8, 27}, {0x07FFFFE9, 27}, {0x07FFFFEA, 27},
+	{0x07FFFFEB, 27}, {0x0FFFFFFE, 28}, {0x07FFFFEC, 27}, {0x07FFFFED, 27}, {0x07FFFFEE, 27}, {0x07FFFFEF, 27}, {0x07FFFFF0, 27}, {0x03FFFFEE, 26},
+	{0x3FFFFFFF, 30}
+};
+
+/* Huffman 解码树：子节点值大于 0 为内部节点索引，小于 0 为叶子节点（符号为 -value - 1） */
+struct THuffmanTree
+{
+	short nodes[256][2];
+
+	THuffmanTree()
+	{
+		int iCount = 1;
+
+		::ZeroMemory(nodes, sizeof(nodes));
+
+		for(int sym = 0; sym < 257; sym++)
+		{
+			const THuffmanCode& hc = s_huffmanCodes[sym];
+
+			int iNode = 0;
+
+			for(int i = hc.bits - 1; i > 0; i--)
+			{
+				int iBit = (hc.code >> i) & 1;
+
+				if(nodes[iNode][iBit] == 0)
+					nodes[iNode][iBit] = (short)(iCount++);
+
+				iNode = nodes[iNode][iBit];
+			}
+
+			nodes[iNode][hc.code & 1] = (short)(-sym - 1);
+		}
+
+		ASSERT(iCount == 256);
+	}
+};
+
+static const THuffmanTree& HuffmanTree()
+{
+	static const THuffmanTree s_tree;
+	return s_tree;
+}
+
+int CHpackHuffman::GetEncodedLength(LPCSTR lpszData, int iLength)
+{
+	UINT64 ullBits = 0;
+
+	for(int i = 0; i < iLength; i++)
+		ullBits += s_huffmanCodes[(BYTE)lpszData[i]].bits;
+
+	return (int)((ullBits + 7) >> 3);
+}
+
+void CHpackHuffman::Encode(LPCSTR lpszData, int iLength, CBufferPtr& buffer)
+{
+	size_t iOffset	= buffer.Size();
+	BYTE* p			= buffer.Realloc(iOffset + GetEncodedLength(lpszData, iLength)) + iOffset;
+
+	UINT64 ullBits	= 0;
+	int iBits		= 0;
+
+	for(int i = 0; i < iLength; i++)
+	{
+		const THuffmanCode& hc = s_huffmanCodes[(BYTE)lpszData[i]];
+
+		ullBits	 = (ullBits << hc.bits) | hc.code;
+		iBits	+= hc.bits;
+
+		while(iBits >= 8)
+		{
+			iBits -= 8;
+			*p++ = (BYTE)(ullBits >> iBits);
+		}
+
+		ullBits &= ((1ULL << iBits) - 1);
+	}
+
+	/* 使用 EOS 的高位（全 1）填充 */
+	if(iBits > 0)
+		*p++ = (BYTE)((ullBits << (8 - iBits)) | (0xFF >> iBits));
+}
+
+BOOL CHpackHuffman::Decode(const BYTE* pData, int iLength, CCharBufferPtr& buffer)
+{
+	const THuffmanTree& tree = HuffmanTree();
+
+	/* 最短编码为 5 位 */
+	size_t iOffset	= buffer.Size();
+	char* pStart	= buffer.Realloc(iOffset + (iLength * 8) / 5 + 1);
+	char* p			= pStart + iOffset;
+
+	int iNode		= 0;
+	int iDepth		= 0;
+	BOOL bAllOnes	= TRUE;
+
+	for(int i = 0; i < iLength; i++)
+	{
+		BYTE b = pData[i];
+
+		for(int j = 7; j >= 0; j--)
+		{
+			int iBit	= (b >> j) & 1;
+			int iNext	= tree.nodes[iNode][iBit];
+
+			if(iNext < 0)
+			{
+				int sym = -iNext - 1;
+
+				if(sym == 256)
+					return FALSE;
+
+				*p++		= (char)sym;
+				iNode		= 0;
+				iDepth		= 0;
+				bAllOnes	= TRUE;
+			}
+			else
+			{
+				iNode		 = iNext;
+				iDepth		+= 1;
+				bAllOnes	&= iBit;
+			}
+		}
+	}
+
+	/* 填充不能超过 7 位且必须是 EOS 的高位 */
+	if(iDepth > 7 || !bAllOnes)
+		return FALSE;
+
+	buffer.SetSize(p - pStart);
+
+	return TRUE;
+}
+
+// ------------------------------------------------------------------------------------------------------------- //
+
+/* RFC 7541 附录 A：静态表 */
+struct TStaticEntry
+{
+	LPCSTR	name;
+	int		nameLen;
+	LPCSTR	value;
+	int		valueLen;
+};
+
+#define HPACK_ENTRY(n, v)	{n, sizeof(n) - 1, v, sizeof(v) - 1}
+
+static const TStaticEntry s_staticTable[CHpackTable::STATIC_COUNT] =
+{
+	HPACK_ENTRY(":authority",				""),
+	HPACK_ENTRY(":method",					"GET"),
+	HPACK_ENTRY(":method",					"POST"),
+	HPACK_ENTRY(":path",					"/"),
+	HPACK_ENTRY(":path",					"/index.html"),
+	HPACK_ENTRY(":scheme",					"http"),
+	HPACK_ENTRY(":scheme",					"https"),
+	HPACK_ENTRY(":status",					"200"),
+	HPACK_ENTRY(":status",					"204"),
+	HPACK_ENTRY(":status",					"206"),
+	HPACK_ENTRY(":status",					"304"),
+	HPACK_ENTRY(":status",					"400"),
+	HPACK_ENTRY(":status",					"404"),
+	HPACK_ENTRY(":status",					"500"),
+	HPACK_ENTRY("accept-charset",			""),
+	HPACK_ENTRY("accept-encoding",			"gzip, deflate"),
+	HPACK_ENTRY("accept-language",			""),
+	HPACK_ENTRY("accept-ranges",			""),
+	HPACK_ENTRY("accept",					""),
+	HPACK_ENTRY("access-control-allow-origin",	""),
+	HPACK_ENTRY("age",						""),
+	HPACK_ENTRY("allow",					""),
+	HPACK_ENTRY("authorization",			""),
+	HPACK_ENTRY("cache-control",			""),
+	HPACK_ENTRY("content-disposition",		""),
+	HPACK_ENTRY("content-encoding",			""),
+	HPACK_ENTRY("content-language",			""),
+	HPACK_ENTRY("content-length",			""),
+	HPACK_ENTRY("content-location",			""),
+	HPACK_ENTRY("content-range",			""),
+	HPACK_ENTRY("content-type",				""),
+	HPACK_ENTRY("cookie",					""),
+	HPACK_ENTRY("date",						""),
+	HPACK_ENTRY("etag",						""),
+	HPACK_ENTRY("expect",					""),
+	HPACK_ENTRY("expires",					""),
+	HPACK_ENTRY("from",						""),
+	HPACK_ENTRY("host",						""),
+	HPACK_ENTRY("if-match",					""),
+	HPACK_ENTRY("if-modified-since",		""),
+	HPACK_ENTRY("if-none-match",			""),
+	HPACK_ENTRY("if-range",					""),
+	HPACK_ENTRY("if-unmodified-since",		""),
+	HPACK_ENTRY("last-modified",			""),
+	HPACK_ENTRY("link",						""),
+	HPACK_ENTRY("location",					""),
+	HPACK_ENTRY("max-forwards",				""),
+	HPACK_ENTRY("proxy-authenticate",		""),
+	HPACK_ENTRY("proxy-authorization",		""),
+	HPACK_ENTRY("range",					""),
+	HPACK_ENTRY("referer",					""),
+	HPACK_ENTRY("refresh",					""),
+	HPACK_ENTRY("retry-after",				""),
+	HPACK_ENTRY("server",					""),
+	HPACK_ENTRY("set-cookie",				""),
+	HPACK_ENTRY("strict-transport-security",	""),
+	HPACK_ENTRY("transfer-encoding",		""),
+	HPACK_ENTRY("user-agent",				""),
+	HPACK_ENTRY("vary",						""),
+	HPACK_ENTRY("via",						""),
+	HPACK_ENTRY("www-authenticate",			"")
+};
+
+BOOL CHpackTable::Get(UINT uiIndex, LPCSTR& lpszName, int& iNameLen, LPCSTR& lpszValue, int& iValueLen) const
+{
+	if(uiIndex == 0)
+		return FALSE;
+
+	if(uiIndex <= STATIC_COUNT)
+	{
+		const TStaticEntry& entry = s_staticTable[uiIndex - 1];
+
+		lpszName	= entry.name;
+		iNameLen	= entry.nameLen;
+		lpszValue	= entry.value;
+		iValueLen	= entry.valueLen;
+
+		return TRUE;
+	}
+
+	uiIndex -= STATIC_COUNT + 1;
+
+	if(uiIndex >= (UINT)m_entries.size())
+		return FALSE;
+
+	const TEntry& entry = m_entries[uiIndex];
+
+	lpszName	= entry.name.c_str();
+	iNameLen	= entry.name.GetLength();
+	lpszValue	= entry.value.c_str();
+	iValueLen	= entry.value.GetLength();
+
+	return TRUE;
+}
+
+UINT CHpackTable::Find(LPCSTR lpszName, int iNameLen, LPCSTR lpszValue, int iValueLen, BOOL& bExact) const
+{
+	UINT uiNameIndex = 0;
+
+	bExact = FALSE;
+
+	for(UINT i = 0; i < STATIC_COUNT; i++)
+	{
+		const TStaticEntry& entry = s_staticTable[i];
+
+		if(entry.nameLen != iNameLen || memcmp(entry.name, lpszName, iNameLen) != 0)
+			continue;
+
+		if(entry.valueLen == iValueLen && memcmp(entry.value, lpszValue, iValueLen) == 0)
+		{
+			bExact = TRUE;
+			return i + 1;
+		}
+
+		if(uiNameIndex == 0)
+			uiNameIndex = i + 1;
+	}
+
+	for(UINT i = 0; i < (UINT)m_entries.size(); i++)
+	{
+		const TEntry& entry = m_entries[i];
+
+		if(entry.name.GetLength() != iNameLen || memcmp(entry.name.c_str(), lpszName, iNameLen) != 0)
+			continue;
+
+		if(entry.value.GetLength() == iValueLen && memcmp(entry.value.c_str(), lpszValue, iValueLen) == 0)
+		{
+			bExact = TRUE;
+			return STATIC_COUNT + 1 + i;
+		}
+
+		if(uiNameIndex == 0)
+			uiNameIndex = STATIC_COUNT + 1 + i;
+	}
+
+	return uiNameIndex;
+}
+
+void CHpackTable::Add(LPCSTR lpszName, int iNameLen, LPCSTR lpszValue, int iValueLen)
+{
+	UINT uiSize = (UINT)(iNameLen + iValueLen + 32);
+
+	if(uiSize > m_uiMaxSize)
+	{
+		Clear();
+		return;
+	}
+
+	/* 名称和值可能引用即将被淘汰的字段，先复制再淘汰 */
+	TEntry entry;
+
+	entry.name.assign(lpszName, iNameLen);
+	entry.value.assign(lpszValue, iValueLen);
+
+	Evict(m_uiMaxSize - uiSize);
+
+	m_entries.emplace_front(move(entry));
+	m_uiSize += uiSize;
+}
+
+void CHpackTable::SetMaxSize(UINT uiMaxSize)
+{
+	m_uiMaxSize = uiMaxSize;
+	Evict(uiMaxSize);
+}
+
+void CHpackTable::Clear()
+{
+	m_entries.clear();
+	m_uiSize = 0;
+}
+
+void CHpackTable::Evict(UINT uiLimit)
+{
+	while(m_uiSize > uiLimit && !m_entries.empty())
+	{
+		const TEntry& entry = m_entries.back();
+
+		m_uiSize -= (UINT)(entry.name.GetLength() + entry.value.GetLength() + 32);
+		m_entries.pop_back();
+	}
+}
+
+// ------------------------------------------------------------------------------------------------------------- //
+
+EnHttp2ErrorCode CHpackDecoder::Decode(const BYTE* pData, int iLength, CHttp2FieldList& fields)
+{
+	const BYTE* p		= pData;
+	const BYTE* pEnd	= pData + iLength;
+	BOOL bFieldDecoded	= FALSE;
+
+	while(p < pEnd)
+	{
+		BYTE b = *p;
+
+		/* 索引字段 */
+		if(b & 0x80)
+		{
+			UINT uiIndex;
+			LPCSTR lpszName, lpszValue;
+			int iNameLen, iValueLen;
+
+			if(!DecodeInt(p, pEnd, 7, uiIndex) || !m_table.Get(uiIndex, lpszName, iNameLen, lpszValue, iValueLen))
+				return H2EC_COMPRESSION_ERROR;
+
+			/* 索引字段每字节可展开为一个动态表条目，必须在展开前累计检查头部列表大小 */
+			if(IsListSizeExceeded(fields, iNameLen, iValueLen))
+				return H2EC_ENHANCE_YOUR_CALM;
+
+			fields.Add(lpszName, iNameLen, lpszValue, iValueLen);
+			bFieldDecoded = TRUE;
+		}
+		/* 动态表大小更新：只能出现在头部块开头 */
+		else if((b & 0xE0) == 0x20)
+		{
+			UINT uiMaxSize;
+
+			if(bFieldDecoded || !DecodeInt(p, pEnd, 5, uiMaxSize) || uiMaxSize > m_uiMaxTableSize)
+				return H2EC_COMPRESSION_ERROR;
+
+			m_table.SetMaxSize(uiMaxSize);
+		}
+		/* 字面值字段：0x40 加入动态表，0x00 不索引，0x10 永不索引 */
+		else
+		{
+			BOOL bIndexing = ((b & 0xC0) == 0x40);
+			UINT uiIndex;
+
+			if(!DecodeInt(p, pEnd, bIndexing ? 6 : 4, uiIndex))
+				return H2EC_COMPRESSION_ERROR;
+
+			m_bufName.SetSize(0);
+			m_bufValue.SetSize(0);
+
+			if(uiIndex != 0)
+			{
+				LPCSTR lpszName, lpszValue;
+				int iNameLen, iValueLen;
+
+				if(!m_table.Get(uiIndex, lpszName, iNameLen, lpszValue, iValueLen))
+					return H2EC_COMPRESSION_ERROR;
+
+				m_bufName.Copy(lpszName, iNameLen);
+			}
+			else if(!DecodeString(p, pEnd, m_bufName))
+				return H2EC_COMPRESSION_ERROR;
+
+			if(!DecodeString(p, pEnd, m_bufValue))
+				return H2EC_COMPRESSION_ERROR;
+
+			LPCSTR lpszName		= H2_SAFE_STR(m_bufName.Ptr());
+			LPCSTR lpszValue	= H2_SAFE_STR(m_bufValue.Ptr());
+			int iNameLen		= (int)m_bufName.Size();
+			int iValueLen		= (int)m_bufValue.Size();
+
+			if(IsListSizeExceeded(fields, iNameLen, iValueLen))
+				return H2EC_ENHANCE_YOUR_CALM;
+
+			fields.Add(lpszName, iNameLen, lpszValue, iValueLen);
+
+			if(bIndexing)
+				m_table.Add(lpszName, iNameLen, lpszValue, iValueLen);
+
+			bFieldDecoded = TRUE;
+		}
+	}
+
+	return H2EC_NO_ERROR;
+}
+
+void CHpackDecoder::Reset()
+{
+	m_table.Clear();
+	m_table.SetMaxSize(HTTP2_DEFAULT_HEADER_TABLE_SIZE);
+
+	m_uiMaxTableSize = HTTP2_DEFAULT_HEADER_TABLE_SIZE;
+}
+
+BOOL CHpackDecoder::DecodeInt(const BYTE*& p, const BYTE* pEnd, int iPrefixBits, UINT& uiValue)
+{
+	if(p >= pEnd)
+		return FALSE;
+
+	UINT uiMask	= (1U << iPrefixBits) - 1;
+	uiValue		= *p++ & uiMask;
+
+	if(uiValue < uiMask)
+		return TRUE;
+
+	UINT64 ullValue = uiValue;
+
+	for(int iShift = 0; p < pEnd; iShift += 7)
+	{
+		BYTE b = *p++;
+
+		ullValue += (UINT64)(b & 0x7F) << iShift;
+
+		if(ullValue > HTTP2_MAX_WINDOW_SIZE)
+			return FALSE;
+
+		if((b & 0x80) == 0)
+		{
+			uiValue = (UINT)ullValue;
+			return TRUE;
+		}
+	}
+
+	return FALSE;
+}
+
+BOOL CHpackDecoder::DecodeString(const BYTE*& p, const BYTE* pEnd, CCharBufferPtr& buffer)
+{
+	if(p >= pEnd)
+		return FALSE;
+
+	BOOL bHuffman = (*p & 0x80);
+	UINT uiLength;
+
+	if(!DecodeInt(p, pEnd, 7, uiLength) || uiLength > (UINT)(pEnd - p))
+		return FALSE;
+
+	if(bHuffman)
+	{
+		if(!CHpackHuffman::Decode(p, (int)uiLength, buffer))
+			return FALSE;
+	}
+	else if(uiLength > 0)
+		buffer.Cat((LPCSTR)p, uiLength);
+
+	p += uiLength;
+
+	return TRUE;
+}
+
+// ------------------------------------------------------------------------------------------------------------- //
+
+void CHpackEncoder::Encode(const CHttp2FieldList& fields, CBufferPtr& buffer)
+{
+	if(m_bSizeUpdate)
+	{
+		if(m_uiMinTableSize < m_uiTableSize)
+		{
+			EncodeInt(m_uiMinTableSize, 5, 0x20, buffer);
+			m_table.SetMaxSize(m_uiMinTableSize);
+		}
+
+		EncodeInt(m_uiTableSize, 5, 0x20, buffer);
+		m_table.SetMaxSize(m_uiTableSize);
+
+		m_uiMinTableSize	= m_uiTableSize;
+		m_bSizeUpdate		= FALSE;
+	}
+
+	for(int i = 0; i < fields.Size(); i++)
+	{
+		int iNameLen	= fields.GetNameLen(i);
+		LPCSTR lpszName	= fields.GetName(i);
+		char* pszLower	= m_bufName.Realloc(iNameLen + 1);
+
+		for(int j = 0; j < iNameLen; j++)
+			pszLower[j] = (char)tolower((BYTE)lpszName[j]);
+
+		pszLower[iNameLen] = 0;
+
+		EncodeField(pszLower, iNameLen, fields.GetValue(i), fields.GetValueLen(i), buffer);
+	}
+}
+
+void CHpackEncoder::EncodeField(LPCSTR lpszName, int iNameLen, LPCSTR lpszValue, int iValueLen, CBufferPtr& buffer)
+{
+	/* 敏感字段：永不索引 */
+	static const LPCSTR s_lpszSensitive[]	= {"authorization", "proxy-authorization"};
+	/* 取值多变的字段：不索引，避免挤出动态表中的常用字段 */
+	static const LPCSTR s_lpszVolatile[]	= {":path", "content-length", "date", "etag", "last-modified", "if-modified-since", "if-none-match", "location"};
+
+	BOOL bNeverIndex	= (iNameLen == 6 && iValueLen < 20 && memcmp(lpszName, "cookie", 6) == 0);
+	BOOL bIndexing		= TRUE;
+
+	for(int i = 0; !bNeverIndex && i < (int)_countof(s_lpszSensitive); i++)
+		bNeverIndex = (strcmp(lpszName, s_lpszSensitive[i]) == 0);
+
+	BOOL bExact;
+	UINT uiIndex = m_table.Find(lpszName, iNameLen, lpszValue, iValueLen, bExact);
+
+	if(bExact && !bNeverIndex)
+	{
+		EncodeInt(uiIndex, 7, 0x80, buffer);
+		return;
+	}
+
+	if(bNeverIndex || (UINT)(iNameLen + iValueLen + 32) > m_table.GetMaxSize() / 2)
+		bIndexing = FALSE;
+
+	for(int i = 0; bIndexing && i < (int)_countof(s_lpszVolatile); i++)
+		bIndexing = (strcmp(lpszName, s_lpszVolatile[i]) != 0);
+
+	if(bIndexing)
+		EncodeInt(uiIndex, 6, 0x40, buffer);
+	else
+		EncodeInt(uiIndex, 4, bNeverIndex ? 0x10 : 0x00, buffer);
+
+	if(uiIndex == 0)
+		EncodeString(lpszName, iNameLen, buffer);
+
+	EncodeString(lpszValue, iValueLen, buffer);
+
+	if(bIndexing)
+		m_table.Add(lpszName, iNameLen, lpszValue, iValueLen);
+}
+
+void CHpackEncoder::SetMaxTableSize(UINT uiMaxSize)
+{
+	uiMaxSize = MIN(uiMaxSize, HTTP2_DEFAULT_HEADER_TABLE_SIZE);
+
+	if(uiMaxSize == m_uiTableSize)
+		return;
+
+	m_uiMinTableSize	= MIN(m_uiMinTableSize, uiMaxSize);
+	m_uiTableSize		= uiMaxSize;
+	m_bSizeUpdate		= TRUE;
+}
+
+void CHpackEncoder::Reset()
+{
+	m_table.Clear();
+	m_table.SetMaxSize(HTTP2_DEFAULT_HEADER_TABLE_SIZE);
+
+	m_uiTableSize		= HTTP2_DEFAULT_HEADER_TABLE_SIZE;
+	m_uiMinTableSize	= HTTP2_DEFAULT_HEADER_TABLE_SIZE;
+	m_bSizeUpdate		= FALSE;
+}
+
+void CHpackEncoder::EncodeInt(UINT uiValue, int iPrefixBits, BYTE bFlags, CBufferPtr& buffer)
+{
+	BYTE bytes[8];
+	int iCount	= 0;
+	UINT uiMask	= (1U << iPrefixBits) - 1;
+
+	if(uiValue < uiMask)
+		bytes[iCount++] = (BYTE)(bFlags | uiValue);
+	else
+	{
+		bytes[iCount++]	 = (BYTE)(bFlags | uiMask);
+		uiValue			-= uiMask;
+
+		while(uiValue >= 0x80)
+		{
+			bytes[iCount++]	  = (BYTE)((uiValue & 0x7F) | 0x80);
+			uiValue			>>= 7;
+		}
+
+		bytes[iCount++] = (BYTE)uiValue;
+	}
+
+	buffer.Cat(bytes, iCount);
+}
+
+void CHpackEncoder::EncodeString(LPCSTR lpszData, int iLength, CBufferPtr& buffer)
+{
+	int iHuffmanLen = CHpackHuffman::GetEncodedLength(lpszData, iLength);
+
+	if(iHuffmanLen < iLength)
+	{
+		EncodeInt((UINT)iHuffmanLen, 7, 0x80, buffer);
+		CHpackHuffman::Encode(lpszData, iLength, buffer);
+	}
+	else
+	{
+		EncodeInt((UINT)iLength, 7, 0x00, buffer);
+
+		if(iLength > 0)
+			buffer.Cat((const BYTE*)lpszData, iLength);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------------------- //
+
+static inline DWORD ReadUInt32(const BYTE* p)
+{
+	return ((DWORD)p[0] << 24) | ((DWORD)p[1] << 16) | ((DWORD)p[2] << 8) | (DWORD)p[3];
+}
+
+CHttp2Session::CHttp2Session()
+: m_pHandler(nullptr)
+{
+	Reset();
+}
+
+BOOL CHttp2Session::Start(BOOL bServer, DWORD dwMaxConcurrentStreams, IHttp2SessionHandler* pHandler)
+{
+	ASSERT(pHandler != nullptr);
+
+	Reset();
+
+	CCriSecLock locallock(m_cs);
+
+	m_pHandler					= pHandler;
+	m_bServer					= bServer;
+	m_dwMaxConcurrentStreams	= (dwMaxConcurrentStreams > 0) ? dwMaxConcurrentStreams : DEFAULT_HTTP2_MAX_CONCURRENT_STREAMS;
+	m_iPrefaceRemain			= bServer ? HTTP2_PREFACE_LEN : 0;
+	m_dwNextStreamID			= bServer ? 2 : 1;
+
+	if(!bServer)
+		m_bufSend.Cat((const BYTE*)HTTP2_PREFACE, HTTP2_PREFACE_LEN);
+
+	struct {WORD id; DWORD value;} settings[] =
+	{
+		{H2SS_MAX_CONCURRENT_STREAMS,	m_dwMaxConcurrentStreams},
+		{H2SS_INITIAL_WINDOW_SIZE,		HTTP2_LOCAL_STREAM_WINDOW_SIZE},
+		{H2SS_MAX_HEADER_LIST_SIZE,		HTTP2_MAX_HEADER_LIST_SIZE},
+		{H2SS_ENABLE_PUSH,				0},
+	};
+
+	int iCount = bServer ? 3 : 4;
+
+	WriteFrameHeader(iCount * 6, H2FT_SETTINGS, 0, 0);
+
+	for(int i = 0; i < iCount; i++)
+	{
+		BYTE bytes[2] = {(BYTE)(settings[i].id >> 8), (BYTE)settings[i].id};
+
+		m_bufSend.Cat(bytes, 2);
+		WriteUInt32(settings[i].value);
+	}
+
+	WriteFrameHeader(4, H2FT_WINDOW_UPDATE, 0, 0);
+	WriteUInt32(HTTP2_LOCAL_CONN_WINDOW_SIZE - HTTP2_DEFAULT_WINDOW_SIZE);
+
+	m_iRecvWindow = HTTP2_LOCAL_CONN_WINDOW_SIZE;
+
+	return Flush();
+}
+
+void CHttp2Session::Reset()
+{
+	CCriSecLock locallock(m_cs);
+
+	for(auto it = m_streams.begin(), end = m_streams.end(); it != end; ++it)
+		delete it->second;
+
+	m_streams.clear();
+	m_vtBlocked.clear();
+
+	m_encoder.Reset();
+	m_decoder.Reset();
+	m_fields.Clear();
+
+	m_bufRecv.Free();
+	m_bufBlock.Free();
+	m_bufSend.Free();
+	m_bufHeaders.Free();
+
+	m_pHandler					= nullptr;
+	m_bServer					= FALSE;
+	m_bError					= FALSE;
+	m_dwErrorCode				= H2EC_NO_ERROR;
+	m_lpszErrorDesc				= "";
+	m_iPrefaceRemain			= 0;
+	m_bSettingsReceived			= FALSE;
+	m_dwBlockStreamID			= 0;
+	m_bBlockEndStream			= FALSE;
+	m_bContinuation				= FALSE;
+	m_dwFloodTime				= ::TimeGetTime();
+	m_iPingFrames				= 0;
+	m_iSettingsFrames			= 0;
+	m_iEmptyDataFrames			= 0;
+	m_iRstFrames				= 0;
+	m_dwMaxConcurrentStreams	= DEFAULT_HTTP2_MAX_CONCURRENT_STREAMS;
+	m_dwPeerMaxStreams			= HTTP2_MAX_STREAM_ID;
+	m_iPeerMaxFrameSize			= HTTP2_MIN_FRAME_SIZE;
+	m_iPeerInitialWindow		= HTTP2_DEFAULT_WINDOW_SIZE;
+	m_iLocalStreams				= 0;
+	m_iPeerStreams				= 0;
+	m_dwNextStreamID			= 1;
+	m_dwLastPeerStreamID		= 0;
+	m_bGoAwaySent				= FALSE;
+	m_bGoAwayReceived			= FALSE;
+	m_iSendWindow				= HTTP2_DEFAULT_WINDOW_SIZE;
+	m_iRecvWindow				= HTTP2_DEFAULT_WINDOW_SIZE;
+	m_iRecvConsumed				= 0;
+}
+
+BOOL CHttp2Session::Receive(const BYTE* pData, int iLength)
+{
+	if(m_pHandler == nullptr || m_bError)
+	{
+		::SetLastError(ERROR_INVALID_STATE);
+		return FALSE;
+	}
+
+	if(m_iPrefaceRemain > 0)
+	{
+		int iCompare = MIN(iLength, m_iPrefaceRemain);
+
+		if(memcmp(pData, HTTP2_PREFACE + (HTTP2_PREFACE_LEN - m_iPrefaceRemain), iCompare) != 0)
+		{
+			CCriSecLock locallock(m_cs);
+			return ConnectionError(H2EC_PROTOCOL_ERROR, "invalid connection preface");
+		}
+
+		m_iPrefaceRemain	-= iCompare;
+		pData				+= iCompare;
+		iLength				-= iCompare;
+	}
+
+	BOOL bBuffered = (m_bufRecv.Size() > 0);
+
+	if(bBuffered)
+	{
+		m_bufRecv.Cat(pData, iLength);
+
+		pData	= m_bufRecv.Ptr();
+		iLength	= (int)m_bufRecv.Size();
+	}
+
+	while(iLength >= HTTP2_FRAME_HEADER_SIZE)
+	{
+		int iFrameLen = (pData[0] << 16) | (pData[1] << 8) | pData[2];
+
+		/* 本端使用默认的 SETTINGS_MAX_FRAME_SIZE */
+		if(iFrameLen > HTTP2_MIN_FRAME_SIZE)
+		{
+			CCriSecLock locallock(m_cs);
+			return ConnectionError(H2EC_FRAME_SIZE_ERROR, "frame too large");
+		}
+
+		if(iLength < HTTP2_FRAME_HEADER_SIZE + iFrameLen)
+			break;
+
+		if(!ProcessFrame(pData[3], pData[4], ReadUInt32(pData + 5) & HTTP2_MAX_STREAM_ID, pData + HTTP2_FRAME_HEADER_SIZE, iFrameLen))
+			return FALSE;
+
+		pData	+= HTTP2_FRAME_HEADER_SIZE + iFrameLen;
+		iLength	-= HTTP2_FRAME_HEADER_SIZE + iFrameLen;
+	}
+
+	if(bBuffered)
+	{
+		if(iLength > 0)
+			memmove(m_bufRecv.Ptr(), pData, iLength);
+
+		m_bufRecv.SetSize(iLength);
+	}
+	else if(iLength > 0)
+		m_bufRecv.Copy(pData, iLength);
+
+	/* 发送本次处理中积压的控制帧应答 */
+	CCriSecLock locallock(m_cs);
+
+	return Flush();
+}
+
+BOOL CHttp2Session::ProcessFrame(BYTE bType, BYTE bFlags, DWORD dwStreamID, const BYTE* pPayload, int iLength)
+{
+	if(!m_bSettingsReceived)
+	{
+		if(bType != H2FT_SETTINGS || (bFlags & H2FF_ACK))
+		{
+			CCriSecLock locallock(m_cs);
+			return ConnectionError(H2EC_PROTOCOL_ERROR, "first frame is not SETTINGS");
+		}
+
+		m_bSettingsReceived = TRUE;
+	}
+
+	if(m_bContinuation && (bType != H2FT_CONTINUATION || dwStreamID != m_dwBlockStreamID))
+	{
+		CCriSecLock locallock(m_cs);
+		return ConnectionError(H2EC_PROTOCOL_ERROR, "CONTINUATION expected");
+	}
+
+	switch(bType)
+	{
+	case H2FT_DATA:				return OnDataFrame(bFlags, dwStreamID, pPayload, iLength);
+	case H2FT_HEADERS:			return OnHeadersFrame(bFlags, dwStreamID, pPayload, iLength);
+	case H2FT_CONTINUATION:		return OnContinuationFrame(bFlags, dwStreamID, pPayload, iLength);
+	case H2FT_RST_STREAM:		return OnRstStreamFrame(dwStreamID, pPayload, iLength);
+	case H2FT_SETTINGS:			return OnSettingsFrame(bFlags, dwStreamID, pPayload, iLength);
+	case H2FT_PING:				return OnPingFrame(bFlags, dwStreamID, pPayload, iLength);
+	case H2FT_GOAWAY:			return OnGoAwayFrame(dwStreamID, pPayload, iLength);
+	case H2FT_WINDOW_UPDATE:	return OnWindowUpdateFrame(dwStreamID, pPayload, iLength);
+	case H2FT_PRIORITY:
+		{
+			CCriSecLock locallock(m_cs);
+
+			if(dwStreamID == 0)
+				return ConnectionError(H2EC_PROTOCOL_ERROR, "PRIORITY on stream 0");
+			if(iLength != 5)
+				return ConnectionError(H2EC_FRAME_SIZE_ERROR, "invalid PRIORITY frame");
+
+			return TRUE;
+		}
+	case H2FT_PUSH_PROMISE:
+		{
+			CCriSecLock locallock(m_cs);
+			return ConnectionError(H2EC_PROTOCOL_ERROR, "push is disabled");
+		}
+	default:
+		/* 忽略未知类型的帧 */
+		return TRUE;
+	}
+}
+
+BOOL CHttp2Session::OnDataFrame(BYTE bFlags, DWORD dwStreamID, const BYTE* pPayload, int iLength)
+{
+	const BYTE* pData	= pPayload;
+	int iDataLen		= iLength;
+	BOOL bEndStream		= (bFlags & H2FF_END_STREAM);
+	BOOL bDeliver		= FALSE;
+	DWORD dwResetCode	= H2EC_NO_ERROR;
+
+	{
+		CCriSecLock locallock(m_cs);
+
+		if(dwStreamID == 0)
+			return ConnectionError(H2EC_PROTOCOL_ERROR, "DATA on stream 0");
+
+		if(bFlags & H2FF_PADDED)
+		{
+			if(iLength < 1 || pPayload[0] >= iLength)
+				return ConnectionError(H2EC_PROTOCOL_ERROR, "invalid DATA padding");
+
+			pData		= pPayload + 1;
+			iDataLen	= iLength - 1 - pPayload[0];
+		}
+
+		if(iDataLen == 0 && !bEndStream && !CheckFlood(m_iEmptyDataFrames, HTTP2_MAX_EMPTY_DATA_FRAMES, "empty DATA flood"))
+			return FALSE;
+
+		if(iLength > m_iRecvWindow)
+			return ConnectionError(H2EC_FLOW_CONTROL_ERROR, "connection flow control window exceeded");
+
+		m_iRecvWindow -= iLength;
+
+		TStream* pStream = FindStream(dwStreamID);
+
+		if(pStream == nullptr)
+		{
+			if(IsIdleStream(dwStreamID))
+				return ConnectionError(H2EC_PROTOCOL_ERROR, "DATA on idle stream");
+
+			/* 已重置的流上仍在途中的数据 */
+			ConsumeRecvWindow(nullptr, iLength);
+		}
+		else if(pStream->remoteClosed || !pStream->headersDone || iLength > pStream->recvWindow)
+		{
+			DWORD dwErrorCode = pStream->remoteClosed ? H2EC_STREAM_CLOSED : (pStream->headersDone ? H2EC_FLOW_CONTROL_ERROR : H2EC_PROTOCOL_ERROR);
+
+			/* 通知应用本端创建的流被重置 */
+			if(pStream->local && !pStream->remoteClosed)
+				dwResetCode = dwErrorCode;
+
+			StreamError(dwStreamID, dwErrorCode);
+			ConsumeRecvWindow(nullptr, iLength);
+		}
+		else
+		{
+			pStream->recvWindow -= iLength;
+			bDeliver = !pStream->discard;
+
+			if(!bDeliver)
+				ConsumeRecvWindow(bEndStream ? nullptr : pStream, iLength);
+
+			if(bEndStream)
+				SetRemoteClosed(pStream);
+		}
+
+		if(!Flush())
+			return FALSE;
+	}
+
+	if(dwResetCode != H2EC_NO_ERROR)
+		m_pHandler->OnHttp2StreamReset(dwStreamID, dwResetCode);
+
+	if(!bDeliver)
+		return TRUE;
+
+	if(m_pHandler->OnHttp2Data(dwStreamID, pData, iDataLen, bEndStream) == HPR_ERROR)
+	{
+		CCriSecLock locallock(m_cs);
+		return ConnectionError(H2EC_INTERNAL_ERROR, "DATA rejected by application");
+	}
+
+	CCriSecLock locallock(m_cs);
+
+	ConsumeRecvWindow(bEndStream ? nullptr : FindStream(dwStreamID), iLength);
+
+	return Flush();
+}
+
+BOOL CHttp2Session::OnHeadersFrame(BYTE bFlags, DWORD dwStreamID, const BYTE* pPayload, int iLength)
+{
+	const BYTE* pBlock	= pPayload;
+	int iBlockLen		= iLength;
+	int iPadding		= 0;
+
+	if(bFlags & H2FF_PADDED)
+	{
+		if(iBlockLen < 1)
+		{
+			CCriSecLock locallock(m_cs);
+			return ConnectionError(H2EC_FRAME_SIZE_ERROR, "invalid HEADERS frame");
+		}
+
+		iPadding = pBlock[0];
+
+		pBlock		+= 1;
+		iBlockLen	-= 1;
+	}
+
+	/* 忽略优先级信息 */
+	if(bFlags & H2FF_PRIORITY)
+	{
+		if(iBlockLen < 5)
+		{
+			CCriSecLock locallock(m_cs);
+			return ConnectionError(H2EC_FRAME_SIZE_ERROR, "invalid HEADERS frame");
+		}
+
+		pBlock		+= 5;
+		iBlockLen	-= 5;
+	}
+
+	if(dwStreamID == 0 || iPadding > iBlockLen)
+	{
+		CCriSecLock locallock(m_cs);
+		return ConnectionError(H2EC_PROTOCOL_ERROR, "invalid HEADERS frame");
+	}
+
+	m_bufBlock.SetSize(0);
+
+	if(iBlockLen - iPadding > 0)
+		m_bufBlock.Cat(pBlock, iBlockLen - iPadding);
+
+	m_dwBlockStreamID	= dwStreamID;
+	m_bBlockEndStream	= (bFlags & H2FF_END_STREAM);
+
+	if(!(bFlags & H2FF_END_HEADERS))
+	{
+		m_bContinuation = TRUE;
+		return TRUE;
+	}
+
+	return ProcessHeaderBlock();
+}
+
+BOOL CHttp2Session::OnContinuationFrame(BYTE bFlags, DWORD dwStreamID, const BYTE* pPayload, int iLength)
+{
+	if(!m_bContinuation)
+	{
+		CCriSecLock locallock(m_cs);
+		return ConnectionError(H2EC_PROTOCOL_ERROR, "unexpected CONTINUATION");
+	}
+
+	if(m_bufBlock.Size() + iLength > HTTP2_MAX_HEADER_BLOCK_SIZE)
+	{
+		CCriSecLock locallock(m_cs);
+		return ConnectionError(H2EC_ENHANCE_YOUR_CALM, "header block too large");
+	}
+
+	if(iLength > 0)
+		m_bufBlock.Cat(pPayload, iLength);
+
+	if(!(bFlags & H2FF_END_HEADERS))
+		return TRUE;
+
+	m_bContinuation = FALSE;
+
+	return ProcessHeaderBlock();
+}
+
+BOOL CHttp2Session::ProcessHeaderBlock()
+{
+	DWORD dwStreamID	= m_dwBlockStreamID;
+	BOOL bEndStream		= m_bBlockEndStream;
+	BOOL bTrailer		= FALSE;
+	LPCSTR lpszMethod	= nullptr;
+	LPCSTR lpszPath		= nullptr;
+
+	m_fields.Clear();
+
+	/* 无论流状态如何都必须解码头部块，保证动态表与对端一致；
+	   头部列表超限时动态表已无法与对端保持一致，所有头部块（包括尾部头部）均按连接错误处理 */
+	EnHttp2ErrorCode enCode = m_decoder.Decode(m_bufBlock.Ptr(), (int)m_bufBlock.Size(), m_fields);
+
+	if(enCode != H2EC_NO_ERROR)
+	{
+		CCriSecLock locallock(m_cs);
+		return ConnectionError(enCode, enCode == H2EC_ENHANCE_YOUR_CALM ? "header list too large" : "header block decoding failed");
+	}
+
+	{
+		CCriSecLock locallock(m_cs);
+
+		TStream* pStream = FindStream(dwStreamID);
+
+		if(pStream == nullptr)
+		{
+			BOOL bPeerStream = ((dwStreamID & 1) == 1) == m_bServer;
+
+			if(!bPeerStream)
+			{
+				/* 本端已关闭的流 */
+				if(!IsIdleStream(dwStreamID))
+					return Flush();
+
+				return ConnectionError(H2EC_PROTOCOL_ERROR, "HEADERS on idle stream");
+			}
+
+			/* 客户端不接受服务端创建的流（推送被禁用） */
+			if(!m_bServer)
+				return ConnectionError(H2EC_PROTOCOL_ERROR, "unexpected server stream");
+
+			if(!IsIdleStream(dwStreamID))
+				return Flush();
+
+			m_dwLastPeerStreamID = dwStreamID;
+
+			if(m_bGoAwaySent)
+				return Flush();
+
+			if(m_iPeerStreams >= (int)m_dwMaxConcurrentStreams)
+			{
+				StreamError(dwStreamID, H2EC_REFUSED_STREAM);
+				return Flush();
+			}
+
+			pStream = CreateStream(dwStreamID, FALSE);
+		}
+		else if(pStream->remoteClosed)
+		{
+			StreamError(dwStreamID, H2EC_STREAM_CLOSED);
+			return Flush();
+		}
+		else if(pStream->headersDone)
+		{
+			if(!bEndStream)
+			{
+				StreamError(dwStreamID, H2EC_PROTOCOL_ERROR);
+				return Flush();
+			}
+
+			/* 已跳过请求体 / 响应体的流同时丢弃尾部头部 */
+			if(pStream->discard)
+			{
+				SetRemoteClosed(pStream);
+				return Flush();
+			}
+
+			bTrailer = TRUE;
+		}
+		else if(!m_bServer)
+		{
+			/* 忽略临时响应（1xx） */
+			int iStatus = m_fields.Find(HTTP2_HEADER_STATUS);
+
+			if(iStatus >= 0 && m_fields.GetValue(iStatus)[0] == '1')
+			{
+				if(bEndStream)
+					StreamError(dwStreamID, H2EC_PROTOCOL_ERROR);
+
+				return Flush();
+			}
+		}
+
+		pStream->headersDone = TRUE;
+
+		/* 保存流的头部字段供事件回调之外按流访问（流随即关闭时不必保存） */
+		if(!bTrailer && (!bEndStream || !pStream->localClosed))
+			pStream->fields.Copy(m_fields);
+
+		if(pStream->local)
+		{
+			m_strMethod	= pStream->method;
+			m_strPath	= pStream->path;
+
+			lpszMethod	= m_strMethod.c_str();
+			lpszPath	= m_strPath.c_str();
+		}
+
+		if(bEndStream)
+			SetRemoteClosed(pStream);
+	}
+
+	EnHttpParseResult rs = m_pHandler->OnHttp2Headers(dwStreamID, m_fields, lpszMethod, lpszPath, bEndStream, bTrailer);
+
+	CCriSecLock locallock(m_cs);
+
+	if(rs == HPR_ERROR)
+		return ConnectionError(H2EC_INTERNAL_ERROR, "HEADERS rejected by application");
+
+	if(rs == HPR_SKIP_BODY && !bEndStream)
+	{
+		TStream* pStream = FindStream(dwStreamID);
+
+		if(pStream != nullptr)
+			pStream->discard = TRUE;
+	}
+
+	return TRUE;
+}
+
+BOOL CHttp2Session::OnRstStreamFrame(DWORD dwStreamID, const BYTE* pPayload, int iLength)
+{
+	DWORD dwErrorCode;
+
+	{
+		CCriSecLock locallock(m_cs);
+
+		if(dwStreamID == 0)
+			return ConnectionError(H2EC_PROTOCOL_ERROR, "RST_STREAM on stream 0");
+		if(iLength != 4)
+			return ConnectionError(H2EC_FRAME_SIZE_ERROR, "invalid RST_STREAM frame");
+		if(IsIdleStream(dwStreamID))
+			return ConnectionError(H2EC_PROTOCOL_ERROR, "RST_STREAM on idle stream");
+		if(!CheckFlood(m_iRstFrames, HTTP2_MAX_RST_STREAM_FRAMES, "RST_STREAM flood"))
+			return FALSE;
+
+		TStream* pStream = FindStream(dwStreamID);
+
+		if(pStream == nullptr)
+			return TRUE;
+
+		dwErrorCode = ReadUInt32(pPayload);
+
+		CloseStream(pStream);
+	}
+
+	m_pHandler->OnHttp2StreamReset(dwStreamID, dwErrorCode);
+
+	return TRUE;
+}
+
+BOOL CHttp2Session::OnSettingsFrame(BYTE bFlags, DWORD dwStreamID, const BYTE* pPayload, int iLength)
+{
+	CCriSecLock locallock(m_cs);
+
+	if(dwStreamID != 0)
+		return ConnectionError(H2EC_PROTOCOL_ERROR, "SETTINGS on stream");
+
+	if(bFlags & H2FF_ACK)
+	{
+		if(iLength != 0)
+			return ConnectionError(H2EC_FRAME_SIZE_ERROR, "invalid SETTINGS ACK");
+
+		return TRUE;
+	}
+
+	if(iLength % 6 != 0)
+		return ConnectionError(H2EC_FRAME_SIZE_ERROR, "invalid SETTINGS frame");
+	if(!CheckFlood(m_iSettingsFrames, HTTP2_MAX_SETTINGS_FRAMES, "SETTINGS flood"))
+		return FALSE;
+
+	for(const BYTE* p = pPayload, *pEnd = pPayload + iLength; p < pEnd; p += 6)
+	{
+		WORD wID		= (WORD)((p[0] << 8) | p[1]);
+		DWORD dwValue	= ReadUInt32(p + 2);
+
+		switch(wID)
+		{
+		case H2SS_HEADER_TABLE_SIZE:
+			m_encoder.SetMaxTableSize(dwValue);
+			break;
+		case H2SS_ENABLE_PUSH:
+			if(dwValue > 1)
+				return ConnectionError(H2EC_PROTOCOL_ERROR, "invalid SETTINGS_ENABLE_PUSH");
+			break;
+		case H2SS_MAX_CONCURRENT_STREAMS:
+			m_dwPeerMaxStreams = dwValue;
+			break;
+		case H2SS_INITIAL_WINDOW_SIZE:
+			{
+				if(dwValue > HTTP2_MAX_WINDOW_SIZE)
+					return ConnectionError(H2EC_FLOW_CONTROL_ERROR, "invalid SETTINGS_INITIAL_WINDOW_SIZE");
+
+				int iDelta = (int)dwValue - m_iPeerInitialWindow;
+
+				for(auto it = m_streams.begin(), end = m_streams.end(); it != end; ++it)
+				{
+					TStream* pStream = it->second;
+
+					if((INT64)pStream->sendWindow + iDelta > HTTP2_MAX_WINDOW_SIZE)
+						return ConnectionError(H2EC_FLOW_CONTROL_ERROR, "stream flow control window overflow");
+
+					pStream->sendWindow += iDelta;
+				}
+
+				m_iPeerInitialWindow = (int)dwValue;
+			}
+			break;
+		case H2SS_MAX_FRAME_SIZE:
+			if(dwValue < HTTP2_MIN_FRAME_SIZE || dwValue > HTTP2_MAX_FRAME_SIZE)
+				return ConnectionError(H2EC_PROTOCOL_ERROR, "invalid SETTINGS_MAX_FRAME_SIZE");
+
+			m_iPeerMaxFrameSize = (int)dwValue;
+			break;
+		default:
+			break;
+		}
+	}
+
+	WriteFrameHeader(0, H2FT_SETTINGS, H2FF_ACK, 0);
+	FlushAllPending();
+
+	return Flush();
+}
+
+BOOL CHttp2Session::OnPingFrame(BYTE bFlags, DWORD dwStreamID, const BYTE* pPayload, int iLength)
+{
+	CCriSecLock locallock(m_cs);
+
+	if(dwStreamID != 0)
+		return ConnectionError(H2EC_PROTOCOL_ERROR, "PING on stream");
+	if(iLength != 8)
+		return ConnectionError(H2EC_FRAME_SIZE_ERROR, "invalid PING frame");
+
+	if(bFlags & H2FF_ACK)
+		return TRUE;
+	if(!CheckFlood(m_iPingFrames, HTTP2_MAX_PING_FRAMES, "PING flood"))
+		return FALSE;
+
+	/* 应答在本次 Receive() 结束时合并发送 */
+	WriteFrameHeader(8, H2FT_PING, H2FF_ACK, 0);
+	m_bufSend.Cat(pPayload, 8);
+
+	if(m_bufSend.Size() > HTTP2_MAX_CONTROL_QUEUE_SIZE)
+	{
+		m_bufSend.SetSize(0);
+		return ConnectionError(H2EC_ENHANCE_YOUR_CALM, "control frame flood");
+	}
+
+	return TRUE;
+}
+
+BOOL CHttp2Session::OnGoAwayFrame(DWORD dwStreamID, const BYTE* pPayload, int iLength)
+{
+	vector<DWORD> vtRefused;
+
+	{
+		CCriSecLock locallock(m_cs);
+
+		if(dwStreamID != 0)
+			return ConnectionError(H2EC_PROTOCOL_ERROR, "GOAWAY on stream");
+		if(iLength < 8)
+			return ConnectionError(H2EC_FRAME_SIZE_ERROR, "invalid GOAWAY frame");
+
+		DWORD dwLastStreamID = ReadUInt32(pPayload) & HTTP2_MAX_STREAM_ID;
+
+		m_bGoAwayReceived = TRUE;
+
+		/* 本端创建的、ID 大于 dwLastStreamID 的流不会被对端处理 */
+		for(auto it = m_streams.begin(), end = m_streams.end(); it != end; ++it)
+		{
+			if(it->second->local && it->first > dwLastStreamID)
+				vtRefused.push_back(it->first);
+		}
+
+		for(size_t i = 0; i < vtRefused.size(); i++)
+			CloseStream(FindStream(vtRefused[i]));
+	}
+
+	for(size_t i = 0; i < vtRefused.size(); i++)
+		m_pHandler->OnHttp2StreamReset(vtRefused[i], H2EC_REFUSED_STREAM);
+
+	return TRUE;
+}
+
+BOOL CHttp2Session::OnWindowUpdateFrame(DWORD dwStreamID, const BYTE* pPayload, int iLength)
+{
+	CCriSecLock locallock(m_cs);
+
+	if(iLength != 4)
+		return ConnectionError(H2EC_FRAME_SIZE_ERROR, "invalid WINDOW_UPDATE frame");
+
+	int iIncrement = (int)(ReadUInt32(pPayload) & HTTP2_MAX_WINDOW_SIZE);
+
+	if(dwStreamID == 0)
+	{
+		if(iIncrement == 0)
+			return ConnectionError(H2EC_PROTOCOL_ERROR, "invalid WINDOW_UPDATE increment");
+		if((INT64)m_iSendWindow + iIncrement > HTTP2_MAX_WINDOW_SIZE)
+			return ConnectionError(H2EC_FLOW_CONTROL_ERROR, "connection flow control window overflow");
+
+		m_iSendWindow += iIncrement;
+	}
+	else
+	{
+		if(IsIdleStream(dwStreamID))
+			return ConnectionError(H2EC_PROTOCOL_ERROR, "WINDOW_UPDATE on idle stream");
+
+		TStream* pStream = FindStream(dwStreamID);
+
+		if(pStream == nullptr)
+			return TRUE;
+
+		if(iIncrement == 0)
+			StreamError(dwStreamID, H2EC_PROTOCOL_ERROR);
+		else if((INT64)pStream->sendWindow + iIncrement > HTTP2_MAX_WINDOW_SIZE)
+			StreamError(dwStreamID, H2EC_FLOW_CONTROL_ERROR);
+		else
+			pStream->sendWindow += iIncrement;
+	}
+
+	FlushAllPending();
+
+	return Flush();
+}
+
+DWORD CHttp2Session::OpenStream(const CHttp2FieldList& fields, BOOL bEndStream)
+{
+	CCriSecLock locallock(m_cs);
+
+	if(m_pHandler == nullptr || m_bServer)
+	{
+		::SetLastError(ERROR_INVALID_OPERATION);
+		return 0;
+	}
+
+	if(m_bError || m_bGoAwaySent || m_bGoAwayReceived || m_dwNextStreamID > HTTP2_MAX_STREAM_ID)
+	{
+		::SetLastError(ERROR_INVALID_STATE);
+		return 0;
+	}
+
+	if(m_iLocalStreams >= (int)m_dwPeerMaxStreams)
+	{
+		::SetLastError(ERROR_CONNECTION_COUNT_LIMIT);
+		return 0;
+	}
+
+	DWORD dwStreamID	= m_dwNextStreamID;
+	m_dwNextStreamID	+= 2;
+	TStream* pStream	= CreateStream(dwStreamID, TRUE);
+
+	int iMethod	= fields.Find(HTTP2_HEADER_METHOD);
+	int iPath	= fields.Find(HTTP2_HEADER_PATH);
+
+	if(iMethod >= 0)	pStream->method	= fields.GetValue(iMethod);
+	if(iPath >= 0)		pStream->path	= fields.GetValue(iPath);
+
+	WriteHeaders(dwStreamID, fields, bEndStream);
+
+	if(bEndStream)
+		SetLocalClosed(pStream);
+
+	return Flush() ? dwStreamID : 0;
+}
+
+BOOL CHttp2Session::SendHeaders(DWORD dwStreamID, const CHttp2FieldList& fields, BOOL bEndStream)
+{
+	CCriSecLock locallock(m_cs);
+
+	TStream* pStream = FindStream(dwStreamID);
+
+	if(pStream == nullptr)
+	{
+		::SetLastError(ERROR_OBJECT_NOT_FOUND);
+		return FALSE;
+	}
+
+	/* 有未发送的缓存数据时不能发送尾部头部 */
+	if(pStream->localClosed || pStream->endQueued || pStream->pending.Size() > 0)
+	{
+		::SetLastError(ERROR_INVALID_STATE);
+		return FALSE;
+	}
+
+	WriteHeaders(dwStreamID, fields, bEndStream);
+
+	if(bEndStream)
+		SetLocalClosed(pStream);
+
+	return Flush();
+}
+
+BOOL CHttp2Session::SendData(DWORD dwStreamID, const BYTE* pData, int iLength, BOOL bEndStream)
+{
+	CCriSecLock locallock(m_cs);
+
+	TStream* pStream = FindStream(dwStreamID);
+
+	if(pStream == nullptr)
+	{
+		::SetLastError(ERROR_OBJECT_NOT_FOUND);
+		return FALSE;
+	}
+
+	if(pStream->localClosed || pStream->endQueued)
+	{
+		::SetLastError(ERROR_INVALID_STATE);
+		return FALSE;
+	}
+
+	if(pStream->pending.Size() > 0)
+	{
+		if(iLength > 0)
+			pStream->pending.Cat(pData, iLength);
+
+		pStream->endQueued = bEndStream;
+
+		return TRUE;
+	}
+
+	int iSent = WriteData(pStream, pData, iLength, bEndStream);
+
+	if(iSent < iLength)
+	{
+		pStream->pending.Copy(pData + iSent, iLength - iSent);
+		pStream->endQueued = bEndStream;
+
+		m_vtBlocked.push_back(dwStreamID);
+	}
+	else if(bEndStream)
+		SetLocalClosed(pStream);
+
+	return Flush();
+}
+
+BOOL CHttp2Session::ResetStream(DWORD dwStreamID, DWORD dwErrorCode)
+{
+	CCriSecLock locallock(m_cs);
+
+	if(FindStream(dwStreamID) == nullptr)
+	{
+		::SetLastError(ERROR_OBJECT_NOT_FOUND);
+		return FALSE;
+	}
+
+	StreamError(dwStreamID, dwErrorCode);
+
+	return Flush();
+}
+
+BOOL CHttp2Session::GoAway(DWORD dwErrorCode)
+{
+	CCriSecLock locallock(m_cs);
+
+	if(m_pHandler == nullptr)
+	{
+		::SetLastError(ERROR_INVALID_STATE);
+		return FALSE;
+	}
+
+	if(m_bGoAwaySent)
+		return TRUE;
+
+	WriteFrameHeader(8, H2FT_GOAWAY, 0, 0);
+	WriteUInt32(m_dwLastPeerStreamID);
+	WriteUInt32(dwErrorCode);
+
+	m_bGoAwaySent = TRUE;
+
+	return Flush();
+}
+
+BOOL CHttp2Session::IsStreamWritable(DWORD dwStreamID)
+{
+	CCriSecLock locallock(m_cs);
+
+	TStream* pStream = FindStream(dwStreamID);
+
+	return pStream != nullptr && !pStream->localClosed && !pStream->endQueued;
+}
+
+int CHttp2Session::GetStreamCount()
+{
+	CCriSecLock locallock(m_cs);
+
+	return (int)m_streams.size();
+}
+
+BOOL CHttp2Session::GetStreamField(DWORD dwStreamID, LPCSTR lpszName, LPSTR lpszValue, int& iValueLen)
+{
+	ASSERT(lpszName != nullptr && iValueLen >= 0);
+
+	CCriSecLock locallock(m_cs);
+
+	TStream* pStream = FindStream(dwStreamID);
+
+	if(pStream == nullptr || !pStream->headersDone)
+	{
+		::SetLastError(ERROR_OBJECT_NOT_FOUND);
+		return FALSE;
+	}
+
+	const CHttp2FieldList& fields = pStream->fields;
+	int i = fields.FindNoCase(lpszName);
+
+	if(i < 0 && strcasecmp(lpszName, "host") == 0)
+		i = fields.Find(HTTP2_HEADER_AUTHORITY);
+
+	if(i < 0)
+	{
+		::SetLastError(ERROR_OBJECT_NOT_FOUND);
+		return FALSE;
+	}
+
+	int iLength = fields.GetValueLen(i) + 1;
+
+	if(lpszValue == nullptr || iValueLen < iLength)
+	{
+		iValueLen = iLength;
+		::SetLastError(ERROR_BUFFER_OVERFLOW);
+
+		return FALSE;
+	}
+
+	memcpy(lpszValue, fields.GetValue(i), iLength);
+	iValueLen = iLength;
+
+	return TRUE;
+}
+
+BOOL CHttp2Session::CheckFlood(int& iFrames, int iMaxFrames, LPCSTR lpszDesc)
+{
+	DWORD dwNow = ::TimeGetTime();
+
+	if(dwNow - m_dwFloodTime >= HTTP2_FLOOD_CHECK_INTERVAL)
+	{
+		m_dwFloodTime		= dwNow;
+		m_iPingFrames		= 0;
+		m_iSettingsFrames	= 0;
+		m_iEmptyDataFrames	= 0;
+		m_iRstFrames		= 0;
+	}
+
+	if(++iFrames <= iMaxFrames)
+		return TRUE;
+
+	/* 丢弃积压的控制帧应答，直接发送 GOAWAY */
+	m_bufSend.SetSize(0);
+
+	return ConnectionError(H2EC_ENHANCE_YOUR_CALM, lpszDesc);
+}
+
+BOOL CHttp2Session::ConnectionError(DWORD dwErrorCode, LPCSTR lpszDesc)
+{
+	m_bError		= TRUE;
+	m_dwErrorCode	= dwErrorCode;
+	m_lpszErrorDesc	= lpszDesc;
+
+	if(!m_bGoAwaySent)
+	{
+		int iDescLen = (int)strlen(lpszDesc);
+
+		WriteFrameHeader(8 + iDescLen, H2FT_GOAWAY, 0, 0);
+		WriteUInt32(m_dwLastPeerStreamID);
+		WriteUInt32(dwErrorCode);
+		m_bufSend.Cat((const BYTE*)lpszDesc, iDescLen);
+
+		m_bGoAwaySent = TRUE;
+
+		Flush();
+	}
+
+	::SetLastError(ERROR_INVALID_DATA);
+
+	return FALSE;
+}
+
+void CHttp2Session::StreamError(DWORD dwStreamID, DWORD dwErrorCode)
+{
+	WriteFrameHeader(4, H2FT_RST_STREAM, 0, dwStreamID);
+	WriteUInt32(dwErrorCode);
+
+	TStream* pStream = FindStream(dwStreamID);
+
+	if(pStream != nullptr)
+		CloseStream(pStream);
+}
+
+BOOL CHttp2Session::IsIdleStream(DWORD dwStreamID) const
+{
+	BOOL bPeerStream = ((dwStreamID & 1) == 1) == m_bServer;
+
+	return bPeerStream ? (dwStreamID > m_dwLastPeerStreamID) : (dwStreamID >= m_dwNextStreamID);
+}
+
+CHttp2Session::TStream* CHttp2Session::FindStream(DWORD dwStreamID)
+{
+	auto it = m_streams.find(dwStreamID);
+
+	return (it != m_streams.end()) ? it->second : nullptr;
+}
+
+CHttp2Session::TStream* CHttp2Session::CreateStream(DWORD dwStreamID, BOOL bLocal)
+{
+	TStream* pStream = new TStream;
+
+	pStream->id				= dwStreamID;
+	pStream->local			= bLocal;
+	pStream->localClosed	= FALSE;
+	pStream->remoteClosed	= FALSE;
+	pStream->endQueued		= FALSE;
+	pStream->headersDone	= FALSE;
+	pStream->discard		= FALSE;
+	pStream->sendWindow		= m_iPeerInitialWindow;
+	pStream->recvWindow		= HTTP2_LOCAL_STREAM_WINDOW_SIZE;
+	pStream->recvConsumed	= 0;
+
+	m_streams[dwStreamID] = pStream;
+
+	if(bLocal)
+		++m_iLocalStreams;
+	else
+		++m_iPeerStreams;
+
+	return pStream;
+}
+
+void CHttp2Session::CloseStream(TStream* pStream)
+{
+	if(pStream->local)
+		--m_iLocalStreams;
+	else
+		--m_iPeerStreams;
+
+	m_streams.erase(pStream->id);
+
+	delete pStream;
+}
+
+void CHttp2Session::SetLocalClosed(TStream* pStream)
+{
+	pStream->localClosed = TRUE;
+
+	if(pStream->remoteClosed)
+		CloseStream(pStream);
+}
+
+void CHttp2Session::SetRemoteClosed(TStream* pStream)
+{
+	pStream->remoteClosed = TRUE;
+
+	if(pStream->localClosed)
+		CloseStream(pStream);
+}
+
+void CHttp2Session::ConsumeRecvWindow(TStream* pStream, int iLength)
+{
+	m_iRecvConsumed += iLength;
+
+	if(m_iRecvConsumed >= HTTP2_LOCAL_CONN_WINDOW_SIZE / 2)
+	{
+		WriteFrameHeader(4, H2FT_WINDOW_UPDATE, 0, 0);
+		WriteUInt32(m_iRecvConsumed);
+
+		m_iRecvWindow	+= m_iRecvConsumed;
+		m_iRecvConsumed	 = 0;
+	}
+
+	if(pStream == nullptr || pStream->remoteClosed)
+		return;
+
+	pStream->recvConsumed += iLength;
+
+	if(pStream->recvConsumed >= HTTP2_LOCAL_STREAM_WINDOW_SIZE / 2)
+	{
+		WriteFrameHeader(4, H2FT_WINDOW_UPDATE, 0, pStream->id);
+		WriteUInt32(pStream->recvConsumed);
+
+		pStream->recvWindow		+= pStream->recvConsumed;
+		pStream->recvConsumed	 = 0;
+	}
+}
+
+int CHttp2Session::WriteData(TStream* pStream, const BYTE* pData, int iLength, BOOL bEndStream)
+{
+	int iSent = 0;
+
+	while(iSent < iLength)
+	{
+		int iFrameLen = MIN(iLength - iSent, m_iPeerMaxFrameSize);
+		iFrameLen = MIN(iFrameLen, m_iSendWindow);
+		iFrameLen = MIN(iFrameLen, pStream->sendWindow);
+
+		if(iFrameLen <= 0)
+			break;
+
+		BOOL bLast = bEndStream && (iSent + iFrameLen == iLength);
+
+		WriteFrameHeader(iFrameLen, H2FT_DATA, bLast ? H2FF_END_STREAM : 0, pStream->id);
+		m_bufSend.Cat(pData + iSent, iFrameLen);
+
+		iSent				+= iFrameLen;
+		m_iSendWindow		-= iFrameLen;
+		pStream->sendWindow	-= iFrameLen;
+	}
+
+	if(iLength == 0 && bEndStream)
+		WriteFrameHeader(0, H2FT_DATA, H2FF_END_STREAM, pStream->id);
+
+	return iSent;
+}
+
+BOOL CHttp2Session::FlushPending(TStream* pStream)
+{
+	CBufferPtr& pending	= pStream->pending;
+	int iLength			= (int)pending.Size();
+	int iSent			= WriteData(pStream, pending.Ptr(), iLength, pStream->endQueued);
+
+	if(iSent < iLength)
+	{
+		if(iSent > 0)
+		{
+			memmove(pending.Ptr(), pending.Ptr() + iSent, iLength - iSent);
+			pending.SetSize(iLength - iSent);
+		}
+
+		return FALSE;
+	}
+
+	pending.Free();
+
+	if(pStream->endQueued)
+		SetLocalClosed(pStream);
+
+	return TRUE;
+}
+
+void CHttp2Session::FlushAllPending()
+{
+	size_t j = 0;
+
+	for(size_t i = 0; i < m_vtBlocked.size(); i++)
+	{
+		TStream* pStream = FindStream(m_vtBlocked[i]);
+
+		if(pStream == nullptr || pStream->pending.Size() == 0)
+			continue;
+
+		if(m_iSendWindow <= 0 || !FlushPending(pStream))
+			m_vtBlocked[j++] = m_vtBlocked[i];
+	}
+
+	m_vtBlocked.resize(j);
+}
+
+void CHttp2Session::WriteHeaders(DWORD dwStreamID, const CHttp2FieldList& fields, BOOL bEndStream)
+{
+	m_bufHeaders.SetSize(0);
+	m_encoder.Encode(fields, m_bufHeaders);
+
+	const BYTE* pBlock	= m_bufHeaders.Ptr();
+	int iBlockLen		= (int)m_bufHeaders.Size();
+	int iOffset			= 0;
+
+	do
+	{
+		int iFrameLen	= MIN(iBlockLen - iOffset, m_iPeerMaxFrameSize);
+		BYTE bType		= (iOffset == 0) ? H2FT_HEADERS : H2FT_CONTINUATION;
+		BYTE bFlags		= (iOffset + iFrameLen == iBlockLen) ? H2FF_END_HEADERS : 0;
+
+		if(iOffset == 0 && bEndStream)
+			bFlags |= H2FF_END_STREAM;
+
+		WriteFrameHeader(iFrameLen, bType, bFlags, dwStreamID);
+
+		if(iFrameLen > 0)
+			m_bufSend.Cat(pBlock + iOffset, iFrameLen);
+
+		iOffset += iFrameLen;
+	} while(iOffset < iBlockLen);
+}
+
+void CHttp2Session::WriteFrameHeader(int iLength, BYTE bType, BYTE bFlags, DWORD dwStreamID)
+{
+	BYTE header[HTTP2_FRAME_HEADER_SIZE] =
+	{
+		(BYTE)(iLength >> 16), (BYTE)(iLength >> 8), (BYTE)iLength,
+		bType, bFlags,
+		(BYTE)(dwStreamID >> 24), (BYTE)(dwStreamID >> 16), (BYTE)(dwStreamID >> 8), (BYTE)dwStreamID
+	};
+
+	m_bufSend.Cat(header, HTTP2_FRAME_HEADER_SIZE);
+}
+
+void CHttp2Session::WriteUInt32(DWORD dwValue)
+{
+	BYTE bytes[4] = {(BYTE)(dwValue >> 24), (BYTE)(dwValue >> 16), (BYTE)(dwValue >> 8), (BYTE)dwValue};
+
+	m_bufSend.Cat(bytes, 4);
+}
+
+BOOL CHttp2Session::Flush()
+{
+	if(m_bufSend.Size() == 0)
+		return TRUE;
+
+	BOOL isOK = m_pHandler->OnHttp2Send(m_bufSend.Ptr(), (int)m_bufSend.Size());
+
+	m_bufSend.SetSize(0);
+
+	return isOK;
+}
+
+#endif
@@ -0,0 +1,507 @@
+/*
+ * Copyright: JessMA Open Source (ldcsaa@gmail.com)
+ *
+ * Author	: Bruce Liang
+ * Website	: https://github.com/ldcsaa
+ * Project	: https://github.com/ldcsaa/HP-Socket
+ * Blog		: http://www.cnblogs.com/ldcsaa
+ * Wiki		: http://www.oschina.net/p/hp-socket
+ * QQ Group	: 44636872, 75375912
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "SocketHelper.h"
+
+#ifdef _HTTP_SUPPORT
+
+#include <deque>
+#include <vector>
+#include <unordered_map>
+
+using namespace std;
+
+/************************************************************************
+名称：HTTP/2 全局常量
+描述：声明 HTTP/2（RFC 7540）及 HPACK 头部压缩（RFC 7541）的常量
+************************************************************************/
+
+#define HTTP2_PREFACE						"PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n"
+#define HTTP2_PREFACE_LEN					24
+#define HTTP2_ALPN_PROTOCOL					"h2"
+#define HTTP2_SCHEMA_HTTP					"http"
+#define HTTP2_SCHEMA_HTTPS					"https"
+
+#define HTTP2_HEADER_METHOD					":method"
+#define HTTP2_HEADER_SCHEME					":scheme"
+#define HTTP2_HEADER_AUTHORITY				":authority"
+#define HTTP2_HEADER_PATH					":path"
+#define HTTP2_HEADER_STATUS					":status"
+#define HTTP2_HEADER_CONTENT_LENGTH			"content-length"
+
+#define HTTP2_FRAME_HEADER_SIZE				9
+#define HTTP2_MIN_FRAME_SIZE				16384
+#define HTTP2_MAX_FRAME_SIZE				0xFFFFFF
+#define HTTP2_DEFAULT_WINDOW_SIZE			65535
+#define HTTP2_MAX_WINDOW_SIZE				0x7FFFFFFF
+#define HTTP2_MAX_STREAM_ID					0x7FFFFFFF
+#define HTTP2_DEFAULT_HEADER_TABLE_SIZE		4096
+
+/* 本端接受的最大头部列表大小（SETTINGS_MAX_HEADER_LIST_SIZE） */
+#define HTTP2_MAX_HEADER_LIST_SIZE			(64 * 1024)
+/* 本端缓存的最大头部块长度（HEADERS + CONTINUATION） */
+#define HTTP2_MAX_HEADER_BLOCK_SIZE			(HTTP2_MAX_HEADER_LIST_SIZE * 2)
+/* 本端通告的流窗口及连接窗口（数据交给应用处理后即补充窗口） */
+#define HTTP2_LOCAL_STREAM_WINDOW_SIZE		(256 * 1024)
+#define HTTP2_LOCAL_CONN_WINDOW_SIZE		(1024 * 1024)
+
+#define DEFAULT_HTTP2_MAX_CONCURRENT_STREAMS	256
+
+/* 洪水攻击检测：每个统计周期（毫秒）内允许对端发送的 PING、SETTINGS、空 DATA 及 RST_STREAM 帧数量，超出时以 ENHANCE_YOUR_CALM 终止连接 */
+#define HTTP2_FLOOD_CHECK_INTERVAL			10000
+#define HTTP2_MAX_PING_FRAMES				500
+#define HTTP2_MAX_SETTINGS_FRAMES			100
+#define HTTP2_MAX_EMPTY_DATA_FRAMES			1000
+#define HTTP2_MAX_RST_STREAM_FRAMES			1000
+/* 等待发送的控制帧应答（PING ACK）的最大字节数，超出时以 ENHANCE_YOUR_CALM 终止连接 */
+#define HTTP2_MAX_CONTROL_QUEUE_SIZE		(16 * 1024)
+
+/* HTTP/2 帧类型 */
+enum EnHttp2FrameType
+{
+	H2FT_DATA			= 0x0,
+	H2FT_HEADERS		= 0x1,
+	H2FT_PRIORITY		= 0x2,
+	H2FT_RST_STREAM		= 0x3,
+	H2FT_SETTINGS		= 0x4,
+	H2FT_PUSH_PROMISE	= 0x5,
+	H2FT_PING			= 0x6,
+	H2FT_GOAWAY			= 0x7,
+	H2FT_WINDOW_UPDATE	= 0x8,
+	H2FT_CONTINUATION	= 0x9,
+};
+
+/* HTTP/2 帧标志 */
+enum EnHttp2FrameFlag
+{
+	H2FF_END_STREAM		= 0x01,
+	H2FF_ACK			= 0x01,
+	H2FF_END_HEADERS	= 0x04,
+	H2FF_PADDED			= 0x08,
+	H2FF_PRIORITY		= 0x20,
+};
+
+/* HTTP/2 SETTINGS 参数 */
+enum EnHttp2Setting
+{
+	H2SS_HEADER_TABLE_SIZE		= 0x1,
+	H2SS_ENABLE_PUSH			= 0x2,
+	H2SS_MAX_CONCURRENT_STREAMS	= 0x3,
+	H2SS_INITIAL_WINDOW_SIZE	= 0x4,
+	H2SS_MAX_FRAME_SIZE			= 0x5,
+	H2SS_MAX_HEADER_LIST_SIZE	= 0x6,
+};
+
+/* HTTP/2 错误码（RST_STREAM / GOAWAY） */
+enum EnHttp2ErrorCode
+{
+	H2EC_NO_ERROR				= 0x0,
+	H2EC_PROTOCOL_ERROR			= 0x1,
+	H2EC_INTERNAL_ERROR			= 0x2,
+	H2EC_FLOW_CONTROL_ERROR		= 0x3,
+	H2EC_SETTINGS_TIMEOUT		= 0x4,
+	H2EC_STREAM_CLOSED			= 0x5,
+	H2EC_FRAME_SIZE_ERROR		= 0x6,
+	H2EC_REFUSED_STREAM			= 0x7,
+	H2EC_CANCEL					= 0x8,
+	H2EC_COMPRESSION_ERROR		= 0x9,
+	H2EC_CONNECT_ERROR			= 0xA,
+	H2EC_ENHANCE_YOUR_CALM		= 0xB,
+	H2EC_INADEQUATE_SECURITY	= 0xC,
+	H2EC_HTTP_1_1_REQUIRED		= 0xD,
+};
+
+// ------------------------------------------------------------------------------------------------------------- //
+
+/************************************************************************
+名称：HTTP/2 头部字段列表
+描述：名称和值（以 '\0' 结尾）依次追加到连续缓冲区中，清空后缓冲区空间被复用
+************************************************************************/
+class CHttp2FieldList
+{
+public:
+	void Add(LPCSTR lpszName, int iNameLen, LPCSTR lpszValue, int iValueLen);
+	void Add(LPCSTR lpszName, LPCSTR lpszValue)	{Add(lpszName, (int)strlen(lpszName), lpszValue, (int)strlen(lpszValue));}
+	void Clear();
+	/* 复制另一个字段列表的全部字段 */
+	void Copy(const CHttp2FieldList& other);
+
+	/* 查找第一个同名字段（名称区分大小写），找不到返回 -1 */
+	int Find(LPCSTR lpszName) const;
+	/* 查找第一个同名字段（名称不区分大小写），找不到返回 -1 */
+	int FindNoCase(LPCSTR lpszName) const;
+
+	int Size()					const	{return (int)m_fields.size();}
+	LPCSTR GetName(int i)		const	{return m_buffer.Ptr() + m_fields[i].nameOff;}
+	LPCSTR GetValue(int i)		const	{return m_buffer.Ptr() + m_fields[i].valueOff;}
+	int GetNameLen(int i)		const	{return m_fields[i].nameLen;}
+	int GetValueLen(int i)		const	{return m_fields[i].valueLen;}
+	/* 头部列表大小（RFC 7540 6.5.2：每个字段的名称长度 + 值长度 + 32） */
+	UINT GetListSize()			const	{return m_uiListSize;}
+
+public:
+	CHttp2FieldList() : m_uiListSize(0) {}
+
+	DECLARE_NO_COPY_CLASS(CHttp2FieldList)
+
+private:
+	struct TField
+	{
+		int nameOff;
+		int nameLen;
+		int valueOff;
+		int valueLen;
+	};
+
+	CCharBufferPtr	m_buffer;
+	vector<TField>	m_fields;
+	UINT			m_uiListSize;
+};
+
+/************************************************************************
+名称：HPACK Huffman 编解码
+描述：使用 RFC 7541 附录 B 的静态 Huffman 码表，解码使用启动时构建的二叉解码树
+************************************************************************/
+class CHpackHuffman
+{
+public:
+	/* 获取 Huffman 编码后的长度 */
+	static int GetEncodedLength(LPCSTR lpszData, int iLength);
+	/* Huffman 编码：编码结果追加到 buffer */
+	static void Encode(LPCSTR lpszData, int iLength, CBufferPtr& buffer);
+	/* Huffman 解码：解码结果追加到 buffer，编码中含有 EOS 或填充不合法时返回 FALSE */
+	static BOOL Decode(const BYTE* pData, int iLength, CCharBufferPtr& buffer);
+
+private:
+	CHpackHuffman() = delete;
+};
+
+/************************************************************************
+名称：HPACK 头部表
+描述：索引 1 - 61 为静态表，62 以后为动态表（最新加入的字段索引最小）；
+	  动态表大小按 RFC 7541 4.1 计算（名称长度 + 值长度 + 32），超出最大值时淘汰最旧的字段
+************************************************************************/
+class CHpackTable
+{
+public:
+	/* 获取索引对应的头部字段，索引无效返回 FALSE */
+	BOOL Get(UINT uiIndex, LPCSTR& lpszName, int& iNameLen, LPCSTR& lpszValue, int& iValueLen) const;
+	/* 查找头部字段：返回名称和值都匹配的索引（bExact 为 TRUE）或只有名称匹配的索引，找不到返回 0 */
+	UINT Find(LPCSTR lpszName, int iNameLen, LPCSTR lpszValue, int iValueLen, BOOL& bExact) const;
+	/* 加入动态表，字段大小超过动态表最大值时清空动态表 */
+	void Add(LPCSTR lpszName, int iNameLen, LPCSTR lpszValue, int iValueLen);
+
+	void SetMaxSize(UINT uiMaxSize);
+	void Clear();
+
+	UINT GetMaxSize()	const	{return m_uiMaxSize;}
+	UINT GetSize()		const	{return m_uiSize;}
+	int GetCount()		const	{return (int)m_entries.size();}
+
+	static const UINT STATIC_COUNT = 61;
+
+private:
+	void Evict(UINT uiLimit);
+
+public:
+	CHpackTable() : m_uiSize(0), m_uiMaxSize(HTTP2_DEFAULT_HEADER_TABLE_SIZE) {}
+
+	DECLARE_NO_COPY_CLASS(CHpackTable)
+
+private:
+	struct TEntry
+	{
+		CStringA name;
+		CStringA value;
+	};
+
+	deque<TEntry>	m_entries;
+	UINT			m_uiSize;
+	UINT			m_uiMaxSize;
+};
+
+/************************************************************************
+名称：HPACK 解码器
+描述：解码完整的头部块，头部块之间共享动态表，因此一个连接上的所有头部块必须按接收顺序解码
+************************************************************************/
+class CHpackDecoder
+{
+public:
+	/* 解码头部块：解码出的字段追加到 fields，成功返回 H2EC_NO_ERROR；
+	   压缩错误返回 H2EC_COMPRESSION_ERROR，头部列表大小超过 HTTP2_MAX_HEADER_LIST_SIZE 时立即停止解码并返回 H2EC_ENHANCE_YOUR_CALM */
+	EnHttp2ErrorCode Decode(const BYTE* pData, int iLength, CHttp2FieldList& fields);
+	/* 设置本端通告的 SETTINGS_HEADER_TABLE_SIZE（动态表大小更新不能超过该值） */
+	void SetMaxTableSize(UINT uiMaxSize)	{m_uiMaxTableSize = uiMaxSize;}
+	void Reset();
+
+private:
+	static BOOL DecodeInt(const BYTE*& p, const BYTE* pEnd, int iPrefixBits, UINT& uiValue);
+	static BOOL DecodeString(const BYTE*& p, const BYTE* pEnd, CCharBufferPtr& buffer);
+	static BOOL IsListSizeExceeded(const CHttp2FieldList& fields, int iNameLen, int iValueLen)
+		{return fields.GetListSize() + (UINT)(iNameLen + iValueLen + 32) > HTTP2_MAX_HEADER_LIST_SIZE;}
+
+public:
+	CHpackDecoder() : m_uiMaxTableSize(HTTP2_DEFAULT_HEADER_TABLE_SIZE) {}
+
+	DECLARE_NO_COPY_CLASS(CHpackDecoder)
+
+private:
+	CHpackTable		m_table;
+	UINT			m_uiMaxTableSize;
+
+	CCharBufferPtr	m_bufName;
+	CCharBufferPtr	m_bufValue;
+};
+
+/************************************************************************
+名称：HPACK 编码器
+描述：字段名称转换为小写；完全匹配的字段使用索引，其它字段按名称选择编码方式：
+	  敏感字段（authorization、cookie 等）使用永不索引的字面值，取值多变的字段（:path、content-length 等）
+	  使用不索引的字面值，其余字段加入动态表；字符串在 Huffman 编码更短时使用 Huffman 编码
+************************************************************************/
+class CHpackEncoder
+{
+public:
+	/* 编码头部块：编码结果追加到 buffer */
+	void Encode(const CHttp2FieldList& fields, CBufferPtr& buffer);
+	/* 设置对端通告的 SETTINGS_HEADER_TABLE_SIZE（本端最多使用 HTTP2_DEFAULT_HEADER_TABLE_SIZE） */
+	void SetMaxTableSize(UINT uiMaxSize);
+	void Reset();
+
+private:
+	void EncodeField(LPCSTR lpszName, int iNameLen, LPCSTR lpszValue, int iValueLen, CBufferPtr& buffer);
+
+	static void EncodeInt(UINT uiValue, int iPrefixBits, BYTE bFlags, CBufferPtr& buffer);
+	static void EncodeString(LPCSTR lpszData, int iLength, CBufferPtr& buffer);
+
+public:
+	CHpackEncoder()
+	: m_uiTableSize		(HTTP2_DEFAULT_HEADER_TABLE_SIZE)
+	, m_uiMinTableSize	(HTTP2_DEFAULT_HEADER_TABLE_SIZE)
+	, m_bSizeUpdate		(FALSE)
+	{
+
+	}
+
+	DECLARE_NO_COPY_CLASS(CHpackEncoder)
+
+private:
+	CHpackTable		m_table;
+
+	/* 待通告的动态表大小更新：两次编码之间动态表大小先减小再增大时需先通告最小值 */
+	UINT			m_uiTableSize;
+	UINT			m_uiMinTableSize;
+	BOOL			m_bSizeUpdate;
+
+	CCharBufferPtr	m_bufName;
+};
+
+// ------------------------------------------------------------------------------------------------------------- //
+
+/************************************************************************
+名称：HTTP/2 会话事件处理器
+描述：CHttp2Session 通过本接口输出帧数据和投递流事件
+************************************************************************/
+class IHttp2SessionHandler
+{
+public:
+	/* 发送帧数据（在会话锁内调用，不能回调 CHttp2Session 的方法） */
+	virtual BOOL OnHttp2Send(const BYTE* pData, int iLength)														= 0;
+	/*
+	* 收到完整的头部块
+	*		lpszMethod / lpszPath	-- 客户端：流对应的请求方法和路径；服务端：nullptr
+	*		bTrailer				-- 是否为请求体 / 响应体之后的尾部头部
+	* 返回 HPR_SKIP_BODY 时丢弃该流后续的 DATA 帧，返回 HPR_ERROR 时以 INTERNAL_ERROR 终止连接
+	*/
+	virtual EnHttpParseResult OnHttp2Headers(DWORD dwStreamID, const CHttp2FieldList& fields, LPCSTR lpszMethod, LPCSTR lpszPath, BOOL bEndStream, BOOL bTrailer)	= 0;
+	/* 收到 DATA 帧数据（iLength 可能为 0），返回 HPR_ERROR 时以 INTERNAL_ERROR 终止连接 */
+	virtual EnHttpParseResult OnHttp2Data(DWORD dwStreamID, const BYTE* pData, int iLength, BOOL bEndStream)		= 0;
+	/* 流被对端重置（RST_STREAM）或因对端 GOAWAY 而不会被处理 */
+	virtual void OnHttp2StreamReset(DWORD dwStreamID, DWORD dwErrorCode)											= 0;
+
+public:
+	virtual ~IHttp2SessionHandler() = default;
+};
+
+/************************************************************************
+名称：HTTP/2 会话
+描述：实现一个连接上的 HTTP/2 帧收发、流状态、HPACK 编解码和流量控制
+		1、Receive() 只能在连接的接收线程中调用，事件回调时不持有会话锁，回调中可以调用发送方法
+		2、发送方法可以在任意线程中调用：帧编码和输出在会话锁内完成，保证 HPACK 编码顺序与发送顺序一致
+		3、超出对端流控窗口的 DATA 数据缓存在流中，收到 WINDOW_UPDATE 或 SETTINGS 后继续发送
+		4、接收的 DATA 数据交给应用后，已消耗的数量超过窗口的一半时发送 WINDOW_UPDATE
+		5、不支持服务端推送（SETTINGS_ENABLE_PUSH 为 0）和优先级调度（PRIORITY 帧被忽略）
+		6、PING 应答在本次 Receive() 结束时合并发送；对端在统计周期内发送过多的 PING / SETTINGS / 空 DATA / RST_STREAM 帧，
+		   或等待发送的 PING 应答超过上限时，发送 GOAWAY（ENHANCE_YOUR_CALM）并终止连接
+************************************************************************/
+class CHttp2Session
+{
+private:
+	struct TStream
+	{
+		DWORD		id;
+		BOOL		local;
+		BOOL		localClosed;
+		BOOL		remoteClosed;
+		BOOL		endQueued;
+		BOOL		headersDone;
+		BOOL		discard;
+		int			sendWindow;
+		int			recvWindow;
+		int			recvConsumed;
+		CBufferPtr	pending;
+		CStringA	method;
+		CStringA	path;
+
+		/* 对端发送的第一个头部块（流关闭时随流释放） */
+		CHttp2FieldList	fields;
+	};
+
+	using CStreamMap = unordered_map<DWORD, TStream*>;
+
+public:
+	/* 启动会话：客户端发送连接前言，双方发送 SETTINGS 帧和连接窗口的 WINDOW_UPDATE 帧 */
+	BOOL Start(BOOL bServer, DWORD dwMaxConcurrentStreams, IHttp2SessionHandler* pHandler);
+	void Reset();
+
+	/* 处理接收的数据（服务端以连接前言开始）：连接错误时发送 GOAWAY 并返回 FALSE，通过 GetErrorCode() / GetErrorDesc() 获取错误 */
+	BOOL Receive(const BYTE* pData, int iLength);
+
+	/* 客户端：创建新的流并发送请求头部块，返回流 ID，失败返回 0（对端并发流数达到上限时错误码为 ERROR_CONNECTION_COUNT_LIMIT） */
+	DWORD OpenStream(const CHttp2FieldList& fields, BOOL bEndStream);
+	/* 发送头部块（响应头部或尾部头部） */
+	BOOL SendHeaders(DWORD dwStreamID, const CHttp2FieldList& fields, BOOL bEndStream);
+	/* 发送数据：超出流控窗口的数据缓存在流中，窗口更新后发送 */
+	BOOL SendData(DWORD dwStreamID, const BYTE* pData, int iLength, BOOL bEndStream);
+	/* 重置流 */
+	BOOL ResetStream(DWORD dwStreamID, DWORD dwErrorCode = H2EC_CANCEL);
+	/* 发送 GOAWAY：不再接受新的流 */
+	BOOL GoAway(DWORD dwErrorCode = H2EC_NO_ERROR);
+
+	/* 检查流是否存在且本端还可以发送数据 */
+	BOOL IsStreamWritable(DWORD dwStreamID);
+	/* 获取未关闭的流数量 */
+	int GetStreamCount();
+	/*
+	* 获取流的头部字段值（对端发送的第一个头部块，名称不区分大小写，"host" 不存在时取 ":authority"），可在任意线程中调用
+	*		iValueLen	-- 传入：缓冲区长度；传出：值长度（包含结尾的 '\0'），缓冲区不足时返回 FALSE 并设置为所需长度
+	* 流不存在或已关闭时返回 FALSE（错误代码：ERROR_OBJECT_NOT_FOUND）
+	*/
+	BOOL GetStreamField(DWORD dwStreamID, LPCSTR lpszName, LPSTR lpszValue, int& iValueLen);
+
+	BOOL IsStarted()		const	{return m_pHandler != nullptr;}
+	BOOL IsServer()			const	{return m_bServer;}
+	DWORD GetErrorCode()	const	{return m_dwErrorCode;}
+	LPCSTR GetErrorDesc()	const	{return m_lpszErrorDesc;}
+
+private:
+	BOOL ProcessFrame(BYTE bType, BYTE bFlags, DWORD dwStreamID, const BYTE* pPayload, int iLength);
+	BOOL OnDataFrame(BYTE bFlags, DWORD dwStreamID, const BYTE* pPayload, int iLength);
+	BOOL OnHeadersFrame(BYTE bFlags, DWORD dwStreamID, const BYTE* pPayload, int iLength);
+	BOOL OnContinuationFrame(BYTE bFlags, DWORD dwStreamID, const BYTE* pPayload, int iLength);
+	BOOL OnRstStreamFrame(DWORD dwStreamID, const BYTE* pPayload, int iLength);
+	BOOL OnSettingsFrame(BYTE bFlags, DWORD dwStreamID, const BYTE* pPayload, int iLength);
+	BOOL OnPingFrame(BYTE bFlags, DWORD dwStreamID, const BYTE* pPayload, int iLength);
+	BOOL OnGoAwayFrame(DWORD dwStreamID, const BYTE* pPayload, int iLength);
+	BOOL OnWindowUpdateFrame(DWORD dwStreamID, const BYTE* pPayload, int iLength);
+	BOOL ProcessHeaderBlock();
+
+	/* 以下方法在会话锁内调用 */
+	BOOL CheckFlood(int& iFrames, int iMaxFrames, LPCSTR lpszDesc);
+	BOOL ConnectionError(DWORD dwErrorCode, LPCSTR lpszDesc);
+	void StreamError(DWORD dwStreamID, DWORD dwErrorCode);
+	BOOL IsIdleStream(DWORD dwStreamID) const;
+	TStream* FindStream(DWORD dwStreamID);
+	TStream* CreateStream(DWORD dwStreamID, BOOL bLocal);
+	void CloseStream(TStream* pStream);
+	void SetLocalClosed(TStream* pStream);
+	void SetRemoteClosed(TStream* pStream);
+	void ConsumeRecvWindow(TStream* pStream, int iLength);
+	int WriteData(TStream* pStream, const BYTE* pData, int iLength, BOOL bEndStream);
+	BOOL FlushPending(TStream* pStream);
+	void FlushAllPending();
+	void WriteHeaders(DWORD dwStreamID, const CHttp2FieldList& fields, BOOL bEndStream);
+	void WriteFrameHeader(int iLength, BYTE bType, BYTE bFlags, DWORD dwStreamID);
+	void WriteUInt32(DWORD dwValue);
+	BOOL Flush();
+
+public:
+	CHttp2Session();
+	~CHttp2Session() {Reset();}
+
+	DECLARE_NO_COPY_CLASS(CHttp2Session)
+
+private:
+	CCriSec					m_cs;
+	IHttp2SessionHandler*	m_pHandler;
+	BOOL					m_bServer;
+	BOOL					m_bError;
+	DWORD					m_dwErrorCode;
+	LPCSTR					m_lpszErrorDesc;
+
+	/* 接收线程状态 */
+	int						m_iPrefaceRemain;
+	BOOL					m_bSettingsReceived;
+	CBufferPtr				m_bufRecv;
+	CBufferPtr				m_bufBlock;
+	DWORD					m_dwBlockStreamID;
+	BOOL					m_bBlockEndStream;
+	BOOL					m_bContinuation;
+	CHpackDecoder			m_decoder;
+	CHttp2FieldList			m_fields;
+	CStringA				m_strMethod;
+	CStringA				m_strPath;
+
+	/* 洪水攻击检测 */
+	DWORD					m_dwFloodTime;
+	int						m_iPingFrames;
+	int						m_iSettingsFrames;
+	int						m_iEmptyDataFrames;
+	int						m_iRstFrames;
+
+	/* 会话锁保护的状态 */
+	CHpackEncoder			m_encoder;
+	CBufferPtr				m_bufSend;
+	CBufferPtr				m_bufHeaders;
+	CStreamMap				m_streams;
+	vector<DWORD>			m_vtBlocked;
+
+	DWORD					m_dwMaxConcurrentStreams;
+	DWORD					m_dwPeerMaxStreams;
+	int						m_iPeerMaxFrameSize;
+	int						m_iPeerInitialWindow;
+	int						m_iLocalStreams;
+	int						m_iPeerStreams;
+	DWORD					m_dwNextStreamID;
+	DWORD					m_dwLastPeerStreamID;
+	BOOL					m_bGoAwaySent;
+	BOOL					m_bGoAwayReceived;
+
+	int						m_iSendWindow;
+	int						m_iRecvWindow;
+	int						m_iRecvConsumed;
+};
+
+#endif
@@ -40,7 +40,6 @@ template<class T, USHORT default_port> void CHttpAgentT<T, default_port>::Prepar
 {
 	__super::PrepareStart();
 
-	m_objPool.SetHttpObjLockTime(GetFreeSocketObjLockTime());
 	m_objPool.SetHttpObjPoolSize(GetFreeSocketObjPool());
 	m_objPool.SetHttpObjPoolHold(GetFreeSocketObjHold());
 
@@ -49,6 +48,8 @@ template<class T, USHORT default_port> void CHttpAgentT<T, default_port>::Prepar
 
 template<class T, USHORT default_port> BOOL CHttpAgentT<T, default_port>::SendRequest(CONNID dwConnID, LPCSTR lpszMethod, LPCSTR lpszPath, const THeader lpHeaders[], int iHeaderCount, const BYTE* pBody, int iLength)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -56,6 +57,9 @@ template<class T, USHORT default_port> BOOL CHttpAgentT<T, default_port>::SendRe
 		::SetLastError(ERROR_OBJECT_NOT_FOUND);
 		return FALSE;
 	}
+
+	if(pHttpObj->IsHttp2())
+		return SendStreamRequest(dwConnID, nullptr, lpszMethod, lpszPath, lpHeaders, iHeaderCount, pBody, iLength);
 	
 	WSABUF szBuffer[2];
 	CStringA strHeader;
@@ -99,8 +103,88 @@ template<class T, USHORT default_port> BOOL CHttpAgentT<T, default_port>::SendLo
 	return SendRequest(dwConnID, lpszMethod, lpszPath, lpHeaders, iHeaderCount, (BYTE*)fmap, (int)fmap.Size());
 }
 
+template<class T, USHORT default_port> BOOL CHttpAgentT<T, default_port>::SendStreamRequest(CONNID dwConnID, DWORD* lpdwStreamID, LPCSTR lpszMethod, LPCSTR lpszPath, const THeader lpHeaders[], int iHeaderCount, const BYTE* pBody, int iLength)
+{
+	CEpochLock epochlock;
+
+	THttpObj* pHttpObj = FindHttpObj(dwConnID);
+
+	if(pHttpObj == nullptr)
+	{
+		::SetLastError(ERROR_OBJECT_NOT_FOUND);
+		return FALSE;
+	}
+
+	if(!pHttpObj->IsHttp2())
+	{
+		::SetLastError(ERROR_INVALID_STATE);
+		return FALSE;
+	}
+
+	LPCSTR lpszHost	= nullptr;
+	USHORT usPort	= 0;
+
+	GetRemoteHost(dwConnID, &lpszHost, &usPort);
+	if(usPort == default_port) usPort = 0;
+
+	CStringA strPath;
+	::AdjustRequestPath(FALSE, lpszPath, strPath);
+
+	TCookieMap cookies;
+	pHttpObj->LoadHttp2Cookies(strPath, cookies);
+
+	CHttp2FieldList fields;
+	fields.Add(HTTP2_HEADER_METHOD, CStringA(lpszMethod).MakeUpper());
+	fields.Add(HTTP2_HEADER_SCHEME, IsSecure() ? HTTP2_SCHEMA_HTTPS : HTTP2_SCHEMA_HTTP);
+	fields.Add(HTTP2_HEADER_PATH, strPath);
+
+	BOOL bChunked	= ::MakeHttp2HeaderFields(lpHeaders, iHeaderCount, &cookies, iLength, TRUE, lpszHost, usPort, fields);
+	BOOL bEndStream	= (iLength == 0 && !bChunked);
+
+	CHttp2Session& session	= pHttpObj->GetHttp2Session();
+	DWORD dwStreamID		= session.OpenStream(fields, bEndStream);
+
+	if(dwStreamID == 0)
+		return FALSE;
+
+	if(lpdwStreamID != nullptr)
+		*lpdwStreamID = dwStreamID;
+
+	if(iLength > 0)
+		return session.SendData(dwStreamID, pBody, iLength, !bChunked);
+
+	return TRUE;
+}
+
+template<class T, USHORT default_port> BOOL CHttpAgentT<T, default_port>::SendStreamChunkData(CONNID dwConnID, DWORD dwStreamID, const BYTE* pData, int iLength)
+{
+	CEpochLock epochlock;
+
+	THttpObj* pHttpObj = FindHttpObj(dwConnID);
+
+	if(pHttpObj == nullptr)
+	{
+		::SetLastError(ERROR_OBJECT_NOT_FOUND);
+		return FALSE;
+	}
+
+	if(!pHttpObj->IsHttp2())
+	{
+		::SetLastError(ERROR_INVALID_STATE);
+		return FALSE;
+	}
+
+	return pHttpObj->GetHttp2Session().SendData(dwStreamID, pData, iLength, iLength == 0);
+}
+
 template<class T, USHORT default_port> BOOL CHttpAgentT<T, default_port>::SendChunkData(CONNID dwConnID, const BYTE* pData, int iLength, LPCSTR lpszExtensions)
 {
+	if(m_bHttp2Support && IsHttp2(dwConnID))
+	{
+		::SetLastError(ERROR_INVALID_OPERATION);
+		return FALSE;
+	}
+
 	char szLen[12];
 	WSABUF bufs[5];
 
@@ -142,11 +226,17 @@ template<class T, USHORT default_port> EnHandleResult CHttpAgentT<T, default_por
 
 template<class T, USHORT default_port> EnHandleResult CHttpAgentT<T, default_port>::DoFireHandShake(TAgentSocketObj* pSocketObj)
 {
-	EnHandleResult result = __super::DoFireHandShake(pSocketObj);
+	EnHandleResult result;
+	THttpObj* pHttpObj = FindHttpObj(pSocketObj);
+
+	// HTTP/2 会话在 OnHandShake 事件之前启动，应用在 OnHandShake 事件中即可发送请求
+	if(pHttpObj != nullptr && IsHttp2Negotiated(pSocketObj) && !pHttpObj->StartHttp2())
+		result = HR_ERROR;
+	else
+		result = __super::DoFireHandShake(pSocketObj);
 
 	if(result == HR_ERROR)
 	{
-		THttpObj* pHttpObj = FindHttpObj(pSocketObj);
 		VERIFY(pHttpObj);
 
 		m_objPool.PutFreeHttpObj(pHttpObj);
@@ -192,6 +282,8 @@ template<class T, USHORT default_port> EnHandleResult CHttpAgentT<T, default_por
 
 template<class T, USHORT default_port> BOOL CHttpAgentT<T, default_port>::IsUpgrade(CONNID dwConnID)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -202,6 +294,8 @@ template<class T, USHORT default_port> BOOL CHttpAgentT<T, default_port>::IsUpgr
 
 template<class T, USHORT default_port> BOOL CHttpAgentT<T, default_port>::IsKeepAlive(CONNID dwConnID)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -212,6 +306,8 @@ template<class T, USHORT default_port> BOOL CHttpAgentT<T, default_port>::IsKeep
 
 template<class T, USHORT default_port> USHORT CHttpAgentT<T, default_port>::GetVersion(CONNID dwConnID)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -222,6 +318,8 @@ template<class T, USHORT default_port> USHORT CHttpAgentT<T, default_port>::GetV
 
 template<class T, USHORT default_port> ULONGLONG CHttpAgentT<T, default_port>::GetContentLength(CONNID dwConnID)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -232,6 +330,8 @@ template<class T, USHORT default_port> ULONGLONG CHttpAgentT<T, default_port>::G
 
 template<class T, USHORT default_port> LPCSTR CHttpAgentT<T, default_port>::GetContentType(CONNID dwConnID)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -242,6 +342,8 @@ template<class T, USHORT default_port> LPCSTR CHttpAgentT<T, default_port>::GetC
 
 template<class T, USHORT default_port> LPCSTR CHttpAgentT<T, default_port>::GetContentEncoding(CONNID dwConnID)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -252,6 +354,8 @@ template<class T, USHORT default_port> LPCSTR CHttpAgentT<T, default_port>::GetC
 
 template<class T, USHORT default_port> LPCSTR CHttpAgentT<T, default_port>::GetTransferEncoding(CONNID dwConnID)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -262,6 +366,8 @@ template<class T, USHORT default_port> LPCSTR CHttpAgentT<T, default_port>::GetT
 
 template<class T, USHORT default_port> EnHttpUpgradeType CHttpAgentT<T, default_port>::GetUpgradeType(CONNID dwConnID)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -272,6 +378,8 @@ template<class T, USHORT default_port> EnHttpUpgradeType CHttpAgentT<T, default_
 
 template<class T, USHORT default_port> USHORT CHttpAgentT<T, default_port>::GetParseErrorCode(CONNID dwConnID, LPCSTR* lpszErrorDesc)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -282,6 +390,8 @@ template<class T, USHORT default_port> USHORT CHttpAgentT<T, default_port>::GetP
 
 template<class T, USHORT default_port> BOOL CHttpAgentT<T, default_port>::GetHeader(CONNID dwConnID, LPCSTR lpszName, LPCSTR* lpszValue)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -292,6 +402,8 @@ template<class T, USHORT default_port> BOOL CHttpAgentT<T, default_port>::GetHea
 
 template<class T, USHORT default_port> BOOL CHttpAgentT<T, default_port>::GetHeaders(CONNID dwConnID, LPCSTR lpszName, LPCSTR lpszValue[], DWORD& dwCount)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -302,6 +414,8 @@ template<class T, USHORT default_port> BOOL CHttpAgentT<T, default_port>::GetHea
 
 template<class T, USHORT default_port> BOOL CHttpAgentT<T, default_port>::GetAllHeaders(CONNID dwConnID, THeader lpHeaders[], DWORD& dwCount)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -312,6 +426,8 @@ template<class T, USHORT default_port> BOOL CHttpAgentT<T, default_port>::GetAll
 
 template<class T, USHORT default_port> BOOL CHttpAgentT<T, default_port>::GetAllHeaderNames(CONNID dwConnID, LPCSTR lpszName[], DWORD& dwCount)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -322,6 +438,8 @@ template<class T, USHORT default_port> BOOL CHttpAgentT<T, default_port>::GetAll
 
 template<class T, USHORT default_port> BOOL CHttpAgentT<T, default_port>::GetCookie(CONNID dwConnID, LPCSTR lpszName, LPCSTR* lpszValue)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -332,6 +450,8 @@ template<class T, USHORT default_port> BOOL CHttpAgentT<T, default_port>::GetCoo
 
 template<class T, USHORT default_port> BOOL CHttpAgentT<T, default_port>::GetAllCookies(CONNID dwConnID, TCookie lpCookies[], DWORD& dwCount)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -342,6 +462,8 @@ template<class T, USHORT default_port> BOOL CHttpAgentT<T, default_port>::GetAll
 
 template<class T, USHORT default_port> USHORT CHttpAgentT<T, default_port>::GetStatusCode(CONNID dwConnID)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -350,8 +472,49 @@ template<class T, USHORT default_port> USHORT CHttpAgentT<T, default_port>::GetS
 	return pHttpObj->GetStatusCode();
 }
 
+template<class T, USHORT default_port> BOOL CHttpAgentT<T, default_port>::IsHttp2(CONNID dwConnID)
+{
+	CEpochLock epochlock;
+
+	THttpObj* pHttpObj = FindHttpObj(dwConnID);
+
+	if(pHttpObj == nullptr)
+		return FALSE;
+
+	return pHttpObj->IsHttp2();
+}
+
+template<class T, USHORT default_port> DWORD CHttpAgentT<T, default_port>::GetStreamID(CONNID dwConnID)
+{
+	CEpochLock epochlock;
+
+	THttpObj* pHttpObj = FindHttpObj(dwConnID);
+
+	if(pHttpObj == nullptr)
+		return 0;
+
+	return pHttpObj->GetStreamID();
+}
+
+template<class T, USHORT default_port> BOOL CHttpAgentT<T, default_port>::GetStreamHeader(CONNID dwConnID, DWORD dwStreamID, LPCSTR lpszName, LPSTR lpszValue, int& iValueLen)
+{
+	CEpochLock epochlock;
+
+	THttpObj* pHttpObj = FindHttpObj(dwConnID);
+
+	if(pHttpObj == nullptr)
+	{
+		::SetLastError(ERROR_OBJECT_NOT_FOUND);
+		return FALSE;
+	}
+
+	return pHttpObj->GetStreamHeader(dwStreamID, lpszName, lpszValue, iValueLen);
+}
+
 template<class T, USHORT default_port> BOOL CHttpAgentT<T, default_port>::GetWSMessageState(CONNID dwConnID, BOOL* lpbFinal, BYTE* lpiReserved, BYTE* lpiOperationCode, LPCBYTE* lpszMask, ULONGLONG* lpullBodyLen, ULONGLONG* lpullBodyRemain)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -378,6 +541,8 @@ template<class T, USHORT default_port> inline typename CHttpAgentT<T, default_po
 
 template<class T, USHORT default_port> BOOL CHttpAgentT<T, default_port>::StartHttp(CONNID dwConnID)
 {
+	CEpochLock epochlock;
+
 	if(IsHttpAutoStart())
 	{
 		::SetLastError(ERROR_INVALID_OPERATION);
@@ -446,6 +611,23 @@ template<class T, USHORT default_port> void CHttpAgentT<T, default_port>::DoStar
 	VERIFY(SetConnectionReserved(pSocketObj, pHttpObj));
 }
 
+template<class T, USHORT default_port> BOOL CHttpAgentT<T, default_port>::IsHttp2Negotiated(TAgentSocketObj* pSocketObj)
+{
+	if(!m_bHttp2Support)
+		return FALSE;
+	if(!IsSecure())
+		return TRUE;
+
+#ifdef _SSL_SUPPORT
+	LPCSTR lpszProtocol = nullptr;
+
+	if(GetSSLSessionInfo(pSocketObj->connID, SSL_SSI_ALPN_PROTOCOL, (LPVOID*)&lpszProtocol) && lpszProtocol != nullptr)
+		return strcmp(lpszProtocol, HTTP2_ALPN_PROTOCOL) == 0;
+#endif
+
+	return FALSE;
+}
+
 // ------------------------------------------------------------------------------------------------------------- //
 
 template class CHttpAgentT<CTcpAgent, HTTP_DEFAULT_PORT>;
@@ -41,7 +41,6 @@ public:
 	using __super::SendPackets;
 	using __super::HasStarted;
 	using __super::GetRemoteHost;
-	using __super::GetFreeSocketObjLockTime;
 	using __super::GetFreeSocketObjPool;
 	using __super::GetFreeSocketObjHold;
 
@@ -52,6 +51,7 @@ public:
 #ifdef _SSL_SUPPORT
 	using __super::StartSSLHandShake;
 	using __super::IsSSLAutoHandShake;
+	using __super::GetSSLSessionInfo;
 #endif
 
 protected:
@@ -64,6 +64,8 @@ public:
 	virtual BOOL SendRequest(CONNID dwConnID, LPCSTR lpszMethod, LPCSTR lpszPath, const THeader lpHeaders[] = nullptr, int iHeaderCount = 0, const BYTE* pBody = nullptr, int iLength = 0);
 	virtual BOOL SendLocalFile(CONNID dwConnID, LPCSTR lpszFileName, LPCSTR lpszMethod, LPCSTR lpszPath, const THeader lpHeaders[] = nullptr, int iHeaderCount = 0);
 	virtual BOOL SendChunkData(CONNID dwConnID, const BYTE* pData = nullptr, int iLength = 0, LPCSTR lpszExtensions = nullptr);
+	virtual BOOL SendStreamRequest(CONNID dwConnID, DWORD* lpdwStreamID, LPCSTR lpszMethod, LPCSTR lpszPath, const THeader lpHeaders[] = nullptr, int iHeaderCount = 0, const BYTE* pBody = nullptr, int iLength = 0);
+	virtual BOOL SendStreamChunkData(CONNID dwConnID, DWORD dwStreamID, const BYTE* pData = nullptr, int iLength = 0);
 
 	virtual BOOL SendPost(CONNID dwConnID, LPCSTR lpszPath, const THeader lpHeaders[], int iHeaderCount, const BYTE* pBody, int iLength)
 		{return SendRequest(dwConnID, HTTP_METHOD_POST, lpszPath, lpHeaders, iHeaderCount, pBody, iLength);}
@@ -92,10 +94,14 @@ public:
 	virtual void SetUseCookie(BOOL bUseCookie)					{ENSURE_HAS_STOPPED(); m_pCookieMgr		= bUseCookie ? &g_CookieMgr : nullptr;}
 	virtual void SetHttpAutoStart(BOOL bAutoStart)				{ENSURE_HAS_STOPPED(); m_bHttpAutoStart	= bAutoStart;}
 	virtual void SetLocalVersion(EnHttpVersion enLocalVersion)	{ENSURE_HAS_STOPPED(); m_enLocalVersion	= enLocalVersion;}
+	virtual void SetHttp2Support(BOOL bSupport)					{ENSURE_HAS_STOPPED(); m_bHttp2Support	= bSupport;}
+	virtual void SetHttp2MaxConcurrentStreams(DWORD dwMaxConcurrentStreams)	{ENSURE_HAS_STOPPED(); m_dwHttp2MaxConcurrentStreams = dwMaxConcurrentStreams;}
 
 	virtual BOOL IsUseCookie()									{return m_pCookieMgr != nullptr;}
 	virtual BOOL IsHttpAutoStart()								{return m_bHttpAutoStart;}
 	virtual EnHttpVersion GetLocalVersion()						{return m_enLocalVersion;}
+	virtual BOOL IsHttp2Support()								{return m_bHttp2Support;}
+	virtual DWORD GetHttp2MaxConcurrentStreams()				{return m_dwHttp2MaxConcurrentStreams;}
 
 	virtual BOOL IsUpgrade(CONNID dwConnID);
 	virtual BOOL IsKeepAlive(CONNID dwConnID);
@@ -116,12 +122,16 @@ public:
 	virtual BOOL GetAllCookies(CONNID dwConnID, TCookie lpCookies[], DWORD& dwCount);
 
 	virtual USHORT GetStatusCode(CONNID dwConnID);
+	virtual BOOL IsHttp2(CONNID dwConnID);
+	virtual DWORD GetStreamID(CONNID dwConnID);
+	virtual BOOL GetStreamHeader(CONNID dwConnID, DWORD dwStreamID, LPCSTR lpszName, LPSTR lpszValue, int& iValueLen);
 
 	virtual BOOL GetWSMessageState(CONNID dwConnID, BOOL* lpbFinal, BYTE* lpiReserved, BYTE* lpiOperationCode, LPCBYTE* lpszMask, ULONGLONG* lpullBodyLen, ULONGLONG* lpullBodyRemain);
 
 private:
 	BOOL StartHttp(TAgentSocketObj* pSocketObj);
 	void DoStartHttp(TAgentSocketObj* pSocketObj);
+	BOOL IsHttp2Negotiated(TAgentSocketObj* pSocketObj);
 
 private:
 	virtual BOOL CheckParams();
@@ -130,11 +140,15 @@ private:
 	virtual EnHandleResult DoFireConnect(TAgentSocketObj* pSocketObj);
 	virtual EnHandleResult DoFireHandShake(TAgentSocketObj* pSocketObj);
 	virtual EnHandleResult DoFireReceive(TAgentSocketObj* pSocketObj, const BYTE* pData, int iLength);
+	virtual EnHandleResult DoFireReceive(TAgentSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount)
+		{return __super::DoFireReceiveEach(pSocketObj, pBuffers, iCount);}
 	virtual EnHandleResult DoFireClose(TAgentSocketObj* pSocketObj, EnSocketOperation enOperation, int iErrorCode);
 	virtual EnHandleResult DoFireShutdown();
 
 	EnHandleResult DoFireSuperReceive(TAgentSocketObj* pSocketObj, const BYTE* pData, int iLength)
 		{return __super::DoFireReceive(pSocketObj, pData, iLength);}
+	BOOL SendHttp2Data(TAgentSocketObj* pSocketObj, const BYTE* pData, int iLength)
+		{WSABUF buffer = {(UINT)iLength, (LPBYTE)pData}; return SendPackets(pSocketObj->connID, &buffer, 1);}
 
 	EnHttpParseResult FireMessageBegin(TAgentSocketObj* pSocketObj)
 		{return m_pListener->OnMessageBegin((IHttpAgent*)this, pSocketObj->connID);}
@@ -179,6 +193,8 @@ public:
 	, m_pCookieMgr		(&g_CookieMgr)
 	, m_bHttpAutoStart	(TRUE)
 	, m_enLocalVersion	(DEFAULT_HTTP_VERSION)
+	, m_bHttp2Support	(FALSE)
+	, m_dwHttp2MaxConcurrentStreams(DEFAULT_HTTP2_MAX_CONCURRENT_STREAMS)
 	{
 
 	}
@@ -194,6 +210,8 @@ private:
 	EnHttpVersion		m_enLocalVersion;
 
 	BOOL				m_bHttpAutoStart;
+	BOOL				m_bHttp2Support;
+	DWORD				m_dwHttp2MaxConcurrentStreams;
 
 	CHttpObjPool		m_objPool;
 };
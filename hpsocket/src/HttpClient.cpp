@@ -40,6 +40,9 @@ template<class R, class T, USHORT default_port> BOOL CHttpClientT<R, T, default_
 {
 	USES_CONVERSION;
 
+	if(m_objHttp.IsHttp2())
+		return SendStreamRequest(nullptr, lpszMethod, lpszPath, lpHeaders, iHeaderCount, pBody, iLength);
+
 	WSABUF szBuffer[2];
 	CStringA strHeader;
 
@@ -82,8 +85,68 @@ template<class R, class T, USHORT default_port> BOOL CHttpClientT<R, T, default_
 	return SendRequest(lpszMethod, lpszPath, lpHeaders, iHeaderCount, (BYTE*)fmap, (int)fmap.Size());
 }
 
+template<class R, class T, USHORT default_port> BOOL CHttpClientT<R, T, default_port>::SendStreamRequest(DWORD* lpdwStreamID, LPCSTR lpszMethod, LPCSTR lpszPath, const THeader lpHeaders[], int iHeaderCount, const BYTE* pBody, int iLength)
+{
+	if(!m_objHttp.IsHttp2())
+	{
+		::SetLastError(ERROR_INVALID_STATE);
+		return FALSE;
+	}
+
+	LPCSTR lpszHost	= nullptr;
+	USHORT usPort	= 0;
+
+	GetRemoteHost(&lpszHost, &usPort);
+	if(usPort == default_port) usPort = 0;
+
+	CStringA strPath;
+	::AdjustRequestPath(FALSE, lpszPath, strPath);
+
+	TCookieMap cookies;
+	m_objHttp.LoadHttp2Cookies(strPath, cookies);
+
+	CHttp2FieldList fields;
+	fields.Add(HTTP2_HEADER_METHOD, CStringA(lpszMethod).MakeUpper());
+	fields.Add(HTTP2_HEADER_SCHEME, IsSecure() ? HTTP2_SCHEMA_HTTPS : HTTP2_SCHEMA_HTTP);
+	fields.Add(HTTP2_HEADER_PATH, strPath);
+
+	BOOL bChunked	= ::MakeHttp2HeaderFields(lpHeaders, iHeaderCount, &cookies, iLength, TRUE, lpszHost, usPort, fields);
+	BOOL bEndStream	= (iLength == 0 && !bChunked);
+
+	CHttp2Session& session	= m_objHttp.GetHttp2Session();
+	DWORD dwStreamID		= session.OpenStream(fields, bEndStream);
+
+	if(dwStreamID == 0)
+		return FALSE;
+
+	if(lpdwStreamID != nullptr)
+		*lpdwStreamID = dwStreamID;
+
+	if(iLength > 0)
+		return session.SendData(dwStreamID, pBody, iLength, !bChunked);
+
+	return TRUE;
+}
+
+template<class R, class T, USHORT default_port> BOOL CHttpClientT<R, T, default_port>::SendStreamChunkData(DWORD dwStreamID, const BYTE* pData, int iLength)
+{
+	if(!m_objHttp.IsHttp2())
+	{
+		::SetLastError(ERROR_INVALID_STATE);
+		return FALSE;
+	}
+
+	return m_objHttp.GetHttp2Session().SendData(dwStreamID, pData, iLength, iLength == 0);
+}
+
 template<class R, class T, USHORT default_port> BOOL CHttpClientT<R, T, default_port>::SendChunkData(const BYTE* pData, int iLength, LPCSTR lpszExtensions)
 {
+	if(m_objHttp.IsHttp2())
+	{
+		::SetLastError(ERROR_INVALID_OPERATION);
+		return FALSE;
+	}
+
 	char szLen[12];
 	WSABUF bufs[5];
 
@@ -151,6 +214,23 @@ template<class R, class T, USHORT default_port> BOOL CHttpClientT<R, T, default_
 	return TRUE;
 }
 
+template<class R, class T, USHORT default_port> BOOL CHttpClientT<R, T, default_port>::IsHttp2Negotiated()
+{
+	if(!m_bHttp2Support)
+		return FALSE;
+	if(!IsSecure())
+		return TRUE;
+
+#ifdef _SSL_SUPPORT
+	LPCSTR lpszProtocol = nullptr;
+
+	if(GetSSLSessionInfo(SSL_SSI_ALPN_PROTOCOL, (LPVOID*)&lpszProtocol) && lpszProtocol != nullptr)
+		return strcmp(lpszProtocol, HTTP2_ALPN_PROTOCOL) == 0;
+#endif
+
+	return FALSE;
+}
+
 // ------------------------------------------------------------------------------------------------------------- //
 
 template<class T, USHORT default_port> BOOL CHttpSyncClientT<T, default_port>::Start(LPCTSTR lpszRemoteAddress, USHORT usPort, BOOL bAsyncConnect, LPCTSTR lpszBindAddress, USHORT usLocalPort)
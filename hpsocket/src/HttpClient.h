@@ -46,6 +46,7 @@ public:
 #ifdef _SSL_SUPPORT
 	using __super::IsSSLAutoHandShake;
 	using __super::StartSSLHandShakeNoCheck;
+	using __super::GetSSLSessionInfo;
 #endif
 
 protected:
@@ -58,6 +59,8 @@ public:
 	virtual BOOL SendRequest(LPCSTR lpszMethod, LPCSTR lpszPath, const THeader lpHeaders[] = nullptr, int iHeaderCount = 0, const BYTE* pBody = nullptr, int iLength = 0);
 	virtual BOOL SendLocalFile(LPCSTR lpszFileName, LPCSTR lpszMethod, LPCSTR lpszPath, const THeader lpHeaders[] = nullptr, int iHeaderCount = 0);
 	virtual BOOL SendChunkData(const BYTE* pData = nullptr, int iLength = 0, LPCSTR lpszExtensions = nullptr);
+	virtual BOOL SendStreamRequest(DWORD* lpdwStreamID, LPCSTR lpszMethod, LPCSTR lpszPath, const THeader lpHeaders[] = nullptr, int iHeaderCount = 0, const BYTE* pBody = nullptr, int iLength = 0);
+	virtual BOOL SendStreamChunkData(DWORD dwStreamID, const BYTE* pData = nullptr, int iLength = 0);
 
 	virtual BOOL SendPost(LPCSTR lpszPath, const THeader lpHeaders[], int iHeaderCount, const BYTE* pBody, int iLength)
 		{return SendRequest(HTTP_METHOD_POST, lpszPath, lpHeaders, iHeaderCount, pBody, iLength);}
@@ -86,10 +89,14 @@ public:
 	virtual void SetUseCookie(BOOL bUseCookie)					{ENSURE_HAS_STOPPED(); m_pCookieMgr		= bUseCookie ? &g_CookieMgr : nullptr;}
 	virtual void SetHttpAutoStart(BOOL bAutoStart)				{ENSURE_HAS_STOPPED(); m_bHttpAutoStart	= bAutoStart;}
 	virtual void SetLocalVersion(EnHttpVersion enLocalVersion)	{ENSURE_HAS_STOPPED(); m_enLocalVersion	= enLocalVersion;}
+	virtual void SetHttp2Support(BOOL bSupport)					{ENSURE_HAS_STOPPED(); m_bHttp2Support	= bSupport;}
+	virtual void SetHttp2MaxConcurrentStreams(DWORD dwMaxConcurrentStreams)	{ENSURE_HAS_STOPPED(); m_dwHttp2MaxConcurrentStreams = dwMaxConcurrentStreams;}
 
 	virtual BOOL IsUseCookie()									{return m_pCookieMgr != nullptr;}
 	virtual BOOL IsHttpAutoStart()								{return m_bHttpAutoStart;}
 	virtual EnHttpVersion GetLocalVersion()						{return m_enLocalVersion;}
+	virtual BOOL IsHttp2Support()								{return m_bHttp2Support;}
+	virtual DWORD GetHttp2MaxConcurrentStreams()				{return m_dwHttp2MaxConcurrentStreams;}
 
 	virtual BOOL IsUpgrade()
 		{return m_objHttp.IsUpgrade();}
@@ -126,6 +133,12 @@ public:
 
 	virtual USHORT GetStatusCode()
 		{return m_objHttp.GetStatusCode();}
+	virtual BOOL IsHttp2()
+		{return m_objHttp.IsHttp2();}
+	virtual DWORD GetStreamID()
+		{return m_objHttp.GetStreamID();}
+	virtual BOOL GetStreamHeader(DWORD dwStreamID, LPCSTR lpszName, LPSTR lpszValue, int& iValueLen)
+		{return m_objHttp.GetStreamHeader(dwStreamID, lpszName, lpszValue, iValueLen);}
 
 	virtual BOOL GetWSMessageState(BOOL* lpbFinal, BYTE* lpiReserved, BYTE* lpiOperationCode, LPCBYTE* lpszMask, ULONGLONG* lpullBodyLen, ULONGLONG* lpullBodyRemain)
 		{return m_objHttp.GetWSMessageState(lpbFinal, lpiReserved, lpiOperationCode, lpszMask, lpullBodyLen, lpullBodyRemain);}
@@ -136,6 +149,8 @@ private:
 	void DoStartHttp()
 		{m_objHttp.SetValid(TRUE);}
 
+	BOOL IsHttp2Negotiated();
+
 	virtual EnHandleResult FireConnect()
 		{return m_bHttpAutoStart ? __super::FireConnect() : __super::DoFireConnect(this);}
 
@@ -151,11 +166,24 @@ private:
 		return result;
 	}
 
+	virtual EnHandleResult DoFireHandShake(ITcpClient* pSender)
+	{
+		ASSERT(pSender == this);
+
+		// HTTP/2 会话在 OnHandShake 事件之前启动，应用在 OnHandShake 事件中即可发送请求
+		if(m_objHttp.IsValid() && IsHttp2Negotiated() && !m_objHttp.StartHttp2())
+			return HR_ERROR;
+
+		return __super::DoFireHandShake(this);
+	}
+
 	virtual EnHandleResult DoFireReceive(ITcpClient* pSender, const BYTE* pData, int iLength)
 		{ASSERT(pSender == this); return m_objHttp.IsValid() ? m_objHttp.Execute(pData, iLength) : __super::DoFireReceive(pSender, pData, iLength);}
 
 	EnHandleResult DoFireSuperReceive(IHttpClient* pSender, const BYTE* pData, int iLength)
 		{ASSERT(pSender == (IHttpClient*)this); return __super::DoFireReceive(pSender, pData, iLength);}
+	BOOL SendHttp2Data(IHttpClient* pSender, const BYTE* pData, int iLength)
+		{WSABUF buffer = {(UINT)iLength, (LPBYTE)pData}; return SendPackets(&buffer, 1);}
 
 	virtual EnHandleResult DoFireClose(ITcpClient* pSender, EnSocketOperation enOperation, int iErrorCode)
 	{
@@ -213,6 +241,8 @@ public:
 	, m_pCookieMgr		(&g_CookieMgr)
 	, m_bHttpAutoStart	(TRUE)
 	, m_enLocalVersion	(DEFAULT_HTTP_VERSION)
+	, m_bHttp2Support	(FALSE)
+	, m_dwHttp2MaxConcurrentStreams(DEFAULT_HTTP2_MAX_CONCURRENT_STREAMS)
 	, m_objHttp			(FALSE, this, (IHttpClient*)this)
 	{
 
@@ -225,6 +255,8 @@ public:
 
 private:
 	BOOL					m_bHttpAutoStart;
+	BOOL					m_bHttp2Support;
+	DWORD					m_dwHttp2MaxConcurrentStreams;
 
 	IHttpClientListener*	m_pListener;
 	CCookieMgr*				m_pCookieMgr;
@@ -229,6 +229,95 @@ void MakeHeaderLines(const THeader lpHeaders[], int iHeaderCount, const TCookieM
 	strValue.Append(HTTP_CRLF);
 }
 
+BOOL MakeHttp2HeaderFields(const THeader lpHeaders[], int iHeaderCount, const TCookieMap* pCookies, int iBodyLength, BOOL bRequest, LPCSTR lpszDefaultHost, USHORT usPort, CHttp2FieldList& fields)
+{
+	static const LPCSTR s_lpszConnHeaders[] = {HTTP_HEADER_CONNECTION, HTTP_HEADER_UPGRADE, HTTP_HEADER_TRANSFER_ENCODING, "Keep-Alive", "Proxy-Connection"};
+
+	LPCSTR lpszHost	= nullptr;
+	BOOL bChunked	= FALSE;
+	BOOL bLength	= FALSE;
+
+	for(int i = 0; i < iHeaderCount; i++)
+	{
+		const THeader& header = lpHeaders[i];
+
+		if(::IsStrEmptyA(header.name))
+			continue;
+
+		if(stricmp(header.name, HTTP_HEADER_HOST) == 0)
+			lpszHost = header.value;
+		else if(stricmp(header.name, HTTP_HEADER_TRANSFER_ENCODING) == 0)
+			bChunked = TRUE;
+		else if(stricmp(header.name, HTTP_HEADER_CONTENT_LENGTH) == 0)
+			bLength = TRUE;
+	}
+
+	if(bRequest)
+	{
+		CStringA strHost;
+
+		if(lpszHost == nullptr && !::IsStrEmptyA(lpszDefaultHost))
+		{
+			strHost = lpszDefaultHost;
+			if(usPort != 0) strHost.AppendFormat(":%u", usPort);
+
+			lpszHost = strHost;
+		}
+
+		if(lpszHost != nullptr)
+			fields.Add(HTTP2_HEADER_AUTHORITY, lpszHost);
+	}
+
+	for(int i = 0; i < iHeaderCount; i++)
+	{
+		const THeader& header = lpHeaders[i];
+
+		if(::IsStrEmptyA(header.name) || (bRequest && stricmp(header.name, HTTP_HEADER_HOST) == 0))
+			continue;
+
+		BOOL bConnHeader = FALSE;
+
+		for(int j = 0; j < (int)_countof(s_lpszConnHeaders); j++)
+		{
+			if(stricmp(header.name, s_lpszConnHeaders[j]) == 0)
+			{
+				bConnHeader = TRUE;
+				break;
+			}
+		}
+
+		if(!bConnHeader)
+			fields.Add(header.name, header.value ? header.value : "");
+	}
+
+	if((!bRequest || iBodyLength > 0) && !bLength && !bChunked)
+	{
+		char szBodyLength[16];
+		itoa(iBodyLength, szBodyLength, 10);
+
+		fields.Add(HTTP2_HEADER_CONTENT_LENGTH, szBodyLength);
+	}
+
+	if(pCookies != nullptr && !pCookies->empty())
+	{
+		CStringA strCookie;
+
+		for(TCookieMapCI it = pCookies->begin(), end = pCookies->end(); it != end; ++it)
+		{
+			if(!strCookie.IsEmpty())
+				strCookie.Append(HTTP_COOKIE_SEPARATOR);
+
+			strCookie.Append(it->first);
+			strCookie.AppendChar(COOKIE_KV_SEP_CHAR);
+			strCookie.Append(it->second);
+		}
+
+		fields.Add("cookie", strCookie);
+	}
+
+	return bChunked;
+}
+
 void MakeHttpPacket(const CStringA& strHeader, const BYTE* pBody, int iLength, WSABUF szBuffer[2])
 {
 	ASSERT(pBody != nullptr || iLength == 0);
@@ -434,4 +523,422 @@ BOOL ParseUrl(const CStringA& strUrl, BOOL& bHttps, CStringA& strHost, USHORT& u
 	return TRUE;
 }
 
+// ------------------------------------------------------------------------------------------------------------- //
+
+struct TKnownHeader
+{
+	LPCSTR				name;
+	int					length;
+	UINT				hash;
+	EnHttpKnownHeader	known;
+};
+
+#define KNOWN_HEADER(name, known)	{name, (int)sizeof(name) - 1, CHttpHeaderStore::HashName(name, (int)sizeof(name) - 1), known}
+
+static constexpr TKnownHeader s_knownHeaders[] =
+{
+	KNOWN_HEADER(HTTP_HEADER_HOST,				HKH_HOST),
+	KNOWN_HEADER(HTTP_HEADER_COOKIE,			HKH_COOKIE),
+	KNOWN_HEADER(HTTP_HEADER_SET_COOKIE,		HKH_SET_COOKIE),
+	KNOWN_HEADER(HTTP_HEADER_CONTENT_TYPE,		HKH_CONTENT_TYPE),
+	KNOWN_HEADER(HTTP_HEADER_CONTENT_LENGTH,	HKH_CONTENT_LENGTH),
+	KNOWN_HEADER(HTTP_HEADER_CONTENT_ENCODING,	HKH_CONTENT_ENCODING),
+	KNOWN_HEADER(HTTP_HEADER_TRANSFER_ENCODING,	HKH_TRANSFER_ENCODING),
+	KNOWN_HEADER(HTTP_HEADER_CONNECTION,		HKH_CONNECTION),
+	KNOWN_HEADER(HTTP_HEADER_UPGRADE,			HKH_UPGRADE),
+};
+
+EnHttpKnownHeader CHttpHeaderStore::GetKnownHeader(LPCSTR lpszName, int iLength, UINT uiHash)
+{
+	for(int i = 0; i < (int)_countof(s_knownHeaders); i++)
+	{
+		const TKnownHeader& kh = s_knownHeaders[i];
+
+		if(kh.hash == uiHash && kh.length == iLength && strnicmp(kh.name, lpszName, iLength) == 0)
+			return kh.known;
+	}
+
+	return HKH_UNKNOWN;
+}
+
+void CHttpHeaderStore::Append(const char* at, int iLength)
+{
+	int iNeed = m_iLength + iLength + 1;
+
+	if(m_blocks.empty() || m_iStart + iNeed > m_blocks[m_iBlock].size)
+		NextBlock(iNeed);
+
+	if(iLength > 0)
+	{
+		memcpy(m_blocks[m_iBlock].data.get() + m_iStart + m_iLength, at, iLength);
+		m_iLength += iLength;
+	}
+}
+
+void CHttpHeaderStore::NextBlock(int iNeed)
+{
+	int iNext			= m_blocks.empty() ? 0 : m_iBlock + 1;
+	const char* pOpen	= m_blocks.empty() ? nullptr : m_blocks[m_iBlock].data.get() + m_iStart;
+
+	//后续字符串块（清空前分配）容量不足时插入新的字符串块
+	if(iNext >= (int)m_blocks.size() || m_blocks[iNext].size < iNeed)
+	{
+		TBlock block;
+
+		block.size = MAX(iNeed, HTTP_HEADER_BLOCK_SIZE);
+		block.data.reset(new char[block.size]);
+
+		m_blocks.insert(m_blocks.begin() + iNext, move(block));
+	}
+
+	//搬移未完成的字符串（字符串块的内存地址不随数组调整而改变）
+	if(m_iLength > 0)
+		memcpy(m_blocks[iNext].data.get(), pOpen, m_iLength);
+
+	m_iBlock = iNext;
+	m_iStart = 0;
+}
+
+LPCSTR CHttpHeaderStore::EndString(int& iLength)
+{
+	Append(nullptr, 0);
+
+	char* lpszStr		= m_blocks[m_iBlock].data.get() + m_iStart;
+	lpszStr[m_iLength]	= 0;
+	iLength				= m_iLength;
+
+	m_iStart		   += m_iLength + 1;
+	m_iLength			= 0;
+
+	return lpszStr;
+}
+
+void CHttpHeaderStore::EndName()
+{
+	m_lpszName		= EndString(m_iNameLen);
+	m_uiNameHash	= HashName(m_lpszName, m_iNameLen);
+}
+
+const THttpHeaderItem& CHttpHeaderStore::EndValue()
+{
+	if(m_items.capacity() == 0)
+		m_items.reserve(HTTP_HEADER_RESERVED_ITEMS);
+
+	//去除值末尾的空白（OWS，http_parser 不去除），与快速解析结果一致
+	if(m_iLength > 0)
+	{
+		const char* lpszValue = m_blocks[m_iBlock].data.get() + m_iStart;
+
+		while(m_iLength > 0 && (lpszValue[m_iLength - 1] == ' ' || lpszValue[m_iLength - 1] == '\t'))
+			--m_iLength;
+	}
+
+	THttpHeaderItem item;
+
+	item.name		= m_lpszName;
+	item.nameLen	= m_iNameLen;
+	item.hash		= m_uiNameHash;
+	item.known		= GetKnownHeader(m_lpszName, m_iNameLen, m_uiNameHash);
+	item.value		= EndString(item.valueLen);
+
+	m_items.push_back(item);
+
+	return m_items.back();
+}
+
+const THttpHeaderItem& CHttpHeaderStore::Add(LPCSTR lpszName, int iNameLen, LPCSTR lpszValue, int iValueLen)
+{
+	Append(lpszName, iNameLen);
+	EndName();
+	Append(lpszValue, iValueLen);
+
+	return EndValue();
+}
+
+const THttpHeaderItem* CHttpHeaderStore::Find(LPCSTR lpszName) const
+{
+	int iNameLen	= (int)strlen(lpszName);
+	int i			= FindNext(lpszName, iNameLen, HashName(lpszName, iNameLen), 0);
+
+	return (i >= 0) ? &m_items[i] : nullptr;
+}
+
+const THttpHeaderItem* CHttpHeaderStore::Find(EnHttpKnownHeader enKnown) const
+{
+	for(int i = 0, iSize = Size(); i < iSize; i++)
+	{
+		if(m_items[i].known == enKnown)
+			return &m_items[i];
+	}
+
+	return nullptr;
+}
+
+int CHttpHeaderStore::FindNext(LPCSTR lpszName, int iNameLen, UINT uiHash, int iStart) const
+{
+	for(int i = iStart, iSize = Size(); i < iSize; i++)
+	{
+		const THttpHeaderItem& item = m_items[i];
+
+		if(item.hash == uiHash && item.nameLen == iNameLen && strnicmp(item.name, lpszName, iNameLen) == 0)
+			return i;
+	}
+
+	return -1;
+}
+
+void CHttpHeaderStore::Clear()
+{
+	m_items.clear();
+
+	if(m_blocks.size() > HTTP_HEADER_CACHED_BLOCKS)
+		m_blocks.resize(HTTP_HEADER_CACHED_BLOCKS);
+
+	m_iBlock		= 0;
+	m_iStart		= 0;
+	m_iLength		= 0;
+	m_lpszName		= nullptr;
+	m_iNameLen		= 0;
+	m_uiNameHash	= 0;
+}
+
+void CHttpHeaderStore::CopyFrom(const CHttpHeaderStore& other)
+{
+	if(&other == this)
+		return;
+
+	Clear();
+
+	for(int i = 0, iSize = other.Size(); i < iSize; i++)
+	{
+		const THttpHeaderItem& item = other[i];
+		Add(item.name, item.nameLen, item.value, item.valueLen);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------------------- //
+
+void CHttpPipeline::SetKeepAlive(BOOL bKeepAlive)
+{
+	CCriSecLock locallock(m_cs);
+
+	if(!m_items.empty())
+		m_items.back().keepAlive = bKeepAlive;
+}
+
+BOOL CHttpPipeline::GetKeepAlive(DWORD dwSeq, BOOL& bKeepAlive)
+{
+	CCriSecLock locallock(m_cs);
+
+	TItem* pItem = GetItem(dwSeq);
+
+	if(pItem == nullptr || pItem->responded)
+		return FALSE;
+
+	bKeepAlive = pItem->keepAlive;
+
+	return TRUE;
+}
+
+BOOL CHttpPipeline::GetFirstPending(DWORD& dwSeq)
+{
+	CCriSecLock locallock(m_cs);
+
+	for(size_t i = 0; i < m_items.size(); i++)
+	{
+		if(!m_items[i].responded)
+		{
+			dwSeq = m_dwHeadSeq + (DWORD)i;
+			return TRUE;
+		}
+	}
+
+	return FALSE;
+}
+
+DWORD CHttpPipeline::GetCurrentSeq()
+{
+	CCriSecLock locallock(m_cs);
+
+	if(m_dwNextSeq == 0)
+		return HTTP_INVALID_REQUEST_SEQ;
+
+	return m_dwNextSeq - 1;
+}
+
+BOOL CHttpPipeline::IsPaused()
+{
+	CCriSecLock locallock(m_cs);
+
+	return m_bPaused;
+}
+
+void CHttpPipeline::Reset()
+{
+	CCriSecLock locallock(m_cs);
+
+	m_items.clear();
+
+	m_dwHeadSeq	= 0;
+	m_dwNextSeq	= 0;
+	m_bPaused	= FALSE;
+	m_bSending	= FALSE;
+	m_bBroken	= FALSE;
+}
+
+CHttpPipeline::TItem* CHttpPipeline::GetItem(DWORD dwSeq)
+{
+	DWORD dwIndex = dwSeq - m_dwHeadSeq;
+
+	if(dwIndex >= (DWORD)m_items.size())
+		return nullptr;
+
+	return &m_items[dwIndex];
+}
+
+void CHttpPipeline::PopFront()
+{
+	m_items.pop_front();
+	++m_dwHeadSeq;
+}
+
+// ------------------------------------------------------------------------------------------------------------- //
+
+#define HTTP_HEADER_PROXY_CONNECTION		"Proxy-Connection"
+#define HTTP_HEADER_NAME_IS(f, s)			((f).nameLen == (int)sizeof(s) - 1 && strnicmp((f).name, s, (f).nameLen) == 0)
+#define HTTP_HEADER_VALUE_IS(f, s)			((f).valueLen == (int)sizeof(s) - 1 && strnicmp((f).value, s, (f).valueLen) == 0)
+#define HTTP_IS_DIGIT(c)					((c) >= '0' && (c) <= '9')
+
+BOOL ParseHttpMethod(const char* p, int iLength, http_method& enMethod)
+{
+#define XX(num, name, string)											\
+	if(iLength == (int)sizeof(#string) - 1 && memcmp(p, #string, iLength) == 0)	\
+	{																	\
+		enMethod = HTTP_##name;											\
+		return TRUE;													\
+	}
+
+	HTTP_METHOD_MAP(XX)
+
+#undef XX
+
+	return FALSE;
+}
+
+/* 处理 http_parser 特殊对待的头部，不能按相同方式处理时返回 FALSE */
+static BOOL ParseHttpSpecialHeader(const THttpRequestHead::TField& field, THttpRequestHead& head)
+{
+	if(HTTP_HEADER_NAME_IS(field, HTTP_HEADER_CONTENT_LENGTH))
+	{
+		if((head.flags & F_CONTENTLENGTH) || field.valueLen == 0 || field.valueLen > 18)
+			return FALSE;
+
+		ULONGLONG ullLength = 0;
+
+		for(int i = 0; i < field.valueLen; i++)
+		{
+			if(!HTTP_IS_DIGIT(field.value[i]))
+				return FALSE;
+
+			ullLength = ullLength * 10 + (field.value[i] - '0');
+		}
+
+		head.flags		   |= F_CONTENTLENGTH;
+		head.contentLength	= ullLength;
+	}
+	else if(HTTP_HEADER_NAME_IS(field, HTTP_HEADER_CONNECTION) || HTTP_HEADER_NAME_IS(field, HTTP_HEADER_PROXY_CONNECTION))
+	{
+		if(HTTP_HEADER_VALUE_IS(field, HTTP_CONNECTION_KEEPALIVE_VALUE))
+			head.flags |= F_CONNECTION_KEEP_ALIVE;
+		else if(HTTP_HEADER_VALUE_IS(field, HTTP_CONNECTION_CLOSE_VALUE))
+			head.flags |= F_CONNECTION_CLOSE;
+		else
+			return FALSE;
+	}
+	else if(HTTP_HEADER_NAME_IS(field, HTTP_HEADER_TRANSFER_ENCODING) || HTTP_HEADER_NAME_IS(field, HTTP_HEADER_UPGRADE))
+		return FALSE;
+
+	return TRUE;
+}
+
+BOOL ParseHttpRequestHead(const char* pData, int iLength, THttpRequestHead& head)
+{
+	ASSERT(iLength >= 4 && memcmp(pData + iLength - 4, "\r\n\r\n", 4) == 0);
+
+	if(iLength > HTTP_MAX_HEADER_SIZE)
+		return FALSE;
+
+	const char* p	= pData;
+	const char* end	= pData + iLength;
+
+	// 请求行：METHOD SP URL SP HTTP/x.y CRLF
+	int i = CHttpScanner::FindTokenEnd(p, (int)(end - p));
+
+	if(i == 0 || p[i] != ' ' || !ParseHttpMethod(p, i, head.method) || head.method == HTTP_CONNECT)
+		return FALSE;
+
+	p += i + 1;
+	i  = CHttpScanner::FindUrlEnd(p, (int)(end - p));
+
+	if(i == 0 || p[i] != ' ' || ::http_parser_parse_url(p, i, 0, &head.urlFields) != 0)
+		return FALSE;
+
+	head.url	= p;
+	head.urlLen	= i;
+	p		   += i + 1;
+
+	if(end - p < 10 || memcmp(p, "HTTP/", 5) != 0 || !HTTP_IS_DIGIT(p[5]) || p[6] != '.' || !HTTP_IS_DIGIT(p[7]) || p[8] != '\r' || p[9] != '\n')
+		return FALSE;
+
+	head.major			= p[5] - '0';
+	head.minor			= p[7] - '0';
+	head.flags			= 0;
+	head.contentLength	= ULLONG_MAX;
+	head.headerCount	= 0;
+	p				   += 10;
+
+	// 头部行：NAME ":" OWS VALUE OWS CRLF
+	while(p[0] != '\r')
+	{
+		if(head.headerCount == HTTP_FAST_PARSE_MAX_HEADERS)
+			return FALSE;
+
+		THttpRequestHead::TField& field = head.headers[head.headerCount];
+
+		i = CHttpScanner::FindTokenEnd(p, (int)(end - p));
+
+		if(i == 0 || p[i] != ':')
+			return FALSE;
+
+		field.name		= p;
+		field.nameLen	= i;
+		p			   += i + 1;
+
+		while(*p == ' ' || *p == '\t')
+			++p;
+
+		i = CHttpScanner::FindValueEnd(p, (int)(end - p));
+
+		if(p[i] != '\r' || p[i + 1] != '\n')
+			return FALSE;
+
+		field.value		= p;
+		field.valueLen	= i;
+		p			   += i + 2;
+
+		//去除值末尾的空白（OWS）
+		while(field.valueLen > 0 && (field.value[field.valueLen - 1] == ' ' || field.value[field.valueLen - 1] == '\t'))
+			--field.valueLen;
+
+		if(p >= end || *p == ' ' || *p == '\t')
+			return FALSE;
+		if(!ParseHttpSpecialHeader(field, head))
+			return FALSE;
+
+		++head.headerCount;
+	}
+
+	return (p + 2 == end && p[1] == '\n');
+}
+
 #endif
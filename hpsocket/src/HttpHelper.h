@@ -29,6 +29,8 @@
 #ifdef _HTTP_SUPPORT
 
 #include "common/http/http_parser.h"
+#include "common/HttpScanner.h"
+#include "Http2Helper.h"
 
 /************************************************************************
 ƣHTTP ȫֳ
@@ -112,11 +114,6 @@ struct TDyingConnection
 
 };
 
-typedef unordered_multimap<CStringA, CStringA,
-		cstringa_nc_hash_func::hash, cstringa_nc_hash_func::equal_to>	THeaderMap;
-typedef THeaderMap::const_iterator										THeaderMapCI;
-typedef THeaderMap::iterator											THeaderMapI;
-
 typedef unordered_map<CStringA, CStringA,
 		cstringa_hash_func::hash, cstringa_hash_func::equal_to>			TCookieMap;
 typedef TCookieMap::const_iterator										TCookieMapCI;
@@ -124,6 +121,367 @@ typedef TCookieMap::iterator											TCookieMapI;
 
 // ------------------------------------------------------------------------------------------------------------- //
 
+/* ͷ洢ַĬϴС */
+#define HTTP_HEADER_BLOCK_SIZE				2048
+/* ͷ洢ַַʱͷţ */
+#define HTTP_HEADER_CACHED_BLOCKS			4
+/* ͷ洢Ԥͷ */
+#define HTTP_HEADER_RESERVED_ITEMS			24
+
+/*  HTTP ͷƹϣֵԤȼ㣬ͷʱʶڲŲ */
+enum EnHttpKnownHeader
+{
+	HKH_UNKNOWN				= 0,
+	HKH_HOST				= 1,
+	HKH_COOKIE				= 2,
+	HKH_SET_COOKIE			= 3,
+	HKH_CONTENT_TYPE		= 4,
+	HKH_CONTENT_LENGTH		= 5,
+	HKH_CONTENT_ENCODING	= 6,
+	HKH_TRANSFER_ENCODING	= 7,
+	HKH_CONNECTION			= 8,
+	HKH_UPGRADE				= 9,
+};
+
+/* HTTP ͷƺֵָͷ洢ַ飬ͷ洢ǰЧ */
+struct THttpHeaderItem
+{
+	LPCSTR				name;
+	LPCSTR				value;
+	int					nameLen;
+	int					valueLen;
+	UINT				hash;
+	EnHttpKnownHeader	known;
+};
+
+/************************************************************************
+ƣHTTP ͷ洢
+ͷ˳򱣴Уͷͨ 20 ȱȽԤȼƹϣֵ˳Ƚϣ
+	  ƺֵƬֱ׷ӵɸõַУֻеǰַʣռ䲻ʱŰδɵַ
+	  Ƶһַ飻ɵֲַַ䣬պַ鼰ͷĿռ䱻
+************************************************************************/
+class CHttpHeaderStore
+{
+public:
+	/* ׷ӵǰͷƻֵƬ */
+	void Append(const char* at, int iLength);
+	/* ǰͷ */
+	void EndName();
+	/* ǰͷֵȥĩβհףͷ */
+	const THttpHeaderItem& EndValue();
+	/* ͷ */
+	const THttpHeaderItem& Add(LPCSTR lpszName, int iNameLen, LPCSTR lpszValue, int iValueLen);
+
+	const THttpHeaderItem* Find(LPCSTR lpszName) const;
+	const THttpHeaderItem* Find(EnHttpKnownHeader enKnown) const;
+	/*  iStart λÿʼͬͷͷλãҲ -1 */
+	int FindNext(LPCSTR lpszName, int iNameLen, UINT uiHash, int iStart) const;
+
+	void Clear();
+	void CopyFrom(const CHttpHeaderStore& other);
+
+	int Size()									const	{return (int)m_items.size();}
+	const THttpHeaderItem& operator[] (int i)	const	{return m_items[i];}
+
+	/* ƹϣֵFNV-1aִСд */
+	static constexpr UINT HashName(LPCSTR lpszName, int iLength)
+	{
+		UINT uiHash = 2166136261U;
+
+		for(int i = 0; i < iLength; i++)
+		{
+			char c = lpszName[i];
+
+			if(c >= 'A' && c <= 'Z')
+				c += 'a' - 'A';
+
+			uiHash = (uiHash ^ (BYTE)c) * 16777619U;
+		}
+
+		return uiHash;
+	}
+
+	static EnHttpKnownHeader GetKnownHeader(LPCSTR lpszName, int iLength, UINT uiHash);
+
+private:
+	LPCSTR EndString(int& iLength);
+	void NextBlock(int iNeed);
+
+public:
+	CHttpHeaderStore()
+	: m_iBlock		(0)
+	, m_iStart		(0)
+	, m_iLength		(0)
+	, m_lpszName	(nullptr)
+	, m_iNameLen	(0)
+	, m_uiNameHash	(0)
+	{
+
+	}
+
+	DECLARE_NO_COPY_CLASS(CHttpHeaderStore)
+
+private:
+	struct TBlock
+	{
+		unique_ptr<char[]>	data;
+		int					size;
+	};
+
+	vector<TBlock>			m_blocks;
+	int						m_iBlock;
+	int						m_iStart;
+	int						m_iLength;
+
+	LPCSTR					m_lpszName;
+	int						m_iNameLen;
+	UINT					m_uiNameHash;
+
+	vector<THttpHeaderItem>	m_items;
+};
+
+// ------------------------------------------------------------------------------------------------------------- //
+
+/* ٽֵ֧ͷʱ http_parser  */
+#define HTTP_FAST_PARSE_MAX_HEADERS			64
+
+/* ٽ HTTP ͷURLͷƺֵָͷ */
+struct THttpRequestHead
+{
+	struct TField
+	{
+		LPCSTR	name;
+		LPCSTR	value;
+		int		nameLen;
+		int		valueLen;
+	};
+
+	http_method		method;
+	LPCSTR			url;
+	int				urlLen;
+	http_parser_url	urlFields;
+	USHORT			major;
+	USHORT			minor;
+	UINT			flags;
+	ULONGLONG		contentLength;
+	int				headerCount;
+	TField			headers[HTTP_FAST_PARSE_MAX_HEADERS];
+};
+
+/*
+* ٽ "\r\n\r\n"  HTTP ͷʹ CHttpScanner ҷַֽ
+* ֻܹ淶ʽ CONNECT Upgrade / Transfer-Encoding ͷ۵Ƿظ Content-Length 
+* Ҫ http_parser ʱ FALSEͷֵȥβհףOWS
+*/
+extern BOOL ParseHttpRequestHead(const char* pData, int iLength, THttpRequestHead& head);
+/* 󷽷ƣִСд */
+extern BOOL ParseHttpMethod(const char* p, int iLength, http_method& enMethod);
+
+// ------------------------------------------------------------------------------------------------------------- //
+
+/************************************************************************
+ƣHTTP ߻Ӧ
+ϵ󰴽˳ţӦ˳ͣĳӦֻڴǰӦ
+	  ѷͺŷͣǰύӦƵеȴδӦﵽʱͣգʱָ
+************************************************************************/
+class CHttpPipeline
+{
+private:
+	struct TItem
+	{
+		BOOL		keepAlive;
+		BOOL		responded;
+		CBufferPtr	response;
+	};
+
+public:
+	/* ʼ󣺷ţδӦﵽ dwMaxPending ʱ fnPause(TRUE)ã */
+	template<typename _Pause> DWORD BeginRequest(DWORD dwMaxPending, _Pause&& fnPause)
+	{
+		DWORD dwSeq;
+		BOOL bPause = FALSE;
+
+		{
+			CCriSecLock locallock(m_cs);
+
+			m_items.emplace_back();
+
+			TItem& item		= m_items.back();
+			item.keepAlive	= TRUE;
+			item.responded	= FALSE;
+
+			if(!m_bPaused && (DWORD)m_items.size() >= dwMaxPending)
+			{
+				m_bPaused	= TRUE;
+				bPause		= TRUE;
+			}
+
+			dwSeq = m_dwNextSeq++;
+		}
+
+		if(bPause)
+			SyncPause(fnPause);
+
+		return dwSeq;
+	}
+
+	/*
+	* ύ dwSeq Ӧ˳Կɷ͵Ӧ fnSend(const WSABUF pBuffers[], int iCount)
+	* δӦ dwMaxPending ʱ fnPause(FALSE)󲻴ڻύӦʱ FALSE
+	* fnSend() ʧʱնеȫѻӦ FALSEӦϿӣ˺ύӦʧ
+	*
+	* ͬһʱֻһ̷߳ӦfnSend()  fnPause() ã
+	* ߳ύӦȻ浽Уɷ̴߳Ӷȡ˳
+	*/
+	template<typename _Send, typename _Pause> BOOL Submit(DWORD dwSeq, const WSABUF pBuffers[], int iCount, DWORD dwMaxPending, _Send&& fnSend, _Pause&& fnPause)
+	{
+		{
+			CCriSecLock locallock(m_cs);
+
+			if(m_bBroken)
+			{
+				::SetLastError(ERROR_INVALID_STATE);
+				return FALSE;
+			}
+
+			TItem* pItem = GetItem(dwSeq);
+
+			if(pItem == nullptr || pItem->responded)
+			{
+				::SetLastError(ERROR_INVALID_PARAMETER);
+				return FALSE;
+			}
+
+			pItem->responded = TRUE;
+
+			if(dwSeq != m_dwHeadSeq || m_bSending)
+			{
+				for(int i = 0; i < iCount; i++)
+				{
+					if(pBuffers[i].len > 0)
+						pItem->response.Cat(pBuffers[i].buf, pBuffers[i].len);
+				}
+
+				return TRUE;
+			}
+
+			m_bSending = TRUE;
+			PopFront();
+		}
+
+		BOOL isOK	  = fnSend(pBuffers, iCount);
+		BOOL bUnpause = FALSE;
+
+		while(TRUE)
+		{
+			CBufferPtr response;
+
+			{
+				CCriSecLock locallock(m_cs);
+
+				if(!isOK)
+				{
+					m_items.clear();
+
+					m_dwHeadSeq	= m_dwNextSeq;
+					m_bSending	= FALSE;
+					m_bBroken	= TRUE;
+
+					break;
+				}
+
+				if(m_items.empty() || !m_items.front().responded)
+				{
+					m_bSending = FALSE;
+
+					if(m_bPaused && (DWORD)m_items.size() < dwMaxPending)
+					{
+						m_bPaused = FALSE;
+						bUnpause  = TRUE;
+					}
+
+					break;
+				}
+
+				response.Swap(m_items.front().response);
+				PopFront();
+			}
+
+			WSABUF buffer;
+			buffer.buf = response.Ptr();
+			buffer.len = (UINT)response.Size();
+
+			isOK = fnSend(&buffer, 1);
+		}
+
+		if(bUnpause)
+			SyncPause(fnPause);
+
+		return isOK;
+	}
+
+	/* ʼǷ񱣳 */
+	void SetKeepAlive(BOOL bKeepAlive);
+	/* ȡ dwSeq Ƿ񱣳ӣ󲻴ڻύӦʱ FALSE */
+	BOOL GetKeepAlive(DWORD dwSeq, BOOL& bKeepAlive);
+	/* ȡδύӦţûδύӦʱ FALSE */
+	BOOL GetFirstPending(DWORD& dwSeq);
+	/* ȡʼţûпʼκʱ HTTP_INVALID_REQUEST_SEQ */
+	DWORD GetCurrentSeq();
+	/* δӦǷѴﵽޣʱӦֹͣ */
+	BOOL IsPaused();
+
+	void Reset();
+
+private:
+	TItem* GetItem(DWORD dwSeq);
+	void PopFront();
+
+	/* ǰͣ״̬ fnPause() m_csPause деã֤һε m_bPaused һ */
+	template<typename _Pause> void SyncPause(_Pause&& fnPause)
+	{
+		CCriSecLock locallock(m_csPause);
+
+		BOOL bPaused;
+
+		{
+			CCriSecLock locallock2(m_cs);
+			bPaused = m_bPaused;
+		}
+
+		fnPause(bPaused);
+	}
+
+public:
+	CHttpPipeline()
+	: m_dwHeadSeq	(0)
+	, m_dwNextSeq	(0)
+	, m_bPaused		(FALSE)
+	, m_bSending	(FALSE)
+	, m_bBroken		(FALSE)
+	{
+
+	}
+
+	DECLARE_NO_COPY_CLASS(CHttpPipeline)
+
+private:
+	CCriSec			m_cs;
+	CCriSec			m_csPause;
+	deque<TItem>	m_items;
+
+	/* ͷ */
+	DWORD			m_dwHeadSeq;
+	DWORD			m_dwNextSeq;
+	BOOL			m_bPaused;
+	/* Ƿ߳ڷӦ */
+	BOOL			m_bSending;
+	/* ӦʧܺٽµӦ */
+	BOOL			m_bBroken;
+};
+
+// ------------------------------------------------------------------------------------------------------------- //
+
 struct TBaseWSHeader
 {
 public:
@@ -369,6 +727,63 @@ private:
 	ULONGLONG m_ullBodyRemain;
 };
 
+/* HTTP/2 Ľṹ HTTP/2 Ự¼ת Http  */
+template<class T> struct TH2Context : public IHttp2SessionHandler
+{
+public:
+	virtual BOOL OnHttp2Send(const BYTE* pData, int iLength)
+		{return m_pHttpObj->on_h2_send(pData, iLength);}
+	virtual EnHttpParseResult OnHttp2Headers(DWORD dwStreamID, const CHttp2FieldList& fields, LPCSTR lpszMethod, LPCSTR lpszPath, BOOL bEndStream, BOOL bTrailer)
+		{TEventScope scope(this); return m_pHttpObj->on_h2_headers(dwStreamID, fields, lpszMethod, lpszPath, bEndStream, bTrailer);}
+	virtual EnHttpParseResult OnHttp2Data(DWORD dwStreamID, const BYTE* pData, int iLength, BOOL bEndStream)
+		{TEventScope scope(this); return m_pHttpObj->on_h2_data(dwStreamID, pData, iLength, bEndStream);}
+	virtual void OnHttp2StreamReset(DWORD dwStreamID, DWORD dwErrorCode)
+		{TEventScope scope(this); m_pHttpObj->on_h2_reset(dwStreamID, dwErrorCode);}
+
+	CHttp2Session& GetSession()	{return m_session;}
+	/* 鵱ǰ߳Ƿִ¼ص */
+	BOOL IsInStreamEvent()		{return m_tidEvent != 0 && ::IsSelfThread(m_tidEvent);}
+
+private:
+	struct TEventScope
+	{
+		TEventScope(TH2Context* pContext) : m_pContext(pContext)	{m_pContext->m_tidEvent = SELF_THREAD_ID;}
+		~TEventScope()												{m_pContext->m_tidEvent = 0;}
+
+		TH2Context* m_pContext;
+	};
+
+public:
+	TH2Context(T* pHttpObj) : m_pHttpObj(pHttpObj), m_tidEvent(0)
+	{
+
+	}
+
+private:
+	T* m_pHttpObj;
+	CHttp2Session m_session;
+
+	volatile THR_ID m_tidEvent;
+};
+
+// ------------------------------------------------------------------------------------------------------------- //
+
+extern CStringA& GetHttpVersionStr(EnHttpVersion enVersion, CStringA& strResult);
+extern CStringA& AdjustRequestPath(BOOL bConnect, LPCSTR lpszPath, CStringA& strPath);
+extern LPCSTR GetHttpDefaultStatusCodeDesc(EnHttpStatusCode enCode);
+extern void MakeRequestLine(LPCSTR lpszMethod, LPCSTR lpszPath, EnHttpVersion enVersion, CStringA& strValue);
+extern void MakeStatusLine(EnHttpVersion enVersion, USHORT usStatusCode, LPCSTR lpszDesc, CStringA& strValue);
+extern void MakeHeaderLines(const THeader lpHeaders[], int iHeaderCount, const TCookieMap* pCookies, int iBodyLength, BOOL bRequest, int iConnFlag, LPCSTR lpszDefaultHost, USHORT usPort, CStringA& strValue);
+extern void MakeHttpPacket(const CStringA& strHeader, const BYTE* pBody, int iLength, WSABUF szBuffer[2]);
+extern int MakeChunkPackage(const BYTE* pData, int iLength, LPCSTR lpszExtensions, char szLen[12], WSABUF bufs[5]);
+extern BOOL MakeWSPacket(BOOL bFinal, BYTE iReserved, BYTE iOperationCode, const BYTE lpszMask[4], BYTE* pData, int iLength, ULONGLONG ullBodyLen, BYTE szHeader[HTTP_MAX_WS_HEADER_LEN], WSABUF szBuffer[2]);
+extern BOOL ParseUrl(const CStringA& strUrl, BOOL& bHttps, CStringA& strHost, USHORT& usPort, CStringA& strPath);
+/*
+*  HTTP/2 ͷֶΣαͷֶ֮׷ӣȥصͷ Host ͷתΪ :authority αͷ
+* Cookie ϲΪһֶΣǷ Transfer-Encoding ͷϢͨ SendStreamChunkData() ͣ
+*/
+extern BOOL MakeHttp2HeaderFields(const THeader lpHeaders[], int iHeaderCount, const TCookieMap* pCookies, int iBodyLength, BOOL bRequest, LPCSTR lpszDefaultHost, USHORT usPort, CHttp2FieldList& fields);
+
 // ------------------------------------------------------------------------------------------------------------- //
 
 /* Http Ľṹ */
@@ -379,6 +794,13 @@ public:
 	{
 		ASSERT(pData != nullptr && iLength > 0);
 
+		if(m_parser.http_errno == HPE_PAUSED)
+			return HoldData(pData, iLength);
+		if(m_ph2Context)
+			return ExecuteHttp2(pData, iLength);
+		if(m_iPrefaceMatched >= 0)
+			return DetectHttp2(pData, iLength);
+
 		if(m_parser.upgrade)
 		{
 			if(m_enUpgrade == HUT_WEB_SOCKET)
@@ -387,20 +809,27 @@ public:
 				return m_pContext->DoFireSuperReceive(m_pSocket, pData, iLength);
 		}
 
-		EnHandleResult hr = HR_OK;
-		int iPased		  = (int)::http_parser_execute(&m_parser, &sm_settings, (LPCSTR)pData, iLength);
+		if(m_bFastParse)
+			return ExecuteFast(pData, iLength);
 
-		if(m_parser.upgrade)
-			hr = Upgrade(pData, iLength, iPased);
-		else if(m_parser.http_errno != HPE_OK)
-		{
-			m_pContext->FireParseError(m_pSocket, m_parser.http_errno, ::http_errno_description(HTTP_PARSER_ERRNO(&m_parser)));
-			hr = HR_ERROR;
-		}
-		else
-			ASSERT(iPased == iLength);
+		return ExecuteParser(pData, iLength);
+	}
 
-		return hr;
+	/* ָͣĽͣڼݴ */
+	EnHandleResult ExecuteHeld()
+	{
+		if(m_parser.http_errno != HPE_PAUSED)
+			return HR_OK;
+
+		::http_parser_pause(&m_parser, 0);
+
+		if(m_bufHeld.Size() == 0)
+			return HR_OK;
+
+		CBufferPtr buffer;
+		buffer.Swap(m_bufHeld);
+
+		return Execute(buffer.Ptr(), (int)buffer.Size());
 	}
 
 	void CheckBodyIdentityEof()
@@ -459,13 +888,12 @@ public:
 		EnHttpParseResult hpr	= HPR_OK;
 		THttpObjT* pSelf		= Self(p);
 
-		pSelf->AppendBuffer(at, length);
+		pSelf->m_headers.Append(at, (int)length);
 
 		if(p->state != s_header_value_discard_ws)
 			return hpr;
 
-		pSelf->m_strCurHeader = pSelf->GetBuffer();
-		pSelf->ResetBuffer();
+		pSelf->m_headers.EndName();
 
 		return hpr;
 	}
@@ -475,25 +903,12 @@ public:
 		EnHttpParseResult hpr	= HPR_OK;
 		THttpObjT* pSelf		= Self(p);
 
-		pSelf->AppendBuffer(at, length);
+		pSelf->m_headers.Append(at, (int)length);
 
 		if(p->state != s_header_almost_done && p->state != s_header_field_start)
 			return hpr;
 
-		pSelf->m_headers.emplace(move(THeaderMap::value_type(pSelf->m_strCurHeader, pSelf->GetBuffer())));
-		hpr = pSelf->m_pContext->FireHeader(pSelf->m_pSocket, pSelf->m_strCurHeader, pSelf->GetBuffer());
-
-		if(hpr != HPR_ERROR)
-		{
-			if(pSelf->m_bRequest && pSelf->m_strCurHeader == HTTP_HEADER_COOKIE)
-				hpr = pSelf->ParseCookie();
-			else if(!pSelf->m_bRequest && pSelf->m_strCurHeader == HTTP_HEADER_SET_COOKIE)
-				hpr = pSelf->ParseSetCookie();
-		}
-
-		pSelf->ResetBuffer();
-
-		return hpr;
+		return pSelf->FireHeaderItem(pSelf->m_headers.EndValue());
 	}
 
 	static int on_headers_complete(http_parser* p)
@@ -543,6 +958,10 @@ public:
 		THttpObjT* pSelf		= Self(p);
 		EnHttpParseResult hpr	= pSelf->m_pContext->FireMessageComplete(pSelf->m_pSocket);
 
+		// δӦĹ߻ﵽޣ߽ͣݴ浽ָպٽ
+		if(hpr == HPR_OK && pSelf->m_bRequest && !p->upgrade && pSelf->m_pipeline.IsPaused())
+			::http_parser_pause(p, 1);
+
 		return hpr;
 	}
 
@@ -561,8 +980,389 @@ public:
 		return m_pContext->FireWSMessageComplete(m_pSocket);
 	}
 
+	BOOL on_h2_send(const BYTE* pData, int iLength)
+	{
+		return m_pContext->SendHttp2Data(m_pSocket, pData, iLength);
+	}
+
+	/* HTTP/2 ͷ鰴 http_parser ˳򴥷¼ͷʷһͷ */
+	EnHttpParseResult on_h2_headers(DWORD dwStreamID, const CHttp2FieldList& fields, LPCSTR lpszMethod, LPCSTR lpszPath, BOOL bEndStream, BOOL bTrailer)
+	{
+		m_dwStreamID = dwStreamID;
+
+		if(bTrailer)
+		{
+			if(FireHttp2Fields(fields) != HPR_OK)
+				return HPR_ERROR;
+
+			return m_pContext->FireMessageComplete(m_pSocket) == HPR_OK ? HPR_OK : HPR_ERROR;
+		}
+
+		int iPseudo = fields.Find(m_bRequest ? HTTP2_HEADER_PATH : HTTP2_HEADER_STATUS);
+		int iMethod = m_bRequest ? fields.Find(HTTP2_HEADER_METHOD) : -1;
+
+		http_method enMethod = HTTP_GET;
+
+		if(iPseudo < 0 || (m_bRequest && (iMethod < 0 || !::ParseHttpMethod(fields.GetValue(iMethod), fields.GetValueLen(iMethod), enMethod) || enMethod == HTTP_CONNECT)))
+		{
+			m_ph2Context->GetSession().ResetStream(dwStreamID, H2EC_PROTOCOL_ERROR);
+			return HPR_SKIP_BODY;
+		}
+
+		ResetHeaderState(FALSE, FALSE);
+
+		m_parser.flags			= 0;
+		m_parser.upgrade		= 0;
+		m_parser.content_length	= ULLONG_MAX;
+
+		if(m_bRequest)
+			m_parser.method = enMethod;
+		else
+			SetRequestPath(lpszMethod, lpszPath);
+
+		if(m_pContext->FireMessageBegin(m_pSocket) != HPR_OK)
+			return HPR_ERROR;
+
+		EnHttpParseResult hpr = HPR_OK;
+
+		if(m_bRequest)
+		{
+			AppendBuffer(fields.GetValue(iPseudo), fields.GetValueLen(iPseudo));
+
+			hpr = ParseUrl();
+
+			if(hpr == HPR_OK)
+				hpr = m_pContext->FireRequestLine(m_pSocket, ::http_method_str(enMethod), GetBuffer());
+
+			ResetBuffer();
+		}
+		else
+		{
+			m_parser.status_code = (USHORT)atoi(fields.GetValue(iPseudo));
+			hpr = m_pContext->FireStatusLine(m_pSocket, m_parser.status_code, ::GetHttpDefaultStatusCodeDesc((EnHttpStatusCode)m_parser.status_code));
+		}
+
+		if(hpr != HPR_OK || FireHttp2Fields(fields) != HPR_OK)
+			return HPR_ERROR;
+
+		int iAuthority = m_bRequest ? fields.Find(HTTP2_HEADER_AUTHORITY) : -1;
+
+		if(iAuthority >= 0 && m_headers.Find(HKH_HOST) == nullptr)
+		{
+			if(FireHeaderItem(m_headers.Add(HTTP_HEADER_HOST, (int)strlen(HTTP_HEADER_HOST), fields.GetValue(iAuthority), fields.GetValueLen(iAuthority))) != HPR_OK)
+				return HPR_ERROR;
+		}
+
+		int iLength = fields.Find(HTTP2_HEADER_CONTENT_LENGTH);
+
+		if(iLength >= 0)
+			m_parser.content_length = strtoull(fields.GetValue(iLength), nullptr, 10);
+		else if(bEndStream)
+			m_parser.content_length = 0;
+
+		hpr = (EnHttpParseResult)on_headers_complete(&m_parser);
+
+		if(hpr != HPR_OK && hpr != HPR_SKIP_BODY)
+			return HPR_ERROR;
+
+		if(bEndStream || hpr == HPR_SKIP_BODY)
+		{
+			if(m_pContext->FireMessageComplete(m_pSocket) != HPR_OK)
+				return HPR_ERROR;
+		}
+
+		return hpr;
+	}
+
+	EnHttpParseResult on_h2_data(DWORD dwStreamID, const BYTE* pData, int iLength, BOOL bEndStream)
+	{
+		m_dwStreamID = dwStreamID;
+
+		if(iLength > 0 && m_pContext->FireBody(m_pSocket, pData, iLength) != HPR_OK)
+			return HPR_ERROR;
+
+		if(bEndStream && m_pContext->FireMessageComplete(m_pSocket) != HPR_OK)
+			return HPR_ERROR;
+
+		return HPR_OK;
+	}
+
+	/* ʱ OnParseError ¼Ϊ HTTP/2 룩Ӽ */
+	void on_h2_reset(DWORD dwStreamID, DWORD dwErrorCode)
+	{
+		m_dwStreamID = dwStreamID;
+
+		m_pContext->FireParseError(m_pSocket, (int)dwErrorCode, "HTTP/2 stream reset");
+	}
+
 private:
 
+	EnHandleResult ExecuteHttp2(const BYTE* pData, int iLength)
+	{
+		CHttp2Session& session = m_ph2Context->GetSession();
+
+		if(session.Receive(pData, iLength))
+			return HR_OK;
+
+		m_pContext->FireParseError(m_pSocket, (int)session.GetErrorCode(), session.GetErrorDesc());
+
+		return HR_ERROR;
+	}
+
+	/*
+	*  HTTP/2 ǰԣˣǰƥʱ HTTP/2 Ự
+	* ƥĲֺ͵ǰݽ HTTP/1.x 
+	*/
+	EnHandleResult DetectHttp2(const BYTE* pData, int iLength)
+	{
+		int iMatched		= m_iPrefaceMatched;
+		m_iPrefaceMatched	= -1;
+
+		if(!m_bRequest || !m_pContext->IsHttp2Support())
+			return Execute(pData, iLength);
+
+		int iCompare = MIN(iLength, HTTP2_PREFACE_LEN - iMatched);
+
+		if(memcmp(pData, HTTP2_PREFACE + iMatched, iCompare) != 0)
+		{
+			if(iMatched > 0)
+			{
+				EnHandleResult hr = Execute((const BYTE*)HTTP2_PREFACE, iMatched);
+
+				if(hr != HR_OK)
+					return hr;
+			}
+
+			return Execute(pData, iLength);
+		}
+
+		if(iMatched + iCompare < HTTP2_PREFACE_LEN)
+		{
+			m_iPrefaceMatched = iMatched + iCompare;
+			return HR_OK;
+		}
+
+		if(!StartHttp2())
+			return HR_ERROR;
+
+		EnHandleResult hr = ExecuteHttp2((const BYTE*)HTTP2_PREFACE, HTTP2_PREFACE_LEN);
+
+		if(hr == HR_OK && iCompare < iLength)
+			hr = ExecuteHttp2(pData + iCompare, iLength - iCompare);
+
+		return hr;
+	}
+
+	EnHttpParseResult FireHttp2Fields(const CHttp2FieldList& fields)
+	{
+		for(int i = 0; i < fields.Size(); i++)
+		{
+			if(fields.GetName(i)[0] == ':')
+				continue;
+
+			if(FireHeaderItem(m_headers.Add(fields.GetName(i), fields.GetNameLen(i), fields.GetValue(i), fields.GetValueLen(i))) != HPR_OK)
+				return HPR_ERROR;
+		}
+
+		return HPR_OK;
+	}
+
+	EnHandleResult ExecuteParser(const BYTE* pData, int iLength)
+	{
+		EnHandleResult hr = HR_OK;
+		int iPased		  = (int)::http_parser_execute(&m_parser, &sm_settings, (LPCSTR)pData, iLength);
+
+		if(m_parser.upgrade)
+			hr = Upgrade(pData, iLength, iPased);
+		else if(m_parser.http_errno == HPE_PAUSED)
+			hr = HoldData(pData + iPased, iLength - iPased);
+		else if(m_parser.http_errno != HPE_OK)
+			hr = RaiseParseError();
+		else
+			ASSERT(iPased == iLength);
+
+		return hr;
+	}
+
+	/* ͣڼݴδ */
+	EnHandleResult HoldData(const BYTE* pData, int iLength)
+	{
+		if(iLength > 0)
+			m_bufHeld.Cat(pData, iLength);
+
+		return HR_OK;
+	}
+
+	/*
+	* ٽͷ ParseHttpRequestHead()  http_parser ˳򴥷¼
+	* Content-Length 彻Ӧ״̬ http_parser  http_parser 
+	*/
+	EnHandleResult ExecuteFast(const BYTE* pData, int iLength)
+	{
+		EnHandleResult hr = HR_OK;
+
+		while(iLength > 0 && hr == HR_OK)
+		{
+			if(m_parser.upgrade)
+				return Execute(pData, iLength);
+
+			int iPased = iLength;
+
+			if(m_parser.http_errno == HPE_PAUSED)
+				return HoldData(pData, iLength);
+			else if(m_parser.http_errno != HPE_OK)
+				return ExecuteParser(pData, iLength);
+			else if(IsParserAtRequestStart())
+				hr = ExecuteHead(pData, iLength, iPased);
+			else if(IsParserInBody())
+			{
+				iPased	= (int)MIN((ULONGLONG)iLength, m_parser.content_length);
+				hr		= ExecuteParser(pData, iPased);
+			}
+			else
+				return ExecuteParser(pData, iLength);
+
+			pData	+= iPased;
+			iLength	-= iPased;
+		}
+
+		return hr;
+	}
+
+	EnHandleResult ExecuteHead(const BYTE* pData, int iLength, int& iPased)
+	{
+		THttpRequestHead head;
+
+		// ͷܿٽʱǰ󽻸 http_parser 
+		int iEnd = CHttpScanner::FindHeadEnd((LPCSTR)pData, iLength);
+
+		if(iEnd < 0 || !::ParseHttpRequestHead((LPCSTR)pData, iEnd, head))
+		{
+			iPased = (iEnd < 0) ? iLength : iEnd;
+			return ExecuteParser(pData, iPased);
+		}
+
+		iPased				= iEnd;
+		EnHandleResult hr	= FireHead(head);
+
+		if(hr == HR_OK && m_parser.upgrade)
+		{
+			hr		= Upgrade(pData, iLength, iPased);
+			iPased	= iLength;
+		}
+
+		return hr;
+	}
+
+	EnHandleResult FireHead(const THttpRequestHead& head)
+	{
+		m_parser.flags			= 0;
+		m_parser.content_length	= ULLONG_MAX;
+		m_parser.method			= head.method;
+
+		if(on_message_begin(&m_parser) != HPR_OK)
+			return RaiseParseError(HPE_CB_message_begin);
+
+		AppendBuffer(head.url, head.urlLen);
+		SetUrlFields(head.urlFields);
+
+		EnHttpParseResult hpr = m_pContext->FireRequestLine(m_pSocket, ::http_method_str(head.method), GetBuffer());
+		ResetBuffer();
+
+		if(hpr != HPR_OK)
+			return RaiseParseError(HPE_CB_url);
+
+		m_parser.http_major = head.major;
+		m_parser.http_minor = head.minor;
+
+		for(int i = 0; i < head.headerCount; i++)
+		{
+			const THttpRequestHead::TField& field = head.headers[i];
+
+			if(FireHeaderItem(m_headers.Add(field.name, field.nameLen, field.value, field.valueLen)) != HPR_OK)
+				return RaiseParseError(HPE_CB_header_value);
+		}
+
+		m_parser.flags			= head.flags;
+		m_parser.content_length	= head.contentLength;
+		m_parser.upgrade		= 0;
+		m_parser.nread			= 0;
+
+		switch(on_headers_complete(&m_parser))
+		{
+		case HPR_OK:
+			break;
+		case HPR_UPGRADE:
+			m_parser.upgrade = 1;
+		case HPR_SKIP_BODY:
+			m_parser.flags |= F_SKIPBODY;
+			break;
+		default:
+			return RaiseParseError(HPE_CB_headers_complete);
+		}
+
+		if((m_parser.flags & F_SKIPBODY) || m_parser.content_length == 0 || m_parser.content_length == ULLONG_MAX)
+		{
+			SetParserHeadComplete(FALSE);
+
+			//  ExecuteParser() һ£Эʱ OnMessageComplete صĴ
+			if(on_message_complete(&m_parser) != HPR_OK)
+			{
+				m_parser.http_errno = HPE_CB_message_complete;
+
+				if(!m_parser.upgrade)
+					return RaiseParseError();
+			}
+		}
+		else
+			SetParserHeadComplete(TRUE);
+
+		return HR_OK;
+	}
+
+	/*
+	* http_parser ûṩȡý״̬Ľӿڣٽֻͨ·ڲ״̬
+	*	IsParserAtRequestStart()	- ȴһs_start_req
+	*	IsParserInBody()			- ڽ Content-Length 壨s_body_identity
+	*	SetParserHeadComplete()		- ͷɿٽʱ s_body_identity http_parser  content_length
+	*								  岢 OnBody / OnMessageComplete http_parser ʱһ£ s_start_req  s_dead
+	*/
+	BOOL IsParserAtRequestStart()	const	{return m_parser.state == s_start_req;}
+	BOOL IsParserInBody()			const	{return m_parser.state == s_body_identity;}
+
+	void SetParserHeadComplete(BOOL bBody)
+	{
+		if(bBody)
+			m_parser.state = s_body_identity;
+		else
+			m_parser.state = ::http_should_keep_alive(&m_parser) ? s_start_req : s_dead;
+	}
+
+	EnHttpParseResult FireHeaderItem(const THttpHeaderItem& item)
+	{
+		EnHttpParseResult hpr = m_pContext->FireHeader(m_pSocket, item.name, item.value);
+
+		if(hpr != HPR_ERROR)
+		{
+			if(m_bRequest && item.known == HKH_COOKIE)
+				hpr = ParseCookie(item.value);
+			else if(!m_bRequest && item.known == HKH_SET_COOKIE)
+				hpr = ParseSetCookie(item.value);
+		}
+
+		return hpr;
+	}
+
+	EnHandleResult RaiseParseError(http_errno enErrno = HPE_OK)
+	{
+		if(enErrno != HPE_OK)
+			m_parser.http_errno = enErrno;
+
+		m_pContext->FireParseError(m_pSocket, m_parser.http_errno, ::http_errno_description(HTTP_PARSER_ERRNO(&m_parser)));
+
+		return HR_ERROR;
+	}
+
 	EnHandleResult Upgrade(const BYTE* pData, int iLength, int iPased)
 	{
 		ASSERT(m_parser.upgrade);
@@ -591,7 +1391,7 @@ private:
 		else
 		{
 			LPCSTR lpszValue;
-			if(GetHeader(HTTP_HEADER_UPGRADE, &lpszValue) && stricmp(HTTP_HEADER_VALUE_WEB_SOCKET, lpszValue) == 0)
+			if(GetHeader(HKH_UPGRADE, &lpszValue) && stricmp(HTTP_HEADER_VALUE_WEB_SOCKET, lpszValue) == 0)
 				m_enUpgrade = HUT_WEB_SOCKET;
 			else
 				m_enUpgrade = HUT_UNKNOWN;
@@ -611,6 +1411,13 @@ private:
 			return HPR_ERROR;
 		}
 
+		SetUrlFields(url);
+
+		return HPR_OK;
+	}
+
+	void SetUrlFields(const http_parser_url& url)
+	{
 		m_usUrlFieldSet		= url.field_set;
 		LPCSTR lpszBuffer	= m_strBuffer;
 
@@ -619,17 +1426,16 @@ private:
 			if((url.field_set & (1 << i)) != 0)
 				m_pstrUrlFileds[i].SetString((lpszBuffer + url.field_data[i].off), url.field_data[i].len);
 		}
-
-		return HPR_OK;
 	}
 
-	EnHttpParseResult ParseCookie()
+	EnHttpParseResult ParseCookie(LPCSTR lpszValue)
 	{
 		int i = 0;
+		CStringA strValue(lpszValue);
 
 		do 
 		{
-			CStringA tk = m_strBuffer.Tokenize(COOKIE_FIELD_SEP, i);
+			CStringA tk = strValue.Tokenize(COOKIE_FIELD_SEP, i);
 
 			if(i == -1)
 				break;
@@ -652,7 +1458,7 @@ private:
 		return HPR_OK;
 	}
 
-	EnHttpParseResult ParseSetCookie()
+	EnHttpParseResult ParseSetCookie(LPCSTR lpszValue)
 	{
 		CCookieMgr* pCookieMgr = m_pContext->GetCookieMgr();
 
@@ -662,7 +1468,7 @@ private:
 		LPCSTR lpszDomain	= GetDomain();
 		LPCSTR lpszPath		= GetPath();
 
-		unique_ptr<CCookie> pCookie(CCookie::FromString(m_strBuffer, lpszDomain, lpszPath));
+		unique_ptr<CCookie> pCookie(CCookie::FromString(lpszValue, lpszDomain, lpszPath));
 
 		if(pCookie == nullptr)
 			return HPR_ERROR;
@@ -683,13 +1489,34 @@ private:
 
 public:
 	DWORD GetFreeTime() const		{return m_dwFreeTime;}
-	void SetFree()					{m_dwFreeTime = ::TimeGetTime();}
+	ULONGLONG GetFreeEpoch() const	{return m_ullFreeEpoch;}
+	void SetFree()					{m_dwFreeTime = ::TimeGetTime(); m_ullFreeEpoch = CEpochDomain::Retire();}
 
 	BOOL IsRequest()				{return m_bRequest;}
+	BOOL IsFastParse()				{return m_bFastParse;}
+	CHttpPipeline& GetPipeline()	{return m_pipeline;}
+	void SetFastParse(BOOL bFastParse)	{m_bFastParse = m_bRequest && bFastParse;}
 	BOOL IsUpgrade()				{return m_parser.upgrade;}
-	BOOL IsKeepAlive()				{return ::http_should_keep_alive(&m_parser);}
+	BOOL IsKeepAlive()				{return m_ph2Context ? TRUE : ::http_should_keep_alive(&m_parser);}
 	USHORT GetVersion()				{return MAKEWORD(m_parser.http_major, m_parser.http_minor);}
 	ULONGLONG GetContentLength()	{return m_parser.content_length;}
+	BOOL IsHttp2()					{return m_ph2Context != nullptr;}
+	DWORD GetStreamID()				{return m_dwStreamID;}
+
+	BOOL GetStreamHeader(DWORD dwStreamID, LPCSTR lpszName, LPSTR lpszValue, int& iValueLen)
+	{
+		if(!m_ph2Context)
+		{
+			::SetLastError(ERROR_INVALID_STATE);
+			return FALSE;
+		}
+
+		return m_ph2Context->GetSession().GetStreamField(dwStreamID, lpszName, lpszValue, iValueLen);
+	}
+
+	/* ¼صзظ ID̻߳¼ص֮⣩ 0 */
+	DWORD GetEventStreamID()		{return (m_ph2Context && m_ph2Context->IsInStreamEvent()) ? m_dwStreamID : 0;}
+	CHttp2Session& GetHttp2Session(){return m_ph2Context->GetSession();}
 
 	int GetMethodInt()				{return m_bRequest ? m_parser.method : m_sRequestMethod;}
 	LPCSTR GetMethod()				{return ::http_method_str((http_method)GetMethodInt());}
@@ -698,7 +1525,7 @@ public:
 
 	EnHttpUpgradeType GetUpgradeType()	{return m_enUpgrade;}
 
-	THeaderMap& GetHeaderMap()		{return m_headers;}
+	CHttpHeaderStore& GetHeaderStore()	{return m_headers;}
 	TCookieMap& GetCookieMap()		{return m_cookies;}
 
 	BOOL HasReleased()				{return m_bReleased;}
@@ -707,7 +1534,7 @@ public:
 	LPCSTR GetContentType()
 	{
 		LPCSTR lpszValue = nullptr;
-		GetHeader(HTTP_HEADER_CONTENT_TYPE, &lpszValue);
+		GetHeader(HKH_CONTENT_TYPE, &lpszValue);
 
 		return lpszValue;
 	}
@@ -715,7 +1542,7 @@ public:
 	LPCSTR GetContentEncoding()
 	{
 		LPCSTR lpszValue = nullptr;
-		GetHeader(HTTP_HEADER_CONTENT_ENCODING, &lpszValue);
+		GetHeader(HKH_CONTENT_ENCODING, &lpszValue);
 
 		return lpszValue;
 	}
@@ -723,7 +1550,7 @@ public:
 	LPCSTR GetTransferEncoding()
 	{
 		LPCSTR lpszValue = nullptr;
-		GetHeader(HTTP_HEADER_TRANSFER_ENCODING, &lpszValue);
+		GetHeader(HKH_TRANSFER_ENCODING, &lpszValue);
 
 		return lpszValue;
 	}
@@ -731,7 +1558,7 @@ public:
 	LPCSTR GetHost()
 	{
 		LPCSTR lpszValue = nullptr;
-		GetHeader(HTTP_HEADER_HOST, &lpszValue);
+		GetHeader(HKH_HOST, &lpszValue);
 
 		return lpszValue;
 	}
@@ -812,40 +1639,49 @@ public:
 	{
 		ASSERT(lpszName);
 
-		BOOL isOK		= FALSE;
-		THeaderMapCI it = m_headers.find(lpszName);
+		const THttpHeaderItem* pItem = m_headers.Find(lpszName);
 
-		if(it != m_headers.end())
-		{
-			*lpszValue	= it->second;
-			isOK		= TRUE;
-		}
+		if(pItem == nullptr)
+			return FALSE;
 
-		return isOK;
+		*lpszValue = pItem->value;
+
+		return TRUE;
 	}
 
-	BOOL GetHeaders(LPCSTR lpszName, LPCSTR lpszValue[], DWORD& dwCount)
+	BOOL GetHeader(EnHttpKnownHeader enKnown, LPCSTR* lpszValue)
 	{
-		ASSERT(lpszName);
+		const THttpHeaderItem* pItem = m_headers.Find(enKnown);
 
-		if(lpszValue == nullptr || dwCount == 0)
-		{
-			dwCount = (DWORD)m_headers.count(lpszName);
+		if(pItem == nullptr)
 			return FALSE;
-		}
 
-		pair<THeaderMapCI, THeaderMapCI> range = m_headers.equal_range(lpszName);
+		*lpszValue = pItem->value;
+
+		return TRUE;
+	}
 
-		THeaderMapCI it	= range.first;
+	BOOL GetHeaders(LPCSTR lpszName, LPCSTR lpszValue[], DWORD& dwCount)
+	{
+		ASSERT(lpszName);
+
+		int iNameLen	= (int)strlen(lpszName);
+		UINT uiHash		= CHttpHeaderStore::HashName(lpszName, iNameLen);
+		BOOL bFetch		= (lpszValue != nullptr && dwCount > 0);
 		DWORD dwIndex	= 0;
 
-		while(it != range.second)
+		for(int i = m_headers.FindNext(lpszName, iNameLen, uiHash, 0); i >= 0; i = m_headers.FindNext(lpszName, iNameLen, uiHash, i + 1))
 		{
-			if(dwIndex < dwCount)
-				lpszValue[dwIndex] = it->second;
+			if(bFetch && dwIndex < dwCount)
+				lpszValue[dwIndex] = m_headers[i].value;
 
 			++dwIndex;
-			++it;
+		}
+
+		if(!bFetch)
+		{
+			dwCount = dwIndex;
+			return FALSE;
 		}
 
 		BOOL isOK	= (dwIndex > 0 && dwIndex <= dwCount);
@@ -856,7 +1692,7 @@ public:
 
 	BOOL GetAllHeaders(THeader lpHeaders[], DWORD& dwCount)
 	{
-		DWORD dwSize = (DWORD)m_headers.size();
+		DWORD dwSize = (DWORD)m_headers.Size();
 
 		if(lpHeaders == nullptr || dwCount == 0 || dwSize == 0 || dwSize > dwCount)
 		{
@@ -864,12 +1700,10 @@ public:
 			return FALSE;
 		}
 
-		DWORD dwIndex = 0;
-
-		for(THeaderMapCI it = m_headers.begin(), end = m_headers.end(); it != end; ++it, ++dwIndex)
+		for(DWORD dwIndex = 0; dwIndex < dwSize; dwIndex++)
 		{
-			lpHeaders[dwIndex].name  = it->first;
-			lpHeaders[dwIndex].value = it->second;
+			lpHeaders[dwIndex].name  = m_headers[dwIndex].name;
+			lpHeaders[dwIndex].value = m_headers[dwIndex].value;
 		}
 
 		dwCount = dwSize;
@@ -878,7 +1712,7 @@ public:
 
 	BOOL GetAllHeaderNames(LPCSTR lpszName[], DWORD& dwCount)
 	{
-		DWORD dwSize = (DWORD)m_headers.size();
+		DWORD dwSize = (DWORD)m_headers.Size();
 
 		if(lpszName == nullptr || dwCount == 0 || dwSize == 0 || dwSize > dwCount)
 		{
@@ -886,10 +1720,8 @@ public:
 			return FALSE;
 		}
 
-		DWORD dwIndex = 0;
-
-		for(THeaderMapCI it = m_headers.begin(), end = m_headers.end(); it != end; ++it, ++dwIndex)
-			lpszName[dwIndex] = it->first;
+		for(DWORD dwIndex = 0; dwIndex < dwSize; dwIndex++)
+			lpszName[dwIndex] = m_headers[dwIndex].name;
 
 		dwCount = dwSize;
 		return TRUE;
@@ -993,6 +1825,49 @@ public:
 		return m_pwsContext->GetMessageState(lpbFinal, lpiReserved, lpiOperationCode, lpszMask, lpullBodyLen, lpullBodyRemain);
 	}
 
+	/*  HTTP/2 Ự˼⵽ǰԻͻЭ HTTP/2 ã */
+	BOOL StartHttp2()
+	{
+		ASSERT(!m_ph2Context && !m_parser.upgrade);
+
+		m_iPrefaceMatched		= -1;
+		m_ph2Context			= new TH2Context<THttpObjT<T, S>>(this);
+		m_parser.http_major		= 2;
+		m_parser.http_minor		= 0;
+
+		return m_ph2Context->GetSession().Start(m_bRequest, m_pContext->GetHttp2MaxConcurrentStreams(), m_ph2Context);
+	}
+
+	/*  HTTP/2 ͷϢ */
+	BOOL SendHttp2Message(DWORD dwStreamID, const CHttp2FieldList& fields, const BYTE* pData, int iLength, BOOL bEndStream)
+	{
+		CHttp2Session& session = m_ph2Context->GetSession();
+
+		if(iLength == 0)
+			return session.SendHeaders(dwStreamID, fields, bEndStream);
+
+		return session.SendHeaders(dwStreamID, fields, FALSE) && session.SendData(dwStreamID, pData, iLength, bEndStream);
+	}
+
+	/* ȡ HTTP/2 Я Cookieı䵱ǰӦ· */
+	BOOL LoadHttp2Cookies(LPCSTR lpszPath, TCookieMap& cookies)
+	{
+		CCookieMgr* pCookieMgr = m_pContext->GetCookieMgr();
+
+		if(pCookieMgr == nullptr)
+			return TRUE;
+
+		CCookieSet set;
+
+		if(!pCookieMgr->GetCookies(set, GetDomain(), lpszPath, TRUE, m_pContext->IsSecure()))
+			return FALSE;
+
+		for(CCookieSetCI it = set.begin(), end = set.end(); it != end; ++it)
+			cookies[it->name] = it->value;
+
+		return TRUE;
+	}
+
 public:
 	THttpObjT			(BOOL bRequest, T* pContext, S* pSocket)
 	: m_pContext		(pContext)
@@ -1000,11 +1875,16 @@ public:
 	, m_bRequest		(bRequest)
 	, m_bValid			(FALSE)
 	, m_bReleased		(FALSE)
+	, m_bFastParse		(FALSE)
 	, m_dwFreeTime		(0)
+	, m_ullFreeEpoch	(0)
 	, m_usUrlFieldSet	(m_bRequest ? 0 : -1)
 	, m_pstrUrlFileds	(nullptr)
 	, m_enUpgrade		(HUT_NONE)
 	, m_pwsContext		(nullptr)
+	, m_ph2Context		(nullptr)
+	, m_dwStreamID		(0)
+	, m_iPrefaceMatched	(m_bRequest ? 0 : -1)
 	{
 		if(m_bRequest)
 			m_pstrUrlFileds	  = new CStringA[HUF_MAX];
@@ -1022,6 +1902,7 @@ public:
 			delete m_pstrRequestPath;
 
 		ReleaseWSContext();
+		ReleaseH2Context();
 	}
 
 	static THttpObjT* Construct(BOOL bRequest, T* pContext, S* pSocket)
@@ -1035,11 +1916,18 @@ public:
 		ResetParser();
 		ResetHeaderState();
 		ReleaseWSContext();
+		ReleaseH2Context();
+		m_pipeline.Reset();
+		m_bufHeld.Free();
 
 		m_bValid	 = bValid;
 		m_bReleased  = FALSE;
+		m_bFastParse = FALSE;
 		m_enUpgrade  = HUT_NONE;
+		m_dwStreamID = 0;
+		m_iPrefaceMatched = m_bRequest ? 0 : -1;
 		m_dwFreeTime = 0;
+		m_ullFreeEpoch = 0;
 	}
 
 	void Renew(T* pContext, S* pSocket)
@@ -1071,7 +1959,7 @@ public:
 		m_parser		= src.m_parser;
 		m_parser.data	= p;
 
-		m_headers = src.m_headers;
+		m_headers.CopyFrom(src.m_headers);
 		m_cookies = src.m_cookies;
 
 		if(m_bRequest)
@@ -1149,14 +2037,13 @@ private:
 		if(m_bRequest || bClearCookies)
 			DeleteAllCookies();
 			
-		m_headers.clear();
+		m_headers.Clear();
 		ResetHeaderBuffer();
 	}
 
 	void ResetHeaderBuffer()
 	{
 		ResetBuffer();
-		m_strCurHeader.Empty();
 	}
 
 	void ReleaseWSContext()
@@ -1168,6 +2055,15 @@ private:
 		}
 	}
 
+	void ReleaseH2Context()
+	{
+		if(m_ph2Context)
+		{
+			delete m_ph2Context;
+			m_ph2Context = nullptr;
+		}
+	}
+
 	void AppendBuffer(const char* at, size_t length)	{m_strBuffer.Append(at, (int)length);}
 	void ResetBuffer()									{m_strBuffer.Empty();}
 	LPCSTR GetBuffer()									{return m_strBuffer;}
@@ -1180,13 +2076,16 @@ private:
 	BOOL		m_bValid;
 	BOOL		m_bRequest;
 	BOOL		m_bReleased;
+	BOOL		m_bFastParse;
 	T*			m_pContext;
 	S*			m_pSocket;
 	http_parser	m_parser;
-	THeaderMap	m_headers;
 	TCookieMap	m_cookies;
 	CStringA	m_strBuffer;
-	CStringA	m_strCurHeader;
+
+	CHttpHeaderStore m_headers;
+	CHttpPipeline	 m_pipeline;
+	CBufferPtr		 m_bufHeld;
 
 	union
 	{
@@ -1202,8 +2101,13 @@ private:
 
 	EnHttpUpgradeType	m_enUpgrade;
 	DWORD				m_dwFreeTime;
+	ULONGLONG			m_ullFreeEpoch;
 
 	TWSContext<THttpObjT<T, S>>* m_pwsContext;
+	TH2Context<THttpObjT<T, S>>* m_ph2Context;
+
+	DWORD				m_dwStreamID;
+	int					m_iPrefaceMatched;
 
 	static http_parser_settings sm_settings;
 };
@@ -1238,7 +2142,7 @@ public:
 
 		if(m_lsFreeHttpObj.TryLock(&pHttpObj, dwIndex))
 		{
-			if(::GetTimeGap32(pHttpObj->GetFreeTime()) >= m_dwHttpObjLockTime)
+			if(CEpochDomain::IsReclaimable(pHttpObj->GetFreeEpoch()))
 				VERIFY(m_lsFreeHttpObj.ReleaseLock(nullptr, dwIndex));
 			else
 			{
@@ -1284,25 +2188,21 @@ public:
 private:
 	void ReleaseGCHttpObj(BOOL bForce = FALSE)
 	{
-		::ReleaseGCObj(m_lsGCHttpObj, m_dwHttpObjLockTime, bForce);
+		::ReleaseGCObj(m_lsGCHttpObj, bForce);
 	}
 
 public:
-	void SetHttpObjLockTime	(DWORD dwHttpObjLockTime)	{m_dwHttpObjLockTime = dwHttpObjLockTime;}
 	void SetHttpObjPoolSize	(DWORD dwHttpObjPoolSize)	{m_dwHttpObjPoolSize = dwHttpObjPoolSize;}
 	void SetHttpObjPoolHold	(DWORD dwHttpObjPoolHold)	{m_dwHttpObjPoolHold = dwHttpObjPoolHold;}
 
-	DWORD GetHttpObjLockTime()	{return m_dwHttpObjLockTime;}
 	DWORD GetHttpObjPoolSize()	{return m_dwHttpObjPoolSize;}
 	DWORD GetHttpObjPoolHold()	{return m_dwHttpObjPoolHold;}
 
 public:
 	CHttpObjPoolT(	DWORD dwPoolSize = DEFAULT_HTTPOBJ_POOL_SIZE,
-					DWORD dwPoolHold = DEFAULT_HTTPOBJ_POOL_HOLD,
-					DWORD dwLockTime = DEFAULT_HTTPOBJ_LOCK_TIME)
+					DWORD dwPoolHold = DEFAULT_HTTPOBJ_POOL_HOLD)
 	: m_dwHttpObjPoolSize(dwPoolSize)
 	, m_dwHttpObjPoolHold(dwPoolHold)
-	, m_dwHttpObjLockTime(dwLockTime)
 	{
 
 	}
@@ -1312,12 +2212,10 @@ public:
 	DECLARE_NO_COPY_CLASS(CHttpObjPoolT)
 
 public:
-	static const DWORD DEFAULT_HTTPOBJ_LOCK_TIME;
 	static const DWORD DEFAULT_HTTPOBJ_POOL_SIZE;
 	static const DWORD DEFAULT_HTTPOBJ_POOL_HOLD;
 
 private:
-	DWORD				m_dwHttpObjLockTime;
 	DWORD				m_dwHttpObjPoolSize;
 	DWORD				m_dwHttpObjPoolHold;
 
@@ -1325,21 +2223,7 @@ private:
 	TSSLHttpObjQueue	m_lsGCHttpObj;
 };
 
-template<BOOL is_request, class T, class S> const DWORD CHttpObjPoolT<is_request, T, S>::DEFAULT_HTTPOBJ_LOCK_TIME	= DEFAULT_OBJECT_CACHE_LOCK_TIME;
 template<BOOL is_request, class T, class S> const DWORD CHttpObjPoolT<is_request, T, S>::DEFAULT_HTTPOBJ_POOL_SIZE	= DEFAULT_OBJECT_CACHE_POOL_SIZE;
 template<BOOL is_request, class T, class S> const DWORD CHttpObjPoolT<is_request, T, S>::DEFAULT_HTTPOBJ_POOL_HOLD	= DEFAULT_OBJECT_CACHE_POOL_HOLD;
 
-// ------------------------------------------------------------------------------------------------------------- //
-
-extern CStringA& GetHttpVersionStr(EnHttpVersion enVersion, CStringA& strResult);
-extern CStringA& AdjustRequestPath(BOOL bConnect, LPCSTR lpszPath, CStringA& strPath);
-extern LPCSTR GetHttpDefaultStatusCodeDesc(EnHttpStatusCode enCode);
-extern void MakeRequestLine(LPCSTR lpszMethod, LPCSTR lpszPath, EnHttpVersion enVersion, CStringA& strValue);
-extern void MakeStatusLine(EnHttpVersion enVersion, USHORT usStatusCode, LPCSTR lpszDesc, CStringA& strValue);
-extern void MakeHeaderLines(const THeader lpHeaders[], int iHeaderCount, const TCookieMap* pCookies, int iBodyLength, BOOL bRequest, int iConnFlag, LPCSTR lpszDefaultHost, USHORT usPort, CStringA& strValue);
-extern void MakeHttpPacket(const CStringA& strHeader, const BYTE* pBody, int iLength, WSABUF szBuffer[2]);
-extern int MakeChunkPackage(const BYTE* pData, int iLength, LPCSTR lpszExtensions, char szLen[12], WSABUF bufs[5]);
-extern BOOL MakeWSPacket(BOOL bFinal, BYTE iReserved, BYTE iOperationCode, const BYTE lpszMask[4], BYTE* pData, int iLength, ULONGLONG ullBodyLen, BYTE szHeader[HTTP_MAX_WS_HEADER_LEN], WSABUF szBuffer[2]);
-extern BOOL ParseUrl(const CStringA& strUrl, BOOL& bHttps, CStringA& strHost, USHORT& usPort, CStringA& strPath);
-
 #endif
@@ -50,7 +50,6 @@ template<class T, USHORT default_port> void CHttpServerT<T, default_port>::Prepa
 {
 	__super::PrepareStart();
 
-	m_objPool.SetHttpObjLockTime(GetFreeSocketObjLockTime());
 	m_objPool.SetHttpObjPoolSize(GetFreeSocketObjPool());
 	m_objPool.SetHttpObjPoolHold(GetFreeSocketObjHold());
 
@@ -59,6 +58,40 @@ template<class T, USHORT default_port> void CHttpServerT<T, default_port>::Prepa
 
 template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::SendResponse(CONNID dwConnID, USHORT usStatusCode, LPCSTR lpszDesc, const THeader lpHeaders[], int iHeaderCount, const BYTE* pData, int iLength)
 {
+	if(m_bHttp2Support || m_dwMaxPipelineRequests > 0)
+	{
+		CEpochLock epochlock;
+
+		THttpObj* pHttpObj = FindHttpObj(dwConnID);
+
+		if(pHttpObj != nullptr && pHttpObj->IsHttp2())
+		{
+			/* 隐式回复只能在流的事件回调中发起，否则无法确定回复所属的流 */
+			DWORD dwStreamID = pHttpObj->GetEventStreamID();
+
+			if(dwStreamID == 0)
+			{
+				::SetLastError(ERROR_INVALID_STATE);
+				return FALSE;
+			}
+
+			return SendStreamResponse(dwConnID, dwStreamID, usStatusCode, lpszDesc, lpHeaders, iHeaderCount, pData, iLength);
+		}
+
+		if(pHttpObj != nullptr && m_dwMaxPipelineRequests > 0)
+		{
+			DWORD dwSeq;
+
+			if(!pHttpObj->GetPipeline().GetFirstPending(dwSeq))
+			{
+				::SetLastError(ERROR_INVALID_STATE);
+				return FALSE;
+			}
+
+			return SendPipelineResponse(dwConnID, dwSeq, usStatusCode, lpszDesc, lpHeaders, iHeaderCount, pData, iLength);
+		}
+	}
+
 	WSABUF szBuffer[2];
 	CStringA strHeader;
 
@@ -85,8 +118,129 @@ template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::SendL
 	return SendResponse(dwConnID, usStatusCode, lpszDesc, lpHeaders, iHeaderCount, (BYTE*)fmap, (int)fmap.Size());
 }
 
+template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::SendPipelineResponse(CONNID dwConnID, DWORD dwSeq, USHORT usStatusCode, LPCSTR lpszDesc, const THeader lpHeaders[], int iHeaderCount, const BYTE* pData, int iLength)
+{
+	if(m_dwMaxPipelineRequests == 0)
+	{
+		::SetLastError(ERROR_INVALID_OPERATION);
+		return FALSE;
+	}
+
+	CEpochLock epochlock;
+
+	THttpObj* pHttpObj = FindHttpObj(dwConnID);
+
+	if(pHttpObj == nullptr)
+	{
+		::SetLastError(ERROR_OBJECT_NOT_FOUND);
+		return FALSE;
+	}
+
+	BOOL bKeepAlive;
+	CHttpPipeline& pipeline = pHttpObj->GetPipeline();
+
+	if(!pipeline.GetKeepAlive(dwSeq, bKeepAlive))
+	{
+		::SetLastError(ERROR_INVALID_PARAMETER);
+		return FALSE;
+	}
+
+	WSABUF szBuffer[2];
+	CStringA strHeader;
+
+	::MakeStatusLine(m_enLocalVersion, usStatusCode, lpszDesc, strHeader);
+	::MakeHeaderLines(lpHeaders, iHeaderCount, nullptr, iLength, FALSE, bKeepAlive, nullptr, 0, strHeader);
+	::MakeHttpPacket(strHeader, pData, iLength, szBuffer);
+
+	// 发送失败时后续响应无法按序发送，断开连接
+	auto fnSend = [this, dwConnID](const WSABUF pBuffers[], int iCount) -> BOOL
+	{
+		if(SendPackets(dwConnID, pBuffers, iCount))
+			return TRUE;
+
+		DWORD dwCode = ::GetLastError();
+		Disconnect(dwConnID);
+		::SetLastError(dwCode);
+
+		return FALSE;
+	};
+
+	return pipeline.Submit(dwSeq, szBuffer, 2, m_dwMaxPipelineRequests, fnSend,
+							[this, dwConnID](BOOL bPause) {PauseReceive(dwConnID, bPause);});
+}
+
+template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::SendStreamResponse(CONNID dwConnID, DWORD dwStreamID, USHORT usStatusCode, LPCSTR lpszDesc, const THeader lpHeaders[], int iHeaderCount, const BYTE* pData, int iLength)
+{
+	CEpochLock epochlock;
+
+	THttpObj* pHttpObj = FindHttpObj(dwConnID);
+
+	if(pHttpObj == nullptr)
+	{
+		::SetLastError(ERROR_OBJECT_NOT_FOUND);
+		return FALSE;
+	}
+
+	if(!pHttpObj->IsHttp2())
+	{
+		::SetLastError(ERROR_INVALID_STATE);
+		return FALSE;
+	}
+
+	char szStatus[8];
+	itoa(usStatusCode, szStatus, 10);
+
+	CHttp2FieldList fields;
+	fields.Add(HTTP2_HEADER_STATUS, szStatus);
+
+	BOOL bChunked = ::MakeHttp2HeaderFields(lpHeaders, iHeaderCount, nullptr, iLength, FALSE, nullptr, 0, fields);
+
+	return pHttpObj->SendHttp2Message(dwStreamID, fields, pData, iLength, !bChunked);
+}
+
+template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::SendStreamChunkData(CONNID dwConnID, DWORD dwStreamID, const BYTE* pData, int iLength)
+{
+	CEpochLock epochlock;
+
+	THttpObj* pHttpObj = FindHttpObj(dwConnID);
+
+	if(pHttpObj == nullptr)
+	{
+		::SetLastError(ERROR_OBJECT_NOT_FOUND);
+		return FALSE;
+	}
+
+	if(!pHttpObj->IsHttp2())
+	{
+		::SetLastError(ERROR_INVALID_STATE);
+		return FALSE;
+	}
+
+	return pHttpObj->GetHttp2Session().SendData(dwStreamID, pData, iLength, iLength == 0);
+}
+
 template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::SendChunkData(CONNID dwConnID, const BYTE* pData, int iLength, LPCSTR lpszExtensions)
 {
+	if(m_bHttp2Support)
+	{
+		CEpochLock epochlock;
+
+		THttpObj* pHttpObj = FindHttpObj(dwConnID);
+
+		if(pHttpObj != nullptr && pHttpObj->IsHttp2())
+		{
+			DWORD dwStreamID = pHttpObj->GetEventStreamID();
+
+			if(dwStreamID == 0)
+			{
+				::SetLastError(ERROR_INVALID_STATE);
+				return FALSE;
+			}
+
+			return SendStreamChunkData(dwConnID, dwStreamID, pData, iLength);
+		}
+	}
+
 	char szLen[12];
 	WSABUF bufs[5];
 
@@ -97,6 +251,8 @@ template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::SendC
 
 template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::Release(CONNID dwConnID)
 {
+	CEpochLock epochlock;
+
 	if(!HasStarted())
 		return FALSE;
 
@@ -276,6 +432,24 @@ template<class T, USHORT default_port> EnHandleResult CHttpServerT<T, default_po
 	return result;
 }
 
+template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::BeforeUnpause(TSocketObj* pSocketObj)
+{
+	CReentrantCriSecLock locallock(pSocketObj->csIo);
+
+	if(!TSocketObj::IsValid(pSocketObj))
+		return FALSE;
+
+	if(pSocketObj->IsPaused())
+		return TRUE;
+
+	THttpObj* pHttpObj = FindHttpObj(pSocketObj);
+
+	if(pHttpObj == nullptr || pHttpObj->HasReleased())
+		return TRUE;
+
+	return (pHttpObj->ExecuteHeld() != HR_ERROR);
+}
+
 template<class T, USHORT default_port> EnHandleResult CHttpServerT<T, default_port>::DoFireShutdown()
 {
 	EnHandleResult result = __super::DoFireShutdown();
@@ -298,6 +472,8 @@ template<class T, USHORT default_port> void CHttpServerT<T, default_port>::WaitF
 
 template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::IsUpgrade(CONNID dwConnID)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -308,6 +484,8 @@ template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::IsUpg
 
 template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::IsKeepAlive(CONNID dwConnID)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -318,6 +496,8 @@ template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::IsKee
 
 template<class T, USHORT default_port> USHORT CHttpServerT<T, default_port>::GetVersion(CONNID dwConnID)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -328,6 +508,8 @@ template<class T, USHORT default_port> USHORT CHttpServerT<T, default_port>::Get
 
 template<class T, USHORT default_port> LPCSTR CHttpServerT<T, default_port>::GetHost(CONNID dwConnID)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -338,6 +520,8 @@ template<class T, USHORT default_port> LPCSTR CHttpServerT<T, default_port>::Get
 
 template<class T, USHORT default_port> ULONGLONG CHttpServerT<T, default_port>::GetContentLength(CONNID dwConnID)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -348,6 +532,8 @@ template<class T, USHORT default_port> ULONGLONG CHttpServerT<T, default_port>::
 
 template<class T, USHORT default_port> LPCSTR CHttpServerT<T, default_port>::GetContentType(CONNID dwConnID)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -358,6 +544,8 @@ template<class T, USHORT default_port> LPCSTR CHttpServerT<T, default_port>::Get
 
 template<class T, USHORT default_port> LPCSTR CHttpServerT<T, default_port>::GetContentEncoding(CONNID dwConnID)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -368,6 +556,8 @@ template<class T, USHORT default_port> LPCSTR CHttpServerT<T, default_port>::Get
 
 template<class T, USHORT default_port> LPCSTR CHttpServerT<T, default_port>::GetTransferEncoding(CONNID dwConnID)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -378,6 +568,8 @@ template<class T, USHORT default_port> LPCSTR CHttpServerT<T, default_port>::Get
 
 template<class T, USHORT default_port> EnHttpUpgradeType CHttpServerT<T, default_port>::GetUpgradeType(CONNID dwConnID)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -388,6 +580,8 @@ template<class T, USHORT default_port> EnHttpUpgradeType CHttpServerT<T, default
 
 template<class T, USHORT default_port> USHORT CHttpServerT<T, default_port>::GetParseErrorCode(CONNID dwConnID, LPCSTR* lpszErrorDesc)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -398,6 +592,8 @@ template<class T, USHORT default_port> USHORT CHttpServerT<T, default_port>::Get
 
 template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::GetHeader(CONNID dwConnID, LPCSTR lpszName, LPCSTR* lpszValue)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -408,6 +604,8 @@ template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::GetHe
 
 template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::GetHeaders(CONNID dwConnID, LPCSTR lpszName, LPCSTR lpszValue[], DWORD& dwCount)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -418,6 +616,8 @@ template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::GetHe
 
 template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::GetAllHeaders(CONNID dwConnID, THeader lpHeaders[], DWORD& dwCount)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -428,6 +628,8 @@ template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::GetAl
 
 template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::GetAllHeaderNames(CONNID dwConnID, LPCSTR lpszName[], DWORD& dwCount)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -438,6 +640,8 @@ template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::GetAl
 
 template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::GetCookie(CONNID dwConnID, LPCSTR lpszName, LPCSTR* lpszValue)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -448,6 +652,8 @@ template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::GetCo
 
 template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::GetAllCookies(CONNID dwConnID, TCookie lpCookies[], DWORD& dwCount)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -458,6 +664,8 @@ template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::GetAl
 
 template<class T, USHORT default_port> USHORT CHttpServerT<T, default_port>::GetUrlFieldSet(CONNID dwConnID)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -468,6 +676,8 @@ template<class T, USHORT default_port> USHORT CHttpServerT<T, default_port>::Get
 
 template<class T, USHORT default_port> LPCSTR CHttpServerT<T, default_port>::GetUrlField(CONNID dwConnID, EnHttpUrlField enField)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -478,6 +688,8 @@ template<class T, USHORT default_port> LPCSTR CHttpServerT<T, default_port>::Get
 
 template<class T, USHORT default_port> LPCSTR CHttpServerT<T, default_port>::GetMethod(CONNID dwConnID)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -486,8 +698,75 @@ template<class T, USHORT default_port> LPCSTR CHttpServerT<T, default_port>::Get
 	return pHttpObj->GetMethod();
 }
 
+template<class T, USHORT default_port> DWORD CHttpServerT<T, default_port>::GetRequestSeq(CONNID dwConnID)
+{
+	CEpochLock epochlock;
+
+	THttpObj* pHttpObj = FindHttpObj(dwConnID);
+
+	if(pHttpObj == nullptr)
+	{
+		::SetLastError(ERROR_OBJECT_NOT_FOUND);
+		return HTTP_INVALID_REQUEST_SEQ;
+	}
+
+	if(m_dwMaxPipelineRequests == 0 || pHttpObj->IsHttp2())
+	{
+		::SetLastError(ERROR_INVALID_OPERATION);
+		return HTTP_INVALID_REQUEST_SEQ;
+	}
+
+	DWORD dwSeq = pHttpObj->GetPipeline().GetCurrentSeq();
+
+	if(dwSeq == HTTP_INVALID_REQUEST_SEQ)
+		::SetLastError(ERROR_INVALID_STATE);
+
+	return dwSeq;
+}
+
+template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::IsHttp2(CONNID dwConnID)
+{
+	CEpochLock epochlock;
+
+	THttpObj* pHttpObj = FindHttpObj(dwConnID);
+
+	if(pHttpObj == nullptr)
+		return FALSE;
+
+	return pHttpObj->IsHttp2();
+}
+
+template<class T, USHORT default_port> DWORD CHttpServerT<T, default_port>::GetStreamID(CONNID dwConnID)
+{
+	CEpochLock epochlock;
+
+	THttpObj* pHttpObj = FindHttpObj(dwConnID);
+
+	if(pHttpObj == nullptr)
+		return 0;
+
+	return pHttpObj->GetStreamID();
+}
+
+template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::GetStreamHeader(CONNID dwConnID, DWORD dwStreamID, LPCSTR lpszName, LPSTR lpszValue, int& iValueLen)
+{
+	CEpochLock epochlock;
+
+	THttpObj* pHttpObj = FindHttpObj(dwConnID);
+
+	if(pHttpObj == nullptr)
+	{
+		::SetLastError(ERROR_OBJECT_NOT_FOUND);
+		return FALSE;
+	}
+
+	return pHttpObj->GetStreamHeader(dwStreamID, lpszName, lpszValue, iValueLen);
+}
+
 template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::GetWSMessageState(CONNID dwConnID, BOOL* lpbFinal, BYTE* lpiReserved, BYTE* lpiOperationCode, LPCBYTE* lpszMask, ULONGLONG* lpullBodyLen, ULONGLONG* lpullBodyRemain)
 {
+	CEpochLock epochlock;
+
 	THttpObj* pHttpObj = FindHttpObj(dwConnID);
 
 	if(pHttpObj == nullptr)
@@ -514,6 +793,8 @@ template<class T, USHORT default_port> inline typename CHttpServerT<T, default_p
 
 template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::StartHttp(CONNID dwConnID)
 {
+	CEpochLock epochlock;
+
 	if(IsHttpAutoStart())
 	{
 		::SetLastError(ERROR_INVALID_OPERATION);
@@ -576,9 +857,39 @@ template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::Start
 	return TRUE;
 }
 
+template<class T, USHORT default_port> EnHttpParseResult CHttpServerT<T, default_port>::FireMessageBegin(TSocketObj* pSocketObj)
+{
+	CONNID dwConnID = pSocketObj->connID;
+
+	if(m_dwMaxPipelineRequests > 0)
+	{
+		THttpObj* pHttpObj = FindHttpObj(pSocketObj);
+
+		if(!pHttpObj->IsHttp2())
+			pHttpObj->GetPipeline().BeginRequest(m_dwMaxPipelineRequests, [this, dwConnID](BOOL bPause) {PauseReceive(dwConnID, bPause);});
+	}
+
+	return m_pListener->OnMessageBegin((IHttpServer*)this, dwConnID);
+}
+
+template<class T, USHORT default_port> EnHttpParseResult CHttpServerT<T, default_port>::FireHeadersComplete(TSocketObj* pSocketObj)
+{
+	if(m_dwMaxPipelineRequests > 0)
+	{
+		THttpObj* pHttpObj = FindHttpObj(pSocketObj);
+
+		if(!pHttpObj->IsHttp2())
+			pHttpObj->GetPipeline().SetKeepAlive(pHttpObj->IsKeepAlive());
+	}
+
+	return m_pListener->OnHeadersComplete((IHttpServer*)this, pSocketObj->connID);
+}
+
 template<class T, USHORT default_port> void CHttpServerT<T, default_port>::DoStartHttp(TSocketObj* pSocketObj)
 {
 	THttpObj* pHttpObj = m_objPool.PickFreeHttpObj(this, pSocketObj);
+	pHttpObj->SetFastParse(m_bFastParse);
+
 	VERIFY(SetConnectionReserved(pSocketObj, pHttpObj));
 }
 // ------------------------------------------------------------------------------------------------------------- //
@@ -42,10 +42,10 @@ public:
 	using __super::SendPackets;
 	using __super::Disconnect;
 	using __super::HasStarted;
-	using __super::GetFreeSocketObjLockTime;
 	using __super::GetFreeSocketObjPool;
 	using __super::GetFreeSocketObjHold;
 	using __super::GetPendingDataLength;
+	using __super::PauseReceive;
 
 	using __super::IsSecure;
 	using __super::FireHandShake;
@@ -71,6 +71,9 @@ public:
 	virtual BOOL SendResponse(CONNID dwConnID, USHORT usStatusCode, LPCSTR lpszDesc = nullptr, const THeader lpHeaders[] = nullptr, int iHeaderCount = 0, const BYTE* pData = nullptr, int iLength = 0);
 	virtual BOOL SendLocalFile(CONNID dwConnID, LPCSTR lpszFileName, USHORT usStatusCode = HSC_OK, LPCSTR lpszDesc = nullptr, const THeader lpHeaders[] = nullptr, int iHeaderCount = 0);
 	virtual BOOL SendChunkData(CONNID dwConnID, const BYTE* pData = nullptr, int iLength = 0, LPCSTR lpszExtensions = nullptr);
+	virtual BOOL SendPipelineResponse(CONNID dwConnID, DWORD dwSeq, USHORT usStatusCode, LPCSTR lpszDesc = nullptr, const THeader lpHeaders[] = nullptr, int iHeaderCount = 0, const BYTE* pData = nullptr, int iLength = 0);
+	virtual BOOL SendStreamResponse(CONNID dwConnID, DWORD dwStreamID, USHORT usStatusCode, LPCSTR lpszDesc = nullptr, const THeader lpHeaders[] = nullptr, int iHeaderCount = 0, const BYTE* pData = nullptr, int iLength = 0);
+	virtual BOOL SendStreamChunkData(CONNID dwConnID, DWORD dwStreamID, const BYTE* pData = nullptr, int iLength = 0);
 
 	virtual BOOL Release(CONNID dwConnID);
 
@@ -83,10 +86,18 @@ public:
 	virtual void SetHttpAutoStart(BOOL bAutoStart)				{ENSURE_HAS_STOPPED(); m_bHttpAutoStart = bAutoStart;}
 	virtual void SetLocalVersion(EnHttpVersion enLocalVersion)	{ENSURE_HAS_STOPPED(); m_enLocalVersion = enLocalVersion;}
 	virtual void SetReleaseDelay(DWORD dwReleaseDelay)			{ENSURE_HAS_STOPPED(); m_dwReleaseDelay = dwReleaseDelay;}
+	virtual void SetFastParse(BOOL bFastParse)					{ENSURE_HAS_STOPPED(); m_bFastParse = bFastParse;}
+	virtual void SetMaxPipelineRequests(DWORD dwMaxPipelineRequests)	{ENSURE_HAS_STOPPED(); m_dwMaxPipelineRequests = dwMaxPipelineRequests;}
+	virtual void SetHttp2Support(BOOL bSupport)					{ENSURE_HAS_STOPPED(); m_bHttp2Support = bSupport;}
+	virtual void SetHttp2MaxConcurrentStreams(DWORD dwMaxConcurrentStreams)	{ENSURE_HAS_STOPPED(); m_dwHttp2MaxConcurrentStreams = dwMaxConcurrentStreams;}
 
 	virtual BOOL IsHttpAutoStart			()	{return m_bHttpAutoStart;}
 	virtual EnHttpVersion GetLocalVersion	()	{return m_enLocalVersion;}
 	virtual DWORD GetReleaseDelay			()	{return m_dwReleaseDelay;}
+	virtual BOOL IsFastParse				()	{return m_bFastParse;}
+	virtual DWORD GetMaxPipelineRequests	()	{return m_dwMaxPipelineRequests;}
+	virtual BOOL IsHttp2Support				()	{return m_bHttp2Support;}
+	virtual DWORD GetHttp2MaxConcurrentStreams()	{return m_dwHttp2MaxConcurrentStreams;}
 
 	virtual BOOL IsUpgrade(CONNID dwConnID);
 	virtual BOOL IsKeepAlive(CONNID dwConnID);
@@ -110,6 +121,10 @@ public:
 	virtual USHORT GetUrlFieldSet(CONNID dwConnID);
 	virtual LPCSTR GetUrlField(CONNID dwConnID, EnHttpUrlField enField);
 	virtual LPCSTR GetMethod(CONNID dwConnID);
+	virtual DWORD GetRequestSeq(CONNID dwConnID);
+	virtual BOOL IsHttp2(CONNID dwConnID);
+	virtual DWORD GetStreamID(CONNID dwConnID);
+	virtual BOOL GetStreamHeader(CONNID dwConnID, DWORD dwStreamID, LPCSTR lpszName, LPSTR lpszValue, int& iValueLen);
 
 	virtual BOOL GetWSMessageState(CONNID dwConnID, BOOL* lpbFinal, BYTE* lpiReserved, BYTE* lpiOperationCode, LPCBYTE* lpszMask, ULONGLONG* lpullBodyLen, ULONGLONG* lpullBodyRemain);
 
@@ -124,22 +139,25 @@ private:
 	virtual EnHandleResult DoFireAccept(TSocketObj* pSocketObj);
 	virtual EnHandleResult DoFireHandShake(TSocketObj* pSocketObj);
 	virtual EnHandleResult DoFireReceive(TSocketObj* pSocketObj, const BYTE* pData, int iLength);
+	virtual EnHandleResult DoFireReceive(TSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount)
+		{return __super::DoFireReceiveEach(pSocketObj, pBuffers, iCount);}
 	virtual EnHandleResult DoFireClose(TSocketObj* pSocketObj, EnSocketOperation enOperation, int iErrorCode);
 	virtual EnHandleResult DoFireShutdown();
+	virtual BOOL BeforeUnpause(TSocketObj* pSocketObj);
 
 	EnHandleResult DoFireSuperReceive(TSocketObj* pSocketObj, const BYTE* pData, int iLength)
 		{return __super::DoFireReceive(pSocketObj, pData, iLength);}
+	BOOL SendHttp2Data(TSocketObj* pSocketObj, const BYTE* pData, int iLength)
+		{WSABUF buffer = {(UINT)iLength, (LPBYTE)pData}; return SendPackets(pSocketObj->connID, &buffer, 1);}
 
-	EnHttpParseResult FireMessageBegin(TSocketObj* pSocketObj)
-		{return m_pListener->OnMessageBegin((IHttpServer*)this, pSocketObj->connID);}
+	EnHttpParseResult FireMessageBegin(TSocketObj* pSocketObj);
 	EnHttpParseResult FireRequestLine(TSocketObj* pSocketObj, LPCSTR lpszMethod, LPCSTR lpszUrl)
 		{return m_pListener->OnRequestLine((IHttpServer*)this, pSocketObj->connID, lpszMethod, lpszUrl);}
 	EnHttpParseResult FireStatusLine(TSocketObj* pSocketObj, USHORT usStatusCode, LPCSTR lpszDesc)
 		{return m_pListener->OnStatusLine((IHttpServer*)this, pSocketObj->connID, usStatusCode, lpszDesc);}
 	EnHttpParseResult FireHeader(TSocketObj* pSocketObj, LPCSTR lpszName, LPCSTR lpszValue)
 		{return m_pListener->OnHeader((IHttpServer*)this, pSocketObj->connID, lpszName, lpszValue);}
-	EnHttpParseResult FireHeadersComplete(TSocketObj* pSocketObj)
-		{return m_pListener->OnHeadersComplete((IHttpServer*)this, pSocketObj->connID);}
+	EnHttpParseResult FireHeadersComplete(TSocketObj* pSocketObj);
 	EnHttpParseResult FireBody(TSocketObj* pSocketObj, const BYTE* pData, int iLength)
 		{return m_pListener->OnBody((IHttpServer*)this, pSocketObj->connID, pData, iLength);}
 	EnHttpParseResult FireChunkHeader(TSocketObj* pSocketObj, int iLength)
@@ -180,6 +198,10 @@ public:
 	, m_bHttpAutoStart	(TRUE)
 	, m_enLocalVersion	(DEFAULT_HTTP_VERSION)
 	, m_dwReleaseDelay	(DEFAULT_HTTP_RELEASE_DELAY)
+	, m_bFastParse		(FALSE)
+	, m_dwMaxPipelineRequests(0)
+	, m_bHttp2Support	(FALSE)
+	, m_dwHttp2MaxConcurrentStreams(DEFAULT_HTTP2_MAX_CONCURRENT_STREAMS)
 	{
 
 	}
@@ -199,6 +221,10 @@ private:
 	DWORD						m_dwReleaseDelay;
 
 	BOOL						m_bHttpAutoStart;
+	BOOL						m_bFastParse;
+	DWORD						m_dwMaxPipelineRequests;
+	BOOL						m_bHttp2Support;
+	DWORD						m_dwHttp2MaxConcurrentStreams;
 
 	CCASQueue<TDyingConnection>	m_lsDyingQueue;
 
@@ -44,7 +44,6 @@ void CSSLAgent::PrepareStart()
 	m_sslPool.SetItemCapacity	(GetSocketBufferSize());
 	m_sslPool.SetItemPoolSize	(GetFreeBufferObjPool());
 	m_sslPool.SetItemPoolHold	(GetFreeBufferObjHold());
-	m_sslPool.SetSessionLockTime(GetFreeSocketObjLockTime());
 	m_sslPool.SetSessionPoolSize(GetFreeSocketObjPool());
 	m_sslPool.SetSessionPoolHold(GetFreeSocketObjHold());
 
@@ -68,6 +67,8 @@ void CSSLAgent::OnWorkerThreadEnd(THR_ID dwThreadID)
 
 BOOL CSSLAgent::SendPackets(CONNID dwConnID, const WSABUF pBuffers[], int iCount)
 {
+	CEpochLock epochlock;
+
 	ASSERT(pBuffers && iCount > 0);
 
 	TAgentSocketObj* pSocketObj = FindSocketObj(dwConnID);
@@ -123,6 +124,8 @@ EnHandleResult CSSLAgent::FireClose(TAgentSocketObj* pSocketObj, EnSocketOperati
 
 BOOL CSSLAgent::StartSSLHandShake(CONNID dwConnID)
 {
+	CEpochLock epochlock;
+
 	if(IsSSLAutoHandShake())
 	{
 		::SetLastError(ERROR_INVALID_OPERATION);
@@ -186,6 +189,8 @@ void CSSLAgent::DoSSLHandShake(TAgentSocketObj* pSocketObj)
 
 BOOL CSSLAgent::GetSSLSessionInfo(CONNID dwConnID, EnSSLSessionInfo enInfo, LPVOID* lppInfo)
 {
+	CEpochLock epochlock;
+
 	ASSERT(lppInfo != nullptr);
 
 	*lppInfo					= nullptr;
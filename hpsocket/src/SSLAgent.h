@@ -53,12 +53,16 @@ public:
 	virtual void SetSSLCipherList	(LPCTSTR lpszCipherList){ENSURE_HAS_STOPPED(); m_sslCtx.SetCipherList(lpszCipherList);}
 	virtual BOOL IsSSLAutoHandShake	()						{return m_bSSLAutoHandShake;}
 	virtual LPCTSTR GetSSLCipherList()						{return m_sslCtx.GetCipherList();}
+	virtual void SetSSLAlpnProtocols(LPCTSTR lpszProtocols)	{ENSURE_HAS_STOPPED(); m_sslCtx.SetAlpnProtocols(lpszProtocols);}
+	virtual LPCTSTR GetSSLAlpnProtocols()					{return m_sslCtx.GetAlpnProtocols();}
 
 	virtual BOOL GetSSLSessionInfo(CONNID dwConnID, EnSSLSessionInfo enInfo, LPVOID* lppInfo);
 
 protected:
 	virtual EnHandleResult FireConnect(TAgentSocketObj* pSocketObj);
 	virtual EnHandleResult FireReceive(TAgentSocketObj* pSocketObj, const BYTE* pData, int iLength);
+	virtual EnHandleResult FireReceive(TAgentSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount)
+		{return FireReceiveEach(pSocketObj, pBuffers, iCount);}
 	virtual EnHandleResult FireClose(TAgentSocketObj* pSocketObj, EnSocketOperation enOperation, int iErrorCode);
 
 	virtual BOOL CheckParams();
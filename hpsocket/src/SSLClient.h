@@ -52,6 +52,8 @@ public:
 	virtual void SetSSLCipherList	(LPCTSTR lpszCipherList){ENSURE_HAS_STOPPED(); m_sslCtx.SetCipherList(lpszCipherList);}
 	virtual BOOL IsSSLAutoHandShake	()						{return m_bSSLAutoHandShake;}
 	virtual LPCTSTR GetSSLCipherList()						{return m_sslCtx.GetCipherList();}
+	virtual void SetSSLAlpnProtocols(LPCTSTR lpszProtocols)	{ENSURE_HAS_STOPPED(); m_sslCtx.SetAlpnProtocols(lpszProtocols);}
+	virtual LPCTSTR GetSSLAlpnProtocols()					{return m_sslCtx.GetAlpnProtocols();}
 
 	virtual BOOL GetSSLSessionInfo(EnSSLSessionInfo enInfo, LPVOID* lppInfo);
 
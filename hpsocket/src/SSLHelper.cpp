@@ -38,12 +38,21 @@
 	CSimpleRWLock* CSSLInitializer::sm_pcsLocks	= nullptr;
 #endif
 
+#if OPENSSL_VERSION_NUMBER < OPENSSL_VERSION_1_1_0
+	#define BIO_get_data(bio)			((bio)->ptr)
+	#define BIO_set_data(bio, data)		((bio)->ptr = (data))
+	#define BIO_set_init(bio, init)		((bio)->init = (init))
+	#define BIO_get_new_index()			(BIO_TYPE_SOURCE_SINK | 0x60)
+	#define SSL_CTX_up_ref(ctx)			CRYPTO_add(&(ctx)->references, 1, CRYPTO_LOCK_SSL_CTX)
+#endif
+
+BIO_METHOD* CSSLSession::sm_pChannelMethod		= nullptr;
+
 CSSLInitializer CSSLInitializer::sm_instance;
 
 const DWORD CSSLSessionPool::DEFAULT_ITEM_CAPACITY		= CItemPool::DEFAULT_ITEM_CAPACITY;
 const DWORD CSSLSessionPool::DEFAULT_ITEM_POOL_SIZE		= CItemPool::DEFAULT_POOL_SIZE;
 const DWORD CSSLSessionPool::DEFAULT_ITEM_POOL_HOLD		= CItemPool::DEFAULT_POOL_HOLD;
-const DWORD CSSLSessionPool::DEFAULT_SESSION_LOCK_TIME	= DEFAULT_OBJECT_CACHE_LOCK_TIME;
 const DWORD CSSLSessionPool::DEFAULT_SESSION_POOL_SIZE	= DEFAULT_OBJECT_CACHE_POOL_SIZE;
 const DWORD CSSLSessionPool::DEFAULT_SESSION_POOL_HOLD	= DEFAULT_OBJECT_CACHE_POOL_HOLD;
 
@@ -72,10 +81,14 @@ CSSLInitializer::CSSLInitializer()
 #else
 	OPENSSL_init_ssl(OPENSSL_INIT_SSL_DEFAULT, nullptr);
 #endif
+
+	VERIFY(CSSLSession::CreateChannelMethod());
 }
 
 CSSLInitializer::~CSSLInitializer()
 {
+	CSSLSession::DestroyChannelMethod();
+
 	CleanupThreadState();
 
 #if OPENSSL_VERSION_NUMBER < OPENSSL_VERSION_1_1_0
@@ -164,7 +177,7 @@ BOOL CSSLContext::Initialize(EnSSLSessionMode enSessionMode, int iVerifyMode, BO
 	m_enSessionMode	= enSessionMode;
 
 	if(AddContext(iVerifyMode, bMemory, lpPemCert, lpPemKey, lpKeyPasswod, lpCAPemCert) == 0)
-		m_sslCtx = GetContext(0);
+		m_sslCtx = m_lsSslCtxs[0];
 	else
 	{
 		EXECUTE_RESTORE_ERROR(Cleanup());
@@ -195,6 +208,48 @@ int CSSLContext::AddServerContext(int iVerifyMode, BOOL bMemory, LPVOID lpPemCer
 	return AddContext(iVerifyMode, bMemory, lpPemCert, lpPemKey, lpKeyPasswod, lpCAPemCert);
 }
 
+int CSSLContext::AddServerContextLazy(int iVerifyMode, LPCTSTR lpszPemCertFile, LPCTSTR lpszPemKeyFile, LPCTSTR lpszKeyPassword, LPCTSTR lpszCAPemCertFileOrPath)
+{
+	ASSERT(IsValid());
+
+	if(!IsValid())
+	{
+		::SetLastError(ERROR_INVALID_STATE);
+		return -1;
+	}
+
+	if(m_enSessionMode != SSL_SM_SERVER)
+	{
+		::SetLastError(ERROR_INVALID_OPERATION);
+		return -1;
+	}
+
+	if(::IsStrEmpty(lpszPemCertFile) || ::IsStrEmpty(lpszPemKeyFile) || !CFile::IsFile(lpszPemCertFile) || !CFile::IsFile(lpszPemKeyFile))
+	{
+		::SetLastError(ERROR_INVALID_PARAMETER);
+		return -1;
+	}
+
+	TLazyContext* pLazy = new TLazyContext;
+
+	pLazy->iVerifyMode				= iVerifyMode;
+	pLazy->strPemCertFile			= lpszPemCertFile;
+	pLazy->strPemKeyFile			= lpszPemKeyFile;
+	pLazy->strKeyPassword			= ::SafeStr(lpszKeyPassword);
+	pLazy->strCAPemCertFileOrPath	= ::SafeStr(lpszCAPemCertFileOrPath);
+	pLazy->sslCtx					= nullptr;
+	pLazy->itLru					= m_lsLazyLru.end();
+
+	CCriSecLock locallock(m_csLazy);
+
+	int iIndex = (int)m_lsSslCtxs.size();
+
+	m_lsSslCtxs.push_back(nullptr);
+	m_lsLazyCtxs.push_back(pLazy);
+
+	return iIndex;
+}
+
 BOOL CSSLContext::BindServerName(LPCTSTR lpszServerName, int iContextIndex)
 {
 	ASSERT(lpszServerName && iContextIndex >= 0 && !::IsIPAddress(lpszServerName));
@@ -205,10 +260,24 @@ BOOL CSSLContext::BindServerName(LPCTSTR lpszServerName, int iContextIndex)
 		return FALSE;
 	}
 
-	int iLen		= lstrlen(lpszServerName);
-	LPCTSTR lpszSep	= ::StrChr(lpszServerName, SSL_DOMAIN_SEP_CHAR);
+	BOOL bWildcard	= (lpszServerName[0] == SSL_DOMAIN_WILDCARD[0] && lpszServerName[1] == SSL_DOMAIN_SEP_CHAR);
+	LPCTSTR lpszName= bWildcard ? (lpszServerName + 2) : lpszServerName;
+
+	int iLen		= lstrlen(lpszName);
+	LPCTSTR lpszSep	= ::StrChr(lpszName, SSL_DOMAIN_SEP_CHAR);
+
+	if(lpszSep == nullptr || lpszSep == lpszName || lpszSep == (lpszName + iLen - 1))
+	{
+		::SetLastError(ERROR_INVALID_PARAMETER);
+		return FALSE;
+	}
+
+	int iDepth = 1;
+
+	for(; lpszSep != nullptr; lpszSep = ::StrChr(lpszSep + 1, SSL_DOMAIN_SEP_CHAR))
+		++iDepth;
 
-	if(lpszSep == nullptr || lpszSep == lpszServerName || lpszSep == (lpszServerName + iLen - 1))
+	if(iDepth >= SSL_DOMAIN_MAX_LABELS)
 	{
 		::SetLastError(ERROR_INVALID_PARAMETER);
 		return FALSE;
@@ -221,17 +290,37 @@ BOOL CSSLContext::BindServerName(LPCTSTR lpszServerName, int iContextIndex)
 		::SetLastError(ERROR_INVALID_INDEX);
 		return FALSE;
 	}
-	
-	m_sslServerNames[lpszServerName] = iContextIndex;
+
+	// 精确匹配表只保存普通域名；普通域名和通配域名都进入后缀表（后绑定的覆盖先绑定的）
+	if(!bWildcard)
+		m_sslServerNames[lpszName] = iContextIndex;
+
+	m_sslSuffixNames[lpszName]	= iContextIndex;
+	m_ullSuffixDepths		   |= (1ULL << iDepth);
 
 	return TRUE;
 }
 
 int CSSLContext::AddContext(int iVerifyMode, BOOL bMemory, LPVOID lpPemCert, LPVOID lpPemKey, LPVOID lpKeyPasswod, LPVOID lpCAPemCert)
+{
+	SSL_CTX* sslCtx = CreateContext(iVerifyMode, bMemory, lpPemCert, lpPemKey, lpKeyPasswod, lpCAPemCert);
+
+	if(sslCtx == nullptr)
+		return -1;
+
+	int iIndex = (int)m_lsSslCtxs.size();
+
+	m_lsSslCtxs.push_back(sslCtx);
+	m_lsLazyCtxs.push_back(nullptr);
+
+	return iIndex;
+}
+
+SSL_CTX* CSSLContext::CreateContext(int iVerifyMode, BOOL bMemory, LPVOID lpPemCert, LPVOID lpPemKey, LPVOID lpKeyPasswod, LPVOID lpCAPemCert)
 {
 	USES_CONVERSION;
 
-	int iIndex = -1;
+	BOOL isOK = FALSE;
 
 #if OPENSSL_VERSION_NUMBER < OPENSSL_VERSION_1_1_0
 	SSL_CTX* sslCtx	= SSL_CTX_new(SSLv23_method());
@@ -242,6 +331,14 @@ int CSSLContext::AddContext(int iVerifyMode, BOOL bMemory, LPVOID lpPemCert, LPV
 	SSL_CTX_set_quiet_shutdown(sslCtx, 1);
 	SSL_CTX_set_verify(sslCtx, iVerifyMode, nullptr);
 
+	if(!m_strAlpnWire.IsEmpty())
+	{
+		if(m_enSessionMode == SSL_SM_SERVER)
+			SSL_CTX_set_alpn_select_cb(sslCtx, InternalAlpnSelectCallback, this);
+		else
+			SSL_CTX_set_alpn_protos(sslCtx, (const BYTE*)m_strAlpnWire.c_str(), (UINT)m_strAlpnWire.GetLength());
+	}
+
 	if(!SSL_CTX_set_cipher_list(sslCtx, T2CA(m_strCipherList)))
 		::SetLastError(ERROR_EMPTY);
 	else
@@ -254,17 +351,100 @@ int CSSLContext::AddContext(int iVerifyMode, BOOL bMemory, LPVOID lpPemCert, LPV
 			SSL_CTX_set_session_id_context(sslCtx, (BYTE*)&session_id_context, sizeof(session_id_context));
 		}
 
-		if(LoadCertAndKey(sslCtx, iVerifyMode, bMemory, lpPemCert, lpPemKey, lpKeyPasswod, lpCAPemCert))
-		{
-			iIndex = (int)m_lsSslCtxs.size();
-			m_lsSslCtxs.push_back(sslCtx);
-		}
+		isOK = LoadCertAndKey(sslCtx, iVerifyMode, bMemory, lpPemCert, lpPemKey, lpKeyPasswod, lpCAPemCert);
 	}
 
-	if(iIndex < 0)
+	if(!isOK)
+	{
 		EXECUTE_RESTORE_ERROR(SSL_CTX_free(sslCtx));
+		sslCtx = nullptr;
+	}
 	
-	return iIndex;
+	return sslCtx;
+}
+
+SSL_CTX* CSSLContext::AcquireContext(int i)
+{
+	if(i < 0 || i >= (int)m_lsSslCtxs.size())
+		return nullptr;
+
+	SSL_CTX* sslCtx		= m_lsSslCtxs[i];
+	TLazyContext* pLazy	= m_lsLazyCtxs[i];
+
+	if(pLazy == nullptr)
+	{
+		SSL_CTX_up_ref(sslCtx);
+		return sslCtx;
+	}
+
+	{
+		CCriSecLock locallock(m_csLazy);
+
+		sslCtx = pLazy->sslCtx;
+
+		if(sslCtx != nullptr)
+		{
+			m_lsLazyLru.splice(m_lsLazyLru.begin(), m_lsLazyLru, pLazy->itLru);
+
+			// 调用者持有一个引用，防止 SSL_set_SSL_CTX() 之前被其它线程淘汰
+			SSL_CTX_up_ref(sslCtx);
+
+			return sslCtx;
+		}
+	}
+
+	// 在锁外读取证书文件，避免磁盘 IO 阻塞其它连接的 SNI 回调
+	SSL_CTX* sslNewCtx = LoadLazyContext(pLazy);
+
+	if(sslNewCtx == nullptr)
+		return nullptr;
+
+	CCriSecLock locallock(m_csLazy);
+
+	sslCtx = pLazy->sslCtx;
+
+	// 加载期间其它线程已加载同一证书，则使用已缓存的对象
+	if(sslCtx != nullptr)
+	{
+		m_lsLazyLru.splice(m_lsLazyLru.begin(), m_lsLazyLru, pLazy->itLru);
+		SSL_CTX_free(sslNewCtx);
+	}
+	else
+	{
+		sslCtx = sslNewCtx;
+		CacheLazyContext(i, pLazy, sslCtx);
+	}
+
+	SSL_CTX_up_ref(sslCtx);
+
+	return sslCtx;
+}
+
+SSL_CTX* CSSLContext::LoadLazyContext(TLazyContext* pLazy)
+{
+	LPCTSTR lpszKeyPassword	= pLazy->strKeyPassword.IsEmpty() ? nullptr : (LPCTSTR)pLazy->strKeyPassword;
+	LPCTSTR lpszCAPemCert	= pLazy->strCAPemCertFileOrPath.IsEmpty() ? nullptr : (LPCTSTR)pLazy->strCAPemCertFileOrPath;
+
+	return CreateContext(pLazy->iVerifyMode, FALSE, (LPVOID)(LPCTSTR)pLazy->strPemCertFile, (LPVOID)(LPCTSTR)pLazy->strPemKeyFile, (LPVOID)lpszKeyPassword, (LPVOID)lpszCAPemCert);
+}
+
+void CSSLContext::CacheLazyContext(int i, TLazyContext* pLazy, SSL_CTX* sslCtx)
+{
+	while(m_dwLazyCacheSize > 0 && m_lsLazyLru.size() >= m_dwLazyCacheSize)
+	{
+		TLazyContext* pEvict = m_lsLazyCtxs[m_lsLazyLru.back()];
+
+		// 已建立的 SSL 连接持有各自的引用，这里只释放缓存的引用
+		SSL_CTX_free(pEvict->sslCtx);
+
+		pEvict->sslCtx	= nullptr;
+		pEvict->itLru	= m_lsLazyLru.end();
+
+		m_lsLazyLru.pop_back();
+	}
+
+	pLazy->sslCtx	= sslCtx;
+	pLazy->itLru	= m_lsLazyLru.insert(m_lsLazyLru.begin(), i);
 }
 
 BOOL CSSLContext::LoadCertAndKey(SSL_CTX* sslCtx, int iVerifyMode, BOOL bMemory, LPVOID lpPemCert, LPVOID lpPemKey, LPVOID lpKeyPasswod, LPVOID lpCAPemCert)
@@ -725,10 +905,27 @@ void CSSLContext::Cleanup()
 		int iCount = (int)m_lsSslCtxs.size();
 
 		for(int i = 0; i < iCount; i++)
-			SSL_CTX_free(m_lsSslCtxs[i]);
+		{
+			TLazyContext* pLazy = m_lsLazyCtxs[i];
+
+			if(pLazy == nullptr)
+				SSL_CTX_free(m_lsSslCtxs[i]);
+			else
+			{
+				if(pLazy->sslCtx != nullptr)
+					SSL_CTX_free(pLazy->sslCtx);
+
+				delete pLazy;
+			}
+		}
 
 		m_lsSslCtxs.clear();
+		m_lsLazyCtxs.clear();
+		m_lsLazyLru.clear();
 		m_sslServerNames.clear();
+		m_sslSuffixNames.clear();
+
+		m_ullSuffixDepths = 0;
 
 		m_sslCtx = nullptr;
 	}
@@ -775,7 +972,7 @@ int CSSLContext::InternalServerNameCallback(SSL* ssl, int* ad, void* arg)
 		return SSL_TLSEXT_ERR_ALERT_FATAL;
 	}
 
-	SSL_CTX* sslCtx = pThis->GetContext(iIndex);
+	SSL_CTX* sslCtx = pThis->AcquireContext(iIndex);
 
 	if(sslCtx == nullptr)
 	{
@@ -784,29 +981,85 @@ int CSSLContext::InternalServerNameCallback(SSL* ssl, int* ad, void* arg)
 	}
 
 	SSL_set_SSL_CTX(ssl, sslCtx);
+	SSL_CTX_free(sslCtx);
+
+	return SSL_TLSEXT_ERR_OK;
+}
+
+void CSSLContext::SetAlpnProtocols(LPCTSTR lpszProtocols)
+{
+	USES_CONVERSION;
+
+	m_strAlpnProtocols = lpszProtocols ? lpszProtocols : _T("");
+	m_strAlpnWire.Empty();
+
+	/* 转换为 ALPN 协议格式：每个协议名称前加 1 字节长度 */
+	LPCSTR lpszList = T2CA(m_strAlpnProtocols);
+
+	for(LPCSTR lpszBegin = lpszList; *lpszBegin != 0;)
+	{
+		LPCSTR lpszEnd = strchr(lpszBegin, ',');
+
+		if(lpszEnd == nullptr)
+			lpszEnd = lpszBegin + strlen(lpszBegin);
+
+		int iLength = (int)(lpszEnd - lpszBegin);
+
+		if(iLength > 0 && iLength <= 255)
+		{
+			m_strAlpnWire.push_back((char)iLength);
+			m_strAlpnWire.append(lpszBegin, iLength);
+		}
+
+		lpszBegin = (*lpszEnd == ',') ? lpszEnd + 1 : lpszEnd;
+	}
+}
+
+int CSSLContext::InternalAlpnSelectCallback(SSL* ssl, const BYTE** out, BYTE* outlen, const BYTE* in, UINT inlen, void* arg)
+{
+	CSSLContext* pThis = (CSSLContext*)arg;
+
+	/* 按服务端的优先级选择协议，没有共同支持的协议时不使用 ALPN */
+	if(SSL_select_next_proto((BYTE**)out, outlen, (const BYTE*)pThis->m_strAlpnWire.c_str(), (UINT)pThis->m_strAlpnWire.GetLength(), in, inlen) != OPENSSL_NPN_NEGOTIATED)
+		return SSL_TLSEXT_ERR_NOACK;
 
 	return SSL_TLSEXT_ERR_OK;
 }
 
 int __HP_CALL CSSLContext::DefaultServerNameCallback(LPCTSTR lpszServerName, PVOID pContext)
 {
-	CSSLContext* pThis = (CSSLContext*)pContext;
+	return ((CSSLContext*)pContext)->FindServerName(lpszServerName);
+}
 
-	if(pThis->m_sslServerNames.empty())
+int CSSLContext::FindServerName(LPCTSTR lpszServerName) const
+{
+	if(m_sslSuffixNames.empty())
 		return 0;
 
-	LPCTSTR lpszTmp = lpszServerName;
-	LPCTSTR lpszSep = ::StrChr(lpszTmp, SSL_DOMAIN_SEP_CHAR);
+	CServerNameMap::const_iterator it = m_sslServerNames.find(lpszServerName);
+
+	if(it != m_sslServerNames.end())
+		return it->second;
+
+	int iCount = 0;
 
-	while(lpszSep != nullptr)
+	for(LPCTSTR lpszSep = ::StrChr(lpszServerName, SSL_DOMAIN_SEP_CHAR); lpszSep != nullptr; lpszSep = ::StrChr(lpszSep + 1, SSL_DOMAIN_SEP_CHAR))
+		++iCount;
+
+	// 由长到短只探测绑定过的后缀层级，最具体的绑定优先（绑定的层级都小于 SSL_DOMAIN_MAX_LABELS，更深的后缀直接跳过）
+	int i = 0;
+
+	for(LPCTSTR lpszSep = ::StrChr(lpszServerName, SSL_DOMAIN_SEP_CHAR); lpszSep != nullptr; lpszSep = ::StrChr(lpszSep + 1, SSL_DOMAIN_SEP_CHAR), i++)
 	{
-		CServerNameMap::const_iterator it = pThis->m_sslServerNames.find(lpszTmp);
+		int iDepth = iCount - i;
 
-		if(it != pThis->m_sslServerNames.end())
-			return it->second;
+		if(iDepth >= SSL_DOMAIN_MAX_LABELS || (m_ullSuffixDepths & (1ULL << iDepth)) == 0)
+			continue;
+
+		it = m_sslSuffixNames.find(lpszSep + 1);
 
-		lpszTmp = (lpszSep + 1);
-		lpszSep = ::StrChr(lpszTmp, SSL_DOMAIN_SEP_CHAR);
+		if(it != m_sslSuffixNames.end())
+			return it->second;
 	}
 
 	return 0;
@@ -814,10 +1067,25 @@ int __HP_CALL CSSLContext::DefaultServerNameCallback(LPCTSTR lpszServerName, PVO
 
 SSL_CTX* CSSLContext::GetContext(int i) const
 {
-	SSL_CTX* sslCtx = nullptr;
+	if(i < 0 || i >= (int)m_lsSslCtxs.size())
+		return nullptr;
+
+	SSL_CTX* sslCtx		= m_lsSslCtxs[i];
+	TLazyContext* pLazy	= m_lsLazyCtxs[i];
+
+	if(pLazy == nullptr)
+	{
+		SSL_CTX_up_ref(sslCtx);
+		return sslCtx;
+	}
 
-	if(i >= 0 && i < (int)m_lsSslCtxs.size())
-		sslCtx = m_lsSslCtxs[i];
+	// 在锁内增加引用，防止返回后被 LRU 淘汰释放
+	CCriSecLock locallock(m_csLazy);
+
+	sslCtx = pLazy->sslCtx;
+
+	if(sslCtx != nullptr)
+		SSL_CTX_up_ref(sslCtx);
 
 	return sslCtx;
 }
@@ -825,23 +1093,25 @@ SSL_CTX* CSSLContext::GetContext(int i) const
 BOOL CSSLSession::WriteRecvChannel(const BYTE* pData, int iLength)
 {
 	ASSERT(pData && iLength > 0);
+	ASSERT(m_iRecvLength == 0);
 
-	BOOL isOK = TRUE;
-	int bytes = BIO_write(m_bioRecv, pData, iLength);
-
-	if(bytes > 0)
-		ASSERT(bytes == iLength);
-	else if(!BIO_should_retry(m_bioRecv))
-	{
-		::SetLastError(ERROR_INVALID_DATA);
-		isOK = FALSE;
-	}
+	m_pRecvData		= pData;
+	m_iRecvLength	= iLength;
 
-	return isOK;
+	return TRUE;
 }
 
 BOOL CSSLSession::ReadRecvChannel()
 {
+	// SSL_read() 可能产生输出（如：握手消息、Alert），经 ChannelWrite() 投递到发送通道，必须与发送操作互斥
+	CCriSecLock locallock(m_csSend);
+
+	if(!IsValid())
+	{
+		::SetLastError(ERROR_INVALID_STATE);
+		return FALSE;
+	}
+
 	BOOL isOK = TRUE;
 	int bytes = SSL_read(m_ssl, m_bufRecv.buf, m_pitRecv->Capacity());
 
@@ -858,6 +1128,16 @@ BOOL CSSLSession::ReadRecvChannel()
 	return isOK;
 }
 
+void CSSLSession::FinishRecvChannel()
+{
+	// 接收缓冲区属于工作线程，SSL 未消费完的密文必须转存
+	if(m_iRecvLength > 0)
+		m_lsRecv.Cat(m_pRecvData, m_iRecvLength);
+
+	m_pRecvData		= nullptr;
+	m_iRecvLength	= 0;
+}
+
 BOOL CSSLSession::WriteSendChannel(const BYTE* pData, int iLength)
 {
 	ASSERT(IsReady());
@@ -868,6 +1148,11 @@ BOOL CSSLSession::WriteSendChannel(const BYTE* pData, int iLength)
 
 	if(bytes > 0)
 		ASSERT(bytes == iLength);
+	else if(m_bSendBroken)
+	{
+		::SetLastError(ERROR_INVALID_STATE);
+		isOK = FALSE;
+	}
 	else if(IsFatalError(bytes))
 		isOK = FALSE;
 
@@ -897,39 +1182,224 @@ BOOL CSSLSession::WriteSendChannel(const WSABUF pBuffers[], int iCount)
 	return isOK;
 }
 
-BOOL CSSLSession::ReadSendChannel()
+BOOL CSSLSession::BindSendChannel(Fn_SSLSendChannel fnChannel, PVOID pThis, PVOID pSocketObj)
+{
+	ASSERT(fnChannel && !IsSendChannelBound());
+
+	m_fnSendChannel		= fnChannel;
+	m_pSendThis			= pThis;
+	m_pSendSocketObj	= pSocketObj;
+
+	// 投递绑定前产生的握手数据（如：客户端 ClientHello）
+	return FlushSendChannel();
+}
+
+void CSSLSession::HoldSendChannel()
+{
+	CCriSecLock locallock(m_csSend);
+
+	ASSERT(!m_bSendHeld);
+
+	m_bSendHeld = TRUE;
+}
+
+BOOL CSSLSession::ReleaseSendChannel()
+{
+	CCriSecLock locallock(m_csSend);
+
+	ASSERT(m_bSendHeld);
+
+	m_bSendHeld = FALSE;
+
+	if(!IsSendChannelBound())
+		return !m_bSendBroken;
+
+	return FlushSendChannel();
+}
+
+BOOL CSSLSession::FlushSendChannel()
 {
-	if(BIO_pending(m_bioSend) == 0)
+	while(!m_bSendBroken && !m_lsSend.IsEmpty())
 	{
-		m_bufSend.len = 0;
-		return TRUE;
+		TItemPtr itPtr(m_itPool, m_lsSend.PopFront());
+
+		if(!m_fnSendChannel(m_pSendThis, m_pSendSocketObj, itPtr->Ptr(), itPtr->Size()))
+			m_bSendBroken = TRUE;
 	}
 
-	BOOL isOK = TRUE;
-	int bytes = BIO_read(m_bioSend, m_bufSend.buf, m_pitSend->Capacity());
+	m_lsSend.Release();
 
-	if(bytes > 0)
-		m_bufSend.len = bytes;
-	else if(BIO_should_retry(m_bioSend))
-		m_bufSend.len = 0;
-	else
+	return !m_bSendBroken;
+}
+
+int CSSLSession::ChannelRead(char* pData, int iLength)
+{
+	BIO_clear_retry_flags(m_bio);
+
+	int iRead = 0;
+
+	if(m_lsRecv.Length() > 0)
+		iRead = m_lsRecv.Fetch((BYTE*)pData, iLength);
+
+	if(iRead < iLength && m_iRecvLength > 0)
 	{
-		::SetLastError(ERROR_INVALID_DATA);
-		isOK = FALSE;
+		int iCopy = MIN(m_iRecvLength, iLength - iRead);
+		memcpy(pData + iRead, m_pRecvData, iCopy);
+
+		m_pRecvData		+= iCopy;
+		m_iRecvLength	-= iCopy;
+		iRead			+= iCopy;
 	}
 
-	return isOK;
+	if(iRead == 0)
+	{
+		BIO_set_retry_read(m_bio);
+		return -1;
+	}
+
+	return iRead;
+}
+
+int CSSLSession::ChannelWrite(const char* pData, int iLength)
+{
+	BIO_clear_retry_flags(m_bio);
+
+	if(m_bSendBroken)
+		return -1;
+
+	if(!IsSendChannelBound() || m_bSendHeld)
+		m_lsSend.Cat((const BYTE*)pData, iLength);
+	else if(!m_fnSendChannel(m_pSendThis, m_pSendSocketObj, (const BYTE*)pData, iLength))
+	{
+		m_bSendBroken = TRUE;
+		return -1;
+	}
+
+	return iLength;
+}
+
+int CSSLSession::channel_read(BIO* bio, char* pData, int iLength)
+{
+	CSSLSession* pSession = (CSSLSession*)BIO_get_data(bio);
+
+	if(pSession == nullptr || pData == nullptr || iLength <= 0)
+		return 0;
+
+	return pSession->ChannelRead(pData, iLength);
+}
+
+int CSSLSession::channel_write(BIO* bio, const char* pData, int iLength)
+{
+	CSSLSession* pSession = (CSSLSession*)BIO_get_data(bio);
+
+	if(pSession == nullptr || pData == nullptr || iLength <= 0)
+		return 0;
+
+	return pSession->ChannelWrite(pData, iLength);
+}
+
+int CSSLSession::channel_puts(BIO* bio, const char* lpszData)
+{
+	return channel_write(bio, lpszData, (int)strlen(lpszData));
+}
+
+long CSSLSession::channel_ctrl(BIO* bio, int cmd, long num, void* ptr)
+{
+	CSSLSession* pSession = (CSSLSession*)BIO_get_data(bio);
+
+	switch(cmd)
+	{
+	case BIO_CTRL_FLUSH:
+		return 1;
+	case BIO_CTRL_PENDING:
+		return pSession ? (long)(pSession->m_lsRecv.Length() + pSession->m_iRecvLength) : 0;
+	case BIO_CTRL_WPENDING:
+		return 0;
+	default:
+		return 0;
+	}
+}
+
+int CSSLSession::channel_create(BIO* bio)
+{
+	BIO_set_data(bio, nullptr);
+	BIO_set_init(bio, 1);
+
+	return 1;
+}
+
+int CSSLSession::channel_destroy(BIO* bio)
+{
+	if(bio == nullptr)
+		return 0;
+
+	BIO_set_data(bio, nullptr);
+	BIO_set_init(bio, 0);
+
+	return 1;
+}
+
+BOOL CSSLSession::CreateChannelMethod()
+{
+	ASSERT(sm_pChannelMethod == nullptr);
+
+#if OPENSSL_VERSION_NUMBER < OPENSSL_VERSION_1_1_0
+	static BIO_METHOD s_method =
+	{
+		BIO_get_new_index(),
+		"hpsocket ssl channel",
+		channel_write,
+		channel_read,
+		channel_puts,
+		nullptr,
+		channel_ctrl,
+		channel_create,
+		channel_destroy,
+		nullptr
+	};
+
+	sm_pChannelMethod = &s_method;
+#else
+	sm_pChannelMethod = BIO_meth_new(BIO_get_new_index() | BIO_TYPE_SOURCE_SINK, "hpsocket ssl channel");
+
+	if(sm_pChannelMethod == nullptr)
+		return FALSE;
+
+	BIO_meth_set_write	(sm_pChannelMethod, channel_write);
+	BIO_meth_set_read	(sm_pChannelMethod, channel_read);
+	BIO_meth_set_puts	(sm_pChannelMethod, channel_puts);
+	BIO_meth_set_ctrl	(sm_pChannelMethod, channel_ctrl);
+	BIO_meth_set_create	(sm_pChannelMethod, channel_create);
+	BIO_meth_set_destroy(sm_pChannelMethod, channel_destroy);
+#endif
+
+	return TRUE;
+}
+
+void CSSLSession::DestroyChannelMethod()
+{
+#if OPENSSL_VERSION_NUMBER >= OPENSSL_VERSION_1_1_0
+	if(sm_pChannelMethod != nullptr)
+		BIO_meth_free(sm_pChannelMethod);
+#endif
+
+	sm_pChannelMethod = nullptr;
 }
 
 CSSLSession* CSSLSession::Renew(const CSSLContext& sslCtx, LPCSTR lpszHostName)
 {
 	ASSERT(!IsValid());
 
-	m_ssl		= SSL_new(sslCtx.GetDefaultContext());
-	m_bioSend	= BIO_new(BIO_s_mem());
-	m_bioRecv	= BIO_new(BIO_s_mem());
+	m_ssl	= SSL_new(sslCtx.GetDefaultContext());
+	m_bio	= BIO_new(sm_pChannelMethod);
 
-	SSL_set_bio(m_ssl, m_bioRecv, m_bioSend);
+	BIO_set_data(m_bio, this);
+	SSL_set_bio(m_ssl, m_bio, m_bio);
+
+	m_pitRecv		= m_itPool.PickFreeItem();
+	m_bufRecv.buf	= m_pitRecv->Ptr();
+	m_bSendBroken	= FALSE;
+	m_enStatus		= SSL_HSS_PROC;
 
 	if(sslCtx.GetSessionMode() == SSL_SM_SERVER)
 		SSL_accept(m_ssl);
@@ -943,12 +1413,6 @@ CSSLSession* CSSLSession::Renew(const CSSLContext& sslCtx, LPCSTR lpszHostName)
 		SSL_connect(m_ssl);
 	}
 
-	m_pitSend		= m_itPool.PickFreeItem();
-	m_pitRecv		= m_itPool.PickFreeItem();
-	m_bufSend.buf	= m_pitSend->Ptr();
-	m_bufRecv.buf	= m_pitRecv->Ptr();
-	m_enStatus		= SSL_HSS_PROC;
-
 	return this;
 }
 
@@ -958,24 +1422,34 @@ BOOL CSSLSession::Reset()
 
 	if(IsValid())
 	{
+		CReentrantCriSecLock recvlock(m_csRecv);
 		CCriSecLock locallock(m_csSend);
 
 		if(IsValid())
 		{
-			m_enStatus = SSL_HSS_INIT;
+			m_enStatus		= SSL_HSS_INIT;
+			m_fnSendChannel	= nullptr;
 
 			SSL_shutdown(m_ssl);
 			SSL_free(m_ssl);
 
-			m_itPool.PutFreeItem(m_pitSend);
 			m_itPool.PutFreeItem(m_pitRecv);
 
-			m_pitSend	= nullptr;
-			m_pitRecv	= nullptr;
-			m_ssl		= nullptr;
-			m_bioSend	= nullptr;
-			m_bioRecv	= nullptr;
-			m_dwFreeTime= ::TimeGetTime();
+			m_lsRecv.Release();
+			m_lsSend.Release();
+
+			m_pitRecv			= nullptr;
+			m_ssl				= nullptr;
+			m_bio				= nullptr;
+			m_pRecvData			= nullptr;
+			m_iRecvLength		= 0;
+			m_fnSendChannel		= nullptr;
+			m_pSendThis			= nullptr;
+			m_pSendSocketObj	= nullptr;
+			m_bSendBroken		= FALSE;
+			m_bSendHeld			= FALSE;
+			m_dwFreeTime		= ::TimeGetTime();
+			m_ullFreeEpoch		= CEpochDomain::Retire();
 
 			isOK = TRUE;
 		}
@@ -1135,11 +1609,32 @@ BOOL CSSLSession::GetSessionInfo(EnSSLSessionInfo enInfo, LPVOID* lppInfo)
 			*lppInfo = (LPVOID)(SSL_get0_verified_chain(m_ssl));
 		}
 		break;
+	case SSL_SSI_ALPN_PROTOCOL:
+		{
+			*lppInfo = (LPVOID)(GetAlpnProtocol());
+		}
+		break;
 	}
 
 	return TRUE;
 }
 
+LPCSTR CSSLSession::GetAlpnProtocol()
+{
+	const BYTE* pProtocol	= nullptr;
+	UINT uiLength			= 0;
+
+	if(m_ssl != nullptr)
+		SSL_get0_alpn_selected(m_ssl, &pProtocol, &uiLength);
+
+	if(pProtocol == nullptr || uiLength == 0)
+		m_strAlpnProtocol.Empty();
+	else
+		m_strAlpnProtocol.assign((LPCSTR)pProtocol, uiLength);
+
+	return m_strAlpnProtocol.c_str();
+}
+
 CSSLSession* CSSLSessionPool::PickFreeSession(LPCSTR lpszHostName)
 {
 	DWORD dwIndex;
@@ -1147,7 +1642,7 @@ CSSLSession* CSSLSessionPool::PickFreeSession(LPCSTR lpszHostName)
 
 	if(m_lsFreeSession.TryLock(&pSession, dwIndex))
 	{
-		if(::GetTimeGap32(pSession->GetFreeTime()) >= m_dwSessionLockTime)
+		if(CEpochDomain::IsReclaimable(pSession->GetFreeEpoch()))
 			VERIFY(m_lsFreeSession.ReleaseLock(nullptr, dwIndex));
 		else
 		{
@@ -1191,7 +1686,7 @@ void CSSLSessionPool::Clear()
 
 void CSSLSessionPool::ReleaseGCSession(BOOL bForce)
 {
-	::ReleaseGCObj(m_lsGCSession, m_dwSessionLockTime, bForce);
+	::ReleaseGCObj(m_lsGCSession, bForce);
 }
 
 #endif
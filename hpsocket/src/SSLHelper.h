@@ -45,6 +45,8 @@
  ************************************************************************/
 
 #define SSL_DOMAIN_SEP_CHAR		'.'
+#define SSL_DOMAIN_WILDCARD		_T("*.")
+#define SSL_DOMAIN_MAX_LABELS	64
 
  /************************************************************************
 名称：SSL 握手状态
@@ -106,6 +108,19 @@ class CSSLContext
 {
 	typedef unordered_map<CString, int, cstring_nc_hash_func::hash, cstring_nc_hash_func::equal_to> CServerNameMap;
 
+	/* 延迟加载的 SNI 主机证书：首次命中时才从磁盘加载，常驻数量受 LRU 限制 */
+	struct TLazyContext
+	{
+		int			iVerifyMode;
+		CString		strPemCertFile;
+		CString		strPemKeyFile;
+		CString		strKeyPassword;
+		CString		strCAPemCertFileOrPath;
+
+		SSL_CTX*			sslCtx;
+		list<int>::iterator	itLru;
+	};
+
 public:
 
 	/*
@@ -140,9 +155,28 @@ public:
 	*/
 	int AddServerContext(int iVerifyMode, BOOL bMemory, LPVOID lpPemCert, LPVOID lpPemKey, LPVOID lpKeyPasswod = nullptr, LPVOID lpCAPemCert = nullptr);
 
+	/*
+	* 名称：增加延迟加载的 SNI 主机证书（只用于服务端）
+	* 描述：与 AddServerContext() 类似，但证书文件在首次被 SNI 选中时才加载
+	*		1、常驻内存的延迟加载证书数量受 SetLazyContextCacheSize() 限制，超出时淘汰最久未使用的证书
+	*		2、被淘汰的证书在下次命中时重新加载，已建立的连接不受影响
+	*		
+	* 参数：		iVerifyMode				-- SSL 验证模式（参考 EnSSLVerifyMode）
+	*			lpszPemCertFile			-- 证书文件
+	*			lpszPemKeyFile			-- 私钥文件
+	*			lpszKeyPassword			-- 私钥密码（没有密码则为空）
+	*			lpszCAPemCertFileOrPath	-- CA 证书文件或目录（单向验证可选）
+	*
+	* 返回值：	正数		-- 成功，并返回 SNI 主机证书对应的索引
+	*			负数		-- 失败，可通过 ::GetLastError() 获取失败原因
+	*/
+	int AddServerContextLazy(int iVerifyMode, LPCTSTR lpszPemCertFile, LPCTSTR lpszPemKeyFile, LPCTSTR lpszKeyPassword = nullptr, LPCTSTR lpszCAPemCertFileOrPath = nullptr);
+
 	/*
 	* 名称：绑定 SNI 主机域名
 	* 描述：SSL 服务端在 AddServerContext() 成功后可以调用本方法绑定主机域名到 SNI 主机证书
+	*		1、普通域名（如：hpsocket.org）匹配该域名及其所有子域名，精确匹配优先
+	*		2、通配域名（如：*.hpsocket.org）只匹配子域名
 	*		
 	* 参数：		lpszServerName		-- 主机域名
 	*			iContextIndex		-- SNI 主机证书对应的索引
@@ -164,8 +198,10 @@ public:
 	*/
 	void Cleanup();
 
-	/* 获取 SSL 运行环境 SSL_CTX 对象 */
+	/* 获取 SSL 运行环境 SSL_CTX 对象（返回的对象已增加引用，调用者用完后须调用 SSL_CTX_free() 释放；延迟加载的证书未加载时返回 nullptr） */
 	SSL_CTX* GetContext				(int i) const;
+	/* 查找主机域名绑定的 SNI 主机证书索引（没有绑定则返回 0） */
+	int FindServerName				(LPCTSTR lpszServerName) const;
 	/* 获取 SSL 运行环境默认 SSL_CTX 对象 */
 	SSL_CTX* GetDefaultContext		()		const	{return m_sslCtx;}
 	/* 获取 SSL 运行环境的配置模式，配置模式参考：EnSSLSessionMode */
@@ -178,6 +214,16 @@ public:
 	/* 获取 SSL 加密算法列表 */
 	LPCTSTR GetCipherList()							{return m_strCipherList;}
 
+	/* 设置 ALPN 协议列表（逗号分隔，按优先级排列，如："h2,http/1.1"；必须在 Initialize() 前设置） */
+	void SetAlpnProtocols(LPCTSTR lpszProtocols);
+	/* 获取 ALPN 协议列表 */
+	LPCTSTR GetAlpnProtocols()				const	{return m_strAlpnProtocols;}
+
+	/* 设置延迟加载证书的最大常驻数量（默认：0，不限制） */
+	void SetLazyContextCacheSize(DWORD dwSize)		{m_dwLazyCacheSize = dwSize;}
+	/* 获取延迟加载证书的最大常驻数量 */
+	DWORD GetLazyContextCacheSize()			const	{return m_dwLazyCacheSize;}
+
 public:
 	
 	/*
@@ -197,7 +243,9 @@ public:
 	CSSLContext()
 	: m_strCipherList		(DEFAULT_CIPHER_LIST)
 	, m_enSessionMode		(SSL_SM_SERVER)
+	, m_ullSuffixDepths		(0)
 	, m_sslCtx				(nullptr)
+	, m_dwLazyCacheSize		(0)
 	, m_fnServerNameCallback(nullptr)
 	{
 
@@ -209,6 +257,10 @@ private:
 
 	void SetServerNameCallback(Fn_SNI_ServerNameCallback fn);
 	int AddContext(int iVerifyMode, BOOL bMemory, LPVOID lpPemCert, LPVOID lpPemKey, LPVOID lpKeyPasswod, LPVOID lpCAPemCert);
+	SSL_CTX* CreateContext(int iVerifyMode, BOOL bMemory, LPVOID lpPemCert, LPVOID lpPemKey, LPVOID lpKeyPasswod, LPVOID lpCAPemCert);
+	SSL_CTX* AcquireContext(int i);
+	SSL_CTX* LoadLazyContext(TLazyContext* pLazy);
+	void CacheLazyContext(int i, TLazyContext* pLazy, SSL_CTX* sslCtx);
 	BOOL LoadCertAndKey(SSL_CTX* sslCtx, int iVerifyMode, BOOL bMemory, LPVOID lpPemCert, LPVOID lpPemKey, LPVOID lpKeyPasswod, LPVOID lpCAPemCert);
 	BOOL LoadCertAndKeyByFile(SSL_CTX* sslCtx, int iVerifyMode, LPCTSTR lpszPemCertFile, LPCTSTR lpszPemKeyFile, LPCTSTR lpszKeyPassword, LPCTSTR lpszCAPemCertFileOrPath);
 	BOOL LoadCertAndKeyByMemory(SSL_CTX* sslCtx, int iVerifyMode, LPCSTR lpszPemCert, LPCSTR lpszPemKey, LPCSTR lpszKeyPassword, LPCSTR lpszCAPemCert);
@@ -222,6 +274,7 @@ private:
 private:
 
 	static int InternalServerNameCallback(SSL* ssl, int* ad, void* arg);
+	static int InternalAlpnSelectCallback(SSL* ssl, const BYTE** out, BYTE* outlen, const BYTE* in, UINT inlen, void* arg);
 
 public:
 
@@ -239,27 +292,50 @@ public:
 private:
 
 	CString				m_strCipherList;
+	CString				m_strAlpnProtocols;
+	CStringA			m_strAlpnWire;
 	EnSSLSessionMode	m_enSessionMode;
 	CServerNameMap		m_sslServerNames;
+	CServerNameMap		m_sslSuffixNames;
+	ULONGLONG			m_ullSuffixDepths;
 	vector<SSL_CTX*>	m_lsSslCtxs;
 	SSL_CTX*			m_sslCtx;
 
+	vector<TLazyContext*>	m_lsLazyCtxs;
+	list<int>				m_lsLazyLru;
+	DWORD					m_dwLazyCacheSize;
+	mutable CCriSec			m_csLazy;
+
 	Fn_SNI_ServerNameCallback m_fnServerNameCallback;
 };
 
+/* SSL 发送通道回调：把 SSL 输出的密文直接投递到连接的发送队列 */
+typedef BOOL (*Fn_SSLSendChannel)(PVOID pThis, PVOID pSocketObj, const BYTE* pData, int iLength);
+
+/************************************************************************
+名称：SSL Session
+描述：SSL 连接会话
+		1、使用自定义 BIO 作为收发通道，SSL_read() 直接从工作线程接收缓冲区读取密文
+		2、SSL_write() 产生的密文直接写入连接发送队列，不再经过内存 BIO 中转
+************************************************************************/
 class CSSLSession
 {
+	friend class CSSLInitializer;
+
 public:
 
 	BOOL WriteRecvChannel(const BYTE* pData, int iLength);
 	BOOL ReadRecvChannel();
+	void FinishRecvChannel();
 
 	BOOL WriteSendChannel(const BYTE* pData, int iLength);
 	BOOL WriteSendChannel(const WSABUF pBuffers[], int iCount);
-	BOOL ReadSendChannel();
+	BOOL BindSendChannel(Fn_SSLSendChannel fnChannel, PVOID pThis, PVOID pSocketObj);
+	void HoldSendChannel();
+	BOOL ReleaseSendChannel();
 
 	const WSABUF& GetRecvBuffer()	const	{return m_bufRecv;}
-	const WSABUF& GetSendBuffer()	const	{return m_bufSend;}
+	BOOL IsSendChannelBound()		const	{return m_fnSendChannel != nullptr;}
 
 	CSSLSession*			Renew(const CSSLContext& sslCtx, LPCSTR lpszHostName = nullptr);
 	BOOL					Reset();
@@ -268,23 +344,50 @@ public:
 	BOOL					IsReady()		const	{return GetStatus() == SSL_HSS_SUCC;}
 	EnSSLHandShakeStatus	GetStatus()		const	{return m_enStatus;}
 	DWORD					GetFreeTime()	const	{return m_dwFreeTime;}
+	ULONGLONG				GetFreeEpoch()	const	{return m_ullFreeEpoch;}
 	CCriSec&				GetSendLock()			{return m_csSend;}
+	CReentrantCriSec&		GetRecvLock()			{return m_csRecv;}
 	BOOL					GetSessionInfo(EnSSLSessionInfo enInfo, LPVOID* lppInfo);
+	/* 获取 ALPN 协商的协议（未协商时为空串） */
+	LPCSTR					GetAlpnProtocol();
 
 private:
 
 	BOOL IsFatalError(int iBytes);
 
+	int ChannelRead	(char* pData, int iLength);
+	int ChannelWrite(const char* pData, int iLength);
+	BOOL FlushSendChannel();
+
+private:
+
+	static BOOL CreateChannelMethod();
+	static void DestroyChannelMethod();
+
+	static int channel_read		(BIO* bio, char* pData, int iLength);
+	static int channel_write	(BIO* bio, const char* pData, int iLength);
+	static int channel_puts		(BIO* bio, const char* lpszData);
+	static long channel_ctrl	(BIO* bio, int cmd, long num, void* ptr);
+	static int channel_create	(BIO* bio);
+	static int channel_destroy	(BIO* bio);
+
 public:
 
 	CSSLSession(CItemPool& itPool)
-	: m_enStatus(SSL_HSS_INIT)
-	, m_itPool	(itPool)
-	, m_ssl		(nullptr)
-	, m_bioSend	(nullptr)
-	, m_bioRecv	(nullptr)
-	, m_pitSend	(nullptr)
-	, m_pitRecv	(nullptr)
+	: m_enStatus		(SSL_HSS_INIT)
+	, m_itPool			(itPool)
+	, m_ssl				(nullptr)
+	, m_bio				(nullptr)
+	, m_pitRecv			(nullptr)
+	, m_lsRecv			(itPool)
+	, m_lsSend			(itPool)
+	, m_pRecvData		(nullptr)
+	, m_iRecvLength		(0)
+	, m_fnSendChannel	(nullptr)
+	, m_pSendThis		(nullptr)
+	, m_pSendSocketObj	(nullptr)
+	, m_bSendBroken		(FALSE)
+	, m_bSendHeld		(FALSE)
 	{
 
 	}
@@ -303,18 +406,33 @@ public:
 private:
 	CItemPool&				m_itPool;
 	CCriSec					m_csSend;
+	CReentrantCriSec		m_csRecv;
 
 	DWORD					m_dwFreeTime;
+	ULONGLONG				m_ullFreeEpoch;
 	EnSSLHandShakeStatus	m_enStatus;
 
 	SSL* m_ssl;
-	BIO* m_bioSend;
-	BIO* m_bioRecv;
+	BIO* m_bio;
 
-	TItem*		m_pitSend;
 	TItem*		m_pitRecv;
-	WSABUF		m_bufSend;
 	WSABUF		m_bufRecv;
+
+	TItemListEx	m_lsRecv;
+	TItemList	m_lsSend;
+
+	const BYTE*	m_pRecvData;
+	int			m_iRecvLength;
+
+	Fn_SSLSendChannel	m_fnSendChannel;
+	PVOID				m_pSendThis;
+	PVOID				m_pSendSocketObj;
+	BOOL				m_bSendBroken;
+	BOOL				m_bSendHeld;
+
+	CStringA			m_strAlpnProtocol;
+
+	static BIO_METHOD*	sm_pChannelMethod;
 };
 
 class CSSLSessionPool
@@ -337,7 +455,6 @@ public:
 	void SetItemPoolSize	(DWORD dwItemPoolSize)		{m_itPool.SetPoolSize(dwItemPoolSize);}
 	void SetItemPoolHold	(DWORD dwItemPoolHold)		{m_itPool.SetPoolHold(dwItemPoolHold);}
 
-	void SetSessionLockTime	(DWORD dwSessionLockTime)	{m_dwSessionLockTime = dwSessionLockTime;}
 	void SetSessionPoolSize	(DWORD dwSessionPoolSize)	{m_dwSessionPoolSize = dwSessionPoolSize;}
 	void SetSessionPoolHold	(DWORD dwSessionPoolHold)	{m_dwSessionPoolHold = dwSessionPoolHold;}
 
@@ -345,19 +462,16 @@ public:
 	DWORD GetItemPoolSize	()	{return m_itPool.GetPoolSize();}
 	DWORD GetItemPoolHold	()	{return m_itPool.GetPoolHold();}
 
-	DWORD GetSessionLockTime()	{return m_dwSessionLockTime;}
 	DWORD GetSessionPoolSize()	{return m_dwSessionPoolSize;}
 	DWORD GetSessionPoolHold()	{return m_dwSessionPoolHold;}
 
 public:
 	CSSLSessionPool(const CSSLContext& sslCtx,
 					DWORD dwPoolSize = DEFAULT_SESSION_POOL_SIZE,
-					DWORD dwPoolHold = DEFAULT_SESSION_POOL_HOLD,
-					DWORD dwLockTime = DEFAULT_SESSION_LOCK_TIME)
+					DWORD dwPoolHold = DEFAULT_SESSION_POOL_HOLD)
 	: m_sslCtx(sslCtx)
 	, m_dwSessionPoolSize(dwPoolSize)
 	, m_dwSessionPoolHold(dwPoolHold)
-	, m_dwSessionLockTime(dwLockTime)
 	{
 
 	}
@@ -370,7 +484,6 @@ public:
 	static const DWORD DEFAULT_ITEM_CAPACITY;
 	static const DWORD DEFAULT_ITEM_POOL_SIZE;
 	static const DWORD DEFAULT_ITEM_POOL_HOLD;
-	static const DWORD DEFAULT_SESSION_LOCK_TIME;
 	static const DWORD DEFAULT_SESSION_POOL_SIZE;
 	static const DWORD DEFAULT_SESSION_POOL_HOLD;
 
@@ -378,7 +491,6 @@ private:
 	CItemPool			m_itPool;
 	const CSSLContext&	m_sslCtx;
 
-	DWORD				m_dwSessionLockTime;
 	DWORD				m_dwSessionPoolSize;
 	DWORD				m_dwSessionPoolHold;
 
@@ -388,30 +500,28 @@ private:
 
 template<class T, class S> EnHandleResult ProcessHandShake(T* pThis, S* pSocketObj, CSSLSession* pSession)
 {
-	EnHandleResult result = HR_OK;
-
 	CCriSecLock locallock(pSession->GetSendLock());
 
-	while(TRUE)
-	{
-		VERIFY(pSession->ReadSendChannel());
-		const WSABUF& buffer = pSession->GetSendBuffer();
+	if(pSession->IsSendChannelBound())
+		return HR_OK;
 
-		if(buffer.len == 0)
-			break;
+	Fn_SSLSendChannel fnChannel = [](PVOID pv, PVOID ps, const BYTE* pData, int iLength) -> BOOL
+	{
+		WSABUF buffer;
+		buffer.len = iLength;
+		buffer.buf = (LPBYTE)pData;
 
-		if(!pThis->DoSendPackets(pSocketObj, &buffer, 1))
-		{
-			result = HR_ERROR;
-			break;
-		}
-	}
+		return ((T*)pv)->DoSendPackets((S*)ps, &buffer, 1);
+	};
 
-	return result;
+	return pSession->BindSendChannel(fnChannel, pThis, pSocketObj) ? HR_OK : HR_ERROR;
 }
 
 template<class T, class S> EnHandleResult ProcessReceive(T* pThis, S* pSocketObj, CSSLSession* pSession, const BYTE* pData, int iLength)
 {
+	// 握手线程不持有 csIo 执行解密与握手运算，接收通道由会话接收锁串行化
+	CReentrantCriSecLock recvlock(pSession->GetRecvLock());
+
 	if(!pSession->WriteRecvChannel(pData, iLength))
 		return HR_ERROR;
 
@@ -421,7 +531,10 @@ template<class T, class S> EnHandleResult ProcessReceive(T* pThis, S* pSocketObj
 	while(TRUE)
 	{
 		if(!pSession->ReadRecvChannel())
-			return HR_ERROR;
+		{
+			result = HR_ERROR;
+			break;
+		}
 
 		if(enStatus == SSL_HSS_PROC && pSession->IsReady())
 		{
@@ -448,6 +561,8 @@ template<class T, class S> EnHandleResult ProcessReceive(T* pThis, S* pSocketObj
 			break;
 	}
 
+	pSession->FinishRecvChannel();
+
 	if(result != HR_ERROR && pSession->IsHandShaking())
 		result = ::ProcessHandShake(pThis, pSocketObj, pSession);
 
@@ -470,21 +585,7 @@ template<class T, class S> BOOL ProcessSend(T* pThis, S* pSocketObj, CSSLSession
 		return FALSE;
 	}
 
-	VERIFY(pSession->WriteSendChannel(pBuffers, iCount));
-
-	while(TRUE)
-	{
-		VERIFY(pSession->ReadSendChannel());
-		const WSABUF& buffer = pSession->GetSendBuffer();
-
-		if(buffer.len == 0)
-			break;
-
-		if(!pThis->DoSendPackets(pSocketObj, &buffer, 1))
-			return FALSE;
-	}
-
-	return TRUE;
+	return pSession->WriteSendChannel(pBuffers, iCount);
 }
 
 #endif
\ No newline at end of file
@@ -44,15 +44,20 @@ void CSSLServer::PrepareStart()
 	m_sslPool.SetItemCapacity	(GetSocketBufferSize());
 	m_sslPool.SetItemPoolSize	(GetFreeBufferObjPool());
 	m_sslPool.SetItemPoolHold	(GetFreeBufferObjHold());
-	m_sslPool.SetSessionLockTime(GetFreeSocketObjLockTime());
 	m_sslPool.SetSessionPoolSize(GetFreeSocketObjPool());
 	m_sslPool.SetSessionPoolHold(GetFreeSocketObjHold());
 
 	m_sslPool.Prepare();
+
+	if(m_dwSSLHandShakeThreadCount > 0)
+		VERIFY(m_thHandShake.Start(m_dwSSLHandShakeThreadCount));
 }
 
 void CSSLServer::Reset()
 {
+	if(m_thHandShake.GetState() != SS_STOPPED)
+		m_thHandShake.Stop();
+
 	m_sslPool.Clear();
 	m_sslCtx.RemoveThreadLocalState();
 
@@ -68,6 +73,8 @@ void CSSLServer::OnWorkerThreadEnd(THR_ID dwThreadID)
 
 BOOL CSSLServer::SendPackets(CONNID dwConnID, const WSABUF pBuffers[], int iCount)
 {
+	CEpochLock epochlock;
+
 	ASSERT(pBuffers && iCount > 0);
 
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
@@ -102,10 +109,133 @@ EnHandleResult CSSLServer::FireReceive(TSocketObj* pSocketObj, const BYTE* pData
 	CSSLSession* pSession = nullptr;
 	GetConnectionReserved2(pSocketObj, (PVOID*)&pSession);
 
-	if(pSession != nullptr)
-		return ::ProcessReceive(this, pSocketObj, pSession, pData, iLength);
-	else
+	if(pSession == nullptr)
 		return DoFireReceive(pSocketObj, pData, iLength);
+	if(m_dwSSLHandShakeThreadCount > 0 && pSession->IsHandShaking())
+	{
+		WSABUF buffer = {(UINT)iLength, (LPBYTE)pData};
+		return DispatchHandShake(pSocketObj, &buffer, 1);
+	}
+
+	return ::ProcessReceive(this, pSocketObj, pSession, pData, iLength);
+}
+
+EnHandleResult CSSLServer::FireReceive(TSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount)
+{
+	for(int i = 0; i < iCount; i++)
+	{
+		// 握手交由握手线程处理时，本批次剩余数据必须随同一任务按序投递
+		if(IsHandShakeDispatchable(pSocketObj))
+			return DispatchHandShake(pSocketObj, pBuffers + i, iCount - i);
+
+		EnHandleResult rs = FireReceive(pSocketObj, pBuffers[i].buf, (int)pBuffers[i].len);
+
+		if(rs == HR_ERROR)
+			return rs;
+	}
+
+	return HR_OK;
+}
+
+BOOL CSSLServer::IsHandShakeDispatchable(TSocketObj* pSocketObj)
+{
+	if(m_dwSSLHandShakeThreadCount == 0)
+		return FALSE;
+
+	CSSLSession* pSession = nullptr;
+	GetConnectionReserved2(pSocketObj, (PVOID*)&pSession);
+
+	return (pSession != nullptr && pSession->IsHandShaking());
+}
+
+EnHandleResult CSSLServer::DispatchHandShake(TSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount)
+{
+	ASSERT(iCount > 0);
+
+	int iLength = 0;
+
+	for(int i = 0; i < iCount; i++)
+		iLength += (int)pBuffers[i].len;
+
+	// 多个缓冲区合并为一个任务，保证握手线程按接收顺序处理 TLS 记录
+	LPBYTE pData = MALLOC(BYTE, iLength);
+
+	for(int i = 0, iOffset = 0; i < iCount; iOffset += (int)pBuffers[i].len, i++)
+		::CopyMemory(pData + iOffset, pBuffers[i].buf, pBuffers[i].len);
+
+	// 握手期间暂停接收，握手线程处理完本次数据后通过 PauseReceive() 恢复接收
+	PauseReceive(pSocketObj->connID, TRUE);
+
+	LPTSocketTask pTask = ::CreateSocketTaskObj(HandShakeTaskProc, this, pSocketObj->connID, pData, iLength, TBT_ATTACH);
+
+	if(m_thHandShake.Submit(pTask))
+		return HR_OK;
+
+	PauseReceive(pSocketObj->connID, FALSE);
+
+	CSSLSession* pSession = nullptr;
+	GetConnectionReserved2(pSocketObj, (PVOID*)&pSession);
+
+	EnHandleResult result = ::ProcessReceive(this, pSocketObj, pSession, pData, iLength);
+
+	::DestroySocketTaskObj(pTask);
+
+	return result;
+}
+
+void __HP_CALL CSSLServer::HandShakeTaskProc(TSocketTask* pTask)
+{
+	CEpochLock epochlock;
+
+	CSSLServer* pThis		= (CSSLServer*)pTask->sender;
+	TSocketObj* pSocketObj	= pThis->FindSocketObj(pTask->connID);
+
+	if(!TSocketObj::IsValid(pSocketObj))
+		return;
+
+	CSSLSession* pSession = nullptr;
+
+	{
+		// 只在取得会话时持有 csIo，握手运算期间通信工作线程仍可处理该连接的发送
+		CReentrantCriSecLock locallock(pSocketObj->csIo);
+
+		if(!TSocketObj::IsValid(pSocketObj) || pSocketObj->connID != pTask->connID)
+			return;
+
+		pThis->GetConnectionReserved2(pSocketObj, (PVOID*)&pSession);
+
+		if(pSession == nullptr)
+			return;
+	}
+
+	EnHandleResult result = HR_OK;
+
+	{
+		// 会话接收锁阻止连接关闭时并发重置会话（会话内存由 epoch 保证不被重用）
+		CReentrantCriSecLock recvlock(pSession->GetRecvLock());
+
+		if(!pSession->IsValid() || !TSocketObj::IsValid(pSocketObj) || pSocketObj->connID != pTask->connID)
+			return;
+
+		// 握手数据在本步骤结束后统一投递
+		pSession->HoldSendChannel();
+
+		result = ::ProcessReceive(pThis, pSocketObj, pSession, pTask->buf, pTask->bufLen);
+
+		if(!pSession->ReleaseSendChannel())
+			result = HR_ERROR;
+	}
+
+	// 关闭连接须在释放会话接收锁之后进行（关闭过程先获取 csIo 再重置会话）
+	if(result == HR_ERROR)
+	{
+		TRACE("<S-CNNID: %zu> SSL handshake fail, connection will be closed !", pTask->connID);
+
+		pThis->AddFreeSocketObj(pSocketObj, SCF_ERROR, SO_RECEIVE, ENSURE_ERROR_CANCELLED);
+		return;
+	}
+
+	pThis->PauseReceive(pTask->connID, FALSE);
 }
 
 EnHandleResult CSSLServer::FireClose(TSocketObj* pSocketObj, EnSocketOperation enOperation, int iErrorCode)
@@ -123,6 +253,8 @@ EnHandleResult CSSLServer::FireClose(TSocketObj* pSocketObj, EnSocketOperation e
 
 BOOL CSSLServer::StartSSLHandShake(CONNID dwConnID)
 {
+	CEpochLock epochlock;
+
 	if(IsSSLAutoHandShake())
 	{
 		::SetLastError(ERROR_INVALID_OPERATION);
@@ -186,6 +318,8 @@ void CSSLServer::DoSSLHandShake(TSocketObj* pSocketObj)
 
 BOOL CSSLServer::GetSSLSessionInfo(CONNID dwConnID, EnSSLSessionInfo enInfo, LPVOID* lppInfo)
 {
+	CEpochLock epochlock;
+
 	ASSERT(lppInfo != nullptr);
 
 	*lppInfo				= nullptr;
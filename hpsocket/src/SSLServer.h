@@ -25,6 +25,7 @@
 
 #include "TcpServer.h"
 #include "SSLHelper.h"
+#include "HPThreadPool.h"
 
 #ifdef _SSL_SUPPORT
 
@@ -48,6 +49,9 @@ public:
 	virtual int AddSSLContextByMemory(int iVerifyMode = SSL_VM_NONE, LPCSTR lpszPemCert = nullptr, LPCSTR lpszPemKey = nullptr, LPCSTR lpszKeyPassword = nullptr, LPCSTR lpszCAPemCert = nullptr)
 		{return m_sslCtx.AddServerContext(iVerifyMode, TRUE, (LPVOID)lpszPemCert, (LPVOID)lpszPemKey, (LPVOID)lpszKeyPassword, (LPVOID)lpszCAPemCert);}
 
+	virtual int AddSSLContextLazy(int iVerifyMode, LPCTSTR lpszPemCertFile, LPCTSTR lpszPemKeyFile, LPCTSTR lpszKeyPassword = nullptr, LPCTSTR lpszCAPemCertFileOrPath = nullptr)
+		{return m_sslCtx.AddServerContextLazy(iVerifyMode, lpszPemCertFile, lpszPemKeyFile, lpszKeyPassword, lpszCAPemCertFileOrPath);}
+
 	virtual BOOL BindSSLServerName(LPCTSTR lpszServerName, int iContextIndex)
 		{return m_sslCtx.BindServerName(lpszServerName, iContextIndex);}
 
@@ -61,12 +65,19 @@ public:
 	virtual void SetSSLCipherList	(LPCTSTR lpszCipherList){ENSURE_HAS_STOPPED(); m_sslCtx.SetCipherList(lpszCipherList);}
 	virtual BOOL IsSSLAutoHandShake	()						{return m_bSSLAutoHandShake;}
 	virtual LPCTSTR GetSSLCipherList()						{return m_sslCtx.GetCipherList();}
+	virtual void SetSSLAlpnProtocols(LPCTSTR lpszProtocols)	{ENSURE_HAS_STOPPED(); m_sslCtx.SetAlpnProtocols(lpszProtocols);}
+	virtual LPCTSTR GetSSLAlpnProtocols()					{return m_sslCtx.GetAlpnProtocols();}
+	virtual void SetSSLHandShakeThreadCount(DWORD dwThreadCount)	{ENSURE_HAS_STOPPED(); m_dwSSLHandShakeThreadCount = dwThreadCount;}
+	virtual DWORD GetSSLHandShakeThreadCount()						{return m_dwSSLHandShakeThreadCount;}
+	virtual void SetSSLLazyContextCacheSize(DWORD dwCacheSize)		{m_sslCtx.SetLazyContextCacheSize(dwCacheSize);}
+	virtual DWORD GetSSLLazyContextCacheSize()						{return m_sslCtx.GetLazyContextCacheSize();}
 
 	virtual BOOL GetSSLSessionInfo(CONNID dwConnID, EnSSLSessionInfo enInfo, LPVOID* lppInfo);
 
 protected:
 	virtual EnHandleResult FireAccept(TSocketObj* pSocketObj);
 	virtual EnHandleResult FireReceive(TSocketObj* pSocketObj, const BYTE* pData, int iLength);
+	virtual EnHandleResult FireReceive(TSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount);
 	virtual EnHandleResult FireClose(TSocketObj* pSocketObj, EnSocketOperation enOperation, int iErrorCode);
 
 	virtual BOOL CheckParams();
@@ -80,6 +91,10 @@ protected:
 
 private:
 	void DoSSLHandShake(TSocketObj* pSocketObj);
+	BOOL IsHandShakeDispatchable(TSocketObj* pSocketObj);
+	EnHandleResult DispatchHandShake(TSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount);
+
+	static void __HP_CALL HandShakeTaskProc(TSocketTask* pTask);
 
 private:
 	friend EnHandleResult ProcessHandShake<>(CSSLServer* pThis, TSocketObj* pSocketObj, CSSLSession* pSession);
@@ -91,6 +106,7 @@ public:
 	: CTcpServer(pListener)
 	, m_sslPool(m_sslCtx)
 	, m_bSSLAutoHandShake(TRUE)
+	, m_dwSSLHandShakeThreadCount(0)
 	{
 
 	}
@@ -102,9 +118,11 @@ public:
 
 private:
 	BOOL m_bSSLAutoHandShake;
+	DWORD m_dwSSLHandShakeThreadCount;
 
 	CSSLContext m_sslCtx;
 	CSSLSessionPool m_sslPool;
+	CHPThreadPool m_thHandShake;
 };
 
 #endif
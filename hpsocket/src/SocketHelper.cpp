@@ -27,6 +27,7 @@
 #include <arpa/inet.h>
 #include <netinet/tcp.h>
 #include <netinet/udp.h>
+#include <sys/event.h>
 
 #ifdef _ICONV_SUPPORT
 #include <iconv.h>
@@ -723,6 +724,207 @@ int ManualCloseSocket(SOCKET sock, int iShutdownFlag, BOOL bGraceful)
 	return closesocket(sock);
 }
 
+static void CopyHistogramStat(const CLatencyHistogram::TStat& src, THistogramStat& dest)
+{
+	dest.count	= src.count;
+	dest.sum	= src.sum;
+	dest.min	= src.min;
+	dest.max	= src.max;
+	dest.p50	= src.p50;
+	dest.p90	= src.p90;
+	dest.p99	= src.p99;
+	dest.p999	= src.p999;
+}
+
+void GetSocketMetrics(CIOMetrics& metrics, TSocketMetrics& snapshot, DWORD dwConnections, DWORD dwCommandQueue)
+{
+	::ZeroMemory(&snapshot, sizeof(TSocketMetrics));
+
+	snapshot.uptime			= metrics.GetUptime();
+	snapshot.connections	= dwConnections;
+	snapshot.commandQueue	= dwCommandQueue;
+
+	snapshot.bytesIn		= metrics.GetCounter(CIOMetrics::IMC_BYTES_IN);
+	snapshot.bytesOut		= metrics.GetCounter(CIOMetrics::IMC_BYTES_OUT);
+	snapshot.readsIn		= metrics.GetCounter(CIOMetrics::IMC_READS_IN);
+	snapshot.msgsOut		= metrics.GetCounter(CIOMetrics::IMC_MSGS_OUT);
+	snapshot.recvCalls		= metrics.GetCounter(CIOMetrics::IMC_RECV_CALLS);
+	snapshot.sendCalls		= metrics.GetCounter(CIOMetrics::IMC_SEND_CALLS);
+	snapshot.ioEvents		= metrics.GetCounter(CIOMetrics::IMC_IO_EVENTS);
+	snapshot.connects		= metrics.GetCounter(CIOMetrics::IMC_CONNECTS);
+	snapshot.closes			= metrics.GetCounter(CIOMetrics::IMC_CLOSES);
+	snapshot.loops			= metrics.GetCounter(CIOMetrics::IMC_LOOPS);
+	snapshot.commands		= metrics.GetCounter(CIOMetrics::IMC_COMMANDS);
+
+	CLatencyHistogram::TStat stat;
+
+	metrics.GetHistogram(CIOMetrics::IMH_CALLBACK, stat);
+	CopyHistogramStat(stat, snapshot.callbackTime);
+	metrics.GetHistogram(CIOMetrics::IMH_LOOP, stat);
+	CopyHistogramStat(stat, snapshot.loopTime);
+	metrics.GetHistogram(CIOMetrics::IMH_SEND_QUEUE, stat);
+	CopyHistogramStat(stat, snapshot.sendQueueDepth);
+	metrics.GetHistogram(CIOMetrics::IMH_COMMAND_QUEUE, stat);
+	CopyHistogramStat(stat, snapshot.commandQueueDepth);
+}
+
+void AddHeapMetrics(TSocketMetrics& snapshot, CPrivateHeap& heap)
+{
+	THeapStat stat;
+	heap.GetStat(stat);
+
+	snapshot.heapAllocBytes		+= stat.allocBytes;
+	snapshot.heapReservedBytes	+= stat.reservedBytes;
+}
+
+static void AppendMetricsValue(CStringA& strText, LPCSTR lpszPrefix, LPCSTR lpszName, LPCSTR lpszType, LPCSTR lpszHelp, ULLONG ullValue)
+{
+	strText.AppendFormat("# HELP %s_%s %s\n# TYPE %s_%s %s\n%s_%s %llu\n", lpszPrefix, lpszName, lpszHelp, lpszPrefix, lpszName, lpszType, lpszPrefix, lpszName, ullValue);
+}
+
+static void AppendMetricsSummary(CStringA& strText, LPCSTR lpszPrefix, LPCSTR lpszName, LPCSTR lpszHelp, const THistogramStat& stat, double dScale)
+{
+	strText.AppendFormat("# HELP %s_%s %s\n# TYPE %s_%s summary\n", lpszPrefix, lpszName, lpszHelp, lpszPrefix, lpszName);
+
+	strText.AppendFormat("%s_%s{quantile=\"0.5\"} %.9g\n",	lpszPrefix, lpszName, stat.p50 * dScale);
+	strText.AppendFormat("%s_%s{quantile=\"0.9\"} %.9g\n",	lpszPrefix, lpszName, stat.p90 * dScale);
+	strText.AppendFormat("%s_%s{quantile=\"0.99\"} %.9g\n",	lpszPrefix, lpszName, stat.p99 * dScale);
+	strText.AppendFormat("%s_%s{quantile=\"0.999\"} %.9g\n",	lpszPrefix, lpszName, stat.p999 * dScale);
+	strText.AppendFormat("%s_%s_sum %.9g\n%s_%s_count %llu\n",	lpszPrefix, lpszName, stat.sum * dScale, lpszPrefix, lpszName, stat.count);
+}
+
+BOOL FormatMetricsText(const TSocketMetrics& snapshot, LPSTR lpszBuffer, int& iLength, LPCSTR lpszPrefix)
+{
+	if(::IsStrEmptyA(lpszPrefix))
+		lpszPrefix = DEFAULT_METRICS_PREFIX;
+
+	CStringA strText;
+
+	AppendMetricsValue(strText, lpszPrefix, "uptime_milliseconds", "gauge", "Milliseconds since the component started.", snapshot.uptime);
+	AppendMetricsValue(strText, lpszPrefix, "connections", "gauge", "Current connection count.", snapshot.connections);
+	AppendMetricsValue(strText, lpszPrefix, "command_queue", "gauge", "Current dispatcher command queue depth.", snapshot.commandQueue);
+	AppendMetricsValue(strText, lpszPrefix, "received_bytes_total", "counter", "Bytes received.", snapshot.bytesIn);
+	AppendMetricsValue(strText, lpszPrefix, "sent_bytes_total", "counter", "Bytes sent.", snapshot.bytesOut);
+	AppendMetricsValue(strText, lpszPrefix, "received_reads_total", "counter", "Receive system calls that returned data.", snapshot.readsIn);
+	AppendMetricsValue(strText, lpszPrefix, "sent_messages_total", "counter", "Send requests accepted.", snapshot.msgsOut);
+	AppendMetricsValue(strText, lpszPrefix, "recv_syscalls_total", "counter", "Receive system calls.", snapshot.recvCalls);
+	AppendMetricsValue(strText, lpszPrefix, "send_syscalls_total", "counter", "Send system calls.", snapshot.sendCalls);
+	AppendMetricsValue(strText, lpszPrefix, "io_events_total", "counter", "IO events dispatched.", snapshot.ioEvents);
+	AppendMetricsValue(strText, lpszPrefix, "connects_total", "counter", "Connections accepted or established.", snapshot.connects);
+	AppendMetricsValue(strText, lpszPrefix, "closes_total", "counter", "Connections closed.", snapshot.closes);
+	AppendMetricsValue(strText, lpszPrefix, "loops_total", "counter", "Dispatcher loop iterations.", snapshot.loops);
+	AppendMetricsValue(strText, lpszPrefix, "commands_total", "counter", "Dispatcher commands processed.", snapshot.commands);
+	AppendMetricsValue(strText, lpszPrefix, "heap_allocated_bytes", "gauge", "Bytes allocated from the component's private heaps.", snapshot.heapAllocBytes);
+	AppendMetricsValue(strText, lpszPrefix, "heap_reserved_bytes", "gauge", "Bytes mapped from the system by the component's private heaps.", snapshot.heapReservedBytes);
+
+	AppendMetricsSummary(strText, lpszPrefix, "callback_duration_seconds", "Listener callback duration.", snapshot.callbackTime, 1e-9);
+	AppendMetricsSummary(strText, lpszPrefix, "loop_duration_seconds", "Dispatcher loop iteration duration.", snapshot.loopTime, 1e-9);
+	AppendMetricsSummary(strText, lpszPrefix, "send_queue_bytes", "Pending send bytes after each send request.", snapshot.sendQueueDepth, 1.0);
+	AppendMetricsSummary(strText, lpszPrefix, "command_queue_depth", "Command queue depth when commands are processed.", snapshot.commandQueueDepth, 1.0);
+
+	int iSize = strText.GetLength() + 1;
+
+	if(lpszBuffer == nullptr || iLength < iSize)
+	{
+		iLength = iSize;
+		::SetLastError(ERROR_BUFFER_OVERFLOW);
+
+		return FALSE;
+	}
+
+	memcpy(lpszBuffer, (LPCSTR)strText, iSize);
+	iLength = iSize;
+
+	return TRUE;
+}
+
+BOOL GetWorkerTraceStats(CLoopTracer& tracer, TWorkerTraceStat stats[], DWORD& dwCount)
+{
+	DWORD dwWorkers = (DWORD)tracer.GetWorkerCount();
+
+	if(stats == nullptr || dwCount < dwWorkers)
+	{
+		dwCount = dwWorkers;
+		::SetLastError(ERROR_BUFFER_OVERFLOW);
+
+		return FALSE;
+	}
+
+	CLoopTracer::TWorkerStat stat;
+
+	for(DWORD i = 0; i < dwWorkers; i++)
+	{
+		VERIFY(tracer.GetWorkerStat((int)i, stat));
+
+		ULLONG ullTotal = stat.busy + stat.idle;
+
+		stats[i].busyTime	= stat.busy / 1000;
+		stats[i].idleTime	= stat.idle / 1000;
+		stats[i].events		= stat.events;
+		stats[i].slowEvents	= stat.slow;
+		stats[i].busyRatio	= (ullTotal == 0) ? 0 : (DWORD)((double)stat.busy * 10000 / ullTotal);
+	}
+
+	dwCount = dwWorkers;
+
+	return TRUE;
+}
+
+static EnSocketOperation GetTraceOperation(const TTraceRecord& record, EnSocketOperation enListenOperation)
+{
+	if(record.events == (UINT)EVFILT_EXCEPT || record.flags == EV_ERROR)
+		return SO_CLOSE;
+
+	switch((short)record.events)
+	{
+	case EVFILT_READ:	return (record.id == 0) ? enListenOperation : SO_RECEIVE;
+	case EVFILT_WRITE:	return SO_SEND;
+	case EVFILT_USER:	return SO_CLOSE;
+	default:			return SO_UNKNOWN;
+	}
+}
+
+BOOL GetSlowCallbacks(CLoopTracer& tracer, TSlowCallback records[], DWORD& dwCount, EnSocketOperation enListenOperation)
+{
+	DWORD dwAvail = 0;
+	tracer.DumpSlowEvents(nullptr, dwAvail);
+
+	if(records == nullptr || dwCount < dwAvail)
+	{
+		dwCount = dwAvail;
+		::SetLastError(ERROR_BUFFER_OVERFLOW);
+
+		return FALSE;
+	}
+
+	DWORD dwTraces = tracer.GetRingCapacity();
+	unique_ptr<TTraceRecord[]> traces = make_unique<TTraceRecord[]>(dwTraces);
+
+	VERIFY(tracer.DumpSlowEvents(traces.get(), dwTraces));
+
+	//导出期间可能有新记录写入：只保留最新的 dwCount 条
+	DWORD dwSkip	= (dwTraces > dwCount) ? (dwTraces - dwCount) : 0;
+	ULLONG ullNanos	= ::TimeGetNanos();
+	ULLONG ullTime	= ::TimeGetTime64();
+
+	for(DWORD i = dwSkip; i < dwTraces; i++)
+	{
+		const TTraceRecord& trace	= traces[i];
+		TSlowCallback& record		= records[i - dwSkip];
+
+		record.seq			= trace.seq;
+		record.timestamp	= ullTime - (ullNanos - trace.begin) / 1000000;
+		record.duration		= trace.duration / 1000;
+		record.connID		= (CONNID)trace.id;
+		record.operation	= GetTraceOperation(trace, enListenOperation);
+		record.worker		= trace.worker;
+	}
+
+	dwCount = dwTraces - dwSkip;
+
+	return TRUE;
+}
+
 #ifdef _ICONV_SUPPORT
 
 BOOL CharsetConvert(LPCSTR lpszFromCharset, LPCSTR lpszToCharset, LPCSTR lpszInBuf, int iInBufLen, LPSTR lpszOutBuf, int& iOutBufLen)
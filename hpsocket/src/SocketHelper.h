@@ -31,6 +31,7 @@
 #include "common/BufferPool.h"
 #include "common/RingBuffer.h"
 #include "common/FileHelper.h"
+#include "common/Metrics.h"
 
 #include <netdb.h>
 #include <sys/un.h>
@@ -71,16 +72,22 @@ using SOCKADDR_IN6		= sockaddr_in6;
 #define MAX_CONTINUE_READS						30
 /* 处理发送事件时最大写入次数 */
 #define MAX_CONTINUE_WRITES						50
+/* 处理接收事件时最小读取次数（自适应调整下限） */
+#define MIN_CONTINUE_READS						4
+/* 处理发送事件时最小写入次数（自适应调整下限） */
+#define MIN_CONTINUE_WRITES						4
 
 /* 默认工作队列等待的最大描述符事件数量 */
 #define DEFAULT_WORKER_MAX_EVENT_COUNT			CIODispatcher::DEF_WORKER_MAX_EVENTS
+/* 默认单个连接每轮事件处理的读写字节预算 */
+#define DEFAULT_IO_BYTES_BUDGET					(256 * 1024)
+/* 默认单个连接每轮事件处理的时间预算（微秒，0：不限制） */
+#define DEFAULT_IO_TIME_BUDGET					0
 
 /* Server/Agent 最大连接数 */
 #define MAX_CONNECTION_COUNT					(5 * 1000 * 1000)
 /* Server/Agent 默认最大连接数 */
 #define DEFAULT_CONNECTION_COUNT				10000
-/* Server/Agent 默认 Socket 缓存对象锁定时间 */
-#define DEFAULT_FREE_SOCKETOBJ_LOCK_TIME		DEFAULT_OBJECT_CACHE_LOCK_TIME
 /* Server/Agent 默认 Socket 缓存池大小 */
 #define DEFAULT_FREE_SOCKETOBJ_POOL				DEFAULT_OBJECT_CACHE_POOL_SIZE
 /* Server/Agent 默认 Socket 缓存池回收阀值 */
@@ -425,6 +432,76 @@ typedef TReceiveBufferMap::iterator			TReceiveBufferMapI;
 /* 线程 ID - 接收缓冲区哈希表 const 迭代器 */
 typedef TReceiveBufferMap::const_iterator	TReceiveBufferMapCI;
 
+/* 连接读写预算：根据观测到的平均读写字节数自适应调整每轮事件处理的读写次数 */
+struct TIoBudget
+{
+	DWORD	avgRead;
+	DWORD	avgWrite;
+	UINT	deferred;
+
+	/* 获取本轮最大读写次数（字节预算除以平均读写字节数，限制在 [MIN, MAX] 之间） */
+	int GetReads	(DWORD dwBytesBudget) const	{return Limit(avgRead, dwBytesBudget, MIN_CONTINUE_READS, MAX_CONTINUE_READS);}
+	int GetWrites	(DWORD dwBytesBudget) const	{return Limit(avgWrite, dwBytesBudget, MIN_CONTINUE_WRITES, MAX_CONTINUE_WRITES);}
+
+	/* 记录单次读写字节数（指数加权移动平均，新样本权重 1/8） */
+	void OnRead		(int iBytes)	{avgRead	= Average(avgRead, iBytes);}
+	void OnWrite	(int iBytes)	{avgWrite	= Average(avgWrite, iBytes);}
+
+	/* 标记因预算用尽而未处理完的事件（DISP_EVENT_FLAG_R / DISP_EVENT_FLAG_W） */
+	void Defer(UINT uFlag)	{deferred |= uFlag;}
+	UINT TakeDeferred()		{UINT uFlags = deferred; deferred = 0; return uFlags;}
+
+	void Reset()
+	{
+		avgRead		= 0;
+		avgWrite	= 0;
+		deferred	= 0;
+	}
+
+private:
+	static int Limit(DWORD dwAvg, DWORD dwBytesBudget, int iMin, int iMax)
+	{
+		if(dwAvg == 0 || dwBytesBudget == 0)
+			return iMax;
+
+		return (int)MAX(MIN(dwBytesBudget / dwAvg, (DWORD)iMax), (DWORD)iMin);
+	}
+
+	static DWORD Average(DWORD dwAvg, int iBytes)
+		{return (dwAvg == 0) ? (DWORD)iBytes : ((dwAvg * 7 + (DWORD)iBytes) >> 3);}
+};
+
+/* 单轮事件处理的读写预算计量（次数、字节数与时间任一用尽即结束本轮） */
+struct TIoPass
+{
+	int		times;
+	DWORD	bytesBudget;
+	DWORD	bytes;
+	ULLONG	deadline;
+
+	/* iTimes < 0 则不限制 */
+	TIoPass(int iTimes, DWORD dwBytesBudget, DWORD dwTimeBudget)
+	: times			(iTimes)
+	, bytesBudget	(dwBytesBudget)
+	, bytes			(0)
+	, deadline		((iTimes >= 0 && dwTimeBudget > 0) ? ::TimeGetNanos() + dwTimeBudget * 1000ull : 0)
+	{
+	}
+
+	/* 计入一次读写，返回本轮预算是否已用尽 */
+	BOOL Consume(int iBytes)
+	{
+		if(times < 0)
+			return FALSE;
+
+		bytes += (DWORD)iBytes;
+
+		return	(--times <= 0)									||
+				(bytesBudget > 0 && bytes >= bytesBudget)		||
+				(deadline != 0 && ::TimeGetNanos() >= deadline)	;
+	}
+};
+
 /* Socket 缓冲区基础结构 */
 struct TSocketObjBase
 {
@@ -444,6 +521,8 @@ struct TSocketObjBase
 		DWORD	connTime;
 	};
 
+	ULONGLONG	freeEpoch;
+
 	volatile BOOL connected;
 	volatile BOOL paused;
 
@@ -459,10 +538,11 @@ struct TSocketObjBase
 		{ASSERT(IsExist(pSocketObj)); pSocketObj->valid = FALSE;}
 
 	static void Release(TSocketObjBase* pSocketObj)
-		{ASSERT(IsExist(pSocketObj)); pSocketObj->freeTime = ::TimeGetTime();}
+		{ASSERT(IsExist(pSocketObj)); pSocketObj->freeTime = ::TimeGetTime(); pSocketObj->freeEpoch = CEpochDomain::Retire();}
 
 	DWORD GetConnTime	()	const	{return connTime;}
 	DWORD GetFreeTime	()	const	{return freeTime;}
+	ULONGLONG GetFreeEpoch()const	{return freeEpoch;}
 	DWORD GetActiveTime	()	const	{return activeTime;}
 	BOOL IsPaused		()	const	{return paused;}
 
@@ -491,6 +571,7 @@ struct TSocketObj : public TSocketObjBase
 
 	SOCKET				socket;
 	TBufferObjList		sndBuff;
+	TIoBudget			budget;
 
 	static TSocketObj* Construct(CPrivateHeap& hp, CBufferObjPool& bfPool)
 	{
@@ -550,6 +631,7 @@ struct TSocketObj : public TSocketObjBase
 		__super::Reset(dwConnID);
 		
 		socket = soClient;
+		budget.Reset();
 	}
 };
 
@@ -895,6 +977,21 @@ int SendUdpCloseNotify(SOCKET sock, const HP_SOCKADDR& remoteAddr);
 /* 关闭 Socket */
 int ManualCloseSocket(SOCKET sock, int iShutdownFlag = 0xFF, BOOL bGraceful = TRUE);
 
+/* 默认 Prometheus 度量名称前缀 */
+#define DEFAULT_METRICS_PREFIX		"hpsocket"
+
+/* 汇总运行时度量快照 */
+void GetSocketMetrics(CIOMetrics& metrics, TSocketMetrics& snapshot, DWORD dwConnections = 0, DWORD dwCommandQueue = 0);
+/* 把私有堆的内存占用累加到运行时度量快照 */
+void AddHeapMetrics(TSocketMetrics& snapshot, CPrivateHeap& heap);
+/* 把运行时度量快照输出为 Prometheus 文本格式（iLength 为缓冲区长度，返回时为文本长度，含结束符；缓冲区不足时返回 FALSE 并在 iLength 中返回所需长度） */
+BOOL FormatMetricsText(const TSocketMetrics& snapshot, LPSTR lpszBuffer, int& iLength, LPCSTR lpszPrefix = nullptr);
+
+/* 获取事件循环跟踪器的工作线程统计（stats 为空或 dwCount 小于工作线程数时返回 FALSE，dwCount 返回工作线程数） */
+BOOL GetWorkerTraceStats(CLoopTracer& tracer, TWorkerTraceStat stats[], DWORD& dwCount);
+/* 导出事件循环跟踪器的慢回调记录（enListenOperation 为监听 Socket 可读事件对应的操作类型；records 为空或 dwCount 不足时返回 FALSE，dwCount 返回现存记录数） */
+BOOL GetSlowCallbacks(CLoopTracer& tracer, TSlowCallback records[], DWORD& dwCount, EnSocketOperation enListenOperation = SO_RECEIVE);
+
 #ifdef _ICONV_SUPPORT
 
 #define CHARSET_GBK			"GBK"
@@ -241,10 +241,10 @@ public:
 	virtual void SetSendPolicy				(EnSendPolicy enSendPolicy)			= 0;
 	/* 设置 OnSend 事件同步策略（对 Linux 平台组件无效） */
 	virtual void SetOnSendSyncPolicy		(EnOnSendSyncPolicy enSyncPolicy)	= 0;
+	/* 设置 OnSend 事件通知策略（默认：OSNP_EACH） */
+	virtual void SetOnSendNotifyPolicy		(EnOnSendNotifyPolicy enNotifyPolicy)	= 0;
 	/* 设置最大连接数（组件会根据设置值预分配内存，因此需要根据实际情况设置，不宜过大）*/
 	virtual void SetMaxConnectionCount		(DWORD dwMaxConnectionCount)		= 0;
-	/* 设置 Socket 缓存对象锁定时间（毫秒，在锁定期间该 Socket 缓存对象不能被获取使用） */
-	virtual void SetFreeSocketObjLockTime	(DWORD dwFreeSocketObjLockTime)		= 0;
 	/* 设置 Socket 缓存池大小（通常设置为平均并发连接数的 1/3 - 1/2） */
 	virtual void SetFreeSocketObjPool		(DWORD dwFreeSocketObjPool)			= 0;
 	/* 设置内存块缓存池大小（通常设置为 Socket 缓存池大小的 2 - 3 倍） */
@@ -264,10 +264,10 @@ public:
 	virtual EnSendPolicy GetSendPolicy				()	= 0;
 	/* 获取 OnSend 事件同步策略（对 Linux 平台组件无效） */
 	virtual EnOnSendSyncPolicy GetOnSendSyncPolicy	()	= 0;
+	/* 获取 OnSend 事件通知策略 */
+	virtual EnOnSendNotifyPolicy GetOnSendNotifyPolicy	()	= 0;
 	/* 获取最大连接数 */
 	virtual DWORD GetMaxConnectionCount				()	= 0;
-	/* 获取 Socket 缓存对象锁定时间 */
-	virtual DWORD GetFreeSocketObjLockTime			()	= 0;
 	/* 获取 Socket 缓存池大小 */
 	virtual DWORD GetFreeSocketObjPool				()	= 0;
 	/* 获取内存块缓存池大小 */
@@ -281,6 +281,70 @@ public:
 	/* 检测是否标记静默时间 */
 	virtual BOOL IsMarkSilence						()	= 0;
 
+public:
+
+	/***********************************************************************/
+	/***************************** 运行时度量方法 *****************************/
+
+	/* 设置是否采集运行时度量（可随时开关，默认：FALSE） */
+	virtual void SetCollectMetrics	(BOOL bCollectMetrics)							= 0;
+	/* 检测是否采集运行时度量 */
+	virtual BOOL IsCollectMetrics	()												= 0;
+
+	/*
+	* 名称：获取运行时度量
+	* 描述：汇总各工作线程的计数器与直方图，生成运行时度量快照
+	*		
+	* 参数：		metrics		-- 度量快照
+	* 返回值：	TRUE	-- 成功
+	*			FALSE	-- 失败（组件未启动）
+	*/
+	virtual BOOL GetMetrics			(TSocketMetrics& metrics)						= 0;
+
+	/*
+	* 名称：获取 Prometheus 格式运行时度量
+	* 描述：把运行时度量快照输出为 Prometheus 文本格式
+	*		
+	* 参数：		lpszBuffer	-- 文本缓冲区
+	*			iLength		-- 传入缓冲区长度，返回文本长度（含结束符）
+	*			lpszPrefix	-- 度量名称前缀（默认：hpsocket）
+	* 返回值：	TRUE	-- 成功
+	*			FALSE	-- 失败（缓冲区为空或长度不足时，iLength 返回所需长度）
+	*/
+	virtual BOOL GetMetricsText		(LPSTR lpszBuffer, int& iLength, LPCSTR lpszPrefix = nullptr)	= 0;
+
+public:
+
+	/***********************************************************************/
+	/**************************** 事件循环跟踪方法 ****************************/
+
+	/* 设置慢回调阈值（微秒，0 表示关闭事件循环跟踪，可随时开关，默认：0）；跟踪开启期间统计各工作线程繁忙率，处理耗时达到阈值的事件记入慢回调记录 */
+	virtual void SetSlowCallbackThreshold	(DWORD dwSlowCallbackThreshold)				= 0;
+	/* 获取慢回调阈值 */
+	virtual DWORD GetSlowCallbackThreshold	()											= 0;
+
+	/*
+	* 名称：获取工作线程跟踪统计
+	* 描述：获取各工作线程等待事件与处理事件的累计耗时及繁忙率
+	*		
+	* 参数：		stats		-- 统计数组（按工作线程序号排列）
+	*			dwCount		-- 数组长度（返回实际工作线程数）
+	* 返回值：	TRUE	-- 成功
+	*			FALSE	-- 失败（组件未启动，或数组为空、长度不足时 dwCount 返回所需长度）
+	*/
+	virtual BOOL GetWorkerTraceStats		(TWorkerTraceStat stats[], DWORD& dwCount)	= 0;
+
+	/*
+	* 名称：导出慢回调记录
+	* 描述：从慢回调跟踪环（最多保留最近 1024 条）导出记录，按发生先后排列
+	*		
+	* 参数：		records		-- 记录数组
+	*			dwCount		-- 数组长度（返回实际记录数）
+	* 返回值：	TRUE	-- 成功
+	*			FALSE	-- 失败（组件未启动，或数组为空、长度不足时 dwCount 返回所需长度）
+	*/
+	virtual BOOL GetSlowCallbacks			(TSlowCallback records[], DWORD& dwCount)	= 0;
+
 public:
 	virtual ~IComplexSocket() = default;
 };
@@ -403,6 +467,22 @@ public:
 	*/
 	virtual int AddSSLContextByMemory(int iVerifyMode = SSL_VM_NONE, LPCSTR lpszPemCert = nullptr, LPCSTR lpszPemKey = nullptr, LPCSTR lpszKeyPassword = nullptr, LPCSTR lpszCAPemCert = nullptr)																			= 0;
 
+	/*
+	* 名称：增加延迟加载的 SNI 主机证书
+	* 描述：与 AddSSLContext() 相同，但证书文件在首次被 SNI 选中时才加载，适用于大量 SNI 主机证书的场景
+	*		（常驻内存的延迟加载证书数量参考 SetSSLLazyContextCacheSize()）
+	*		
+	* 参数：		iVerifyMode				-- SSL 验证模式（参考 EnSSLVerifyMode）
+	*			lpszPemCertFile			-- 证书文件
+	*			lpszPemKeyFile			-- 私钥文件
+	*			lpszKeyPassword			-- 私钥密码（没有密码则为空）
+	*			lpszCAPemCertFileOrPath	-- CA 证书文件或目录（单向验证可选）
+	*
+	* 返回值：	正数		-- 成功，并返回 SNI 主机证书对应的索引，该索引用于在 SNI 回调函数中定位 SNI 主机
+	*			负数		-- 失败，可通过 SYS_GetLastError() 获取失败原因
+	*/
+	virtual int AddSSLContextLazy(int iVerifyMode, LPCTSTR lpszPemCertFile, LPCTSTR lpszPemKeyFile, LPCTSTR lpszKeyPassword = nullptr, LPCTSTR lpszCAPemCertFileOrPath = nullptr)																						= 0;
+
 	/*
 	* 名称：绑定 SNI 主机域名
 	* 描述：SSL 服务端在 AddSSLContext() 成功后可以调用本方法绑定主机域名到 SNI 主机证书
@@ -447,6 +527,14 @@ public:
 	virtual void SetAcceptSocketCount	(DWORD dwAcceptSocketCount)		= 0;
 	/* 设置通信数据缓冲区大小（根据平均通信数据包大小调整设置，通常设置为 1024 的倍数） */
 	virtual void SetSocketBufferSize	(DWORD dwSocketBufferSize)		= 0;
+	/* 设置是否批量接收（TRUE：同一轮事件处理中读取的数据通过一次 OnReceiveBatch() 通知交付，默认：FALSE） */
+	virtual void SetBatchReceive		(BOOL bBatchReceive)			= 0;
+	/* 设置单个连接每轮事件处理的读写字节预算（0 则只限制读写次数，默认：256 * 1024，用尽预算的连接推迟到本批事件之后继续处理） */
+	virtual void SetIoBytesBudget		(DWORD dwIoBytesBudget)			= 0;
+	/* 设置单个连接每轮事件处理的时间预算（微秒，0 则不限制，默认：0） */
+	virtual void SetIoTimeBudget		(DWORD dwIoTimeBudget)			= 0;
+	/* 设置是否使用边缘触发（TRUE：读事件以 EV_CLEAR 方式注册并读取至 EAGAIN，每次处理后重新启用，默认：FALSE） */
+	virtual void SetEdgeTrigger			(BOOL bEdgeTrigger)				= 0;
 	/* 设置监听 Socket 的等候队列大小（根据并发连接数量调整设置） */
 	virtual void SetSocketListenQueue	(DWORD dwSocketListenQueue)		= 0;
 	/* 设置正常心跳包间隔（毫秒，0 则不发送心跳包，默认：60 * 1000） */
@@ -458,6 +546,14 @@ public:
 	virtual DWORD GetAcceptSocketCount	()	= 0;
 	/* 获取通信数据缓冲区大小 */
 	virtual DWORD GetSocketBufferSize	()	= 0;
+	/* 检测是否批量接收 */
+	virtual BOOL IsBatchReceive			()	= 0;
+	/* 获取单个连接每轮事件处理的读写字节预算 */
+	virtual DWORD GetIoBytesBudget		()	= 0;
+	/* 获取单个连接每轮事件处理的时间预算 */
+	virtual DWORD GetIoTimeBudget		()	= 0;
+	/* 检测是否使用边缘触发 */
+	virtual BOOL IsEdgeTrigger			()	= 0;
 	/* 获取监听 Socket 的等候队列大小 */
 	virtual DWORD GetSocketListenQueue	()	= 0;
 	/* 获取正常心跳包间隔 */
@@ -476,6 +572,24 @@ public:
 	/* 获取 SSL 加密算法列表 */
 	virtual LPCTSTR GetSSLCipherList()									= 0;
 
+	/* 设置 ALPN 协议列表（逗号分隔，按优先级排列，如："h2,http/1.1"；默认：空，不使用 ALPN；必须在 SetupSSLContext() 前设置） */
+	virtual void SetSSLAlpnProtocols(LPCTSTR lpszProtocols)				= 0;
+	/* 获取 ALPN 协议列表 */
+	virtual LPCTSTR GetSSLAlpnProtocols()								= 0;
+
+	/*
+	* 设置 SSL 握手线程数量（默认：0，在通信工作线程中握手；大于 0 则由独立的握手线程池执行握手运算）
+	* 注意：大于 0 时，OnHandShake() 事件以及握手期间到达数据的 OnReceive() 事件在握手线程中触发，
+	*		握手完成前该连接暂停接收，同一连接的事件仍按顺序触发
+	*/
+	virtual void SetSSLHandShakeThreadCount(DWORD dwThreadCount)		= 0;
+	/* 获取 SSL 握手线程数量 */
+	virtual DWORD GetSSLHandShakeThreadCount()							= 0;
+	/* 设置延迟加载 SNI 主机证书的最大常驻数量（默认：0，不限制，超出时淘汰最久未使用的证书） */
+	virtual void SetSSLLazyContextCacheSize(DWORD dwCacheSize)			= 0;
+	/* 获取延迟加载 SNI 主机证书的最大常驻数量 */
+	virtual DWORD GetSSLLazyContextCacheSize()							= 0;
+
 	/*
 	* 名称：获取 SSL Session 信息
 	* 描述：获取指定类型的 SSL Session 信息（输出类型参考：EnSSLSessionInfo）
@@ -564,6 +678,16 @@ public:
 	virtual void SetMaxMessageSize		(DWORD dwMaxMessageSize)	= 0;
 	/* 设置握手超时时间（毫秒，默认：5000） */
 	virtual void SetHandShakeTimeout	(DWORD dwHandShakeTimeout)	= 0;
+	/* 设置批量发送最大刷新延迟（毫秒，默认：0，每次发送立即刷新；大于 0 则合并多次发送及 ACK，在该延迟内或待发数据满一个 MTU 时刷新） */
+	virtual void SetFlushDelay			(DWORD dwFlushDelay)		= 0;
+	/* 设置 FEC 数据分片数（默认：0，与校验分片数均大于 0 时启用 FEC，两端必须设置一致） */
+	virtual void SetFecDataShards		(DWORD dwDataShards)		= 0;
+	/* 设置 FEC 校验分片数（默认：0，每个分组最多可恢复丢失的分片数；数据分片数与校验分片数之和不大于 255） */
+	virtual void SetFecParityShards		(DWORD dwParityShards)		= 0;
+	/* 设置拥塞控制算法（默认：ACC_KCP；其它算法不能与 SetTurnoffCongestCtrl(TRUE) 同时使用，否则启动失败） */
+	virtual void SetCongestCtrl			(EnArqCongestCtrl enCongestCtrl)	= 0;
+	/* 设置发送速率（字节/秒，默认：0；ACC_FIXED_RATE 的固定发送速率，ACC_BBR 的发送速率上限，0 则不限制） */
+	virtual void SetPacingRate			(DWORD dwPacingRate)		= 0;
 
 	/* 检测是否开启 nodelay 模式 */
 	virtual BOOL IsNoDelay				()							= 0;
@@ -587,9 +711,21 @@ public:
 	virtual DWORD GetMaxMessageSize		()							= 0;
 	/* 获取握手超时时间 */
 	virtual DWORD GetHandShakeTimeout	()							= 0;
+	/* 获取批量发送最大刷新延迟 */
+	virtual DWORD GetFlushDelay			()							= 0;
+	/* 获取 FEC 数据分片数 */
+	virtual DWORD GetFecDataShards		()							= 0;
+	/* 获取 FEC 校验分片数 */
+	virtual DWORD GetFecParityShards	()							= 0;
+	/* 获取拥塞控制算法 */
+	virtual EnArqCongestCtrl GetCongestCtrl	()						= 0;
+	/* 获取发送速率 */
+	virtual DWORD GetPacingRate			()							= 0;
 
 	/* 获取等待发送包数量 */
 	virtual BOOL GetWaitingSendMessageCount	(CONNID dwConnID, int& iCount)	= 0;
+	/* 获取连接的拥塞控制状态（拥塞窗口、RTT、发送速率等） */
+	virtual BOOL GetSessionStats			(CONNID dwConnID, TArqSessionStats& stats)	= 0;
 
 public:
 	virtual ~IArqSocket() = default;
@@ -736,6 +872,14 @@ public:
 
 	/* 设置通信数据缓冲区大小（根据平均通信数据包大小调整设置，通常设置为 1024 的倍数） */
 	virtual void SetSocketBufferSize	(DWORD dwSocketBufferSize)		= 0;
+	/* 设置是否批量接收（TRUE：同一轮事件处理中读取的数据通过一次 OnReceiveBatch() 通知交付，默认：FALSE） */
+	virtual void SetBatchReceive		(BOOL bBatchReceive)			= 0;
+	/* 设置单个连接每轮事件处理的读写字节预算（0 则只限制读写次数，默认：256 * 1024，用尽预算的连接推迟到本批事件之后继续处理） */
+	virtual void SetIoBytesBudget		(DWORD dwIoBytesBudget)			= 0;
+	/* 设置单个连接每轮事件处理的时间预算（微秒，0 则不限制，默认：0） */
+	virtual void SetIoTimeBudget		(DWORD dwIoTimeBudget)			= 0;
+	/* 设置是否使用边缘触发（TRUE：读事件以 EV_CLEAR 方式注册并读取至 EAGAIN，每次处理后重新启用，默认：FALSE） */
+	virtual void SetEdgeTrigger			(BOOL bEdgeTrigger)				= 0;
 	/* 设置正常心跳包间隔（毫秒，0 则不发送心跳包，默认：60 * 1000） */
 	virtual void SetKeepAliveTime		(DWORD dwKeepAliveTime)			= 0;
 	/* 设置异常心跳包间隔（毫秒，0 不发送心跳包，，默认：20 * 1000，如果超过若干次 [默认：WinXP 5 次, Win7 10 次] 检测不到心跳确认包则认为已断线） */
@@ -743,6 +887,14 @@ public:
 
 	/* 获取通信数据缓冲区大小 */
 	virtual DWORD GetSocketBufferSize	()	= 0;
+	/* 检测是否批量接收 */
+	virtual BOOL IsBatchReceive			()	= 0;
+	/* 获取单个连接每轮事件处理的读写字节预算 */
+	virtual DWORD GetIoBytesBudget		()	= 0;
+	/* 获取单个连接每轮事件处理的时间预算 */
+	virtual DWORD GetIoTimeBudget		()	= 0;
+	/* 检测是否使用边缘触发 */
+	virtual BOOL IsEdgeTrigger			()	= 0;
 	/* 获取正常心跳包间隔 */
 	virtual DWORD GetKeepAliveTime		()	= 0;
 	/* 获取异常心跳包间隔 */
@@ -759,6 +911,11 @@ public:
 	/* 获取 SSL 加密算法列表 */
 	virtual LPCTSTR GetSSLCipherList()									= 0;
 
+	/* 设置 ALPN 协议列表（逗号分隔，按优先级排列，如："h2,http/1.1"；默认：空，不使用 ALPN；必须在 SetupSSLContext() 前设置） */
+	virtual void SetSSLAlpnProtocols(LPCTSTR lpszProtocols)				= 0;
+	/* 获取 ALPN 协议列表 */
+	virtual LPCTSTR GetSSLAlpnProtocols()								= 0;
+
 	/*
 	* 名称：获取 SSL Session 信息
 	* 描述：获取指定类型的 SSL Session 信息（输出类型参考：EnSSLSessionInfo）
@@ -899,6 +1056,38 @@ public:
 	/* 获取内存块缓存池回收阀值 */
 	virtual DWORD GetFreeBufferPoolHold		()													= 0;
 
+public:
+
+	/***********************************************************************/
+	/***************************** 运行时度量方法 *****************************/
+
+	/* 设置是否采集运行时度量（可随时开关，默认：FALSE） */
+	virtual void SetCollectMetrics	(BOOL bCollectMetrics)							= 0;
+	/* 检测是否采集运行时度量 */
+	virtual BOOL IsCollectMetrics	()												= 0;
+
+	/*
+	* 名称：获取运行时度量
+	* 描述：汇总各工作线程的计数器与直方图，生成运行时度量快照
+	*		
+	* 参数：		metrics		-- 度量快照
+	* 返回值：	TRUE	-- 成功
+	*			FALSE	-- 失败（组件未启动）
+	*/
+	virtual BOOL GetMetrics			(TSocketMetrics& metrics)						= 0;
+
+	/*
+	* 名称：获取 Prometheus 格式运行时度量
+	* 描述：把运行时度量快照输出为 Prometheus 文本格式
+	*		
+	* 参数：		lpszBuffer	-- 文本缓冲区
+	*			iLength		-- 传入缓冲区长度，返回文本长度（含结束符）
+	*			lpszPrefix	-- 度量名称前缀（默认：hpsocket）
+	* 返回值：	TRUE	-- 成功
+	*			FALSE	-- 失败（缓冲区为空或长度不足时，iLength 返回所需长度）
+	*/
+	virtual BOOL GetMetricsText		(LPSTR lpszBuffer, int& iLength, LPCSTR lpszPrefix = nullptr)	= 0;
+
 public:
 	virtual ~IClient() = default;
 };
@@ -1010,6 +1199,11 @@ public:
 	/* 获取 SSL 加密算法列表 */
 	virtual LPCTSTR GetSSLCipherList()						= 0;
 
+	/* 设置 ALPN 协议列表（逗号分隔，按优先级排列，如："h2,http/1.1"；默认：空，不使用 ALPN；必须在 SetupSSLContext() 前设置） */
+	virtual void SetSSLAlpnProtocols(LPCTSTR lpszProtocols)	= 0;
+	/* 获取 ALPN 协议列表 */
+	virtual LPCTSTR GetSSLAlpnProtocols()					= 0;
+
 	/*
 	* 名称：获取 SSL Session 信息
 	* 描述：获取指定类型的 SSL Session 信息（输出类型参考：EnSSLSessionInfo）
@@ -1222,6 +1416,11 @@ public:
 	/* 获取数据报文最大长度 */
 	virtual DWORD GetMaxDatagramSize()							= 0;
 
+	/* 设置是否批量接收（TRUE：同一轮事件处理中接收的数据报通过一次 OnReceiveBatch() 通知交付，默认：FALSE） */
+	virtual void SetBatchReceive	(BOOL bBatchReceive)		= 0;
+	/* 检测是否批量接收 */
+	virtual BOOL IsBatchReceive		()							= 0;
+
 	/* 设置组播报文的 TTL（0 - 255） */
 	virtual void SetMultiCastTtl	(int iMCTtl)				= 0;
 	/* 获取组播报文的 TTL */
@@ -1254,6 +1453,70 @@ public:
 	/* 获取内存块缓存池回收阀值 */	
 	virtual DWORD GetFreeBufferPoolHold	()									= 0;
 
+public:
+
+	/***********************************************************************/
+	/***************************** 运行时度量方法 *****************************/
+
+	/* 设置是否采集运行时度量（可随时开关，默认：FALSE） */
+	virtual void SetCollectMetrics	(BOOL bCollectMetrics)							= 0;
+	/* 检测是否采集运行时度量 */
+	virtual BOOL IsCollectMetrics	()												= 0;
+
+	/*
+	* 名称：获取运行时度量
+	* 描述：汇总各工作线程的计数器与直方图，生成运行时度量快照
+	*		
+	* 参数：		metrics		-- 度量快照
+	* 返回值：	TRUE	-- 成功
+	*			FALSE	-- 失败（组件未启动）
+	*/
+	virtual BOOL GetMetrics			(TSocketMetrics& metrics)						= 0;
+
+	/*
+	* 名称：获取 Prometheus 格式运行时度量
+	* 描述：把运行时度量快照输出为 Prometheus 文本格式
+	*		
+	* 参数：		lpszBuffer	-- 文本缓冲区
+	*			iLength		-- 传入缓冲区长度，返回文本长度（含结束符）
+	*			lpszPrefix	-- 度量名称前缀（默认：hpsocket）
+	* 返回值：	TRUE	-- 成功
+	*			FALSE	-- 失败（缓冲区为空或长度不足时，iLength 返回所需长度）
+	*/
+	virtual BOOL GetMetricsText		(LPSTR lpszBuffer, int& iLength, LPCSTR lpszPrefix = nullptr)	= 0;
+
+public:
+
+	/***********************************************************************/
+	/**************************** 事件循环跟踪方法 ****************************/
+
+	/* 设置慢回调阈值（微秒，0 表示关闭事件循环跟踪，可随时开关，默认：0）；跟踪开启期间统计各工作线程繁忙率，处理耗时达到阈值的事件记入慢回调记录 */
+	virtual void SetSlowCallbackThreshold	(DWORD dwSlowCallbackThreshold)				= 0;
+	/* 获取慢回调阈值 */
+	virtual DWORD GetSlowCallbackThreshold	()											= 0;
+
+	/*
+	* 名称：获取工作线程跟踪统计
+	* 描述：获取各工作线程等待事件与处理事件的累计耗时及繁忙率
+	*		
+	* 参数：		stats		-- 统计数组（按工作线程序号排列）
+	*			dwCount		-- 数组长度（返回实际工作线程数）
+	* 返回值：	TRUE	-- 成功
+	*			FALSE	-- 失败（组件未启动，或数组为空、长度不足时 dwCount 返回所需长度）
+	*/
+	virtual BOOL GetWorkerTraceStats		(TWorkerTraceStat stats[], DWORD& dwCount)	= 0;
+
+	/*
+	* 名称：导出慢回调记录
+	* 描述：从慢回调跟踪环（最多保留最近 1024 条）导出记录，按发生先后排列
+	*		
+	* 参数：		records		-- 记录数组
+	*			dwCount		-- 数组长度（返回实际记录数）
+	* 返回值：	TRUE	-- 成功
+	*			FALSE	-- 失败（组件未启动，或数组为空、长度不足时 dwCount 返回所需长度）
+	*/
+	virtual BOOL GetSlowCallbacks			(TSlowCallback records[], DWORD& dwCount)	= 0;
+
 public:
 	virtual ~IUdpNode() = default;
 };
@@ -1296,6 +1559,16 @@ public:
 	virtual void SetMaxMessageSize		(DWORD dwMaxMessageSize)	= 0;
 	/* 设置握手超时时间（毫秒，默认：5000） */
 	virtual void SetHandShakeTimeout	(DWORD dwHandShakeTimeout)	= 0;
+	/* 设置批量发送最大刷新延迟（毫秒，默认：0，每次发送立即刷新；大于 0 则合并多次发送及 ACK，在该延迟内或待发数据满一个 MTU 时刷新） */
+	virtual void SetFlushDelay			(DWORD dwFlushDelay)		= 0;
+	/* 设置 FEC 数据分片数（默认：0，与校验分片数均大于 0 时启用 FEC，两端必须设置一致） */
+	virtual void SetFecDataShards		(DWORD dwDataShards)		= 0;
+	/* 设置 FEC 校验分片数（默认：0，每个分组最多可恢复丢失的分片数；数据分片数与校验分片数之和不大于 255） */
+	virtual void SetFecParityShards		(DWORD dwParityShards)		= 0;
+	/* 设置拥塞控制算法（默认：ACC_KCP；其它算法不能与 SetTurnoffCongestCtrl(TRUE) 同时使用，否则启动失败） */
+	virtual void SetCongestCtrl			(EnArqCongestCtrl enCongestCtrl)	= 0;
+	/* 设置发送速率（字节/秒，默认：0；ACC_FIXED_RATE 的固定发送速率，ACC_BBR 的发送速率上限，0 则不限制） */
+	virtual void SetPacingRate			(DWORD dwPacingRate)		= 0;
 
 	/* 检测是否开启 nodelay 模式 */
 	virtual BOOL IsNoDelay				()							= 0;
@@ -1319,9 +1592,21 @@ public:
 	virtual DWORD GetMaxMessageSize		()							= 0;
 	/* 获取握手超时时间 */
 	virtual DWORD GetHandShakeTimeout	()							= 0;
+	/* 获取批量发送最大刷新延迟 */
+	virtual DWORD GetFlushDelay			()							= 0;
+	/* 获取 FEC 数据分片数 */
+	virtual DWORD GetFecDataShards		()							= 0;
+	/* 获取 FEC 校验分片数 */
+	virtual DWORD GetFecParityShards	()							= 0;
+	/* 获取拥塞控制算法 */
+	virtual EnArqCongestCtrl GetCongestCtrl	()						= 0;
+	/* 获取发送速率 */
+	virtual DWORD GetPacingRate			()							= 0;
 
 	/* 获取等待发送包数量 */
 	virtual BOOL GetWaitingSendMessageCount	(int& iCount)			= 0;
+	/* 获取连接的拥塞控制状态（拥塞窗口、RTT、发送速率等） */
+	virtual BOOL GetSessionStats			(TArqSessionStats& stats)	= 0;
 
 public:
 	virtual ~IArqClient() = default;
@@ -1478,7 +1763,8 @@ public:
 	/*
 	* 名称：握手完成通知
 	* 描述：连接完成握手时，Socket 监听器将收到该通知，监听器接收到该通知后才能开始
-	*		数据收发操作
+	*		数据收发操作（SSL Server 设置了握手线程数量时，该通知及紧随其后的 OnReceive()
+	*		通知在握手线程中触发，参考：ITcpServer::SetSSLHandShakeThreadCount()）
 	*		
 	* 参数：		pSender		-- 事件源对象
 	*			dwConnID	-- 连接 ID
@@ -1525,6 +1811,29 @@ public:
 	*/
 	virtual EnHandleResult OnReceive(T* pSender, CONNID dwConnID, int iLength)									= 0;
 
+	/*
+	* 名称：批量数据到达通知（PUSH 模型）
+	* 描述：组件启用批量接收（SetBatchReceive(TRUE)）后，同一轮事件处理中读取到的所有数据
+	*		通过该通知一次性交付，默认实现逐个缓冲区调用 OnReceive()
+	*		
+	* 参数：		pSender		-- 事件源对象
+	*			dwConnID	-- 连接 ID
+	*			pBuffers	-- 已接收数据缓冲区数组（只在通知期间有效）
+	*			iCount		-- 缓冲区数量
+	* 返回值：	HR_OK / HR_IGNORE	-- 继续执行
+	*			HR_ERROR			-- 引发 OnClose() 事件并关闭连接
+	*/
+	virtual EnHandleResult OnReceiveBatch(T* pSender, CONNID dwConnID, const WSABUF pBuffers[], int iCount)
+	{
+		for(int i = 0; i < iCount; i++)
+		{
+			if(OnReceive(pSender, dwConnID, pBuffers[i].buf, (int)pBuffers[i].len) == HR_ERROR)
+				return HR_ERROR;
+		}
+
+		return HR_OK;
+	}
+
 	/*
 	* 名称：通信错误通知
 	* 描述：通信发生错误后，Socket 监听器将收到该通知，并关闭连接
@@ -1891,6 +2200,27 @@ public:
 	*/
 	virtual EnHandleResult OnReceive(IUdpNode* pSender, LPCTSTR lpszRemoteAddress, USHORT usRemotePort, const BYTE* pData, int iLength)	= 0;
 
+	/*
+	* 名称：批量数据到达通知（PUSH 模型）
+	* 描述：组件启用批量接收（SetBatchReceive(TRUE)）后，同一轮事件处理中接收到的所有数据报
+	*		通过该通知一次性交付，默认实现逐个数据报调用 OnReceive()
+	*		
+	* 参数：		pSender				-- 事件源对象
+	*			pDatagrams			-- 数据报数组（包含各数据报的远程地址，只在通知期间有效）
+	*			iCount				-- 数据报数量
+	* 返回值：	忽略返回值
+	*/
+	virtual EnHandleResult OnReceiveBatch(IUdpNode* pSender, const TUdpDatagram pDatagrams[], int iCount)
+	{
+		for(int i = 0; i < iCount; i++)
+		{
+			const TUdpDatagram& dg = pDatagrams[i];
+			OnReceive(pSender, dg.address, dg.port, dg.buffer.buf, (int)dg.buffer.len);
+		}
+
+		return HR_OK;
+	}
+
 	/*
 	* 名称：通信错误通知
 	* 描述：通信发生错误后，Socket 监听器将收到该通知
@@ -1972,6 +2302,20 @@ public:
 	*/
 	virtual BOOL SendChunkData(CONNID dwConnID, const BYTE* pData = nullptr, int iLength = 0, LPCSTR lpszExtensions = nullptr)	= 0;
 
+	/*
+	* 名称：发送 HTTP/2 流数据
+	* 描述：向 HTTP/2 连接的指定流发送消息体数据（消息头部设置了 Transfer-Encoding 时，消息体通过本方法发送），
+	*		超出对端流量控制窗口的数据缓存在流中，窗口更新后继续发送；可在任意线程中调用
+	*		
+	* 参数：		dwConnID		-- 连接 ID
+	*			dwStreamID		-- 流 ID
+	*			pData			-- 数据
+	*			iLength			-- 数据长度（为 0 表示结束流）
+	* 返回值：	TRUE			-- 成功
+	*			FALSE			-- 失败，可通过 SYS_GetLastError() 获取错误代码
+	*/
+	virtual BOOL SendStreamChunkData(CONNID dwConnID, DWORD dwStreamID, const BYTE* pData = nullptr, int iLength = 0)	= 0;
+
 public:
 
 	/***********************************************************************/
@@ -1988,6 +2332,15 @@ public:
 	virtual BOOL IsKeepAlive(CONNID dwConnID)											= 0;
 	/* 获取协议版本 */
 	virtual USHORT GetVersion(CONNID dwConnID)											= 0;
+
+	/*
+	* 以下返回字符串指针的方法（GetContentType()、GetHeader()、GetAllHeaders()、GetCookie()、GetHost()、GetUrlField()、GetMethod() 等）
+	* 返回的指针指向连接内部的 HTTP 对象，连接关闭后该对象随时可能被回收重用：
+	*	1、在该连接的事件回调中调用时，指针在回调返回前有效；
+	*	2、在事件回调之外（如异步回复线程）调用时，须在对象访问保护段（HP_EnterObjectEpoch() / HP_LeaveObjectEpoch() 或 CHPObjectEpochGuard）
+	*	   内调用并使用返回的指针，离开保护段前复制所需数据；连接开始解析下一个请求后，取得的数据为新请求的数据
+	*/
+
 	/* 获取内容长度 */
 	virtual ULONGLONG GetContentLength(CONNID dwConnID)									= 0;
 	/* 获取内容类型 */
@@ -2032,6 +2385,34 @@ public:
 	/* 获取 HTTP 启动方式 */
 	virtual BOOL IsHttpAutoStart()																	= 0;
 
+	/*
+	* 设置是否支持 HTTP/2（默认：FALSE）
+	*	服务端：连接以 HTTP/2 连接前言开始时使用 HTTP/2（明文连接不支持通过 Upgrade 升级到 h2c）
+	*	客户端：明文连接直接使用 HTTP/2（prior knowledge），SSL 连接在 ALPN 协商结果为 "h2" 时使用 HTTP/2，否则使用 HTTP/1.x
+	*	HTTP/2 连接中多个流的事件交错触发，GetStreamID() 返回最近一个事件所属的流，GetHeader() / GetUrlField() 等连接级的访问方法
+	*	返回最近一个头部块的内容，只在该流的事件回调中有效（新的流会覆盖这些数据）；
+	*	异步回复请求时应在 OnMessageBegin 事件中保存 GetStreamID() 的返回值，在回调之外通过 GetStreamHeader() 按流获取头部，
+	*	再通过 SendStreamResponse() 回复
+	*/
+	virtual void SetHttp2Support(BOOL bSupport)													= 0;
+	/* 检查是否支持 HTTP/2 */
+	virtual BOOL IsHttp2Support()																	= 0;
+	/* 设置 HTTP/2 连接允许对端创建的最大并发流数量（默认：256） */
+	virtual void SetHttp2MaxConcurrentStreams(DWORD dwMaxConcurrentStreams)						= 0;
+	/* 获取 HTTP/2 连接允许对端创建的最大并发流数量 */
+	virtual DWORD GetHttp2MaxConcurrentStreams()													= 0;
+	/* 检查连接是否使用 HTTP/2 */
+	virtual BOOL IsHttp2(CONNID dwConnID)															= 0;
+	/* 获取当前事件所属的 HTTP/2 流 ID（HTTP/1.x 连接返回 0） */
+	virtual DWORD GetStreamID(CONNID dwConnID)														= 0;
+	/*
+	* 获取 HTTP/2 流的头部字段值（对端发送的第一个头部块，流关闭前可在任意线程中调用）
+	*		lpszName	-- 字段名称（不区分大小写，可获取 ":method"、":path" 等伪头部，"Host" 不存在时取 ":authority"）
+	*		iValueLen	-- 传入：缓冲区长度；传出：值长度（包含结尾的 '\0'），缓冲区不足时返回 FALSE 并设置为所需长度
+	* 失败时通过 SYS_GetLastError() 获取错误代码（HTTP/1.x 连接：ERROR_INVALID_STATE；流或字段不存在：ERROR_OBJECT_NOT_FOUND）
+	*/
+	virtual BOOL GetStreamHeader(CONNID dwConnID, DWORD dwStreamID, LPCSTR lpszName, LPSTR lpszValue, int& iValueLen)	= 0;
+
 public:
 	virtual ~IComplexHttp() = default;
 };
@@ -2084,6 +2465,24 @@ public:
 	*/
 	virtual BOOL SendRequest(CONNID dwConnID, LPCSTR lpszMethod, LPCSTR lpszPath, const THeader lpHeaders[] = nullptr, int iHeaderCount = 0, const BYTE* pBody = nullptr, int iLength = 0)	= 0;
 
+	/*
+	* 名称：发送 HTTP/2 请求
+	* 描述：在 HTTP/2 连接上创建新的流并发送请求，可在任意线程中调用；HTTP/2 连接中 SendRequest() 同样创建新的流，
+	*		请求头部设置了 Transfer-Encoding 时，请求体通过 SendStreamChunkData() 继续发送（HTTP/2 连接中不能调用 SendChunkData()）
+	*		
+	* 参数：		dwConnID		-- 连接 ID
+	*			lpdwStreamID	-- 新创建的流 ID（可为 nullptr）
+	*			lpszMethod		-- 请求方法
+	*			lpszPath		-- 请求路径
+	*			lpHeaders		-- 请求头
+	*			iHeaderCount	-- 请求头数量
+	*			pBody			-- 请求体
+	*			iLength			-- 请求体长度
+	* 返回值：	TRUE			-- 成功
+	*			FALSE			-- 失败，可通过 SYS_GetLastError() 获取错误代码
+	*/
+	virtual BOOL SendStreamRequest(CONNID dwConnID, DWORD* lpdwStreamID, LPCSTR lpszMethod, LPCSTR lpszPath, const THeader lpHeaders[] = nullptr, int iHeaderCount = 0, const BYTE* pBody = nullptr, int iLength = 0)	= 0;
+
 	/*
 	* 名称：发送本地文件
 	* 描述：向指定连接发送 4096 KB 以下的小文件
@@ -2179,6 +2578,25 @@ public:
 	*/
 	virtual BOOL SendResponse(CONNID dwConnID, USHORT usStatusCode, LPCSTR lpszDesc = nullptr, const THeader lpHeaders[] = nullptr, int iHeaderCount = 0, const BYTE* pData = nullptr, int iLength = 0)	= 0;
 
+	/*
+	* 名称：回复 HTTP/2 请求
+	* 描述：向 HTTP/2 连接的指定流回复请求（流 ID 通过 GetStreamID() 获取），可在任意线程中调用；
+	*		HTTP/2 连接中 SendResponse() / SendLocalFile() / SendChunkData() 只能在流的事件回调中调用（回复该流），
+	*		在其它线程或事件回调之外调用时失败（错误代码：ERROR_INVALID_STATE）；HTTP/2 不传输状态描述，lpszDesc 被忽略
+	*		
+	* 参数：		dwConnID		-- 连接 ID
+	*			dwStreamID		-- 流 ID
+	*			usStatusCode	-- HTTP 状态码
+	*			lpszDesc		-- HTTP 状态描述
+	*			lpHeaders		-- 回复请求头
+	*			iHeaderCount	-- 回复请求头数量
+	*			pData			-- 回复请求体
+	*			iLength			-- 回复请求体长度
+	* 返回值：	TRUE			-- 成功
+	*			FALSE			-- 失败，可通过 SYS_GetLastError() 获取错误代码
+	*/
+	virtual BOOL SendStreamResponse(CONNID dwConnID, DWORD dwStreamID, USHORT usStatusCode, LPCSTR lpszDesc = nullptr, const THeader lpHeaders[] = nullptr, int iHeaderCount = 0, const BYTE* pData = nullptr, int iLength = 0)	= 0;
+
 	/*
 	* 名称：发送本地文件
 	* 描述：向指定连接发送 4096 KB 以下的小文件
@@ -2194,6 +2612,26 @@ public:
 	*/
 	virtual BOOL SendLocalFile(CONNID dwConnID, LPCSTR lpszFileName, USHORT usStatusCode = HSC_OK, LPCSTR lpszDesc = nullptr, const THeader lpHeaders[] = nullptr, int iHeaderCount = 0)				= 0;
 
+	/*
+	* 名称：按请求序号回复请求
+	* 描述：启用管线化（通过 SetMaxPipelineRequests() 设置）时，向客户端回复序号为 dwSeq 的请求（请求序号通过 GetRequestSeq() 获取），
+	*		响应按请求序号顺序发送，可在任意线程中调用；启用管线化时 SendResponse() / SendLocalFile() 回复最早的未回复请求；
+	*		未回复请求数达到上限时停止解析后续请求，GetHeader() / GetUrlField() 等方法只返回当前正在解析的请求的数据，
+	*		在事件回调之外异步回复时，需在 OnHeadersComplete() 等事件中复制所需的请求数据
+	*		
+	* 参数：		dwConnID		-- 连接 ID
+	*			dwSeq			-- 请求序号
+	*			usStatusCode	-- HTTP 状态码
+	*			lpszDesc		-- HTTP 状态描述
+	*			lpHeaders		-- 回复请求头
+	*			iHeaderCount	-- 回复请求头数量
+	*			pData			-- 回复请求体
+	*			iLength			-- 回复请求体长度
+	* 返回值：	TRUE			-- 成功（响应已发送或已进入响应队列）
+	*			FALSE			-- 失败，可通过 SYS_GetLastError() 获取错误代码
+	*/
+	virtual BOOL SendPipelineResponse(CONNID dwConnID, DWORD dwSeq, USHORT usStatusCode, LPCSTR lpszDesc = nullptr, const THeader lpHeaders[] = nullptr, int iHeaderCount = 0, const BYTE* pData = nullptr, int iLength = 0)	= 0;
+
 	/*
 	* 名称：释放连接
 	* 描述：把连接放入释放队列，等待某个时间（通过 SetReleaseDelay() 设置）关闭连接
@@ -2216,6 +2654,16 @@ public:
 	virtual void SetReleaseDelay(DWORD dwReleaseDelay)					= 0;
 	/* 获取连接释放延时 */
 	virtual DWORD GetReleaseDelay()										= 0;
+	/* 设置是否启用请求头快速解析（默认：FALSE，启用后使用 SIMD 指令批量查找请求头分界字符，不能快速解析的请求仍由 http_parser 解析） */
+	virtual void SetFastParse(BOOL bFastParse)							= 0;
+	/* 检测是否启用请求头快速解析 */
+	virtual BOOL IsFastParse()											= 0;
+	/* 设置每个连接的最大未回复管线化请求数（默认：0，不启用管线化；启用后响应按请求顺序发送，未回复请求数达到上限时停止解析并暂停接收） */
+	virtual void SetMaxPipelineRequests(DWORD dwMaxPipelineRequests)	= 0;
+	/* 获取每个连接的最大未回复管线化请求数 */
+	virtual DWORD GetMaxPipelineRequests()								= 0;
+	/* 获取当前请求的序号（在 OnMessageBegin() 到 OnMessageComplete() 事件中调用，用于 SendPipelineResponse()；失败时返回 HTTP_INVALID_REQUEST_SEQ） */
+	virtual DWORD GetRequestSeq(CONNID dwConnID)						= 0;
 
 	/* 获取请求行 URL 域掩码（URL 域参考：EnHttpUrlField） */
 	virtual USHORT GetUrlFieldSet(CONNID dwConnID)						= 0;
@@ -2277,6 +2725,18 @@ public:
 	*/
 	virtual BOOL SendChunkData(const BYTE* pData = nullptr, int iLength = 0, LPCSTR lpszExtensions = nullptr)	= 0;
 
+	/*
+	* 名称：发送 HTTP/2 流数据
+	* 描述：向 HTTP/2 连接的指定流发送消息体数据（消息头部设置了 Transfer-Encoding 时，消息体通过本方法发送）
+	*		
+	* 参数：		dwStreamID		-- 流 ID
+	*			pData			-- 数据
+	*			iLength			-- 数据长度（为 0 表示结束流）
+	* 返回值：	TRUE			-- 成功
+	*			FALSE			-- 失败，可通过 SYS_GetLastError() 获取错误代码
+	*/
+	virtual BOOL SendStreamChunkData(DWORD dwStreamID, const BYTE* pData = nullptr, int iLength = 0)	= 0;
+
 public:
 
 	/***********************************************************************/
@@ -2340,6 +2800,21 @@ public:
 	/* 获取 HTTP 启动方式 */
 	virtual BOOL IsHttpAutoStart()													= 0;
 
+	/* 设置是否支持 HTTP/2（默认：FALSE；明文连接直接使用 HTTP/2，SSL 连接在 ALPN 协商结果为 "h2" 时使用 HTTP/2） */
+	virtual void SetHttp2Support(BOOL bSupport)									= 0;
+	/* 检查是否支持 HTTP/2 */
+	virtual BOOL IsHttp2Support()													= 0;
+	/* 设置 HTTP/2 连接允许对端创建的最大并发流数量（默认：256） */
+	virtual void SetHttp2MaxConcurrentStreams(DWORD dwMaxConcurrentStreams)		= 0;
+	/* 获取 HTTP/2 连接允许对端创建的最大并发流数量 */
+	virtual DWORD GetHttp2MaxConcurrentStreams()									= 0;
+	/* 检查连接是否使用 HTTP/2 */
+	virtual BOOL IsHttp2()															= 0;
+	/* 获取当前事件所属的 HTTP/2 流 ID（HTTP/1.x 连接返回 0） */
+	virtual DWORD GetStreamID()														= 0;
+	/* 获取 HTTP/2 流的头部字段值（参考：IComplexHttp::GetStreamHeader()） */
+	virtual BOOL GetStreamHeader(DWORD dwStreamID, LPCSTR lpszName, LPSTR lpszValue, int& iValueLen)	= 0;
+
 public:
 	virtual ~IHttp() = default;
 };
@@ -2370,6 +2845,23 @@ public:
 	*/
 	virtual BOOL SendRequest(LPCSTR lpszMethod, LPCSTR lpszPath, const THeader lpHeaders[] = nullptr, int iHeaderCount = 0, const BYTE* pBody = nullptr, int iLength = 0)	= 0;
 
+	/*
+	* 名称：发送 HTTP/2 请求
+	* 描述：在 HTTP/2 连接上创建新的流并发送请求，可在任意线程中调用；HTTP/2 连接中 SendRequest() 同样创建新的流，
+	*		请求头部设置了 Transfer-Encoding 时，请求体通过 SendStreamChunkData() 继续发送（HTTP/2 连接中不能调用 SendChunkData()）
+	*		
+	* 参数：		lpdwStreamID	-- 新创建的流 ID（可为 nullptr）
+	*			lpszMethod		-- 请求方法
+	*			lpszPath		-- 请求路径
+	*			lpHeaders		-- 请求头
+	*			iHeaderCount	-- 请求头数量
+	*			pBody			-- 请求体
+	*			iLength			-- 请求体长度
+	* 返回值：	TRUE			-- 成功
+	*			FALSE			-- 失败，可通过 SYS_GetLastError() 获取错误代码
+	*/
+	virtual BOOL SendStreamRequest(DWORD* lpdwStreamID, LPCSTR lpszMethod, LPCSTR lpszPath, const THeader lpHeaders[] = nullptr, int iHeaderCount = 0, const BYTE* pBody = nullptr, int iLength = 0)	= 0;
+
 	/*
 	* 名称：发送本地文件
 	* 描述：向指定连接发送 4096 KB 以下的小文件
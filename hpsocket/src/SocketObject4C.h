@@ -126,6 +126,13 @@ public:
 				: HR_IGNORE;
 	}
 
+	virtual EnHandleResult OnReceiveBatch(T* pSender, CONNID dwConnID, const WSABUF pBuffers[], int iCount)
+	{
+		return	(m_fnOnReceiveBatch)
+				? m_fnOnReceiveBatch(C_HP_Object::FromSecond<offset>(pSender), dwConnID, pBuffers, iCount)
+				: L::OnReceiveBatch(pSender, dwConnID, pBuffers, iCount);
+	}
+
 	virtual EnHandleResult OnClose(T* pSender, CONNID dwConnID, EnSocketOperation enOperation, int iErrorCode)
 	{
 		ASSERT(m_fnOnClose);
@@ -150,6 +157,7 @@ public:
 	, m_fnOnSend			(nullptr)
 	, m_fnOnReceive			(nullptr)
 	, m_fnOnPullReceive		(nullptr)
+	, m_fnOnReceiveBatch	(nullptr)
 	, m_fnOnClose			(nullptr)
 	, m_fnOnShutdown		(nullptr)
 	{
@@ -162,6 +170,7 @@ public:
 	HP_FN_Server_OnSend				m_fnOnSend			;
 	HP_FN_Server_OnReceive			m_fnOnReceive		;
 	HP_FN_Server_OnPullReceive		m_fnOnPullReceive	;
+	HP_FN_Server_OnReceiveBatch		m_fnOnReceiveBatch	;
 	HP_FN_Server_OnClose			m_fnOnClose			;
 	HP_FN_Server_OnShutdown			m_fnOnShutdown		;
 };
@@ -215,6 +224,13 @@ public:
 				: HR_IGNORE;
 	}
 
+	virtual EnHandleResult OnReceiveBatch(T* pSender, CONNID dwConnID, const WSABUF pBuffers[], int iCount)
+	{
+		return	(m_fnOnReceiveBatch)
+				? m_fnOnReceiveBatch(C_HP_Object::FromSecond<offset>(pSender), dwConnID, pBuffers, iCount)
+				: L::OnReceiveBatch(pSender, dwConnID, pBuffers, iCount);
+	}
+
 	virtual EnHandleResult OnClose(T* pSender, CONNID dwConnID, EnSocketOperation enOperation, int iErrorCode)
 	{
 		ASSERT(m_fnOnClose);
@@ -239,6 +255,7 @@ public:
 	, m_fnOnSend			(nullptr)
 	, m_fnOnReceive			(nullptr)
 	, m_fnOnPullReceive		(nullptr)
+	, m_fnOnReceiveBatch	(nullptr)
 	, m_fnOnClose			(nullptr)
 	, m_fnOnShutdown		(nullptr)
 	{
@@ -251,6 +268,7 @@ public:
 	HP_FN_Agent_OnSend				m_fnOnSend			;
 	HP_FN_Agent_OnReceive			m_fnOnReceive		;
 	HP_FN_Agent_OnPullReceive		m_fnOnPullReceive	;
+	HP_FN_Agent_OnReceiveBatch		m_fnOnReceiveBatch	;
 	HP_FN_Agent_OnClose				m_fnOnClose			;
 	HP_FN_Agent_OnShutdown			m_fnOnShutdown		;
 };
@@ -363,6 +381,13 @@ public:
 				: HR_IGNORE;
 	}
 
+	virtual EnHandleResult OnReceiveBatch(T* pSender, const TUdpDatagram pDatagrams[], int iCount)
+	{
+		return	(m_fnOnReceiveBatch)
+				? m_fnOnReceiveBatch(C_HP_Object::FromSecond<offset>(pSender), pDatagrams, iCount)
+				: L::OnReceiveBatch(pSender, pDatagrams, iCount);
+	}
+
 	virtual EnHandleResult OnError(T* pSender, EnSocketOperation enOperation, int iErrorCode, LPCTSTR lpszRemoteAddress, USHORT usRemotePort, const BYTE* pData, int iLength)
 	{
 		ASSERT(m_fnOnError);
@@ -384,6 +409,7 @@ public:
 	: m_fnOnPrepareListen	(nullptr)
 	, m_fnOnSend			(nullptr)
 	, m_fnOnReceive			(nullptr)
+	, m_fnOnReceiveBatch	(nullptr)
 	, m_fnOnError			(nullptr)
 	, m_fnOnShutdown		(nullptr)
 	{
@@ -393,6 +419,7 @@ public:
 	HP_FN_UdpNode_OnPrepareListen	m_fnOnPrepareListen	;
 	HP_FN_UdpNode_OnSend			m_fnOnSend			;
 	HP_FN_UdpNode_OnReceive			m_fnOnReceive		;
+	HP_FN_UdpNode_OnReceiveBatch	m_fnOnReceiveBatch	;
 	HP_FN_UdpNode_OnError			m_fnOnError			;
 	HP_FN_UdpNode_OnShutdown		m_fnOnShutdown		;
 };
@@ -57,14 +57,16 @@ BOOL CTcpAgent::CheckParams()
 {
 	if	((m_enSendPolicy >= SP_PACK && m_enSendPolicy <= SP_DIRECT)								&&
 		(m_enOnSendSyncPolicy >= OSSP_NONE && m_enOnSendSyncPolicy <= OSSP_RECEIVE)				&&
+		(m_enOnSendNotifyPolicy >= OSNP_EACH && m_enOnSendNotifyPolicy <= OSNP_NONE)			&&
 		((int)m_dwMaxConnectionCount > 0 && m_dwMaxConnectionCount <= MAX_CONNECTION_COUNT)		&&
 		((int)m_dwWorkerThreadCount > 0 && m_dwWorkerThreadCount <= MAX_WORKER_THREAD_COUNT)	&&
 		((int)m_dwSocketBufferSize >= MIN_SOCKET_BUFFER_SIZE)									&&
-		((int)m_dwFreeSocketObjLockTime >= 1000)												&&
 		((int)m_dwFreeSocketObjPool >= 0)														&&
 		((int)m_dwFreeBufferObjPool >= 0)														&&
 		((int)m_dwFreeSocketObjHold >= 0)														&&
 		((int)m_dwFreeBufferObjHold >= 0)														&&
+		((int)m_dwIoBytesBudget >= 0)															&&
+		((int)m_dwIoTimeBudget >= 0)															&&
 		((int)m_dwKeepAliveTime >= 1000 || m_dwKeepAliveTime == 0)								&&
 		((int)m_dwKeepAliveInterval >= 1000 || m_dwKeepAliveInterval == 0)						)
 		return TRUE;
@@ -83,6 +85,8 @@ void CTcpAgent::PrepareStart()
 	m_bfObjPool.SetPoolHold(m_dwFreeBufferObjHold);
 
 	m_bfObjPool.Prepare();
+
+	m_metrics.Reset();
 }
 
 BOOL CTcpAgent::CheckStarting()
@@ -369,13 +373,20 @@ int CTcpAgent::ConnectToServer(CONNID dwConnID, LPCTSTR lpszRemoteAddress, SOCKE
 
 			pSocketObj->SetConnected();
 
-			if(TRIGGER(FireConnect(pSocketObj)) == HR_ERROR)
+			m_metrics.Add(CIOMetrics::IMC_CONNECTS);
+
+			EnHandleResult rs;
+
+			{
+				CMetricsTimer timer(m_metrics);
+				rs = TRIGGER(FireConnect(pSocketObj));
+			}
+
+			if(rs == HR_ERROR)
 				result = ENSURE_ERROR_CANCELLED;
 			else
 			{
-                UINT evts = (pSocketObj->IsPending() ? EVFILT_WRITE : 0) | (pSocketObj->IsPaused() ? 0 : EVFILT_READ);
-
-                if(m_ioDispatcher.CtlFD(pSocketObj->socket, EV_ADD | EV_ONESHOT | EV_ENABLE ,evts, pSocketObj))
+                if(ArmSocketObj(pSocketObj))
 					result = NO_ERROR;
 			}
 		}
@@ -396,7 +407,7 @@ TAgentSocketObj* CTcpAgent::GetFreeSocketObj(CONNID dwConnID, SOCKET soClient)
 
 	if(m_lsFreeSocket.TryLock(&pSocketObj, dwIndex))
 	{
-		if(::GetTimeGap32(pSocketObj->freeTime) >= m_dwFreeSocketObjLockTime)
+		if(CEpochDomain::IsReclaimable(pSocketObj->freeEpoch))
 			VERIFY(m_lsFreeSocket.ReleaseLock(nullptr, dwIndex));
 		else
 		{
@@ -439,7 +450,7 @@ void CTcpAgent::AddFreeSocketObj(TAgentSocketObj* pSocketObj, EnSocketCloseFlag
 
 void CTcpAgent::ReleaseGCSocketObj(BOOL bForce)
 {
-	::ReleaseGCObj(m_lsGCSocket, m_dwFreeSocketObjLockTime, bForce);
+	::ReleaseGCObj(m_lsGCSocket, bForce);
 }
 
 BOOL CTcpAgent::InvalidSocketObj(TAgentSocketObj* pSocketObj)
@@ -475,10 +486,16 @@ void CTcpAgent::CloseClientSocketObj(TAgentSocketObj* pSocketObj, EnSocketCloseF
 {
 	ASSERT(TAgentSocketObj::IsExist(pSocketObj));
 
-	if(enFlag == SCF_CLOSE)
-		FireClose(pSocketObj, SO_CLOSE, SE_OK);
-	else if(enFlag == SCF_ERROR)
-		FireClose(pSocketObj, enOperation, iErrorCode);
+	{
+		CMetricsTimer timer(m_metrics);
+
+		if(enFlag == SCF_CLOSE)
+			FireClose(pSocketObj, SO_CLOSE, SE_OK);
+		else if(enFlag == SCF_ERROR)
+			FireClose(pSocketObj, enOperation, iErrorCode);
+	}
+
+	m_metrics.Add(CIOMetrics::IMC_CLOSES);
 
 	SOCKET socket = pSocketObj->socket;
 	pSocketObj->socket = INVALID_SOCKET;
@@ -488,6 +505,8 @@ void CTcpAgent::CloseClientSocketObj(TAgentSocketObj* pSocketObj, EnSocketCloseF
 
 BOOL CTcpAgent::GetLocalAddress(CONNID dwConnID, TCHAR lpszAddress[], int& iAddressLen, USHORT& usPort)
 {
+	CEpochLock epochlock;
+
 	ASSERT(lpszAddress != nullptr && iAddressLen > 0);
 
 	TAgentSocketObj* pSocketObj = FindSocketObj(dwConnID);
@@ -500,6 +519,8 @@ BOOL CTcpAgent::GetLocalAddress(CONNID dwConnID, TCHAR lpszAddress[], int& iAddr
 
 BOOL CTcpAgent::GetRemoteAddress(CONNID dwConnID, TCHAR lpszAddress[], int& iAddressLen, USHORT& usPort)
 {
+	CEpochLock epochlock;
+
 	ASSERT(lpszAddress != nullptr && iAddressLen > 0);
 
 	TAgentSocketObj* pSocketObj = FindSocketObj(dwConnID);
@@ -515,6 +536,8 @@ BOOL CTcpAgent::GetRemoteAddress(CONNID dwConnID, TCHAR lpszAddress[], int& iAdd
 
 BOOL CTcpAgent::GetRemoteHost(CONNID dwConnID, TCHAR lpszHost[], int& iHostLen, USHORT& usPort)
 {
+	CEpochLock epochlock;
+
 	ASSERT(lpszHost != nullptr && iHostLen > 0);
 
 	BOOL isOK				= FALSE;
@@ -540,6 +563,8 @@ BOOL CTcpAgent::GetRemoteHost(CONNID dwConnID, TCHAR lpszHost[], int& iHostLen,
 
 BOOL CTcpAgent::GetRemoteHost(CONNID dwConnID, LPCSTR* lpszHost, USHORT* pusPort)
 {
+	CEpochLock epochlock;
+
 	*lpszHost				= nullptr;
 	TAgentSocketObj* pSocketObj	= FindSocketObj(dwConnID);
 
@@ -556,6 +581,8 @@ BOOL CTcpAgent::GetRemoteHost(CONNID dwConnID, LPCSTR* lpszHost, USHORT* pusPort
 
 BOOL CTcpAgent::SetConnectionExtra(CONNID dwConnID, PVOID pExtra)
 {
+	CEpochLock epochlock;
+
 	TAgentSocketObj* pSocketObj = FindSocketObj(dwConnID);
 	return SetConnectionExtra(pSocketObj, pExtra);
 }
@@ -573,6 +600,8 @@ BOOL CTcpAgent::SetConnectionExtra(TAgentSocketObj* pSocketObj, PVOID pExtra)
 
 BOOL CTcpAgent::GetConnectionExtra(CONNID dwConnID, PVOID* ppExtra)
 {
+	CEpochLock epochlock;
+
 	TAgentSocketObj* pSocketObj = FindSocketObj(dwConnID);
 	return GetConnectionExtra(pSocketObj, ppExtra);
 }
@@ -592,6 +621,8 @@ BOOL CTcpAgent::GetConnectionExtra(TAgentSocketObj* pSocketObj, PVOID* ppExtra)
 
 BOOL CTcpAgent::SetConnectionReserved(CONNID dwConnID, PVOID pReserved)
 {
+	CEpochLock epochlock;
+
 	TAgentSocketObj* pSocketObj = FindSocketObj(dwConnID);
 	return SetConnectionReserved(pSocketObj, pReserved);
 }
@@ -609,6 +640,8 @@ BOOL CTcpAgent::SetConnectionReserved(TAgentSocketObj* pSocketObj, PVOID pReserv
 
 BOOL CTcpAgent::GetConnectionReserved(CONNID dwConnID, PVOID* ppReserved)
 {
+	CEpochLock epochlock;
+
 	TAgentSocketObj* pSocketObj = FindSocketObj(dwConnID);
 	return GetConnectionReserved(pSocketObj, ppReserved);
 }
@@ -628,6 +661,8 @@ BOOL CTcpAgent::GetConnectionReserved(TAgentSocketObj* pSocketObj, PVOID* ppRese
 
 BOOL CTcpAgent::SetConnectionReserved2(CONNID dwConnID, PVOID pReserved2)
 {
+	CEpochLock epochlock;
+
 	TAgentSocketObj* pSocketObj = FindSocketObj(dwConnID);
 	return SetConnectionReserved2(pSocketObj, pReserved2);
 }
@@ -645,6 +680,8 @@ BOOL CTcpAgent::SetConnectionReserved2(TAgentSocketObj* pSocketObj, PVOID pReser
 
 BOOL CTcpAgent::GetConnectionReserved2(CONNID dwConnID, PVOID* ppReserved2)
 {
+	CEpochLock epochlock;
+
 	TAgentSocketObj* pSocketObj = FindSocketObj(dwConnID);
 	return GetConnectionReserved2(pSocketObj, ppReserved2);
 }
@@ -664,6 +701,8 @@ BOOL CTcpAgent::GetConnectionReserved2(TAgentSocketObj* pSocketObj, PVOID* ppRes
 
 BOOL CTcpAgent::IsPauseReceive(CONNID dwConnID, BOOL& bPaused)
 {
+	CEpochLock epochlock;
+
 	TAgentSocketObj* pSocketObj = FindSocketObj(dwConnID);
 
 	if(TAgentSocketObj::IsValid(pSocketObj))
@@ -677,6 +716,8 @@ BOOL CTcpAgent::IsPauseReceive(CONNID dwConnID, BOOL& bPaused)
 
 BOOL CTcpAgent::IsConnected(CONNID dwConnID)
 {
+	CEpochLock epochlock;
+
 	TAgentSocketObj* pSocketObj = FindSocketObj(dwConnID);
 
 	if(TAgentSocketObj::IsValid(pSocketObj))
@@ -687,6 +728,8 @@ BOOL CTcpAgent::IsConnected(CONNID dwConnID)
 
 BOOL CTcpAgent::GetPendingDataLength(CONNID dwConnID, int& iPending)
 {
+	CEpochLock epochlock;
+
 	TAgentSocketObj* pSocketObj = FindSocketObj(dwConnID);
 
 	if(TAgentSocketObj::IsValid(pSocketObj))
@@ -703,6 +746,53 @@ DWORD CTcpAgent::GetConnectionCount()
 	return m_bfActiveSockets.Elements();
 }
 
+BOOL CTcpAgent::GetMetrics(TSocketMetrics& metrics)
+{
+	if(!HasStarted())
+	{
+		::SetLastError(ERROR_INVALID_STATE);
+		return FALSE;
+	}
+
+	::GetSocketMetrics(m_metrics, metrics, GetConnectionCount(), m_ioDispatcher.GetCommandQueueSize());
+	::AddHeapMetrics(metrics, m_phSocket);
+	::AddHeapMetrics(metrics, m_bfObjPool.GetPrivateHeap());
+
+	return TRUE;
+}
+
+BOOL CTcpAgent::GetMetricsText(LPSTR lpszBuffer, int& iLength, LPCSTR lpszPrefix)
+{
+	TSocketMetrics metrics;
+
+	if(!GetMetrics(metrics))
+		return FALSE;
+
+	return ::FormatMetricsText(metrics, lpszBuffer, iLength, lpszPrefix);
+}
+
+BOOL CTcpAgent::GetWorkerTraceStats(TWorkerTraceStat stats[], DWORD& dwCount)
+{
+	if(!HasStarted())
+	{
+		::SetLastError(ERROR_INVALID_STATE);
+		return FALSE;
+	}
+
+	return ::GetWorkerTraceStats(m_ioDispatcher.GetLoopTracer(), stats, dwCount);
+}
+
+BOOL CTcpAgent::GetSlowCallbacks(TSlowCallback records[], DWORD& dwCount)
+{
+	if(!HasStarted())
+	{
+		::SetLastError(ERROR_INVALID_STATE);
+		return FALSE;
+	}
+
+	return ::GetSlowCallbacks(m_ioDispatcher.GetLoopTracer(), records, dwCount);
+}
+
 BOOL CTcpAgent::GetAllConnectionIDs(CONNID pIDs[], DWORD& dwCount)
 {
 	return m_bfActiveSockets.GetAllElementIndexes(pIDs, dwCount);
@@ -710,6 +800,8 @@ BOOL CTcpAgent::GetAllConnectionIDs(CONNID pIDs[], DWORD& dwCount)
 
 BOOL CTcpAgent::GetConnectPeriod(CONNID dwConnID, DWORD& dwPeriod)
 {
+	CEpochLock epochlock;
+
 	BOOL isOK					= TRUE;
 	TAgentSocketObj* pSocketObj	= FindSocketObj(dwConnID);
 
@@ -723,6 +815,8 @@ BOOL CTcpAgent::GetConnectPeriod(CONNID dwConnID, DWORD& dwPeriod)
 
 BOOL CTcpAgent::GetSilencePeriod(CONNID dwConnID, DWORD& dwPeriod)
 {
+	CEpochLock epochlock;
+
 	if(!m_bMarkSilence)
 		return FALSE;
 
@@ -739,6 +833,8 @@ BOOL CTcpAgent::GetSilencePeriod(CONNID dwConnID, DWORD& dwPeriod)
 
 BOOL CTcpAgent::Disconnect(CONNID dwConnID, BOOL bForce)
 {
+	CEpochLock epochlock;
+
 	TAgentSocketObj* pSocketObj = FindSocketObj(dwConnID);
 
 	if(!TAgentSocketObj::IsValid(pSocketObj))
@@ -752,6 +848,8 @@ BOOL CTcpAgent::Disconnect(CONNID dwConnID, BOOL bForce)
 
 BOOL CTcpAgent::DisconnectLongConnections(DWORD dwPeriod, BOOL bForce)
 {
+	CEpochLock epochlock;
+
 	if(dwPeriod > MAX_CONNECTION_PERIOD)
 		return FALSE;
 
@@ -773,6 +871,8 @@ BOOL CTcpAgent::DisconnectLongConnections(DWORD dwPeriod, BOOL bForce)
 
 BOOL CTcpAgent::DisconnectSilenceConnections(DWORD dwPeriod, BOOL bForce)
 {
+	CEpochLock epochlock;
+
 	if(!m_bMarkSilence)
 		return FALSE;
 	if(dwPeriod > MAX_CONNECTION_PERIOD)
@@ -796,6 +896,8 @@ BOOL CTcpAgent::DisconnectSilenceConnections(DWORD dwPeriod, BOOL bForce)
 
 BOOL CTcpAgent::PauseReceive(CONNID dwConnID, BOOL bPause)
 {
+	CEpochLock epochlock;
+
 	TAgentSocketObj* pSocketObj = FindSocketObj(dwConnID);
 
 	if(!TAgentSocketObj::IsValid(pSocketObj))
@@ -858,13 +960,37 @@ VOID CTcpAgent::OnAfterProcessIo(PVOID pv, UINT events, BOOL rs)
 	{
         ASSERT(rs && !(events == EVFILT_EXCEPT));
 
-        UINT evts = (pSocketObj->IsPending() ? EVFILT_WRITE : 0) | (pSocketObj->IsPaused() ? 0 : EVFILT_READ);
-        m_ioDispatcher.CtlFD(pSocketObj->socket, EV_ADD | EV_ENABLE | EV_ONESHOT, evts, pSocketObj);
+		UINT uDeferred = pSocketObj->budget.TakeDeferred();
+
+		//因读写预算用尽而未处理完的连接放入工作线程就绪队列，本批事件之后重新处理，不必重新注册事件
+		if(uDeferred == 0 || !m_ioDispatcher.DeferIo(pSocketObj, uDeferred))
+			ArmSocketObj(pSocketObj);
 	}
 
 	pSocketObj->csIo.unlock();
 }
 
+BOOL CTcpAgent::ArmSocketObj(TAgentSocketObj* pSocketObj)
+{
+	if(!m_bEdgeTrigger)
+	{
+        UINT evts = (pSocketObj->IsPending() ? EVFILT_WRITE : 0) | (pSocketObj->IsPaused() ? 0 : EVFILT_READ);
+        return m_ioDispatcher.CtlFD(pSocketObj->socket, EV_ADD | EV_ENABLE | EV_ONESHOT, evts, pSocketObj);
+	}
+
+	BOOL isOK = TRUE;
+
+	//边缘触发模式：读事件以 EV_CLEAR | EV_DISPATCH 注册，每次投递后自动禁用，处理完成后重新启用，
+	//保证共享 kqueue 的多个工作线程不会同时收到同一连接的读事件；暂停接收时不重新启用读事件；
+	//写事件只在有待发数据时单次注册
+	if(!pSocketObj->IsPaused())
+		isOK = m_ioDispatcher.CtlFD(pSocketObj->socket, EV_ADD | EV_ENABLE | EV_CLEAR | EV_DISPATCH, EVFILT_READ, pSocketObj);
+	if(isOK && pSocketObj->IsPending())
+		isOK = m_ioDispatcher.CtlFD(pSocketObj->socket, EV_ADD | EV_ENABLE | EV_ONESHOT, EVFILT_WRITE, pSocketObj);
+
+	return isOK;
+}
+
 VOID CTcpAgent::OnCommand(TDispCommand* pCmd)
 {
 	switch(pCmd->type)
@@ -939,6 +1065,11 @@ VOID CTcpAgent::OnDispatchThreadEnd(THR_ID tid)
 	OnWorkerThreadEnd(tid);
 }
 
+UINT_PTR CTcpAgent::GetTraceID(PVOID pv, UINT events)
+{
+	return ((TAgentSocketObj*)pv)->connID;
+}
+
 BOOL CTcpAgent::HandleClose(TAgentSocketObj* pSocketObj, EnSocketCloseFlag enFlag, UINT events)
 {
 	EnSocketOperation enOperation = SO_CLOSE;
@@ -980,14 +1111,22 @@ BOOL CTcpAgent::HandleConnect(TAgentSocketObj* pSocketObj, UINT events)
 
 	pSocketObj->SetConnected();
 
-	if(TRIGGER(FireConnect(pSocketObj)) == HR_ERROR)
+	m_metrics.Add(CIOMetrics::IMC_CONNECTS);
+
+	EnHandleResult rs;
+
+	{
+		CMetricsTimer timer(m_metrics);
+		rs = TRIGGER(FireConnect(pSocketObj));
+	}
+
+	if(rs == HR_ERROR)
 	{
 		AddFreeSocketObj(pSocketObj, SCF_NONE);
 		return FALSE;
 	}
 
-    UINT evts = (pSocketObj->IsPending() ? EVFILT_WRITE : 0) | (pSocketObj->IsPaused() ? 0 : EVFILT_READ);
-    m_ioDispatcher.CtlFD(pSocketObj->socket, EV_ADD | EV_ENABLE | EV_ONESHOT , evts, pSocketObj);
+    ArmSocketObj(pSocketObj);
 
 	return TRUE;
 }
@@ -998,26 +1137,47 @@ BOOL CTcpAgent::HandleReceive(TAgentSocketObj* pSocketObj, int flag)
 
 	if(m_bMarkSilence) pSocketObj->activeTime = ::TimeGetTime();
 
+	if(m_bBatchReceive)
+		return HandleReceiveBatch(pSocketObj, flag);
+
 	CBufferPtr& buffer = *(m_rcBufferMap[SELF_THREAD_ID]);
 
-	int reads = flag ? -1 : MAX_CONTINUE_READS;
+	TIoBudget& budget = pSocketObj->budget;
+	TIoPass pass(flag ? -1 : budget.GetReads(m_dwIoBytesBudget), m_dwIoBytesBudget, m_dwIoTimeBudget);
 
-	for(int i = 0; i < reads || reads < 0; i++)
+	while(TRUE)
 	{
 		if(pSocketObj->paused)
 			break;
 
 		int rc = (int)read(pSocketObj->socket, buffer.Ptr(), buffer.Size());
 
+		m_metrics.OnRecv(rc);
+
 		if(rc > 0)
 		{
-			if(TRIGGER(FireReceive(pSocketObj, buffer.Ptr(), rc)) == HR_ERROR)
+			budget.OnRead(rc);
+
+			EnHandleResult rs;
+
+			{
+				CMetricsTimer timer(m_metrics);
+				rs = TRIGGER(FireReceive(pSocketObj, buffer.Ptr(), rc));
+			}
+
+			if(rs == HR_ERROR)
 			{
 				TRACE("<C-CNNID: %zu> OnReceive() event return 'HR_ERROR', connection will be closed !", pSocketObj->connID);
 
 				AddFreeSocketObj(pSocketObj, SCF_ERROR, SO_RECEIVE, ENSURE_ERROR_CANCELLED);
 				return FALSE;
 			}
+
+			if(pass.Consume(rc))
+			{
+				budget.Defer(DISP_EVENT_FLAG_R);
+				break;
+			}
 		}
 		else if(rc == 0)
 		{
@@ -1041,6 +1201,128 @@ BOOL CTcpAgent::HandleReceive(TAgentSocketObj* pSocketObj, int flag)
 	return TRUE;
 }
 
+BOOL CTcpAgent::HandleReceiveBatch(TAgentSocketObj* pSocketObj, int flag)
+{
+	CBufferPtr& buffer = *(m_rcBufferMap[SELF_THREAD_ID]);
+
+	WSABUF buffers[MAX_CONTINUE_READS];
+
+	int iCount		= 0;
+	int iOffset		= 0;
+	int iSize		= (int)buffer.Size();
+
+	TIoBudget& budget = pSocketObj->budget;
+	TIoPass pass(flag ? -1 : budget.GetReads(m_dwIoBytesBudget), m_dwIoBytesBudget, m_dwIoTimeBudget);
+
+	while(TRUE)
+	{
+		if(pSocketObj->paused)
+			break;
+
+		int rc = (int)read(pSocketObj->socket, buffer.Ptr() + iOffset, iSize - iOffset);
+
+		m_metrics.OnRecv(rc);
+
+		if(rc > 0)
+		{
+			budget.OnRead(rc);
+
+			buffers[iCount].buf = buffer.Ptr() + iOffset;
+			buffers[iCount].len = rc;
+
+			++iCount;
+			iOffset += rc;
+
+			/* 缓冲区数组已满或剩余空间不足 1/4 时先交付已读取的数据，避免后续 read() 读取过少 */
+			if(iCount == MAX_CONTINUE_READS || iSize - iOffset < iSize / 4)
+			{
+				if(!NotifyReceive(pSocketObj, buffers, iCount))
+					return FALSE;
+
+				iCount	= 0;
+				iOffset	= 0;
+			}
+
+			if(pass.Consume(rc))
+			{
+				budget.Defer(DISP_EVENT_FLAG_R);
+				break;
+			}
+		}
+		else if(rc == 0)
+		{
+			if(iCount > 0 && !NotifyReceive(pSocketObj, buffers, iCount))
+				return FALSE;
+
+			AddFreeSocketObj(pSocketObj, SCF_CLOSE, SO_RECEIVE, SE_OK);
+			return FALSE;
+		}
+		else
+		{
+			ASSERT(rc == SOCKET_ERROR);
+
+			int code = ::WSAGetLastError();
+
+			if(code == ERROR_WOULDBLOCK)
+				break;
+
+			if(iCount > 0 && !NotifyReceive(pSocketObj, buffers, iCount))
+				return FALSE;
+
+			AddFreeSocketObj(pSocketObj, SCF_ERROR, SO_RECEIVE, code);
+			return FALSE;
+		}
+	}
+
+	return (iCount == 0 || NotifyReceive(pSocketObj, buffers, iCount));
+}
+
+BOOL CTcpAgent::NotifyReceive(TAgentSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount)
+{
+	EnHandleResult rs;
+
+	{
+		CMetricsTimer timer(m_metrics);
+		rs = TRIGGER(FireReceive(pSocketObj, pBuffers, iCount));
+	}
+
+	if(rs == HR_ERROR)
+	{
+		TRACE("<C-CNNID: %zu> OnReceiveBatch() event return 'HR_ERROR', connection will be closed !", pSocketObj->connID);
+
+		AddFreeSocketObj(pSocketObj, SCF_ERROR, SO_RECEIVE, ENSURE_ERROR_CANCELLED);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+EnHandleResult CTcpAgent::FireReceiveEach(TAgentSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount)
+{
+	for(int i = 0; i < iCount; i++)
+	{
+		EnHandleResult rs = FireReceive(pSocketObj, pBuffers[i].buf, (int)pBuffers[i].len);
+
+		if(rs == HR_ERROR)
+			return rs;
+	}
+
+	return HR_OK;
+}
+
+EnHandleResult CTcpAgent::DoFireReceiveEach(TAgentSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount)
+{
+	for(int i = 0; i < iCount; i++)
+	{
+		EnHandleResult rs = DoFireReceive(pSocketObj, pBuffers[i].buf, (int)pBuffers[i].len);
+
+		if(rs == HR_ERROR)
+			return rs;
+	}
+
+	return HR_OK;
+}
+
 BOOL CTcpAgent::HandleSend(TAgentSocketObj* pSocketObj, int flag)
 {
 	ASSERT(TAgentSocketObj::IsValid(pSocketObj));
@@ -1049,12 +1331,15 @@ BOOL CTcpAgent::HandleSend(TAgentSocketObj* pSocketObj, int flag)
 		return TRUE;
 
 	BOOL bBlocked	= FALSE;
-	int writes		= flag ? -1 : MAX_CONTINUE_WRITES;
+	int iSent		= 0;
+
+	TIoBudget& budget = pSocketObj->budget;
+	TIoPass pass(flag ? -1 : budget.GetWrites(m_dwIoBytesBudget), m_dwIoBytesBudget, m_dwIoTimeBudget);
 
 	TBufferObjList& sndBuff = pSocketObj->sndBuff;
 	TItemPtr itPtr(sndBuff);
 
-	for(int i = 0; i < writes || writes < 0; i++)
+	while(TRUE)
 	{
 		{
 			CReentrantCriSecLock locallock(pSocketObj->csSend);
@@ -1066,7 +1351,9 @@ BOOL CTcpAgent::HandleSend(TAgentSocketObj* pSocketObj, int flag)
 
 		ASSERT(!itPtr->IsEmpty());
 
-		if(!SendItem(pSocketObj, itPtr, bBlocked))
+		int iSize = itPtr->Size();
+
+		if(!SendItem(pSocketObj, itPtr, bBlocked, iSent))
 			return FALSE;
 
 		if(bBlocked)
@@ -1078,24 +1365,38 @@ BOOL CTcpAgent::HandleSend(TAgentSocketObj* pSocketObj, int flag)
 
 			break;
 		}
+
+		budget.OnWrite(iSize);
+
+		if(pass.Consume(iSize))
+		{
+			if(pSocketObj->IsPending())
+				budget.Defer(DISP_EVENT_FLAG_W);
+
+			break;
+		}
 	}
 
+	if(iSent > 0)
+		NotifySend(pSocketObj, nullptr, iSent);
+
 	return TRUE;
 }
 
-BOOL CTcpAgent::SendItem(TAgentSocketObj* pSocketObj, TItem* pItem, BOOL& bBlocked)
+BOOL CTcpAgent::SendItem(TAgentSocketObj* pSocketObj, TItem* pItem, BOOL& bBlocked, int& iSent)
 {
 	while(!pItem->IsEmpty())
 	{
 		int rc = (int)write(pSocketObj->socket, pItem->Ptr(), pItem->Size());
 
+		m_metrics.OnSend(rc);
+
 		if(rc > 0)
 		{
-			if(TRIGGER(FireSend(pSocketObj, pItem->Ptr(), rc)) == HR_ERROR)
-			{
-				TRACE("<C-CNNID: %zu> OnSend() event should not return 'HR_ERROR' !!", pSocketObj->connID);
-				ASSERT(FALSE);
-			}
+			if(m_enOnSendNotifyPolicy == OSNP_EACH)
+				NotifySend(pSocketObj, pItem->Ptr(), rc);
+			else if(m_enOnSendNotifyPolicy == OSNP_BATCH)
+				iSent += rc;
 
 			pItem->Reduce(rc);
 		}
@@ -1121,6 +1422,22 @@ BOOL CTcpAgent::SendItem(TAgentSocketObj* pSocketObj, TItem* pItem, BOOL& bBlock
 	return TRUE;
 }
 
+void CTcpAgent::NotifySend(TAgentSocketObj* pSocketObj, const BYTE* pData, int iLength)
+{
+	EnHandleResult rs;
+
+	{
+		CMetricsTimer timer(m_metrics);
+		rs = TRIGGER(FireSend(pSocketObj, pData, iLength));
+	}
+
+	if(rs == HR_ERROR)
+	{
+		TRACE("<C-CNNID: %zu> OnSend() event should not return 'HR_ERROR' !!", pSocketObj->connID);
+		ASSERT(FALSE);
+	}
+}
+
 BOOL CTcpAgent::Send(CONNID dwConnID, const BYTE* pBuffer, int iLength, int iOffset)
 {
 	ASSERT(pBuffer && iLength > 0);
@@ -1136,6 +1453,8 @@ BOOL CTcpAgent::Send(CONNID dwConnID, const BYTE* pBuffer, int iLength, int iOff
 
 BOOL CTcpAgent::DoSendPackets(CONNID dwConnID, const WSABUF pBuffers[], int iCount)
 {
+	CEpochLock epochlock;
+
 	ASSERT(pBuffers && iCount > 0);
 
 	TAgentSocketObj* pSocketObj = FindSocketObj(dwConnID);
@@ -1196,6 +1515,8 @@ int CTcpAgent::SendInternal(TAgentSocketObj* pSocketObj, const WSABUF pBuffers[]
 		}
 	}
 
+	m_metrics.OnSendRequest(pSocketObj->Pending());
+
 	if(iPending == 0 && pSocketObj->IsPending())
 	{
 		if(!m_ioDispatcher.SendCommand(DISP_CMD_SEND, pSocketObj->connID))
@@ -67,6 +67,8 @@ public:
 	virtual BOOL IsSSLAutoHandShake	()						{return FALSE;}
 	virtual void SetSSLCipherList	(LPCTSTR lpszCipherList){}
 	virtual LPCTSTR GetSSLCipherList()						{return nullptr;}
+	virtual void SetSSLAlpnProtocols(LPCTSTR lpszProtocols)	{}
+	virtual LPCTSTR GetSSLAlpnProtocols()					{return nullptr;}
 	virtual BOOL GetSSLSessionInfo(CONNID dwConnID, EnSSLSessionInfo enInfo, LPVOID* lppInfo)	{return FALSE;}
 
 protected:
@@ -83,6 +85,7 @@ private:
 	virtual BOOL OnError(PVOID pv, UINT events)						override;
 	virtual VOID OnDispatchThreadStart(THR_ID tid)					override;
 	virtual VOID OnDispatchThreadEnd(THR_ID tid)					override;
+	virtual UINT_PTR GetTraceID(PVOID pv, UINT events)				override;
 
 
 public:
@@ -94,10 +97,10 @@ public:
 	virtual void SetReuseAddressPolicy		(EnReuseAddressPolicy enReusePolicy)	{ENSURE_HAS_STOPPED(); m_enReusePolicy		= enReusePolicy;}
 	virtual void SetSendPolicy				(EnSendPolicy enSendPolicy)				{ENSURE_HAS_STOPPED(); m_enSendPolicy		= enSendPolicy;}
 	virtual void SetOnSendSyncPolicy		(EnOnSendSyncPolicy enOnSendSyncPolicy)	{ENSURE_HAS_STOPPED(); m_enOnSendSyncPolicy	= enOnSendSyncPolicy;}
+	virtual void SetOnSendNotifyPolicy		(EnOnSendNotifyPolicy enOnSendNotifyPolicy)	{ENSURE_HAS_STOPPED(); m_enOnSendNotifyPolicy	= enOnSendNotifyPolicy;}
 	virtual void SetMaxConnectionCount		(DWORD dwMaxConnectionCount)	{ENSURE_HAS_STOPPED(); m_dwMaxConnectionCount		= dwMaxConnectionCount;}
 	virtual void SetWorkerThreadCount		(DWORD dwWorkerThreadCount)		{ENSURE_HAS_STOPPED(); m_dwWorkerThreadCount		= dwWorkerThreadCount;}
 	virtual void SetSocketBufferSize		(DWORD dwSocketBufferSize)		{ENSURE_HAS_STOPPED(); m_dwSocketBufferSize			= dwSocketBufferSize;}
-	virtual void SetFreeSocketObjLockTime	(DWORD dwFreeSocketObjLockTime)	{ENSURE_HAS_STOPPED(); m_dwFreeSocketObjLockTime	= dwFreeSocketObjLockTime;}
 	virtual void SetFreeSocketObjPool		(DWORD dwFreeSocketObjPool)		{ENSURE_HAS_STOPPED(); m_dwFreeSocketObjPool		= dwFreeSocketObjPool;}
 	virtual void SetFreeBufferObjPool		(DWORD dwFreeBufferObjPool)		{ENSURE_HAS_STOPPED(); m_dwFreeBufferObjPool		= dwFreeBufferObjPool;}
 	virtual void SetFreeSocketObjHold		(DWORD dwFreeSocketObjHold)		{ENSURE_HAS_STOPPED(); m_dwFreeSocketObjHold		= dwFreeSocketObjHold;}
@@ -105,14 +108,18 @@ public:
 	virtual void SetKeepAliveTime			(DWORD dwKeepAliveTime)			{ENSURE_HAS_STOPPED(); m_dwKeepAliveTime			= dwKeepAliveTime;}
 	virtual void SetKeepAliveInterval		(DWORD dwKeepAliveInterval)		{ENSURE_HAS_STOPPED(); m_dwKeepAliveInterval		= dwKeepAliveInterval;}
 	virtual void SetMarkSilence				(BOOL bMarkSilence)				{ENSURE_HAS_STOPPED(); m_bMarkSilence				= bMarkSilence;}
+	virtual void SetBatchReceive			(BOOL bBatchReceive)			{ENSURE_HAS_STOPPED(); m_bBatchReceive				= bBatchReceive;}
+	virtual void SetEdgeTrigger				(BOOL bEdgeTrigger)				{ENSURE_HAS_STOPPED(); m_bEdgeTrigger				= bEdgeTrigger;}
+	virtual void SetIoBytesBudget			(DWORD dwIoBytesBudget)			{ENSURE_HAS_STOPPED(); m_dwIoBytesBudget			= dwIoBytesBudget;}
+	virtual void SetIoTimeBudget			(DWORD dwIoTimeBudget)			{ENSURE_HAS_STOPPED(); m_dwIoTimeBudget				= dwIoTimeBudget;}
 
 	virtual EnReuseAddressPolicy GetReuseAddressPolicy	()	{return m_enReusePolicy;}
 	virtual EnSendPolicy GetSendPolicy					()	{return m_enSendPolicy;}
 	virtual EnOnSendSyncPolicy GetOnSendSyncPolicy		()	{return m_enOnSendSyncPolicy;}
+	virtual EnOnSendNotifyPolicy GetOnSendNotifyPolicy	()	{return m_enOnSendNotifyPolicy;}
 	virtual DWORD GetMaxConnectionCount		()	{return m_dwMaxConnectionCount;}
 	virtual DWORD GetWorkerThreadCount		()	{return m_dwWorkerThreadCount;}
 	virtual DWORD GetSocketBufferSize		()	{return m_dwSocketBufferSize;}
-	virtual DWORD GetFreeSocketObjLockTime	()	{return m_dwFreeSocketObjLockTime;}
 	virtual DWORD GetFreeSocketObjPool		()	{return m_dwFreeSocketObjPool;}
 	virtual DWORD GetFreeBufferObjPool		()	{return m_dwFreeBufferObjPool;}
 	virtual DWORD GetFreeSocketObjHold		()	{return m_dwFreeSocketObjHold;}
@@ -120,6 +127,20 @@ public:
 	virtual DWORD GetKeepAliveTime			()	{return m_dwKeepAliveTime;}
 	virtual DWORD GetKeepAliveInterval		()	{return m_dwKeepAliveInterval;}
 	virtual BOOL  IsMarkSilence				()	{return m_bMarkSilence;}
+	virtual BOOL  IsBatchReceive			()	{return m_bBatchReceive;}
+	virtual BOOL  IsEdgeTrigger				()	{return m_bEdgeTrigger;}
+	virtual DWORD GetIoBytesBudget			()	{return m_dwIoBytesBudget;}
+	virtual DWORD GetIoTimeBudget			()	{return m_dwIoTimeBudget;}
+
+	virtual void SetCollectMetrics	(BOOL bCollectMetrics)	{m_metrics.SetEnabled(bCollectMetrics);}
+	virtual BOOL IsCollectMetrics	()						{return m_metrics.IsEnabled();}
+	virtual BOOL GetMetrics			(TSocketMetrics& metrics);
+	virtual BOOL GetMetricsText		(LPSTR lpszBuffer, int& iLength, LPCSTR lpszPrefix = nullptr);
+
+	virtual void SetSlowCallbackThreshold	(DWORD dwSlowCallbackThreshold)	{m_ioDispatcher.GetLoopTracer().SetSlowThreshold(dwSlowCallbackThreshold * 1000ull);}
+	virtual DWORD GetSlowCallbackThreshold	()								{return (DWORD)(m_ioDispatcher.GetLoopTracer().GetSlowThreshold() / 1000);}
+	virtual BOOL GetWorkerTraceStats		(TWorkerTraceStat stats[], DWORD& dwCount);
+	virtual BOOL GetSlowCallbacks			(TSlowCallback records[], DWORD& dwCount);
 
 protected:
 	virtual EnHandleResult FirePrepareConnect(CONNID dwConnID, SOCKET socket)
@@ -136,6 +157,8 @@ protected:
 		{return DoFireReceive(pSocketObj, pData, iLength);}
 	virtual EnHandleResult FireReceive(TAgentSocketObj* pSocketObj, int iLength)
 		{return DoFireReceive(pSocketObj, iLength);}
+	virtual EnHandleResult FireReceive(TAgentSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount)
+		{return DoFireReceive(pSocketObj, pBuffers, iCount);}
 	virtual EnHandleResult FireSend(TAgentSocketObj* pSocketObj, const BYTE* pData, int iLength)
 		{return DoFireSend(pSocketObj, pData, iLength);}
 	virtual EnHandleResult FireClose(TAgentSocketObj* pSocketObj, EnSocketOperation enOperation, int iErrorCode)
@@ -153,6 +176,8 @@ protected:
 		{return m_pListener->OnReceive(this, pSocketObj->connID, pData, iLength);}
 	virtual EnHandleResult DoFireReceive(TAgentSocketObj* pSocketObj, int iLength)
 		{return m_pListener->OnReceive(this, pSocketObj->connID, iLength);}
+	virtual EnHandleResult DoFireReceive(TAgentSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount)
+		{return m_pListener->OnReceiveBatch(this, pSocketObj->connID, pBuffers, iCount);}
 	virtual EnHandleResult DoFireSend(TAgentSocketObj* pSocketObj, const BYTE* pData, int iLength)
 		{return m_pListener->OnSend(this, pSocketObj->connID, pData, iLength);}
 	virtual EnHandleResult DoFireClose(TAgentSocketObj* pSocketObj, EnSocketOperation enOperation, int iErrorCode)
@@ -160,6 +185,10 @@ protected:
 	virtual EnHandleResult DoFireShutdown()
 		{return m_pListener->OnShutdown(this);}
 
+	/* 把批量数据到达事件拆分为逐个缓冲区的数据到达事件（供需要加工接收数据的派生组件使用） */
+	EnHandleResult FireReceiveEach(TAgentSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount);
+	EnHandleResult DoFireReceiveEach(TAgentSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount);
+
 	void SetLastError(EnSocketError code, LPCSTR func, int ec);
 	virtual BOOL CheckParams();
 	virtual void PrepareStart();
@@ -218,11 +247,15 @@ private:
 	VOID HandleCmdDisconnect(CONNID dwConnID, BOOL bForce);
 	BOOL HandleConnect		(TAgentSocketObj* pSocketObj, UINT events);
 	BOOL HandleReceive		(TAgentSocketObj* pSocketObj, int flag);
+	BOOL HandleReceiveBatch	(TAgentSocketObj* pSocketObj, int flag);
+	BOOL NotifyReceive		(TAgentSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount);
 	BOOL HandleSend			(TAgentSocketObj* pSocketObj, int flag);
 	BOOL HandleClose		(TAgentSocketObj* pSocketObj, EnSocketCloseFlag enFlag, UINT events);
+	BOOL ArmSocketObj		(TAgentSocketObj* pSocketObj);
 
 	int SendInternal	(TAgentSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount);
-	BOOL SendItem		(TAgentSocketObj* pSocketObj, TItem* pItem, BOOL& bBlocked);
+	BOOL SendItem		(TAgentSocketObj* pSocketObj, TItem* pItem, BOOL& bBlocked, int& iSent);
+	void NotifySend		(TAgentSocketObj* pSocketObj, const BYTE* pData, int iLength);
 
 public:
 	CTcpAgent(ITcpAgentListener* pListener)
@@ -233,10 +266,10 @@ public:
 	, m_enReusePolicy			(RAP_ADDR_ONLY)
 	, m_enSendPolicy			(SP_PACK)
 	, m_enOnSendSyncPolicy		(OSSP_NONE)
+	, m_enOnSendNotifyPolicy	(OSNP_EACH)
 	, m_dwMaxConnectionCount	(DEFAULT_CONNECTION_COUNT)
 	, m_dwWorkerThreadCount		(DEFAULT_WORKER_THREAD_COUNT)
 	, m_dwSocketBufferSize		(DEFAULT_TCP_SOCKET_BUFFER_SIZE)
-	, m_dwFreeSocketObjLockTime	(DEFAULT_FREE_SOCKETOBJ_LOCK_TIME)
 	, m_dwFreeSocketObjPool		(DEFAULT_FREE_SOCKETOBJ_POOL)
 	, m_dwFreeBufferObjPool		(DEFAULT_FREE_BUFFEROBJ_POOL)
 	, m_dwFreeSocketObjHold		(DEFAULT_FREE_SOCKETOBJ_HOLD)
@@ -244,9 +277,15 @@ public:
 	, m_dwKeepAliveTime			(DEFALUT_TCP_KEEPALIVE_TIME)
 	, m_dwKeepAliveInterval		(DEFALUT_TCP_KEEPALIVE_INTERVAL)
 	, m_bMarkSilence			(TRUE)
+	, m_bBatchReceive			(FALSE)
+	, m_bEdgeTrigger			(FALSE)
+	, m_dwIoBytesBudget			(DEFAULT_IO_BYTES_BUDGET)
+	, m_dwIoTimeBudget			(DEFAULT_IO_TIME_BUDGET)
 	, m_soAddr					(AF_UNSPEC, TRUE)
 	{
 		ASSERT(m_pListener);
+
+		m_ioDispatcher.SetMetrics(&m_metrics);
 	}
 
 	virtual ~CTcpAgent()
@@ -258,10 +297,10 @@ private:
 	EnReuseAddressPolicy m_enReusePolicy;
 	EnSendPolicy m_enSendPolicy;
 	EnOnSendSyncPolicy m_enOnSendSyncPolicy;
+	EnOnSendNotifyPolicy m_enOnSendNotifyPolicy;
 	DWORD m_dwMaxConnectionCount;
 	DWORD m_dwWorkerThreadCount;
 	DWORD m_dwSocketBufferSize;
-	DWORD m_dwFreeSocketObjLockTime;
 	DWORD m_dwFreeSocketObjPool;
 	DWORD m_dwFreeBufferObjPool;
 	DWORD m_dwFreeSocketObjHold;
@@ -269,6 +308,10 @@ private:
 	DWORD m_dwKeepAliveTime;
 	DWORD m_dwKeepAliveInterval;
 	BOOL  m_bMarkSilence;
+	BOOL  m_bBatchReceive;
+	BOOL  m_bEdgeTrigger;
+	DWORD m_dwIoBytesBudget;
+	DWORD m_dwIoTimeBudget;
 
 private:
 	CSEM					m_evWait;
@@ -290,5 +333,6 @@ private:
 	TAgentSocketObjPtrQueue	m_lsGCSocket;
 	TReceiveBufferMap		m_rcBufferMap;
 
+	CIOMetrics				m_metrics;
 	CIODispatcher			m_ioDispatcher;
 };
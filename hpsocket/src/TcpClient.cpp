@@ -91,6 +91,8 @@ void CTcpClient::PrepareStart()
 	m_itPool.SetPoolHold(m_dwFreeBufferPoolHold);
 
 	m_itPool.Prepare();
+
+	m_metrics.Reset();
 }
 
 BOOL CTcpClient::CheckStarting()
@@ -203,7 +205,16 @@ BOOL CTcpClient::ConnectToServer(const HP_SOCKADDR& addrRemote, BOOL bAsyncConne
 
 			SetConnected();
 
-			if(TRIGGER(FireConnect()) == HR_ERROR)
+			m_metrics.Add(CIOMetrics::IMC_CONNECTS);
+
+			EnHandleResult rs;
+
+			{
+				CMetricsTimer timer(m_metrics);
+				rs = TRIGGER(FireConnect());
+			}
+
+			if(rs == HR_ERROR)
 				::WSASetLastError(ENSURE_ERROR_CANCELLED);
 			else
 			{
@@ -226,7 +237,14 @@ BOOL CTcpClient::Stop()
 	SetConnected(FALSE);
 
 	if(m_ccContext.bFireOnClose)
-		FireClose(m_ccContext.enOperation, m_ccContext.iErrorCode);
+	{
+		{
+			CMetricsTimer timer(m_metrics);
+			FireClose(m_ccContext.enOperation, m_ccContext.iErrorCode);
+		}
+
+		m_metrics.Add(CIOMetrics::IMC_CLOSES);
+	}
 
 	if(m_soClient != INVALID_SOCKET)
 	{
@@ -308,6 +326,11 @@ UINT WINAPI CTcpClient::WorkerThreadProc(LPVOID pv)
 			goto EXIT_WORKER_THREAD;
 		}
 
+		CMetricsTimer looptimer(m_metrics, CIOMetrics::IMH_LOOP);
+
+		m_metrics.Add(CIOMetrics::IMC_LOOPS);
+		m_metrics.Add(CIOMetrics::IMC_IO_EVENTS, __builtin_popcount(rs));
+
 		for(int i = 0; i < size; i++)
 		{
 			if((1 << i) & rs)
@@ -408,7 +431,16 @@ BOOL CTcpClient::HandleConnect(SHORT events)
 
 	SetConnected();
 
-	if(TRIGGER(FireConnect()) == HR_ERROR)
+	m_metrics.Add(CIOMetrics::IMC_CONNECTS);
+
+	EnHandleResult rs;
+
+	{
+		CMetricsTimer timer(m_metrics);
+		rs = TRIGGER(FireConnect());
+	}
+
+	if(rs == HR_ERROR)
 	{
 		m_ccContext.Reset(FALSE);
 		return FALSE;
@@ -452,9 +484,18 @@ BOOL CTcpClient::ReadData()
 
 		int rc = (int)read(m_soClient, (char*)(BYTE*)m_rcBuffer, m_dwSocketBufferSize);
 
+		m_metrics.OnRecv(rc);
+
 		if(rc > 0)
 		{
-			if(TRIGGER(FireReceive(m_rcBuffer, rc)) == HR_ERROR)
+			EnHandleResult rs;
+
+			{
+				CMetricsTimer timer(m_metrics);
+				rs = TRIGGER(FireReceive(m_rcBuffer, rc));
+			}
+
+			if(rs == HR_ERROR)
 			{
 				TRACE("<C-CNNID: %zu> OnReceive() event return 'HR_ERROR', connection will be closed !", m_dwConnID);
 
@@ -545,9 +586,18 @@ BOOL CTcpClient::DoSendData(TItem* pItem, BOOL& bBlocked)
 	{
 		int rc = (int)write(m_soClient, (char*)pItem->Ptr(), pItem->Size());
 
+		m_metrics.OnSend(rc);
+
 		if(rc > 0)
 		{
-			if(TRIGGER(FireSend(pItem->Ptr(), rc)) == HR_ERROR)
+			EnHandleResult rs;
+
+			{
+				CMetricsTimer timer(m_metrics);
+				rs = TRIGGER(FireSend(pItem->Ptr(), rc));
+			}
+
+			if(rs == HR_ERROR)
 			{
 				TRACE("<C-CNNID: %zu> OnSend() event should not return 'HR_ERROR' !!", m_dwConnID);
 				ASSERT(FALSE);
@@ -638,6 +688,8 @@ int CTcpClient::SendInternal(const WSABUF pBuffers[], int iCount)
 		}
 	}
 
+	m_metrics.OnSendRequest(m_lsSend.Length());
+
 	if(iPending == 0 && m_lsSend.Length() > 0) m_evSend.Set();
 
 	return NO_ERROR;
@@ -675,6 +727,30 @@ BOOL CTcpClient::GetLocalAddress(TCHAR lpszAddress[], int& iAddressLen, USHORT&
 	return ::GetSocketLocalAddress(m_soClient, lpszAddress, iAddressLen, usPort);
 }
 
+BOOL CTcpClient::GetMetrics(TSocketMetrics& metrics)
+{
+	if(!HasStarted())
+	{
+		::SetLastError(ERROR_INVALID_STATE);
+		return FALSE;
+	}
+
+	::GetSocketMetrics(m_metrics, metrics, IsConnected() ? 1 : 0);
+	::AddHeapMetrics(metrics, m_itPool.GetPrivateHeap());
+
+	return TRUE;
+}
+
+BOOL CTcpClient::GetMetricsText(LPSTR lpszBuffer, int& iLength, LPCSTR lpszPrefix)
+{
+	TSocketMetrics metrics;
+
+	if(!GetMetrics(metrics))
+		return FALSE;
+
+	return ::FormatMetricsText(metrics, lpszBuffer, iLength, lpszPrefix);
+}
+
 void CTcpClient::SetRemoteHost(LPCTSTR lpszHost, USHORT usPort)
 {
 	m_strHost = lpszHost;
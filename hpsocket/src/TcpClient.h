@@ -58,6 +58,8 @@ public:
 	virtual BOOL IsSSLAutoHandShake	()						{return FALSE;}
 	virtual void SetSSLCipherList	(LPCTSTR lpszCipherList){}
 	virtual LPCTSTR GetSSLCipherList()						{return nullptr;}
+	virtual void SetSSLAlpnProtocols(LPCTSTR lpszProtocols)	{}
+	virtual LPCTSTR GetSSLAlpnProtocols()					{return nullptr;}
 	virtual BOOL GetSSLSessionInfo(EnSSLSessionInfo enInfo, LPVOID* lppInfo)	{return FALSE;}
 
 protected:
@@ -83,6 +85,11 @@ public:
 	virtual DWORD GetFreeBufferPoolHold	()	{return m_dwFreeBufferPoolHold;}
 	virtual PVOID GetExtra				()	{return m_pExtra;}
 
+	virtual void SetCollectMetrics	(BOOL bCollectMetrics)	{m_metrics.SetEnabled(bCollectMetrics);}
+	virtual BOOL IsCollectMetrics	()						{return m_metrics.IsEnabled();}
+	virtual BOOL GetMetrics			(TSocketMetrics& metrics);
+	virtual BOOL GetMetricsText		(LPSTR lpszBuffer, int& iLength, LPCSTR lpszPrefix = nullptr);
+
 protected:
 	virtual EnHandleResult FirePrepareConnect(SOCKET socket)
 		{return DoFirePrepareConnect(this, socket);}
@@ -236,5 +243,7 @@ private:
 
 	volatile BOOL		m_bPaused;
 
+	CIOMetrics			m_metrics;
+
 	CThread<CTcpClient, VOID, UINT> m_thWorker;
 };
@@ -35,7 +35,6 @@ template<class T> class CTcpPackServerT : public IPackSocket, public T
 	using __super::GetSocketBufferSize;
 	using __super::GetFreeBufferObjPool;
 	using __super::GetFreeBufferObjHold;
-	using __super::GetFreeSocketObjLockTime;
 	using __super::GetFreeSocketObjPool;
 	using __super::GetFreeSocketObjHold;
 	using __super::SetLastError;
@@ -83,6 +82,11 @@ protected:
 		return ParsePack(this, pInfo, pBuffer, pSocketObj, m_dwMaxPackSize, m_usHeaderFlag, pData, iLength);
 	}
 
+	virtual EnHandleResult DoFireReceive(TSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount)
+	{
+		return __super::DoFireReceiveEach(pSocketObj, pBuffers, iCount);
+	}
+
 	virtual EnHandleResult DoFireClose(TSocketObj* pSocketObj, EnSocketOperation enOperation, int iErrorCode)
 	{
 		EnHandleResult result = __super::DoFireClose(pSocketObj, enOperation, iErrorCode);
@@ -146,7 +150,6 @@ protected:
 		m_bfPool.SetItemCapacity	(GetSocketBufferSize());
 		m_bfPool.SetItemPoolSize	(GetFreeBufferObjPool());
 		m_bfPool.SetItemPoolHold	(GetFreeBufferObjHold());
-		m_bfPool.SetBufferLockTime	(GetFreeSocketObjLockTime());
 		m_bfPool.SetBufferPoolSize	(GetFreeSocketObjPool());
 		m_bfPool.SetBufferPoolHold	(GetFreeSocketObjHold());
 
@@ -35,7 +35,6 @@ template<class T> class CTcpPullServerT : public IPullSocket, public T
 	using __super::GetSocketBufferSize;
 	using __super::GetFreeBufferObjPool;
 	using __super::GetFreeBufferObjHold;
-	using __super::GetFreeSocketObjLockTime;
 	using __super::GetFreeSocketObjPool;
 	using __super::GetFreeSocketObjHold;
 
@@ -46,12 +45,16 @@ public:
 public:
 	virtual EnFetchResult Fetch(CONNID dwConnID, BYTE* pData, int iLength)
 	{
+		CEpochLock epochlock;
+
 		TBuffer* pBuffer = m_bfPool[dwConnID];
 		return ::FetchBuffer(pBuffer, pData, iLength);
 	}
 
 	virtual EnFetchResult Peek(CONNID dwConnID, BYTE* pData, int iLength)
 	{
+		CEpochLock epochlock;
+
 		TBuffer* pBuffer = m_bfPool[dwConnID];
 		return ::PeekBuffer(pBuffer, pData, iLength);
 	}
@@ -81,6 +84,18 @@ protected:
 		return __super::DoFireReceive(pSocketObj, pBuffer->Length());
 	}
 
+	virtual EnHandleResult DoFireReceive(TSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount)
+	{
+		TBuffer* pBuffer = nullptr;
+		GetConnectionReserved(pSocketObj, (PVOID*)&pBuffer);
+		ASSERT(pBuffer && pBuffer->IsValid());
+
+		for(int i = 0; i < iCount; i++)
+			pBuffer->Cat(pBuffers[i].buf, (int)pBuffers[i].len);
+
+		return __super::DoFireReceive(pSocketObj, pBuffer->Length());
+	}
+
 	virtual EnHandleResult DoFireClose(TSocketObj* pSocketObj, EnSocketOperation enOperation, int iErrorCode)
 	{
 		EnHandleResult result = __super::DoFireClose(pSocketObj, enOperation, iErrorCode);
@@ -111,7 +126,6 @@ protected:
 		m_bfPool.SetItemCapacity	(GetSocketBufferSize());
 		m_bfPool.SetItemPoolSize	(GetFreeBufferObjPool());
 		m_bfPool.SetItemPoolHold	(GetFreeBufferObjHold());
-		m_bfPool.SetBufferLockTime	(GetFreeSocketObjLockTime());
 		m_bfPool.SetBufferPoolSize	(GetFreeSocketObjPool());
 		m_bfPool.SetBufferPoolHold	(GetFreeSocketObjHold());
 
@@ -54,16 +54,18 @@ BOOL CTcpServer::CheckParams()
 {
 	if	((m_enSendPolicy >= SP_PACK && m_enSendPolicy <= SP_DIRECT)								&&
 		(m_enOnSendSyncPolicy >= OSSP_NONE && m_enOnSendSyncPolicy <= OSSP_RECEIVE)				&&
+		(m_enOnSendNotifyPolicy >= OSNP_EACH && m_enOnSendNotifyPolicy <= OSNP_NONE)			&&
 		((int)m_dwMaxConnectionCount > 0 && m_dwMaxConnectionCount <= MAX_CONNECTION_COUNT)		&&
 		((int)m_dwWorkerThreadCount > 0 && m_dwWorkerThreadCount <= MAX_WORKER_THREAD_COUNT)	&&
 		((int)m_dwAcceptSocketCount > 0)														&&
 		((int)m_dwSocketBufferSize >= MIN_SOCKET_BUFFER_SIZE)									&&
 		((int)m_dwSocketListenQueue > 0)														&&
-		((int)m_dwFreeSocketObjLockTime >= 1000)												&&
 		((int)m_dwFreeSocketObjPool >= 0)														&&
 		((int)m_dwFreeBufferObjPool >= 0)														&&
 		((int)m_dwFreeSocketObjHold >= 0)														&&
 		((int)m_dwFreeBufferObjHold >= 0)														&&
+		((int)m_dwIoBytesBudget >= 0)															&&
+		((int)m_dwIoTimeBudget >= 0)															&&
 		((int)m_dwKeepAliveTime >= 1000 || m_dwKeepAliveTime == 0)								&&
 		((int)m_dwKeepAliveInterval >= 1000 || m_dwKeepAliveInterval == 0)						)
 		return TRUE;
@@ -82,6 +84,8 @@ void CTcpServer::PrepareStart()
 	m_bfObjPool.SetPoolHold(m_dwFreeBufferObjHold);
 
 	m_bfObjPool.Prepare();
+
+	m_metrics.Reset();
 }
 
 BOOL CTcpServer::CheckStarting()
@@ -268,7 +272,7 @@ TSocketObj* CTcpServer::GetFreeSocketObj(CONNID dwConnID, SOCKET soClient)
 
 	if(m_lsFreeSocket.TryLock(&pSocketObj, dwIndex))
 	{
-		if(::GetTimeGap32(pSocketObj->freeTime) >= m_dwFreeSocketObjLockTime)
+		if(CEpochDomain::IsReclaimable(pSocketObj->freeEpoch))
 			VERIFY(m_lsFreeSocket.ReleaseLock(nullptr, dwIndex));
 		else
 		{
@@ -311,7 +315,7 @@ void CTcpServer::AddFreeSocketObj(TSocketObj* pSocketObj, EnSocketCloseFlag enFl
 
 void CTcpServer::ReleaseGCSocketObj(BOOL bForce)
 {
-	::ReleaseGCObj(m_lsGCSocket, m_dwFreeSocketObjLockTime, bForce);
+	::ReleaseGCObj(m_lsGCSocket, bForce);
 }
 
 BOOL CTcpServer::InvalidSocketObj(TSocketObj* pSocketObj)
@@ -346,10 +350,16 @@ void CTcpServer::CloseClientSocketObj(TSocketObj* pSocketObj, EnSocketCloseFlag
 {
 	ASSERT(TSocketObj::IsExist(pSocketObj));
 
-	if(enFlag == SCF_CLOSE)
-		FireClose(pSocketObj, SO_CLOSE, SE_OK);
-	else if(enFlag == SCF_ERROR)
-		FireClose(pSocketObj, enOperation, iErrorCode);
+	{
+		CMetricsTimer timer(m_metrics);
+
+		if(enFlag == SCF_CLOSE)
+			FireClose(pSocketObj, SO_CLOSE, SE_OK);
+		else if(enFlag == SCF_ERROR)
+			FireClose(pSocketObj, enOperation, iErrorCode);
+	}
+
+	m_metrics.Add(CIOMetrics::IMC_CLOSES);
 
 	SOCKET socket = pSocketObj->socket;
 	pSocketObj->socket = INVALID_SOCKET;
@@ -366,6 +376,8 @@ BOOL CTcpServer::GetListenAddress(TCHAR lpszAddress[], int& iAddressLen, USHORT&
 
 BOOL CTcpServer::GetLocalAddress(CONNID dwConnID, TCHAR lpszAddress[], int& iAddressLen, USHORT& usPort)
 {
+	CEpochLock epochlock;
+
 	ASSERT(lpszAddress != nullptr && iAddressLen > 0);
 
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
@@ -378,6 +390,8 @@ BOOL CTcpServer::GetLocalAddress(CONNID dwConnID, TCHAR lpszAddress[], int& iAdd
 
 BOOL CTcpServer::GetRemoteAddress(CONNID dwConnID, TCHAR lpszAddress[], int& iAddressLen, USHORT& usPort)
 {
+	CEpochLock epochlock;
+
 	ASSERT(lpszAddress != nullptr && iAddressLen > 0);
 
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
@@ -393,6 +407,8 @@ BOOL CTcpServer::GetRemoteAddress(CONNID dwConnID, TCHAR lpszAddress[], int& iAd
 
 BOOL CTcpServer::SetConnectionExtra(CONNID dwConnID, PVOID pExtra)
 {
+	CEpochLock epochlock;
+
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
 	return SetConnectionExtra(pSocketObj, pExtra);
 }
@@ -410,6 +426,8 @@ BOOL CTcpServer::SetConnectionExtra(TSocketObj* pSocketObj, PVOID pExtra)
 
 BOOL CTcpServer::GetConnectionExtra(CONNID dwConnID, PVOID* ppExtra)
 {
+	CEpochLock epochlock;
+
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
 	return GetConnectionExtra(pSocketObj, ppExtra);
 }
@@ -429,6 +447,8 @@ BOOL CTcpServer::GetConnectionExtra(TSocketObj* pSocketObj, PVOID* ppExtra)
 
 BOOL CTcpServer::SetConnectionReserved(CONNID dwConnID, PVOID pReserved)
 {
+	CEpochLock epochlock;
+
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
 	return SetConnectionReserved(pSocketObj, pReserved);
 }
@@ -446,6 +466,8 @@ BOOL CTcpServer::SetConnectionReserved(TSocketObj* pSocketObj, PVOID pReserved)
 
 BOOL CTcpServer::GetConnectionReserved(CONNID dwConnID, PVOID* ppReserved)
 {
+	CEpochLock epochlock;
+
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
 	return GetConnectionReserved(pSocketObj, ppReserved);
 }
@@ -465,6 +487,8 @@ BOOL CTcpServer::GetConnectionReserved(TSocketObj* pSocketObj, PVOID* ppReserved
 
 BOOL CTcpServer::SetConnectionReserved2(CONNID dwConnID, PVOID pReserved2)
 {
+	CEpochLock epochlock;
+
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
 	return SetConnectionReserved2(pSocketObj, pReserved2);
 }
@@ -482,6 +506,8 @@ BOOL CTcpServer::SetConnectionReserved2(TSocketObj* pSocketObj, PVOID pReserved2
 
 BOOL CTcpServer::GetConnectionReserved2(CONNID dwConnID, PVOID* ppReserved2)
 {
+	CEpochLock epochlock;
+
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
 	return GetConnectionReserved2(pSocketObj, ppReserved2);
 }
@@ -501,6 +527,8 @@ BOOL CTcpServer::GetConnectionReserved2(TSocketObj* pSocketObj, PVOID* ppReserve
 
 BOOL CTcpServer::IsPauseReceive(CONNID dwConnID, BOOL& bPaused)
 {
+	CEpochLock epochlock;
+
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
 
 	if(TSocketObj::IsValid(pSocketObj))
@@ -514,6 +542,8 @@ BOOL CTcpServer::IsPauseReceive(CONNID dwConnID, BOOL& bPaused)
 
 BOOL CTcpServer::IsConnected(CONNID dwConnID)
 {
+	CEpochLock epochlock;
+
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
 
 	if(TSocketObj::IsValid(pSocketObj))
@@ -524,6 +554,8 @@ BOOL CTcpServer::IsConnected(CONNID dwConnID)
 
 BOOL CTcpServer::GetPendingDataLength(CONNID dwConnID, int& iPending)
 {
+	CEpochLock epochlock;
+
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
 
 	if(TSocketObj::IsValid(pSocketObj))
@@ -540,6 +572,53 @@ DWORD CTcpServer::GetConnectionCount()
 	return m_bfActiveSockets.Elements();
 }
 
+BOOL CTcpServer::GetMetrics(TSocketMetrics& metrics)
+{
+	if(!HasStarted())
+	{
+		::SetLastError(ERROR_INVALID_STATE);
+		return FALSE;
+	}
+
+	::GetSocketMetrics(m_metrics, metrics, GetConnectionCount(), m_ioDispatcher.GetCommandQueueSize());
+	::AddHeapMetrics(metrics, m_phSocket);
+	::AddHeapMetrics(metrics, m_bfObjPool.GetPrivateHeap());
+
+	return TRUE;
+}
+
+BOOL CTcpServer::GetMetricsText(LPSTR lpszBuffer, int& iLength, LPCSTR lpszPrefix)
+{
+	TSocketMetrics metrics;
+
+	if(!GetMetrics(metrics))
+		return FALSE;
+
+	return ::FormatMetricsText(metrics, lpszBuffer, iLength, lpszPrefix);
+}
+
+BOOL CTcpServer::GetWorkerTraceStats(TWorkerTraceStat stats[], DWORD& dwCount)
+{
+	if(!HasStarted())
+	{
+		::SetLastError(ERROR_INVALID_STATE);
+		return FALSE;
+	}
+
+	return ::GetWorkerTraceStats(m_ioDispatcher.GetLoopTracer(), stats, dwCount);
+}
+
+BOOL CTcpServer::GetSlowCallbacks(TSlowCallback records[], DWORD& dwCount)
+{
+	if(!HasStarted())
+	{
+		::SetLastError(ERROR_INVALID_STATE);
+		return FALSE;
+	}
+
+	return ::GetSlowCallbacks(m_ioDispatcher.GetLoopTracer(), records, dwCount, SO_ACCEPT);
+}
+
 BOOL CTcpServer::GetAllConnectionIDs(CONNID pIDs[], DWORD& dwCount)
 {
 	return m_bfActiveSockets.GetAllElementIndexes(pIDs, dwCount);
@@ -547,6 +626,8 @@ BOOL CTcpServer::GetAllConnectionIDs(CONNID pIDs[], DWORD& dwCount)
 
 BOOL CTcpServer::GetConnectPeriod(CONNID dwConnID, DWORD& dwPeriod)
 {
+	CEpochLock epochlock;
+
 	BOOL isOK				= TRUE;
 	TSocketObj* pSocketObj	= FindSocketObj(dwConnID);
 
@@ -560,6 +641,8 @@ BOOL CTcpServer::GetConnectPeriod(CONNID dwConnID, DWORD& dwPeriod)
 
 BOOL CTcpServer::GetSilencePeriod(CONNID dwConnID, DWORD& dwPeriod)
 {
+	CEpochLock epochlock;
+
 	if(!m_bMarkSilence)
 		return FALSE;
 
@@ -576,6 +659,8 @@ BOOL CTcpServer::GetSilencePeriod(CONNID dwConnID, DWORD& dwPeriod)
 
 BOOL CTcpServer::Disconnect(CONNID dwConnID, BOOL bForce)
 {
+	CEpochLock epochlock;
+
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
 
 	if(!TSocketObj::IsValid(pSocketObj))
@@ -589,6 +674,8 @@ BOOL CTcpServer::Disconnect(CONNID dwConnID, BOOL bForce)
 
 BOOL CTcpServer::DisconnectLongConnections(DWORD dwPeriod, BOOL bForce)
 {
+	CEpochLock epochlock;
+
 	if(dwPeriod > MAX_CONNECTION_PERIOD)
 		return FALSE;
 
@@ -610,6 +697,8 @@ BOOL CTcpServer::DisconnectLongConnections(DWORD dwPeriod, BOOL bForce)
 
 BOOL CTcpServer::DisconnectSilenceConnections(DWORD dwPeriod, BOOL bForce)
 {
+	CEpochLock epochlock;
+
 	if(!m_bMarkSilence)
 		return FALSE;
 	if(dwPeriod > MAX_CONNECTION_PERIOD)
@@ -633,6 +722,8 @@ BOOL CTcpServer::DisconnectSilenceConnections(DWORD dwPeriod, BOOL bForce)
 
 BOOL CTcpServer::PauseReceive(CONNID dwConnID, BOOL bPause)
 {
+	CEpochLock epochlock;
+
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
 
 	if(!TSocketObj::IsValid(pSocketObj))
@@ -687,13 +778,37 @@ VOID CTcpServer::OnAfterProcessIo(PVOID pv, UINT events, BOOL rs)
 	{
         ASSERT(rs && events != EVFILT_EXCEPT);
 
-        UINT evts = (pSocketObj->IsPending() ? EVFILT_WRITE : 0) | (pSocketObj->IsPaused() ? 0 : EVFILT_READ);
-        m_ioDispatcher.CtlFD(pSocketObj->socket, EV_ADD | EV_ENABLE | EV_DISPATCH ,evts, pSocketObj);
+		UINT uDeferred = pSocketObj->budget.TakeDeferred();
+
+		//因读写预算用尽而未处理完的连接放入工作线程就绪队列，本批事件之后重新处理，不必重新注册事件
+		if(uDeferred == 0 || !m_ioDispatcher.DeferIo(pSocketObj, uDeferred))
+			ArmSocketObj(pSocketObj);
 	}
 
 	pSocketObj->csIo.unlock();
 }
 
+BOOL CTcpServer::ArmSocketObj(TSocketObj* pSocketObj)
+{
+	if(!m_bEdgeTrigger)
+	{
+        UINT evts = (pSocketObj->IsPending() ? EVFILT_WRITE : 0) | (pSocketObj->IsPaused() ? 0 : EVFILT_READ);
+        return m_ioDispatcher.CtlFD(pSocketObj->socket, EV_ADD | EV_ENABLE | EV_DISPATCH, evts, pSocketObj);
+	}
+
+	BOOL isOK = TRUE;
+
+	//边缘触发模式：读事件以 EV_CLEAR | EV_DISPATCH 注册，每次投递后自动禁用，处理完成后重新启用，
+	//保证共享 kqueue 的多个工作线程不会同时收到同一连接的读事件；暂停接收时不重新启用读事件；
+	//写事件只在有待发数据时单次注册
+	if(!pSocketObj->IsPaused())
+		isOK = m_ioDispatcher.CtlFD(pSocketObj->socket, EV_ADD | EV_ENABLE | EV_CLEAR | EV_DISPATCH, EVFILT_READ, pSocketObj);
+	if(isOK && pSocketObj->IsPending())
+		isOK = m_ioDispatcher.CtlFD(pSocketObj->socket, EV_ADD | EV_ENABLE | EV_DISPATCH, EVFILT_WRITE, pSocketObj);
+
+	return isOK;
+}
+
 VOID CTcpServer::OnCommand(TDispCommand* pCmd)
 {
 	switch(pCmd->type)
@@ -769,6 +884,11 @@ VOID CTcpServer::OnDispatchThreadEnd(THR_ID tid)
 	OnWorkerThreadEnd(tid);
 }
 
+UINT_PTR CTcpServer::GetTraceID(PVOID pv, UINT events)
+{
+	return ((TSocketObj*)pv)->connID;
+}
+
 BOOL CTcpServer::HandleClose(TSocketObj* pSocketObj, EnSocketCloseFlag enFlag, UINT events)
 {
 	EnSocketOperation enOperation = SO_CLOSE;
@@ -833,14 +953,22 @@ BOOL CTcpServer::HandleAccept(UINT events)
 
 		AddClientSocketObj(dwConnID, pSocketObj, addr);
 
-		if(TRIGGER(FireAccept(pSocketObj)) == HR_ERROR)
+		m_metrics.Add(CIOMetrics::IMC_CONNECTS);
+
+		EnHandleResult rs;
+
+		{
+			CMetricsTimer timer(m_metrics);
+			rs = TRIGGER(FireAccept(pSocketObj));
+		}
+
+		if(rs == HR_ERROR)
 		{
 			AddFreeSocketObj(pSocketObj, SCF_NONE);
 			continue;
 		}
 
-        UINT evts = (pSocketObj->IsPending() ? EVFILT_WRITE : 0) | (pSocketObj->IsPaused() ? 0 : EVFILT_READ);
-        VERIFY(m_ioDispatcher.CtlFD(pSocketObj->socket, EV_ADD | EV_ENABLE | EV_DISPATCH, evts, pSocketObj));
+        VERIFY(ArmSocketObj(pSocketObj));
 	}
 
 	return TRUE;
@@ -852,26 +980,47 @@ BOOL CTcpServer::HandleReceive(TSocketObj* pSocketObj, int flag)
 
 	if(m_bMarkSilence) pSocketObj->activeTime = ::TimeGetTime();
 
+	if(m_bBatchReceive)
+		return HandleReceiveBatch(pSocketObj, flag);
+
 	CBufferPtr& buffer = *(m_rcBufferMap[SELF_THREAD_ID]);
 
-	int reads = flag ? -1 : MAX_CONTINUE_READS;
+	TIoBudget& budget = pSocketObj->budget;
+	TIoPass pass(flag ? -1 : budget.GetReads(m_dwIoBytesBudget), m_dwIoBytesBudget, m_dwIoTimeBudget);
 
-	for(int i = 0; i < reads || reads < 0; i++)
+	while(TRUE)
 	{
 		if(pSocketObj->paused)
 			break;
 
 		int rc = (int)read(pSocketObj->socket, buffer.Ptr(), buffer.Size());
 
+		m_metrics.OnRecv(rc);
+
 		if(rc > 0)
 		{
-			if(TRIGGER(FireReceive(pSocketObj, buffer.Ptr(), rc)) == HR_ERROR)
+			budget.OnRead(rc);
+
+			EnHandleResult rs;
+
+			{
+				CMetricsTimer timer(m_metrics);
+				rs = TRIGGER(FireReceive(pSocketObj, buffer.Ptr(), rc));
+			}
+
+			if(rs == HR_ERROR)
 			{
 				TRACE("<S-CNNID: %zu> OnReceive() event return 'HR_ERROR', connection will be closed !", pSocketObj->connID);
 
 				AddFreeSocketObj(pSocketObj, SCF_ERROR, SO_RECEIVE, ENSURE_ERROR_CANCELLED);
 				return FALSE;
 			}
+
+			if(pass.Consume(rc))
+			{
+				budget.Defer(DISP_EVENT_FLAG_R);
+				break;
+			}
 		}
 		else if(rc == 0)
 		{
@@ -895,6 +1044,128 @@ BOOL CTcpServer::HandleReceive(TSocketObj* pSocketObj, int flag)
 	return TRUE;
 }
 
+BOOL CTcpServer::HandleReceiveBatch(TSocketObj* pSocketObj, int flag)
+{
+	CBufferPtr& buffer = *(m_rcBufferMap[SELF_THREAD_ID]);
+
+	WSABUF buffers[MAX_CONTINUE_READS];
+
+	int iCount		= 0;
+	int iOffset		= 0;
+	int iSize		= (int)buffer.Size();
+
+	TIoBudget& budget = pSocketObj->budget;
+	TIoPass pass(flag ? -1 : budget.GetReads(m_dwIoBytesBudget), m_dwIoBytesBudget, m_dwIoTimeBudget);
+
+	while(TRUE)
+	{
+		if(pSocketObj->paused)
+			break;
+
+		int rc = (int)read(pSocketObj->socket, buffer.Ptr() + iOffset, iSize - iOffset);
+
+		m_metrics.OnRecv(rc);
+
+		if(rc > 0)
+		{
+			budget.OnRead(rc);
+
+			buffers[iCount].buf = buffer.Ptr() + iOffset;
+			buffers[iCount].len = rc;
+
+			++iCount;
+			iOffset += rc;
+
+			/* 缓冲区数组已满或剩余空间不足 1/4 时先交付已读取的数据，避免后续 read() 读取过少 */
+			if(iCount == MAX_CONTINUE_READS || iSize - iOffset < iSize / 4)
+			{
+				if(!NotifyReceive(pSocketObj, buffers, iCount))
+					return FALSE;
+
+				iCount	= 0;
+				iOffset	= 0;
+			}
+
+			if(pass.Consume(rc))
+			{
+				budget.Defer(DISP_EVENT_FLAG_R);
+				break;
+			}
+		}
+		else if(rc == 0)
+		{
+			if(iCount > 0 && !NotifyReceive(pSocketObj, buffers, iCount))
+				return FALSE;
+
+			AddFreeSocketObj(pSocketObj, SCF_CLOSE, SO_RECEIVE, SE_OK);
+			return FALSE;
+		}
+		else
+		{
+			ASSERT(rc == SOCKET_ERROR);
+
+			int code = ::WSAGetLastError();
+
+			if(code == ERROR_WOULDBLOCK)
+				break;
+
+			if(iCount > 0 && !NotifyReceive(pSocketObj, buffers, iCount))
+				return FALSE;
+
+			AddFreeSocketObj(pSocketObj, SCF_ERROR, SO_RECEIVE, code);
+			return FALSE;
+		}
+	}
+
+	return (iCount == 0 || NotifyReceive(pSocketObj, buffers, iCount));
+}
+
+BOOL CTcpServer::NotifyReceive(TSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount)
+{
+	EnHandleResult rs;
+
+	{
+		CMetricsTimer timer(m_metrics);
+		rs = TRIGGER(FireReceive(pSocketObj, pBuffers, iCount));
+	}
+
+	if(rs == HR_ERROR)
+	{
+		TRACE("<S-CNNID: %zu> OnReceiveBatch() event return 'HR_ERROR', connection will be closed !", pSocketObj->connID);
+
+		AddFreeSocketObj(pSocketObj, SCF_ERROR, SO_RECEIVE, ENSURE_ERROR_CANCELLED);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+EnHandleResult CTcpServer::FireReceiveEach(TSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount)
+{
+	for(int i = 0; i < iCount; i++)
+	{
+		EnHandleResult rs = FireReceive(pSocketObj, pBuffers[i].buf, (int)pBuffers[i].len);
+
+		if(rs == HR_ERROR)
+			return rs;
+	}
+
+	return HR_OK;
+}
+
+EnHandleResult CTcpServer::DoFireReceiveEach(TSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount)
+{
+	for(int i = 0; i < iCount; i++)
+	{
+		EnHandleResult rs = DoFireReceive(pSocketObj, pBuffers[i].buf, (int)pBuffers[i].len);
+
+		if(rs == HR_ERROR)
+			return rs;
+	}
+
+	return HR_OK;
+}
+
 BOOL CTcpServer::HandleSend(TSocketObj* pSocketObj, int flag)
 {
 	ASSERT(TSocketObj::IsValid(pSocketObj));
@@ -903,12 +1174,15 @@ BOOL CTcpServer::HandleSend(TSocketObj* pSocketObj, int flag)
 		return TRUE;
 
 	BOOL bBlocked	= FALSE;
-	int writes		= flag ? -1 : MAX_CONTINUE_WRITES;
+	int iSent		= 0;
+
+	TIoBudget& budget = pSocketObj->budget;
+	TIoPass pass(flag ? -1 : budget.GetWrites(m_dwIoBytesBudget), m_dwIoBytesBudget, m_dwIoTimeBudget);
 
 	TBufferObjList& sndBuff = pSocketObj->sndBuff;
 	TItemPtr itPtr(sndBuff);
 
-	for(int i = 0; i < writes || writes < 0; i++)
+	while(TRUE)
 	{
 		{
 			CReentrantCriSecLock locallock(pSocketObj->csSend);
@@ -920,7 +1194,9 @@ BOOL CTcpServer::HandleSend(TSocketObj* pSocketObj, int flag)
 
 		ASSERT(!itPtr->IsEmpty());
 
-		if(!SendItem(pSocketObj, itPtr, bBlocked))
+		int iSize = itPtr->Size();
+
+		if(!SendItem(pSocketObj, itPtr, bBlocked, iSent))
 			return FALSE;
 
 		if(bBlocked)
@@ -932,24 +1208,38 @@ BOOL CTcpServer::HandleSend(TSocketObj* pSocketObj, int flag)
 
 			break;
 		}
+
+		budget.OnWrite(iSize);
+
+		if(pass.Consume(iSize))
+		{
+			if(pSocketObj->IsPending())
+				budget.Defer(DISP_EVENT_FLAG_W);
+
+			break;
+		}
 	}
 
+	if(iSent > 0)
+		NotifySend(pSocketObj, nullptr, iSent);
+
 	return TRUE;
 }
 
-BOOL CTcpServer::SendItem(TSocketObj* pSocketObj, TItem* pItem, BOOL& bBlocked)
+BOOL CTcpServer::SendItem(TSocketObj* pSocketObj, TItem* pItem, BOOL& bBlocked, int& iSent)
 {
 	while(!pItem->IsEmpty())
 	{
 		int rc = (int)write(pSocketObj->socket, pItem->Ptr(), pItem->Size());
 
+		m_metrics.OnSend(rc);
+
 		if(rc > 0)
 		{
-			if(TRIGGER(FireSend(pSocketObj, pItem->Ptr(), rc)) == HR_ERROR)
-			{
-				TRACE("<S-CNNID: %zu> OnSend() event should not return 'HR_ERROR' !!", pSocketObj->connID);
-				ASSERT(FALSE);
-			}
+			if(m_enOnSendNotifyPolicy == OSNP_EACH)
+				NotifySend(pSocketObj, pItem->Ptr(), rc);
+			else if(m_enOnSendNotifyPolicy == OSNP_BATCH)
+				iSent += rc;
 
 			pItem->Reduce(rc);
 		}
@@ -975,6 +1265,22 @@ BOOL CTcpServer::SendItem(TSocketObj* pSocketObj, TItem* pItem, BOOL& bBlocked)
 	return TRUE;
 }
 
+void CTcpServer::NotifySend(TSocketObj* pSocketObj, const BYTE* pData, int iLength)
+{
+	EnHandleResult rs;
+
+	{
+		CMetricsTimer timer(m_metrics);
+		rs = TRIGGER(FireSend(pSocketObj, pData, iLength));
+	}
+
+	if(rs == HR_ERROR)
+	{
+		TRACE("<S-CNNID: %zu> OnSend() event should not return 'HR_ERROR' !!", pSocketObj->connID);
+		ASSERT(FALSE);
+	}
+}
+
 BOOL CTcpServer::Send(CONNID dwConnID, const BYTE* pBuffer, int iLength, int iOffset)
 {
 	ASSERT(pBuffer && iLength > 0);
@@ -990,6 +1296,8 @@ BOOL CTcpServer::Send(CONNID dwConnID, const BYTE* pBuffer, int iLength, int iOf
 
 BOOL CTcpServer::DoSendPackets(CONNID dwConnID, const WSABUF pBuffers[], int iCount)
 {
+	CEpochLock epochlock;
+
 	ASSERT(pBuffers && iCount > 0);
 
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
@@ -1044,6 +1352,8 @@ int CTcpServer::SendInternal(TSocketObj* pSocketObj, const WSABUF pBuffers[], in
 		}
 	}
 
+	m_metrics.OnSendRequest(pSocketObj->Pending());
+
 	if(iPending == 0 && pSocketObj->IsPending())
 	{
 		if(!m_ioDispatcher.SendCommand(DISP_CMD_SEND, pSocketObj->connID))
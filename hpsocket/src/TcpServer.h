@@ -61,6 +61,7 @@ public:
 	virtual BOOL SetupSSLContextByMemory(int iVerifyMode = SSL_VM_NONE, LPCSTR lpszPemCert = nullptr, LPCSTR lpszPemKey = nullptr, LPCSTR lpszKeyPassword = nullptr, LPCSTR lpszCAPemCert = nullptr, Fn_SNI_ServerNameCallback fnServerNameCallback = nullptr)					{return FALSE;}
 	virtual int AddSSLContext		(int iVerifyMode = SSL_VM_NONE, LPCTSTR lpszPemCertFile = nullptr, LPCTSTR lpszPemKeyFile = nullptr, LPCTSTR lpszKeyPassword = nullptr, LPCTSTR lpszCAPemCertFileOrPath = nullptr)															{return FALSE;}
 	virtual int AddSSLContextByMemory(int iVerifyMode = SSL_VM_NONE, LPCSTR lpszPemCert = nullptr, LPCSTR lpszPemKey = nullptr, LPCSTR lpszKeyPassword = nullptr, LPCSTR lpszCAPemCert = nullptr)																				{return FALSE;}
+	virtual int AddSSLContextLazy	(int iVerifyMode, LPCTSTR lpszPemCertFile, LPCTSTR lpszPemKeyFile, LPCTSTR lpszKeyPassword = nullptr, LPCTSTR lpszCAPemCertFileOrPath = nullptr)																				{return FALSE;}
 	virtual BOOL BindSSLServerName	(LPCTSTR lpszServerName, int iContextIndex)																																																	{return FALSE;}
 	virtual void CleanupSSLContext	()						{}
 
@@ -69,6 +70,12 @@ public:
 	virtual BOOL IsSSLAutoHandShake	()						{return FALSE;}
 	virtual void SetSSLCipherList	(LPCTSTR lpszCipherList){}
 	virtual LPCTSTR GetSSLCipherList()						{return nullptr;}
+	virtual void SetSSLAlpnProtocols(LPCTSTR lpszProtocols)	{}
+	virtual LPCTSTR GetSSLAlpnProtocols()					{return nullptr;}
+	virtual void SetSSLHandShakeThreadCount(DWORD dwThreadCount)	{}
+	virtual DWORD GetSSLHandShakeThreadCount()						{return 0;}
+	virtual void SetSSLLazyContextCacheSize(DWORD dwCacheSize)		{}
+	virtual DWORD GetSSLLazyContextCacheSize()						{return 0;}
 	virtual BOOL GetSSLSessionInfo(CONNID dwConnID, EnSSLSessionInfo enInfo, LPVOID* lppInfo)	{return FALSE;}
 
 protected:
@@ -85,6 +92,7 @@ private:
 	virtual BOOL OnError(PVOID pv, UINT events)						override;
 	virtual VOID OnDispatchThreadStart(THR_ID tid)					override;
 	virtual VOID OnDispatchThreadEnd(THR_ID tid)					override;
+	virtual UINT_PTR GetTraceID(PVOID pv, UINT events)				override;
 
 public:
 	virtual BOOL IsSecure					() {return FALSE;}
@@ -95,12 +103,12 @@ public:
 	virtual void SetReuseAddressPolicy		(EnReuseAddressPolicy enReusePolicy)	{ENSURE_HAS_STOPPED(); m_enReusePolicy		= enReusePolicy;}
 	virtual void SetSendPolicy				(EnSendPolicy enSendPolicy)				{ENSURE_HAS_STOPPED(); m_enSendPolicy		= enSendPolicy;}
 	virtual void SetOnSendSyncPolicy		(EnOnSendSyncPolicy enOnSendSyncPolicy)	{ENSURE_HAS_STOPPED(); m_enOnSendSyncPolicy	= enOnSendSyncPolicy;}
+	virtual void SetOnSendNotifyPolicy		(EnOnSendNotifyPolicy enOnSendNotifyPolicy)	{ENSURE_HAS_STOPPED(); m_enOnSendNotifyPolicy	= enOnSendNotifyPolicy;}
 	virtual void SetMaxConnectionCount		(DWORD dwMaxConnectionCount)	{ENSURE_HAS_STOPPED(); m_dwMaxConnectionCount		= dwMaxConnectionCount;}
 	virtual void SetWorkerThreadCount		(DWORD dwWorkerThreadCount)		{ENSURE_HAS_STOPPED(); m_dwWorkerThreadCount		= dwWorkerThreadCount;}
 	virtual void SetSocketListenQueue		(DWORD dwSocketListenQueue)		{ENSURE_HAS_STOPPED(); m_dwSocketListenQueue		= dwSocketListenQueue;}
 	virtual void SetAcceptSocketCount		(DWORD dwAcceptSocketCount)		{ENSURE_HAS_STOPPED(); m_dwAcceptSocketCount		= dwAcceptSocketCount;}
 	virtual void SetSocketBufferSize		(DWORD dwSocketBufferSize)		{ENSURE_HAS_STOPPED(); m_dwSocketBufferSize			= dwSocketBufferSize;}
-	virtual void SetFreeSocketObjLockTime	(DWORD dwFreeSocketObjLockTime)	{ENSURE_HAS_STOPPED(); m_dwFreeSocketObjLockTime	= dwFreeSocketObjLockTime;}
 	virtual void SetFreeSocketObjPool		(DWORD dwFreeSocketObjPool)		{ENSURE_HAS_STOPPED(); m_dwFreeSocketObjPool		= dwFreeSocketObjPool;}
 	virtual void SetFreeBufferObjPool		(DWORD dwFreeBufferObjPool)		{ENSURE_HAS_STOPPED(); m_dwFreeBufferObjPool		= dwFreeBufferObjPool;}
 	virtual void SetFreeSocketObjHold		(DWORD dwFreeSocketObjHold)		{ENSURE_HAS_STOPPED(); m_dwFreeSocketObjHold		= dwFreeSocketObjHold;}
@@ -108,16 +116,20 @@ public:
 	virtual void SetKeepAliveTime			(DWORD dwKeepAliveTime)			{ENSURE_HAS_STOPPED(); m_dwKeepAliveTime			= dwKeepAliveTime;}
 	virtual void SetKeepAliveInterval		(DWORD dwKeepAliveInterval)		{ENSURE_HAS_STOPPED(); m_dwKeepAliveInterval		= dwKeepAliveInterval;}
 	virtual void SetMarkSilence				(BOOL bMarkSilence)				{ENSURE_HAS_STOPPED(); m_bMarkSilence				= bMarkSilence;}
+	virtual void SetBatchReceive			(BOOL bBatchReceive)			{ENSURE_HAS_STOPPED(); m_bBatchReceive				= bBatchReceive;}
+	virtual void SetEdgeTrigger				(BOOL bEdgeTrigger)				{ENSURE_HAS_STOPPED(); m_bEdgeTrigger				= bEdgeTrigger;}
+	virtual void SetIoBytesBudget			(DWORD dwIoBytesBudget)			{ENSURE_HAS_STOPPED(); m_dwIoBytesBudget			= dwIoBytesBudget;}
+	virtual void SetIoTimeBudget			(DWORD dwIoTimeBudget)			{ENSURE_HAS_STOPPED(); m_dwIoTimeBudget				= dwIoTimeBudget;}
 
 	virtual EnReuseAddressPolicy GetReuseAddressPolicy	()	{return m_enReusePolicy;}
 	virtual EnSendPolicy GetSendPolicy					()	{return m_enSendPolicy;}
 	virtual EnOnSendSyncPolicy GetOnSendSyncPolicy		()	{return m_enOnSendSyncPolicy;}
+	virtual EnOnSendNotifyPolicy GetOnSendNotifyPolicy	()	{return m_enOnSendNotifyPolicy;}
 	virtual DWORD GetMaxConnectionCount		()	{return m_dwMaxConnectionCount;}
 	virtual DWORD GetWorkerThreadCount		()	{return m_dwWorkerThreadCount;}
 	virtual DWORD GetSocketListenQueue		()	{return m_dwSocketListenQueue;}
 	virtual DWORD GetAcceptSocketCount		()	{return m_dwAcceptSocketCount;}
 	virtual DWORD GetSocketBufferSize		()	{return m_dwSocketBufferSize;}
-	virtual DWORD GetFreeSocketObjLockTime	()	{return m_dwFreeSocketObjLockTime;}
 	virtual DWORD GetFreeSocketObjPool		()	{return m_dwFreeSocketObjPool;}
 	virtual DWORD GetFreeBufferObjPool		()	{return m_dwFreeBufferObjPool;}
 	virtual DWORD GetFreeSocketObjHold		()	{return m_dwFreeSocketObjHold;}
@@ -125,6 +137,20 @@ public:
 	virtual DWORD GetKeepAliveTime			()	{return m_dwKeepAliveTime;}
 	virtual DWORD GetKeepAliveInterval		()	{return m_dwKeepAliveInterval;}
 	virtual BOOL  IsMarkSilence				()	{return m_bMarkSilence;}
+	virtual BOOL  IsBatchReceive			()	{return m_bBatchReceive;}
+	virtual BOOL  IsEdgeTrigger				()	{return m_bEdgeTrigger;}
+	virtual DWORD GetIoBytesBudget			()	{return m_dwIoBytesBudget;}
+	virtual DWORD GetIoTimeBudget			()	{return m_dwIoTimeBudget;}
+
+	virtual void SetCollectMetrics	(BOOL bCollectMetrics)	{m_metrics.SetEnabled(bCollectMetrics);}
+	virtual BOOL IsCollectMetrics	()						{return m_metrics.IsEnabled();}
+	virtual BOOL GetMetrics			(TSocketMetrics& metrics);
+	virtual BOOL GetMetricsText		(LPSTR lpszBuffer, int& iLength, LPCSTR lpszPrefix = nullptr);
+
+	virtual void SetSlowCallbackThreshold	(DWORD dwSlowCallbackThreshold)	{m_ioDispatcher.GetLoopTracer().SetSlowThreshold(dwSlowCallbackThreshold * 1000ull);}
+	virtual DWORD GetSlowCallbackThreshold	()								{return (DWORD)(m_ioDispatcher.GetLoopTracer().GetSlowThreshold() / 1000);}
+	virtual BOOL GetWorkerTraceStats		(TWorkerTraceStat stats[], DWORD& dwCount);
+	virtual BOOL GetSlowCallbacks			(TSlowCallback records[], DWORD& dwCount);
 
 protected:
 	virtual EnHandleResult FirePrepareListen(SOCKET soListen)
@@ -141,6 +167,8 @@ protected:
 		{return DoFireReceive(pSocketObj, pData, iLength);}
 	virtual EnHandleResult FireReceive(TSocketObj* pSocketObj, int iLength)
 		{return DoFireReceive(pSocketObj, iLength);}
+	virtual EnHandleResult FireReceive(TSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount)
+		{return DoFireReceive(pSocketObj, pBuffers, iCount);}
 	virtual EnHandleResult FireSend(TSocketObj* pSocketObj, const BYTE* pData, int iLength)
 		{return DoFireSend(pSocketObj, pData, iLength);}
 	virtual EnHandleResult FireClose(TSocketObj* pSocketObj, EnSocketOperation enOperation, int iErrorCode)
@@ -158,6 +186,8 @@ protected:
 		{return m_pListener->OnReceive(this, pSocketObj->connID, pData, iLength);}
 	virtual EnHandleResult DoFireReceive(TSocketObj* pSocketObj, int iLength)
 		{return m_pListener->OnReceive(this, pSocketObj->connID, iLength);}
+	virtual EnHandleResult DoFireReceive(TSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount)
+		{return m_pListener->OnReceiveBatch(this, pSocketObj->connID, pBuffers, iCount);}
 	virtual EnHandleResult DoFireSend(TSocketObj* pSocketObj, const BYTE* pData, int iLength)
 		{return m_pListener->OnSend(this, pSocketObj->connID, pData, iLength);}
 	virtual EnHandleResult DoFireClose(TSocketObj* pSocketObj, EnSocketOperation enOperation, int iErrorCode)
@@ -165,6 +195,10 @@ protected:
 	virtual EnHandleResult DoFireShutdown()
 		{return m_pListener->OnShutdown(this);}
 
+	/* 把批量数据到达事件拆分为逐个缓冲区的数据到达事件（供需要加工接收数据的派生组件使用） */
+	EnHandleResult FireReceiveEach(TSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount);
+	EnHandleResult DoFireReceiveEach(TSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount);
+
 	void SetLastError(EnSocketError code, LPCSTR func, int ec);
 	virtual BOOL CheckParams();
 	virtual void PrepareStart();
@@ -191,6 +225,8 @@ protected:
 	BOOL SetConnectionReserved2(TSocketObj* pSocketObj, PVOID pReserved2);
 	BOOL GetConnectionReserved2(TSocketObj* pSocketObj, PVOID* ppReserved2);
 
+	void AddFreeSocketObj	(TSocketObj* pSocketObj, EnSocketCloseFlag enFlag = SCF_NONE, EnSocketOperation enOperation = SO_UNKNOWN, int iErrorCode = 0);
+
 private:
 	BOOL CheckStarting();
 	BOOL CheckStoping();
@@ -207,7 +243,6 @@ private:
 
 	TSocketObj* GetFreeSocketObj(CONNID dwConnID, SOCKET soClient);
 	TSocketObj* CreateSocketObj();
-	void AddFreeSocketObj	(TSocketObj* pSocketObj, EnSocketCloseFlag enFlag = SCF_NONE, EnSocketOperation enOperation = SO_UNKNOWN, int iErrorCode = 0);
 	void DeleteSocketObj	(TSocketObj* pSocketObj);
 	BOOL InvalidSocketObj	(TSocketObj* pSocketObj);
 	void ReleaseGCSocketObj	(BOOL bForce = FALSE);
@@ -220,11 +255,15 @@ private:
 	VOID HandleCmdDisconnect(CONNID dwConnID, BOOL bForce);
 	BOOL HandleAccept		(UINT events);
 	BOOL HandleReceive		(TSocketObj* pSocketObj, int flag);
+	BOOL HandleReceiveBatch	(TSocketObj* pSocketObj, int flag);
+	BOOL NotifyReceive		(TSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount);
 	BOOL HandleSend			(TSocketObj* pSocketObj, int flag);
 	BOOL HandleClose		(TSocketObj* pSocketObj, EnSocketCloseFlag enFlag, UINT events);
+	BOOL ArmSocketObj		(TSocketObj* pSocketObj);
 
 	int SendInternal	(TSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount);
-	BOOL SendItem		(TSocketObj* pSocketObj, TItem* pItem, BOOL& bBlocked);
+	BOOL SendItem		(TSocketObj* pSocketObj, TItem* pItem, BOOL& bBlocked, int& iSent);
+	void NotifySend		(TSocketObj* pSocketObj, const BYTE* pData, int iLength);
 
 public:
 	CTcpServer(ITcpServerListener* pListener)
@@ -235,12 +274,12 @@ public:
 	, m_enReusePolicy			(RAP_ADDR_ONLY)
 	, m_enSendPolicy			(SP_PACK)
 	, m_enOnSendSyncPolicy		(OSSP_NONE)
+	, m_enOnSendNotifyPolicy	(OSNP_EACH)
 	, m_dwMaxConnectionCount	(DEFAULT_CONNECTION_COUNT)
 	, m_dwWorkerThreadCount		(DEFAULT_WORKER_THREAD_COUNT)
 	, m_dwSocketListenQueue		(DEFAULT_TCP_SERVER_SOCKET_LISTEN_QUEUE)
 	, m_dwAcceptSocketCount		(DEFAULT_WORKER_MAX_EVENT_COUNT)
 	, m_dwSocketBufferSize		(DEFAULT_TCP_SOCKET_BUFFER_SIZE)
-	, m_dwFreeSocketObjLockTime	(DEFAULT_FREE_SOCKETOBJ_LOCK_TIME)
 	, m_dwFreeSocketObjPool		(DEFAULT_FREE_SOCKETOBJ_POOL)
 	, m_dwFreeBufferObjPool		(DEFAULT_FREE_BUFFEROBJ_POOL)
 	, m_dwFreeSocketObjHold		(DEFAULT_FREE_SOCKETOBJ_HOLD)
@@ -248,8 +287,14 @@ public:
 	, m_dwKeepAliveTime			(DEFALUT_TCP_KEEPALIVE_TIME)
 	, m_dwKeepAliveInterval		(DEFALUT_TCP_KEEPALIVE_INTERVAL)
 	, m_bMarkSilence			(TRUE)
+	, m_bBatchReceive			(FALSE)
+	, m_bEdgeTrigger			(FALSE)
+	, m_dwIoBytesBudget			(DEFAULT_IO_BYTES_BUDGET)
+	, m_dwIoTimeBudget			(DEFAULT_IO_TIME_BUDGET)
 	{
 		ASSERT(m_pListener);
+
+		m_ioDispatcher.SetMetrics(&m_metrics);
 	}
 
 	virtual ~CTcpServer()
@@ -261,12 +306,12 @@ private:
 	EnReuseAddressPolicy m_enReusePolicy;
 	EnSendPolicy m_enSendPolicy;
 	EnOnSendSyncPolicy m_enOnSendSyncPolicy;
+	EnOnSendNotifyPolicy m_enOnSendNotifyPolicy;
 	DWORD m_dwMaxConnectionCount;
 	DWORD m_dwWorkerThreadCount;
 	DWORD m_dwSocketListenQueue;
 	DWORD m_dwAcceptSocketCount;
 	DWORD m_dwSocketBufferSize;
-	DWORD m_dwFreeSocketObjLockTime;
 	DWORD m_dwFreeSocketObjPool;
 	DWORD m_dwFreeBufferObjPool;
 	DWORD m_dwFreeSocketObjHold;
@@ -274,6 +319,10 @@ private:
 	DWORD m_dwKeepAliveTime;
 	DWORD m_dwKeepAliveInterval;
 	BOOL  m_bMarkSilence;
+	BOOL  m_bBatchReceive;
+	BOOL  m_bEdgeTrigger;
+	DWORD m_dwIoBytesBudget;
+	DWORD m_dwIoTimeBudget;
 
 private:
 	CSEM				m_evWait;
@@ -294,5 +343,6 @@ private:
 	TSocketObjPtrQueue	m_lsGCSocket;
 	TReceiveBufferMap	m_rcBufferMap;
 
+	CIOMetrics			m_metrics;
 	CIODispatcher		m_ioDispatcher;
 };
@@ -58,7 +58,7 @@ void CUdpArqClient::OnWorkerThreadStart(THR_ID dwThreadID)
 {
 	m_arqBuffer.Malloc(m_arqAttr.dwMaxMessageSize);
 
-	m_pTimer = TimerPipe::Create(0, m_arqAttr.dwFlushInterval);
+	m_pTimer = TimerPipe::Create(0, m_arqAttr.GetTimerInterval());
 	SET_NONBLOCK_CLOEXEC(m_pTimer->GetReadFd());
 
 	m_arqTimer = m_pTimer->GetReadFd();
@@ -186,4 +186,9 @@ BOOL CUdpArqClient::GetWaitingSendMessageCount(int& iCount)
 	return (iCount >= 0);
 }
 
+BOOL CUdpArqClient::GetSessionStats(TArqSessionStats& stats)
+{
+	return m_arqSession.GetStats(stats);
+}
+
 #endif
@@ -66,6 +66,11 @@ public:
 	virtual void SetMaxTransUnit		(DWORD dwMaxTransUnit)		{ENSURE_HAS_STOPPED(); m_dwMtu						= dwMaxTransUnit;}
 	virtual void SetMaxMessageSize		(DWORD dwMaxMessageSize)	{ENSURE_HAS_STOPPED(); m_arqAttr.dwMaxMessageSize	= dwMaxMessageSize;}
 	virtual void SetHandShakeTimeout	(DWORD dwHandShakeTimeout)	{ENSURE_HAS_STOPPED(); m_arqAttr.dwHandShakeTimeout	= dwHandShakeTimeout;}
+	virtual void SetFlushDelay			(DWORD dwFlushDelay)		{ENSURE_HAS_STOPPED(); m_arqAttr.dwFlushDelay		= dwFlushDelay;}
+	virtual void SetFecDataShards		(DWORD dwDataShards)		{ENSURE_HAS_STOPPED(); m_arqAttr.dwFecDataShards	= dwDataShards;}
+	virtual void SetFecParityShards		(DWORD dwParityShards)		{ENSURE_HAS_STOPPED(); m_arqAttr.dwFecParityShards	= dwParityShards;}
+	virtual void SetCongestCtrl			(EnArqCongestCtrl enCongestCtrl)	{ENSURE_HAS_STOPPED(); m_arqAttr.enCongestCtrl	= enCongestCtrl;}
+	virtual void SetPacingRate			(DWORD dwPacingRate)		{ENSURE_HAS_STOPPED(); m_arqAttr.dwPacingRate		= dwPacingRate;}
 
 	virtual BOOL IsNoDelay				()	{return m_arqAttr.bNoDelay;}
 	virtual BOOL IsTurnoffCongestCtrl	()	{return m_arqAttr.bTurnoffNc;}
@@ -78,8 +83,14 @@ public:
 	virtual DWORD GetMaxTransUnit		()	{return m_arqAttr.dwMtu;}
 	virtual DWORD GetMaxMessageSize		()	{return m_arqAttr.dwMaxMessageSize;}
 	virtual DWORD GetHandShakeTimeout	()	{return m_arqAttr.dwHandShakeTimeout;}
+	virtual DWORD GetFlushDelay			()	{return m_arqAttr.dwFlushDelay;}
+	virtual DWORD GetFecDataShards		()	{return m_arqAttr.dwFecDataShards;}
+	virtual DWORD GetFecParityShards	()	{return m_arqAttr.dwFecParityShards;}
+	virtual EnArqCongestCtrl GetCongestCtrl()	{return m_arqAttr.enCongestCtrl;}
+	virtual DWORD GetPacingRate			()	{return m_arqAttr.dwPacingRate;}
 
 	virtual BOOL GetWaitingSendMessageCount	(int& iCount);
+	virtual BOOL GetSessionStats			(TArqSessionStats& stats);
 
 public:
 	const TArqAttr& GetArqAttribute		()	{return m_arqAttr;}
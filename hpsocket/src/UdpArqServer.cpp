@@ -46,11 +46,10 @@ void CUdpArqServer::PrepareStart()
 {
 	__super::PrepareStart();
 
-	m_ssPool.SetSessionLockTime(GetFreeSocketObjLockTime());
 	m_ssPool.SetSessionPoolSize(GetFreeSocketObjPool());
 	m_ssPool.SetSessionPoolHold(GetFreeSocketObjHold());
 
-	m_ssPool.Prepare();
+	m_ssPool.Prepare(GetMaxConnectionCount());
 }
 
 void CUdpArqServer::Reset()
@@ -75,6 +74,8 @@ void CUdpArqServer::OnWorkerThreadStart(THR_ID dwThreadID)
 
 BOOL CUdpArqServer::Send(CONNID dwConnID, const BYTE* pBuffer, int iLength, int iOffset)
 {
+	CEpochLock epochlock;
+
 	ASSERT(pBuffer && iLength > 0 && iLength <= (int)m_arqAttr.dwMaxMessageSize);
 
 	int result = NO_ERROR;
@@ -100,6 +101,8 @@ BOOL CUdpArqServer::Send(CONNID dwConnID, const BYTE* pBuffer, int iLength, int
 
 BOOL CUdpArqServer::SendPackets(CONNID dwConnID, const WSABUF pBuffers[], int iCount)
 {
+	CEpochLock epochlock;
+
 	ASSERT(pBuffers && iCount > 0);
 
 	if(!pBuffers || iCount <= 0)
@@ -209,8 +212,48 @@ EnHandleResult CUdpArqServer::FireClose(TUdpSocketObj* pSocketObj, EnSocketOpera
 	return result;
 }
 
+CONNID CUdpArqServer::ResolveConnectionID(const HP_SOCKADDR& addr, const BYTE* pData, int iLength)
+{
+	DWORD dwConvID = 0;
+
+	//KCP 数据包头为本端会话 ID，握手包的对端 ID 为本端会话 ID（首个握手包为 0）；
+	//启用 FEC 时 KCP 数据包位于 FEC 数据分片头及数据报长度之后，校验分片不含 KCP 数据包头（按地址查找）
+	if(iLength >= KCP_HEADER_SIZE)
+	{
+		if(!m_arqAttr.IsFecEnabled())
+			dwConvID = *((DWORD*)pData);
+		else if(iLength >= FEC_OVERHEAD + KCP_HEADER_SIZE && pData[5] == FEC_TYPE_DATA)
+			memcpy(&dwConvID, pData + FEC_OVERHEAD, sizeof(DWORD));
+	}
+	else if(iLength == TArqCmd::PACKAGE_LENGTH)
+	{
+		TArqCmd cmd;
+
+		if(cmd.Parse(pData))
+			dwConvID = cmd.peerID;
+	}
+
+	if(dwConvID != 0)
+	{
+		CArqSessionEx* pSession = m_ssPool.FindSession(dwConvID);
+
+		if(pSession != nullptr)
+		{
+			TUdpSocketObj* pSocketObj = pSession->GetSocket();
+
+			//旧版本对端填写的是其自身的会话 ID，需校验远端地址，不匹配时按地址查找
+			if(TUdpSocketObj::IsValid(pSocketObj) && pSocketObj->remoteAddr.EqualTo(addr))
+				return pSocketObj->connID;
+		}
+	}
+
+	return __super::ResolveConnectionID(addr, pData, iLength);
+}
+
 BOOL CUdpArqServer::GetWaitingSendMessageCount(CONNID dwConnID, int& iCount)
 {
+	CEpochLock epochlock;
+
 	TUdpSocketObj* pSocketObj = FindSocketObj(dwConnID);
 
 	if(!TUdpSocketObj::IsValid(pSocketObj))
@@ -233,4 +276,28 @@ BOOL CUdpArqServer::GetWaitingSendMessageCount(CONNID dwConnID, int& iCount)
 	return (iCount >= 0);
 }
 
+BOOL CUdpArqServer::GetSessionStats(CONNID dwConnID, TArqSessionStats& stats)
+{
+	CEpochLock epochlock;
+
+	TUdpSocketObj* pSocketObj = FindSocketObj(dwConnID);
+
+	if(!TUdpSocketObj::IsValid(pSocketObj))
+	{
+		::SetLastError(ERROR_OBJECT_NOT_FOUND);
+		return FALSE;
+	}
+
+	CArqSessionEx* pSession = nullptr;
+	GetConnectionReserved(pSocketObj, (PVOID*)&pSession);
+
+	if(pSession == nullptr)
+	{
+		::SetLastError(ERROR_OBJECT_NOT_FOUND);
+		return FALSE;
+	}
+
+	return pSession->GetStats(stats);
+}
+
 #endif
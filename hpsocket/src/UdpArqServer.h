@@ -50,6 +50,8 @@ protected:
 	virtual EnHandleResult FireReceive(TUdpSocketObj* pSocketObj, const BYTE* pData, int iLength);
 	virtual EnHandleResult FireClose(TUdpSocketObj* pSocketObj, EnSocketOperation enOperation, int iErrorCode);
 
+	virtual CONNID ResolveConnectionID(const HP_SOCKADDR& addr, const BYTE* pData, int iLength);
+
 	virtual BOOL CheckParams();
 	virtual void PrepareStart();
 	virtual void Reset();
@@ -67,6 +69,11 @@ public:
 	virtual void SetMaxTransUnit		(DWORD dwMaxTransUnit)		{ENSURE_HAS_STOPPED(); m_dwMtu						= dwMaxTransUnit;}
 	virtual void SetMaxMessageSize		(DWORD dwMaxMessageSize)	{ENSURE_HAS_STOPPED(); m_arqAttr.dwMaxMessageSize	= dwMaxMessageSize;}
 	virtual void SetHandShakeTimeout	(DWORD dwHandShakeTimeout)	{ENSURE_HAS_STOPPED(); m_arqAttr.dwHandShakeTimeout	= dwHandShakeTimeout;}
+	virtual void SetFlushDelay			(DWORD dwFlushDelay)		{ENSURE_HAS_STOPPED(); m_arqAttr.dwFlushDelay		= dwFlushDelay;}
+	virtual void SetFecDataShards		(DWORD dwDataShards)		{ENSURE_HAS_STOPPED(); m_arqAttr.dwFecDataShards	= dwDataShards;}
+	virtual void SetFecParityShards		(DWORD dwParityShards)		{ENSURE_HAS_STOPPED(); m_arqAttr.dwFecParityShards	= dwParityShards;}
+	virtual void SetCongestCtrl			(EnArqCongestCtrl enCongestCtrl)	{ENSURE_HAS_STOPPED(); m_arqAttr.enCongestCtrl	= enCongestCtrl;}
+	virtual void SetPacingRate			(DWORD dwPacingRate)		{ENSURE_HAS_STOPPED(); m_arqAttr.dwPacingRate		= dwPacingRate;}
 
 	virtual BOOL IsNoDelay				()	{return m_arqAttr.bNoDelay;}
 	virtual BOOL IsTurnoffCongestCtrl	()	{return m_arqAttr.bTurnoffNc;}
@@ -79,8 +86,14 @@ public:
 	virtual DWORD GetMaxTransUnit		()	{return m_arqAttr.dwMtu;}
 	virtual DWORD GetMaxMessageSize		()	{return m_arqAttr.dwMaxMessageSize;}
 	virtual DWORD GetHandShakeTimeout	()	{return m_arqAttr.dwHandShakeTimeout;}
+	virtual DWORD GetFlushDelay			()	{return m_arqAttr.dwFlushDelay;}
+	virtual DWORD GetFecDataShards		()	{return m_arqAttr.dwFecDataShards;}
+	virtual DWORD GetFecParityShards	()	{return m_arqAttr.dwFecParityShards;}
+	virtual EnArqCongestCtrl GetCongestCtrl()	{return m_arqAttr.enCongestCtrl;}
+	virtual DWORD GetPacingRate			()	{return m_arqAttr.dwPacingRate;}
 
 	virtual BOOL GetWaitingSendMessageCount	(CONNID dwConnID, int& iCount);
+	virtual BOOL GetSessionStats			(CONNID dwConnID, TArqSessionStats& stats);
 
 public:
 	const TArqAttr& GetArqAttribute		()	{return m_arqAttr;}
@@ -95,6 +95,8 @@ void CUdpCast::PrepareStart()
 	m_itPool.SetPoolHold(m_dwFreeBufferPoolHold);
 
 	m_itPool.Prepare();
+
+	m_metrics.Reset();
 }
 
 BOOL CUdpCast::CheckStarting()
@@ -204,7 +206,16 @@ BOOL CUdpCast::ConnectToGroup(const HP_SOCKADDR& bindAddr)
 
 	SetConnected();
 
-	if(TRIGGER(FireConnect()) == HR_ERROR)
+	m_metrics.Add(CIOMetrics::IMC_CONNECTS);
+
+	EnHandleResult rs;
+
+	{
+		CMetricsTimer timer(m_metrics);
+		rs = TRIGGER(FireConnect());
+	}
+
+	if(rs == HR_ERROR)
 	{
 		::WSASetLastError(ENSURE_ERROR_CANCELLED);
 		return FALSE;
@@ -225,7 +236,14 @@ BOOL CUdpCast::Stop()
 	SetConnected(FALSE);
 
 	if(m_ccContext.bFireOnClose)
-		FireClose(m_ccContext.enOperation, m_ccContext.iErrorCode);
+	{
+		{
+			CMetricsTimer timer(m_metrics);
+			FireClose(m_ccContext.enOperation, m_ccContext.iErrorCode);
+		}
+
+		m_metrics.Add(CIOMetrics::IMC_CLOSES);
+	}
 
 	if(m_soClient != INVALID_SOCKET)
 	{
@@ -310,6 +328,11 @@ UINT WINAPI CUdpCast::WorkerThreadProc(LPVOID pv)
 			goto EXIT_WORKER_THREAD;
 		}
 
+		CMetricsTimer looptimer(m_metrics, CIOMetrics::IMH_LOOP);
+
+		m_metrics.Add(CIOMetrics::IMC_LOOPS);
+		m_metrics.Add(CIOMetrics::IMC_IO_EVENTS, __builtin_popcount(rs));
+
 		for(int i = 0; i < size; i++)
 		{
 			if((1 << i) & rs)
@@ -420,6 +443,8 @@ BOOL CUdpCast::ReadData()
 		socklen_t addrLen = (socklen_t)m_remoteAddr.AddrSize();
 		int rc			  = (int)recvfrom(m_soClient, (char*)(BYTE*)m_rcBuffer, m_dwMaxDatagramSize, MSG_TRUNC, m_remoteAddr.Addr(), &addrLen);
 
+		m_metrics.OnRecv(rc);
+
 		if(rc >= 0)
 		{
 			if(rc > (int)m_dwMaxDatagramSize)
@@ -428,7 +453,14 @@ BOOL CUdpCast::ReadData()
 				return FALSE;
 			}
 
-			if(TRIGGER(FireReceive(m_rcBuffer, rc)) == HR_ERROR)
+			EnHandleResult rs;
+
+			{
+				CMetricsTimer timer(m_metrics);
+				rs = TRIGGER(FireReceive(m_rcBuffer, rc));
+			}
+
+			if(rs == HR_ERROR)
 			{
 				TRACE("<C-CNNID: %zu> OnReceive() event return 'HR_ERROR', connection will be closed !", m_dwConnID);
 
@@ -508,6 +540,8 @@ BOOL CUdpCast::DoSendData(TItem* pItem, BOOL& bBlocked)
 {
 	int rc = (int)sendto(m_soClient, (char*)pItem->Ptr(), pItem->Size(), 0, m_castAddr.Addr(), m_castAddr.AddrSize());
 
+	m_metrics.OnSend(rc);
+
 	if(rc >= 0)
 	{
 		ASSERT(rc == pItem->Size());
@@ -518,7 +552,14 @@ BOOL CUdpCast::DoSendData(TItem* pItem, BOOL& bBlocked)
 			m_lsSend.ReduceLength(1);
 		}
 
-		if(TRIGGER(FireSend(pItem->Ptr(), rc)) == HR_ERROR)
+		EnHandleResult rs;
+
+		{
+			CMetricsTimer timer(m_metrics);
+			rs = TRIGGER(FireSend(pItem->Ptr(), rc));
+		}
+
+		if(rs == HR_ERROR)
 		{
 			TRACE("<C-CNNID: %zu> OnSend() event should not return 'HR_ERROR' !!", m_dwConnID);
 			ASSERT(FALSE);
@@ -631,6 +672,8 @@ int CUdpCast::SendInternal(TItemPtr& itPtr)
 
 		m_lsSend.PushBack(itPtr.Detach());
 		if(iBufferSize == 0) m_lsSend.IncreaseLength(1);
+
+		m_metrics.OnSendRequest(m_lsSend.Length());
 	}
 
 	if(iPending == 0 && m_lsSend.Length() > 0) m_evSend.Set();
@@ -653,6 +696,30 @@ BOOL CUdpCast::GetLocalAddress(TCHAR lpszAddress[], int& iAddressLen, USHORT& us
 	return ::GetSocketLocalAddress(m_soClient, lpszAddress, iAddressLen, usPort);
 }
 
+BOOL CUdpCast::GetMetrics(TSocketMetrics& metrics)
+{
+	if(!HasStarted())
+	{
+		::SetLastError(ERROR_INVALID_STATE);
+		return FALSE;
+	}
+
+	::GetSocketMetrics(m_metrics, metrics, IsConnected() ? 1 : 0);
+	::AddHeapMetrics(metrics, m_itPool.GetPrivateHeap());
+
+	return TRUE;
+}
+
+BOOL CUdpCast::GetMetricsText(LPSTR lpszBuffer, int& iLength, LPCSTR lpszPrefix)
+{
+	TSocketMetrics metrics;
+
+	if(!GetMetrics(metrics))
+		return FALSE;
+
+	return ::FormatMetricsText(metrics, lpszBuffer, iLength, lpszPrefix);
+}
+
 void CUdpCast::SetRemoteHost(LPCTSTR lpszHost, USHORT usPort)
 {
 	m_strHost = lpszHost;
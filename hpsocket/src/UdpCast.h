@@ -70,6 +70,11 @@ public:
 	virtual BOOL IsMultiCastLoop		()	{return m_bMCLoop;}
 	virtual PVOID GetExtra				()	{return m_pExtra;}
 
+	virtual void SetCollectMetrics	(BOOL bCollectMetrics)	{m_metrics.SetEnabled(bCollectMetrics);}
+	virtual BOOL IsCollectMetrics	()						{return m_metrics.IsEnabled();}
+	virtual BOOL GetMetrics			(TSocketMetrics& metrics);
+	virtual BOOL GetMetricsText		(LPSTR lpszBuffer, int& iLength, LPCSTR lpszPrefix = nullptr);
+
 	virtual BOOL GetRemoteAddress(TCHAR lpszAddress[], int& iAddressLen, USHORT& usPort)
 	{
 		ADDRESS_FAMILY usFamily;
@@ -213,6 +218,8 @@ private:
 
 	volatile BOOL		m_bPaused;
 
+	CIOMetrics			m_metrics;
+
 	CThread<CUdpCast, VOID, UINT> m_thWorker;
 };
 
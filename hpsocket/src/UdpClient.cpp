@@ -90,6 +90,8 @@ void CUdpClient::PrepareStart()
 	m_itPool.SetPoolHold(m_dwFreeBufferPoolHold);
 
 	m_itPool.Prepare();
+
+	m_metrics.Reset();
 }
 
 BOOL CUdpClient::CheckStarting()
@@ -200,7 +202,16 @@ BOOL CUdpClient::ConnectToServer(const HP_SOCKADDR& addrRemote, BOOL bAsyncConne
 
 			SetConnected();
 
-			if(TRIGGER(FireConnect()) == HR_ERROR)
+			m_metrics.Add(CIOMetrics::IMC_CONNECTS);
+
+			EnHandleResult rs;
+
+			{
+				CMetricsTimer timer(m_metrics);
+				rs = TRIGGER(FireConnect());
+			}
+
+			if(rs == HR_ERROR)
 				::WSASetLastError(ENSURE_ERROR_CANCELLED);
 			else
 			{
@@ -225,7 +236,14 @@ BOOL CUdpClient::Stop()
 	CheckConnected();
 
 	if(m_ccContext.bFireOnClose)
-		FireClose(m_ccContext.enOperation, m_ccContext.iErrorCode);
+	{
+		{
+			CMetricsTimer timer(m_metrics);
+			FireClose(m_ccContext.enOperation, m_ccContext.iErrorCode);
+		}
+
+		m_metrics.Add(CIOMetrics::IMC_CLOSES);
+	}
 
 	if(m_soClient != INVALID_SOCKET)
 	{
@@ -343,6 +361,11 @@ UINT WINAPI CUdpClient::WorkerThreadProc(LPVOID pv)
 			goto EXIT_WORKER_THREAD;
 		}
 
+		CMetricsTimer looptimer(m_metrics, CIOMetrics::IMH_LOOP);
+
+		m_metrics.Add(CIOMetrics::IMC_LOOPS);
+		m_metrics.Add(CIOMetrics::IMC_IO_EVENTS, __builtin_popcount(rs));
+
 		for(DWORD i = 0; i < dwSize; i++)
 		{
 			if((1 << i) & rs)
@@ -487,7 +510,16 @@ BOOL CUdpClient::HandleConnect(SHORT events)
 
 	SetConnected();
 
-	if(TRIGGER(FireConnect()) != HR_ERROR)
+	m_metrics.Add(CIOMetrics::IMC_CONNECTS);
+
+	EnHandleResult rs;
+
+	{
+		CMetricsTimer timer(m_metrics);
+		rs = TRIGGER(FireConnect());
+	}
+
+	if(rs != HR_ERROR)
 		VERIFY(DetectConnection());
 	else
 	{
@@ -533,6 +565,8 @@ BOOL CUdpClient::ReadData()
 
 		int rc = (int)recv(m_soClient, (char*)(BYTE*)m_rcBuffer, m_dwMaxDatagramSize, MSG_TRUNC);
 
+		m_metrics.OnRecv(rc);
+
 		if(rc > 0)
 		{
 			m_dwDetectFails = 0;
@@ -549,7 +583,14 @@ BOOL CUdpClient::ReadData()
 				return FALSE;
 			}
 
-			if(TRIGGER(FireReceive(m_rcBuffer, rc)) == HR_ERROR)
+			EnHandleResult rs;
+
+			{
+				CMetricsTimer timer(m_metrics);
+				rs = TRIGGER(FireReceive(m_rcBuffer, rc));
+			}
+
+			if(rs == HR_ERROR)
 			{
 				TRACE("<C-CNNID: %zu> OnReceive() event return 'HR_ERROR', connection will be closed !", m_dwConnID);
 
@@ -636,11 +677,20 @@ BOOL CUdpClient::DoSendData(TItem* pItem, BOOL& bBlocked)
 {
 	int rc = (int)send(m_soClient, (char*)pItem->Ptr(), pItem->Size(), 0);
 
+	m_metrics.OnSend(rc);
+
 	if(rc > 0)
 	{
 		ASSERT(rc == pItem->Size());
 
-		if(TRIGGER(FireSend(pItem->Ptr(), rc)) == HR_ERROR)
+		EnHandleResult rs;
+
+		{
+			CMetricsTimer timer(m_metrics);
+			rs = TRIGGER(FireSend(pItem->Ptr(), rc));
+		}
+
+		if(rs == HR_ERROR)
 		{
 			TRACE("<C-CNNID: %zu> OnSend() event should not return 'HR_ERROR' !!", m_dwConnID);
 			ASSERT(FALSE);
@@ -750,6 +800,8 @@ int CUdpClient::SendInternal(TItemPtr& itPtr)
 		iPending = m_lsSend.Length();
 
 		m_lsSend.PushBack(itPtr.Detach());
+
+		m_metrics.OnSendRequest(m_lsSend.Length());
 	}
 
 	if(iPending == 0 && m_lsSend.Length() > 0) m_evSend.Set();
@@ -772,6 +824,30 @@ BOOL CUdpClient::GetLocalAddress(TCHAR lpszAddress[], int& iAddressLen, USHORT&
 	return ::GetSocketLocalAddress(m_soClient, lpszAddress, iAddressLen, usPort);
 }
 
+BOOL CUdpClient::GetMetrics(TSocketMetrics& metrics)
+{
+	if(!HasStarted())
+	{
+		::SetLastError(ERROR_INVALID_STATE);
+		return FALSE;
+	}
+
+	::GetSocketMetrics(m_metrics, metrics, IsConnected() ? 1 : 0);
+	::AddHeapMetrics(metrics, m_itPool.GetPrivateHeap());
+
+	return TRUE;
+}
+
+BOOL CUdpClient::GetMetricsText(LPSTR lpszBuffer, int& iLength, LPCSTR lpszPrefix)
+{
+	TSocketMetrics metrics;
+
+	if(!GetMetrics(metrics))
+		return FALSE;
+
+	return ::FormatMetricsText(metrics, lpszBuffer, iLength, lpszPrefix);
+}
+
 void CUdpClient::SetRemoteHost(LPCTSTR lpszHost, USHORT usPort)
 {
 	m_strHost = lpszHost;
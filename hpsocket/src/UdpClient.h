@@ -70,6 +70,11 @@ public:
 	virtual DWORD GetFreeBufferPoolHold	()	{return m_dwFreeBufferPoolHold;}
 	virtual PVOID GetExtra				()	{return m_pExtra;}
 
+	virtual void SetCollectMetrics	(BOOL bCollectMetrics)	{m_metrics.SetEnabled(bCollectMetrics);}
+	virtual BOOL IsCollectMetrics	()						{return m_metrics.IsEnabled();}
+	virtual BOOL GetMetrics			(TSocketMetrics& metrics);
+	virtual BOOL GetMetricsText		(LPSTR lpszBuffer, int& iLength, LPCSTR lpszPrefix = nullptr);
+
 protected:
 	virtual EnHandleResult FirePrepareConnect(SOCKET socket)
 		{return DoFirePrepareConnect(this, socket);}
@@ -232,6 +237,8 @@ private:
 	DWORD				m_dwDetectFails;
 	volatile BOOL		m_bPaused;
 
+	CIOMetrics			m_metrics;
+
 	CThread<CUdpClient, VOID, UINT> m_thWorker;
 };
 
@@ -85,6 +85,8 @@ void CUdpNode::PrepareStart()
 	m_bfObjPool.SetPoolHold(m_dwFreeBufferPoolHold);
 
 	m_bfObjPool.Prepare();
+
+	m_metrics.Reset();
 }
 
 BOOL CUdpNode::CreateListenSocket(LPCTSTR lpszBindAddress, USHORT usPort, LPCTSTR lpszCastAddress)
@@ -433,6 +435,8 @@ int CUdpNode::SendInternal(HP_SOCKADDR& addrRemote, TNodeBufferObjPtr& bufPtr)
 
 		m_sndBuff.PushBack(bufPtr.Detach());
 		if(iBufferSize == 0) m_sndBuff.IncreaseLength(1);
+
+		m_metrics.OnSendRequest(m_sndBuff.Length());
 	}
 
 	if(!bPending && IsPending())
@@ -520,6 +524,8 @@ BOOL CUdpNode::HandleReceive(int flag)
 
 		int rc = (int)recvfrom(m_soListen, itPtr->Ptr(), iBufferLen, MSG_TRUNC, itPtr->remoteAddr.Addr(), &dwAddrLen);
 
+		m_metrics.OnRecv(rc);
+
 		if(rc >= 0)
 		{
 			if(rc > iBufferLen)
@@ -558,6 +564,12 @@ VOID CUdpNode::HandleCmdReceive(int flag)
 	if(m_recvQueue.IsEmpty())
 		return;
 
+	if(m_bBatchReceive)
+	{
+		HandleCmdReceiveBatch(flag);
+		return;
+	}
+
 	int reads = flag ? -1 : MAX_CONTINUE_READS;
 
 	for(int i = 0; i < reads || reads < 0; i++)
@@ -567,6 +579,7 @@ VOID CUdpNode::HandleCmdReceive(int flag)
 		if(!m_recvQueue.PopFront(&itPtr.PtrRef()))
 			break;
 
+		CMetricsTimer timer(m_metrics);
 		TRIGGER(FireReceive(itPtr));
 	}
 
@@ -574,6 +587,49 @@ VOID CUdpNode::HandleCmdReceive(int flag)
 		VERIFY(m_ioDispatcher.SendCommand(DISP_CMD_RECEIVE, flag));
 }
 
+VOID CUdpNode::HandleCmdReceiveBatch(int flag)
+{
+	TNodeBufferObj* pBufferObjs[MAX_CONTINUE_READS];
+	TUdpDatagram datagrams[MAX_CONTINUE_READS];
+	TCHAR szAddress[MAX_CONTINUE_READS][50];
+
+	do
+	{
+		int iCount = 0;
+
+		while(iCount < MAX_CONTINUE_READS && m_recvQueue.PopFront(&pBufferObjs[iCount]))
+		{
+			TNodeBufferObj* pBufferObj	= pBufferObjs[iCount];
+			TUdpDatagram& datagram		= datagrams[iCount];
+			int iAddressLen				= sizeof(szAddress[iCount]) / sizeof(TCHAR);
+			ADDRESS_FAMILY usFamily;
+
+			::sockaddr_IN_2_A(pBufferObj->remoteAddr, usFamily, szAddress[iCount], iAddressLen, datagram.port);
+
+			datagram.address	= szAddress[iCount];
+			datagram.buffer.buf	= pBufferObj->Ptr();
+			datagram.buffer.len	= pBufferObj->Size();
+
+			++iCount;
+		}
+
+		if(iCount == 0)
+			break;
+
+		{
+			CMetricsTimer timer(m_metrics);
+			TRIGGER(FireReceive(datagrams, iCount));
+		}
+
+		for(int i = 0; i < iCount; i++)
+			m_bfObjPool.PutFreeItem(pBufferObjs[i]);
+
+	} while(flag);
+
+	if(!m_recvQueue.IsEmpty())
+		VERIFY(m_ioDispatcher.SendCommand(DISP_CMD_RECEIVE, flag));
+}
+
 BOOL CUdpNode::HandleSend(int flag, int rd)
 {
     m_ioDispatcher.CtlFD(m_soListen, EV_ADD | EV_CLEAR | EV_ENABLE | EV_DISPATCH, EVFILT_READ, &m_soListen);
@@ -626,6 +682,8 @@ BOOL CUdpNode::SendItem(TNodeBufferObj* pBufferObj, BOOL& bBlocked)
 {
 	int rc = (int)sendto(m_soListen, pBufferObj->Ptr(), pBufferObj->Size(), 0, pBufferObj->remoteAddr.Addr(), pBufferObj->remoteAddr.AddrSize());
 
+	m_metrics.OnSend(rc);
+
 	if(rc >= 0)
 	{
 		ASSERT(rc == pBufferObj->Size());
@@ -636,6 +694,7 @@ BOOL CUdpNode::SendItem(TNodeBufferObj* pBufferObj, BOOL& bBlocked)
 			m_sndBuff.ReduceLength(1);
 		}
 
+		CMetricsTimer timer(m_metrics);
 		TRIGGER(FireSend(pBufferObj));
 	}
 	else if(rc == SOCKET_ERROR)
@@ -661,6 +720,52 @@ BOOL CUdpNode::GetLocalAddress(TCHAR lpszAddress[], int& iAddressLen, USHORT& us
 	return ::sockaddr_IN_2_A(m_localAddr, usFamily, lpszAddress, iAddressLen, usPort);
 }
 
+BOOL CUdpNode::GetMetrics(TSocketMetrics& metrics)
+{
+	if(!HasStarted())
+	{
+		::SetLastError(ERROR_INVALID_STATE);
+		return FALSE;
+	}
+
+	::GetSocketMetrics(m_metrics, metrics, 0, m_ioDispatcher.GetCommandQueueSize());
+	::AddHeapMetrics(metrics, m_bfObjPool.GetPrivateHeap());
+
+	return TRUE;
+}
+
+BOOL CUdpNode::GetMetricsText(LPSTR lpszBuffer, int& iLength, LPCSTR lpszPrefix)
+{
+	TSocketMetrics metrics;
+
+	if(!GetMetrics(metrics))
+		return FALSE;
+
+	return ::FormatMetricsText(metrics, lpszBuffer, iLength, lpszPrefix);
+}
+
+BOOL CUdpNode::GetWorkerTraceStats(TWorkerTraceStat stats[], DWORD& dwCount)
+{
+	if(!HasStarted())
+	{
+		::SetLastError(ERROR_INVALID_STATE);
+		return FALSE;
+	}
+
+	return ::GetWorkerTraceStats(m_ioDispatcher.GetLoopTracer(), stats, dwCount);
+}
+
+BOOL CUdpNode::GetSlowCallbacks(TSlowCallback records[], DWORD& dwCount)
+{
+	if(!HasStarted())
+	{
+		::SetLastError(ERROR_INVALID_STATE);
+		return FALSE;
+	}
+
+	return ::GetSlowCallbacks(m_ioDispatcher.GetLoopTracer(), records, dwCount);
+}
+
 BOOL CUdpNode::GetCastAddress(TCHAR lpszAddress[], int& iAddressLen, USHORT& usPort)
 {
 	ADDRESS_FAMILY usFamily;
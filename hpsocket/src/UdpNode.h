@@ -69,6 +69,7 @@ public:
 	virtual void SetMaxDatagramSize		(DWORD dwMaxDatagramSize)			{ENSURE_HAS_STOPPED(); m_dwMaxDatagramSize		= dwMaxDatagramSize;}
 	virtual void SetMultiCastTtl		(int iMCTtl)						{ENSURE_HAS_STOPPED(); m_iMCTtl					= iMCTtl;}
 	virtual void SetMultiCastLoop		(BOOL bMCLoop)						{ENSURE_HAS_STOPPED(); m_bMCLoop				= bMCLoop;}
+	virtual void SetBatchReceive		(BOOL bBatchReceive)				{ENSURE_HAS_STOPPED(); m_bBatchReceive			= bBatchReceive;}
 	virtual void SetExtra				(PVOID pExtra)						{m_pExtra										= pExtra;}						
 
 	virtual EnReuseAddressPolicy GetReuseAddressPolicy	()	{return m_enReusePolicy;}
@@ -78,8 +79,19 @@ public:
 	virtual DWORD GetPostReceiveCount	()	{return m_dwPostReceiveCount;}
 	virtual DWORD GetMaxDatagramSize	()	{return m_dwMaxDatagramSize;}
 	virtual EnCastMode GetCastMode		()	{return m_enCastMode;}
+
+	virtual void SetCollectMetrics	(BOOL bCollectMetrics)	{m_metrics.SetEnabled(bCollectMetrics);}
+	virtual BOOL IsCollectMetrics	()						{return m_metrics.IsEnabled();}
+	virtual BOOL GetMetrics			(TSocketMetrics& metrics);
+	virtual BOOL GetMetricsText		(LPSTR lpszBuffer, int& iLength, LPCSTR lpszPrefix = nullptr);
+
+	virtual void SetSlowCallbackThreshold	(DWORD dwSlowCallbackThreshold)	{m_ioDispatcher.GetLoopTracer().SetSlowThreshold(dwSlowCallbackThreshold * 1000ull);}
+	virtual DWORD GetSlowCallbackThreshold	()								{return (DWORD)(m_ioDispatcher.GetLoopTracer().GetSlowThreshold() / 1000);}
+	virtual BOOL GetWorkerTraceStats		(TWorkerTraceStat stats[], DWORD& dwCount);
+	virtual BOOL GetSlowCallbacks			(TSlowCallback records[], DWORD& dwCount);
 	virtual int GetMultiCastTtl			()	{return m_iMCTtl;}
 	virtual BOOL IsMultiCastLoop		()	{return m_bMCLoop;}
+	virtual BOOL IsBatchReceive			()	{return m_bBatchReceive;}
 	virtual PVOID GetExtra				()	{return m_pExtra;}
 
 protected:
@@ -90,6 +102,8 @@ protected:
 
 	EnHandleResult FireSend(TNodeBufferObj* pBufferObj);
 	EnHandleResult FireReceive(TNodeBufferObj* pBufferObj);
+	EnHandleResult FireReceive(const TUdpDatagram pDatagrams[], int iCount)
+		{return m_pListener->OnReceiveBatch(this, pDatagrams, iCount);}
 	EnHandleResult FireError(TNodeBufferObj* pBufferObj, EnSocketOperation enOperation, int iErrorCode);
 
 	void SetLastError(EnSocketError code, LPCSTR func, int ec);
@@ -124,6 +138,7 @@ private:
 	BOOL HandleClose(TNodeBufferObj* pBufferObj, EnSocketOperation enOperation, int iErrorCode);
 
 	VOID HandleCmdReceive(int flag);
+	VOID HandleCmdReceiveBatch(int flag);
 	VOID HandleCmdSend(int flag);
 
 	BOOL SendItem(TNodeBufferObj* pBufferObj, BOOL& bBlocked);
@@ -149,11 +164,14 @@ public:
 	, m_pExtra					(nullptr)
 	, m_iMCTtl					(1)
 	, m_bMCLoop					(FALSE)
+	, m_bBatchReceive			(FALSE)
 	, m_enCastMode				(CM_UNICAST)
 	, m_castAddr				(AF_UNSPEC, TRUE)
 	, m_localAddr				(AF_UNSPEC, TRUE)
 	{
 		ASSERT(m_pListener);
+
+		m_ioDispatcher.SetMetrics(&m_metrics);
 	}
 
 	virtual ~CUdpNode()
@@ -172,6 +190,7 @@ private:
 
 	int					m_iMCTtl;
 	BOOL				m_bMCLoop;
+	BOOL				m_bBatchReceive;
 	EnCastMode			m_enCastMode;
 
 private:
@@ -193,6 +212,7 @@ private:
 
 	volatile long		m_iSending;
 
+	CIOMetrics			m_metrics;
 	CIODispatcher		m_ioDispatcher;
 };
 
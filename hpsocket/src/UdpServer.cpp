@@ -27,6 +27,9 @@
 
 EnHandleResult CUdpServer::TriggerFireAccept(TUdpSocketObj* pSocketObj)
 {
+	m_metrics.Add(CIOMetrics::IMC_CONNECTS);
+
+	CMetricsTimer timer(m_metrics);
 	EnHandleResult rs = TRIGGER(FireAccept(pSocketObj));
 
 	return rs;
@@ -62,9 +65,9 @@ BOOL CUdpServer::CheckParams()
 {
 	if	((m_enSendPolicy >= SP_PACK && m_enSendPolicy <= SP_DIRECT)								&&
 		(m_enOnSendSyncPolicy >= OSSP_NONE && m_enOnSendSyncPolicy <= OSSP_CLOSE)				&&
+		(m_enOnSendNotifyPolicy >= OSNP_EACH && m_enOnSendNotifyPolicy <= OSNP_NONE)			&&
 		((int)m_dwMaxConnectionCount > 0 && m_dwMaxConnectionCount <= MAX_CONNECTION_COUNT)		&&
 		((int)m_dwWorkerThreadCount > 0 && m_dwWorkerThreadCount <= MAX_WORKER_THREAD_COUNT)	&&
-		((int)m_dwFreeSocketObjLockTime >= 1000)												&&
 		((int)m_dwFreeSocketObjPool >= 0)														&&
 		((int)m_dwFreeBufferObjPool >= 0)														&&
 		((int)m_dwFreeSocketObjHold >= 0)														&&
@@ -89,6 +92,8 @@ void CUdpServer::PrepareStart()
 	m_bfObjPool.SetPoolHold(m_dwFreeBufferObjHold);
 
 	m_bfObjPool.Prepare();
+
+	m_metrics.Reset();
 }
 
 BOOL CUdpServer::CheckStarting()
@@ -198,6 +203,8 @@ BOOL CUdpServer::Stop()
 
 void CUdpServer::SendCloseNotify()
 {
+	CEpochLock epochlock;
+
 	if(m_soListen == INVALID_SOCKET)
 		return;
 
@@ -285,7 +292,7 @@ TUdpSocketObj* CUdpServer::GetFreeSocketObj(CONNID dwConnID)
 
 	if(m_lsFreeSocket.TryLock(&pSocketObj, dwIndex))
 	{
-		if(::GetTimeGap32(pSocketObj->freeTime) >= m_dwFreeSocketObjLockTime)
+		if(CEpochDomain::IsReclaimable(pSocketObj->freeEpoch))
 			VERIFY(m_lsFreeSocket.ReleaseLock(nullptr, dwIndex));
 		else
 		{
@@ -335,7 +342,7 @@ void CUdpServer::AddFreeSocketObj(TUdpSocketObj* pSocketObj, EnSocketCloseFlag e
 
 void CUdpServer::ReleaseGCSocketObj(BOOL bForce)
 {
-	::ReleaseGCObj(m_lsGCSocket, m_dwFreeSocketObjLockTime, bForce);
+	::ReleaseGCObj(m_lsGCSocket, bForce);
 }
 
 BOOL CUdpServer::InvalidSocketObj(TUdpSocketObj* pSocketObj)
@@ -393,10 +400,16 @@ void CUdpServer::CloseClientSocketObj(TUdpSocketObj* pSocketObj, EnSocketCloseFl
 	if(bNotify && m_soListen != INVALID_SOCKET)
 		::SendUdpCloseNotify(m_soListen, pSocketObj->remoteAddr);
 
-	if(enFlag == SCF_CLOSE)
-		FireClose(pSocketObj, SO_CLOSE, SE_OK);
-	else if(enFlag == SCF_ERROR)
-		FireClose(pSocketObj, enOperation, iErrorCode);
+	{
+		CMetricsTimer timer(m_metrics);
+
+		if(enFlag == SCF_CLOSE)
+			FireClose(pSocketObj, SO_CLOSE, SE_OK);
+		else if(enFlag == SCF_ERROR)
+			FireClose(pSocketObj, enOperation, iErrorCode);
+	}
+
+	m_metrics.Add(CIOMetrics::IMC_CLOSES);
 }
 
 BOOL CUdpServer::GetListenAddress(TCHAR lpszAddress[], int& iAddressLen, USHORT& usPort)
@@ -408,6 +421,8 @@ BOOL CUdpServer::GetListenAddress(TCHAR lpszAddress[], int& iAddressLen, USHORT&
 
 BOOL CUdpServer::GetLocalAddress(CONNID dwConnID, TCHAR lpszAddress[], int& iAddressLen, USHORT& usPort)
 {
+	CEpochLock epochlock;
+
 	ASSERT(lpszAddress != nullptr && iAddressLen > 0);
 
 	TUdpSocketObj* pSocketObj = FindSocketObj(dwConnID);
@@ -420,6 +435,8 @@ BOOL CUdpServer::GetLocalAddress(CONNID dwConnID, TCHAR lpszAddress[], int& iAdd
 
 BOOL CUdpServer::GetRemoteAddress(CONNID dwConnID, TCHAR lpszAddress[], int& iAddressLen, USHORT& usPort)
 {
+	CEpochLock epochlock;
+
 	ASSERT(lpszAddress != nullptr && iAddressLen > 0);
 
 	TUdpSocketObj* pSocketObj = FindSocketObj(dwConnID);
@@ -435,6 +452,8 @@ BOOL CUdpServer::GetRemoteAddress(CONNID dwConnID, TCHAR lpszAddress[], int& iAd
 
 BOOL CUdpServer::SetConnectionExtra(CONNID dwConnID, PVOID pExtra)
 {
+	CEpochLock epochlock;
+
 	TUdpSocketObj* pSocketObj = FindSocketObj(dwConnID);
 	return SetConnectionExtra(pSocketObj, pExtra);
 }
@@ -452,6 +471,8 @@ BOOL CUdpServer::SetConnectionExtra(TUdpSocketObj* pSocketObj, PVOID pExtra)
 
 BOOL CUdpServer::GetConnectionExtra(CONNID dwConnID, PVOID* ppExtra)
 {
+	CEpochLock epochlock;
+
 	TUdpSocketObj* pSocketObj = FindSocketObj(dwConnID);
 	return GetConnectionExtra(pSocketObj, ppExtra);
 }
@@ -471,6 +492,8 @@ BOOL CUdpServer::GetConnectionExtra(TUdpSocketObj* pSocketObj, PVOID* ppExtra)
 
 BOOL CUdpServer::SetConnectionReserved(CONNID dwConnID, PVOID pReserved)
 {
+	CEpochLock epochlock;
+
 	TUdpSocketObj* pSocketObj = FindSocketObj(dwConnID);
 	return SetConnectionReserved(pSocketObj, pReserved);
 }
@@ -488,6 +511,8 @@ BOOL CUdpServer::SetConnectionReserved(TUdpSocketObj* pSocketObj, PVOID pReserve
 
 BOOL CUdpServer::GetConnectionReserved(CONNID dwConnID, PVOID* ppReserved)
 {
+	CEpochLock epochlock;
+
 	TUdpSocketObj* pSocketObj = FindSocketObj(dwConnID);
 	return GetConnectionReserved(pSocketObj, ppReserved);
 }
@@ -507,6 +532,8 @@ BOOL CUdpServer::GetConnectionReserved(TUdpSocketObj* pSocketObj, PVOID* ppReser
 
 BOOL CUdpServer::SetConnectionReserved2(CONNID dwConnID, PVOID pReserved2)
 {
+	CEpochLock epochlock;
+
 	TUdpSocketObj* pSocketObj = FindSocketObj(dwConnID);
 	return SetConnectionReserved2(pSocketObj, pReserved2);
 }
@@ -524,6 +551,8 @@ BOOL CUdpServer::SetConnectionReserved2(TUdpSocketObj* pSocketObj, PVOID pReserv
 
 BOOL CUdpServer::GetConnectionReserved2(CONNID dwConnID, PVOID* ppReserved2)
 {
+	CEpochLock epochlock;
+
 	TUdpSocketObj* pSocketObj = FindSocketObj(dwConnID);
 	return GetConnectionReserved2(pSocketObj, ppReserved2);
 }
@@ -552,6 +581,8 @@ BOOL CUdpServer::IsPauseReceive(CONNID dwConnID, BOOL& bPaused)
 
 BOOL CUdpServer::IsConnected(CONNID dwConnID)
 {
+	CEpochLock epochlock;
+
 	TUdpSocketObj* pSocketObj = FindSocketObj(dwConnID);
 
 	if(TUdpSocketObj::IsValid(pSocketObj))
@@ -562,6 +593,8 @@ BOOL CUdpServer::IsConnected(CONNID dwConnID)
 
 BOOL CUdpServer::GetPendingDataLength(CONNID dwConnID, int& iPending)
 {
+	CEpochLock epochlock;
+
 	TUdpSocketObj* pSocketObj = FindSocketObj(dwConnID);
 
 	if(TUdpSocketObj::IsValid(pSocketObj))
@@ -578,6 +611,53 @@ DWORD CUdpServer::GetConnectionCount()
 	return m_bfActiveSockets.Elements();
 }
 
+BOOL CUdpServer::GetMetrics(TSocketMetrics& metrics)
+{
+	if(!HasStarted())
+	{
+		::SetLastError(ERROR_INVALID_STATE);
+		return FALSE;
+	}
+
+	::GetSocketMetrics(m_metrics, metrics, GetConnectionCount(), m_ioDispatcher.GetCommandQueueSize());
+	::AddHeapMetrics(metrics, m_phSocket);
+	::AddHeapMetrics(metrics, m_bfObjPool.GetPrivateHeap());
+
+	return TRUE;
+}
+
+BOOL CUdpServer::GetMetricsText(LPSTR lpszBuffer, int& iLength, LPCSTR lpszPrefix)
+{
+	TSocketMetrics metrics;
+
+	if(!GetMetrics(metrics))
+		return FALSE;
+
+	return ::FormatMetricsText(metrics, lpszBuffer, iLength, lpszPrefix);
+}
+
+BOOL CUdpServer::GetWorkerTraceStats(TWorkerTraceStat stats[], DWORD& dwCount)
+{
+	if(!HasStarted())
+	{
+		::SetLastError(ERROR_INVALID_STATE);
+		return FALSE;
+	}
+
+	return ::GetWorkerTraceStats(m_ioDispatcher.GetLoopTracer(), stats, dwCount);
+}
+
+BOOL CUdpServer::GetSlowCallbacks(TSlowCallback records[], DWORD& dwCount)
+{
+	if(!HasStarted())
+	{
+		::SetLastError(ERROR_INVALID_STATE);
+		return FALSE;
+	}
+
+	return ::GetSlowCallbacks(m_ioDispatcher.GetLoopTracer(), records, dwCount);
+}
+
 BOOL CUdpServer::GetAllConnectionIDs(CONNID pIDs[], DWORD& dwCount)
 {
 	return m_bfActiveSockets.GetAllElementIndexes(pIDs, dwCount);
@@ -585,6 +665,8 @@ BOOL CUdpServer::GetAllConnectionIDs(CONNID pIDs[], DWORD& dwCount)
 
 BOOL CUdpServer::GetConnectPeriod(CONNID dwConnID, DWORD& dwPeriod)
 {
+	CEpochLock epochlock;
+
 	BOOL isOK					= TRUE;
 	TUdpSocketObj* pSocketObj	= FindSocketObj(dwConnID);
 
@@ -598,6 +680,8 @@ BOOL CUdpServer::GetConnectPeriod(CONNID dwConnID, DWORD& dwPeriod)
 
 BOOL CUdpServer::GetSilencePeriod(CONNID dwConnID, DWORD& dwPeriod)
 {
+	CEpochLock epochlock;
+
 	if(!m_bMarkSilence)
 		return FALSE;
 
@@ -614,6 +698,8 @@ BOOL CUdpServer::GetSilencePeriod(CONNID dwConnID, DWORD& dwPeriod)
 
 BOOL CUdpServer::Disconnect(CONNID dwConnID, BOOL bForce)
 {
+	CEpochLock epochlock;
+
 	TUdpSocketObj* pSocketObj = FindSocketObj(dwConnID);
 
 	if(!TUdpSocketObj::IsValid(pSocketObj))
@@ -627,6 +713,8 @@ BOOL CUdpServer::Disconnect(CONNID dwConnID, BOOL bForce)
 
 BOOL CUdpServer::DisconnectLongConnections(DWORD dwPeriod, BOOL bForce)
 {
+	CEpochLock epochlock;
+
 	if(dwPeriod > MAX_CONNECTION_PERIOD)
 		return FALSE;
 
@@ -648,6 +736,8 @@ BOOL CUdpServer::DisconnectLongConnections(DWORD dwPeriod, BOOL bForce)
 
 BOOL CUdpServer::DisconnectSilenceConnections(DWORD dwPeriod, BOOL bForce)
 {
+	CEpochLock epochlock;
+
 	if(!m_bMarkSilence)
 		return FALSE;
 	if(dwPeriod > MAX_CONNECTION_PERIOD)
@@ -787,9 +877,11 @@ BOOL CUdpServer::HandleReceive(int flag)
 		//接收用户数据报
 		int rc = (int)recvfrom(m_soListen, itPtr->Ptr(), iBufferLen, MSG_TRUNC, addr.Addr(), &dwAddrLen);
 
+		m_metrics.OnRecv(rc);
+
 		if(rc >= 0)
 		{
-			CONNID dwConnID = FindConnectionID(&addr);
+			CONNID dwConnID = ResolveConnectionID(addr, itPtr->Ptr(), MIN(rc, iBufferLen));
 			//表明该地址还不具有接收通信ID
 			if(dwConnID == 0)
 			{
@@ -945,7 +1037,14 @@ VOID CUdpServer::HandleCmdReceive(CONNID dwConnID, int flag)
 			if(!pSocketObj->recvQueue.PopFront(&itPtr.PtrRef()))
 				break;
 
-			if(TRIGGER(FireReceive(pSocketObj, itPtr->Ptr(), itPtr->Size())) == HR_ERROR)
+			EnHandleResult rs;
+
+			{
+				CMetricsTimer timer(m_metrics);
+				rs = TRIGGER(FireReceive(pSocketObj, itPtr->Ptr(), itPtr->Size()));
+			}
+
+			if(rs == HR_ERROR)
 			{
 				TRACE("<S-CNNID: %zu> OnReceive() event return 'HR_ERROR', connection will be closed !", dwConnID);
 
@@ -983,6 +1082,7 @@ VOID CUdpServer::HandleCmdSend(CONNID dwConnID, int flag)
 		return;
 
 	BOOL bBlocked	= FALSE;
+	int iSent		= 0;
 	int writes		= flag ? -1 : MAX_CONTINUE_WRITES;
 
 	TBufferObjList& sndBuff = pSocketObj->sndBuff;
@@ -1006,7 +1106,7 @@ VOID CUdpServer::HandleCmdSend(CONNID dwConnID, int flag)
 
 			ASSERT(!itPtr->IsEmpty());
 
-			if(!SendItem(pSocketObj, itPtr, bBlocked))
+			if(!SendItem(pSocketObj, itPtr, bBlocked, iSent))
 				return;
 
 			if(bBlocked)
@@ -1023,25 +1123,29 @@ VOID CUdpServer::HandleCmdSend(CONNID dwConnID, int flag)
 				break;
 			}
 		}
+
+		if(iSent > 0)
+			NotifySend(pSocketObj, nullptr, iSent);
 	}
 
 	if(!bBlocked && pSocketObj->IsPending())
 		VERIFY(m_ioDispatcher.SendCommand(DISP_CMD_SEND, dwConnID));
 }
 
-BOOL CUdpServer::SendItem(TUdpSocketObj* pSocketObj, TItem* pItem, BOOL& bBlocked)
+BOOL CUdpServer::SendItem(TUdpSocketObj* pSocketObj, TItem* pItem, BOOL& bBlocked, int& iSent)
 {
 	int rc = (int)sendto(m_soListen, pItem->Ptr(), pItem->Size(), 0, pSocketObj->remoteAddr.Addr(), pSocketObj->remoteAddr.AddrSize());
 
+	m_metrics.OnSend(rc);
+
 	if(rc > 0)
 	{
 		ASSERT(rc == pItem->Size());
 
-		if(TRIGGER(FireSend(pSocketObj, pItem->Ptr(), rc)) == HR_ERROR)
-		{
-			TRACE("<S-CNNID: %zu> OnSend() event should not return 'HR_ERROR' !!", pSocketObj->connID);
-			ASSERT(FALSE);
-		}
+		if(m_enOnSendNotifyPolicy == OSNP_EACH)
+			NotifySend(pSocketObj, pItem->Ptr(), rc);
+		else if(m_enOnSendNotifyPolicy == OSNP_BATCH)
+			iSent += rc;
 	}
 	else if(rc == SOCKET_ERROR)
 	{
@@ -1058,8 +1162,26 @@ BOOL CUdpServer::SendItem(TUdpSocketObj* pSocketObj, TItem* pItem, BOOL& bBlocke
 	return TRUE;
 }
 
+void CUdpServer::NotifySend(TUdpSocketObj* pSocketObj, const BYTE* pData, int iLength)
+{
+	EnHandleResult rs;
+
+	{
+		CMetricsTimer timer(m_metrics);
+		rs = TRIGGER(FireSend(pSocketObj, pData, iLength));
+	}
+
+	if(rs == HR_ERROR)
+	{
+		TRACE("<S-CNNID: %zu> OnSend() event should not return 'HR_ERROR' !!", pSocketObj->connID);
+		ASSERT(FALSE);
+	}
+}
+
 BOOL CUdpServer::Send(CONNID dwConnID, const BYTE* pBuffer, int iLength, int iOffset)
 {
+	CEpochLock epochlock;
+
 	ASSERT(pBuffer && iLength > 0 && iLength <= (int)m_dwMaxDatagramSize);
 
 	TUdpSocketObj* pSocketObj = FindSocketObj(dwConnID);
@@ -1096,6 +1218,8 @@ BOOL CUdpServer::DoSend(TUdpSocketObj* pSocketObj, const BYTE* pBuffer, int iLen
 
 BOOL CUdpServer::SendPackets(CONNID dwConnID, const WSABUF pBuffers[], int iCount)
 {
+	CEpochLock epochlock;
+
 	ASSERT(pBuffers && iCount > 0);
 
 	if(!pBuffers || iCount <= 0)
@@ -1158,6 +1282,8 @@ int CUdpServer::SendInternal(TUdpSocketObj* pSocketObj, TItemPtr& itPtr)
 		bPending = pSocketObj->IsPending();
 
 		pSocketObj->sndBuff.PushBack(itPtr.Detach());
+
+		m_metrics.OnSendRequest(pSocketObj->Pending());
 	}
 
 	if(!bPending)
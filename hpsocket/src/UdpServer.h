@@ -80,9 +80,9 @@ public:
 	virtual void SetReuseAddressPolicy		(EnReuseAddressPolicy enReusePolicy)	{ENSURE_HAS_STOPPED(); m_enReusePolicy		= enReusePolicy;}
 	virtual void SetSendPolicy				(EnSendPolicy enSendPolicy)				{ENSURE_HAS_STOPPED(); m_enSendPolicy		= enSendPolicy;}
 	virtual void SetOnSendSyncPolicy		(EnOnSendSyncPolicy enOnSendSyncPolicy)	{ENSURE_HAS_STOPPED(); m_enOnSendSyncPolicy	= enOnSendSyncPolicy;}
+	virtual void SetOnSendNotifyPolicy		(EnOnSendNotifyPolicy enOnSendNotifyPolicy)	{ENSURE_HAS_STOPPED(); m_enOnSendNotifyPolicy	= enOnSendNotifyPolicy;}
 	virtual void SetMaxConnectionCount		(DWORD dwMaxConnectionCount)	{ENSURE_HAS_STOPPED(); m_dwMaxConnectionCount		= dwMaxConnectionCount;}
 	virtual void SetWorkerThreadCount		(DWORD dwWorkerThreadCount)		{ENSURE_HAS_STOPPED(); m_dwWorkerThreadCount		= dwWorkerThreadCount;}
-	virtual void SetFreeSocketObjLockTime	(DWORD dwFreeSocketObjLockTime)	{ENSURE_HAS_STOPPED(); m_dwFreeSocketObjLockTime	= dwFreeSocketObjLockTime;}
 	virtual void SetFreeSocketObjPool		(DWORD dwFreeSocketObjPool)		{ENSURE_HAS_STOPPED(); m_dwFreeSocketObjPool		= dwFreeSocketObjPool;}
 	virtual void SetFreeBufferObjPool		(DWORD dwFreeBufferObjPool)		{ENSURE_HAS_STOPPED(); m_dwFreeBufferObjPool		= dwFreeBufferObjPool;}
 	virtual void SetFreeSocketObjHold		(DWORD dwFreeSocketObjHold)		{ENSURE_HAS_STOPPED(); m_dwFreeSocketObjHold		= dwFreeSocketObjHold;}
@@ -96,9 +96,9 @@ public:
 	virtual EnReuseAddressPolicy GetReuseAddressPolicy	()	{return m_enReusePolicy;}
 	virtual EnSendPolicy GetSendPolicy					()	{return m_enSendPolicy;}
 	virtual EnOnSendSyncPolicy GetOnSendSyncPolicy		()	{return m_enOnSendSyncPolicy;}
+	virtual EnOnSendNotifyPolicy GetOnSendNotifyPolicy	()	{return m_enOnSendNotifyPolicy;}
 	virtual DWORD GetMaxConnectionCount		()	{return m_dwMaxConnectionCount;}
 	virtual DWORD GetWorkerThreadCount		()	{return m_dwWorkerThreadCount;}
-	virtual DWORD GetFreeSocketObjLockTime	()	{return m_dwFreeSocketObjLockTime;}
 	virtual DWORD GetFreeSocketObjPool		()	{return m_dwFreeSocketObjPool;}
 	virtual DWORD GetFreeBufferObjPool		()	{return m_dwFreeBufferObjPool;}
 	virtual DWORD GetFreeSocketObjHold		()	{return m_dwFreeSocketObjHold;}
@@ -109,6 +109,16 @@ public:
 	virtual DWORD GetDetectInterval			()	{return m_dwDetectInterval;}
 	virtual BOOL  IsMarkSilence				()	{return m_bMarkSilence;}
 
+	virtual void SetCollectMetrics	(BOOL bCollectMetrics)	{m_metrics.SetEnabled(bCollectMetrics);}
+	virtual BOOL IsCollectMetrics	()						{return m_metrics.IsEnabled();}
+	virtual BOOL GetMetrics			(TSocketMetrics& metrics);
+	virtual BOOL GetMetricsText		(LPSTR lpszBuffer, int& iLength, LPCSTR lpszPrefix = nullptr);
+
+	virtual void SetSlowCallbackThreshold	(DWORD dwSlowCallbackThreshold)	{m_ioDispatcher.GetLoopTracer().SetSlowThreshold(dwSlowCallbackThreshold * 1000ull);}
+	virtual DWORD GetSlowCallbackThreshold	()								{return (DWORD)(m_ioDispatcher.GetLoopTracer().GetSlowThreshold() / 1000);}
+	virtual BOOL GetWorkerTraceStats		(TWorkerTraceStat stats[], DWORD& dwCount);
+	virtual BOOL GetSlowCallbacks			(TSlowCallback records[], DWORD& dwCount);
+
 protected:
 	virtual EnHandleResult FirePrepareListen(SOCKET soListen)
 		{return DoFirePrepareListen(soListen);}
@@ -156,6 +166,10 @@ protected:
 	virtual void OnWorkerThreadStart(THR_ID tid) {}
 	virtual void OnWorkerThreadEnd(THR_ID tid) {}
 
+	/* 根据接收到的数据报确定所属连接：默认按远端地址查找，子类可根据报文内容直接定位连接 */
+	virtual CONNID ResolveConnectionID(const HP_SOCKADDR& addr, const BYTE* pData, int iLength)
+		{return FindConnectionID(&addr);}
+
 	TUdpSocketObj*	FindSocketObj(CONNID dwConnID);
 	int				SendInternal(TUdpSocketObj* pSocketObj, TItemPtr& itPtr);
 
@@ -212,7 +226,8 @@ private:
 	BOOL HandleClose		(TUdpSocketObj* pSocketObj, EnSocketOperation enOperation, int iErrorCode);
 	void HandleZeroBytes	(TUdpSocketObj* pSocketObj);
 
-	BOOL SendItem			(TUdpSocketObj* pSocketObj, TItem* pItem, BOOL& bBlocked);
+	BOOL SendItem			(TUdpSocketObj* pSocketObj, TItem* pItem, BOOL& bBlocked, int& iSent);
+	void NotifySend			(TUdpSocketObj* pSocketObj, const BYTE* pData, int iLength);
 
 	void DetectConnection		(PVOID pv);
 	BOOL IsNeedDetectConnection	() {return m_dwDetectAttempts > 0 && m_dwDetectInterval > 0;}
@@ -225,10 +240,10 @@ public:
 	, m_enState					(SS_STOPPED)
 	, m_enSendPolicy			(SP_PACK)
 	, m_enOnSendSyncPolicy		(OSSP_NONE)
+	, m_enOnSendNotifyPolicy	(OSNP_EACH)
 	, m_enReusePolicy			(RAP_ADDR_ONLY)
 	, m_dwMaxConnectionCount	(DEFAULT_CONNECTION_COUNT)
 	, m_dwWorkerThreadCount		(DEFAULT_WORKER_THREAD_COUNT)
-	, m_dwFreeSocketObjLockTime	(DEFAULT_FREE_SOCKETOBJ_LOCK_TIME)
 	, m_dwFreeSocketObjPool		(DEFAULT_FREE_SOCKETOBJ_POOL)
 	, m_dwFreeBufferObjPool		(DEFAULT_FREE_BUFFEROBJ_POOL)
 	, m_dwFreeSocketObjHold		(DEFAULT_FREE_SOCKETOBJ_HOLD)
@@ -240,6 +255,8 @@ public:
 	, m_bMarkSilence			(TRUE)
 	{
 		ASSERT(m_pListener);
+
+		m_ioDispatcher.SetMetrics(&m_metrics);
 	}
 
 	virtual ~CUdpServer()
@@ -251,9 +268,9 @@ private:
 	EnReuseAddressPolicy m_enReusePolicy;
 	EnSendPolicy m_enSendPolicy;
 	EnOnSendSyncPolicy m_enOnSendSyncPolicy;
+	EnOnSendNotifyPolicy m_enOnSendNotifyPolicy;
 	DWORD m_dwMaxConnectionCount;
 	DWORD m_dwWorkerThreadCount;
-	DWORD m_dwFreeSocketObjLockTime;
 	DWORD m_dwFreeSocketObjPool;
 	DWORD m_dwFreeBufferObjPool;
 	DWORD m_dwFreeSocketObjHold;
@@ -291,6 +308,7 @@ private:
 
 	CSendQueue				m_quSend;
 
+	CIOMetrics				m_metrics;
 	CIODispatcher			m_ioDispatcher;
 };
 
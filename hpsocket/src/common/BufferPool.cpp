@@ -30,7 +30,6 @@ const DWORD CBufferPool::DEFAULT_MAX_CACHE_SIZE		= 0;
 const DWORD CBufferPool::DEFAULT_ITEM_CAPACITY		= CItemPool::DEFAULT_ITEM_CAPACITY;
 const DWORD CBufferPool::DEFAULT_ITEM_POOL_SIZE		= CItemPool::DEFAULT_POOL_SIZE;
 const DWORD CBufferPool::DEFAULT_ITEM_POOL_HOLD		= CItemPool::DEFAULT_POOL_HOLD;
-const DWORD CBufferPool::DEFAULT_BUFFER_LOCK_TIME	= DEFAULT_OBJECT_CACHE_LOCK_TIME;
 const DWORD CBufferPool::DEFAULT_BUFFER_POOL_SIZE	= DEFAULT_OBJECT_CACHE_POOL_SIZE;
 const DWORD CBufferPool::DEFAULT_BUFFER_POOL_HOLD	= DEFAULT_OBJECT_CACHE_POOL_HOLD;
 
@@ -129,6 +128,7 @@ void TBuffer::Reset()
 	id		 = 0;
 	length	 = 0;
 	freeTime = ::TimeGetTime();
+	freeEpoch= CEpochDomain::Retire();
 }
 
 int TBuffer::Cat(const BYTE* pData, int len)
@@ -218,7 +218,7 @@ void CBufferPool::PutFreeBuffer(TBuffer* pBuffer)
 
 void CBufferPool::ReleaseGCBuffer(BOOL bForce)
 {
-	::ReleaseGCObj(m_lsGCBuffer, m_dwBufferLockTime, bForce);
+	::ReleaseGCObj(m_lsGCBuffer, bForce);
 }
 
 TBuffer* CBufferPool::PutCacheBuffer(ULONG_PTR dwID)
@@ -240,7 +240,7 @@ TBuffer* CBufferPool::PickFreeBuffer(ULONG_PTR dwID)
 
 	if(m_lsFreeBuffer.TryLock(&pBuffer, dwIndex))
 	{
-		if(::GetTimeGap32(pBuffer->freeTime) >= m_dwBufferLockTime)
+		if(CEpochDomain::IsReclaimable(pBuffer->freeEpoch))
 			VERIFY(m_lsFreeBuffer.ReleaseLock(nullptr, dwIndex));
 		else
 		{
@@ -274,6 +274,13 @@ private:
 	T*	pBack;
 };
 
+/*
+* 内存块缓存池：
+*	默认容量（m_dwItemCapacity）的内存块放入 m_lsFreeItem；
+*	其它容量的内存块按 2 的幂分级（CLASS_MIN_CAPACITY ~ CLASS_MAX_CAPACITY）各自缓存，
+*	PickFreeItem(size) 选择能容纳 size 的最小级别，小数据不再占用整块默认容量，大数据也不必拆分成多个内存块；
+*	默认容量的 m_lsFreeItem 前置线程弹匣（CMagazinePool），收发路径上的取/放通常只访问本线程槽位
+*/
 template<class T> class CNodePoolT
 {
 public:
@@ -281,7 +288,20 @@ public:
 	{
 		ASSERT(pItem != nullptr);
 
-		if(!m_lsFreeItem.TryPut(pItem))
+		int iCapacity = pItem->Capacity();
+
+		if(iCapacity == (int)m_dwItemCapacity)
+		{
+			if(!m_lsFreeItem.TryPut(pItem))
+				T::Destruct(pItem);
+
+			return;
+		}
+
+		int iClass = GetClassIndex(iCapacity);
+
+		/* 各级别缓存的内存块数量不超过该级别的保留数量，多余的内存块直接释放 */
+		if(GetClassCapacity(iClass) != iCapacity || m_lsClassItem[iClass].Elements() >= m_dwClassHold[iClass] || !m_lsClassItem[iClass].TryPut(pItem))
 			T::Destruct(pItem);
 	}
 
@@ -308,18 +328,80 @@ public:
 		return pItem;
 	}
 
+	/*
+	* 获取至少能容纳 dwSize 字节的内存块（超过 CLASS_MAX_CAPACITY 及默认容量时返回其中较大者，由调用者继续追加）；
+	* 所选级别不如默认容量合适时（包括被 CLASS_MAX_CAPACITY 截断后小于默认容量）使用默认容量的内存块
+	*/
+	T* PickFreeItem(DWORD dwSize)
+	{
+		int iClass		= GetClassIndex((int)MIN(dwSize, (DWORD)CLASS_MAX_CAPACITY));
+		int iCapacity	= GetClassCapacity(iClass);
+
+		if(dwSize <= m_dwItemCapacity && iCapacity >= (int)m_dwItemCapacity)
+			return PickFreeItem();
+		if(dwSize > m_dwItemCapacity && iCapacity <= (int)m_dwItemCapacity)
+			return PickFreeItem();
+		if((DWORD)iCapacity < dwSize && (DWORD)iCapacity < m_dwItemCapacity)
+			return PickFreeItem();
+
+		T* pItem = nullptr;
+
+		if(!m_lsClassItem[iClass].TryGet(&pItem))
+			pItem = T::Construct(m_heap, iCapacity);
+
+		ASSERT(pItem);
+		pItem->Reset();
+
+		return pItem;
+	}
+
 	void Prepare()
 	{
-		m_lsFreeItem.Reset(m_dwPoolSize);
+		m_lsFreeItem.Reset(m_dwPoolSize, m_dwPoolHold);
+
+		for(int i = 0; i < CLASS_COUNT; i++)
+		{
+			DWORD dwCapacity = (DWORD)GetClassCapacity(i);
+			DWORD dwPoolSize = m_dwPoolSize;
+			DWORD dwPoolHold = m_dwPoolHold;
+
+			/* 大于默认容量的级别按容量比例缩减缓存数量及保留数量，使各级缓存占用的内存不超过默认级别 */
+			if(dwCapacity > m_dwItemCapacity)
+			{
+				dwPoolSize = MAX((DWORD)((ULONGLONG)m_dwPoolSize * m_dwItemCapacity / dwCapacity), (DWORD)1);
+				dwPoolHold = (DWORD)((ULONGLONG)m_dwPoolHold * m_dwItemCapacity / dwCapacity);
+			}
+
+			m_lsClassItem[i].Reset(dwPoolSize);
+			m_dwClassHold[i] = MIN(dwPoolHold, dwPoolSize);
+		}
 	}
 
 	void Clear()
 	{
 		m_lsFreeItem.Clear();
 
+		for(int i = 0; i < CLASS_COUNT; i++)
+			m_lsClassItem[i].Clear();
+
 		m_heap.Reset();
 	}
 
+private:
+	static int GetClassIndex(int iSize)
+	{
+		int iClass = 0;
+
+		for(int iCapacity = CLASS_MIN_CAPACITY; iCapacity < iSize && iClass < CLASS_COUNT - 1; iCapacity <<= 1)
+			++iClass;
+
+		return iClass;
+	}
+
+	static int GetClassCapacity(int iClass)	{return CLASS_MIN_CAPACITY << iClass;}
+
+	static constexpr int GetClassCount(int iMin, int iMax) {return iMin >= iMax ? 1 : 1 + GetClassCount(iMin << 1, iMax);}
+
 public:
 	void SetItemCapacity(DWORD dwItemCapacity)	{m_dwItemCapacity	= dwItemCapacity;}
 	void SetPoolSize	(DWORD dwPoolSize)		{m_dwPoolSize		= dwPoolSize;}
@@ -330,6 +412,9 @@ public:
 
 	CPrivateHeap& GetPrivateHeap()				{return m_heap;}
 
+	/* 获取默认容量内存块的弹匣命中/补充统计 */
+	void GetMagazineStat(typename CMagazinePool<T>::TStat& stat)	{m_lsFreeItem.GetStat(stat);}
+
 public:
 	CNodePoolT(	DWORD dwPoolSize	 = DEFAULT_POOL_SIZE,
 				DWORD dwPoolHold	 = DEFAULT_POOL_HOLD,
@@ -338,6 +423,7 @@ public:
 				, m_dwPoolHold(dwPoolHold)
 				, m_dwItemCapacity(dwItemCapacity)
 	{
+		::ZeroMemory(m_dwClassHold, sizeof(m_dwClassHold));
 	}
 
 	~CNodePoolT()	{Clear();}
@@ -349,6 +435,10 @@ public:
 	static const DWORD DEFAULT_POOL_SIZE;
 	static const DWORD DEFAULT_POOL_HOLD;
 
+	static constexpr int CLASS_MIN_CAPACITY	= BUFFER_CACHE_CLASS_MIN_CAPACITY;
+	static constexpr int CLASS_MAX_CAPACITY	= BUFFER_CACHE_CLASS_MAX_CAPACITY;
+	static constexpr int CLASS_COUNT		= GetClassCount(CLASS_MIN_CAPACITY, CLASS_MAX_CAPACITY);
+
 private:
 	CPrivateHeap	m_heap;
 
@@ -356,7 +446,9 @@ private:
 	DWORD			m_dwPoolSize;
 	DWORD			m_dwPoolHold;
 
-	CRingPool<T>	m_lsFreeItem;
+	CMagazinePool<T>	m_lsFreeItem;
+	CRingPool<T>		m_lsClassItem[CLASS_COUNT];
+	DWORD				m_dwClassHold[CLASS_COUNT];
 };
 
 template<class T> const DWORD CNodePoolT<T>::DEFAULT_ITEM_CAPACITY	= TItem::DEFAULT_ITEM_CAPACITY;
@@ -377,7 +469,7 @@ public:
 		if(length > (int)itPool.GetItemCapacity())
 			return 0;
 
-		T* pItem = __super::PushBack(itPool.PickFreeItem());
+		T* pItem = __super::PushBack(itPool.PickFreeItem(length));
 		return pItem->Cat(pData, length);
 	}
 
@@ -389,8 +481,11 @@ public:
 		{
 			T* pItem = __super::Back();
 
-			if(pItem == nullptr || pItem->IsFull())
-				pItem = __super::PushBack(itPool.PickFreeItem());
+			/* 空链表按数据大小取块；链表中已有数据时（连续追加）至少取默认容量，避免产生大量小块 */
+			if(pItem == nullptr)
+				pItem = __super::PushBack(itPool.PickFreeItem(remain));
+			else if(pItem->IsFull())
+				pItem = __super::PushBack(itPool.PickFreeItem(MAX((DWORD)remain, itPool.GetItemCapacity())));
 
 			int cat  = pItem->Cat(pData, remain);
 
@@ -747,6 +842,7 @@ public:
 	bool IsValid		()	const	{return id != 0;}
 
 	DWORD GetFreeTime	()	const	{return freeTime;}
+	ULONGLONG GetFreeEpoch()const	{return freeEpoch;}
 
 private:
 	int IncreaseLength	(int len)	{return (length += len);}
@@ -759,7 +855,7 @@ private:
 	friend void DestructObject<>(TBuffer*);
 
 	TBuffer(CPrivateHeap& hp, CItemPool& itPool, ULONG_PTR dwID = 0)
-	: heap(hp), items(itPool), id(dwID), length(0)
+	: heap(hp), items(itPool), id(dwID), length(0), freeTime(0), freeEpoch(0)
 	{
 	}
 
@@ -774,6 +870,7 @@ private:
 	ULONG_PTR		id;
 	int				length;
 	DWORD			freeTime;
+	ULONGLONG		freeEpoch;
 
 private:
 	TBuffer*		next;
@@ -808,7 +905,6 @@ public:
 	void SetItemPoolHold	(DWORD dwItemPoolHold)		{m_itPool.SetPoolHold(dwItemPoolHold);}
 
 	void SetMaxCacheSize	(DWORD dwMaxCacheSize)		{m_dwMaxCacheSize	= dwMaxCacheSize;}
-	void SetBufferLockTime	(DWORD dwBufferLockTime)	{m_dwBufferLockTime	= dwBufferLockTime;}
 	void SetBufferPoolSize	(DWORD dwBufferPoolSize)	{m_dwBufferPoolSize	= dwBufferPoolSize;}
 	void SetBufferPoolHold	(DWORD dwBufferPoolHold)	{m_dwBufferPoolHold	= dwBufferPoolHold;}
 
@@ -817,7 +913,6 @@ public:
 	DWORD GetItemPoolHold	()							{return m_itPool.GetPoolHold();}
 
 	DWORD GetMaxCacheSize	()							{return m_dwMaxCacheSize;}
-	DWORD GetBufferLockTime	()							{return m_dwBufferLockTime;}
 	DWORD GetBufferPoolSize	()							{return m_dwBufferPoolSize;}
 	DWORD GetBufferPoolHold	()							{return m_dwBufferPoolHold;}
 
@@ -826,11 +921,9 @@ public:
 public:
 	CBufferPool(DWORD dwPoolSize	 = DEFAULT_BUFFER_POOL_SIZE,
 				DWORD dwPoolHold	 = DEFAULT_BUFFER_POOL_HOLD,
-				DWORD dwLockTime	 = DEFAULT_BUFFER_LOCK_TIME,
 				DWORD dwMaxCacheSize = DEFAULT_MAX_CACHE_SIZE)
 	: m_dwBufferPoolSize(dwPoolSize)
 	, m_dwBufferPoolHold(dwPoolHold)
-	, m_dwBufferLockTime(dwLockTime)
 	, m_dwMaxCacheSize(dwMaxCacheSize)
 	{
 
@@ -849,13 +942,11 @@ public:
 	static const DWORD DEFAULT_ITEM_CAPACITY;
 	static const DWORD DEFAULT_ITEM_POOL_SIZE;
 	static const DWORD DEFAULT_ITEM_POOL_HOLD;
-	static const DWORD DEFAULT_BUFFER_LOCK_TIME;
 	static const DWORD DEFAULT_BUFFER_POOL_SIZE;
 	static const DWORD DEFAULT_BUFFER_POOL_HOLD;
 
 private:
 	DWORD			m_dwMaxCacheSize;
-	DWORD			m_dwBufferLockTime;
 	DWORD			m_dwBufferPoolSize;
 	DWORD			m_dwBufferPoolHold;
 
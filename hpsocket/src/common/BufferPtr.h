@@ -100,6 +100,13 @@ public:
 		return *this;
 	}
 
+	void Swap(CBufferPtrT& other)
+	{
+		std::swap(m_pch, other.m_pch);
+		std::swap(m_size, other.m_size);
+		std::swap(m_capacity, other.m_capacity);
+	}
+
 	template<size_t S> bool Equal(const CBufferPtrT<T, S>& other) const
 	{
 		if((void*)&other == (void*)this)
@@ -0,0 +1,162 @@
+﻿/*
+* Copyright: JessMA Open Source (ldcsaa@gmail.com)
+*
+* Author	: Bruce Liang
+* Website	: https://github.com/ldcsaa
+* Project	: https://github.com/ldcsaa/HP-Socket
+* Blog		: http://www.cnblogs.com/ldcsaa
+* Wiki		: http://www.oschina.net/p/hp-socket
+* QQ Group	: 44636872, 75375912
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#pragma once
+
+#include "GlobalDef.h"
+#include "Singleton.h"
+#include "FuncHelper.h"
+
+#include <atomic>
+
+using namespace std;
+
+/*
+  基于纪元（Epoch）的对象回收
+  ------------------------------------------------------------------------
+  访问可能被回收的对象（TSocketObj、TBuffer、CSSLSession、THttpObj 等）的代码段用 CEpochLock 保护：
+	进入时登记当前全局纪元，离开时清除登记（可嵌套）；
+  对象从查找表摘除后调用 Retire() 取得回收纪元（同时推进全局纪元）；
+  当所有处于保护段内的线程登记的纪元都大于对象的回收纪元时，不再有线程能引用该对象，IsReclaimable() 返回 TRUE
+*/
+class CEpochDomain
+{
+private:
+
+	struct TRecord
+	{
+		atomic<ULONGLONG>	epoch;		// 0：不在保护段内
+		atomic_bool			used;
+		TRecord*			next;
+		int					nest;		// 仅由拥有者线程访问
+	} __attribute__((aligned(64)));
+
+	struct TRecordHolder
+	{
+		TRecord* pRecord;
+
+		TRecordHolder() : pRecord(AcquireRecord()) {}
+
+		~TRecordHolder()
+		{
+			pRecord->epoch.store(0);
+			pRecord->used.store(false, memory_order_release);
+		}
+	};
+
+public:
+
+	static void Enter()
+	{
+		TRecord* pRecord = GetRecord();
+
+		if(pRecord->nest++ == 0)
+			pRecord->epoch.store(Epoch().load());
+	}
+
+	static void Leave()
+	{
+		TRecord* pRecord = GetRecord();
+
+		ASSERT(pRecord->nest > 0);
+
+		if(--pRecord->nest == 0)
+			pRecord->epoch.store(0, memory_order_release);
+	}
+
+	/* 对象摘除后调用：返回对象的回收纪元，并推进全局纪元 */
+	static ULONGLONG Retire()
+	{
+		return Epoch().fetch_add(1);
+	}
+
+	/* 检查回收纪元为 ullEpoch 的对象是否已无线程引用 */
+	static BOOL IsReclaimable(ULONGLONG ullEpoch)
+	{
+		if(ullEpoch < SafeEpoch().load(memory_order_acquire))
+			return TRUE;
+
+		ULONGLONG ullSafe = Epoch().load();
+
+		for(TRecord* pRecord = Head().load(memory_order_acquire); pRecord != nullptr; pRecord = pRecord->next)
+		{
+			ULONGLONG ullActive = pRecord->epoch.load();
+
+			if(ullActive != 0 && ullActive < ullSafe)
+				ullSafe = ullActive;
+		}
+
+		ULONGLONG ullLast = SafeEpoch().load(memory_order_relaxed);
+
+		while(ullLast < ullSafe && !SafeEpoch().compare_exchange_weak(ullLast, ullSafe))
+			;
+
+		return ullEpoch < ullSafe;
+	}
+
+private:
+
+	static TRecord* GetRecord()
+	{
+		static thread_local TRecordHolder s_holder;
+
+		return s_holder.pRecord;
+	}
+
+	static TRecord* AcquireRecord()
+	{
+		for(TRecord* pRecord = Head().load(memory_order_acquire); pRecord != nullptr; pRecord = pRecord->next)
+		{
+			bool bExpect = false;
+
+			if(!pRecord->used.load(memory_order_relaxed) && pRecord->used.compare_exchange_strong(bExpect, true))
+				return pRecord;
+		}
+
+		/* 线程登记记录只增不删，线程退出后由其它线程复用 */
+		TRecord* pRecord = new TRecord;
+
+		pRecord->epoch	= 0;
+		pRecord->used	= true;
+		pRecord->nest	= 0;
+		pRecord->next	= Head().load(memory_order_relaxed);
+
+		while(!Head().compare_exchange_weak(pRecord->next, pRecord))
+			;
+
+		return pRecord;
+	}
+
+	static atomic<ULONGLONG>& Epoch()		{static atomic<ULONGLONG> s_ullEpoch(1);	return s_ullEpoch;}
+	static atomic<ULONGLONG>& SafeEpoch()	{static atomic<ULONGLONG> s_ullSafe(0);		return s_ullSafe;}
+	static atomic<TRecord*>& Head()			{static atomic<TRecord*> s_pHead(nullptr);	return s_pHead;}
+};
+
+class CEpochLock
+{
+public:
+	CEpochLock()	{CEpochDomain::Enter();}
+	~CEpochLock()	{CEpochDomain::Leave();}
+
+	DECLARE_NO_COPY_CLASS(CEpochLock)
+};
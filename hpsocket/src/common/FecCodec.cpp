@@ -0,0 +1,778 @@
+﻿/*
+* Copyright: JessMA Open Source (ldcsaa@gmail.com)
+*
+* Author	: Bruce Liang
+* Website	: https://github.com/ldcsaa
+* Project	: https://github.com/ldcsaa/HP-Socket
+* Blog		: http://www.cnblogs.com/ldcsaa
+* Wiki		: http://www.oschina.net/p/hp-socket
+* QQ Group	: 44636872, 75375912
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "FecCodec.h"
+#include "FuncHelper.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+	#include <immintrin.h>
+	#define _GF_SIMD_X86
+#elif defined(__aarch64__)
+	#include <arm_neon.h>
+	#define _GF_SIMD_NEON
+#endif
+
+#define GF_POLYNOMIAL			0x11D
+
+/* 批量运算实现：处理 pDest / pSrc 的前若干字节（按向量长度对齐部分），返回已处理的字节数 */
+using Fn_GFKernel = int (*)(BYTE* pDest, const BYTE* pSrc, const BYTE* pNibbles, int iLength, BOOL bAdd);
+
+static int GFKernelNone(BYTE* pDest, const BYTE* pSrc, const BYTE* pNibbles, int iLength, BOOL bAdd)
+{
+	return 0;
+}
+
+#if defined(_GF_SIMD_X86)
+
+__attribute__((target("ssse3")))
+static int GFKernelSSSE3(BYTE* pDest, const BYTE* pSrc, const BYTE* pNibbles, int iLength, BOOL bAdd)
+{
+	const __m128i low	= _mm_loadu_si128((const __m128i*)pNibbles);
+	const __m128i high	= _mm_loadu_si128((const __m128i*)(pNibbles + 16));
+	const __m128i mask	= _mm_set1_epi8(0x0F);
+
+	int i = 0;
+
+	for(; i + 16 <= iLength; i += 16)
+	{
+		__m128i x = _mm_loadu_si128((const __m128i*)(pSrc + i));
+		__m128i l = _mm_and_si128(x, mask);
+		__m128i h = _mm_and_si128(_mm_srli_epi64(x, 4), mask);
+		__m128i p = _mm_xor_si128(_mm_shuffle_epi8(low, l), _mm_shuffle_epi8(high, h));
+
+		if(bAdd) p = _mm_xor_si128(p, _mm_loadu_si128((const __m128i*)(pDest + i)));
+
+		_mm_storeu_si128((__m128i*)(pDest + i), p);
+	}
+
+	return i;
+}
+
+__attribute__((target("avx2")))
+static int GFKernelAVX2(BYTE* pDest, const BYTE* pSrc, const BYTE* pNibbles, int iLength, BOOL bAdd)
+{
+	const __m256i low	= _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)pNibbles));
+	const __m256i high	= _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(pNibbles + 16)));
+	const __m256i mask	= _mm256_set1_epi8(0x0F);
+
+	int i = 0;
+
+	for(; i + 32 <= iLength; i += 32)
+	{
+		__m256i x = _mm256_loadu_si256((const __m256i*)(pSrc + i));
+		__m256i l = _mm256_and_si256(x, mask);
+		__m256i h = _mm256_and_si256(_mm256_srli_epi64(x, 4), mask);
+		__m256i p = _mm256_xor_si256(_mm256_shuffle_epi8(low, l), _mm256_shuffle_epi8(high, h));
+
+		if(bAdd) p = _mm256_xor_si256(p, _mm256_loadu_si256((const __m256i*)(pDest + i)));
+
+		_mm256_storeu_si256((__m256i*)(pDest + i), p);
+	}
+
+	return i + GFKernelSSSE3(pDest + i, pSrc + i, pNibbles, iLength - i, bAdd);
+}
+
+#elif defined(_GF_SIMD_NEON)
+
+static int GFKernelNEON(BYTE* pDest, const BYTE* pSrc, const BYTE* pNibbles, int iLength, BOOL bAdd)
+{
+	const uint8x16_t low	= vld1q_u8(pNibbles);
+	const uint8x16_t high	= vld1q_u8(pNibbles + 16);
+	const uint8x16_t mask	= vdupq_n_u8(0x0F);
+
+	int i = 0;
+
+	for(; i + 16 <= iLength; i += 16)
+	{
+		uint8x16_t x = vld1q_u8(pSrc + i);
+		uint8x16_t p = veorq_u8(vqtbl1q_u8(low, vandq_u8(x, mask)), vqtbl1q_u8(high, vshrq_n_u8(x, 4)));
+
+		if(bAdd) p = veorq_u8(p, vld1q_u8(pDest + i));
+
+		vst1q_u8(pDest + i, p);
+	}
+
+	return i;
+}
+
+#endif
+
+/* GF(2^8) 运算表：对数 / 指数表、乘法表，以及每个乘数的低 / 高半字节乘积表（供 SIMD 实现使用） */
+struct TGFTables
+{
+	BYTE log[256];
+	BYTE exp[512];
+	BYTE mul[256][256];
+	BYTE nibbles[256][32];
+
+	Fn_GFKernel	kernel;
+	LPCSTR		kernelName;
+
+	TGFTables()
+	{
+		int x = 1;
+
+		for(int i = 0; i < 255; i++)
+		{
+			exp[i]	= (BYTE)x;
+			log[x]	= (BYTE)i;
+
+			x <<= 1;
+
+			if(x & 0x100)
+				x ^= GF_POLYNOMIAL;
+		}
+
+		for(int i = 255; i < 512; i++)
+			exp[i] = exp[i - 255];
+
+		log[0] = 0;
+
+		for(int a = 0; a < 256; a++)
+		{
+			for(int b = 0; b < 256; b++)
+				mul[a][b] = (a == 0 || b == 0) ? 0 : exp[log[a] + log[b]];
+
+			for(int n = 0; n < 16; n++)
+			{
+				nibbles[a][n]		= mul[a][n];
+				nibbles[a][16 + n]	= mul[a][n << 4];
+			}
+		}
+
+		kernel		= GFKernelNone;
+		kernelName	= "scalar";
+
+#if defined(_GF_SIMD_X86)
+		__builtin_cpu_init();
+
+		if(__builtin_cpu_supports("avx2"))
+		{
+			kernel		= GFKernelAVX2;
+			kernelName	= "avx2";
+		}
+		else if(__builtin_cpu_supports("ssse3"))
+		{
+			kernel		= GFKernelSSSE3;
+			kernelName	= "ssse3";
+		}
+#elif defined(_GF_SIMD_NEON)
+		kernel		= GFKernelNEON;
+		kernelName	= "neon";
+#endif
+	}
+};
+
+static const TGFTables& GFTables()
+{
+	static const TGFTables s_tables;
+	return s_tables;
+}
+
+BYTE CGF256::Mul(BYTE a, BYTE b)
+{
+	return GFTables().mul[a][b];
+}
+
+BYTE CGF256::Div(BYTE a, BYTE b)
+{
+	ASSERT(b != 0);
+
+	if(a == 0)
+		return 0;
+
+	const TGFTables& tbl = GFTables();
+
+	return tbl.exp[tbl.log[a] + 255 - tbl.log[b]];
+}
+
+BYTE CGF256::Inv(BYTE a)
+{
+	return Div(1, a);
+}
+
+void CGF256::MulAdd(BYTE* pDest, const BYTE* pSrc, BYTE c, int iLength)
+{
+	if(c == 0)
+		return;
+
+	if(c == 1)
+	{
+		for(int i = 0; i < iLength; i++)
+			pDest[i] ^= pSrc[i];
+
+		return;
+	}
+
+	const TGFTables& tbl	= GFTables();
+	const BYTE* pMul		= tbl.mul[c];
+
+	int i = tbl.kernel(pDest, pSrc, tbl.nibbles[c], iLength, TRUE);
+
+	for(; i < iLength; i++)
+		pDest[i] ^= pMul[pSrc[i]];
+}
+
+void CGF256::MulSet(BYTE* pDest, const BYTE* pSrc, BYTE c, int iLength)
+{
+	if(c == 0)
+	{
+		::ZeroMemory(pDest, iLength);
+		return;
+	}
+
+	if(c == 1)
+	{
+		if(pDest != pSrc)
+			memcpy(pDest, pSrc, iLength);
+
+		return;
+	}
+
+	const TGFTables& tbl	= GFTables();
+	const BYTE* pMul		= tbl.mul[c];
+
+	int i = tbl.kernel(pDest, pSrc, tbl.nibbles[c], iLength, FALSE);
+
+	for(; i < iLength; i++)
+		pDest[i] = pMul[pSrc[i]];
+}
+
+LPCSTR CGF256::GetKernelName()
+{
+	return GFTables().kernelName;
+}
+
+BOOL CRSCodec::Init(int iDataShards, int iParityShards)
+{
+	if(iDataShards <= 0 || iParityShards <= 0 || iDataShards + iParityShards > FEC_MAX_SHARDS)
+	{
+		::SetLastError(ERROR_INVALID_PARAMETER);
+		return FALSE;
+	}
+
+	if(iDataShards == m_iDataShards && iParityShards == m_iParityShards)
+		return TRUE;
+
+	m_iDataShards	= iDataShards;
+	m_iParityShards	= iParityShards;
+
+	m_matrix.reset(new BYTE[iParityShards * iDataShards]);
+
+	//Cauchy 矩阵：m[i][j] = 1 / (x[i] + y[j])，x[i] = K + i，y[j] = j
+	for(int i = 0; i < iParityShards; i++)
+	{
+		for(int j = 0; j < iDataShards; j++)
+			m_matrix[i * iDataShards + j] = CGF256::Inv((BYTE)((iDataShards + i) ^ j));
+	}
+
+	return TRUE;
+}
+
+void CRSCodec::Encode(BYTE* shards[], int iLength) const
+{
+	ASSERT(m_iDataShards > 0);
+
+	for(int i = 0; i < m_iParityShards; i++)
+	{
+		const BYTE* pRow	= m_matrix.get() + i * m_iDataShards;
+		BYTE* pParity		= shards[m_iDataShards + i];
+
+		CGF256::MulSet(pParity, shards[0], pRow[0], iLength);
+
+		for(int j = 1; j < m_iDataShards; j++)
+			CGF256::MulAdd(pParity, shards[j], pRow[j], iLength);
+	}
+}
+
+BOOL CRSCodec::Reconstruct(BYTE* shards[], BOOL present[], int iLength) const
+{
+	ASSERT(m_iDataShards > 0);
+
+	int K = m_iDataShards;
+	int N = GetTotalShards();
+
+	BOOL bMissing = FALSE;
+
+	for(int i = 0; i < K; i++)
+	{
+		if(!present[i])
+		{
+			bMissing = TRUE;
+			break;
+		}
+	}
+
+	if(!bMissing)
+		return TRUE;
+
+	//优先选择数据分片
+	unique_ptr<int[]> selected(new int[K]);
+	int iSelected = 0;
+
+	for(int i = 0; i < N && iSelected < K; i++)
+	{
+		if(present[i])
+			selected[iSelected++] = i;
+	}
+
+	if(iSelected < K)
+		return FALSE;
+
+	unique_ptr<BYTE[]> matrix(new BYTE[K * K]);
+
+	for(int r = 0; r < K; r++)
+	{
+		BYTE* pRow	= matrix.get() + r * K;
+		int iShard	= selected[r];
+
+		if(iShard < K)
+		{
+			::ZeroMemory(pRow, K);
+			pRow[iShard] = 1;
+		}
+		else
+			memcpy(pRow, m_matrix.get() + (iShard - K) * K, K);
+	}
+
+	if(!InvertMatrix(matrix.get(), K))
+		return FALSE;
+
+	for(int i = 0; i < K; i++)
+	{
+		if(present[i])
+			continue;
+
+		const BYTE* pRow	= matrix.get() + i * K;
+		BYTE* pData			= shards[i];
+
+		CGF256::MulSet(pData, shards[selected[0]], pRow[0], iLength);
+
+		for(int j = 1; j < K; j++)
+			CGF256::MulAdd(pData, shards[selected[j]], pRow[j], iLength);
+
+		present[i] = TRUE;
+	}
+
+	return TRUE;
+}
+
+BOOL CRSCodec::InvertMatrix(BYTE* pMatrix, int n)
+{
+	int w = 2 * n;
+	unique_ptr<BYTE[]> work(new BYTE[n * w]);
+
+	for(int r = 0; r < n; r++)
+	{
+		BYTE* pRow = work.get() + r * w;
+
+		memcpy(pRow, pMatrix + r * n, n);
+		::ZeroMemory(pRow + n, n);
+		pRow[n + r] = 1;
+	}
+
+	for(int c = 0; c < n; c++)
+	{
+		int iPivot = c;
+
+		while(iPivot < n && work[iPivot * w + c] == 0)
+			++iPivot;
+
+		if(iPivot == n)
+			return FALSE;
+
+		BYTE* pRow = work.get() + c * w;
+
+		if(iPivot != c)
+		{
+			BYTE* pPivot = work.get() + iPivot * w;
+
+			for(int k = 0; k < w; k++)
+				swap(pRow[k], pPivot[k]);
+		}
+
+		BYTE inv = CGF256::Inv(pRow[c]);
+
+		if(inv != 1)
+			CGF256::MulSet(pRow, pRow, inv, w);
+
+		for(int r = 0; r < n; r++)
+		{
+			BYTE* pOther = work.get() + r * w;
+
+			if(r != c && pOther[c] != 0)
+				CGF256::MulAdd(pOther, pRow, pOther[c], w);
+		}
+	}
+
+	for(int r = 0; r < n; r++)
+		memcpy(pMatrix + r * n, work.get() + r * w + n, n);
+
+	return TRUE;
+}
+
+BOOL CFecEncoder::Init(int iDataShards, int iParityShards, int iMaxDatagram)
+{
+	int iOldShards = m_codec.GetTotalShards();
+
+	if(iMaxDatagram <= 0 || iMaxDatagram > 0xFFFF || !m_codec.Init(iDataShards, iParityShards))
+	{
+		::SetLastError(ERROR_INVALID_PARAMETER);
+		return FALSE;
+	}
+
+	int iPacketSize	= FEC_MAX_OVERHEAD + iMaxDatagram;
+	int iShards		= m_codec.GetTotalShards();
+
+	if(!m_buffer || iPacketSize != m_iPacketSize || iShards != iOldShards)
+	{
+		m_buffer.reset(new BYTE[iShards * iPacketSize]);
+		m_shards.reset(new BYTE*[iShards]);
+	}
+
+	m_iMaxDatagram	= iMaxDatagram;
+	m_iPacketSize	= iPacketSize;
+
+	for(int i = 0; i < iShards; i++)
+		m_shards[i] = GetPacket(i) + (i < iDataShards ? FEC_HEADER_SIZE : FEC_PARITY_HEADER_SIZE);
+
+	Reset();
+
+	return TRUE;
+}
+
+void CFecEncoder::Reset()
+{
+	m_dwGroup		= 0;
+	m_iShardIndex	= 0;
+	m_iMaxShard		= 0;
+	m_iParityLen	= 0;
+	m_iParityReady	= 0;
+}
+
+const BYTE* CFecEncoder::Encode(const BYTE* pData, int iLength)
+{
+	ASSERT(IsValid() && iLength > 0 && iLength <= m_iMaxDatagram);
+
+	int K			= m_codec.GetDataShards();
+	int iIndex		= m_iShardIndex;
+	BYTE* pPacket	= GetPacket(iIndex);
+	UINT16 usSize	= (UINT16)iLength;
+
+	m_iParityReady = 0;
+
+	memcpy(pPacket + 0, &m_dwGroup, sizeof(DWORD));
+	*((UINT8*)(pPacket + 4))	= (UINT8)iIndex;
+	*((UINT8*)(pPacket + 5))	= FEC_TYPE_DATA;
+	memcpy(pPacket + 6, &usSize, sizeof(UINT16));
+
+	memcpy(pPacket + FEC_OVERHEAD, pData, iLength);
+
+	m_iMaxShard = MAX(m_iMaxShard, iLength + FEC_SIZE_FIELD_SIZE);
+
+	if(++m_iShardIndex == K)
+		EncodeParity(K);
+
+	return pPacket;
+}
+
+BOOL CFecEncoder::Flush()
+{
+	ASSERT(IsValid());
+
+	m_iParityReady = 0;
+
+	if(m_iShardIndex == 0)
+		return FALSE;
+
+	EncodeParity(m_iShardIndex);
+
+	return TRUE;
+}
+
+void CFecEncoder::EncodeParity(int iDataShards)
+{
+	int K = m_codec.GetDataShards();
+
+	//数据分片以 0 补齐至分组内最长数据分片长度，缺少的数据分片视为空分片
+	for(int i = 0; i < K; i++)
+	{
+		int iShard = 0;
+
+		if(i < iDataShards)
+		{
+			UINT16 usSize;
+			memcpy(&usSize, m_shards[i], sizeof(UINT16));
+
+			iShard = usSize + FEC_SIZE_FIELD_SIZE;
+		}
+
+		if(iShard < m_iMaxShard)
+			::ZeroMemory(m_shards[i] + iShard, m_iMaxShard - iShard);
+	}
+
+	for(int i = K; i < m_codec.GetTotalShards(); i++)
+	{
+		BYTE* pParity = GetPacket(i);
+
+		memcpy(pParity + 0, &m_dwGroup, sizeof(DWORD));
+		*((UINT8*)(pParity + 4))	= (UINT8)i;
+		*((UINT8*)(pParity + 5))	= FEC_TYPE_PARITY;
+		*((UINT8*)(pParity + 6))	= (UINT8)iDataShards;
+	}
+
+	m_codec.Encode(m_shards.get(), m_iMaxShard);
+
+	m_iParityLen	= m_iMaxShard;
+	m_iParityReady	= m_codec.GetParityShards();
+	m_iShardIndex	= 0;
+	m_iMaxShard		= 0;
+
+	++m_dwGroup;
+}
+
+const BYTE* CFecEncoder::GetParity(int i, int& iLength) const
+{
+	ASSERT(i >= 0 && i < m_iParityReady);
+
+	iLength = FEC_PARITY_HEADER_SIZE + m_iParityLen;
+
+	return GetPacket(m_codec.GetDataShards() + i);
+}
+
+BOOL CFecDecoder::Init(int iDataShards, int iParityShards, int iMaxDatagram)
+{
+	int K = m_codec.GetDataShards();
+	int M = m_codec.GetParityShards();
+
+	if(iMaxDatagram <= 0 || iMaxDatagram > 0xFFFF || !m_codec.Init(iDataShards, iParityShards))
+	{
+		::SetLastError(ERROR_INVALID_PARAMETER);
+		return FALSE;
+	}
+
+	int iPacketSize = FEC_SIZE_FIELD_SIZE + iMaxDatagram;
+
+	//参数改变时释放分组缓冲区（在首次使用时重新分配）
+	if(iPacketSize != m_iPacketSize || iDataShards != K || iParityShards != M)
+	{
+		for(int i = 0; i < FEC_DECODE_GROUPS; i++)
+		{
+			TGroup& group = m_groups[i];
+
+			group.buffer.reset();
+			group.shards.reset();
+			group.present.reset();
+			group.lengths.reset();
+		}
+	}
+
+	m_iMaxDatagram	= iMaxDatagram;
+	m_iPacketSize	= iPacketSize;
+
+	Reset();
+
+	return TRUE;
+}
+
+void CFecDecoder::Reset()
+{
+	for(int i = 0; i < FEC_DECODE_GROUPS; i++)
+	{
+		m_groups[i].used = FALSE;
+		m_groups[i].done = FALSE;
+	}
+}
+
+void CFecDecoder::PrepareGroup(TGroup* pGroup, DWORD dwID)
+{
+	int N = m_codec.GetTotalShards();
+
+	if(!pGroup->buffer)
+	{
+		pGroup->buffer.reset(new BYTE[N * m_iPacketSize]);
+		pGroup->shards.reset(new BYTE*[N]);
+		pGroup->present.reset(new BOOL[N]);
+		pGroup->lengths.reset(new int[N]);
+
+		for(int i = 0; i < N; i++)
+			pGroup->shards[i] = pGroup->buffer.get() + i * m_iPacketSize;
+	}
+
+	for(int i = 0; i < N; i++)
+	{
+		pGroup->present[i] = FALSE;
+		pGroup->lengths[i] = -1;
+	}
+
+	pGroup->id			= dwID;
+	pGroup->used		= TRUE;
+	pGroup->done		= FALSE;
+	pGroup->count		= 0;
+	pGroup->parityLen	= 0;
+	pGroup->dataShards	= 0;
+}
+
+BOOL CFecDecoder::Accept(const BYTE* pPacket, int iLength, int& iIndex, TGroup*& pGroup)
+{
+	ASSERT(IsValid());
+
+	iIndex = -1;
+	pGroup = nullptr;
+
+	if(iLength <= FEC_OVERHEAD)
+		return FALSE;
+
+	DWORD dwID;
+	memcpy(&dwID, pPacket + 0, sizeof(DWORD));
+
+	int iShard		= *((UINT8*)(pPacket + 4));
+	UINT8 type		= *((UINT8*)(pPacket + 5));
+	int K			= m_codec.GetDataShards();
+	int iHeader		= FEC_HEADER_SIZE;
+	int iDataShards	= 0;
+
+	if(type == FEC_TYPE_DATA)
+	{
+		if(iShard >= K || iLength - FEC_OVERHEAD > m_iMaxDatagram || ReadSizeField(pPacket + 6) != iLength - FEC_OVERHEAD)
+			return FALSE;
+	}
+	else if(type == FEC_TYPE_PARITY)
+	{
+		iHeader		= FEC_PARITY_HEADER_SIZE;
+		iDataShards	= *((UINT8*)(pPacket + 6));
+
+		if(iShard < K || iShard >= m_codec.GetTotalShards() || iLength - iHeader > m_iPacketSize || iDataShards <= 0 || iDataShards > K)
+			return FALSE;
+	}
+	else
+		return FALSE;
+
+	int iSize = iLength - iHeader;
+
+	TGroup* pSlot = &m_groups[dwID % FEC_DECODE_GROUPS];
+
+	if(!pSlot->used || pSlot->id != dwID)
+	{
+		//过期分组：数据分片直接输出，校验分片丢弃
+		if(pSlot->used && (int)(dwID - pSlot->id) < 0)
+		{
+			if(type == FEC_TYPE_DATA)
+				iIndex = iShard;
+
+			return TRUE;
+		}
+
+		PrepareGroup(pSlot, dwID);
+	}
+
+	if(type == FEC_TYPE_DATA)
+	{
+		if(pSlot->dataShards > 0 && iShard >= pSlot->dataShards)
+			return FALSE;
+	}
+	else if(pSlot->dataShards == 0)
+	{
+		//未满的分组：缺少的数据分片作为已收到的空分片
+		for(int i = iDataShards; i < K; i++)
+		{
+			if(pSlot->present[i])
+				return FALSE;
+		}
+
+		for(int i = iDataShards; i < K; i++)
+		{
+			pSlot->present[i] = TRUE;
+			pSlot->lengths[i] = 0;
+		}
+
+		pSlot->count	  += K - iDataShards;
+		pSlot->dataShards  = iDataShards;
+	}
+	else if(pSlot->dataShards != iDataShards)
+		return FALSE;
+
+	if(pSlot->present[iShard])
+		return TRUE;
+
+	if(type == FEC_TYPE_PARITY)
+	{
+		if(pSlot->parityLen == 0)
+			pSlot->parityLen = iSize;
+		else if(pSlot->parityLen != iSize)
+			return FALSE;
+	}
+
+	if(!pSlot->done)
+	{
+		memcpy(pSlot->shards[iShard], pPacket + iHeader, iSize);
+		pSlot->lengths[iShard] = iSize;
+	}
+
+	pSlot->present[iShard] = TRUE;
+	++pSlot->count;
+
+	iIndex = iShard;
+	pGroup = pSlot;
+
+	return TRUE;
+}
+
+int CFecDecoder::RecoverGroup(TGroup* pGroup)
+{
+	int K		= m_codec.GetDataShards();
+	int iFirst	= -1;
+
+	pGroup->done = TRUE;
+
+	for(int i = 0; i < K; i++)
+	{
+		if(!pGroup->present[i])
+		{
+			iFirst = i;
+			break;
+		}
+	}
+
+	if(iFirst < 0 || pGroup->parityLen == 0)
+		return -1;
+
+	//数据分片以 0 补齐至校验分片长度
+	for(int i = 0; i < K; i++)
+	{
+		int iSize = pGroup->lengths[i];
+
+		if(iSize < 0)
+			continue;
+		if(iSize > pGroup->parityLen)
+			return -1;
+
+		if(iSize < pGroup->parityLen)
+			::ZeroMemory(pGroup->shards[i] + iSize, pGroup->parityLen - iSize);
+	}
+
+	if(!m_codec.Reconstruct(pGroup->shards.get(), pGroup->present.get(), pGroup->parityLen))
+		return -1;
+
+	return iFirst;
+}
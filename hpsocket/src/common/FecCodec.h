@@ -0,0 +1,275 @@
+﻿/*
+* Copyright: JessMA Open Source (ldcsaa@gmail.com)
+*
+* Author	: Bruce Liang
+* Website	: https://github.com/ldcsaa
+* Project	: https://github.com/ldcsaa/HP-Socket
+* Blog		: http://www.cnblogs.com/ldcsaa
+* Wiki		: http://www.oschina.net/p/hp-socket
+* QQ Group	: 44636872, 75375912
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#pragma once
+
+#include "GlobalDef.h"
+#include "Singleton.h"
+
+#include <memory>
+
+using namespace std;
+
+/* FEC 分组最大分片数（数据分片 + 校验分片） */
+#define FEC_MAX_SHARDS			255
+/* FEC 分片头长度：分组序号（4 字节）+ 组内分片序号（1 字节）+ 分片类型（1 字节） */
+#define FEC_HEADER_SIZE			6
+/* FEC 校验分片头长度：分片头 + 分组内数据分片数（1 字节） */
+#define FEC_PARITY_HEADER_SIZE	(FEC_HEADER_SIZE + 1)
+/* FEC 数据分片中数据报长度字段的长度 */
+#define FEC_SIZE_FIELD_SIZE		2
+/* FEC 数据分片相对原始数据报的额外长度 */
+#define FEC_OVERHEAD			(FEC_HEADER_SIZE + FEC_SIZE_FIELD_SIZE)
+/* FEC 分片相对原始数据报的最大额外长度（校验分片） */
+#define FEC_MAX_OVERHEAD		(FEC_PARITY_HEADER_SIZE + FEC_SIZE_FIELD_SIZE)
+/* FEC 解码器缓存的分组数 */
+#define FEC_DECODE_GROUPS		3
+
+#define FEC_TYPE_DATA			0xF1
+#define FEC_TYPE_PARITY			0xF2
+
+/************************************************************************
+名称：GF(2^8) 运算
+描述：本原多项式 0x11D；批量乘加运算根据平台选择 AVX2 / SSSE3 / NEON 实现（半字节查表），否则使用标量查表实现
+************************************************************************/
+class CGF256
+{
+public:
+	static BYTE Mul(BYTE a, BYTE b);
+	static BYTE Div(BYTE a, BYTE b);
+	static BYTE Inv(BYTE a);
+
+	/* pDest[i] ^= c * pSrc[i] */
+	static void MulAdd(BYTE* pDest, const BYTE* pSrc, BYTE c, int iLength);
+	/* pDest[i] = c * pSrc[i] */
+	static void MulSet(BYTE* pDest, const BYTE* pSrc, BYTE c, int iLength);
+
+	/* 获取当前使用的批量运算实现名称 */
+	static LPCSTR GetKernelName();
+
+private:
+	CGF256() = delete;
+};
+
+/************************************************************************
+名称：Reed-Solomon 编解码器
+描述：系统码，校验矩阵为 Cauchy 矩阵，任意 K 个分片（K = 数据分片数）均可恢复全部数据分片
+************************************************************************/
+class CRSCodec
+{
+public:
+	BOOL Init(int iDataShards, int iParityShards);
+
+	/*
+	* 编码：shards 共 K + M 个分片，前 K 个为数据分片，后 M 个为输出的校验分片，每个分片长度为 iLength
+	*/
+	void Encode(BYTE* shards[], int iLength) const;
+
+	/*
+	* 恢复：shards 共 K + M 个分片缓冲区（长度均为 iLength），present 标识分片是否有效；
+	*       恢复丢失的数据分片并置 present 标识，有效分片少于 K 个时返回 FALSE
+	*/
+	BOOL Reconstruct(BYTE* shards[], BOOL present[], int iLength) const;
+
+	int GetDataShards()		const	{return m_iDataShards;}
+	int GetParityShards()	const	{return m_iParityShards;}
+	int GetTotalShards()	const	{return m_iDataShards + m_iParityShards;}
+
+private:
+	static BOOL InvertMatrix(BYTE* pMatrix, int n);
+
+public:
+	CRSCodec() : m_iDataShards(0), m_iParityShards(0) {}
+
+	DECLARE_NO_COPY_CLASS(CRSCodec)
+
+private:
+	int m_iDataShards;
+	int m_iParityShards;
+
+	/* M x K 校验矩阵 */
+	unique_ptr<BYTE[]> m_matrix;
+};
+
+/************************************************************************
+名称：FEC 编码器
+描述：把输出数据报依次作为数据分片加上 FEC 分片头，每 K 个数据分片组成一个分组并生成 M 个校验分片；
+	  分组未满时可调用 Flush() 结束分组，缺少的数据分片视为空分片（不发送）参与编码
+	  数据分片：[分组序号][组内序号][FEC_TYPE_DATA][数据报长度][数据报]
+	  校验分片：[分组序号][组内序号][FEC_TYPE_PARITY][分组内数据分片数][校验数据（长度为分组内最长数据分片长度）]
+************************************************************************/
+class CFecEncoder
+{
+public:
+	/* iMaxDatagram：原始数据报最大长度 */
+	BOOL Init(int iDataShards, int iParityShards, int iMaxDatagram);
+	void Reset();
+
+	/*
+	* 编码数据报：返回数据分片（指向内部缓冲区，长度为 iLength + FEC_OVERHEAD），
+	*       分组满时同时生成校验分片，通过 GetParityCount() / GetParity() 获取（直到下次调用 Encode()）
+	*/
+	const BYTE* Encode(const BYTE* pData, int iLength);
+
+	/*
+	* 结束未满的分组：为当前分组已有的数据分片生成校验分片，通过 GetParityCount() / GetParity() 获取，
+	*       当前分组没有数据分片时返回 FALSE
+	*/
+	BOOL Flush();
+
+	int GetParityCount() const	{return m_iParityReady;}
+	const BYTE* GetParity(int i, int& iLength) const;
+
+	/* 当前分组已编码的数据分片数 */
+	int GetPendingCount() const	{return m_iShardIndex;}
+
+	BOOL IsValid() const		{return m_iMaxDatagram > 0;}
+
+private:
+	void EncodeParity(int iDataShards);
+	BYTE* GetPacket(int i) const	{return m_buffer.get() + i * m_iPacketSize;}
+
+public:
+	CFecEncoder() : m_iMaxDatagram(0), m_iPacketSize(0), m_dwGroup(0), m_iShardIndex(0), m_iMaxShard(0), m_iParityLen(0), m_iParityReady(0) {}
+
+	DECLARE_NO_COPY_CLASS(CFecEncoder)
+
+private:
+	CRSCodec	m_codec;
+
+	int			m_iMaxDatagram;
+	int			m_iPacketSize;
+
+	DWORD		m_dwGroup;
+	int			m_iShardIndex;
+	int			m_iMaxShard;
+	int			m_iParityLen;
+	int			m_iParityReady;
+
+	/* (K + M) 个分片缓冲区，每个分片缓冲区包含分片头 */
+	unique_ptr<BYTE[]>	m_buffer;
+	/* 各分片缓冲区中分片数据（数据分片头或校验分片头之后）的位置 */
+	unique_ptr<BYTE*[]>	m_shards;
+};
+
+/************************************************************************
+名称：FEC 解码器
+描述：数据分片立即输出；分组内收到的分片数达到 K 个且有数据分片丢失时，恢复并输出丢失的数据分片
+	  未满的分组从校验分片中获得数据分片数，缺少的数据分片作为已收到的空分片计数
+	  缓存最近 FEC_DECODE_GROUPS 个分组（只保存分片数据，不含分片头），分组缓冲区在首次使用时分配
+************************************************************************/
+class CFecDecoder
+{
+private:
+	struct TGroup
+	{
+		DWORD	id;
+		BOOL	used;
+		BOOL	done;
+		int		count;
+		int		parityLen;
+		int		dataShards;
+
+		unique_ptr<BYTE[]>	buffer;
+		unique_ptr<BYTE*[]>	shards;
+		unique_ptr<BOOL[]>	present;
+		unique_ptr<int[]>	lengths;
+	};
+
+public:
+	BOOL Init(int iDataShards, int iParityShards, int iMaxDatagram);
+	void Reset();
+
+	/*
+	* 解码分片：对分片中的数据报及恢复的数据报依次调用 fnOutput(const BYTE* pData, int iLength)
+	*       分片格式错误返回 FALSE，fnOutput 返回 FALSE 时停止输出并返回 FALSE
+	*/
+	template<typename _Fn> BOOL Decode(const BYTE* pPacket, int iLength, _Fn&& fnOutput)
+	{
+		int iIndex;
+		TGroup* pGroup;
+
+		if(!Accept(pPacket, iLength, iIndex, pGroup))
+			return FALSE;
+
+		//重复分片
+		if(iIndex < 0)
+			return TRUE;
+
+		if(iIndex < m_codec.GetDataShards())
+		{
+			if(!fnOutput(pPacket + FEC_OVERHEAD, iLength - FEC_OVERHEAD))
+				return FALSE;
+		}
+
+		if(pGroup == nullptr || pGroup->done || pGroup->count < m_codec.GetDataShards())
+			return TRUE;
+
+		int iFirst = RecoverGroup(pGroup);
+
+		for(int i = iFirst; i >= 0 && i < m_codec.GetDataShards(); i++)
+		{
+			if(pGroup->lengths[i] >= 0)
+				continue;
+
+			const BYTE* pShard	= pGroup->shards[i];
+			int iDatagram		= ReadSizeField(pShard);
+
+			if(iDatagram <= 0 || iDatagram + FEC_SIZE_FIELD_SIZE > pGroup->parityLen)
+				continue;
+
+			if(!fnOutput(pShard + FEC_SIZE_FIELD_SIZE, iDatagram))
+				return FALSE;
+		}
+
+		return TRUE;
+	}
+
+	BOOL IsValid() const	{return m_iMaxDatagram > 0;}
+
+private:
+	/* 读取数据报长度字段（分片数据不保证按 2 字节对齐） */
+	static int ReadSizeField(const BYTE* p)	{UINT16 size; memcpy(&size, p, sizeof(size)); return size;}
+
+	/*
+	* 校验分片并存入分组缓存：分片格式错误返回 FALSE；重复分片 iIndex 为 -1；
+	*       过期分组（已移出缓存）的分片 pGroup 为 nullptr
+	*/
+	BOOL Accept(const BYTE* pPacket, int iLength, int& iIndex, TGroup*& pGroup);
+	/* 恢复分组中丢失的数据分片：返回第一个恢复的数据分片序号，无需恢复或无法恢复时返回 -1 */
+	int RecoverGroup(TGroup* pGroup);
+	void PrepareGroup(TGroup* pGroup, DWORD dwID);
+
+public:
+	CFecDecoder() : m_iMaxDatagram(0), m_iPacketSize(0) {}
+
+	DECLARE_NO_COPY_CLASS(CFecDecoder)
+
+private:
+	CRSCodec	m_codec;
+
+	int			m_iMaxDatagram;
+	int			m_iPacketSize;
+
+	TGroup		m_groups[FEC_DECODE_GROUPS];
+};
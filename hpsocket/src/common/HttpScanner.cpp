@@ -0,0 +1,451 @@
+﻿/*
+* Copyright: JessMA Open Source (ldcsaa@gmail.com)
+*
+* Author	: Bruce Liang
+* Website	: https://github.com/ldcsaa
+* Project	: https://github.com/ldcsaa/HP-Socket
+* Blog		: http://www.cnblogs.com/ldcsaa
+* Wiki		: http://www.oschina.net/p/hp-socket
+* QQ Group	: 44636872, 75375912
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "HttpScanner.h"
+#include "FuncHelper.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+	#include <immintrin.h>
+	#define _HTTP_SIMD_X86
+#elif defined(__aarch64__)
+	#include <arm_neon.h>
+	#define _HTTP_SIMD_NEON
+#endif
+
+/*
+* 批量扫描实现：从 p 开始按向量长度扫描，返回第一个分界字符的位置，
+* 或剩余数据不足一个向量时的位置（由标量实现继续扫描）
+*/
+using Fn_HttpScanKernel = int (*)(const BYTE* p, int iLength, const BYTE* pNibbles);
+
+enum EnHttpScanKernel
+{
+	HSK_HEAD_END	= 0,
+	HSK_TOKEN_END	= 1,
+	HSK_URL_END		= 2,
+	HSK_VALUE_END	= 3,
+	HSK_MAX			= 4
+};
+
+static int HttpScanNone(const BYTE* p, int iLength, const BYTE* pNibbles)
+{
+	return 0;
+}
+
+#if defined(_HTTP_SIMD_X86)
+
+__attribute__((target("sse4.2")))
+static int HttpScanHeadEndSSE42(const BYTE* p, int iLength, const BYTE* pNibbles)
+{
+	const __m128i cr = _mm_set1_epi8('\r');
+	const __m128i lf = _mm_set1_epi8('\n');
+
+	int i = 3;
+
+	for(; i + 16 <= iLength; i += 16)
+	{
+		__m128i m1 = _mm_and_si128(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(p + i)), lf), _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(p + i - 1)), cr));
+		__m128i m2 = _mm_and_si128(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(p + i - 2)), lf), _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(p + i - 3)), cr));
+		UINT bits = (UINT)_mm_movemask_epi8(_mm_and_si128(m1, m2));
+
+		if(bits != 0)
+			return i + __builtin_ctz(bits);
+	}
+
+	return i;
+}
+
+__attribute__((target("sse4.2")))
+static int HttpScanTokenEndSSE42(const BYTE* p, int iLength, const BYTE* pNibbles)
+{
+	const __m128i low	= _mm_loadu_si128((const __m128i*)pNibbles);
+	const __m128i high	= _mm_loadu_si128((const __m128i*)(pNibbles + 16));
+	const __m128i mask	= _mm_set1_epi8(0x0F);
+	const __m128i zero	= _mm_setzero_si128();
+
+	int i = 0;
+
+	for(; i + 16 <= iLength; i += 16)
+	{
+		__m128i x = _mm_loadu_si128((const __m128i*)(p + i));
+		__m128i l = _mm_shuffle_epi8(low, _mm_and_si128(x, mask));
+		__m128i h = _mm_shuffle_epi8(high, _mm_and_si128(_mm_srli_epi16(x, 4), mask));
+		UINT bits = (UINT)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(l, h), zero));
+
+		if(bits != 0)
+			return i + __builtin_ctz(bits);
+	}
+
+	return i;
+}
+
+__attribute__((target("sse4.2")))
+static int HttpScanUrlEndSSE42(const BYTE* p, int iLength, const BYTE* pNibbles)
+{
+	const __m128i lo = _mm_set1_epi8(0x21);
+	const __m128i hi = _mm_set1_epi8(0x7E);
+
+	int i = 0;
+
+	for(; i + 16 <= iLength; i += 16)
+	{
+		__m128i x = _mm_loadu_si128((const __m128i*)(p + i));
+		__m128i v = _mm_and_si128(_mm_cmpeq_epi8(_mm_max_epu8(x, lo), x), _mm_cmpeq_epi8(_mm_min_epu8(x, hi), x));
+		UINT bits = ~(UINT)_mm_movemask_epi8(v) & 0xFFFF;
+
+		if(bits != 0)
+			return i + __builtin_ctz(bits);
+	}
+
+	return i;
+}
+
+__attribute__((target("sse4.2")))
+static int HttpScanValueEndSSE42(const BYTE* p, int iLength, const BYTE* pNibbles)
+{
+	const __m128i ctl = _mm_set1_epi8(0x1F);
+	const __m128i tab = _mm_set1_epi8('\t');
+	const __m128i del = _mm_set1_epi8(0x7F);
+
+	int i = 0;
+
+	for(; i + 16 <= iLength; i += 16)
+	{
+		__m128i x = _mm_loadu_si128((const __m128i*)(p + i));
+		__m128i c = _mm_andnot_si128(_mm_cmpeq_epi8(x, tab), _mm_cmpeq_epi8(_mm_min_epu8(x, ctl), x));
+		UINT bits = (UINT)_mm_movemask_epi8(_mm_or_si128(c, _mm_cmpeq_epi8(x, del)));
+
+		if(bits != 0)
+			return i + __builtin_ctz(bits);
+	}
+
+	return i;
+}
+
+__attribute__((target("avx2")))
+static int HttpScanHeadEndAVX2(const BYTE* p, int iLength, const BYTE* pNibbles)
+{
+	const __m256i cr = _mm256_set1_epi8('\r');
+	const __m256i lf = _mm256_set1_epi8('\n');
+
+	int i = 3;
+
+	for(; i + 32 <= iLength; i += 32)
+	{
+		__m256i m1 = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(p + i)), lf), _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(p + i - 1)), cr));
+		__m256i m2 = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(p + i - 2)), lf), _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(p + i - 3)), cr));
+		UINT bits = (UINT)_mm256_movemask_epi8(_mm256_and_si256(m1, m2));
+
+		if(bits != 0)
+			return i + __builtin_ctz(bits);
+	}
+
+	return i;
+}
+
+__attribute__((target("avx2")))
+static int HttpScanTokenEndAVX2(const BYTE* p, int iLength, const BYTE* pNibbles)
+{
+	const __m256i low	= _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)pNibbles));
+	const __m256i high	= _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(pNibbles + 16)));
+	const __m256i mask	= _mm256_set1_epi8(0x0F);
+	const __m256i zero	= _mm256_setzero_si256();
+
+	int i = 0;
+
+	for(; i + 32 <= iLength; i += 32)
+	{
+		__m256i x = _mm256_loadu_si256((const __m256i*)(p + i));
+		__m256i l = _mm256_shuffle_epi8(low, _mm256_and_si256(x, mask));
+		__m256i h = _mm256_shuffle_epi8(high, _mm256_and_si256(_mm256_srli_epi16(x, 4), mask));
+		UINT bits = (UINT)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(l, h), zero));
+
+		if(bits != 0)
+			return i + __builtin_ctz(bits);
+	}
+
+	return i;
+}
+
+__attribute__((target("avx2")))
+static int HttpScanUrlEndAVX2(const BYTE* p, int iLength, const BYTE* pNibbles)
+{
+	const __m256i lo = _mm256_set1_epi8(0x21);
+	const __m256i hi = _mm256_set1_epi8(0x7E);
+
+	int i = 0;
+
+	for(; i + 32 <= iLength; i += 32)
+	{
+		__m256i x = _mm256_loadu_si256((const __m256i*)(p + i));
+		__m256i v = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_max_epu8(x, lo), x), _mm256_cmpeq_epi8(_mm256_min_epu8(x, hi), x));
+		UINT bits = ~(UINT)_mm256_movemask_epi8(v);
+
+		if(bits != 0)
+			return i + __builtin_ctz(bits);
+	}
+
+	return i;
+}
+
+__attribute__((target("avx2")))
+static int HttpScanValueEndAVX2(const BYTE* p, int iLength, const BYTE* pNibbles)
+{
+	const __m256i ctl = _mm256_set1_epi8(0x1F);
+	const __m256i tab = _mm256_set1_epi8('\t');
+	const __m256i del = _mm256_set1_epi8(0x7F);
+
+	int i = 0;
+
+	for(; i + 32 <= iLength; i += 32)
+	{
+		__m256i x = _mm256_loadu_si256((const __m256i*)(p + i));
+		__m256i c = _mm256_andnot_si256(_mm256_cmpeq_epi8(x, tab), _mm256_cmpeq_epi8(_mm256_min_epu8(x, ctl), x));
+		UINT bits = (UINT)_mm256_movemask_epi8(_mm256_or_si256(c, _mm256_cmpeq_epi8(x, del)));
+
+		if(bits != 0)
+			return i + __builtin_ctz(bits);
+	}
+
+	return i;
+}
+
+#elif defined(_HTTP_SIMD_NEON)
+
+/* 比较结果（每字节 0x00 / 0xFF）压缩为 64 位掩码，每个字节对应 4 位 */
+static inline ULLONG NeonMask(uint8x16_t m)
+{
+	return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(m), 4)), 0);
+}
+
+static int HttpScanHeadEndNEON(const BYTE* p, int iLength, const BYTE* pNibbles)
+{
+	const uint8x16_t cr = vdupq_n_u8('\r');
+	const uint8x16_t lf = vdupq_n_u8('\n');
+
+	int i = 3;
+
+	for(; i + 16 <= iLength; i += 16)
+	{
+		uint8x16_t m = vandq_u8(vandq_u8(vceqq_u8(vld1q_u8(p + i), lf), vceqq_u8(vld1q_u8(p + i - 1), cr)),
+								vandq_u8(vceqq_u8(vld1q_u8(p + i - 2), lf), vceqq_u8(vld1q_u8(p + i - 3), cr)));
+		ULLONG bits = NeonMask(m);
+
+		if(bits != 0)
+			return i + (__builtin_ctzll(bits) >> 2);
+	}
+
+	return i;
+}
+
+static int HttpScanTokenEndNEON(const BYTE* p, int iLength, const BYTE* pNibbles)
+{
+	const uint8x16_t low	= vld1q_u8(pNibbles);
+	const uint8x16_t high	= vld1q_u8(pNibbles + 16);
+	const uint8x16_t mask	= vdupq_n_u8(0x0F);
+
+	int i = 0;
+
+	for(; i + 16 <= iLength; i += 16)
+	{
+		uint8x16_t x = vld1q_u8(p + i);
+		uint8x16_t l = vqtbl1q_u8(low, vandq_u8(x, mask));
+		uint8x16_t h = vqtbl1q_u8(high, vshrq_n_u8(x, 4));
+		ULLONG bits	 = NeonMask(vceqq_u8(vandq_u8(l, h), vdupq_n_u8(0)));
+
+		if(bits != 0)
+			return i + (__builtin_ctzll(bits) >> 2);
+	}
+
+	return i;
+}
+
+static int HttpScanUrlEndNEON(const BYTE* p, int iLength, const BYTE* pNibbles)
+{
+	int i = 0;
+
+	for(; i + 16 <= iLength; i += 16)
+	{
+		uint8x16_t x = vld1q_u8(p + i);
+		uint8x16_t m = vorrq_u8(vcltq_u8(x, vdupq_n_u8(0x21)), vcgtq_u8(x, vdupq_n_u8(0x7E)));
+		ULLONG bits	 = NeonMask(m);
+
+		if(bits != 0)
+			return i + (__builtin_ctzll(bits) >> 2);
+	}
+
+	return i;
+}
+
+static int HttpScanValueEndNEON(const BYTE* p, int iLength, const BYTE* pNibbles)
+{
+	int i = 0;
+
+	for(; i + 16 <= iLength; i += 16)
+	{
+		uint8x16_t x = vld1q_u8(p + i);
+		uint8x16_t c = vbicq_u8(vcltq_u8(x, vdupq_n_u8(0x20)), vceqq_u8(x, vdupq_n_u8('\t')));
+		uint8x16_t m = vorrq_u8(c, vceqq_u8(x, vdupq_n_u8(0x7F)));
+		ULLONG bits	 = NeonMask(m);
+
+		if(bits != 0)
+			return i + (__builtin_ctzll(bits) >> 2);
+	}
+
+	return i;
+}
+
+#endif
+
+struct THttpScanTables
+{
+	/* RFC 7230 tchar */
+	BOOL tokens[256];
+	/* token 半字节查表：低半字节表的第 h 位表示 (h << 4 | l) 为 token，高半字节表为 (1 << h)（h >= 8 时为 0） */
+	BYTE nibbles[32];
+
+	Fn_HttpScanKernel kernels[HSK_MAX];
+	LPCSTR kernelName;
+
+	THttpScanTables()
+	{
+		static const char s_szTokenChars[] = "!#$%&'*+-.^_`|~";
+
+		for(int c = 0; c < 256; c++)
+			tokens[c] = (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c != 0 && strchr(s_szTokenChars, c) != nullptr);
+
+		::ZeroMemory(nibbles, sizeof(nibbles));
+
+		for(int c = 0; c < 0x80; c++)
+		{
+			if(tokens[c])
+				nibbles[c & 0x0F] |= (BYTE)(1 << (c >> 4));
+		}
+
+		for(int h = 0; h < 8; h++)
+			nibbles[16 + h] = (BYTE)(1 << h);
+
+		for(int i = 0; i < HSK_MAX; i++)
+			kernels[i] = HttpScanNone;
+
+		kernelName = "scalar";
+
+#if defined(_HTTP_SIMD_X86)
+		__builtin_cpu_init();
+
+		if(__builtin_cpu_supports("avx2"))
+		{
+			kernels[HSK_HEAD_END]	= HttpScanHeadEndAVX2;
+			kernels[HSK_TOKEN_END]	= HttpScanTokenEndAVX2;
+			kernels[HSK_URL_END]	= HttpScanUrlEndAVX2;
+			kernels[HSK_VALUE_END]	= HttpScanValueEndAVX2;
+			kernelName				= "avx2";
+		}
+		else if(__builtin_cpu_supports("sse4.2"))
+		{
+			kernels[HSK_HEAD_END]	= HttpScanHeadEndSSE42;
+			kernels[HSK_TOKEN_END]	= HttpScanTokenEndSSE42;
+			kernels[HSK_URL_END]	= HttpScanUrlEndSSE42;
+			kernels[HSK_VALUE_END]	= HttpScanValueEndSSE42;
+			kernelName				= "sse4.2";
+		}
+#elif defined(_HTTP_SIMD_NEON)
+		kernels[HSK_HEAD_END]	= HttpScanHeadEndNEON;
+		kernels[HSK_TOKEN_END]	= HttpScanTokenEndNEON;
+		kernels[HSK_URL_END]	= HttpScanUrlEndNEON;
+		kernels[HSK_VALUE_END]	= HttpScanValueEndNEON;
+		kernelName				= "neon";
+#endif
+	}
+};
+
+static const THttpScanTables& HttpScanTables()
+{
+	static const THttpScanTables s_tables;
+	return s_tables;
+}
+
+int CHttpScanner::FindHeadEnd(const char* p, int iLength)
+{
+	const THttpScanTables& tables = HttpScanTables();
+
+	const BYTE* s	= (const BYTE*)p;
+	int i			= MAX(tables.kernels[HSK_HEAD_END](s, iLength, tables.nibbles), 3);
+
+	for(; i < iLength; i++)
+	{
+		if(s[i] == '\n' && s[i - 1] == '\r' && s[i - 2] == '\n' && s[i - 3] == '\r')
+			return i + 1;
+	}
+
+	return -1;
+}
+
+int CHttpScanner::FindTokenEnd(const char* p, int iLength)
+{
+	const THttpScanTables& tables = HttpScanTables();
+
+	const BYTE* s	= (const BYTE*)p;
+	int i			= tables.kernels[HSK_TOKEN_END](s, iLength, tables.nibbles);
+
+	while(i < iLength && tables.tokens[s[i]])
+		++i;
+
+	return i;
+}
+
+int CHttpScanner::FindUrlEnd(const char* p, int iLength)
+{
+	const THttpScanTables& tables = HttpScanTables();
+
+	const BYTE* s	= (const BYTE*)p;
+	int i			= tables.kernels[HSK_URL_END](s, iLength, tables.nibbles);
+
+	while(i < iLength && s[i] >= 0x21 && s[i] <= 0x7E)
+		++i;
+
+	return i;
+}
+
+int CHttpScanner::FindValueEnd(const char* p, int iLength)
+{
+	const THttpScanTables& tables = HttpScanTables();
+
+	const BYTE* s	= (const BYTE*)p;
+	int i			= tables.kernels[HSK_VALUE_END](s, iLength, tables.nibbles);
+
+	while(i < iLength && (s[i] >= 0x20 || s[i] == '\t') && s[i] != 0x7F)
+		++i;
+
+	return i;
+}
+
+BOOL CHttpScanner::IsToken(char c)
+{
+	return HttpScanTables().tokens[(BYTE)c];
+}
+
+LPCSTR CHttpScanner::GetKernelName()
+{
+	return HttpScanTables().kernelName;
+}
@@ -0,0 +1,52 @@
+﻿/*
+* Copyright: JessMA Open Source (ldcsaa@gmail.com)
+*
+* Author	: Bruce Liang
+* Website	: https://github.com/ldcsaa
+* Project	: https://github.com/ldcsaa/HP-Socket
+* Blog		: http://www.cnblogs.com/ldcsaa
+* Wiki		: http://www.oschina.net/p/hp-socket
+* QQ Group	: 44636872, 75375912
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#pragma once
+
+#include "GlobalDef.h"
+
+/************************************************************************
+名称：HTTP 报文扫描
+描述：批量查找 HTTP 报文头中的分界字符；根据平台选择 AVX2（每次 32 字节）/ SSE4.2 / NEON（每次 16 字节）实现，
+	  否则使用标量查表实现
+************************************************************************/
+class CHttpScanner
+{
+public:
+	/* 查找报文头结束位置（"\r\n\r\n" 之后的位置），找不到返回 -1 */
+	static int FindHeadEnd(const char* p, int iLength);
+	/* 查找第一个非 token 字符（RFC 7230 tchar），找不到返回 iLength */
+	static int FindTokenEnd(const char* p, int iLength);
+	/* 查找 URL 结束位置：第一个空格、控制字符或非 ASCII 字符，找不到返回 iLength */
+	static int FindUrlEnd(const char* p, int iLength);
+	/* 查找头部值结束位置：第一个控制字符（水平制表符除外），找不到返回 iLength */
+	static int FindValueEnd(const char* p, int iLength);
+
+	static BOOL IsToken(char c);
+
+	/* 获取当前使用的扫描实现名称 */
+	static LPCSTR GetKernelName();
+
+private:
+	CHttpScanner() = delete;
+};
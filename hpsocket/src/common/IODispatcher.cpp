@@ -29,6 +29,11 @@
 #include "MessagePipe.h"
 #include "TimerPipe.h"
 
+/* 当前分发线程在所属分发器中的序号（-1：非分发线程） */
+static thread_local int s_iDispatchWorker = -1;
+/* 当前分发线程的就绪队列（nullptr：非分发线程） */
+static thread_local void* s_pReadyList = nullptr;
+
 BOOL CIODispatcher::Start(IIOHandler *pHandler, int iWorkerMaxEvents, int iWorkers, LLONG llTimerInterval)
 {
 	ASSERT_CHECK_EINVAL(pHandler && iWorkerMaxEvents >= 0 && iWorkers >= 0);
@@ -82,6 +87,9 @@ BOOL CIODispatcher::Start(IIOHandler *pHandler, int iWorkerMaxEvents, int iWorke
 
 	VERIFY_IS_NO_ERROR(pthread_sigmask(SIG_BLOCK, &ss, nullptr));
 
+	m_tracer.Init(m_iWorkers);
+	m_iWorkerSeq = 0;
+
 	m_pWorkers = make_unique<CWorkerThread[]>(m_iWorkers);
 
 	for (int i = 0; i < m_iWorkers; i++)
@@ -183,52 +191,144 @@ BOOL CIODispatcher::CtlFD(FD fd, int op, UINT mask, PVOID pv)
 
 int CIODispatcher::WorkerProc(PVOID pv)
 {
+	s_iDispatchWorker = m_iWorkerSeq.fetch_add(1);
+
     m_pHandler->OnDispatchThreadStart(SELF_THREAD_ID);
 	BOOL bRun = TRUE;
 	unique_ptr<struct kevent[]> pEvents = make_unique<struct kevent[]>(m_iMaxEvents);
 
+	TReadyList ready(this);
+	s_pReadyList = &ready;
+
 	while (bRun)
 	{
+		ULLONG ullWait = m_tracer.IsEnabled() ? ::TimeGetNanos() : 0;
+
 		int rs = kevent(m_kque, NULL, NULL, pEvents.get(), m_iMaxEvents, NULL);
 		if (rs <= TIMEOUT)
 			ERROR_ABORT();
 
-		for (int i = 0; i < rs; i++)
-		{
-			//触发的文件描述符
-			uintptr_t fd = pEvents[i].ident;
+		//处理本批事件期间登记纪元，防止事件引用的 Socket 对象被回收
+		CEpochLock epochlock;
 
-			//触发的事件
-			UINT events = pEvents[i].filter;
+		BOOL bMetrics	= (m_pMetrics && m_pMetrics->IsEnabled());
+		ULLONG ullBegin	= (bMetrics || ullWait != 0) ? ::TimeGetNanos() : 0;
 
-			//附加Custom数据
-			PVOID ptr = pEvents[i].udata;
+		bRun = ProcessEvents(pEvents.get(), rs);
 
-			//可能被设置EV_OOBAND(具有外带数据)，当被shutdown时此项为EV_EOF
-			uint16_t flags = pEvents[i].flags;
+		//就绪队列中的对象在同一纪元内处理（其间不会被回收）。从第二轮开始先无等待地收取新事件，
+		//使新事件与被推迟的连接轮流处理；最后一轮关闭就绪队列，剩余对象重新注册事件，纪元占用时间有界
+		for (int i = 0; bRun && !ready.items.empty(); i++)
+		{
+			if (i > 0)
+			{
+				static const timespec ZERO_TIMEOUT = {0, 0};
 
-			//socket error (if any) in fflags，当socket出现error(EVFILT_EXCEPT)会被设置
-			uint32_t fflags = pEvents[i].fflags;
+				int rs2 = kevent(m_kque, NULL, NULL, pEvents.get(), m_iMaxEvents, &ZERO_TIMEOUT);
 
-			//触发的byte字节数，当为listen套接字时为待接收的连接数量
-			intptr_t count = pEvents[i].data;
+				if (rs2 > 0)
+				{
+					rs	+= rs2;
+					bRun = ProcessEvents(pEvents.get(), rs2);
+				}
+			}
 
-			if (ptr == &m_evTimer)
-				ProcessTimer(&count, events);
-			else if (ptr == m_evCmd)
-				ProcessCommand(events);
-			else if (ptr == m_evExit)
-				bRun = ProcessExit(events);
-			else
-				ProcessIo(ptr, events, flags);
+			if (bRun)
+				ProcessReady(ready, i + 1 >= MAX_READY_ROUNDS);
+		}
+
+		ready.items.clear();
+
+		if (ullBegin != 0)
+		{
+			ULLONG ullBusy = ::TimeGetNanos() - ullBegin;
+
+			if (bMetrics)
+			{
+				m_pMetrics->Add(CIOMetrics::IMC_LOOPS);
+				m_pMetrics->Add(CIOMetrics::IMC_IO_EVENTS, rs);
+				m_pMetrics->Record(CIOMetrics::IMH_LOOP, ullBusy);
+			}
+
+			//等待耗时以本轮开始等待为起点：跟踪在等待期间被开启时本轮不计入
+			if (ullWait != 0)
+				m_tracer.OnLoop(s_iDispatchWorker, ullBegin - ullWait, ullBusy, rs);
 		}
 	}
 
+	s_pReadyList = nullptr;
+
     m_pHandler->OnDispatchThreadEnd(SELF_THREAD_ID);
 
 	return 0;
 }
 
+BOOL CIODispatcher::ProcessEvents(struct kevent* pEvents, int iCount)
+{
+	BOOL bRun = TRUE;
+
+	for (int i = 0; i < iCount; i++)
+	{
+		//触发的文件描述符
+		uintptr_t fd = pEvents[i].ident;
+
+		//触发的事件
+		UINT events = pEvents[i].filter;
+
+		//附加Custom数据
+		PVOID ptr = pEvents[i].udata;
+
+		//可能被设置EV_OOBAND(具有外带数据)，当被shutdown时此项为EV_EOF
+		uint16_t flags = pEvents[i].flags;
+
+		//socket error (if any) in fflags，当socket出现error(EVFILT_EXCEPT)会被设置
+		uint32_t fflags = pEvents[i].fflags;
+
+		//触发的byte字节数，当为listen套接字时为待接收的连接数量
+		intptr_t count = pEvents[i].data;
+
+		if (ptr == &m_evTimer)
+			ProcessTimer(&count, events);
+		else if (ptr == m_evCmd)
+			ProcessCommand(events);
+		else if (ptr == m_evExit)
+			bRun = ProcessExit(events);
+		else
+			ProcessIo(ptr, events, flags);
+	}
+
+	return bRun;
+}
+
+VOID CIODispatcher::ProcessReady(TReadyList& ready, BOOL bLast)
+{
+	ready.current.swap(ready.items);
+	ready.closed = bLast;
+
+	for (auto it = ready.current.begin(), end = ready.current.end(); it != end; ++it)
+	{
+		if (it->flags & DISP_EVENT_FLAG_R)
+			ProcessIo(it->ptr, EVFILT_READ, KEVENT_FLAG_NONE);
+		if (it->flags & DISP_EVENT_FLAG_W)
+			ProcessIo(it->ptr, EVFILT_WRITE, KEVENT_FLAG_NONE);
+	}
+
+	ready.current.clear();
+	ready.closed = FALSE;
+}
+
+BOOL CIODispatcher::DeferIo(PVOID ptr, UINT uFlags)
+{
+	TReadyList* pReady = (TReadyList*)s_pReadyList;
+
+	if (pReady == nullptr || pReady->owner != this || pReady->closed)
+		return FALSE;
+
+	pReady->items.push_back({ptr, uFlags});
+
+	return TRUE;
+}
+
 BOOL CIODispatcher::ProcessCommand(UINT events)
 {
 	if (events == EVFILT_EXCEPT)
@@ -246,12 +346,21 @@ BOOL CIODispatcher::ProcessCommand(UINT events)
 		ASSERT(cTmp > 0);
 
 		TDispCommand *pCmd = nullptr;
+		ULLONG ullCount = 0;
+
+		if (m_pMetrics && m_pMetrics->IsEnabled())
+			m_pMetrics->Record(CIOMetrics::IMH_COMMAND_QUEUE, m_queue.Size());
 
 		while (m_queue.PopFront(&pCmd))
 		{
 			m_pHandler->OnCommand(pCmd);
 			TDispCommand::Destruct(pCmd);
+
+			++ullCount;
 		}
+
+		if (m_pMetrics)
+			m_pMetrics->Add(CIOMetrics::IMC_COMMANDS, ullCount);
 	}
 	else
 	{
@@ -303,12 +412,26 @@ BOOL CIODispatcher::ProcessExit(UINT events)
 
 BOOL CIODispatcher::ProcessIo(PVOID ptr, UINT events, uint16_t flags)
 {
+	ULLONG ullBegin = m_tracer.IsEnabled() ? ::TimeGetNanos() : 0;
+
 	if (!m_pHandler->OnBeforeProcessIo(ptr, events, flags))
+	{
+		//如监听 Socket 在 OnBeforeProcessIo() 中直接接受连接，也计入跟踪（对象标识为 0）
+		if (ullBegin != 0)
+			m_tracer.OnEvent(s_iDispatchWorker, ullBegin, ::TimeGetNanos() - ullBegin, 0, events, flags);
+
 		return FALSE;
+	}
+
+	//对象标识须在处理前取得：处理过程中对象可能被关闭并复用
+	UINT_PTR id = (ullBegin != 0) ? m_pHandler->GetTraceID(ptr, events) : 0;
 
 	BOOL rs = DoProcessIo(ptr, events, flags);
 	m_pHandler->OnAfterProcessIo(ptr, events, rs);
 
+	if (ullBegin != 0)
+		m_tracer.OnEvent(s_iDispatchWorker, ullBegin, ::TimeGetNanos() - ullBegin, id, events, flags);
+
 	return rs;
 }
 
@@ -346,6 +469,17 @@ uint32_t CIODispatcher::AddTimer(LLONG llInterval, PVOID pv)
 	return 0;
 }
 
+BOOL CIODispatcher::SetTimer(uint32_t fdTimer, LLONG llInterval, PVOID pv)
+{
+	if (fdTimer == 0 || llInterval < 0)
+		return FALSE;
+
+	struct kevent event;
+	EV_SET(&event, fdTimer, EVFILT_TIMER, EV_ADD | EV_ONESHOT, NOTE_USECONDS, MAX(llInterval, 1LL) * int64_t(1000), pv);
+
+	return kevent(m_kque, &event, 1, nullptr, 0, nullptr) >= 0;
+}
+
 BOOL CIODispatcher::DelTimer(uint32_t fdTimer)
 {
 	BOOL isOK = FALSE;
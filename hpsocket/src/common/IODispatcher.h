@@ -27,6 +27,7 @@
 #include "Singleton.h"
 #include "RingBuffer.h"
 #include "Thread.h"
+#include "Metrics.h"
 
 #include "MessagePipe.h"
 #include "Event.h"
@@ -36,6 +37,7 @@
 #include <sys/types.h>
 
 #include <memory>
+#include <vector>
 
 using namespace std;
 
@@ -90,6 +92,9 @@ public:
 	virtual VOID OnDispatchThreadStart(THR_ID tid)					= 0;
 	virtual VOID OnDispatchThreadEnd(THR_ID tid)					= 0;
 
+	/* 事件循环跟踪：返回事件所属对象标识（如连接 ID），在 OnBeforeProcessIo() 成功后调用 */
+	virtual UINT_PTR GetTraceID(PVOID pv, UINT events)				= 0;
+
 public:
 	virtual ~IIOHandler() = default;
 };
@@ -108,6 +113,7 @@ public:
 	virtual BOOL OnReadyPrivilege(PVOID pv, UINT events)			override {return TRUE;}
 	virtual VOID OnDispatchThreadStart(THR_ID tid)					override {}
 	virtual VOID OnDispatchThreadEnd(THR_ID tid)					override {}
+	virtual UINT_PTR GetTraceID(PVOID pv, UINT events)				override {return 0;}
 };
 
 // ------------------------------------------------------------------------------------------------------------------------------------------------------- //
@@ -116,6 +122,8 @@ class CIODispatcher
 {
 public:
 	static const int DEF_WORKER_MAX_EVENTS	= 64;
+	/* 每批事件后处理就绪队列的最大轮数 */
+	static const int MAX_READY_ROUNDS		= 8;
 
 	using CCommandQueue	= CCASQueue<TDispCommand>;
 	using CWorkerThread	= CThread<CIODispatcher, VOID, int>;
@@ -149,10 +157,44 @@ public:
 	BOOL CtlFD(FD fd, int op, UINT mask, PVOID pv);
     BOOL ProcessIo(PVOID ptr, UINT events, uint16_t flags);
 
+	/*
+	* 名称：推迟处理 IO 事件
+	* 描述：把因读写预算用尽而未处理完的对象放入当前工作线程的就绪队列，本批事件处理完成后
+	*		在同一纪元内以 ProcessIo() 重新处理，代替重新注册事件
+	*		
+	* 参数：		ptr		-- 事件关联对象
+	*			uFlags	-- 待处理事件（DISP_EVENT_FLAG_R / DISP_EVENT_FLAG_W）
+	* 返回值：	TRUE	-- 成功
+	*			FALSE	-- 非本分发器工作线程或就绪队列已关闭（最后一轮），调用方须自行重新注册事件
+	*/
+	BOOL DeferIo(PVOID ptr, UINT uFlags);
+
 	uint32_t AddTimer		(LLONG llInterval, PVOID pv);
 	BOOL DelTimer	(uint32_t fdTimer);
+	/* 设置单次定时器（毫秒，相同标识的定时器被替换） */
+	BOOL SetTimer	(uint32_t fdTimer, LLONG llInterval, PVOID pv);
+private:
+	struct TReadyIo
+	{
+		PVOID	ptr;
+		UINT	flags;
+	};
+
+	/* 工作线程就绪队列 */
+	struct TReadyList
+	{
+		CIODispatcher*		owner;
+		BOOL				closed;
+		vector<TReadyIo>	items;
+		vector<TReadyIo>	current;
+
+		TReadyList(CIODispatcher* pOwner) : owner(pOwner), closed(FALSE) {}
+	};
+
 private:
 	int WorkerProc(PVOID pv = nullptr);
+	BOOL ProcessEvents(struct kevent* pEvents, int iCount);
+	VOID ProcessReady(TReadyList& ready, BOOL bLast);
 	BOOL ProcessExit(UINT events);
     BOOL ProcessTimer(PVOID ptr, UINT events);
 	BOOL ProcessCommand(UINT events);
@@ -164,7 +206,14 @@ public:
 	BOOL HasStarted()	{return m_pHandler && m_pWorkers;}
 	const CWorkerThread* GetWorkerThreads() {return m_pWorkers.get();}
 
-	CIODispatcher()		{Reset();}
+	/* 设置运行时度量对象（事件循环耗时、事件数与命令队列深度写入其中） */
+	VOID SetMetrics(CIOMetrics* pMetrics)	{m_pMetrics = pMetrics;}
+	UINT GetCommandQueueSize()				{return m_queue.Size();}
+
+	/* 事件循环跟踪器（设置慢回调阈值后开始记录工作线程繁忙率与慢事件） */
+	CLoopTracer& GetLoopTracer()			{return m_tracer;}
+
+	CIODispatcher() : m_pMetrics(nullptr)	{Reset();}
 	~CIODispatcher()	{if(HasStarted()) Stop();}
 
 private:
@@ -178,4 +227,8 @@ private:
 
 	CCommandQueue				m_queue;
 	unique_ptr<CWorkerThread[]>	m_pWorkers;
+	CIOMetrics*					m_pMetrics;
+
+	CLoopTracer					m_tracer;
+	atomic<int>					m_iWorkerSeq;
 };
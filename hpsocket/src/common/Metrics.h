@@ -0,0 +1,726 @@
+﻿/*
+* Copyright: JessMA Open Source (ldcsaa@gmail.com)
+*
+* Author	: Bruce Liang
+* Website	: https://github.com/ldcsaa
+* Project	: https://github.com/ldcsaa/HP-Socket
+* Blog		: http://www.cnblogs.com/ldcsaa
+* Wiki		: http://www.oschina.net/p/hp-socket
+* QQ Group	: 44636872, 75375912
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#pragma once
+
+#include "GlobalDef.h"
+#include "Singleton.h"
+#include "FuncHelper.h"
+#include "SysHelper.h"
+
+#include <time.h>
+#include <atomic>
+#include <memory>
+
+using namespace std;
+
+/* 单调时钟（纳秒） */
+inline ULLONG TimeGetNanos()
+{
+#if defined(__APPLE__)
+	return (ULLONG)::clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+#else
+	timespec ts;
+	::clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ((ULLONG)ts.tv_sec) * 1000000000ull + (ULLONG)ts.tv_nsec;
+#endif
+}
+
+/*
+  度量槽位序号：每个线程首次写入度量时分配，写入按序号分散到独立缓存行，读取时汇总所有槽位
+*/
+inline DWORD GetMetricsSlotOrdinal()
+{
+	static atomic<DWORD> s_dwSlotSeq(0);
+	static thread_local DWORD s_dwSlot = s_dwSlotSeq.fetch_add(1, memory_order_relaxed);
+
+	return s_dwSlot;
+}
+
+inline DWORD GetMetricsSlotCount(DWORD dwMaxSlots)
+{
+	DWORD dwSlots = 1;
+
+	while(dwSlots < (DWORD)PROCESSOR_COUNT && dwSlots < dwMaxSlots)
+		dwSlots <<= 1;
+
+	return dwSlots;
+}
+
+// ------------------------------------------------------------------------------------------------------------- //
+
+/*
+  分槽计数器组：N 个计数器按线程槽位分别累加（relaxed 原子操作，不同工作线程互不争用缓存行），读取时汇总
+*/
+template<int N> class CMetricsCounters
+{
+public:
+
+	static const DWORD MAX_SLOTS = 64;
+
+private:
+
+	struct TSlot
+	{
+		atomic<ULLONG> values[N];
+	} __attribute__((aligned(CACHE_LINE)));
+
+public:
+
+	void Add(int i, ULLONG v = 1)
+	{
+		ASSERT(i >= 0 && i < N);
+
+		m_pSlots[GetMetricsSlotOrdinal() & (m_dwSlots - 1)].values[i].fetch_add(v, memory_order_relaxed);
+	}
+
+	ULLONG Get(int i) const
+	{
+		ASSERT(i >= 0 && i < N);
+
+		ULLONG v = 0;
+
+		for(DWORD j = 0; j < m_dwSlots; j++)
+			v += m_pSlots[j].values[i].load(memory_order_relaxed);
+
+		return v;
+	}
+
+	void Reset()
+	{
+		for(DWORD j = 0; j < m_dwSlots; j++)
+		{
+			for(int i = 0; i < N; i++)
+				m_pSlots[j].values[i].store(0, memory_order_relaxed);
+		}
+	}
+
+public:
+
+	CMetricsCounters()
+	: m_dwSlots(GetMetricsSlotCount(MAX_SLOTS))
+	, m_pSlots(new TSlot[m_dwSlots])
+	{
+		Reset();
+	}
+
+	~CMetricsCounters()
+	{
+		delete[] m_pSlots;
+	}
+
+	DECLARE_NO_COPY_CLASS(CMetricsCounters)
+
+private:
+	DWORD	m_dwSlots;
+	TSlot*	m_pSlots;
+};
+
+// ------------------------------------------------------------------------------------------------------------- //
+
+/*
+  HDR 风格直方图：小于 16 的值逐一分桶，其余按 2 的幂分组、每组 8 个线性子桶（相对误差不超过 12.5%），
+  可记录 [0, 2^48) 范围内的值（超出部分计入最后一个桶）。写入按线程槽位分散，读取时汇总计算分位数
+*/
+class CLatencyHistogram
+{
+public:
+
+	static const int SUB_BUCKET_BITS	= 3;
+	static const int SUB_BUCKETS		= 1 << SUB_BUCKET_BITS;
+	static const int LINEAR_BUCKETS		= 2 * SUB_BUCKETS;
+	static const int MAX_MAGNITUDE		= 47;
+	static const int BUCKET_COUNT		= LINEAR_BUCKETS + (MAX_MAGNITUDE - SUB_BUCKET_BITS) * SUB_BUCKETS;
+	static const DWORD MAX_SLOTS		= 16;
+
+	struct TStat
+	{
+		ULLONG count;
+		ULLONG sum;
+		ULLONG min;
+		ULLONG max;
+		ULLONG p50;
+		ULLONG p90;
+		ULLONG p99;
+		ULLONG p999;
+	};
+
+private:
+
+	struct TSlot
+	{
+		atomic<ULLONG> count;
+		atomic<ULLONG> sum;
+		atomic<ULLONG> min;
+		atomic<ULLONG> max;
+		atomic<ULLONG> buckets[BUCKET_COUNT];
+	} __attribute__((aligned(CACHE_LINE)));
+
+public:
+
+	void Record(ULLONG v)
+	{
+		TSlot& slot = m_pSlots[GetMetricsSlotOrdinal() & (m_dwSlots - 1)];
+
+		slot.buckets[GetBucketIndex(v)].fetch_add(1, memory_order_relaxed);
+		slot.count.fetch_add(1, memory_order_relaxed);
+		slot.sum.fetch_add(v, memory_order_relaxed);
+
+		ULLONG cur = slot.min.load(memory_order_relaxed);
+		while(v < cur && !slot.min.compare_exchange_weak(cur, v, memory_order_relaxed));
+
+		cur = slot.max.load(memory_order_relaxed);
+		while(v > cur && !slot.max.compare_exchange_weak(cur, v, memory_order_relaxed));
+	}
+
+	void GetStat(TStat& stat) const
+	{
+		::ZeroMemory(&stat, sizeof(TStat));
+
+		unique_ptr<ULLONG[]> buckets(new ULLONG[BUCKET_COUNT]());
+		ULLONG ullMin = MAXULONGLONG;
+
+		for(DWORD j = 0; j < m_dwSlots; j++)
+		{
+			TSlot& slot = m_pSlots[j];
+
+			stat.count	+= slot.count.load(memory_order_relaxed);
+			stat.sum	+= slot.sum.load(memory_order_relaxed);
+			ullMin		 = MIN(ullMin, slot.min.load(memory_order_relaxed));
+			stat.max	 = MAX(stat.max, slot.max.load(memory_order_relaxed));
+
+			for(int i = 0; i < BUCKET_COUNT; i++)
+				buckets[i] += slot.buckets[i].load(memory_order_relaxed);
+		}
+
+		if(stat.count == 0)
+			return;
+
+		stat.min  = ullMin;
+		stat.p50  = GetPercentile(buckets.get(), stat, 0.5);
+		stat.p90  = GetPercentile(buckets.get(), stat, 0.9);
+		stat.p99  = GetPercentile(buckets.get(), stat, 0.99);
+		stat.p999 = GetPercentile(buckets.get(), stat, 0.999);
+	}
+
+	void Reset()
+	{
+		for(DWORD j = 0; j < m_dwSlots; j++)
+		{
+			TSlot& slot = m_pSlots[j];
+
+			slot.count.store(0, memory_order_relaxed);
+			slot.sum.store(0, memory_order_relaxed);
+			slot.min.store(MAXULONGLONG, memory_order_relaxed);
+			slot.max.store(0, memory_order_relaxed);
+
+			for(int i = 0; i < BUCKET_COUNT; i++)
+				slot.buckets[i].store(0, memory_order_relaxed);
+		}
+	}
+
+	static int GetBucketIndex(ULLONG v)
+	{
+		if(v < (ULLONG)LINEAR_BUCKETS)
+			return (int)v;
+
+		int iMag = 63 - __builtin_clzll(v);
+
+		if(iMag > MAX_MAGNITUDE)
+			return BUCKET_COUNT - 1;
+
+		int iShift = iMag - SUB_BUCKET_BITS;
+
+		return LINEAR_BUCKETS + (iMag - SUB_BUCKET_BITS - 1) * SUB_BUCKETS + (int)((v >> iShift) & (SUB_BUCKETS - 1));
+	}
+
+	/* 桶内最大值 */
+	static ULLONG GetBucketUpperBound(int i)
+	{
+		if(i < LINEAR_BUCKETS)
+			return (ULLONG)i;
+
+		int k		= i - LINEAR_BUCKETS;
+		int iShift	= k / SUB_BUCKETS + 1;
+		ULLONG ullLower = ((ULLONG)(SUB_BUCKETS + k % SUB_BUCKETS)) << iShift;
+
+		return ullLower + (1ull << iShift) - 1;
+	}
+
+private:
+
+	static ULLONG GetPercentile(const ULLONG buckets[], const TStat& stat, double dPercentile)
+	{
+		ULLONG ullRank	= (ULLONG)(dPercentile * stat.count + 0.5);
+		ULLONG ullSeen	= 0;
+
+		if(ullRank == 0) ullRank = 1;
+
+		for(int i = 0; i < BUCKET_COUNT; i++)
+		{
+			ullSeen += buckets[i];
+
+			if(ullSeen >= ullRank)
+				return MAX(MIN(GetBucketUpperBound(i), stat.max), stat.min);
+		}
+
+		return stat.max;
+	}
+
+public:
+
+	CLatencyHistogram()
+	: m_dwSlots(GetMetricsSlotCount(MAX_SLOTS))
+	, m_pSlots(new TSlot[m_dwSlots])
+	{
+		Reset();
+	}
+
+	~CLatencyHistogram()
+	{
+		delete[] m_pSlots;
+	}
+
+	DECLARE_NO_COPY_CLASS(CLatencyHistogram)
+
+private:
+	DWORD	m_dwSlots;
+	TSlot*	m_pSlots;
+};
+
+// ------------------------------------------------------------------------------------------------------------- //
+
+/*
+  通信组件运行时度量：计数器与直方图的集合，由组件及其 CIODispatcher 共同写入。
+  未启用时所有写入操作只有一次 relaxed 读取的开销
+*/
+class CIOMetrics
+{
+public:
+
+	enum EnCounter
+	{
+		IMC_BYTES_IN,		// 接收字节数
+		IMC_BYTES_OUT,		// 发送字节数
+		IMC_READS_IN,		// 读取到数据的接收系统调用次数（TCP 可能合并或拆分消息，不等于 OnReceive 次数）
+		IMC_MSGS_OUT,		// 发送消息数（Send 调用次数）
+		IMC_RECV_CALLS,		// 接收系统调用次数
+		IMC_SEND_CALLS,		// 发送系统调用次数
+		IMC_IO_EVENTS,		// 分发的 IO 事件数
+		IMC_CONNECTS,		// 建立的连接数（accept 或 connect）
+		IMC_CLOSES,			// 关闭的连接数
+		IMC_LOOPS,			// 事件循环次数
+		IMC_COMMANDS,		// 处理的分发命令数
+		IMC_COUNT
+	};
+
+	enum EnHistogram
+	{
+		IMH_CALLBACK,		// 事件回调耗时（纳秒）
+		IMH_LOOP,			// 每次事件循环处理耗时（纳秒）
+		IMH_SEND_QUEUE,		// 发送请求入队后的待发数据长度（字节）
+		IMH_COMMAND_QUEUE,	// 处理命令时命令队列深度
+		IMH_COUNT
+	};
+
+public:
+
+	BOOL IsEnabled()				{return m_bEnabled.load(memory_order_relaxed);}
+	void SetEnabled(BOOL bEnabled)	{m_bEnabled.store(bEnabled, memory_order_relaxed);}
+
+	void Add(EnCounter enCounter, ULLONG v = 1)
+	{
+		if(IsEnabled())
+			m_counters.Add(enCounter, v);
+	}
+
+	void Record(EnHistogram enHistogram, ULLONG v)
+	{
+		if(IsEnabled())
+			m_histograms[enHistogram].Record(v);
+	}
+
+	/* 登记一次接收系统调用（rc 为调用返回值） */
+	void OnRecv(int rc)
+	{
+		if(!IsEnabled())
+			return;
+
+		m_counters.Add(IMC_RECV_CALLS);
+
+		if(rc > 0)
+		{
+			m_counters.Add(IMC_BYTES_IN, rc);
+			m_counters.Add(IMC_READS_IN);
+		}
+	}
+
+	/* 登记一次发送系统调用（rc 为调用返回值） */
+	void OnSend(int rc)
+	{
+		if(!IsEnabled())
+			return;
+
+		m_counters.Add(IMC_SEND_CALLS);
+
+		if(rc > 0)
+			m_counters.Add(IMC_BYTES_OUT, rc);
+	}
+
+	/* 登记一次发送请求（iPending 为入队后的待发数据长度） */
+	void OnSendRequest(int iPending)
+	{
+		if(!IsEnabled())
+			return;
+
+		m_counters.Add(IMC_MSGS_OUT);
+		m_histograms[IMH_SEND_QUEUE].Record((ULLONG)MAX(iPending, 0));
+	}
+
+	ULLONG GetCounter(EnCounter enCounter)	{return m_counters.Get(enCounter);}
+	ULLONG GetUptime()						{return ::GetTimeGap64(m_ullStartTime);}
+
+	void GetHistogram(EnHistogram enHistogram, CLatencyHistogram::TStat& stat)
+		{m_histograms[enHistogram].GetStat(stat);}
+
+	/* 组件启动时调用：清零所有度量并重新计时 */
+	void Reset()
+	{
+		m_counters.Reset();
+
+		for(int i = 0; i < IMH_COUNT; i++)
+			m_histograms[i].Reset();
+
+		m_ullStartTime = ::TimeGetTime64();
+	}
+
+public:
+
+	CIOMetrics(BOOL bEnabled = FALSE)
+	: m_bEnabled(bEnabled)
+	, m_ullStartTime(::TimeGetTime64())
+	{
+	}
+
+	DECLARE_NO_COPY_CLASS(CIOMetrics)
+
+private:
+	atomic<BOOL>				m_bEnabled;
+	ULLONG						m_ullStartTime;
+
+	CMetricsCounters<IMC_COUNT>	m_counters;
+	CLatencyHistogram			m_histograms[IMH_COUNT];
+};
+
+/* 作用域计时器：构造时若度量已启用则取时间戳，析构时把耗时记入指定直方图 */
+class CMetricsTimer
+{
+public:
+
+	CMetricsTimer(CIOMetrics& metrics, CIOMetrics::EnHistogram enHistogram = CIOMetrics::IMH_CALLBACK)
+	: m_metrics(metrics)
+	, m_enHistogram(enHistogram)
+	, m_ullBegin(metrics.IsEnabled() ? ::TimeGetNanos() : 0)
+	{
+	}
+
+	~CMetricsTimer()
+	{
+		if(m_ullBegin != 0)
+			m_metrics.Record(m_enHistogram, ::TimeGetNanos() - m_ullBegin);
+	}
+
+	DECLARE_NO_COPY_CLASS(CMetricsTimer)
+
+private:
+	CIOMetrics&				m_metrics;
+	CIOMetrics::EnHistogram	m_enHistogram;
+	ULLONG					m_ullBegin;
+};
+
+// ------------------------------------------------------------------------------------------------------------- //
+
+/*
+  事件跟踪记录：事件处理耗时超过慢回调阈值时写入跟踪环
+*/
+struct TTraceRecord
+{
+	ULLONG		seq;		// 全局序号（从 1 开始递增）
+	ULLONG		begin;		// 事件开始时间（TimeGetNanos() 时钟，纳秒）
+	ULLONG		duration;	// 事件处理耗时（纳秒）
+	UINT_PTR	id;			// 事件所属对象标识（由 IIOHandler::GetTraceID() 给出，如连接 ID）
+	UINT		events;		// 事件类型（kqueue filter）
+	USHORT		flags;		// 事件标志
+	int			worker;		// 工作线程序号（-1：非分发线程）
+};
+
+/*
+  无锁跟踪环：写入者以 fetch_add 领取序号并写入对应槽位，环满后覆盖最旧记录；
+  槽位带版本号（写入期间为 0，写完置为序号），导出时跳过正在改写的槽位
+*/
+template<class T> class CTraceRing
+{
+private:
+
+	struct TSlot
+	{
+		atomic<ULLONG>	ver;
+		T				data;
+	};
+
+public:
+
+	ULLONG Push(T& data)
+	{
+		ULLONG seq	= m_ullSeq.fetch_add(1, memory_order_relaxed) + 1;
+		TSlot& slot	= m_pSlots[seq & (m_dwCapacity - 1)];
+
+		data.seq = seq;
+
+		slot.ver.store(0, memory_order_relaxed);
+		atomic_thread_fence(memory_order_release);
+		slot.data = data;
+		slot.ver.store(seq, memory_order_release);
+
+		return seq;
+	}
+
+	/*
+	* 导出最近的记录（按序号从旧到新排列）
+	* 
+	* pData 为空或 dwCount 小于现存记录数时，dwCount 返回现存记录数并返回 FALSE
+	*/
+	BOOL Dump(T pData[], DWORD& dwCount)
+	{
+		ULLONG ullSeq	= m_ullSeq.load(memory_order_acquire);
+		DWORD dwAvail	= (DWORD)MIN(ullSeq, (ULLONG)m_dwCapacity);
+
+		if(pData == nullptr || dwCount < dwAvail)
+		{
+			dwCount = dwAvail;
+			::SetLastError(ERROR_BUFFER_OVERFLOW);
+
+			return FALSE;
+		}
+
+		DWORD dwActual = 0;
+
+		for(ULLONG seq = ullSeq - dwAvail + 1; seq <= ullSeq; seq++)
+		{
+			TSlot& slot = m_pSlots[seq & (m_dwCapacity - 1)];
+
+			if(slot.ver.load(memory_order_acquire) != seq)
+				continue;
+
+			T data = slot.data;
+			atomic_thread_fence(memory_order_acquire);
+
+			if(slot.ver.load(memory_order_relaxed) != seq)
+				continue;
+
+			pData[dwActual++] = data;
+		}
+
+		dwCount = dwActual;
+
+		return TRUE;
+	}
+
+	ULLONG GetTotalCount()	{return m_ullSeq.load(memory_order_relaxed);}
+	DWORD GetCapacity()		{return m_dwCapacity;}
+
+	void Reset()
+	{
+		for(DWORD i = 0; i < m_dwCapacity; i++)
+			m_pSlots[i].ver.store(0, memory_order_relaxed);
+
+		m_ullSeq.store(0, memory_order_release);
+	}
+
+public:
+
+	CTraceRing(DWORD dwCapacity)
+	: m_dwCapacity(GetCapacity(dwCapacity))
+	, m_pSlots(new TSlot[m_dwCapacity])
+	, m_ullSeq(0)
+	{
+		Reset();
+	}
+
+	~CTraceRing()
+	{
+		delete[] m_pSlots;
+	}
+
+	DECLARE_NO_COPY_CLASS(CTraceRing)
+
+private:
+
+	static DWORD GetCapacity(DWORD dwCapacity)
+	{
+		DWORD dwActual = 1;
+
+		while(dwActual < dwCapacity)
+			dwActual <<= 1;
+
+		return dwActual;
+	}
+
+private:
+	DWORD			m_dwCapacity;
+	TSlot*			m_pSlots;
+
+	char			m_pad[CACHE_LINE];
+	atomic<ULLONG>	m_ullSeq;
+};
+
+/*
+  事件循环跟踪器：记录各工作线程等待事件与处理事件的耗时（繁忙率 = busy / (busy + idle)），
+  处理耗时达到慢回调阈值的事件写入跟踪环；阈值为 0 时关闭跟踪，可随时开关
+*/
+class CLoopTracer
+{
+public:
+
+	static const DWORD DEF_RING_SIZE	= 1024;
+
+	struct TWorkerStat
+	{
+		ULLONG busy;		// 处理事件耗时（纳秒）
+		ULLONG idle;		// 等待事件耗时（纳秒）
+		ULLONG events;		// 处理的事件数
+		ULLONG slow;		// 慢事件数
+	};
+
+private:
+
+	struct TWorker
+	{
+		atomic<ULLONG> busy;
+		atomic<ULLONG> idle;
+		atomic<ULLONG> events;
+		atomic<ULLONG> slow;
+	} __attribute__((aligned(CACHE_LINE)));
+
+public:
+
+	BOOL IsEnabled()						{return m_ullThreshold.load(memory_order_relaxed) != 0;}
+	ULLONG GetSlowThreshold()				{return m_ullThreshold.load(memory_order_relaxed);}
+	void SetSlowThreshold(ULLONG ullNanos)	{m_ullThreshold.store(ullNanos, memory_order_relaxed);}
+
+	/* 分发器启动时调用（工作线程启动前） */
+	void Init(int iWorkers)
+	{
+		m_iWorkers = iWorkers;
+		m_pWorkers = make_unique<TWorker[]>(iWorkers);
+
+		Reset();
+	}
+
+	/* 登记一次事件循环：ullIdle -- 等待事件耗时，ullBusy -- 处理本批事件耗时，iEvents -- 本批事件数 */
+	void OnLoop(int iWorker, ULLONG ullIdle, ULLONG ullBusy, int iEvents)
+	{
+		if(iWorker < 0 || iWorker >= m_iWorkers)
+			return;
+
+		TWorker& worker = m_pWorkers[iWorker];
+
+		worker.idle.fetch_add(ullIdle, memory_order_relaxed);
+		worker.busy.fetch_add(ullBusy, memory_order_relaxed);
+		worker.events.fetch_add(iEvents, memory_order_relaxed);
+	}
+
+	/* 登记一次事件处理，耗时达到阈值时写入跟踪环 */
+	void OnEvent(int iWorker, ULLONG ullBegin, ULLONG ullDuration, UINT_PTR id, UINT events, USHORT flags)
+	{
+		ULLONG ullThreshold = m_ullThreshold.load(memory_order_relaxed);
+
+		if(ullThreshold == 0 || ullDuration < ullThreshold)
+			return;
+
+		if(iWorker >= 0 && iWorker < m_iWorkers)
+			m_pWorkers[iWorker].slow.fetch_add(1, memory_order_relaxed);
+
+		TTraceRecord record = {0, ullBegin, ullDuration, id, events, flags, iWorker};
+		m_ring.Push(record);
+	}
+
+	int GetWorkerCount()		{return m_iWorkers;}
+	DWORD GetRingCapacity()		{return m_ring.GetCapacity();}
+
+	BOOL GetWorkerStat(int iWorker, TWorkerStat& stat)
+	{
+		if(iWorker < 0 || iWorker >= m_iWorkers)
+		{
+			::SetLastError(ERROR_INVALID_PARAMETER);
+			return FALSE;
+		}
+
+		TWorker& worker = m_pWorkers[iWorker];
+
+		stat.busy	= worker.busy.load(memory_order_relaxed);
+		stat.idle	= worker.idle.load(memory_order_relaxed);
+		stat.events	= worker.events.load(memory_order_relaxed);
+		stat.slow	= worker.slow.load(memory_order_relaxed);
+
+		return TRUE;
+	}
+
+	BOOL DumpSlowEvents(TTraceRecord records[], DWORD& dwCount)
+		{return m_ring.Dump(records, dwCount);}
+
+	void Reset()
+	{
+		for(int i = 0; i < m_iWorkers; i++)
+		{
+			TWorker& worker = m_pWorkers[i];
+
+			worker.busy.store(0, memory_order_relaxed);
+			worker.idle.store(0, memory_order_relaxed);
+			worker.events.store(0, memory_order_relaxed);
+			worker.slow.store(0, memory_order_relaxed);
+		}
+
+		m_ring.Reset();
+	}
+
+public:
+
+	CLoopTracer(DWORD dwRingSize = DEF_RING_SIZE)
+	: m_ullThreshold(0)
+	, m_iWorkers(0)
+	, m_ring(dwRingSize)
+	{
+	}
+
+	DECLARE_NO_COPY_CLASS(CLoopTracer)
+
+private:
+	atomic<ULLONG>			m_ullThreshold;
+
+	int						m_iWorkers;
+	unique_ptr<TWorker[]>	m_pWorkers;
+
+	CTraceRing<TTraceRecord> m_ring;
+};
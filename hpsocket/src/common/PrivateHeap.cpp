@@ -0,0 +1,564 @@
+﻿/*
+* Copyright: JessMA Open Source (ldcsaa@gmail.com)
+*
+* Author	: Bruce Liang
+* Website	: https://github.com/ldcsaa
+* Project	: https://github.com/ldcsaa/HP-Socket
+* Blog		: http://www.cnblogs.com/ldcsaa
+* Wiki		: http://www.oschina.net/p/hp-socket
+* QQ Group	: 44636872, 75375912
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "SysHelper.h"
+#include "FuncHelper.h"
+#include "PrivateHeap.h"
+
+#include <sys/mman.h>
+
+#if defined(__APPLE__)
+	#include <mach/vm_statistics.h>
+#endif
+
+#define HUGE_PAGE_SIZE			(2 * 1024 * 1024)
+#define BLOCK_ALIGN(size, align)	(((size) + (align) - 1) & ~((SIZE_T)(align) - 1))
+
+const SIZE_T CArenaHeapImpl::ARENA_MIN_SIZE			= 64 * 1024;
+const SIZE_T CArenaHeapImpl::ARENA_MAX_SIZE			= 4 * 1024 * 1024;
+const SIZE_T CArenaHeapImpl::ARENA_MAX_BLOCK_SIZE	= 256 * 1024;
+
+struct CArenaHeapImpl::TBlockHead
+{
+	TArena*		arena;		// 所属内存区，大块内存为 nullptr
+	int			iClass;		// -1：大块内存
+	int			iShard;		// 所属分片
+};
+
+struct CArenaHeapImpl::TLargeHead
+{
+	TLargeHead*	prev;
+	TLargeHead*	next;
+	SIZE_T		size;
+	SIZE_T		reserved;
+	TBlockHead	head;
+};
+
+struct CArenaHeapImpl::TArena
+{
+	TArena*		next;
+	SIZE_T		size;
+	SIZE_T		live;		// 未释放的内存块数量
+	SIZE_T		reserved;
+};
+
+struct alignas(64) CArenaHeapImpl::TShard
+{
+	CSpinGuard	cs;
+
+	TArena*		pArena;
+	BYTE*		pCursor;
+	BYTE*		pLimit;
+	TLargeHead*	pLarge;
+	TBlockHead*	pFree[CLASS_COUNT];		// 空闲内存块通过用户区首字段链接，块头保持不变
+	SIZE_T		dwNextArenaSize;
+
+	SIZE_T		dwAllocBytes;
+	SIZE_T		dwPeakBytes;
+	ULONGLONG	ullAllocCount;
+	ULONGLONG	ullFreeCount;
+	DWORD		dwArenaCount;
+	DWORD		dwLargeCount;
+};
+
+#define FREE_NEXT(pHead)		(*(TBlockHead**)((pHead) + 1))
+
+CArenaHeapImpl::CArenaHeapImpl(DWORD dwOptions, SIZE_T dwInitSize, SIZE_T dwMaxSize)
+: m_dwOptions		(dwOptions)
+, m_dwArenaSize		(dwInitSize > 0 ? MAX(BLOCK_ALIGN(dwInitSize, ARENA_MIN_SIZE), ARENA_MIN_SIZE) : ARENA_MAX_SIZE)
+, m_dwMaxSize		(dwMaxSize)
+, m_dwReservedBytes	(0)
+{
+	if(m_dwOptions & HEAP_HUGE_PAGES)
+		m_dwArenaSize = BLOCK_ALIGN(m_dwArenaSize, HUGE_PAGE_SIZE);
+
+	DWORD dwShards = 1;
+
+	while(dwShards < (DWORD)PROCESSOR_COUNT && dwShards < MAX_SHARDS)
+		dwShards <<= 1;
+
+	m_pShards		= new TShard[dwShards];
+	m_dwShardMask	= dwShards - 1;
+
+	for(DWORD i = 0; i < dwShards; i++)
+	{
+		TShard& shard = m_pShards[i];
+
+		shard.pArena			= nullptr;
+		shard.pCursor			= nullptr;
+		shard.pLimit			= nullptr;
+		shard.pLarge			= nullptr;
+		shard.dwNextArenaSize	= (m_dwOptions & HEAP_HUGE_PAGES) ? HUGE_PAGE_SIZE : MIN(ARENA_MIN_SIZE, m_dwArenaSize);
+		shard.dwAllocBytes		= 0;
+		shard.dwPeakBytes		= 0;
+		shard.ullAllocCount		= 0;
+		shard.ullFreeCount		= 0;
+		shard.dwArenaCount		= 0;
+		shard.dwLargeCount		= 0;
+
+		::ZeroMemory(shard.pFree, sizeof(shard.pFree));
+	}
+}
+
+CArenaHeapImpl::~CArenaHeapImpl()
+{
+	/* 析构后分片元数据不再有效，此后释放内存块会访问已释放的内存，因此不允许存在未释放的内存块 */
+	ASSERT(GetAllocBytes() == 0);
+
+	Reset();
+
+	delete[] m_pShards;
+}
+
+DWORD CArenaHeapImpl::GetThreadOrdinal()
+{
+	static atomic<DWORD> s_dwThreadSeq(0);
+	static thread_local DWORD s_dwOrdinal = s_dwThreadSeq.fetch_add(1, memory_order_relaxed);
+
+	return s_dwOrdinal;
+}
+
+CArenaHeapImpl::TShard& CArenaHeapImpl::GetShard()
+{
+	return m_pShards[GetThreadOrdinal() & m_dwShardMask];
+}
+
+PVOID CArenaHeapImpl::Alloc(SIZE_T dwSize, DWORD dwFlags)
+{
+	SIZE_T dwTotal	= MAX(dwSize, sizeof(TBlockHead*)) + sizeof(TBlockHead);
+	TShard& shard	= GetShard();
+	PVOID pv		= nullptr;
+
+	{
+		CLocalLock<CSpinGuard> locallock(shard.cs);
+
+		if(dwTotal > ARENA_MAX_BLOCK_SIZE)
+			pv = AllocLarge(shard, dwSize);
+		else
+			pv = AllocSmall(shard, GetClassIndex(dwTotal));
+	}
+
+	if(!pv)
+		throw std::bad_alloc();
+
+	if(dwFlags & HEAP_ZERO_MEMORY)
+		ZeroMemory(pv, dwSize);
+
+	return pv;
+}
+
+PVOID CArenaHeapImpl::ReAlloc(PVOID pvMemory, SIZE_T dwSize, DWORD dwFlags)
+{
+	if(!pvMemory)
+		return Alloc(dwSize, dwFlags);
+
+	SIZE_T dwOldSize = Size(pvMemory);
+
+	if(dwSize <= dwOldSize)
+		return pvMemory;
+
+	PVOID pv = nullptr;
+
+	try
+	{
+		pv = Alloc(dwSize);
+	}
+	catch(...)
+	{
+		Free(pvMemory);
+		throw;
+	}
+
+	memcpy(pv, pvMemory, dwOldSize);
+	Free(pvMemory);
+
+	if(dwFlags & HEAP_ZERO_MEMORY)
+		ZeroMemory((BYTE*)pv + dwOldSize, dwSize - dwOldSize);
+
+	return pv;
+}
+
+BOOL CArenaHeapImpl::Free(PVOID pvMemory, DWORD dwFlags)
+{
+	if(!pvMemory)
+		return FALSE;
+
+	TBlockHead* pHead = (TBlockHead*)pvMemory - 1;
+
+	ASSERT(pHead->iShard >= 0 && (DWORD)pHead->iShard <= m_dwShardMask);
+
+	TShard& shard = m_pShards[pHead->iShard];
+
+	CLocalLock<CSpinGuard> locallock(shard.cs);
+
+	if(pHead->iClass < 0)
+		FreeLarge(shard, (TLargeHead*)((BYTE*)pHead - offsetof(TLargeHead, head)));
+	else
+		FreeSmall(shard, pHead);
+
+	++shard.ullFreeCount;
+
+	return TRUE;
+}
+
+SIZE_T CArenaHeapImpl::Size(PVOID pvMemory, DWORD dwFlags)
+{
+	TBlockHead* pHead = (TBlockHead*)pvMemory - 1;
+
+	if(pHead->iClass < 0)
+		return ((TLargeHead*)((BYTE*)pHead - offsetof(TLargeHead, head)))->size - sizeof(TLargeHead);
+
+	return GetClassSize(pHead->iClass) - sizeof(TBlockHead);
+}
+
+SIZE_T CArenaHeapImpl::Compact(DWORD dwFlags)
+{
+	SIZE_T dwLargest = 0;
+
+	for(DWORD i = 0; i <= m_dwShardMask; i++)
+	{
+		TShard& shard = m_pShards[i];
+
+		CLocalLock<CSpinGuard> locallock(shard.cs);
+
+		ReleaseIdleArenas(shard);
+
+		dwLargest = MAX(dwLargest, (SIZE_T)(shard.pLimit - shard.pCursor));
+
+		for(int j = CLASS_COUNT - 1; j >= 0; j--)
+		{
+			if(shard.pFree[j] != nullptr)
+			{
+				dwLargest = MAX(dwLargest, GetClassSize(j));
+				break;
+			}
+		}
+	}
+
+	return dwLargest > sizeof(TBlockHead) ? dwLargest - sizeof(TBlockHead) : 0;
+}
+
+BOOL CArenaHeapImpl::Reset()
+{
+	for(DWORD i = 0; i <= m_dwShardMask; i++)
+	{
+		TShard& shard = m_pShards[i];
+
+		CLocalLock<CSpinGuard> locallock(shard.cs);
+
+		ReleaseAllArenas(shard);
+	}
+
+	return TRUE;
+}
+
+void CArenaHeapImpl::GetStat(THeapStat& stat)
+{
+	::ZeroMemory(&stat, sizeof(THeapStat));
+
+	for(DWORD i = 0; i <= m_dwShardMask; i++)
+	{
+		TShard& shard = m_pShards[i];
+
+		CLocalLock<CSpinGuard> locallock(shard.cs);
+
+		stat.allocBytes	+= shard.dwAllocBytes;
+		stat.peakBytes	+= shard.dwPeakBytes;
+		stat.allocCount	+= shard.ullAllocCount;
+		stat.freeCount	+= shard.ullFreeCount;
+		stat.arenaCount	+= shard.dwArenaCount;
+		stat.largeCount	+= shard.dwLargeCount;
+	}
+
+	stat.reservedBytes = GetReservedBytes();
+}
+
+SIZE_T CArenaHeapImpl::GetAllocBytes()
+{
+	SIZE_T dwAllocBytes = 0;
+
+	for(DWORD i = 0; i <= m_dwShardMask; i++)
+		dwAllocBytes += m_pShards[i].dwAllocBytes;
+
+	return dwAllocBytes;
+}
+
+PVOID CArenaHeapImpl::AllocSmall(TShard& shard, int iClass)
+{
+	SIZE_T dwBlockSize	= GetClassSize(iClass);
+	TBlockHead* pHead	= shard.pFree[iClass];
+
+	if(pHead != nullptr)
+		shard.pFree[iClass] = FREE_NEXT(pHead);
+	else
+	{
+		if(shard.pCursor + dwBlockSize > shard.pLimit && !NewArena(shard, dwBlockSize))
+			return nullptr;
+
+		pHead			= (TBlockHead*)shard.pCursor;
+		shard.pCursor  += dwBlockSize;
+
+		pHead->arena	= shard.pArena;
+		pHead->iClass	= iClass;
+		pHead->iShard	= (int)(&shard - m_pShards);
+	}
+
+	++pHead->arena->live;
+
+	shard.dwAllocBytes += dwBlockSize;
+	shard.dwPeakBytes	= MAX(shard.dwPeakBytes, shard.dwAllocBytes);
+
+	++shard.ullAllocCount;
+
+	return pHead + 1;
+}
+
+void CArenaHeapImpl::FreeSmall(TShard& shard, TBlockHead* pHead)
+{
+	ASSERT(pHead->iClass < CLASS_COUNT && pHead->arena->live > 0);
+
+	FREE_NEXT(pHead)			= shard.pFree[pHead->iClass];
+	shard.pFree[pHead->iClass]	= pHead;
+
+	--pHead->arena->live;
+
+	shard.dwAllocBytes -= GetClassSize(pHead->iClass);
+}
+
+PVOID CArenaHeapImpl::AllocLarge(TShard& shard, SIZE_T dwSize)
+{
+	SIZE_T dwMapSize = BLOCK_ALIGN(dwSize + sizeof(TLargeHead), (m_dwOptions & HEAP_HUGE_PAGES) ? HUGE_PAGE_SIZE : SysGetPageSize());
+
+	if(m_dwMaxSize > 0 && GetReservedBytes() + dwMapSize > m_dwMaxSize)
+		return nullptr;
+
+	TLargeHead* pLarge = (TLargeHead*)MapMemory(dwMapSize);
+
+	if(pLarge == nullptr)
+		return nullptr;
+
+	pLarge->prev		= nullptr;
+	pLarge->next		= shard.pLarge;
+	pLarge->size		= dwMapSize;
+	pLarge->head.arena	= nullptr;
+	pLarge->head.iClass	= -1;
+	pLarge->head.iShard	= (int)(&shard - m_pShards);
+
+	if(shard.pLarge != nullptr)
+		shard.pLarge->prev = pLarge;
+
+	shard.pLarge = pLarge;
+
+	shard.dwAllocBytes += dwMapSize;
+	shard.dwPeakBytes	= MAX(shard.dwPeakBytes, shard.dwAllocBytes);
+
+	++shard.dwLargeCount;
+	++shard.ullAllocCount;
+
+	return &pLarge->head + 1;
+}
+
+void CArenaHeapImpl::FreeLarge(TShard& shard, TLargeHead* pLarge)
+{
+	if(pLarge->prev != nullptr)
+		pLarge->prev->next = pLarge->next;
+	else
+		shard.pLarge = pLarge->next;
+
+	if(pLarge->next != nullptr)
+		pLarge->next->prev = pLarge->prev;
+
+	shard.dwAllocBytes -= pLarge->size;
+
+	--shard.dwLargeCount;
+
+	UnmapMemory(pLarge, pLarge->size);
+}
+
+BOOL CArenaHeapImpl::NewArena(TShard& shard, SIZE_T dwBlockSize)
+{
+	SIZE_T dwHeadSize	= BLOCK_ALIGN(sizeof(TArena), sizeof(TBlockHead));
+	SIZE_T dwArenaSize	= shard.dwNextArenaSize;
+
+	while(dwArenaSize < dwHeadSize + dwBlockSize)
+		dwArenaSize <<= 1;
+
+	if(m_dwMaxSize > 0 && GetReservedBytes() + dwArenaSize > m_dwMaxSize)
+		return FALSE;
+
+	TArena* pArena = (TArena*)MapMemory(dwArenaSize);
+
+	if(pArena == nullptr)
+		return FALSE;
+
+	pArena->next	= shard.pArena;
+	pArena->size	= dwArenaSize;
+	pArena->live	= 0;
+	shard.pArena	= pArena;
+
+	shard.pCursor	= (BYTE*)pArena + dwHeadSize;
+	shard.pLimit	= (BYTE*)pArena + dwArenaSize;
+
+	if(shard.dwNextArenaSize < m_dwArenaSize)
+		shard.dwNextArenaSize = MIN(shard.dwNextArenaSize << 1, m_dwArenaSize);
+
+	++shard.dwArenaCount;
+
+	return TRUE;
+}
+
+void CArenaHeapImpl::ReleaseIdleArenas(TShard& shard)
+{
+	/* 先从空闲链表中摘除属于空闲内存区的内存块，再归还这些内存区 */
+	for(int i = 0; i < CLASS_COUNT; i++)
+	{
+		TBlockHead** ppHead = &shard.pFree[i];
+
+		while(*ppHead != nullptr)
+		{
+			if((*ppHead)->arena->live == 0)
+				*ppHead = FREE_NEXT(*ppHead);
+			else
+				ppHead = &FREE_NEXT(*ppHead);
+		}
+	}
+
+	if(shard.pArena != nullptr && shard.pArena->live == 0)
+	{
+		shard.pCursor	= nullptr;
+		shard.pLimit	= nullptr;
+	}
+
+	TArena** ppArena = &shard.pArena;
+
+	while(*ppArena != nullptr)
+	{
+		TArena* pArena = *ppArena;
+
+		if(pArena->live > 0)
+			ppArena = &pArena->next;
+		else
+		{
+			*ppArena = pArena->next;
+
+			UnmapMemory(pArena, pArena->size);
+			--shard.dwArenaCount;
+		}
+	}
+
+	if(shard.pArena == nullptr)
+		shard.dwNextArenaSize = (m_dwOptions & HEAP_HUGE_PAGES) ? HUGE_PAGE_SIZE : MIN(ARENA_MIN_SIZE, m_dwArenaSize);
+}
+
+void CArenaHeapImpl::ReleaseAllArenas(TShard& shard)
+{
+	/* 整块归还内存区与大块内存，不需要逐个摘除空闲内存块 */
+	while(shard.pArena != nullptr)
+	{
+		TArena* pArena = shard.pArena;
+		shard.pArena   = pArena->next;
+
+		UnmapMemory(pArena, pArena->size);
+	}
+
+	while(shard.pLarge != nullptr)
+	{
+		TLargeHead* pLarge = shard.pLarge;
+		shard.pLarge	   = pLarge->next;
+
+		UnmapMemory(pLarge, pLarge->size);
+	}
+
+	::ZeroMemory(shard.pFree, sizeof(shard.pFree));
+
+	shard.pCursor			= nullptr;
+	shard.pLimit			= nullptr;
+	shard.dwNextArenaSize	= (m_dwOptions & HEAP_HUGE_PAGES) ? HUGE_PAGE_SIZE : MIN(ARENA_MIN_SIZE, m_dwArenaSize);
+	shard.dwAllocBytes		= 0;
+	shard.dwArenaCount		= 0;
+	shard.dwLargeCount		= 0;
+}
+
+PVOID CArenaHeapImpl::MapMemory(SIZE_T dwSize)
+{
+	PVOID pv		= MAP_FAILED;
+	BOOL bHugePage	= (m_dwOptions & HEAP_HUGE_PAGES) && (dwSize % HUGE_PAGE_SIZE == 0);
+
+#if defined(__linux__) && defined(MAP_HUGETLB)
+	if(bHugePage)
+		pv = mmap(nullptr, dwSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#elif defined(__APPLE__) && defined(VM_FLAGS_SUPERPAGE_SIZE_2MB)
+	if(bHugePage)
+		pv = mmap(nullptr, dwSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, VM_FLAGS_SUPERPAGE_SIZE_2MB, 0);
+#endif
+
+	if(pv == MAP_FAILED)
+	{
+		pv = mmap(nullptr, dwSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+		if(pv == MAP_FAILED)
+			return nullptr;
+
+#if defined(MADV_HUGEPAGE)
+		if(bHugePage)
+			madvise(pv, dwSize, MADV_HUGEPAGE);
+#endif
+	}
+
+	m_dwReservedBytes += dwSize;
+
+	return pv;
+}
+
+void CArenaHeapImpl::UnmapMemory(PVOID pv, SIZE_T dwSize)
+{
+	VERIFY_IS_NO_ERROR(munmap(pv, dwSize));
+
+	m_dwReservedBytes -= dwSize;
+}
+
+int CArenaHeapImpl::GetClassIndex(SIZE_T dwSize)
+{
+	ASSERT(dwSize > 0 && dwSize <= ARENA_MAX_BLOCK_SIZE);
+
+	if(dwSize <= 128)
+		return (int)((dwSize + 15) >> 4) - 1;
+
+	/* 每个 2 的幂区间 (2^k, 2^(k+1)] 均分为 8 级 */
+	int k = 63 - __builtin_clzll((ULONGLONG)(dwSize - 1));
+
+	return (k - 7) * 8 + (int)((dwSize - 1) >> (k - 3));
+}
+
+SIZE_T CArenaHeapImpl::GetClassSize(int iClass)
+{
+	ASSERT(iClass >= 0 && iClass < CLASS_COUNT);
+
+	if(iClass < 8)
+		return (SIZE_T)(iClass + 1) << 4;
+
+	int j = iClass - 8;
+	int k = 7 + j / 8;
+
+	return ((SIZE_T)1 << k) + ((SIZE_T)(j % 8 + 1) << (k - 3));
+}
@@ -27,8 +27,23 @@
 #include "Singleton.h"
 #include <stdlib.h>
 #include "FuncHelper.h"
+#include "CriSec.h"
 
 #define HEAP_ZERO_MEMORY	0x08
+/* 私有堆选项：内存区使用大页（不支持时退化为普通页） */
+#define HEAP_HUGE_PAGES		0x00010000
+
+/* 私有堆统计信息（CGlobalHeapImpl 不记录统计信息，各字段均为 0） */
+struct THeapStat
+{
+	SIZE_T		allocBytes;		// 当前已分配字节数（按分级大小计）
+	SIZE_T		peakBytes;		// 已分配字节数峰值（各分片峰值之和）
+	SIZE_T		reservedBytes;	// 从系统映射的字节数
+	ULONGLONG	allocCount;		// 累计分配次数
+	ULONGLONG	freeCount;		// 累计释放次数
+	DWORD		arenaCount;		// 内存区数量
+	DWORD		largeCount;		// 大块内存数量
+};
 
 /*
     基于C内存管理函数的封装
@@ -85,6 +100,8 @@ public:
 	BOOL IsValid()	{return TRUE;}
 	BOOL Reset()	{return TRUE;}
 
+	void GetStat(THeapStat& stat)	{::ZeroMemory(&stat, sizeof(THeapStat));}
+
 public:
 	CGlobalHeapImpl	(DWORD dwOptions = 0, SIZE_T dwInitSize = 0, SIZE_T dwMaxSize = 0) {}
 	~CGlobalHeapImpl()	{}
@@ -92,8 +109,88 @@ public:
 	DECLARE_NO_COPY_CLASS(CGlobalHeapImpl)
 };
 
+/*
+    基于 mmap 内存区（Arena）的私有堆
+	1. 小块内存（<= ARENA_MAX_BLOCK_SIZE）按分级大小（每个 2 的幂区间 8 级）从内存区顺序分配，
+	   释放后进入所属级别的空闲链表，再次分配时优先复用
+	2. 内存区按需创建，大小从 ARENA_MIN_SIZE 开始倍增至 dwInitSize（默认 ARENA_MAX_SIZE）
+	3. 大块内存单独 mmap，释放时直接归还系统
+	4. 堆按线程划分为多个分片（不超过 CPU 核数，最多 MAX_SHARDS 个），每个分片拥有独立的锁、内存区与空闲链表，
+	   内存块释放时归还其所属分片
+	5. 每个内存区记录未释放的内存块数量，Compact() 只归还没有未释放内存块的内存区；
+	   Reset() 归还全部内存区与大块内存，此前分配的内存块全部失效（调用者须先释放或丢弃所有内存块）
+	6. 析构时不允许存在未释放的内存块（调试版本断言失败），析构后不能再释放此前分配的内存块
+	7. 记录分配字节数、分配/释放次数等统计信息，用于查看各组件的内存占用（GetStat()）
+*/
+class CArenaHeapImpl
+{
+public:
+	PVOID Alloc		(SIZE_T dwSize, DWORD dwFlags = 0);
+	PVOID ReAlloc	(PVOID pvMemory, SIZE_T dwSize, DWORD dwFlags = 0);
+	BOOL Free		(PVOID pvMemory, DWORD dwFlags = 0);
+	SIZE_T Compact	(DWORD dwFlags = 0);
+	SIZE_T Size		(PVOID pvMemory, DWORD dwFlags = 0);
+
+	BOOL IsValid()	{return TRUE;}
+	BOOL Reset();
+
+	void GetStat(THeapStat& stat);
+	SIZE_T GetAllocBytes	();
+	SIZE_T GetReservedBytes	()	{return m_dwReservedBytes.load(memory_order_relaxed);}
+
+private:
+	struct TBlockHead;
+	struct TLargeHead;
+	struct TArena;
+	struct TShard;
+
+	TShard& GetShard();
+	PVOID AllocSmall(TShard& shard, int iClass);
+	PVOID AllocLarge(TShard& shard, SIZE_T dwSize);
+	void FreeSmall(TShard& shard, TBlockHead* pHead);
+	void FreeLarge(TShard& shard, TLargeHead* pLarge);
+	BOOL NewArena(TShard& shard, SIZE_T dwBlockSize);
+	void ReleaseIdleArenas(TShard& shard);
+	void ReleaseAllArenas(TShard& shard);
+
+	PVOID MapMemory(SIZE_T dwSize);
+	void UnmapMemory(PVOID pv, SIZE_T dwSize);
+
+	static int GetClassIndex(SIZE_T dwSize);
+	static SIZE_T GetClassSize(int iClass);
+	static DWORD GetThreadOrdinal();
+
+public:
+	CArenaHeapImpl	(DWORD dwOptions = 0, SIZE_T dwInitSize = 0, SIZE_T dwMaxSize = 0);
+	~CArenaHeapImpl	();
+
+	DECLARE_NO_COPY_CLASS(CArenaHeapImpl)
+
+public:
+	static const SIZE_T ARENA_MIN_SIZE;
+	static const SIZE_T ARENA_MAX_SIZE;
+	static const SIZE_T ARENA_MAX_BLOCK_SIZE;
+	static const DWORD MAX_SHARDS = 16;
+
+private:
+	static const int CLASS_COUNT = 96;
+
+	DWORD		m_dwOptions;
+	SIZE_T		m_dwArenaSize;
+	SIZE_T		m_dwMaxSize;
+
+	TShard*		m_pShards;
+	DWORD		m_dwShardMask;
+
+	atomic<SIZE_T>	m_dwReservedBytes;
+};
+
 #if !defined (_USE_CUSTOM_PRIVATE_HEAP)
-	using CPrivateHeap = CGlobalHeapImpl;
+	#if defined (_USE_GLOBAL_PRIVATE_HEAP)
+		using CPrivateHeap = CGlobalHeapImpl;
+	#else
+		using CPrivateHeap = CArenaHeapImpl;
+	#endif
 #endif
 
 /*
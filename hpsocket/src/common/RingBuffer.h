@@ -28,6 +28,7 @@
 #include "STLHelper.h"
 #include "FuncHelper.h"
 #include "RWLock.h"
+#include "Epoch.h"
 using namespace std;
 
 #define CACHE_LINE		64
@@ -1032,6 +1033,258 @@ template <class T> T* const CRingPool<T>::E_MAX_STATUS	= (T*)0x0F;
 
 // ------------------------------------------------------------------------------------------------------------- //
 
+/*
+  带线程弹匣缓存的对象池
+  每个线程槽位持有一个小的 LIFO 弹匣（MAGAZINE_CAPACITY），稳态下的取/放只访问本槽位的缓存行；
+  弹匣为空时从全局 CRingPool 批量补充（MAGAZINE_BATCH），弹匣满时批量归还全局 CRingPool；
+  线程数多于槽位时，槽位被占用的线程直接访问全局 CRingPool；
+  归还全局 CRingPool 时其缓存的对象数不超过保留数量（Reset() 的 dwHold），多余的对象直接释放
+*/
+template <class T> class CMagazinePool
+{
+public:
+
+	static const DWORD MAGAZINE_BATCH		= 32;
+	static const DWORD MAGAZINE_CAPACITY	= 2 * MAGAZINE_BATCH;
+	static const DWORD MAX_MAGAZINE_SLOTS	= 64;
+
+private:
+
+	typedef T*			TPTR;
+
+	struct TMagazine
+	{
+		CSpinGuard	guard;
+		DWORD		count;
+
+		ULONGLONG	hits;
+		ULONGLONG	misses;
+		ULONGLONG	refills;
+		ULONGLONG	flushes;
+
+		TPTR		items[MAGAZINE_CAPACITY];
+	} __attribute__((aligned(CACHE_LINE)));
+
+public:
+
+	struct TStat
+	{
+		ULONGLONG hits;		// 弹匣命中次数
+		ULONGLONG misses;	// 弹匣与全局池均为空的次数
+		ULONGLONG refills;	// 从全局池批量补充次数
+		ULONGLONG flushes;	// 向全局池批量归还次数
+	};
+
+public:
+
+	BOOL TryPut(TPTR pElement)
+	{
+		ASSERT(pElement != nullptr);
+
+		if(!IsValid()) return FALSE;
+
+		TMagazine& mag = GetMagazine();
+
+		if(!mag.guard.TryLock())
+			return PutGlobal(pElement);
+
+		if(mag.count == MAGAZINE_CAPACITY)
+			Flush(mag, MAGAZINE_BATCH);
+
+		mag.items[mag.count++] = pElement;
+
+		mag.guard.Unlock();
+
+		return TRUE;
+	}
+
+	BOOL TryGet(TPTR* ppElement)
+	{
+		ASSERT(ppElement != nullptr);
+
+		if(!IsValid()) return FALSE;
+
+		TMagazine& mag = GetMagazine();
+
+		if(!mag.guard.TryLock())
+			return m_lsGlobal.TryGet(ppElement);
+
+		if(mag.count > 0)
+			++mag.hits;
+		else if(Refill(mag) == 0)
+		{
+			++mag.misses;
+			mag.guard.Unlock();
+
+			return FALSE;
+		}
+
+		*ppElement = mag.items[--mag.count];
+
+		mag.guard.Unlock();
+
+		return TRUE;
+	}
+
+	void Reset(DWORD dwSize = 0, DWORD dwHold = (DWORD)INFINITE)
+	{
+		Drain();
+
+		m_dwHold = MIN(dwHold, dwSize);
+
+		if(dwSize == 0)
+		{
+			if(m_pMagazines != nullptr)
+			{
+				delete[] m_pMagazines;
+
+				m_pMagazines = nullptr;
+				m_dwSlots	 = 0;
+			}
+		}
+		else if(m_pMagazines == nullptr)
+		{
+			DWORD dwSlots = 1;
+
+			while(dwSlots < (DWORD)PROCESSOR_COUNT && dwSlots < MAX_MAGAZINE_SLOTS)
+				dwSlots <<= 1;
+
+			m_pMagazines = new TMagazine[dwSlots];
+			m_dwSlots	 = dwSlots;
+
+			for(DWORD i = 0; i < dwSlots; i++)
+				ResetMagazine(m_pMagazines[i]);
+		}
+
+		m_lsGlobal.Reset(dwSize);
+	}
+
+	void Clear()
+	{
+		Drain();
+
+		m_lsGlobal.Clear();
+	}
+
+	void GetStat(TStat& stat)
+	{
+		::ZeroMemory(&stat, sizeof(TStat));
+
+		for(DWORD i = 0; i < m_dwSlots; i++)
+		{
+			TMagazine& mag = m_pMagazines[i];
+
+			stat.hits	 += mag.hits;
+			stat.misses	 += mag.misses;
+			stat.refills += mag.refills;
+			stat.flushes += mag.flushes;
+		}
+	}
+
+	/* 容量及缓存的对象数均包含各线程弹匣（弹匣计数不加锁读取，为近似值） */
+	DWORD Size()		{return m_lsGlobal.Size() + m_dwSlots * MAGAZINE_CAPACITY;}
+	DWORD Elements()
+	{
+		DWORD dwElements = m_lsGlobal.Elements();
+
+		for(DWORD i = 0; i < m_dwSlots; i++)
+			dwElements += m_pMagazines[i].count;
+
+		return dwElements;
+	}
+
+	DWORD GetHold()		{return m_dwHold;}
+	BOOL IsValid()		{return m_lsGlobal.IsValid();}
+
+private:
+
+	TMagazine& GetMagazine()
+	{
+		static atomic<DWORD> s_dwSlotSeq(0);
+		static thread_local DWORD s_dwSlot = s_dwSlotSeq.fetch_add(1, memory_order_relaxed);
+
+		return m_pMagazines[s_dwSlot & (m_dwSlots - 1)];
+	}
+
+	DWORD Refill(TMagazine& mag)
+	{
+		while(mag.count < MAGAZINE_BATCH && m_lsGlobal.TryGet(&mag.items[mag.count]))
+			++mag.count;
+
+		if(mag.count > 0)
+			++mag.refills;
+
+		return mag.count;
+	}
+
+	void Flush(TMagazine& mag, DWORD dwCount)
+	{
+		for(DWORD i = 0; i < dwCount && mag.count > 0; i++)
+		{
+			TPTR pElement = mag.items[--mag.count];
+
+			if(!PutGlobal(pElement))
+				T::Destruct(pElement);
+		}
+
+		++mag.flushes;
+	}
+
+	BOOL PutGlobal(TPTR pElement)
+	{
+		if(m_lsGlobal.Elements() >= m_dwHold)
+			return FALSE;
+
+		return m_lsGlobal.TryPut(pElement);
+	}
+
+	void Drain()
+	{
+		for(DWORD i = 0; i < m_dwSlots; i++)
+		{
+			TMagazine& mag = m_pMagazines[i];
+			CLocalLock<CSpinGuard> locallock(mag.guard);
+
+			while(mag.count > 0)
+				T::Destruct(mag.items[--mag.count]);
+		}
+	}
+
+	static void ResetMagazine(TMagazine& mag)
+	{
+		mag.count	= 0;
+		mag.hits	= 0;
+		mag.misses	= 0;
+		mag.refills	= 0;
+		mag.flushes	= 0;
+	}
+
+public:
+
+	CMagazinePool(DWORD dwSize = 0)
+	: m_pMagazines(nullptr)
+	, m_dwSlots(0)
+	, m_dwHold(0)
+	{
+		Reset(dwSize);
+	}
+
+	~CMagazinePool()
+	{
+		Reset(0);
+	}
+
+	DECLARE_NO_COPY_CLASS(CMagazinePool)
+
+private:
+	TMagazine*		m_pMagazines;
+	DWORD			m_dwSlots;
+	DWORD			m_dwHold;
+	CRingPool<T>	m_lsGlobal;
+};
+
+// ------------------------------------------------------------------------------------------------------------- //
+
 /*
   无锁的线程安全队列
   基于CAS机制，内部使用Node链表
@@ -1736,11 +1989,8 @@ template <class T> using CCASQueue			= CCASQueueX<T>;
 template <class T> using CCASSimpleQueue	= CCASSimpleQueueX<T>;
 
 template<typename T>
-void ReleaseGCObj(CCASQueue<T>& lsGC, DWORD dwLockTime, BOOL bForce = FALSE)
+void ReleaseGCObj(CCASQueue<T>& lsGC, BOOL bForce = FALSE)
 {
-	static const int MIN_CHECK_INTERVAL = 1 * 1000;
-	static const int MAX_CHECK_INTERVAL = 15 * 1000;
-
 	T* pObj = nullptr;
 
 	if(bForce)
@@ -1755,12 +2005,9 @@ void ReleaseGCObj(CCASQueue<T>& lsGC, DWORD dwLockTime, BOOL bForce = FALSE)
 	}
 	else
 	{
-		if(lsGC.IsEmpty() || lsGC.GetCheckTimeGap() < MAX(MIN((int)(dwLockTime / 3), MAX_CHECK_INTERVAL), MIN_CHECK_INTERVAL))
+		if(lsGC.IsEmpty())
 			return;
 
-		BOOL bFirst	= TRUE;
-		DWORD now	= 0;
-
 		while(TRUE)
 		{
 			ASSERT((pObj = nullptr) == nullptr);
@@ -1771,18 +2018,11 @@ void ReleaseGCObj(CCASQueue<T>& lsGC, DWORD dwLockTime, BOOL bForce = FALSE)
 				if(!locallock.IsValid())
 					break;
 
-				if(bFirst)
-				{
-					bFirst	= FALSE;
-					now		= ::TimeGetTime();
-
-					lsGC.UpdateCheckTime(now);
-				}
-
 				if(!lsGC.UnsafePeekFront(&pObj))
 					break;
 
-				if((int)(now - pObj->GetFreeTime()) < (int)dwLockTime)
+				/* GC 队列中的对象基本按回收纪元递增排列，队首对象仍被引用时不再检查后续对象 */
+				if(!CEpochDomain::IsReclaimable(pObj->GetFreeEpoch()))
 					break;
 
 				lsGC.UnsafePopFrontNotCheck();
@@ -43,8 +43,6 @@ static pid_t __gettid(){
 
 /* 最大工作线程数 */
 #define MAX_WORKER_THREAD_COUNT			512
-/* 默认对象缓存对象锁定时间 */
-#define DEFAULT_OBJECT_CACHE_LOCK_TIME	(20 * 1000)
 /* 默认对象缓存池大小 */
 #define DEFAULT_OBJECT_CACHE_POOL_SIZE	600
 /* 默认对象缓存池回收阀值 */
@@ -55,6 +53,10 @@ static pid_t __gettid(){
 #define DEFAULT_BUFFER_CACHE_POOL_SIZE	1024
 /* 默认内存块缓存池回收阀值 */
 #define DEFAULT_BUFFER_CACHE_POOL_HOLD	1024
+/* 内存块分级缓存最小容量（2 的幂） */
+#define BUFFER_CACHE_CLASS_MIN_CAPACITY	128
+/* 内存块分级缓存最大容量（2 的幂） */
+#define BUFFER_CACHE_CLASS_MAX_CAPACITY	(16 * DEFAULT_BUFFER_CACHE_CAPACITY)
 
 #define SysGetSystemConfig				sysconf
 #define SysGetSystemInfo				sysinfo
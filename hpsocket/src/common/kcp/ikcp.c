@@ -310,6 +310,7 @@ ikcpcb* ikcp_create(IUINT32 conv, void *user)
 	kcp->fastlimit = IKCP_FASTACK_LIMIT;
 	kcp->nocwnd = 0;
 	kcp->xmit = 0;
+	kcp->fastxmit = 0;
 	kcp->dead_link = IKCP_DEADLINK;
 	kcp->output = NULL;
 	kcp->writelog = NULL;
@@ -1306,6 +1307,7 @@ void ikcp_flush(ikcpcb *kcp)
 				kcp->fastlimit <= 0) {
 				needsend = 1;
 				segment->xmit++;
+				kcp->fastxmit++;
 				segment->fastack = 0; //重置被跳过次数标识
 				segment->resendts = current + segment->rto; //重新设置超时时间戳
 				change++;
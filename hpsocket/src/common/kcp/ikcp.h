@@ -331,6 +331,8 @@ struct IKCPCB
 	IINT32 rx_rttval, rx_srtt, rx_rto, rx_minrto;
 	IUINT32 snd_wnd, rcv_wnd, rmt_wnd, cwnd, probe;
 	IUINT32 current, interval, ts_flush, xmit;
+	/*! fastxmit: 快速重传的分片数（xmit 只统计超时重传） */
+	IUINT32 fastxmit;
 	IUINT32 nrcv_buf, nsnd_buf;
 	/*! 接收队列数量与发送队列的数量 */
 	IUINT32 nrcv_que, nsnd_que;
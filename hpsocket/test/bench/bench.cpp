@@ -0,0 +1,910 @@
+#include "../helper.h"
+#include "../../src/TcpServer.h"
+#include "../../src/TcpAgent.h"
+#include "../../src/TcpPackServer.h"
+#include "../../src/TcpPackAgent.h"
+#include "../../src/TcpPullServer.h"
+#include "../../src/TcpPullAgent.h"
+#include "../../src/UdpServer.h"
+#include "../../src/UdpClient.h"
+#include "../../src/UdpArqServer.h"
+#include "../../src/UdpArqClient.h"
+#include "../../src/HttpServer.h"
+#include "../../src/HttpAgent.h"
+#include "../../src/SSLServer.h"
+#include "../../src/SSLAgent.h"
+#include "../../src/common/Metrics.h"
+
+#include <sys/resource.h>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <functional>
+
+/*
+  非交互式回环基准测试：每个用例启动一个回显服务端与 N 个连接，每个连接保持 window 条在途消息，
+  预热后统计回显吞吐、往返时延分布与每条消息的 CPU 耗时（服务端与客户端在同一进程内），结果输出为 JSON
+
+  用法：bench_loopback [-p tcp,pack,pull,udp,arq,http,ssl] [-s 64,1024,16384] [-c 1,16,64]
+                       [-w window] [-d duration_ms] [-u warmup_ms] [-P port] [-o result.json]
+*/
+
+#define BENCH_MAX_WINDOW        64
+#define BENCH_CONNECT_TIMEOUT   10000
+#define BENCH_STALL_TIMEOUT     200
+#define BENCH_HTTP_PATH         "/echo"
+
+struct TBenchConn
+{
+    CSpinGuard  cs;
+    CONNID      connID;
+    IUdpClient* pClient;
+
+    ULLONG      sendTimes[BENCH_MAX_WINDOW];
+    int         head;
+    int         count;
+    int         received;
+    ULLONG      lastActive;
+
+    TBenchConn() : connID(0), pClient(nullptr), head(0), count(0), received(0), lastActive(0) {}
+};
+
+struct TBenchResult
+{
+    LPCSTR      protocol;
+    int         msgSize;
+    int         conns;
+    int         window;
+    LPCSTR      status;
+
+    ULLONG      msgs;
+    ULLONG      lost;
+    ULLONG      errors;
+    double      seconds;
+    double      cpuSeconds;
+
+    CLatencyHistogram::TStat latency;
+};
+
+class CBenchSession
+{
+public:
+    using Fn_Send = function<BOOL(TBenchConn*, const BYTE*, int)>;
+
+public:
+    void OnReady()
+    {
+        ++m_iReady;
+    }
+
+    /* 开始发送：每个连接先发出 window 条消息 */
+    void Kick()
+    {
+        m_bRunning = TRUE;
+
+        for(auto& pConn : m_conns)
+        {
+            CSpinLock locallock(pConn->cs);
+
+            pConn->lastActive = ::TimeGetNanos();
+
+            while(pConn->count < m_iWindow && SendOne(pConn.get()));
+        }
+    }
+
+    /* 流式协议：按消息长度切分回显数据 */
+    void OnStreamData(TBenchConn* pConn, int iLength)
+    {
+        CSpinLock locallock(pConn->cs);
+
+        pConn->received += iLength;
+
+        while(pConn->received >= m_iMsgSize)
+        {
+            pConn->received -= m_iMsgSize;
+            Complete(pConn);
+        }
+    }
+
+    /* 消息协议：每次回调为一条完整消息 */
+    void OnMessage(TBenchConn* pConn)
+    {
+        CSpinLock locallock(pConn->cs);
+
+        Complete(pConn);
+    }
+
+    /* 可能丢包的协议（UDP）：在途消息超时未回显时视为丢失并重新发出 */
+    void CheckStalls()
+    {
+        if(!m_bLossy || !m_bRunning)
+            return;
+
+        ULLONG ullNow = ::TimeGetNanos();
+
+        for(auto& pConn : m_conns)
+        {
+            CSpinLock locallock(pConn->cs);
+
+            if(ullNow - pConn->lastActive < BENCH_STALL_TIMEOUT * 1000000ull)
+                continue;
+
+            if(m_bRecording)
+                m_ullLost += pConn->count;
+
+            pConn->head         = 0;
+            pConn->count        = 0;
+            pConn->received     = 0;
+            pConn->lastActive   = ullNow;
+
+            while(pConn->count < m_iWindow && SendOne(pConn.get()));
+        }
+    }
+
+    void StartRecording()
+    {
+        m_latency.Reset();
+
+        m_ullMsgs   = 0;
+        m_ullLost   = 0;
+        m_ullErrors = 0;
+
+        m_bRecording = TRUE;
+    }
+
+    void StopRecording()    {m_bRecording = FALSE;}
+    void Stop()             {m_bRunning = FALSE;}
+
+    int GetReady()          {return m_iReady;}
+    ULLONG GetMsgs()        {return m_ullMsgs;}
+    ULLONG GetLost()        {return m_ullLost;}
+    ULLONG GetErrors()      {return m_ullErrors;}
+
+    void GetLatency(CLatencyHistogram::TStat& stat) {m_latency.GetStat(stat);}
+
+    TBenchConn* GetConn(int i)  {return m_conns[i].get();}
+    int GetMsgSize()            {return m_iMsgSize;}
+    const BYTE* GetPayload()    {return m_payload.Ptr();}
+
+private:
+    BOOL SendOne(TBenchConn* pConn)
+    {
+        int iTail = (pConn->head + pConn->count) % BENCH_MAX_WINDOW;
+
+        pConn->sendTimes[iTail] = ::TimeGetNanos();
+        ++pConn->count;
+
+        if(!m_fnSend(pConn, m_payload.Ptr(), m_iMsgSize))
+        {
+            --pConn->count;
+            ++m_ullErrors;
+
+            return FALSE;
+        }
+
+        return TRUE;
+    }
+
+    void Complete(TBenchConn* pConn)
+    {
+        if(pConn->count == 0)
+            return;
+
+        ULLONG ullNow   = ::TimeGetNanos();
+        ULLONG ullSend  = pConn->sendTimes[pConn->head];
+
+        pConn->head = (pConn->head + 1) % BENCH_MAX_WINDOW;
+        --pConn->count;
+        pConn->lastActive = ullNow;
+
+        if(m_bRecording)
+        {
+            ++m_ullMsgs;
+            m_latency.Record(ullNow - ullSend);
+        }
+
+        if(m_bRunning)
+            SendOne(pConn);
+    }
+
+public:
+    CBenchSession(int iMsgSize, int iConns, int iWindow, BOOL bLossy, Fn_Send fnSend)
+    : m_iMsgSize(iMsgSize)
+    , m_iWindow(iWindow)
+    , m_bLossy(bLossy)
+    , m_fnSend(fnSend)
+    , m_payload(iMsgSize)
+    , m_iReady(0)
+    , m_bRunning(FALSE)
+    , m_bRecording(FALSE)
+    , m_ullMsgs(0)
+    , m_ullLost(0)
+    , m_ullErrors(0)
+    {
+        for(int i = 0; i < iMsgSize; i++)
+            m_payload[i] = (BYTE)('a' + i % 26);
+
+        for(int i = 0; i < iConns; i++)
+            m_conns.emplace_back(new TBenchConn);
+    }
+
+private:
+    int                 m_iMsgSize;
+    int                 m_iWindow;
+    BOOL                m_bLossy;
+    Fn_Send             m_fnSend;
+    CBufferPtr          m_payload;
+
+    vector<unique_ptr<TBenchConn>> m_conns;
+
+    atomic<int>         m_iReady;
+    atomic<BOOL>        m_bRunning;
+    atomic<BOOL>        m_bRecording;
+    atomic<ULLONG>      m_ullMsgs;
+    atomic<ULLONG>      m_ullLost;
+    atomic<ULLONG>      m_ullErrors;
+
+    CLatencyHistogram   m_latency;
+};
+
+// ------------------------------------------------------------------------------------------------------------- //
+
+class CEchoServerListener : public CTcpServerListener
+{
+public:
+    virtual EnHandleResult OnReceive(ITcpServer* pSender, CONNID dwConnID, const BYTE* pData, int iLength) override
+    {
+        return pSender->Send(dwConnID, pData, iLength) ? HR_OK : HR_ERROR;
+    }
+
+    virtual EnHandleResult OnClose(ITcpServer* pSender, CONNID dwConnID, EnSocketOperation enOperation, int iErrorCode) override
+    {
+        return HR_OK;
+    }
+};
+
+class CPullEchoServerListener : public CTcpPullServerListener
+{
+public:
+    virtual EnHandleResult OnReceive(ITcpServer* pSender, CONNID dwConnID, int iLength) override
+    {
+        CBufferPtr buffer(iLength);
+
+        if(m_pPull->Fetch(dwConnID, buffer, iLength) != FR_OK)
+            return HR_ERROR;
+
+        return pSender->Send(dwConnID, buffer, iLength) ? HR_OK : HR_ERROR;
+    }
+
+    virtual EnHandleResult OnClose(ITcpServer* pSender, CONNID dwConnID, EnSocketOperation enOperation, int iErrorCode) override
+    {
+        return HR_OK;
+    }
+
+public:
+    IPullSocket* m_pPull = nullptr;
+};
+
+class CUdpEchoServerListener : public CUdpServerListener
+{
+public:
+    virtual EnHandleResult OnReceive(IUdpServer* pSender, CONNID dwConnID, const BYTE* pData, int iLength) override
+    {
+        return pSender->Send(dwConnID, pData, iLength) ? HR_OK : HR_ERROR;
+    }
+
+    virtual EnHandleResult OnClose(IUdpServer* pSender, CONNID dwConnID, EnSocketOperation enOperation, int iErrorCode) override
+    {
+        return HR_OK;
+    }
+};
+
+class CHttpEchoServerListener : public CHttpServerListener
+{
+public:
+    virtual EnHandleResult OnAccept(ITcpServer* pSender, CONNID dwConnID, UINT_PTR soClient) override
+    {
+        pSender->SetConnectionExtra(dwConnID, new CBufferPtr);
+        return HR_OK;
+    }
+
+    virtual EnHttpParseResult OnHeadersComplete(IHttpServer* pSender, CONNID dwConnID) override
+    {
+        return HPR_OK;
+    }
+
+    virtual EnHttpParseResult OnBody(IHttpServer* pSender, CONNID dwConnID, const BYTE* pData, int iLength) override
+    {
+        CBufferPtr* pBuffer = nullptr;
+        pSender->GetConnectionExtra(dwConnID, (PVOID*)&pBuffer);
+
+        pBuffer->Cat(pData, iLength);
+        return HPR_OK;
+    }
+
+    virtual EnHttpParseResult OnMessageComplete(IHttpServer* pSender, CONNID dwConnID) override
+    {
+        CBufferPtr* pBuffer = nullptr;
+        pSender->GetConnectionExtra(dwConnID, (PVOID*)&pBuffer);
+
+        BOOL isOK = pSender->SendResponse(dwConnID, HSC_OK, "OK", nullptr, 0, pBuffer->Ptr(), (int)pBuffer->Size());
+        pBuffer->Free();
+
+        return isOK ? HPR_OK : HPR_ERROR;
+    }
+
+    virtual EnHttpParseResult OnParseError(IHttpServer* pSender, CONNID dwConnID, int iErrorCode, LPCSTR lpszErrorDesc) override
+    {
+        return HPR_ERROR;
+    }
+
+    virtual EnHandleResult OnClose(ITcpServer* pSender, CONNID dwConnID, EnSocketOperation enOperation, int iErrorCode) override
+    {
+        CBufferPtr* pBuffer = nullptr;
+
+        if(pSender->GetConnectionExtra(dwConnID, (PVOID*)&pBuffer) && pBuffer != nullptr)
+            delete pBuffer;
+
+        return HR_OK;
+    }
+};
+
+// ------------------------------------------------------------------------------------------------------------- //
+
+class CBenchAgentListener : public CTcpAgentListener
+{
+public:
+    virtual EnHandleResult OnHandShake(ITcpAgent* pSender, CONNID dwConnID) override
+    {
+        m_pSession->OnReady();
+        return HR_OK;
+    }
+
+    virtual EnHandleResult OnReceive(ITcpAgent* pSender, CONNID dwConnID, const BYTE* pData, int iLength) override
+    {
+        TBenchConn* pConn = GetConn(pSender, dwConnID);
+
+        m_bMessage ? m_pSession->OnMessage(pConn) : m_pSession->OnStreamData(pConn, iLength);
+        return HR_OK;
+    }
+
+    virtual EnHandleResult OnClose(ITcpAgent* pSender, CONNID dwConnID, EnSocketOperation enOperation, int iErrorCode) override
+    {
+        return HR_OK;
+    }
+
+protected:
+    static TBenchConn* GetConn(ITcpAgent* pSender, CONNID dwConnID)
+    {
+        TBenchConn* pConn = nullptr;
+        pSender->GetConnectionExtra(dwConnID, (PVOID*)&pConn);
+
+        return pConn;
+    }
+
+public:
+    CBenchSession*  m_pSession  = nullptr;
+    BOOL            m_bMessage  = FALSE;
+};
+
+class CBenchPullAgentListener : public CTcpPullAgentListener
+{
+public:
+    virtual EnHandleResult OnHandShake(ITcpAgent* pSender, CONNID dwConnID) override
+    {
+        m_pSession->OnReady();
+        return HR_OK;
+    }
+
+    virtual EnHandleResult OnReceive(ITcpAgent* pSender, CONNID dwConnID, int iLength) override
+    {
+        TBenchConn* pConn = nullptr;
+        pSender->GetConnectionExtra(dwConnID, (PVOID*)&pConn);
+
+        CBufferPtr buffer(iLength);
+
+        if(m_pPull->Fetch(dwConnID, buffer, iLength) != FR_OK)
+            return HR_ERROR;
+
+        m_pSession->OnStreamData(pConn, iLength);
+        return HR_OK;
+    }
+
+    virtual EnHandleResult OnClose(ITcpAgent* pSender, CONNID dwConnID, EnSocketOperation enOperation, int iErrorCode) override
+    {
+        return HR_OK;
+    }
+
+public:
+    CBenchSession*  m_pSession  = nullptr;
+    IPullSocket*    m_pPull     = nullptr;
+};
+
+class CBenchHttpAgentListener : public CHttpAgentListener
+{
+public:
+    virtual EnHandleResult OnHandShake(ITcpAgent* pSender, CONNID dwConnID) override
+    {
+        m_pSession->OnReady();
+        return HR_OK;
+    }
+
+    virtual EnHttpParseResult OnHeadersComplete(IHttpAgent* pSender, CONNID dwConnID) override
+    {
+        return HPR_OK;
+    }
+
+    virtual EnHttpParseResult OnBody(IHttpAgent* pSender, CONNID dwConnID, const BYTE* pData, int iLength) override
+    {
+        return HPR_OK;
+    }
+
+    virtual EnHttpParseResult OnMessageComplete(IHttpAgent* pSender, CONNID dwConnID) override
+    {
+        TBenchConn* pConn = nullptr;
+        pSender->GetConnectionExtra(dwConnID, (PVOID*)&pConn);
+
+        m_pSession->OnMessage(pConn);
+        return HPR_OK;
+    }
+
+    virtual EnHttpParseResult OnParseError(IHttpAgent* pSender, CONNID dwConnID, int iErrorCode, LPCSTR lpszErrorDesc) override
+    {
+        return HPR_ERROR;
+    }
+
+    virtual EnHandleResult OnClose(ITcpAgent* pSender, CONNID dwConnID, EnSocketOperation enOperation, int iErrorCode) override
+    {
+        return HR_OK;
+    }
+
+public:
+    CBenchSession* m_pSession = nullptr;
+};
+
+class CBenchUdpClientListener : public CUdpClientListener
+{
+public:
+    virtual EnHandleResult OnHandShake(IUdpClient* pSender, CONNID dwConnID) override
+    {
+        m_pSession->OnReady();
+        return HR_OK;
+    }
+
+    virtual EnHandleResult OnReceive(IUdpClient* pSender, CONNID dwConnID, const BYTE* pData, int iLength) override
+    {
+        m_pSession->OnMessage((TBenchConn*)pSender->GetExtra());
+        return HR_OK;
+    }
+
+    virtual EnHandleResult OnClose(IUdpClient* pSender, CONNID dwConnID, EnSocketOperation enOperation, int iErrorCode) override
+    {
+        return HR_OK;
+    }
+
+public:
+    CBenchSession* m_pSession = nullptr;
+};
+
+// ------------------------------------------------------------------------------------------------------------- //
+
+struct TBenchArgs
+{
+    vector<string>  protocols   = {"tcp", "pack", "pull", "udp", "arq", "http", "ssl"};
+    vector<int>     sizes       = {64, 1024, 16384};
+    vector<int>     conns       = {1, 16, 64};
+    int             window      = 1;
+    DWORD           duration    = 3000;
+    DWORD           warmup      = 1000;
+    USHORT          port        = DEF_TCP_UDP_PORT;
+    string          output;
+};
+
+static TBenchArgs g_bench_args;
+
+static double GetCpuSeconds()
+{
+    rusage ru;
+    ::getrusage(RUSAGE_SELF, &ru);
+
+    return  ru.ru_utime.tv_sec + ru.ru_utime.tv_usec / 1000000.0 +
+            ru.ru_stime.tv_sec + ru.ru_stime.tv_usec / 1000000.0;
+}
+
+static BOOL WaitForReady(CBenchSession& session, int iConns)
+{
+    DWORD dwBegin = ::TimeGetTime();
+
+    while(session.GetReady() < iConns)
+    {
+        if(::GetTimeGap32(dwBegin) > BENCH_CONNECT_TIMEOUT)
+            return FALSE;
+
+        ::WaitFor(10);
+    }
+
+    return TRUE;
+}
+
+/* 运行一个用例：等待连接就绪，预热后在统计窗口内采集结果 */
+static void Measure(CBenchSession& session, int iConns, TBenchResult& result)
+{
+    if(!WaitForReady(session, iConns))
+    {
+        result.status = "connect_timeout";
+        return;
+    }
+
+    session.Kick();
+
+    DWORD dwBegin = ::TimeGetTime();
+
+    while(::GetTimeGap32(dwBegin) < g_bench_args.warmup)
+    {
+        session.CheckStalls();
+        ::WaitFor(20);
+    }
+
+    double dCpu     = GetCpuSeconds();
+    ULLONG ullBegin = ::TimeGetNanos();
+
+    session.StartRecording();
+    dwBegin = ::TimeGetTime();
+
+    while(::GetTimeGap32(dwBegin) < g_bench_args.duration)
+    {
+        session.CheckStalls();
+        ::WaitFor(20);
+    }
+
+    session.StopRecording();
+
+    result.seconds      = (::TimeGetNanos() - ullBegin) / 1000000000.0;
+    result.cpuSeconds   = GetCpuSeconds() - dCpu;
+    result.msgs         = session.GetMsgs();
+    result.lost         = session.GetLost();
+    result.errors       = session.GetErrors();
+    result.status       = (result.msgs > 0) ? "ok" : "no_traffic";
+
+    session.GetLatency(result.latency);
+    session.Stop();
+}
+
+template<class S, class A, class SL, class AL>
+static void InitPullListeners(S& server, A& agent, SL& serverListener, AL& agentListener) {}
+
+static void InitPullListeners(CTcpPullServer& server, CTcpPullAgent& agent, CPullEchoServerListener& serverListener, CBenchPullAgentListener& agentListener)
+{
+    serverListener.m_pPull  = &server;
+    agentListener.m_pPull   = &agent;
+}
+
+template<class S, class A>
+static void SetupSecurity(S& server, A& agent) {}
+
+static void SetupSecurity(CSSLServer& server, CSSLAgent& agent)
+{
+    VERIFY(server.SetupSSLContextByMemory(SSL_VM_NONE, g_s_lpszPemCert, g_s_lpszPemKey, g_s_lpszKeyPasswod));
+    VERIFY(agent.SetupSSLContextByMemory(SSL_VM_NONE));
+}
+
+template<class S, class A>
+static void SetupPack(S& server, A& agent) {}
+
+static void SetupPack(CTcpPackServer& server, CTcpPackAgent& agent)
+{
+    server.SetMaxPackSize(0x3FFFFF);
+    agent.SetMaxPackSize(0x3FFFFF);
+}
+
+template<class T>
+static void SetupArq(T& socket) {}
+
+static void SetupArq(CUdpArqServer& socket)
+{
+    socket.SetNoDelay(TRUE);
+    socket.SetTurnoffCongestCtrl(TRUE);
+    socket.SetFlushInterval(10);
+}
+
+static void SetupArq(CUdpArqClient& socket)
+{
+    socket.SetNoDelay(TRUE);
+    socket.SetTurnoffCongestCtrl(TRUE);
+    socket.SetFlushInterval(10);
+}
+
+template<class A>
+static CBenchSession::Fn_Send MakeSender(A& agent)
+{
+    return [&agent](TBenchConn* pConn, const BYTE* pData, int iLength) {return agent.Send(pConn->connID, pData, iLength);};
+}
+
+static CBenchSession::Fn_Send MakeSender(CHttpAgent& agent)
+{
+    return [&agent](TBenchConn* pConn, const BYTE* pData, int iLength) {return agent.SendPost(pConn->connID, BENCH_HTTP_PATH, nullptr, 0, pData, iLength);};
+}
+
+/* TCP 系（TCP / PACK / PULL / SSL / HTTP）：服务端 + 通信代理 */
+template<class S, class A, class SL, class AL>
+static void RunAgentCase(TBenchResult& result, SL& serverListener, AL& agentListener)
+{
+    S server(&serverListener);
+    A agent(&agentListener);
+
+    CBenchSession session(result.msgSize, result.conns, result.window, FALSE, MakeSender(agent));
+    agentListener.m_pSession = &session;
+
+    InitPullListeners(server, agent, serverListener, agentListener);
+    SetupSecurity(server, agent);
+    SetupPack(server, agent);
+
+    if(!server.Start(IPV4_LOOPBACK_ADDRESS, g_bench_args.port) || !agent.Start(IPV4_LOOPBACK_ADDRESS, TRUE))
+    {
+        result.status = "start_failed";
+        return;
+    }
+
+    for(int i = 0; i < result.conns; i++)
+    {
+        TBenchConn* pConn = session.GetConn(i);
+
+        if(!agent.Connect(IPV4_LOOPBACK_ADDRESS, g_bench_args.port, &pConn->connID, pConn))
+        {
+            result.status = "connect_failed";
+            break;
+        }
+    }
+
+    if(result.status == nullptr)
+        Measure(session, result.conns, result);
+
+    agent.Stop();
+    server.Stop();
+}
+
+/* UDP 系（UDP / ARQ）：服务端 + 每个连接一个客户端 */
+template<class S, class C>
+static void RunClientCase(TBenchResult& result, BOOL bLossy)
+{
+    CUdpEchoServerListener serverListener;
+    CBenchUdpClientListener clientListener;
+
+    S server(&serverListener);
+    vector<unique_ptr<C>> clients;
+
+    CBenchSession session(result.msgSize, result.conns, result.window, bLossy,
+        [](TBenchConn* pConn, const BYTE* pData, int iLength) {return pConn->pClient->Send(pData, iLength);});
+
+    clientListener.m_pSession = &session;
+
+    SetupArq(server);
+
+    if(!server.Start(IPV4_LOOPBACK_ADDRESS, g_bench_args.port))
+    {
+        result.status = "start_failed";
+        return;
+    }
+
+    for(int i = 0; i < result.conns; i++)
+    {
+        TBenchConn* pConn = session.GetConn(i);
+        C* pClient = new C(&clientListener);
+
+        clients.emplace_back(pClient);
+        pConn->pClient = pClient;
+        pClient->SetExtra(pConn);
+
+        SetupArq(*pClient);
+
+        if(!pClient->Start(IPV4_LOOPBACK_ADDRESS, g_bench_args.port, TRUE))
+        {
+            result.status = "connect_failed";
+            break;
+        }
+    }
+
+    if(result.status == nullptr)
+        Measure(session, result.conns, result);
+
+    for(auto& pClient : clients)
+        pClient->Stop();
+
+    server.Stop();
+}
+
+// ------------------------------------------------------------------------------------------------------------- //
+
+static void RunCase(TBenchResult& result)
+{
+    LPCSTR p = result.protocol;
+
+    if(strcmp(p, "tcp") == 0)
+    {
+        CEchoServerListener sl; CBenchAgentListener al;
+        RunAgentCase<CTcpServer, CTcpAgent>(result, sl, al);
+    }
+    else if(strcmp(p, "pack") == 0)
+    {
+        CEchoServerListener sl; CBenchAgentListener al;
+        al.m_bMessage = TRUE;
+        RunAgentCase<CTcpPackServer, CTcpPackAgent>(result, sl, al);
+    }
+    else if(strcmp(p, "pull") == 0)
+    {
+        CPullEchoServerListener sl; CBenchPullAgentListener al;
+        RunAgentCase<CTcpPullServer, CTcpPullAgent>(result, sl, al);
+    }
+    else if(strcmp(p, "ssl") == 0)
+    {
+        CEchoServerListener sl; CBenchAgentListener al;
+        RunAgentCase<CSSLServer, CSSLAgent>(result, sl, al);
+    }
+    else if(strcmp(p, "http") == 0)
+    {
+        CHttpEchoServerListener sl; CBenchHttpAgentListener al;
+        RunAgentCase<CHttpServer, CHttpAgent>(result, sl, al);
+    }
+    else if(strcmp(p, "udp") == 0)
+        RunClientCase<CUdpServer, CUdpClient>(result, TRUE);
+    else if(strcmp(p, "arq") == 0)
+        RunClientCase<CUdpArqServer, CUdpArqClient>(result, FALSE);
+    else
+        result.status = "unknown_protocol";
+}
+
+/* 协议限制：UDP 单条消息不超过数据报长度，HTTP 与 UDP 每连接只保持一条在途消息 */
+static LPCSTR CheckCase(TBenchResult& result)
+{
+    if(strcmp(result.protocol, "udp") == 0 && result.msgSize > DEFAULT_UDP_MAX_DATAGRAM_SIZE)
+        return "skipped";
+    if(strcmp(result.protocol, "arq") == 0 && result.msgSize > DEFAULT_ARQ_MAX_MSG_SIZE)
+        return "skipped";
+
+    if(strcmp(result.protocol, "http") == 0 || strcmp(result.protocol, "udp") == 0)
+        result.window = 1;
+
+    return nullptr;
+}
+
+// ------------------------------------------------------------------------------------------------------------- //
+
+static void AppendResult(CStringA& strJson, const TBenchResult& r, BOOL bFirst)
+{
+    double dMsgs    = r.seconds > 0 ? r.msgs / r.seconds : 0;
+    double dMB      = dMsgs * r.msgSize / (1024.0 * 1024.0);
+    double dCpu     = r.msgs > 0 ? r.cpuSeconds * 1000000.0 / r.msgs : 0;
+    double dMean    = r.latency.count > 0 ? (double)r.latency.sum / r.latency.count / 1000.0 : 0;
+
+    strJson.AppendFormat("%s\n    {\"protocol\": \"%s\", \"msg_size\": %d, \"connections\": %d, \"window\": %d, \"status\": \"%s\", "
+                         "\"msgs\": %llu, \"lost\": %llu, \"errors\": %llu, \"seconds\": %.3f, "
+                         "\"msgs_per_sec\": %.1f, \"mb_per_sec\": %.3f, \"cpu_us_per_msg\": %.3f, "
+                         "\"latency_us\": {\"mean\": %.2f, \"min\": %.2f, \"p50\": %.2f, \"p90\": %.2f, \"p99\": %.2f, \"p999\": %.2f, \"max\": %.2f}}",
+                         bFirst ? "" : ",", r.protocol, r.msgSize, r.conns, r.window, r.status,
+                         r.msgs, r.lost, r.errors, r.seconds,
+                         dMsgs, dMB, dCpu,
+                         dMean, r.latency.min / 1000.0, r.latency.p50 / 1000.0, r.latency.p90 / 1000.0,
+                         r.latency.p99 / 1000.0, r.latency.p999 / 1000.0, r.latency.max / 1000.0);
+}
+
+template<class T>
+static void ParseList(const char* lpszArg, vector<T>& values, function<T(const string&)> fnParse)
+{
+    values.clear();
+
+    string arg(lpszArg);
+    size_t pos = 0;
+
+    while(pos <= arg.size())
+    {
+        size_t end = arg.find(',', pos);
+        if(end == string::npos) end = arg.size();
+
+        if(end > pos)
+            values.push_back(fnParse(arg.substr(pos, end - pos)));
+
+        pos = end + 1;
+    }
+}
+
+static void PrintUsage(LPCSTR lpszName)
+{
+    fprintf(stderr, "usage: %s [-p tcp,pack,pull,udp,arq,http,ssl] [-s sizes] [-c connections] [-w window] [-d duration_ms] [-u warmup_ms] [-P port] [-o file]\n", lpszName);
+}
+
+static BOOL ParseArgs(int argc, char* const argv[])
+{
+    auto fnStr = [](const string& s) {return s;};
+    auto fnInt = [](const string& s) {return atoi(s.c_str());};
+
+    int c;
+
+    while((c = ::getopt(argc, argv, "p:s:c:w:d:u:P:o:h")) != -1)
+    {
+        switch(c)
+        {
+        case 'p': ParseList<string>(optarg, g_bench_args.protocols, fnStr);    break;
+        case 's': ParseList<int>(optarg, g_bench_args.sizes, fnInt);           break;
+        case 'c': ParseList<int>(optarg, g_bench_args.conns, fnInt);           break;
+        case 'w': g_bench_args.window   = atoi(optarg);                         break;
+        case 'd': g_bench_args.duration = (DWORD)atoi(optarg);                  break;
+        case 'u': g_bench_args.warmup   = (DWORD)atoi(optarg);                  break;
+        case 'P': g_bench_args.port     = (USHORT)atoi(optarg);                 break;
+        case 'o': g_bench_args.output   = optarg;                               break;
+        default : return FALSE;
+        }
+    }
+
+    g_bench_args.window = MAX(1, MIN(g_bench_args.window, BENCH_MAX_WINDOW));
+
+    return TRUE;
+}
+
+int main(int argc, char* const argv[])
+{
+    if(!ParseArgs(argc, argv))
+    {
+        PrintUsage(argv[0]);
+        return EXIT_CODE_CONFIG;
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+
+    CStringA strJson;
+    strJson.AppendFormat("{\n  \"version\": \"%d.%d.%d.%d\", \"timestamp\": %llu, \"duration_ms\": %u, \"warmup_ms\": %u, \"processors\": %d,\n  \"results\": [",
+                         HP_VERSION_MAJOR, HP_VERSION_MINOR, HP_VERSION_REVISE, HP_VERSION_BUILD,
+                         (ULLONG)time(nullptr), g_bench_args.duration, g_bench_args.warmup, (int)PROCESSOR_COUNT);
+
+    BOOL bFirst = TRUE;
+
+    for(const string& protocol : g_bench_args.protocols)
+    {
+        for(int iSize : g_bench_args.sizes)
+        {
+            for(int iConns : g_bench_args.conns)
+            {
+                TBenchResult result;
+                ::ZeroMemory(&result, sizeof(TBenchResult));
+
+                result.protocol = protocol.c_str();
+                result.msgSize  = iSize;
+                result.conns    = iConns;
+                result.window   = g_bench_args.window;
+                result.status   = CheckCase(result);
+
+                if(result.status == nullptr)
+                    RunCase(result);
+
+                fprintf(stderr, "%-5s size=%-6d conns=%-4d window=%-2d %-16s %10.1f msg/s  p50=%.1fus p99=%.1fus\n",
+                        result.protocol, result.msgSize, result.conns, result.window, result.status,
+                        result.seconds > 0 ? result.msgs / result.seconds : 0,
+                        result.latency.p50 / 1000.0, result.latency.p99 / 1000.0);
+
+                AppendResult(strJson, result, bFirst);
+                bFirst = FALSE;
+
+                ++g_bench_args.port;
+            }
+        }
+    }
+
+    strJson.Append("\n  ]\n}\n");
+
+    if(g_bench_args.output.empty())
+        fputs((LPCSTR)strJson, stdout);
+    else
+    {
+        FILE* pFile = fopen(g_bench_args.output.c_str(), "w");
+
+        if(pFile == nullptr)
+        {
+            fprintf(stderr, "cannot open %s\n", g_bench_args.output.c_str());
+            return EXIT_CODE_CONFIG;
+        }
+
+        fputs((LPCSTR)strJson, pFile);
+        fclose(pFile);
+    }
+
+    return EXIT_CODE_OK;
+}
@@ -0,0 +1,680 @@
+#include "../../src/common/GeneralHelper.h"
+#include "../../src/common/RingBuffer.h"
+#include "../../src/common/BufferPool.h"
+#include "../../src/common/Metrics.h"
+#include "../../src/common/FecCodec.h"
+#include "../../src/HttpHelper.h"
+
+#include <stdio.h>
+#include <unistd.h>
+#include <atomic>
+#include <mutex>
+#include <deque>
+#include <vector>
+#include <string>
+#include <thread>
+#include <functional>
+#include <unordered_map>
+
+/*
+  核心数据结构微基准：按 Google Benchmark 的方式以 名称/threads:N 组织用例，
+  每个线程执行固定次数的操作，统计总吞吐与单次操作时延分布（每 16 次操作采样一次），
+  并把 CRingCache2 / CRingPool / CCASQueueX / TItemList 与可替代实现放在同一张表里比较；
+  fec/* 用例测量 ARQ FEC 编解码吞吐（ns/op 对应一个 1400 字节数据报）；
+  http/* 用例比较 http_parser 与快速解析（CHttpScanner）解析同一个典型浏览器请求头的耗时
+
+  用法：bench_structures [-f filter] [-t 1,2,4,8] [-n ops_per_thread] [-o result.json]
+*/
+
+#define MICRO_SAMPLE_MASK       15
+#define MICRO_CACHE_SIZE        (64 * 1024)
+#define MICRO_LOOKUP_ENTRIES    (16 * 1024)
+#define MICRO_POOL_SIZE         (8 * 1024)
+#define MICRO_ITEM_DATA_SIZE    1024
+#define MICRO_FEC_DATA_SHARDS   10
+#define MICRO_FEC_PARITY_SHARDS 3
+#define MICRO_FEC_DATAGRAM_SIZE 1400
+
+static const char MICRO_HTTP_REQUEST[] =
+    "GET /static/js/app.min.js?v=20240315&lang=zh-CN HTTP/1.1\r\n"
+    "Host: www.example.com\r\n"
+    "Connection: keep-alive\r\n"
+    "User-Agent: Mozilla/5.0 (Macintosh; Intel Mac OS X 10_15_7) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/122.0.0.0 Safari/537.36\r\n"
+    "Accept: */*\r\n"
+    "Referer: https://www.example.com/index.html\r\n"
+    "Accept-Encoding: gzip, deflate, br\r\n"
+    "Accept-Language: zh-CN,zh;q=0.9,en;q=0.8\r\n"
+    "Cookie: sid=8f14e45fceea167a5a36dedd4bea2543; theme=dark; _ga=GA1.2.1234567890.1700000000\r\n"
+    "If-None-Match: \"5e8f-17a9c2d4b80\"\r\n"
+    "\r\n";
+
+struct TMicroState
+{
+    int     thread;
+    int     threads;
+    ULLONG  ops;
+
+    CLatencyHistogram* pLatency;
+
+    /* 执行 ops 次操作：每 16 次单独计时一次 */
+    template<class F> void Run(F&& fnOp)
+    {
+        for(ULLONG i = 0; i < ops; i++)
+        {
+            if((i & MICRO_SAMPLE_MASK) != 0)
+                fnOp(i);
+            else
+            {
+                ULLONG ullBegin = ::TimeGetNanos();
+                fnOp(i);
+                pLatency->Record(::TimeGetNanos() - ullBegin);
+            }
+        }
+    }
+};
+
+struct TMicroBenchmark
+{
+    string  name;
+    /* 每轮测试前调用（单线程），准备共享数据结构 */
+    function<void(int iThreads)>    fnSetup;
+    /* 各线程并发调用 */
+    function<void(TMicroState&)>    fnRun;
+    /* 每轮测试后调用（单线程），释放共享数据结构 */
+    function<void()>                fnTeardown;
+    BOOL    multiThread;
+};
+
+struct TMicroResult
+{
+    string  name;
+    int     threads;
+    ULLONG  ops;
+    double  seconds;
+
+    CLatencyHistogram::TStat latency;
+};
+
+static vector<TMicroBenchmark> g_benchmarks;
+
+static void Register(LPCSTR lpszName, function<void(int)> fnSetup, function<void(TMicroState&)> fnRun, function<void()> fnTeardown, BOOL bMultiThread = TRUE)
+{
+    g_benchmarks.push_back({lpszName, fnSetup, fnRun, fnTeardown, bMultiThread});
+}
+
+// ------------------------------------------------------------------------------------------------------------- //
+
+struct TNode
+{
+    DWORD id;
+
+    /* 节点归 g_nodes 所有，对象池回收时无需释放 */
+    static void Destruct(TNode* pNode) {}
+};
+
+static vector<TNode> g_nodes;
+
+static TNode* GetNode(ULLONG i) {return &g_nodes[i % g_nodes.size()];}
+
+/* 连接查找表：放入并移除（连接建立/关闭） */
+template<class C> static void RegisterCachePutRemove(LPCSTR lpszName)
+{
+    static unique_ptr<C> s_pCache;
+
+    Register(lpszName,
+        [](int iThreads) {s_pCache.reset(new C(MICRO_CACHE_SIZE));},
+        [](TMicroState& state)
+        {
+            state.Run([](ULLONG i)
+            {
+                DWORD dwIndex;
+
+                if(s_pCache->Put(GetNode(i), dwIndex))
+                    s_pCache->Remove(dwIndex);
+            });
+        },
+        []() {s_pCache.reset();});
+}
+
+/* 连接查找表：预先放入 MICRO_LOOKUP_ENTRIES 个元素后随机查找（每次收发数据） */
+template<class C> static void RegisterCacheLookup(LPCSTR lpszName)
+{
+    static unique_ptr<C> s_pCache;
+    static vector<DWORD> s_indexes;
+
+    Register(lpszName,
+        [](int iThreads)
+        {
+            s_pCache.reset(new C(MICRO_CACHE_SIZE));
+            s_indexes.resize(MICRO_LOOKUP_ENTRIES);
+
+            for(DWORD i = 0; i < MICRO_LOOKUP_ENTRIES; i++)
+                VERIFY(s_pCache->Put(GetNode(i), s_indexes[i]));
+        },
+        [](TMicroState& state)
+        {
+            ULLONG ullSeed = 0x9E3779B97F4A7C15ull * (state.thread + 1);
+
+            state.Run([&ullSeed](ULLONG i)
+            {
+                ullSeed ^= ullSeed << 13; ullSeed ^= ullSeed >> 7; ullSeed ^= ullSeed << 17;
+
+                TNode* pNode = nullptr;
+                VERIFY(s_pCache->Get(s_indexes[ullSeed % MICRO_LOOKUP_ENTRIES], &pNode) == C::GR_VALID);
+            });
+        },
+        []() {s_pCache.reset(); s_indexes.clear();});
+}
+
+/* 对照组：互斥锁保护的 unordered_map */
+class CLockedMapCache
+{
+public:
+    enum EnGetResult {GR_FAIL = -1, GR_INVALID = 0, GR_VALID = 1};
+
+    BOOL Put(TNode* pNode, DWORD& dwIndex)
+    {
+        lock_guard<mutex> lock(m_mtx);
+
+        dwIndex = ++m_dwSeq;
+        m_map[dwIndex] = pNode;
+
+        return TRUE;
+    }
+
+    EnGetResult Get(DWORD dwIndex, TNode** ppNode)
+    {
+        lock_guard<mutex> lock(m_mtx);
+
+        auto it = m_map.find(dwIndex);
+
+        if(it == m_map.end())
+            return GR_FAIL;
+
+        *ppNode = it->second;
+        return GR_VALID;
+    }
+
+    BOOL Remove(DWORD dwIndex)
+    {
+        lock_guard<mutex> lock(m_mtx);
+
+        return m_map.erase(dwIndex) > 0;
+    }
+
+    CLockedMapCache(DWORD dwSize) : m_dwSeq(0) {m_map.reserve(dwSize);}
+
+private:
+    mutex                               m_mtx;
+    DWORD                               m_dwSeq;
+    unordered_map<DWORD, TNode*>   m_map;
+};
+
+// ------------------------------------------------------------------------------------------------------------- //
+
+/* 空闲对象池：取出再放回（对象分配/回收），池中预先放入 MICRO_POOL_SIZE / 2 个对象 */
+template<class P> static void RegisterPoolGetPut(LPCSTR lpszName)
+{
+    static unique_ptr<P> s_pPool;
+
+    Register(lpszName,
+        [](int iThreads)
+        {
+            s_pPool.reset(new P(MICRO_POOL_SIZE));
+
+            for(DWORD i = 0; i < MICRO_POOL_SIZE / 2; i++)
+                VERIFY(s_pPool->TryPut(GetNode(i)));
+        },
+        [](TMicroState& state)
+        {
+            state.Run([](ULLONG i)
+            {
+                TNode* pNode = nullptr;
+
+                if(s_pPool->TryGet(&pNode))
+                    s_pPool->TryPut(pNode);
+            });
+        },
+        []() {s_pPool.reset();});
+}
+
+/* 对照组：互斥锁保护的 vector 空闲链表 */
+class CLockedFreeList
+{
+public:
+    BOOL TryPut(TNode* pNode)
+    {
+        lock_guard<mutex> lock(m_mtx);
+
+        if(m_nodes.size() >= m_dwSize)
+            return FALSE;
+
+        m_nodes.push_back(pNode);
+        return TRUE;
+    }
+
+    BOOL TryGet(TNode** ppNode)
+    {
+        lock_guard<mutex> lock(m_mtx);
+
+        if(m_nodes.empty())
+            return FALSE;
+
+        *ppNode = m_nodes.back();
+        m_nodes.pop_back();
+
+        return TRUE;
+    }
+
+    CLockedFreeList(DWORD dwSize) : m_dwSize(dwSize) {m_nodes.reserve(dwSize);}
+
+private:
+    mutex           m_mtx;
+    DWORD           m_dwSize;
+    vector<TNode*>  m_nodes;
+};
+
+/* CMagazinePool 的构造参数与 TryPut/TryGet 语义与 CRingPool 相同 */
+template<class T> class CMagazinePoolAdapter : public CMagazinePool<T>
+{
+public:
+    CMagazinePoolAdapter(DWORD dwSize) : CMagazinePool<T>(dwSize) {}
+};
+
+template<class T> class CRingPoolAdapter : public CRingPool<T>
+{
+public:
+    CRingPoolAdapter(DWORD dwSize) : CRingPool<T>(dwSize) {}
+};
+
+// ------------------------------------------------------------------------------------------------------------- //
+
+/* 命令队列：多生产者多消费者，每个线程入队一个元素再出队一个元素 */
+template<class Q> static void RegisterQueuePushPop(LPCSTR lpszName)
+{
+    static unique_ptr<Q> s_pQueue;
+
+    Register(lpszName,
+        [](int iThreads) {s_pQueue.reset(new Q);},
+        [](TMicroState& state)
+        {
+            state.Run([](ULLONG i)
+            {
+                TNode* pNode = nullptr;
+
+                s_pQueue->PushBack(GetNode(i));
+                s_pQueue->PopFront(&pNode);
+            });
+        },
+        []()
+        {
+            TNode* pNode = nullptr;
+            while(s_pQueue->PopFront(&pNode));
+
+            s_pQueue.reset();
+        });
+}
+
+/* 对照组：互斥锁保护的 deque */
+class CLockedQueue
+{
+public:
+    void PushBack(TNode* pNode)
+    {
+        lock_guard<mutex> lock(m_mtx);
+        m_nodes.push_back(pNode);
+    }
+
+    BOOL PopFront(TNode** ppNode)
+    {
+        lock_guard<mutex> lock(m_mtx);
+
+        if(m_nodes.empty())
+            return FALSE;
+
+        *ppNode = m_nodes.front();
+        m_nodes.pop_front();
+
+        return TRUE;
+    }
+
+private:
+    mutex           m_mtx;
+    deque<TNode*>   m_nodes;
+};
+
+// ------------------------------------------------------------------------------------------------------------- //
+
+/* 发送/接收缓冲：每个线程一个列表，共享一个内存块池，追加 1KB 后取出 */
+static void RegisterItemListCatFetch()
+{
+    static unique_ptr<CItemPool> s_pPool;
+
+    Register("item_list/cat_fetch/TItemList",
+        [](int iThreads)
+        {
+            s_pPool.reset(new CItemPool);
+            s_pPool->Prepare();
+        },
+        [](TMicroState& state)
+        {
+            BYTE data[MICRO_ITEM_DATA_SIZE] = {0};
+            TItemList ls(*s_pPool);
+
+            state.Run([&](ULLONG i)
+            {
+                ls.Cat(data, MICRO_ITEM_DATA_SIZE);
+                ls.Fetch(data, MICRO_ITEM_DATA_SIZE);
+            });
+
+            ls.Release();
+        },
+        []() {s_pPool.reset();});
+
+    Register("item_list/cat_fetch/deque_buffer",
+        [](int iThreads) {},
+        [](TMicroState& state)
+        {
+            BYTE data[MICRO_ITEM_DATA_SIZE] = {0};
+            deque<vector<BYTE>> ls;
+
+            state.Run([&](ULLONG i)
+            {
+                ls.emplace_back(data, data + MICRO_ITEM_DATA_SIZE);
+                memcpy(data, ls.front().data(), MICRO_ITEM_DATA_SIZE);
+                ls.pop_front();
+            });
+        },
+        []() {});
+}
+
+// ------------------------------------------------------------------------------------------------------------- //
+
+/* ARQ FEC：每次操作编码一个 1400 字节数据报（10 + 3 分组），解码时每个分组丢失一个数据分片 */
+static void RegisterFecEncodeDecode()
+{
+    Register("fec/encode/CFecEncoder",
+        [](int iThreads) {printf("GF(256) kernel: %s\n", CGF256::GetKernelName());},
+        [](TMicroState& state)
+        {
+            vector<BYTE> data(MICRO_FEC_DATAGRAM_SIZE, (BYTE)state.thread);
+            CFecEncoder encoder;
+            encoder.Init(MICRO_FEC_DATA_SHARDS, MICRO_FEC_PARITY_SHARDS, MICRO_FEC_DATAGRAM_SIZE);
+
+            state.Run([&](ULLONG i)
+            {
+                data[i % MICRO_FEC_DATAGRAM_SIZE] = (BYTE)i;
+                encoder.Encode(data.data(), MICRO_FEC_DATAGRAM_SIZE);
+            });
+        },
+        []() {});
+
+    Register("fec/decode_recover/CFecDecoder",
+        [](int iThreads) {},
+        [](TMicroState& state)
+        {
+            vector<BYTE> data(MICRO_FEC_DATAGRAM_SIZE, (BYTE)state.thread);
+            vector<vector<BYTE>> packets;
+            CFecEncoder encoder;
+            CFecDecoder decoder;
+            encoder.Init(MICRO_FEC_DATA_SHARDS, MICRO_FEC_PARITY_SHARDS, MICRO_FEC_DATAGRAM_SIZE);
+            decoder.Init(MICRO_FEC_DATA_SHARDS, MICRO_FEC_PARITY_SHARDS, MICRO_FEC_DATAGRAM_SIZE);
+
+            ULLONG ullOutput = 0;
+
+            state.Run([&](ULLONG i)
+            {
+                const BYTE* pPacket = encoder.Encode(data.data(), MICRO_FEC_DATAGRAM_SIZE);
+
+                if(i % MICRO_FEC_DATA_SHARDS != 0)
+                    packets.emplace_back(pPacket, pPacket + MICRO_FEC_DATAGRAM_SIZE + FEC_OVERHEAD);
+
+                for(int j = 0; j < encoder.GetParityCount(); j++)
+                {
+                    int iLength;
+                    const BYTE* pParity = encoder.GetParity(j, iLength);
+                    packets.emplace_back(pParity, pParity + iLength);
+                }
+
+                if(encoder.GetParityCount() > 0)
+                {
+                    for(auto& pkt : packets)
+                        decoder.Decode(pkt.data(), (int)pkt.size(), [&](const BYTE* pData, int iLength) {++ullOutput; return TRUE;});
+
+                    packets.clear();
+                }
+            });
+
+            ASSERT(ullOutput >= state.ops - MICRO_FEC_DATA_SHARDS);
+        },
+        []() {});
+}
+
+/* HTTP 请求头解析：每次操作解析一个约 600 字节的请求头，回调只统计名称和值的长度 */
+static void RegisterHttpParse()
+{
+    Register("http/parse_request/http_parser",
+        [](int iThreads) {},
+        [](TMicroState& state)
+        {
+            http_parser parser;
+            http_parser_settings settings;
+            ULLONG ullBytes = 0;
+
+            memset(&settings, 0, sizeof(settings));
+            settings.on_url             = [](http_parser* p, const char* at, size_t length) {*(ULLONG*)p->data += length; return 0;};
+            settings.on_header_field    = settings.on_url;
+            settings.on_header_value    = settings.on_url;
+
+            state.Run([&](ULLONG i)
+            {
+                ::http_parser_init(&parser, HTTP_REQUEST);
+                parser.data = &ullBytes;
+                ::http_parser_execute(&parser, &settings, MICRO_HTTP_REQUEST, sizeof(MICRO_HTTP_REQUEST) - 1);
+            });
+
+            ASSERT(ullBytes > 0);
+        },
+        []() {});
+
+    Register("http/parse_request/CHttpScanner",
+        [](int iThreads) {printf("HTTP scanner kernel: %s\n", CHttpScanner::GetKernelName());},
+        [](TMicroState& state)
+        {
+            unique_ptr<THttpRequestHead> head(new THttpRequestHead);
+            ULLONG ullBytes = 0;
+
+            state.Run([&](ULLONG i)
+            {
+                int iEnd = CHttpScanner::FindHeadEnd(MICRO_HTTP_REQUEST, sizeof(MICRO_HTTP_REQUEST) - 1);
+
+                if(iEnd > 0 && ::ParseHttpRequestHead(MICRO_HTTP_REQUEST, iEnd, *head))
+                {
+                    ullBytes += head->urlLen;
+
+                    for(int j = 0; j < head->headerCount; j++)
+                        ullBytes += head->headers[j].nameLen + head->headers[j].valueLen;
+                }
+            });
+
+            ASSERT(ullBytes > 0);
+        },
+        []() {});
+}
+
+static void RegisterAll()
+{
+    for(DWORD i = 0; i < MICRO_POOL_SIZE; i++)
+        g_nodes.push_back({i});
+
+    RegisterCachePutRemove<CRingCache2<TNode, DWORD, true>>("ring_cache/put_remove/CRingCache2");
+    RegisterCachePutRemove<CRingCache<TNode, DWORD, true>>("ring_cache/put_remove/CRingCache");
+    RegisterCachePutRemove<CLockedMapCache>("ring_cache/put_remove/locked_map");
+
+    RegisterCacheLookup<CRingCache2<TNode, DWORD, true>>("ring_cache/lookup/CRingCache2");
+    RegisterCacheLookup<CRingCache<TNode, DWORD, true>>("ring_cache/lookup/CRingCache");
+    RegisterCacheLookup<CLockedMapCache>("ring_cache/lookup/locked_map");
+
+    RegisterPoolGetPut<CRingPoolAdapter<TNode>>("ring_pool/get_put/CRingPool");
+    RegisterPoolGetPut<CMagazinePoolAdapter<TNode>>("ring_pool/get_put/CMagazinePool");
+    RegisterPoolGetPut<CLockedFreeList>("ring_pool/get_put/locked_free_list");
+
+    RegisterQueuePushPop<CCASQueueX<TNode>>("cas_queue/push_pop/CCASQueueX");
+    RegisterQueuePushPop<CCASQueueY<TNode>>("cas_queue/push_pop/CCASQueueY");
+    RegisterQueuePushPop<CLockedQueue>("cas_queue/push_pop/locked_deque");
+
+    RegisterItemListCatFetch();
+    RegisterFecEncodeDecode();
+    RegisterHttpParse();
+}
+
+// ------------------------------------------------------------------------------------------------------------- //
+
+static void RunBenchmark(TMicroBenchmark& bm, int iThreads, ULLONG ullOps, TMicroResult& result)
+{
+    CLatencyHistogram latency;
+    atomic<int> iReady(0);
+    atomic<BOOL> bGo(FALSE);
+
+    bm.fnSetup(iThreads);
+
+    vector<thread> workers;
+
+    for(int i = 0; i < iThreads; i++)
+    {
+        workers.emplace_back([&, i]()
+        {
+            TMicroState state = {i, iThreads, ullOps, &latency};
+
+            ++iReady;
+            while(!bGo) this_thread::yield();
+
+            bm.fnRun(state);
+        });
+    }
+
+    while(iReady < iThreads) this_thread::yield();
+
+    ULLONG ullBegin = ::TimeGetNanos();
+    bGo = TRUE;
+
+    for(auto& t : workers)
+        t.join();
+
+    result.seconds = (::TimeGetNanos() - ullBegin) / 1000000000.0;
+
+    bm.fnTeardown();
+
+    result.name     = bm.name;
+    result.threads  = iThreads;
+    result.ops      = ullOps * iThreads;
+
+    latency.GetStat(result.latency);
+}
+
+static vector<int> ParseInts(const char* lpszArg)
+{
+    vector<int> values;
+    string arg(lpszArg);
+    size_t pos = 0;
+
+    while(pos <= arg.size())
+    {
+        size_t end = arg.find(',', pos);
+        if(end == string::npos) end = arg.size();
+
+        if(end > pos)
+            values.push_back(atoi(arg.substr(pos, end - pos).c_str()));
+
+        pos = end + 1;
+    }
+
+    return values;
+}
+
+int main(int argc, char* const argv[])
+{
+    string strFilter;
+    string strOutput;
+    ULLONG ullOps = 1000000;
+    vector<int> threads;
+
+    for(int i = 1; i <= (int)PROCESSOR_COUNT; i <<= 1)
+        threads.push_back(i);
+
+    int c;
+
+    while((c = ::getopt(argc, argv, "f:t:n:o:h")) != -1)
+    {
+        switch(c)
+        {
+        case 'f': strFilter = optarg;                           break;
+        case 't': threads   = ParseInts(optarg);                break;
+        case 'n': ullOps    = (ULLONG)atoll(optarg);            break;
+        case 'o': strOutput = optarg;                           break;
+        default :
+            fprintf(stderr, "usage: %s [-f filter] [-t 1,2,4,8] [-n ops_per_thread] [-o file]\n", argv[0]);
+            return EXIT_CODE_CONFIG;
+        }
+    }
+
+    RegisterAll();
+
+    CStringA strJson;
+    strJson.AppendFormat("{\n  \"processors\": %d, \"ops_per_thread\": %llu, \"timestamp\": %llu,\n  \"benchmarks\": [", (int)PROCESSOR_COUNT, ullOps, (ULLONG)time(nullptr));
+
+    printf("%-48s %12s %14s %10s %10s %10s\n", "Benchmark", "ns/op", "ops/s", "p50(ns)", "p99(ns)", "p999(ns)");
+    printf("%s\n", string(108, '-').c_str());
+
+    BOOL bFirst = TRUE;
+
+    for(auto& bm : g_benchmarks)
+    {
+        if(!strFilter.empty() && bm.name.find(strFilter) == string::npos)
+            continue;
+
+        for(int iThreads : threads)
+        {
+            if(iThreads <= 0 || (!bm.multiThread && iThreads > 1))
+                continue;
+
+            TMicroResult result;
+            RunBenchmark(bm, iThreads, ullOps, result);
+
+            double dOpsPerSec = result.seconds > 0 ? result.ops / result.seconds : 0;
+            double dNsPerOp   = result.ops > 0 ? result.seconds * 1000000000.0 * iThreads / result.ops : 0;
+
+            CStringA strName;
+            strName.Format("%s/threads:%d", result.name.c_str(), iThreads);
+
+            printf("%-48s %12.1f %14.0f %10llu %10llu %10llu\n", (LPCSTR)strName, dNsPerOp, dOpsPerSec,
+                    result.latency.p50, result.latency.p99, result.latency.p999);
+            fflush(stdout);
+
+            strJson.AppendFormat("%s\n    {\"name\": \"%s\", \"threads\": %d, \"ops\": %llu, \"seconds\": %.4f, \"ns_per_op\": %.2f, \"ops_per_sec\": %.0f, "
+                                 "\"latency_ns\": {\"p50\": %llu, \"p90\": %llu, \"p99\": %llu, \"p999\": %llu, \"max\": %llu}}",
+                                 bFirst ? "" : ",", result.name.c_str(), iThreads, result.ops, result.seconds, dNsPerOp, dOpsPerSec,
+                                 result.latency.p50, result.latency.p90, result.latency.p99, result.latency.p999, result.latency.max);
+
+            bFirst = FALSE;
+        }
+    }
+
+    strJson.Append("\n  ]\n}\n");
+
+    if(!strOutput.empty())
+    {
+        FILE* pFile = fopen(strOutput.c_str(), "w");
+
+        if(pFile == nullptr)
+        {
+            fprintf(stderr, "cannot open %s\n", strOutput.c_str());
+            return EXIT_CODE_CONFIG;
+        }
+
+        fputs((LPCSTR)strJson, pFile);
+        fclose(pFile);
+    }
+
+    return EXIT_CODE_OK;
+}